@@ -46,6 +46,7 @@ SERIALBOX_API serialboxArrayOfString_t* serialboxArchiveGetRegisteredArchives(vo
  * Extensions    | Archives
  * ------------- | --------
  * .dat, .bin    | Binary
+ * .pack         | PackedBinary
  * .nc           | NetCDF
  *
  * \param filename    Path or name of the file
@@ -51,6 +51,110 @@ std::vector<int> make_strides(int istride, int jstride, int kstride, int lstride
     strides.push_back(lstride);
   return strides;
 }
+
+std::vector<int> make_dims(int isize, int jsize, int ksize, int lsize) {
+  std::vector<int> dims;
+  if(isize > 0 || jsize > 0 || ksize > 0 || lsize > 0)
+    dims.push_back(isize);
+  if(jsize > 0 || ksize > 0 || lsize > 0)
+    dims.push_back(jsize);
+  if(ksize > 0 || lsize > 0)
+    dims.push_back(ksize);
+  if(lsize > 0)
+    dims.push_back(lsize);
+  return dims;
+}
+
+/// Compute the unit-strides from the addresses of the successors of `basePtr` in each dimension
+std::array<long, 4> make_unit_strides(int bytesPerElement, const void* basePtr, const void* iplus1,
+                                      const void* jplus1, const void* kplus1,
+                                      const void* lplus1) {
+  std::array<long, 4> strides{
+      {reinterpret_cast<const char*>(iplus1) - reinterpret_cast<const char*>(basePtr),
+       reinterpret_cast<const char*>(jplus1) - reinterpret_cast<const char*>(basePtr),
+       reinterpret_cast<const char*>(kplus1) - reinterpret_cast<const char*>(basePtr),
+       reinterpret_cast<const char*>(lplus1) - reinterpret_cast<const char*>(basePtr)}};
+
+  // Reorder strides
+  for(int i = 2; i >= 0; --i)
+    if(strides[i] == 0)
+      strides[i] = strides[i + 1];
+
+  // Convert to unit-strides
+  for(long& stride : strides)
+    stride /= bytesPerElement;
+  return strides;
+}
+
+/// Check the type and the sizes `actualSizes` of a field passed from Fortran against the registered
+/// field (dimensions of size 1 may be omitted)
+void check_field(const char* name, const serialbox::FieldMetainfoImpl& info, int type,
+                 std::array<int, 4> actualSizes) {
+  auto refSizes = info.dims();
+  ::make_4D(refSizes);
+
+  // Check rank
+  const int rank = (actualSizes[0] > 0 ? 1 : 0) + (actualSizes[1] > 0 ? 1 : 0) +
+                   (actualSizes[2] > 0 ? 1 : 0) + (actualSizes[3] > 0 ? 1 : 0);
+
+  const int refRank = (refSizes[0] > 0 ? 1 : 0) + (refSizes[1] > 0 ? 1 : 0) +
+                      (refSizes[2] > 0 ? 1 : 0) + (refSizes[3] > 0 ? 1 : 0);
+
+  bool scalar = rank == 0 && refRank == 1 && refSizes[0] == 1;
+
+  if(rank != refRank && !scalar)
+    throw Exception("field '%s' has rank %i but field with rank %i was passed", name, refRank,
+                    rank);
+
+  // Check type (be careful with converting type as it is an arbitrary int)
+  TypeID typeID = type <= Float64 ? (TypeID)type : TypeID::Invalid;
+  if(typeID != info.type())
+    throw Exception("field '%s' has type '%s' but was registered as type '%s'", name,
+                    serialbox::TypeUtil::toString(info.type()),
+                    serialbox::TypeUtil::toString(typeID));
+
+  // Reorder and check dimensions
+  for(int i = 0; i < 4; ++i) {
+    if(actualSizes[i] == refSizes[i])
+      continue;
+
+    if(refSizes[i] == 1) {
+      for(int j = 3; j > i; --j)
+        actualSizes[j] = actualSizes[j - 1];
+      actualSizes[i] = 1;
+      continue;
+    } else
+      throw Exception("dimensions of field '%s' do not match registered ones:"
+                      "\nRegistered as: [ %i, %i, %i, %i ]"
+                      "\nGiven      as: [ %i, %i, %i, %i ]",
+                      name, refSizes[0], refSizes[1], refSizes[2], refSizes[3], actualSizes[0],
+                      actualSizes[1], actualSizes[2], actualSizes[3]);
+  }
+}
+
+/// Construct the StorageView of the registered field `handle` passed from Fortran as an array of
+/// type `type` and size `isize x jsize x ksize x lsize`
+serialbox::StorageView make_storage_view(const FieldHandle& handle, int type, void* basePtr,
+                                         const void* iplus1, const void* jplus1,
+                                         const void* kplus1, const void* lplus1, int isize,
+                                         int jsize, int ksize, int lsize) {
+  if(!handle.valid())
+    throw Exception("invalid field handle");
+
+  const serialbox::FieldMetainfoImpl& info = *handle.info();
+  ::check_field(handle.name().c_str(), info, type, {{isize, jsize, ksize, lsize}});
+
+  // The StorageView follows the registered dimensions, exactly as serialboxSerializerWrite does
+  auto unitStrides = ::make_unit_strides(serialbox::TypeUtil::sizeOf(info.type()), basePtr,
+                                         iplus1, jplus1, kplus1, lplus1);
+  std::vector<int> strides(unitStrides.begin(), unitStrides.begin() + info.dims().size());
+  return serialbox::StorageView(basePtr, info.type(), info.dims(), strides);
+}
+
+/// Get the halo `key` of the registered field `info` (0 if the field has no halos)
+int get_halo(const serialbox::FieldMetainfoImpl& info, const char* key) {
+  return info.metaInfo().hasKey(key) ? info.metaInfo().as<int>(key) : 0;
+}
 } // namespace
 
 /*===------------------------------------------------------------------------------------------===*\
@@ -75,24 +179,43 @@ void serialboxFortranSerializerRead(void* serializer, const void* savepoint, con
                           strides.data(), strides.size());
 }
 
-void serialboxFortranSerializerPrintDebugInfo(void* serializer) {
+void serialboxFortranSerializerWriteHandle(void* serializer, const void* field, int savepoint,
+                                           int type, void* basePtr, const void* iplus1,
+                                           const void* jplus1, const void* kplus1,
+                                           const void* lplus1, int isize, int jsize, int ksize,
+                                           int lsize) {
   Serializer* ser = toSerializer(static_cast<serialboxSerializer_t*>(serializer));
-  std::cout << ser << std::endl;
-}
+  const FieldHandle* handle = toConstFieldHandle(static_cast<const serialboxFieldHandle_t*>(field));
 
-template <class ArrayType1, class ArrayType2>
-static void checkRank(const char* name, ArrayType1&& array, ArrayType2&& arrayRef) {
-  const int rank = (array[0] > 0 ? 1 : 0) + (array[1] > 0 ? 1 : 0) + (array[2] > 0 ? 1 : 0) +
-                   (array[3] > 0 ? 1 : 0);
+  try {
+    auto storageView = ::make_storage_view(*handle, type, basePtr, iplus1, jplus1, kplus1, lplus1,
+                                           isize, jsize, ksize, lsize);
+    ser->write(*handle, serialbox::SavepointHandle(savepoint), storageView);
+  } catch(std::exception& e) {
+    serialboxFatalError(e.what());
+  }
+}
 
-  const int refRank = (arrayRef[0] > 0 ? 1 : 0) + (arrayRef[1] > 0 ? 1 : 0) +
-                      (arrayRef[2] > 0 ? 1 : 0) + (arrayRef[3] > 0 ? 1 : 0);
+void serialboxFortranSerializerReadHandle(void* serializer, const void* field, int savepoint,
+                                          int type, void* basePtr, const void* iplus1,
+                                          const void* jplus1, const void* kplus1,
+                                          const void* lplus1, int isize, int jsize, int ksize,
+                                          int lsize) {
+  Serializer* ser = toSerializer(static_cast<serialboxSerializer_t*>(serializer));
+  const FieldHandle* handle = toConstFieldHandle(static_cast<const serialboxFieldHandle_t*>(field));
 
-  bool scalar = rank == 0 && refRank == 1 && arrayRef[0] == 1;
+  try {
+    auto storageView = ::make_storage_view(*handle, type, basePtr, iplus1, jplus1, kplus1, lplus1,
+                                           isize, jsize, ksize, lsize);
+    ser->read(*handle, serialbox::SavepointHandle(savepoint), storageView);
+  } catch(std::exception& e) {
+    serialboxFatalError(e.what());
+  }
+}
 
-  if(rank != refRank && !scalar)
-    throw Exception("field '%s' has rank %i but field with rank %i was passed", name, refRank,
-                    rank);
+void serialboxFortranSerializerPrintDebugInfo(void* serializer) {
+  Serializer* ser = toSerializer(static_cast<serialboxSerializer_t*>(serializer));
+  std::cout << ser << std::endl;
 }
 
 void serialboxFortranSerializerCheckField(const void* serializer, const char* name, int* type,
@@ -101,39 +224,38 @@ void serialboxFortranSerializerCheckField(const void* serializer, const char* na
   const Serializer* ser = toConstSerializer(static_cast<const serialboxSerializer_t*>(serializer));
 
   try {
-    const auto& info = ser->getFieldMetainfoImplOf(name);
-
-    std::array<int, 4> actualSizes{{*isize, *jsize, *ksize, *lsize}};
-    auto refSizes = info.dims();
-    ::make_4D(refSizes);
-
-    // Check rank
-    checkRank(name, actualSizes, refSizes);
-
-    // Check type (be careful with converting *type as it is an arbitrary int)
-    TypeID typeID = *type <= Float64 ? (TypeID)*type : TypeID::Invalid;
-    if(typeID != info.type())
-      throw Exception("field '%s' has type '%s' but was registered as type '%s'", name,
-                      serialbox::TypeUtil::toString(info.type()),
-                      serialbox::TypeUtil::toString(typeID));
-
-    // Reorder and check dimensions
-    for(int i = 0; i < 4; ++i) {
-      if(actualSizes[i] == refSizes[i])
-        continue;
-
-      if(refSizes[i] == 1) {
-        for(int j = 3; j > i; --j)
-          actualSizes[j] = actualSizes[j - 1];
-        actualSizes[i] = 1;
-        continue;
-      } else
-        throw Exception("dimensions of field '%s' do not match registered ones:"
-                        "\nRegistered as: [ %i, %i, %i, %i ]"
-                        "\nGiven      as: [ %i, %i, %i, %i ]",
-                        name, refSizes[0], refSizes[1], refSizes[2], refSizes[3], actualSizes[0],
-                        actualSizes[1], actualSizes[2], actualSizes[3]);
-    }
+    ::check_field(name, ser->getFieldMetainfoImplOf(name), *type,
+                  {{*isize, *jsize, *ksize, *lsize}});
+  } catch(std::exception& e) {
+    serialboxFatalError(e.what());
+  }
+}
+
+void serialboxFortranSerializerCheckHalosHandle(const void* field, int iMinusHalo, int iPlusHalo,
+                                                int jMinusHalo, int jPlusHalo, int kMinusHalo,
+                                                int kPlusHalo, int lMinusHalo, int lPlusHalo) {
+  const FieldHandle* handle = toConstFieldHandle(static_cast<const serialboxFieldHandle_t*>(field));
+
+  try {
+    if(!handle->valid())
+      throw Exception("invalid field handle");
+
+    const serialbox::FieldMetainfoImpl& info = *handle->info();
+    std::array<int, 8> halos{{iMinusHalo, iPlusHalo, jMinusHalo, jPlusHalo, kMinusHalo,
+                              kPlusHalo, lMinusHalo, lPlusHalo}};
+    std::array<int, 8> refHalos{
+        {::get_halo(info, "__iminushalosize"), ::get_halo(info, "__iplushalosize"),
+         ::get_halo(info, "__jminushalosize"), ::get_halo(info, "__jplushalosize"),
+         ::get_halo(info, "__kminushalosize"), ::get_halo(info, "__kplushalosize"),
+         ::get_halo(info, "__lminushalosize"), ::get_halo(info, "__lplushalosize")}};
+
+    if(halos != refHalos)
+      throw Exception("halos of field '%s' do not match registered ones:"
+                      "\nRegistered as: [ %i, %i, %i, %i, %i, %i, %i, %i ]"
+                      "\nGiven      as: [ %i, %i, %i, %i, %i, %i, %i, %i ]",
+                      handle->name().str(), refHalos[0], refHalos[1], refHalos[2], refHalos[3],
+                      refHalos[4], refHalos[5], refHalos[6], refHalos[7], halos[0], halos[1],
+                      halos[2], halos[3], halos[4], halos[5], halos[6], halos[7]);
   } catch(std::exception& e) {
     serialboxFatalError(e.what());
   }
@@ -148,23 +270,12 @@ void serialboxFortranComputeStrides(void* serializer, const char* fieldname, con
   try {
     const auto& info = ser->getFieldMetainfoImplOf(fieldname);
 
-    std::array<long, 4> strides{
-        {reinterpret_cast<const char*>(iplus1) - reinterpret_cast<const char*>(basePtr),
-         reinterpret_cast<const char*>(jplus1) - reinterpret_cast<const char*>(basePtr),
-         reinterpret_cast<const char*>(kplus1) - reinterpret_cast<const char*>(basePtr),
-         reinterpret_cast<const char*>(lplus1) - reinterpret_cast<const char*>(basePtr)}};
-
-    // Reorder strides
-    for(int i = 2; i >= 0; --i)
-      if(strides[i] == 0)
-        strides[i] = strides[i + 1];
-
-    // Convert to unit-strides
-    const int bytesPerElement = serialbox::TypeUtil::sizeOf(info.type());
-    *istride = strides[0] / bytesPerElement;
-    *jstride = strides[1] / bytesPerElement;
-    *kstride = strides[2] / bytesPerElement;
-    *lstride = strides[3] / bytesPerElement;
+    auto strides = ::make_unit_strides(serialbox::TypeUtil::sizeOf(info.type()), basePtr, iplus1,
+                                       jplus1, kplus1, lplus1);
+    *istride = strides[0];
+    *jstride = strides[1];
+    *kstride = strides[2];
+    *lstride = strides[3];
 
   } catch(std::exception& e) {
     serialboxFatalError(e.what());
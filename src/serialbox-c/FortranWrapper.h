@@ -47,6 +47,28 @@ void serialboxFortranSerializerRead(void* serializer, const void* savepoint, con
                                     void* originPtr, int istride, int jstride, int kstride,
                                     int lstride);
 
+/**
+ * \brief Wrapper for \ref serialboxSerializerWriteByHandle
+ *
+ * The strides are computed from the addresses of the successors of `basePtr` in each dimension
+ * (see \ref serialboxFortranComputeStrides) and the field is checked against the given `type` and
+ * sizes.
+ */
+void serialboxFortranSerializerWriteHandle(void* serializer, const void* field, int savepoint,
+                                           int type, void* basePtr, const void* iplus1,
+                                           const void* jplus1, const void* kplus1,
+                                           const void* lplus1, int isize, int jsize, int ksize,
+                                           int lsize);
+
+/**
+ * \brief Wrapper for \ref serialboxSerializerReadByHandle
+ */
+void serialboxFortranSerializerReadHandle(void* serializer, const void* field, int savepoint,
+                                          int type, void* basePtr, const void* iplus1,
+                                          const void* jplus1, const void* kplus1,
+                                          const void* lplus1, int isize, int jsize, int ksize,
+                                          int lsize);
+
 /**
  * \brief Print debug information (i.e convert serializer to string)
  */
@@ -58,6 +80,13 @@ void serialboxFortranSerializerPrintDebugInfo(void* serializer);
 void serialboxFortranSerializerCheckField(const void* serializer, const char* name, int* type,
                                           int* isize, int* jsize, int* ksize, int* lsize);
 
+/**
+ * \brief Check that the halos passed along with a field handle match the registered ones
+ */
+void serialboxFortranSerializerCheckHalosHandle(const void* field, int iMinusHalo, int iPlusHalo,
+                                                int jMinusHalo, int jPlusHalo, int kMinusHalo,
+                                                int kPlusHalo, int lMinusHalo, int lPlusHalo);
+
 /**
  * \brief Compute unit-strides of registered field `fieldname`
  */
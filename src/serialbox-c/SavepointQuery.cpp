@@ -0,0 +1,75 @@
+/*===-- serialbox-c/SavepointQuery.cpp ----------------------------------------------*- C++ -*-===*\
+ *
+ *                                    S E R I A L B O X
+ *
+ * This file is distributed under terms of BSD license.
+ * See LICENSE.txt for more information
+ *
+ *===------------------------------------------------------------------------------------------===//
+ *
+ *! \file
+ *! This file contains the C implementation of the SavepointQuery.
+ *
+\*===------------------------------------------------------------------------------------------===*/
+
+#include "serialbox-c/SavepointQuery.h"
+#include "serialbox-c/Utility.h"
+
+using namespace serialboxC;
+
+/*===------------------------------------------------------------------------------------------===*\
+ *     Construction & Destruction
+\*===------------------------------------------------------------------------------------------===*/
+
+serialboxSavepointQuery_t* serialboxSavepointQueryCreate(void) {
+  serialboxSavepointQuery_t* query = allocate<serialboxSavepointQuery_t>();
+  try {
+    query->impl = new SavepointQuery;
+    query->ownsData = 1;
+  } catch(std::exception& e) {
+    std::free(query);
+    query = NULL;
+    serialboxFatalError(e.what());
+  }
+  return query;
+}
+
+void serialboxSavepointQueryDestroy(serialboxSavepointQuery_t* query) {
+  if(query) {
+    SavepointQuery* q = toSavepointQuery(query);
+    if(query->ownsData)
+      delete q;
+    std::free(query);
+  }
+}
+
+/*===------------------------------------------------------------------------------------------===*\
+ *     Predicates
+\*===------------------------------------------------------------------------------------------===*/
+
+void serialboxSavepointQuerySetName(serialboxSavepointQuery_t* query, const char* name) {
+  SavepointQuery* q = toSavepointQuery(query);
+  q->name(name);
+}
+
+#define SERIALBOX_SAVEPOINTQUERY_EQUAL_IMPL(name, serialboxPrimitveType, CXXType)                  \
+  void serialboxSavepointQueryEqual##name(serialboxSavepointQuery_t* query, const char* key,       \
+                                          serialboxPrimitveType value) {                           \
+    SavepointQuery* q = toSavepointQuery(query);                                                   \
+    q->equal(key, CXXType(value));                                                                 \
+  }
+
+SERIALBOX_SAVEPOINTQUERY_EQUAL_IMPL(Boolean, serialboxBoolean_t, bool);
+SERIALBOX_SAVEPOINTQUERY_EQUAL_IMPL(Int32, serialboxInt32_t, int);
+SERIALBOX_SAVEPOINTQUERY_EQUAL_IMPL(Int64, serialboxInt64_t, std::int64_t);
+SERIALBOX_SAVEPOINTQUERY_EQUAL_IMPL(Float32, serialboxFloat32_t, float);
+SERIALBOX_SAVEPOINTQUERY_EQUAL_IMPL(Float64, serialboxFloat64_t, double);
+SERIALBOX_SAVEPOINTQUERY_EQUAL_IMPL(String, const char*, std::string);
+
+#undef SERIALBOX_SAVEPOINTQUERY_EQUAL_IMPL
+
+void serialboxSavepointQueryRange(serialboxSavepointQuery_t* query, const char* key, double lower,
+                                  double upper) {
+  SavepointQuery* q = toSavepointQuery(query);
+  q->range(key, lower, upper);
+}
@@ -0,0 +1,106 @@
+/*===-- serialbox-c/SavepointQuery.h ------------------------------------------------*- C++ -*-===*\
+ *
+ *                                    S E R I A L B O X
+ *
+ * This file is distributed under terms of BSD license.
+ * See LICENSE.txt for more information
+ *
+ *===------------------------------------------------------------------------------------------===//
+ *
+ *! \file
+ *! This file contains the C implementation of the SavepointQuery.
+ *
+\*===------------------------------------------------------------------------------------------===*/
+
+#ifndef SERIALBOX_C_SAVEPOINTQUERY_H
+#define SERIALBOX_C_SAVEPOINTQUERY_H
+
+#include "serialbox-c/Api.h"
+#include "serialbox-c/Type.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \ingroup serialboxC
+ * @{
+ *
+ * \defgroup savepointquery SavepointQuery methods
+ * @{
+ */
+
+/*===------------------------------------------------------------------------------------------===*\
+ *     Construction & Destruction
+\*===------------------------------------------------------------------------------------------===*/
+
+/**
+ * \brief Construct an empty SavepointQuery (matches all savepoints)
+ *
+ * \return pointer to the newly constructed SavepointQuery or NULL if an error occurred
+ */
+SERIALBOX_API serialboxSavepointQuery_t* serialboxSavepointQueryCreate(void);
+
+/**
+ * \brief Destroy the query and deallocate all memory
+ *
+ * \param query  Query to use
+ */
+SERIALBOX_API void serialboxSavepointQueryDestroy(serialboxSavepointQuery_t* query);
+
+/*===------------------------------------------------------------------------------------------===*\
+ *     Predicates
+\*===------------------------------------------------------------------------------------------===*/
+
+/**
+ * \brief Only match savepoints with name `name`
+ *
+ * \param query  Query to use
+ * \param name   Name of the savepoints
+ */
+SERIALBOX_API void serialboxSavepointQuerySetName(serialboxSavepointQuery_t* query,
+                                                  const char* name);
+
+/**
+ * \brief Only match savepoints whose meta-information `key` is equal to `value`
+ *
+ * Numeric values are compared by their value (i.e an Int32 of `1` matches a Float64 of `1.0`),
+ * booleans and strings only match values of the same type.
+ *
+ * \param query  Query to use
+ * \param key    Key of the meta-information
+ * \param value  Value to compare to
+ * @{
+ */
+SERIALBOX_API void serialboxSavepointQueryEqualBoolean(serialboxSavepointQuery_t* query,
+                                                       const char* key, serialboxBoolean_t value);
+SERIALBOX_API void serialboxSavepointQueryEqualInt32(serialboxSavepointQuery_t* query,
+                                                     const char* key, serialboxInt32_t value);
+SERIALBOX_API void serialboxSavepointQueryEqualInt64(serialboxSavepointQuery_t* query,
+                                                     const char* key, serialboxInt64_t value);
+SERIALBOX_API void serialboxSavepointQueryEqualFloat32(serialboxSavepointQuery_t* query,
+                                                       const char* key, serialboxFloat32_t value);
+SERIALBOX_API void serialboxSavepointQueryEqualFloat64(serialboxSavepointQuery_t* query,
+                                                       const char* key, serialboxFloat64_t value);
+SERIALBOX_API void serialboxSavepointQueryEqualString(serialboxSavepointQuery_t* query,
+                                                      const char* key, const char* value);
+/** @} */
+
+/**
+ * \brief Only match savepoints whose (numeric) meta-information `key` is in `[lower, upper)`
+ *
+ * \param query  Query to use
+ * \param key    Key of the meta-information
+ * \param lower  Lower bound (inclusive)
+ * \param upper  Upper bound (exclusive)
+ */
+SERIALBOX_API void serialboxSavepointQueryRange(serialboxSavepointQuery_t* query, const char* key,
+                                                double lower, double upper);
+
+/** @} @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -32,6 +32,7 @@
 #include "serialbox-c/Logging.h"
 #include "serialbox-c/Metainfo.h"
 #include "serialbox-c/Savepoint.h"
+#include "serialbox-c/SavepointQuery.h"
 #include "serialbox-c/Serializer.h"
 #include "serialbox-c/Type.h"
 
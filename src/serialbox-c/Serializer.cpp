@@ -25,6 +25,7 @@
 #include "serialbox/core/StorageView.h"
 #include "serialbox/core/Unreachable.h"
 #include "serialbox/core/archive/ArchiveFactory.h"
+#include <algorithm>
 
 using namespace serialboxC;
 
@@ -169,6 +170,45 @@ int serialboxSerializerHasSavepoint(const serialboxSerializer_t* serializer,
   return ser->savepointVector().exists(*sp);
 }
 
+int serialboxSerializerFindSavepoint(const serialboxSerializer_t* serializer,
+                                     const serialboxSavepoint_t* savepoint) {
+  const Savepoint* sp = toConstSavepoint(savepoint);
+  const Serializer* ser = toConstSerializer(serializer);
+  return ser->findSavepoint(*sp).index();
+}
+
+int serialboxSerializerFindOrAddSavepoint(serialboxSerializer_t* serializer,
+                                          const serialboxSavepoint_t* savepoint) {
+  const Savepoint* sp = toConstSavepoint(savepoint);
+  Serializer* ser = toSerializer(serializer);
+  return ser->findOrRegisterSavepoint(*sp).index();
+}
+
+serialboxArrayOfInt32_t*
+serialboxSerializerQuerySavepoints(const serialboxSerializer_t* serializer,
+                                   const serialboxSavepointQuery_t* query) {
+  const Serializer* ser = toConstSerializer(serializer);
+  const SavepointQuery* q = toConstSavepointQuery(query);
+  serialboxArrayOfInt32_t* array = NULL;
+
+  try {
+    const auto indices = ser->querySavepoints(*q);
+    array = serialboxArrayOfInt32Create(indices.size());
+    std::copy(indices.begin(), indices.end(), array->data);
+  } catch(std::exception& e) {
+    serialboxFatalError(e.what());
+  }
+  return array;
+}
+
+int serialboxSerializerFindNearestSavepoint(const serialboxSerializer_t* serializer,
+                                            const serialboxSavepointQuery_t* query,
+                                            const char* key, double value) {
+  const Serializer* ser = toConstSerializer(serializer);
+  const SavepointQuery* q = toConstSavepointQuery(query);
+  return ser->findNearestSavepoint(*q, key, value);
+}
+
 int serialboxSerializerGetNumSavepoints(const serialboxSerializer_t* serializer) {
   const Serializer* ser = toConstSerializer(serializer);
   return (int)ser->savepointVector().size();
@@ -177,7 +217,7 @@ int serialboxSerializerGetNumSavepoints(const serialboxSerializer_t* serializer)
 serialboxSavepoint_t**
 serialboxSerializerGetSavepointVector(const serialboxSerializer_t* serializer) {
   const Serializer* ser = toConstSerializer(serializer);
-  const auto& savepointVector = ser->savepointVector().savepoints();
+  const auto& savepointVector = ser->savepointVector();
 
   serialboxSavepoint_t** savepoints = allocate<serialboxSavepoint_t*>(savepointVector.size());
 
@@ -186,8 +226,8 @@ serialboxSerializerGetSavepointVector(const serialboxSerializer_t* serializer) {
 
   for(std::size_t i = 0; i < savepointVector.size(); ++i) {
     serialboxSavepoint_t* savepoint = allocate<serialboxSavepoint_t>();
-    savepoint->impl = savepointVector[i].get();
-    savepoint->ownsData = 0;
+    savepoint->impl = new Savepoint(savepointVector.savepointAt(i));
+    savepoint->ownsData = 1;
     savepoints[i] = savepoint;
   }
 
@@ -196,7 +236,7 @@ serialboxSerializerGetSavepointVector(const serialboxSerializer_t* serializer) {
 
 void serialboxSerializerDestroySavepointVector(serialboxSavepoint_t** savepointVector, int len) {
   for(int i = 0; i < len; ++i)
-    std::free(savepointVector[i]);
+    serialboxSavepointDestroy(savepointVector[i]);
   std::free(savepointVector);
 }
 
@@ -327,6 +367,33 @@ serialboxSerializerGetFieldMetainfo(const serialboxSerializer_t* serializer, con
   return NULL;
 }
 
+serialboxFieldHandle_t* serialboxSerializerLookupField(serialboxSerializer_t* serializer,
+                                                       const char* name) {
+  Serializer* ser = toSerializer(serializer);
+  if(!ser->hasField(name))
+    return NULL;
+
+  serialboxFieldHandle_t* field = allocate<serialboxFieldHandle_t>();
+  try {
+    field->impl = new FieldHandle(ser->lookupField(name));
+    field->ownsData = 1;
+  } catch(std::exception& e) {
+    std::free(field);
+    field = NULL;
+    serialboxFatalError(e.what());
+  }
+  return field;
+}
+
+void serialboxFieldHandleDestroy(serialboxFieldHandle_t* field) {
+  if(field) {
+    const FieldHandle* handle = toConstFieldHandle(field);
+    if(field->ownsData)
+      delete handle;
+    std::free(field);
+  }
+}
+
 void serialboxSerializerGetFieldMetainfo2(const serialboxSerializer_t* serializer, const char* name,
                                           char** storedName, char** elementType,
                                           int* bytesPerElement, int* rank, int* iSize, int* jSize,
@@ -386,6 +453,21 @@ serialbox::StorageView makeStorageView(Serializer* ser, const char* name, void*
   return serialbox::StorageView(originPtr, it->second->type(), dims, stridesVec);
 }
 
+serialbox::StorageView makeStorageView(const FieldHandle& field, void* originPtr,
+                                       const int* strides, int numStrides) {
+  const auto& dims = field.info()->dims();
+  std::vector<int> stridesVec(strides, strides + numStrides);
+
+  if(dims.size() != stridesVec.size())
+    throw serialbox::Exception("inconsistent number of dimensions and strides of field '%s'"
+                               "\nDimensions as: [ %s ]"
+                               "\nStrides    as: [ %s ]",
+                               field.name().str(), ::vecToString(dims),
+                               ::vecToString(stridesVec));
+
+  return serialbox::StorageView(originPtr, field.info()->type(), dims, stridesVec);
+}
+
 } // namespace internal
 
 void serialboxSerializerWrite(serialboxSerializer_t* serializer, const char* name,
@@ -418,6 +500,36 @@ void serialboxSerializerRead(serialboxSerializer_t* serializer, const char* name
   }
 }
 
+void serialboxSerializerWriteByHandle(serialboxSerializer_t* serializer,
+                                      const serialboxFieldHandle_t* field, int savepoint,
+                                      void* originPtr, const int* strides, int numStrides) {
+  Serializer* ser = toSerializer(serializer);
+  const FieldHandle* handle = toConstFieldHandle(field);
+
+  try {
+    serialbox::StorageView storageView(
+        internal::makeStorageView(*handle, originPtr, strides, numStrides));
+    ser->write(*handle, serialbox::SavepointHandle(savepoint), storageView);
+  } catch(std::exception& e) {
+    serialboxFatalError(e.what());
+  }
+}
+
+void serialboxSerializerReadByHandle(serialboxSerializer_t* serializer,
+                                     const serialboxFieldHandle_t* field, int savepoint,
+                                     void* originPtr, const int* strides, int numStrides) {
+  Serializer* ser = toSerializer(serializer);
+  const FieldHandle* handle = toConstFieldHandle(field);
+
+  try {
+    serialbox::StorageView storageView(
+        internal::makeStorageView(*handle, originPtr, strides, numStrides));
+    ser->read(*handle, serialbox::SavepointHandle(savepoint), storageView);
+  } catch(std::exception& e) {
+    serialboxFatalError(e.what());
+  }
+}
+
 void serialboxSerializerReadSliced(serialboxSerializer_t* serializer, const char* name,
                                    const serialboxSavepoint_t* savepoint, void* originPtr,
                                    const int* strides, int numStrides, const int* slice) {
@@ -463,6 +575,80 @@ void serialboxSerializerWaitForAll(serialboxSerializer_t* serializer) {
   }
 }
 
+void serialboxSerializerSetFieldCacheSize(serialboxSerializer_t* serializer, size_t bytes) {
+  Serializer* ser = toSerializer(serializer);
+  ser->setFieldCacheSize(bytes);
+}
+
+size_t serialboxSerializerGetFieldCacheSize(const serialboxSerializer_t* serializer) {
+  const Serializer* ser = toConstSerializer(serializer);
+  return ser->fieldCacheSize();
+}
+
+size_t serialboxSerializerGetFieldCacheHits(const serialboxSerializer_t* serializer) {
+  const Serializer* ser = toConstSerializer(serializer);
+  return ser->fieldCacheStatistics().hits;
+}
+
+size_t serialboxSerializerGetFieldCacheMisses(const serialboxSerializer_t* serializer) {
+  const Serializer* ser = toConstSerializer(serializer);
+  return ser->fieldCacheStatistics().misses;
+}
+
+void serialboxSerializerFlushFieldCache(serialboxSerializer_t* serializer) {
+  Serializer* ser = toSerializer(serializer);
+  ser->flushFieldCache();
+}
+
+void serialboxSerializerPrefetch(serialboxSerializer_t* serializer,
+                                 const serialboxSavepoint_t* savepoint, int numSavepoints) {
+  Serializer* ser = toSerializer(serializer);
+  const Savepoint* sp = toConstSavepoint(savepoint);
+  try {
+    ser->prefetch(*sp, numSavepoints);
+  } catch(std::exception& e) {
+    serialboxFatalError(e.what());
+  }
+}
+
+void serialboxSerializerSetPrefetchDepth(serialboxSerializer_t* serializer, int depth) {
+  Serializer* ser = toSerializer(serializer);
+  ser->setPrefetchDepth(depth);
+}
+
+int serialboxSerializerGetPrefetchDepth(const serialboxSerializer_t* serializer) {
+  const Serializer* ser = toConstSerializer(serializer);
+  return ser->prefetchDepth();
+}
+
+void serialboxSerializerSetAccessTraceRecording(serialboxSerializer_t* serializer, int record) {
+  Serializer* ser = toSerializer(serializer);
+  try {
+    ser->setAccessTraceRecording(record);
+  } catch(std::exception& e) {
+    serialboxFatalError(e.what());
+  }
+}
+
+int serialboxSerializerIsRecordingAccessTrace(const serialboxSerializer_t* serializer) {
+  const Serializer* ser = toConstSerializer(serializer);
+  return ser->isRecordingAccessTrace();
+}
+
+void serialboxSerializerReplayAccessTrace(serialboxSerializer_t* serializer, size_t budget) {
+  Serializer* ser = toSerializer(serializer);
+  try {
+    ser->replayAccessTrace(budget);
+  } catch(std::exception& e) {
+    serialboxFatalError(e.what());
+  }
+}
+
+int serialboxSerializerIsReplayingAccessTrace(const serialboxSerializer_t* serializer) {
+  const Serializer* ser = toConstSerializer(serializer);
+  return ser->isReplayingAccessTrace();
+}
+
 /*===------------------------------------------------------------------------------------------===*\
  *     Stateless Serialization
 \*===------------------------------------------------------------------------------------------===*/
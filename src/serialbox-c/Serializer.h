@@ -18,6 +18,7 @@
 #include "serialbox-c/Api.h"
 #include "serialbox-c/Array.h"
 #include "serialbox-c/Type.h"
+#include "stddef.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -159,6 +160,56 @@ SERIALBOX_API int serialboxSerializerAddSavepoint(serialboxSerializer_t* seriali
 SERIALBOX_API int serialboxSerializerHasSavepoint(const serialboxSerializer_t* serializer,
                                                   const serialboxSavepoint_t* savepoint);
 
+/**
+ * \brief Get the handle of `savepoint` for \ref serialboxSerializerWriteByHandle and
+ * \ref serialboxSerializerReadByHandle
+ *
+ * \param serializer  Serializer to use
+ * \param savepoint   Savepoint to search for
+ * \return Handle of the savepoint if savepoint exists, -1 otherwise
+ */
+SERIALBOX_API int serialboxSerializerFindSavepoint(const serialboxSerializer_t* serializer,
+                                                   const serialboxSavepoint_t* savepoint);
+
+/**
+ * \brief Get the handle of `savepoint` and register `savepoint` if it does not exist
+ *
+ * \param serializer  Serializer to use
+ * \param savepoint   Savepoint to search for
+ * \return Handle of the savepoint
+ */
+SERIALBOX_API int serialboxSerializerFindOrAddSavepoint(serialboxSerializer_t* serializer,
+                                                        const serialboxSavepoint_t* savepoint);
+
+/**
+ * \brief Query the savepoints by their name and meta-information
+ *
+ * The query is answered by secondary indexes of the Serializer without materializing the
+ * savepoints.
+ *
+ * \param serializer  Serializer to use
+ * \param query       Query to evaluate
+ * \return Newly allocated array of the handles of the matching savepoints (in the order they were
+ * registered) which needs to be deallocated using \ref serialboxArrayOfInt32Destroy
+ */
+SERIALBOX_API serialboxArrayOfInt32_t*
+serialboxSerializerQuerySavepoints(const serialboxSerializer_t* serializer,
+                                   const serialboxSavepointQuery_t* query);
+
+/**
+ * \brief Find the savepoint which matches `query` and whose (numeric) meta-information `key` is
+ * closest to `value`
+ *
+ * \param serializer  Serializer to use
+ * \param query       Query the savepoint has to match
+ * \param key         Key of the meta-information
+ * \param value       Value to compare to
+ * \return Handle of the savepoint if a savepoint matches, -1 otherwise
+ */
+SERIALBOX_API int serialboxSerializerFindNearestSavepoint(const serialboxSerializer_t* serializer,
+                                                          const serialboxSavepointQuery_t* query,
+                                                          const char* key, double value);
+
 /**
  * \brief Get number of registered savepoints
  *
@@ -168,9 +219,9 @@ SERIALBOX_API int serialboxSerializerHasSavepoint(const serialboxSerializer_t* s
 SERIALBOX_API int serialboxSerializerGetNumSavepoints(const serialboxSerializer_t* serializer);
 
 /**
- * \brief Get an array of \b refrences to the registered savepoints
+ * \brief Get an array of \b copies of the registered savepoints
  *
- * To deallocate the vector use `serialboxSerializerDestroySavepointVector`.
+ * To deallocate the vector (and the savepoints) use `serialboxSerializerDestroySavepointVector`.
  *
  * \param serializer  Serializer to use
  * \param name        Name of the Savepoint(s)
@@ -272,6 +323,25 @@ serialboxSerializerGetFieldnames(const serialboxSerializer_t* serializer);
 SERIALBOX_API serialboxFieldMetainfo_t*
 serialboxSerializerGetFieldMetainfo(const serialboxSerializer_t* serializer, const char* name);
 
+/**
+ * \brief Get the handle of field `name` for \ref serialboxSerializerWriteByHandle and
+ * \ref serialboxSerializerReadByHandle
+ *
+ * To deallocate the handle use \ref serialboxFieldHandleDestroy. The handle is only valid as long
+ * as the serializer is alive.
+ *
+ * \param serializer  Serializer to use
+ * \param name        Name of the field to search for
+ * \return Newly allocated handle if field exists, NULL otherwise
+ */
+SERIALBOX_API serialboxFieldHandle_t*
+serialboxSerializerLookupField(serialboxSerializer_t* serializer, const char* name);
+
+/**
+ * \brief Destroy a field handle obtained via \ref serialboxSerializerLookupField
+ */
+SERIALBOX_API void serialboxFieldHandleDestroy(serialboxFieldHandle_t* field);
+
 /**
  * \brief Get values of standard meta info pairs of field with name `name`
  *
@@ -337,6 +407,42 @@ SERIALBOX_API void serialboxSerializerRead(serialboxSerializer_t* serializer, co
                                            const serialboxSavepoint_t* savepoint, void* originPtr,
                                            const int* strides, int numStrides);
 
+/**
+ * \brief Serialize `field` (given by `originPtr` and `strides`) at `savepoint` to disk
+ *
+ * Same as \ref serialboxSerializerWrite, but the field and savepoint are given by handles (see
+ * \ref serialboxSerializerLookupField and \ref serialboxSerializerFindOrAddSavepoint) which spares
+ * the lookup of the field name and savepoint.
+ *
+ * \param field        Handle of the field
+ * \param savepoint    Handle of the savepoint at which the field will be serialized
+ * \param originPtr    Pointer to the origin of the data
+ * \param strides      Array of strides of length `numStrides` (in unit-strides)
+ * \param numStrides   Number of strides
+ */
+SERIALBOX_API void serialboxSerializerWriteByHandle(serialboxSerializer_t* serializer,
+                                                    const serialboxFieldHandle_t* field,
+                                                    int savepoint, void* originPtr,
+                                                    const int* strides, int numStrides);
+
+/**
+ * \brief Deserialize `field` (given by `originPtr` and `strides`) at `savepoint` from disk
+ *
+ * Same as \ref serialboxSerializerRead, but the field and savepoint are given by handles (see
+ * \ref serialboxSerializerLookupField and \ref serialboxSerializerFindSavepoint) which spares
+ * the lookup of the field name and savepoint.
+ *
+ * \param field        Handle of the field
+ * \param savepoint    Handle of the savepoint at which the field will be deserialized
+ * \param originPtr    Pointer to the origin of the data
+ * \param strides      Array of strides of length `numStrides` (in unit-strides)
+ * \param numStrides   Number of strides
+ */
+SERIALBOX_API void serialboxSerializerReadByHandle(serialboxSerializer_t* serializer,
+                                                   const serialboxFieldHandle_t* field,
+                                                   int savepoint, void* originPtr,
+                                                   const int* strides, int numStrides);
+
 /**
  * \brief Deserialize sliced field `name` (given by `originPtr`, `strides` and `slice`) at
  * `savepoint` from disk
@@ -361,12 +467,12 @@ SERIALBOX_API void serialboxSerializerReadSliced(serialboxSerializer_t* serializ
 
 /**
  * \brief Asynchronously deserialize field `name` (given as `storageView`) at `savepoint` from
- * disk using std::async
+ * disk
  *
  * The `origingPtr` represent the memory location of the first element in the array i.e skipping
- * all initial padding.  This method runs the `read` function (SerializerImpl::read) asynchronously
- * (potentially in a separate thread which may be part of a thread pool) meaning this function
- * immediately returns. To synchronize all threads, use \ref serialboxSerializerWaitForAll.
+ * all initial padding. This method queues the read and immediately returns, the queued reads are
+ * performed in batches by a background thread while the caller continues. The data has to remain
+ * valid until \ref serialboxSerializerWaitForAll returns.
  *
  * If the archive is not thread-safe or if the library was not configured with `SERIALBOX_ASYNC_API`
  * the method falls back to synchronous execution.
@@ -385,10 +491,107 @@ SERIALBOX_API void serialboxSerializerReadAsync(serialboxSerializer_t* serialize
                                                 void* originPtr, const int* strides,
                                                 int numStrides);
 /**
- * \brief Wait for all pending asynchronous read operations and reset the internal queue
+ * \brief Wait until all pending asynchronous read operations are completed
+ *
+ * Errors of the asynchronous reads are reported by this function.
  */
 SERIALBOX_API void serialboxSerializerWaitForAll(serialboxSerializer_t* serializer);
 
+/**
+ * \brief Set the budget in bytes of the cache of deserialized fields (0 disables the cache)
+ *
+ * Repeated reads of the same field and slice are served from an in-memory LRU cache instead of
+ * the archive.
+ *
+ * \see
+ *    serialbox::SerializerImpl::setFieldCacheSize
+ */
+SERIALBOX_API void serialboxSerializerSetFieldCacheSize(serialboxSerializer_t* serializer,
+                                                       size_t bytes);
+
+/**
+ * \brief Get the budget in bytes of the cache of deserialized fields
+ */
+SERIALBOX_API size_t serialboxSerializerGetFieldCacheSize(const serialboxSerializer_t* serializer);
+
+/**
+ * \brief Get the number of reads served by the cache of deserialized fields
+ */
+SERIALBOX_API size_t serialboxSerializerGetFieldCacheHits(const serialboxSerializer_t* serializer);
+
+/**
+ * \brief Get the number of reads which were not served by the cache of deserialized fields
+ */
+SERIALBOX_API size_t
+serialboxSerializerGetFieldCacheMisses(const serialboxSerializer_t* serializer);
+
+/**
+ * \brief Drop all entries of the cache of deserialized fields
+ */
+SERIALBOX_API void serialboxSerializerFlushFieldCache(serialboxSerializer_t* serializer);
+
+/**
+ * \brief Hint that the fields of the `numSavepoints` savepoints following `savepoint` will be read
+ * soon (the data is loaded in the background)
+ *
+ * \see
+ *    serialbox::SerializerImpl::prefetch
+ */
+SERIALBOX_API void serialboxSerializerPrefetch(serialboxSerializer_t* serializer,
+                                               const serialboxSavepoint_t* savepoint,
+                                               int numSavepoints);
+
+/**
+ * \brief Set the number of savepoints which are prefetched automatically after each read
+ * (0 disables automatic prefetching)
+ *
+ * \see
+ *    serialbox::SerializerImpl::setPrefetchDepth
+ */
+SERIALBOX_API void serialboxSerializerSetPrefetchDepth(serialboxSerializer_t* serializer,
+                                                      int depth);
+
+/**
+ * \brief Get the number of savepoints which are prefetched automatically after each read
+ */
+SERIALBOX_API int serialboxSerializerGetPrefetchDepth(const serialboxSerializer_t* serializer);
+
+/**
+ * \brief Start (`record` != 0) or stop recording the reads to the access trace
+ * `AccessTrace-prefix.txt`
+ *
+ * \see
+ *    serialbox::SerializerImpl::setAccessTraceRecording
+ */
+SERIALBOX_API void serialboxSerializerSetAccessTraceRecording(serialboxSerializer_t* serializer,
+                                                             int record);
+
+/**
+ * \brief Check if the reads are recorded to the access trace
+ *
+ * \return 1 if the reads are recorded, 0 otherwise
+ */
+SERIALBOX_API int
+serialboxSerializerIsRecordingAccessTrace(const serialboxSerializer_t* serializer);
+
+/**
+ * \brief Follow the recorded access trace and prefetch the data ahead of the reads within a budget
+ * of `budget` bytes (0 stops following the trace)
+ *
+ * \see
+ *    serialbox::SerializerImpl::replayAccessTrace
+ */
+SERIALBOX_API void serialboxSerializerReplayAccessTrace(serialboxSerializer_t* serializer,
+                                                        size_t budget);
+
+/**
+ * \brief Check if the reads follow the access trace
+ *
+ * \return 1 if the reads follow the access trace, 0 otherwise
+ */
+SERIALBOX_API int
+serialboxSerializerIsReplayingAccessTrace(const serialboxSerializer_t* serializer);
+
 /*===------------------------------------------------------------------------------------------===*\
  *     Stateless Serialization
 \*===------------------------------------------------------------------------------------------===*/
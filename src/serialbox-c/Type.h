@@ -101,6 +101,22 @@ SERIALBOX_API typedef struct {
   int ownsData;
 } serialboxFieldMetainfo_t;
 
+/**
+ * \brief Pre-resolved handle of a field (see \ref serialboxSerializerLookupField)
+ */
+SERIALBOX_API typedef struct {
+  void* impl;
+  int ownsData;
+} serialboxFieldHandle_t;
+
+/**
+ * \brief Query of the savepoints of a Serializer (see \ref serialboxSerializerQuerySavepoints)
+ */
+SERIALBOX_API typedef struct {
+  void* impl;
+  int ownsData;
+} serialboxSavepointQuery_t;
+
 /*===------------------------------------------------------------------------------------------===*\
  *     Enumtypes
 \*===------------------------------------------------------------------------------------------===*/
@@ -25,6 +25,7 @@
 #include "serialbox/core/FieldMetainfoImpl.h"
 #include "serialbox/core/MetainfoMapImpl.h"
 #include "serialbox/core/SavepointImpl.h"
+#include "serialbox/core/SavepointQuery.h"
 #include "serialbox/core/SerializerImpl.h"
 #include <cstdlib>
 #include <cstring>
@@ -35,6 +36,8 @@ using Serializer = serialbox::SerializerImpl;
 using FieldMetainfo = serialbox::FieldMetainfoImpl;
 using Savepoint = serialbox::SavepointImpl;
 using MetainfoMap = serialbox::MetainfoMapImpl;
+using FieldHandle = serialbox::FieldHandle;
+using SavepointQuery = serialbox::SavepointQuery;
 
 /// \brief Convert `serialboxSerializer_t` to `Serializer`
 /// @{
@@ -81,6 +84,28 @@ inline const FieldMetainfo* toConstFieldMetainfo(const serialboxFieldMetainfo_t*
 }
 /// @}
 
+/// \brief Convert `serialboxFieldHandle_t` to `FieldHandle`
+inline const FieldHandle* toConstFieldHandle(const serialboxFieldHandle_t* fieldHandle) {
+  if(!fieldHandle->impl)
+    serialboxFatalError("uninitialized FieldHandle");
+  return reinterpret_cast<const FieldHandle*>(fieldHandle->impl);
+}
+
+/// \brief Convert `serialboxSavepointQuery_t` to `SavepointQuery`
+/// @{
+inline SavepointQuery* toSavepointQuery(serialboxSavepointQuery_t* query) {
+  if(!query->impl)
+    serialboxFatalError("uninitialized SavepointQuery");
+  return reinterpret_cast<SavepointQuery*>(query->impl);
+}
+
+inline const SavepointQuery* toConstSavepointQuery(const serialboxSavepointQuery_t* query) {
+  if(!query->impl)
+    serialboxFatalError("uninitialized SavepointQuery");
+  return reinterpret_cast<const SavepointQuery*>(query->impl);
+}
+/// @}
+
 /// \brief Convert `serialboxMetainfo_t` to `MetainfoMapImpl`
 /// @{
 inline MetainfoMap* toMetainfoMap(serialboxMetainfo_t* metaInfo) {
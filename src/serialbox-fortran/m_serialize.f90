@@ -39,10 +39,11 @@ USE iso_c_binding
 IMPLICIT NONE
 
 PUBLIC :: &
-  t_serializer, t_savepoint, fs_init, &
+  t_serializer, t_savepoint, t_field_handle, fs_init, &
   fs_create_serializer, fs_destroy_serializer, fs_serializer_openmode, fs_add_serializer_metainfo, fs_get_serializer_metainfo, &
   fs_create_savepoint, fs_destroy_savepoint, fs_add_savepoint_metainfo, fs_get_savepoint_metainfo, &
   fs_field_exists, fs_register_field, fs_add_field_metainfo, fs_get_field_metainfo, fs_write_field, fs_read_field, &
+  fs_lookup_field, fs_destroy_field_handle, fs_find_savepoint, fs_find_or_add_savepoint, &
   fs_enable_serialization, fs_disable_serialization, fs_print_debuginfo, &
   fs_get_size, fs_get_halos, fs_get_rank, fs_get_total_size, &
   fs_boolsize, fs_intsize, fs_longsize, fs_floatsize, fs_doublesize, fs_is_serialization_on
@@ -71,6 +72,10 @@ PRIVATE
     CHARACTER(LEN=256) :: savepoint_name = ""
   END TYPE t_savepoint
 
+  TYPE :: t_field_handle
+    TYPE(C_PTR) :: handle_ptr = C_NULL_PTR
+  END TYPE t_field_handle
+
   INTERFACE
      FUNCTION fs_field_exists_(serializer, name) &
           BIND(c, name='serialboxSerializerHasField')
@@ -111,6 +116,30 @@ PRIVATE
      END SUBROUTINE fs_read_field_
   END INTERFACE
 
+  INTERFACE
+     SUBROUTINE fs_write_field_handle_(serializer, field_handle, savepoint_handle, fieldtype, &
+                                       fielddata, iplus1, jplus1, kplus1, lplus1, &
+                                       isize, jsize, ksize, lsize) &
+          BIND(c, name='serialboxFortranSerializerWriteHandle')
+       USE, INTRINSIC :: iso_c_binding
+       TYPE(C_PTR), INTENT(IN), VALUE    :: serializer, field_handle, fielddata, &
+                                            iplus1, jplus1, kplus1, lplus1
+       INTEGER(C_INT), INTENT(IN), VALUE :: savepoint_handle, fieldtype, isize, jsize, ksize, lsize
+     END SUBROUTINE fs_write_field_handle_
+  END INTERFACE
+
+  INTERFACE
+     SUBROUTINE fs_read_field_handle_(serializer, field_handle, savepoint_handle, fieldtype, &
+                                      fielddata, iplus1, jplus1, kplus1, lplus1, &
+                                      isize, jsize, ksize, lsize) &
+          BIND(c, name='serialboxFortranSerializerReadHandle')
+       USE, INTRINSIC :: iso_c_binding
+       TYPE(C_PTR), INTENT(IN), VALUE    :: serializer, field_handle, fielddata, &
+                                            iplus1, jplus1, kplus1, lplus1
+       INTEGER(C_INT), INTENT(IN), VALUE :: savepoint_handle, fieldtype, isize, jsize, ksize, lsize
+     END SUBROUTINE fs_read_field_handle_
+  END INTERFACE
+
   INTERFACE
      SUBROUTINE fs_compute_strides(serializer, fieldname, field, iplus1, jplus1, kplus1, lplus1, &
                            istride, jstride, kstride, lstride) &
@@ -265,7 +294,27 @@ PRIVATE
       fs_write_double_1d, &
       fs_write_double_2d, &
       fs_write_double_3d, &
-      fs_write_double_4d
+      fs_write_double_4d, &
+      fs_write_int_0d_handle, &
+      fs_write_int_1d_handle, &
+      fs_write_int_2d_handle, &
+      fs_write_int_3d_handle, &
+      fs_write_int_4d_handle, &
+      fs_write_long_0d_handle, &
+      fs_write_long_1d_handle, &
+      fs_write_long_2d_handle, &
+      fs_write_long_3d_handle, &
+      fs_write_long_4d_handle, &
+      fs_write_float_0d_handle, &
+      fs_write_float_1d_handle, &
+      fs_write_float_2d_handle, &
+      fs_write_float_3d_handle, &
+      fs_write_float_4d_handle, &
+      fs_write_double_0d_handle, &
+      fs_write_double_1d_handle, &
+      fs_write_double_2d_handle, &
+      fs_write_double_3d_handle, &
+      fs_write_double_4d_handle
   END INTERFACE
 
 
@@ -304,7 +353,27 @@ PRIVATE
       fs_read_double_1d, &
       fs_read_double_2d, &
       fs_read_double_3d, &
-      fs_read_double_4d
+      fs_read_double_4d, &
+      fs_read_int_0d_handle, &
+      fs_read_int_1d_handle, &
+      fs_read_int_2d_handle, &
+      fs_read_int_3d_handle, &
+      fs_read_int_4d_handle, &
+      fs_read_long_0d_handle, &
+      fs_read_long_1d_handle, &
+      fs_read_long_2d_handle, &
+      fs_read_long_3d_handle, &
+      fs_read_long_4d_handle, &
+      fs_read_float_0d_handle, &
+      fs_read_float_1d_handle, &
+      fs_read_float_2d_handle, &
+      fs_read_float_3d_handle, &
+      fs_read_float_4d_handle, &
+      fs_read_double_0d_handle, &
+      fs_read_double_1d_handle, &
+      fs_read_double_2d_handle, &
+      fs_read_double_3d_handle, &
+      fs_read_double_4d_handle
   END INTERFACE
 
   LOGICAL :: enable_savepoint_ID = .FALSE.
@@ -1338,6 +1407,146 @@ SUBROUTINE fs_destroy_savepoint(savepoint)
 END SUBROUTINE fs_destroy_savepoint
 
 
+!==============================================================================
+!+ Module procedure that looks up the handle of a registered field. The handle
+!  allows to store and read the field without looking up its name.
+!------------------------------------------------------------------------------
+SUBROUTINE fs_lookup_field(serializer, fieldname, field_handle)
+  TYPE(t_serializer), INTENT(IN)      :: serializer
+  CHARACTER(LEN=*), INTENT(IN)        :: fieldname
+  TYPE(t_field_handle), INTENT(INOUT) :: field_handle
+
+  ! External function
+  INTERFACE
+     FUNCTION fs_lookup_field_(serializer, name) &
+          BIND(c, name='serialboxSerializerLookupField')
+       USE, INTRINSIC :: iso_c_binding
+       TYPE(C_PTR)                          :: fs_lookup_field_
+       TYPE(C_PTR), INTENT(IN), VALUE       :: serializer
+       CHARACTER(KIND=C_CHAR), DIMENSION(*) :: name
+     END FUNCTION fs_lookup_field_
+  END INTERFACE
+
+  ! Destroy pre-existing handle
+  CALL fs_destroy_field_handle(field_handle)
+
+  field_handle%handle_ptr = fs_lookup_field_(serializer%serializer_ptr, TRIM(fieldname)//C_NULL_CHAR)
+  IF (.NOT. C_ASSOCIATED(field_handle%handle_ptr)) THEN
+    WRITE(*,*) "Serialbox: ERROR: field ", fieldname, " does not exist in the serializer"
+    STOP
+  END IF
+
+END SUBROUTINE fs_lookup_field
+
+
+!==============================================================================
+!+ Module procedure that destroys a field handle.
+!  If the handle has never been looked up, the function does nothing.
+!------------------------------------------------------------------------------
+SUBROUTINE fs_destroy_field_handle(field_handle)
+  TYPE(t_field_handle), INTENT(INOUT) :: field_handle
+
+  ! External function
+  INTERFACE
+     SUBROUTINE fs_destroy_field_handle_(field_handle) &
+          BIND(c, name='serialboxFieldHandleDestroy')
+       USE, INTRINSIC :: iso_c_binding
+       TYPE(C_PTR), VALUE :: field_handle
+     END SUBROUTINE fs_destroy_field_handle_
+  END INTERFACE
+
+  IF (C_ASSOCIATED(field_handle%handle_ptr)) THEN
+    CALL fs_destroy_field_handle_(field_handle%handle_ptr)
+  ENDIF
+
+  field_handle%handle_ptr = C_NULL_PTR
+
+END SUBROUTINE fs_destroy_field_handle
+
+
+!==============================================================================
+!+ Module procedure that checks the halos passed along with a field handle
+!  against the halos the field was registered with.
+!------------------------------------------------------------------------------
+SUBROUTINE fs_check_halos_handle(field_handle, minushalos, plushalos)
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(:), plushalos(:)
+
+  ! External function
+  INTERFACE
+     SUBROUTINE fs_check_halos_handle_(field_handle, iminushalo, iplushalo, jminushalo, jplushalo, &
+                                       kminushalo, kplushalo, lminushalo, lplushalo) &
+          BIND(c, name='serialboxFortranSerializerCheckHalosHandle')
+       USE, INTRINSIC :: iso_c_binding
+       TYPE(C_PTR), INTENT(IN), VALUE    :: field_handle
+       INTEGER(C_INT), INTENT(IN), VALUE :: iminushalo, iplushalo, jminushalo, jplushalo, &
+                                            kminushalo, kplushalo, lminushalo, lplushalo
+     END SUBROUTINE fs_check_halos_handle_
+  END INTERFACE
+
+  ! Local variables
+  INTEGER :: halos(2, 4)
+
+  IF (.NOT. PRESENT(minushalos) .AND. .NOT. PRESENT(plushalos)) RETURN
+
+  halos = 0
+  IF (PRESENT(minushalos)) halos(1, 1:MIN(4, SIZE(minushalos))) = minushalos(1:MIN(4, SIZE(minushalos)))
+  IF (PRESENT(plushalos)) halos(2, 1:MIN(4, SIZE(plushalos))) = plushalos(1:MIN(4, SIZE(plushalos)))
+
+  CALL fs_check_halos_handle_(field_handle%handle_ptr, halos(1, 1), halos(2, 1), halos(1, 2), halos(2, 2), &
+                              halos(1, 3), halos(2, 3), halos(1, 4), halos(2, 4))
+
+END SUBROUTINE fs_check_halos_handle
+
+
+!==============================================================================
+!+ Module function that returns the handle of the given savepoint or -1 if the
+!  savepoint does not exist in the serializer.
+!------------------------------------------------------------------------------
+FUNCTION fs_find_savepoint(serializer, savepoint)
+  TYPE(t_serializer), INTENT(IN) :: serializer
+  TYPE(t_savepoint), INTENT(IN)  :: savepoint
+  INTEGER                        :: fs_find_savepoint
+
+  ! External function
+  INTERFACE
+     FUNCTION fs_find_savepoint_(serializer, savepoint) &
+          BIND(c, name='serialboxSerializerFindSavepoint')
+       USE, INTRINSIC :: iso_c_binding
+       INTEGER(C_INT)                 :: fs_find_savepoint_
+       TYPE(C_PTR), INTENT(IN), VALUE :: serializer, savepoint
+     END FUNCTION fs_find_savepoint_
+  END INTERFACE
+
+  fs_find_savepoint = fs_find_savepoint_(serializer%serializer_ptr, savepoint%savepoint_ptr)
+
+END FUNCTION fs_find_savepoint
+
+
+!==============================================================================
+!+ Module function that returns the handle of the given savepoint and registers
+!  the savepoint if it does not exist in the serializer.
+!------------------------------------------------------------------------------
+FUNCTION fs_find_or_add_savepoint(serializer, savepoint)
+  TYPE(t_serializer), INTENT(IN) :: serializer
+  TYPE(t_savepoint), INTENT(IN)  :: savepoint
+  INTEGER                        :: fs_find_or_add_savepoint
+
+  ! External function
+  INTERFACE
+     FUNCTION fs_find_or_add_savepoint_(serializer, savepoint) &
+          BIND(c, name='serialboxSerializerFindOrAddSavepoint')
+       USE, INTRINSIC :: iso_c_binding
+       INTEGER(C_INT)                 :: fs_find_or_add_savepoint_
+       TYPE(C_PTR), INTENT(IN), VALUE :: serializer, savepoint
+     END FUNCTION fs_find_or_add_savepoint_
+  END INTERFACE
+
+  fs_find_or_add_savepoint = fs_find_or_add_savepoint_(serializer%serializer_ptr, savepoint%savepoint_ptr)
+
+END FUNCTION fs_find_or_add_savepoint
+
+
 SUBROUTINE fs_add_savepoint_metainfo_b(savepoint, key, val)
   TYPE(t_savepoint), INTENT(IN) :: savepoint
   CHARACTER(LEN=*)               :: key
@@ -3247,4 +3456,884 @@ SUBROUTINE fs_read_double_4d(serializer, savepoint, fieldname, field, rperturb)
   END IF
 END SUBROUTINE fs_read_double_4d
 
+!==============================================================================
+!+ Module procedures to store and read the given field at the given savepoint
+!  by handles (see fs_lookup_field and fs_find_savepoint). The handles spare the
+!  lookup of the field name and the savepoint in hot loops. As the field is
+!  registered beforehand, its dimensions are checked against the registered ones
+!  and the optional halos against the registered halos.
+!------------------------------------------------------------------------------
+
+SUBROUTINE fs_write_int_0d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_INT), INTENT(IN), TARGET :: field
+
+  ! Local variables
+  INTEGER(KIND=C_INT), POINTER :: padd
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT32, C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           1, 0, 0, 0)
+END SUBROUTINE fs_write_int_0d_handle
+
+SUBROUTINE fs_write_int_1d_handle(serializer, field_handle, savepoint_handle, field, minushalos, plushalos)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_INT), INTENT(IN), TARGET :: field(:)
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(1), plushalos(1)
+
+  ! Local variables
+  INTEGER(KIND=C_INT), POINTER :: padd(:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_check_halos_handle(field_handle, minushalos, plushalos)
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT32, C_LOC(padd(1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)))), &
+                           C_LOC(padd(1)), &
+                           C_LOC(padd(1)), &
+                           C_LOC(padd(1)), &
+                           SIZE(field, 1), 0, 0, 0)
+END SUBROUTINE fs_write_int_1d_handle
+
+SUBROUTINE fs_write_int_2d_handle(serializer, field_handle, savepoint_handle, field, minushalos, plushalos)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_INT), INTENT(IN), TARGET :: field(:,:)
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(2), plushalos(2)
+
+  ! Local variables
+  INTEGER(KIND=C_INT), POINTER :: padd(:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_check_halos_handle(field_handle, minushalos, plushalos)
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT32, C_LOC(padd(1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)))), &
+                           C_LOC(padd(1, 1)), &
+                           C_LOC(padd(1, 1)), &
+                           SIZE(field, 1), SIZE(field, 2), 0, 0)
+END SUBROUTINE fs_write_int_2d_handle
+
+SUBROUTINE fs_write_int_3d_handle(serializer, field_handle, savepoint_handle, field, minushalos, plushalos)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_INT), INTENT(IN), TARGET :: field(:,:,:)
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(3), plushalos(3)
+
+  ! Local variables
+  INTEGER(KIND=C_INT), POINTER :: padd(:,:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_check_halos_handle(field_handle, minushalos, plushalos)
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT32, C_LOC(padd(1, 1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1, 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)), 1)), &
+                           C_LOC(padd(1, 1, MIN(2, SIZE(field, 3)))), &
+                           C_LOC(padd(1, 1, 1)), &
+                           SIZE(field, 1), SIZE(field, 2), SIZE(field, 3), 0)
+END SUBROUTINE fs_write_int_3d_handle
+
+SUBROUTINE fs_write_int_4d_handle(serializer, field_handle, savepoint_handle, field, minushalos, plushalos)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_INT), INTENT(IN), TARGET :: field(:,:,:,:)
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(4), plushalos(4)
+
+  ! Local variables
+  INTEGER(KIND=C_INT), POINTER :: padd(:,:,:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_check_halos_handle(field_handle, minushalos, plushalos)
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT32, C_LOC(padd(1, 1, 1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1, 1, 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)), 1, 1)), &
+                           C_LOC(padd(1, 1, MIN(2, SIZE(field, 3)), 1)), &
+                           C_LOC(padd(1, 1, 1, MIN(2, SIZE(field, 4)))), &
+                           SIZE(field, 1), SIZE(field, 2), SIZE(field, 3), SIZE(field, 4))
+END SUBROUTINE fs_write_int_4d_handle
+
+SUBROUTINE fs_write_long_0d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_LONG), INTENT(IN), TARGET :: field
+
+  ! Local variables
+  INTEGER(KIND=C_LONG), POINTER :: padd
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT64, C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           1, 0, 0, 0)
+END SUBROUTINE fs_write_long_0d_handle
+
+SUBROUTINE fs_write_long_1d_handle(serializer, field_handle, savepoint_handle, field, minushalos, plushalos)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_LONG), INTENT(IN), TARGET :: field(:)
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(1), plushalos(1)
+
+  ! Local variables
+  INTEGER(KIND=C_LONG), POINTER :: padd(:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_check_halos_handle(field_handle, minushalos, plushalos)
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT64, C_LOC(padd(1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)))), &
+                           C_LOC(padd(1)), &
+                           C_LOC(padd(1)), &
+                           C_LOC(padd(1)), &
+                           SIZE(field, 1), 0, 0, 0)
+END SUBROUTINE fs_write_long_1d_handle
+
+SUBROUTINE fs_write_long_2d_handle(serializer, field_handle, savepoint_handle, field, minushalos, plushalos)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_LONG), INTENT(IN), TARGET :: field(:,:)
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(2), plushalos(2)
+
+  ! Local variables
+  INTEGER(KIND=C_LONG), POINTER :: padd(:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_check_halos_handle(field_handle, minushalos, plushalos)
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT64, C_LOC(padd(1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)))), &
+                           C_LOC(padd(1, 1)), &
+                           C_LOC(padd(1, 1)), &
+                           SIZE(field, 1), SIZE(field, 2), 0, 0)
+END SUBROUTINE fs_write_long_2d_handle
+
+SUBROUTINE fs_write_long_3d_handle(serializer, field_handle, savepoint_handle, field, minushalos, plushalos)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_LONG), INTENT(IN), TARGET :: field(:,:,:)
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(3), plushalos(3)
+
+  ! Local variables
+  INTEGER(KIND=C_LONG), POINTER :: padd(:,:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_check_halos_handle(field_handle, minushalos, plushalos)
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT64, C_LOC(padd(1, 1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1, 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)), 1)), &
+                           C_LOC(padd(1, 1, MIN(2, SIZE(field, 3)))), &
+                           C_LOC(padd(1, 1, 1)), &
+                           SIZE(field, 1), SIZE(field, 2), SIZE(field, 3), 0)
+END SUBROUTINE fs_write_long_3d_handle
+
+SUBROUTINE fs_write_long_4d_handle(serializer, field_handle, savepoint_handle, field, minushalos, plushalos)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_LONG), INTENT(IN), TARGET :: field(:,:,:,:)
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(4), plushalos(4)
+
+  ! Local variables
+  INTEGER(KIND=C_LONG), POINTER :: padd(:,:,:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_check_halos_handle(field_handle, minushalos, plushalos)
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT64, C_LOC(padd(1, 1, 1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1, 1, 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)), 1, 1)), &
+                           C_LOC(padd(1, 1, MIN(2, SIZE(field, 3)), 1)), &
+                           C_LOC(padd(1, 1, 1, MIN(2, SIZE(field, 4)))), &
+                           SIZE(field, 1), SIZE(field, 2), SIZE(field, 3), SIZE(field, 4))
+END SUBROUTINE fs_write_long_4d_handle
+
+SUBROUTINE fs_write_float_0d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_FLOAT), INTENT(IN), TARGET :: field
+
+  ! Local variables
+  REAL(KIND=C_FLOAT), POINTER :: padd
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT32, C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           1, 0, 0, 0)
+END SUBROUTINE fs_write_float_0d_handle
+
+SUBROUTINE fs_write_float_1d_handle(serializer, field_handle, savepoint_handle, field, minushalos, plushalos)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_FLOAT), INTENT(IN), TARGET :: field(:)
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(1), plushalos(1)
+
+  ! Local variables
+  REAL(KIND=C_FLOAT), POINTER :: padd(:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_check_halos_handle(field_handle, minushalos, plushalos)
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT32, C_LOC(padd(1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)))), &
+                           C_LOC(padd(1)), &
+                           C_LOC(padd(1)), &
+                           C_LOC(padd(1)), &
+                           SIZE(field, 1), 0, 0, 0)
+END SUBROUTINE fs_write_float_1d_handle
+
+SUBROUTINE fs_write_float_2d_handle(serializer, field_handle, savepoint_handle, field, minushalos, plushalos)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_FLOAT), INTENT(IN), TARGET :: field(:,:)
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(2), plushalos(2)
+
+  ! Local variables
+  REAL(KIND=C_FLOAT), POINTER :: padd(:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_check_halos_handle(field_handle, minushalos, plushalos)
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT32, C_LOC(padd(1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)))), &
+                           C_LOC(padd(1, 1)), &
+                           C_LOC(padd(1, 1)), &
+                           SIZE(field, 1), SIZE(field, 2), 0, 0)
+END SUBROUTINE fs_write_float_2d_handle
+
+SUBROUTINE fs_write_float_3d_handle(serializer, field_handle, savepoint_handle, field, minushalos, plushalos)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_FLOAT), INTENT(IN), TARGET :: field(:,:,:)
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(3), plushalos(3)
+
+  ! Local variables
+  REAL(KIND=C_FLOAT), POINTER :: padd(:,:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_check_halos_handle(field_handle, minushalos, plushalos)
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT32, C_LOC(padd(1, 1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1, 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)), 1)), &
+                           C_LOC(padd(1, 1, MIN(2, SIZE(field, 3)))), &
+                           C_LOC(padd(1, 1, 1)), &
+                           SIZE(field, 1), SIZE(field, 2), SIZE(field, 3), 0)
+END SUBROUTINE fs_write_float_3d_handle
+
+SUBROUTINE fs_write_float_4d_handle(serializer, field_handle, savepoint_handle, field, minushalos, plushalos)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_FLOAT), INTENT(IN), TARGET :: field(:,:,:,:)
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(4), plushalos(4)
+
+  ! Local variables
+  REAL(KIND=C_FLOAT), POINTER :: padd(:,:,:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_check_halos_handle(field_handle, minushalos, plushalos)
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT32, C_LOC(padd(1, 1, 1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1, 1, 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)), 1, 1)), &
+                           C_LOC(padd(1, 1, MIN(2, SIZE(field, 3)), 1)), &
+                           C_LOC(padd(1, 1, 1, MIN(2, SIZE(field, 4)))), &
+                           SIZE(field, 1), SIZE(field, 2), SIZE(field, 3), SIZE(field, 4))
+END SUBROUTINE fs_write_float_4d_handle
+
+SUBROUTINE fs_write_double_0d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_DOUBLE), INTENT(IN), TARGET :: field
+
+  ! Local variables
+  REAL(KIND=C_DOUBLE), POINTER :: padd
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT64, C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           1, 0, 0, 0)
+END SUBROUTINE fs_write_double_0d_handle
+
+SUBROUTINE fs_write_double_1d_handle(serializer, field_handle, savepoint_handle, field, minushalos, plushalos)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_DOUBLE), INTENT(IN), TARGET :: field(:)
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(1), plushalos(1)
+
+  ! Local variables
+  REAL(KIND=C_DOUBLE), POINTER :: padd(:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_check_halos_handle(field_handle, minushalos, plushalos)
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT64, C_LOC(padd(1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)))), &
+                           C_LOC(padd(1)), &
+                           C_LOC(padd(1)), &
+                           C_LOC(padd(1)), &
+                           SIZE(field, 1), 0, 0, 0)
+END SUBROUTINE fs_write_double_1d_handle
+
+SUBROUTINE fs_write_double_2d_handle(serializer, field_handle, savepoint_handle, field, minushalos, plushalos)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_DOUBLE), INTENT(IN), TARGET :: field(:,:)
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(2), plushalos(2)
+
+  ! Local variables
+  REAL(KIND=C_DOUBLE), POINTER :: padd(:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_check_halos_handle(field_handle, minushalos, plushalos)
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT64, C_LOC(padd(1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)))), &
+                           C_LOC(padd(1, 1)), &
+                           C_LOC(padd(1, 1)), &
+                           SIZE(field, 1), SIZE(field, 2), 0, 0)
+END SUBROUTINE fs_write_double_2d_handle
+
+SUBROUTINE fs_write_double_3d_handle(serializer, field_handle, savepoint_handle, field, minushalos, plushalos)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_DOUBLE), INTENT(IN), TARGET :: field(:,:,:)
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(3), plushalos(3)
+
+  ! Local variables
+  REAL(KIND=C_DOUBLE), POINTER :: padd(:,:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_check_halos_handle(field_handle, minushalos, plushalos)
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT64, C_LOC(padd(1, 1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1, 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)), 1)), &
+                           C_LOC(padd(1, 1, MIN(2, SIZE(field, 3)))), &
+                           C_LOC(padd(1, 1, 1)), &
+                           SIZE(field, 1), SIZE(field, 2), SIZE(field, 3), 0)
+END SUBROUTINE fs_write_double_3d_handle
+
+SUBROUTINE fs_write_double_4d_handle(serializer, field_handle, savepoint_handle, field, minushalos, plushalos)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_DOUBLE), INTENT(IN), TARGET :: field(:,:,:,:)
+  INTEGER, INTENT(IN), OPTIONAL    :: minushalos(4), plushalos(4)
+
+  ! Local variables
+  REAL(KIND=C_DOUBLE), POINTER :: padd(:,:,:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_check_halos_handle(field_handle, minushalos, plushalos)
+  CALL fs_write_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT64, C_LOC(padd(1, 1, 1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1, 1, 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)), 1, 1)), &
+                           C_LOC(padd(1, 1, MIN(2, SIZE(field, 3)), 1)), &
+                           C_LOC(padd(1, 1, 1, MIN(2, SIZE(field, 4)))), &
+                           SIZE(field, 1), SIZE(field, 2), SIZE(field, 3), SIZE(field, 4))
+END SUBROUTINE fs_write_double_4d_handle
+
+SUBROUTINE fs_read_int_0d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_INT), INTENT(OUT), TARGET :: field
+
+  ! Local variables
+  INTEGER(KIND=C_INT), POINTER :: padd
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT32, C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           1, 0, 0, 0)
+END SUBROUTINE fs_read_int_0d_handle
+
+SUBROUTINE fs_read_int_1d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_INT), INTENT(OUT), TARGET :: field(:)
+
+  ! Local variables
+  INTEGER(KIND=C_INT), POINTER :: padd(:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT32, C_LOC(padd(1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)))), &
+                           C_LOC(padd(1)), &
+                           C_LOC(padd(1)), &
+                           C_LOC(padd(1)), &
+                           SIZE(field, 1), 0, 0, 0)
+END SUBROUTINE fs_read_int_1d_handle
+
+SUBROUTINE fs_read_int_2d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_INT), INTENT(OUT), TARGET :: field(:,:)
+
+  ! Local variables
+  INTEGER(KIND=C_INT), POINTER :: padd(:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT32, C_LOC(padd(1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)))), &
+                           C_LOC(padd(1, 1)), &
+                           C_LOC(padd(1, 1)), &
+                           SIZE(field, 1), SIZE(field, 2), 0, 0)
+END SUBROUTINE fs_read_int_2d_handle
+
+SUBROUTINE fs_read_int_3d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_INT), INTENT(OUT), TARGET :: field(:,:,:)
+
+  ! Local variables
+  INTEGER(KIND=C_INT), POINTER :: padd(:,:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT32, C_LOC(padd(1, 1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1, 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)), 1)), &
+                           C_LOC(padd(1, 1, MIN(2, SIZE(field, 3)))), &
+                           C_LOC(padd(1, 1, 1)), &
+                           SIZE(field, 1), SIZE(field, 2), SIZE(field, 3), 0)
+END SUBROUTINE fs_read_int_3d_handle
+
+SUBROUTINE fs_read_int_4d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_INT), INTENT(OUT), TARGET :: field(:,:,:,:)
+
+  ! Local variables
+  INTEGER(KIND=C_INT), POINTER :: padd(:,:,:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT32, C_LOC(padd(1, 1, 1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1, 1, 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)), 1, 1)), &
+                           C_LOC(padd(1, 1, MIN(2, SIZE(field, 3)), 1)), &
+                           C_LOC(padd(1, 1, 1, MIN(2, SIZE(field, 4)))), &
+                           SIZE(field, 1), SIZE(field, 2), SIZE(field, 3), SIZE(field, 4))
+END SUBROUTINE fs_read_int_4d_handle
+
+SUBROUTINE fs_read_long_0d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_LONG), INTENT(OUT), TARGET :: field
+
+  ! Local variables
+  INTEGER(KIND=C_LONG), POINTER :: padd
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT64, C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           1, 0, 0, 0)
+END SUBROUTINE fs_read_long_0d_handle
+
+SUBROUTINE fs_read_long_1d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_LONG), INTENT(OUT), TARGET :: field(:)
+
+  ! Local variables
+  INTEGER(KIND=C_LONG), POINTER :: padd(:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT64, C_LOC(padd(1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)))), &
+                           C_LOC(padd(1)), &
+                           C_LOC(padd(1)), &
+                           C_LOC(padd(1)), &
+                           SIZE(field, 1), 0, 0, 0)
+END SUBROUTINE fs_read_long_1d_handle
+
+SUBROUTINE fs_read_long_2d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_LONG), INTENT(OUT), TARGET :: field(:,:)
+
+  ! Local variables
+  INTEGER(KIND=C_LONG), POINTER :: padd(:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT64, C_LOC(padd(1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)))), &
+                           C_LOC(padd(1, 1)), &
+                           C_LOC(padd(1, 1)), &
+                           SIZE(field, 1), SIZE(field, 2), 0, 0)
+END SUBROUTINE fs_read_long_2d_handle
+
+SUBROUTINE fs_read_long_3d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_LONG), INTENT(OUT), TARGET :: field(:,:,:)
+
+  ! Local variables
+  INTEGER(KIND=C_LONG), POINTER :: padd(:,:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT64, C_LOC(padd(1, 1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1, 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)), 1)), &
+                           C_LOC(padd(1, 1, MIN(2, SIZE(field, 3)))), &
+                           C_LOC(padd(1, 1, 1)), &
+                           SIZE(field, 1), SIZE(field, 2), SIZE(field, 3), 0)
+END SUBROUTINE fs_read_long_3d_handle
+
+SUBROUTINE fs_read_long_4d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  INTEGER(KIND=C_LONG), INTENT(OUT), TARGET :: field(:,:,:,:)
+
+  ! Local variables
+  INTEGER(KIND=C_LONG), POINTER :: padd(:,:,:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_INT64, C_LOC(padd(1, 1, 1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1, 1, 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)), 1, 1)), &
+                           C_LOC(padd(1, 1, MIN(2, SIZE(field, 3)), 1)), &
+                           C_LOC(padd(1, 1, 1, MIN(2, SIZE(field, 4)))), &
+                           SIZE(field, 1), SIZE(field, 2), SIZE(field, 3), SIZE(field, 4))
+END SUBROUTINE fs_read_long_4d_handle
+
+SUBROUTINE fs_read_float_0d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_FLOAT), INTENT(OUT), TARGET :: field
+
+  ! Local variables
+  REAL(KIND=C_FLOAT), POINTER :: padd
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT32, C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           1, 0, 0, 0)
+END SUBROUTINE fs_read_float_0d_handle
+
+SUBROUTINE fs_read_float_1d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_FLOAT), INTENT(OUT), TARGET :: field(:)
+
+  ! Local variables
+  REAL(KIND=C_FLOAT), POINTER :: padd(:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT32, C_LOC(padd(1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)))), &
+                           C_LOC(padd(1)), &
+                           C_LOC(padd(1)), &
+                           C_LOC(padd(1)), &
+                           SIZE(field, 1), 0, 0, 0)
+END SUBROUTINE fs_read_float_1d_handle
+
+SUBROUTINE fs_read_float_2d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_FLOAT), INTENT(OUT), TARGET :: field(:,:)
+
+  ! Local variables
+  REAL(KIND=C_FLOAT), POINTER :: padd(:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT32, C_LOC(padd(1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)))), &
+                           C_LOC(padd(1, 1)), &
+                           C_LOC(padd(1, 1)), &
+                           SIZE(field, 1), SIZE(field, 2), 0, 0)
+END SUBROUTINE fs_read_float_2d_handle
+
+SUBROUTINE fs_read_float_3d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_FLOAT), INTENT(OUT), TARGET :: field(:,:,:)
+
+  ! Local variables
+  REAL(KIND=C_FLOAT), POINTER :: padd(:,:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT32, C_LOC(padd(1, 1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1, 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)), 1)), &
+                           C_LOC(padd(1, 1, MIN(2, SIZE(field, 3)))), &
+                           C_LOC(padd(1, 1, 1)), &
+                           SIZE(field, 1), SIZE(field, 2), SIZE(field, 3), 0)
+END SUBROUTINE fs_read_float_3d_handle
+
+SUBROUTINE fs_read_float_4d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_FLOAT), INTENT(OUT), TARGET :: field(:,:,:,:)
+
+  ! Local variables
+  REAL(KIND=C_FLOAT), POINTER :: padd(:,:,:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT32, C_LOC(padd(1, 1, 1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1, 1, 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)), 1, 1)), &
+                           C_LOC(padd(1, 1, MIN(2, SIZE(field, 3)), 1)), &
+                           C_LOC(padd(1, 1, 1, MIN(2, SIZE(field, 4)))), &
+                           SIZE(field, 1), SIZE(field, 2), SIZE(field, 3), SIZE(field, 4))
+END SUBROUTINE fs_read_float_4d_handle
+
+SUBROUTINE fs_read_double_0d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_DOUBLE), INTENT(OUT), TARGET :: field
+
+  ! Local variables
+  REAL(KIND=C_DOUBLE), POINTER :: padd
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT64, C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           C_LOC(padd), &
+                           1, 0, 0, 0)
+END SUBROUTINE fs_read_double_0d_handle
+
+SUBROUTINE fs_read_double_1d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_DOUBLE), INTENT(OUT), TARGET :: field(:)
+
+  ! Local variables
+  REAL(KIND=C_DOUBLE), POINTER :: padd(:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT64, C_LOC(padd(1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)))), &
+                           C_LOC(padd(1)), &
+                           C_LOC(padd(1)), &
+                           C_LOC(padd(1)), &
+                           SIZE(field, 1), 0, 0, 0)
+END SUBROUTINE fs_read_double_1d_handle
+
+SUBROUTINE fs_read_double_2d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_DOUBLE), INTENT(OUT), TARGET :: field(:,:)
+
+  ! Local variables
+  REAL(KIND=C_DOUBLE), POINTER :: padd(:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT64, C_LOC(padd(1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)))), &
+                           C_LOC(padd(1, 1)), &
+                           C_LOC(padd(1, 1)), &
+                           SIZE(field, 1), SIZE(field, 2), 0, 0)
+END SUBROUTINE fs_read_double_2d_handle
+
+SUBROUTINE fs_read_double_3d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_DOUBLE), INTENT(OUT), TARGET :: field(:,:,:)
+
+  ! Local variables
+  REAL(KIND=C_DOUBLE), POINTER :: padd(:,:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT64, C_LOC(padd(1, 1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1, 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)), 1)), &
+                           C_LOC(padd(1, 1, MIN(2, SIZE(field, 3)))), &
+                           C_LOC(padd(1, 1, 1)), &
+                           SIZE(field, 1), SIZE(field, 2), SIZE(field, 3), 0)
+END SUBROUTINE fs_read_double_3d_handle
+
+SUBROUTINE fs_read_double_4d_handle(serializer, field_handle, savepoint_handle, field)
+  TYPE(t_serializer), INTENT(IN)   :: serializer
+  TYPE(t_field_handle), INTENT(IN) :: field_handle
+  INTEGER, INTENT(IN)              :: savepoint_handle
+  REAL(KIND=C_DOUBLE), INTENT(OUT), TARGET :: field(:,:,:,:)
+
+  ! Local variables
+  REAL(KIND=C_DOUBLE), POINTER :: padd(:,:,:,:)
+
+  ! This workaround is needed for gcc < 4.9
+  padd=>field
+
+  CALL fs_read_field_handle_(serializer%serializer_ptr, field_handle%handle_ptr, savepoint_handle, &
+                           SERIALBOX_FIELD_TYPE_FLOAT64, C_LOC(padd(1, 1, 1, 1)), &
+                           C_LOC(padd(MIN(2, SIZE(field, 1)), 1, 1, 1)), &
+                           C_LOC(padd(1, MIN(2, SIZE(field, 2)), 1, 1)), &
+                           C_LOC(padd(1, 1, MIN(2, SIZE(field, 3)), 1)), &
+                           C_LOC(padd(1, 1, 1, MIN(2, SIZE(field, 4)))), &
+                           SIZE(field, 1), SIZE(field, 2), SIZE(field, 3), SIZE(field, 4))
+END SUBROUTINE fs_read_double_4d_handle
+
 END MODULE m_serialize
@@ -43,12 +43,12 @@ from .type import TypeID, OpenModeKind
 from .error import SerialboxError
 from .serlogging import Logging
 from .serializer import Serializer
-from .savepoint import Savepoint, SavepointCollection
+from .savepoint import Savepoint, SavepointCollection, SavepointQuery
 from .metainfomap import MetainfoMap
 from .fieldmetainfo import FieldMetainfo
 from .archive import Archive
 from .slice import Slice
 
 __all__ = ['Config', 'TypeID', 'SerialboxError', 'Logging', 'Serializer', 'Savepoint',
-           'SavepointCollection', 'MetainfoMap', 'FieldMetainfo', 'OpenModeKind', 'Archive',
-           'Slice']
+           'SavepointCollection', 'SavepointQuery', 'MetainfoMap', 'FieldMetainfo', 'OpenModeKind',
+           'Archive', 'Slice']
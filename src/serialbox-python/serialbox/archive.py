@@ -58,6 +58,7 @@ class Archive(object):
         Extensions   Archives
         ===========  ========
          .dat, .bin  Binary
+         .pack       PackedBinary
          .nc         NetCDF
         ===========  ========
 
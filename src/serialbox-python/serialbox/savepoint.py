@@ -14,12 +14,14 @@
 ##===------------------------------------------------------------------------------------------===##
 
 from abc import ABCMeta
-from ctypes import c_char_p, c_void_p, c_int, Structure, POINTER, c_size_t
+from ctypes import (c_char_p, c_void_p, c_int, Structure, POINTER, c_size_t, c_bool, c_int32,
+                    c_int64, c_float, c_double)
 
 from .common import get_library, to_c_string
 from .error import invoke, SerialboxError
 from .metainfomap import MetainfoMap, MetainfoImpl
-from .type import StringTypes
+from .type import (BooleanTypes, Int32Types, Int64Types, Float32Types, Float64Types,
+                   StringTypes)
 from .util import levenshtein
 
 lib = get_library()
@@ -30,6 +32,11 @@ class SavepointImpl(Structure):
     _fields_ = [("impl", c_void_p), ("ownsData", c_int)]
 
 
+class SavepointQueryImpl(Structure):
+    """ Mapping of serialboxSavepointQuery_t """
+    _fields_ = [("impl", c_void_p), ("ownsData", c_int)]
+
+
 def register_library(library):
     library.serialboxSavepointCreate.argtypes = [c_char_p]
     library.serialboxSavepointCreate.restype = POINTER(SavepointImpl)
@@ -55,6 +62,43 @@ def register_library(library):
     library.serialboxSavepointGetMetainfo.argtypes = [POINTER(SavepointImpl)]
     library.serialboxSavepointGetMetainfo.restype = POINTER(MetainfoImpl)
 
+    library.serialboxSavepointQueryCreate.argtypes = None
+    library.serialboxSavepointQueryCreate.restype = POINTER(SavepointQueryImpl)
+
+    library.serialboxSavepointQueryDestroy.argtypes = [POINTER(SavepointQueryImpl)]
+    library.serialboxSavepointQueryDestroy.restype = None
+
+    library.serialboxSavepointQuerySetName.argtypes = [POINTER(SavepointQueryImpl), c_char_p]
+    library.serialboxSavepointQuerySetName.restype = None
+
+    library.serialboxSavepointQueryEqualBoolean.argtypes = [POINTER(SavepointQueryImpl), c_char_p,
+                                                           c_bool]
+    library.serialboxSavepointQueryEqualBoolean.restype = None
+
+    library.serialboxSavepointQueryEqualInt32.argtypes = [POINTER(SavepointQueryImpl), c_char_p,
+                                                         c_int32]
+    library.serialboxSavepointQueryEqualInt32.restype = None
+
+    library.serialboxSavepointQueryEqualInt64.argtypes = [POINTER(SavepointQueryImpl), c_char_p,
+                                                         c_int64]
+    library.serialboxSavepointQueryEqualInt64.restype = None
+
+    library.serialboxSavepointQueryEqualFloat32.argtypes = [POINTER(SavepointQueryImpl), c_char_p,
+                                                           c_float]
+    library.serialboxSavepointQueryEqualFloat32.restype = None
+
+    library.serialboxSavepointQueryEqualFloat64.argtypes = [POINTER(SavepointQueryImpl), c_char_p,
+                                                           c_double]
+    library.serialboxSavepointQueryEqualFloat64.restype = None
+
+    library.serialboxSavepointQueryEqualString.argtypes = [POINTER(SavepointQueryImpl), c_char_p,
+                                                          c_char_p]
+    library.serialboxSavepointQueryEqualString.restype = None
+
+    library.serialboxSavepointQueryRange.argtypes = [POINTER(SavepointQueryImpl), c_char_p,
+                                                    c_double, c_double]
+    library.serialboxSavepointQueryRange.restype = None
+
 
 # ===--------------------------------------------------------------------------------------------===
 #   Savepoint
@@ -434,4 +478,94 @@ class SavepointNamedCollection(SavepointCollection):
             return self.__make_named_savepoint_collection(index, True)
 
 
+# ===--------------------------------------------------------------------------------------------===
+#   SavepointQuery
+# ==---------------------------------------------------------------------------------------------===
+
+class SavepointQuery(object):
+    """Query of the savepoints of a :class:`Serializer <serialbox.Serializer>` by their name and
+    meta-information (see :func:`Serializer.query_savepoints
+    <serialbox.Serializer.query_savepoints>`).
+
+    A savepoint matches the query if it has the requested name (if any) and satisfies all
+    predicates on its meta-information. Numeric values are compared by their value, booleans and
+    strings only match values of the same type.
+
+        >>> query = SavepointQuery('step').range('time', 100, 200)
+        >>> ser.query_savepoints(query)
+        [100, 101, 102, ...]
+        >>>
+
+    The query is answered by indexes of the Serializer and yields the handles of the savepoints
+    (which can be passed to :func:`Serializer.read <serialbox.Serializer.read>`) without
+    constructing :class:`Savepoint <serialbox.Savepoint>` objects.
+    """
+
+    def __init__(self, name=None):
+        """Initialize the query.
+
+        :param str name: Only match savepoints with this name (optional)
+        """
+        self.__query = invoke(lib.serialboxSavepointQueryCreate)
+        if name is not None:
+            self.name(name)
+
+    def name(self, name):
+        """Only match savepoints named `name`.
+
+        :param str name: Name of the savepoints
+        :return: The query
+        :rtype: SavepointQuery
+        """
+        invoke(lib.serialboxSavepointQuerySetName, self.__query, to_c_string(name)[0])
+        return self
+
+    def equal(self, key, value):
+        """Only match savepoints whose meta-information `key` is equal to `value`.
+
+        :param str key: Key of the meta-information
+        :param value: Value to compare to
+        :return: The query
+        :rtype: SavepointQuery
+        :raises serialbox.SerialboxError: if the type of `value` is not supported
+        """
+        keystr = to_c_string(key)[0]
+        if isinstance(value, BooleanTypes):
+            invoke(lib.serialboxSavepointQueryEqualBoolean, self.__query, keystr, c_bool(value))
+        elif isinstance(value, Int32Types):
+            invoke(lib.serialboxSavepointQueryEqualInt32, self.__query, keystr, c_int32(value))
+        elif isinstance(value, Int64Types):
+            invoke(lib.serialboxSavepointQueryEqualInt64, self.__query, keystr, c_int64(value))
+        elif isinstance(value, Float32Types):
+            invoke(lib.serialboxSavepointQueryEqualFloat32, self.__query, keystr, c_float(value))
+        elif isinstance(value, Float64Types):
+            invoke(lib.serialboxSavepointQueryEqualFloat64, self.__query, keystr, c_double(value))
+        elif isinstance(value, StringTypes):
+            invoke(lib.serialboxSavepointQueryEqualString, self.__query, keystr,
+                   to_c_string(value)[0])
+        else:
+            raise SerialboxError(
+                "could not deduce type-id of key '%s' (python type: %s)" % (key, type(value)))
+        return self
+
+    def range(self, key, lower, upper):
+        """Only match savepoints whose (numeric) meta-information `key` is in `[lower, upper)`.
+
+        :param str key: Key of the meta-information
+        :param lower: Lower bound (inclusive)
+        :param upper: Upper bound (exclusive)
+        :return: The query
+        :rtype: SavepointQuery
+        """
+        invoke(lib.serialboxSavepointQueryRange, self.__query, to_c_string(key)[0],
+               c_double(lower), c_double(upper))
+        return self
+
+    def impl(self):
+        return self.__query
+
+    def __del__(self):
+        invoke(lib.serialboxSavepointQueryDestroy, self.__query)
+
+
 register_library(lib)
@@ -13,7 +13,7 @@
 ##
 ##===------------------------------------------------------------------------------------------===##
 
-from ctypes import c_char_p, c_void_p, c_int, Structure, POINTER
+from ctypes import c_char_p, c_void_p, c_int, c_size_t, c_double, Structure, POINTER
 
 import numpy as np
 
@@ -21,8 +21,9 @@ from .archive import Archive
 from .common import get_library, to_c_string
 from .error import invoke, SerialboxError
 from .fieldmetainfo import FieldMetainfo, FieldMetainfoImpl
-from .metainfomap import MetainfoMap, MetainfoImpl, ArrayOfStringImpl
-from .savepoint import Savepoint, SavepointImpl, SavepointTopCollection, SavepointCollection
+from .metainfomap import MetainfoMap, MetainfoImpl, ArrayOfInt32Impl, ArrayOfStringImpl
+from .savepoint import (Savepoint, SavepointImpl, SavepointTopCollection, SavepointCollection,
+                        SavepointQuery, SavepointQueryImpl)
 from .type import *
 
 lib = get_library()
@@ -33,6 +34,11 @@ class SerializerImpl(Structure):
     _fields_ = [("impl", c_void_p), ("ownsData", c_int)]
 
 
+class FieldHandleImpl(Structure):
+    """ Mapping of serialboxFieldHandle_t """
+    _fields_ = [("impl", c_void_p), ("ownsData", c_int)]
+
+
 def register_library(library):
     #
     # Construction & Destruction
@@ -87,6 +93,24 @@ def register_library(library):
                                                         POINTER(SavepointImpl)]
     library.serialboxSerializerHasSavepoint.restype = c_int
 
+    library.serialboxSerializerFindSavepoint.argtypes = [POINTER(SerializerImpl),
+                                                         POINTER(SavepointImpl)]
+    library.serialboxSerializerFindSavepoint.restype = c_int
+
+    library.serialboxSerializerFindOrAddSavepoint.argtypes = [POINTER(SerializerImpl),
+                                                              POINTER(SavepointImpl)]
+    library.serialboxSerializerFindOrAddSavepoint.restype = c_int
+
+    library.serialboxSerializerQuerySavepoints.argtypes = [POINTER(SerializerImpl),
+                                                           POINTER(SavepointQueryImpl)]
+    library.serialboxSerializerQuerySavepoints.restype = POINTER(ArrayOfInt32Impl)
+
+    library.serialboxSerializerFindNearestSavepoint.argtypes = [POINTER(SerializerImpl),
+                                                                POINTER(SavepointQueryImpl),
+                                                                c_char_p,
+                                                                c_double]
+    library.serialboxSerializerFindNearestSavepoint.restype = c_int
+
     library.serialboxSerializerGetNumSavepoints.argtypes = [POINTER(SerializerImpl)]
     library.serialboxSerializerGetNumSavepoints.restype = c_int
 
@@ -120,6 +144,12 @@ def register_library(library):
     library.serialboxSerializerGetFieldnames.argtypes = [POINTER(SerializerImpl)]
     library.serialboxSerializerGetFieldnames.restype = POINTER(ArrayOfStringImpl)
 
+    library.serialboxSerializerLookupField.argtypes = [POINTER(SerializerImpl), c_char_p]
+    library.serialboxSerializerLookupField.restype = POINTER(FieldHandleImpl)
+
+    library.serialboxFieldHandleDestroy.argtypes = [POINTER(FieldHandleImpl)]
+    library.serialboxFieldHandleDestroy.restype = None
+
     #
     # Writing & Reading
     #
@@ -139,6 +169,22 @@ def register_library(library):
                                                 c_int]
     library.serialboxSerializerRead.restype = None
 
+    library.serialboxSerializerWriteByHandle.argtypes = [POINTER(SerializerImpl),
+                                                         POINTER(FieldHandleImpl),
+                                                         c_int,
+                                                         c_void_p,
+                                                         POINTER(c_int),
+                                                         c_int]
+    library.serialboxSerializerWriteByHandle.restype = None
+
+    library.serialboxSerializerReadByHandle.argtypes = [POINTER(SerializerImpl),
+                                                        POINTER(FieldHandleImpl),
+                                                        c_int,
+                                                        c_void_p,
+                                                        POINTER(c_int),
+                                                        c_int]
+    library.serialboxSerializerReadByHandle.restype = None
+
     library.serialboxSerializerReadSliced.argtypes = [POINTER(SerializerImpl),
                                                       c_char_p,
                                                       POINTER(SavepointImpl),
@@ -159,6 +205,44 @@ def register_library(library):
     library.serialboxSerializerWaitForAll.argtypes = [POINTER(SerializerImpl)]
     library.serialboxSerializerWaitForAll.restype = None
 
+    library.serialboxSerializerSetFieldCacheSize.argtypes = [POINTER(SerializerImpl), c_size_t]
+    library.serialboxSerializerSetFieldCacheSize.restype = None
+
+    library.serialboxSerializerGetFieldCacheSize.argtypes = [POINTER(SerializerImpl)]
+    library.serialboxSerializerGetFieldCacheSize.restype = c_size_t
+
+    library.serialboxSerializerGetFieldCacheHits.argtypes = [POINTER(SerializerImpl)]
+    library.serialboxSerializerGetFieldCacheHits.restype = c_size_t
+
+    library.serialboxSerializerGetFieldCacheMisses.argtypes = [POINTER(SerializerImpl)]
+    library.serialboxSerializerGetFieldCacheMisses.restype = c_size_t
+
+    library.serialboxSerializerFlushFieldCache.argtypes = [POINTER(SerializerImpl)]
+    library.serialboxSerializerFlushFieldCache.restype = None
+
+    library.serialboxSerializerPrefetch.argtypes = [POINTER(SerializerImpl),
+                                                    POINTER(SavepointImpl),
+                                                    c_int]
+    library.serialboxSerializerPrefetch.restype = None
+
+    library.serialboxSerializerSetPrefetchDepth.argtypes = [POINTER(SerializerImpl), c_int]
+    library.serialboxSerializerSetPrefetchDepth.restype = None
+
+    library.serialboxSerializerGetPrefetchDepth.argtypes = [POINTER(SerializerImpl)]
+    library.serialboxSerializerGetPrefetchDepth.restype = c_int
+
+    library.serialboxSerializerSetAccessTraceRecording.argtypes = [POINTER(SerializerImpl), c_int]
+    library.serialboxSerializerSetAccessTraceRecording.restype = None
+
+    library.serialboxSerializerIsRecordingAccessTrace.argtypes = [POINTER(SerializerImpl)]
+    library.serialboxSerializerIsRecordingAccessTrace.restype = c_int
+
+    library.serialboxSerializerReplayAccessTrace.argtypes = [POINTER(SerializerImpl), c_size_t]
+    library.serialboxSerializerReplayAccessTrace.restype = None
+
+    library.serialboxSerializerIsReplayingAccessTrace.argtypes = [POINTER(SerializerImpl)]
+    library.serialboxSerializerIsReplayingAccessTrace.restype = c_int
+
     #
     # Stateless Serialization
     #
@@ -189,6 +273,52 @@ def register_library(library):
     library.serialboxArrayOfStringDestroy.restype = None
 
 
+class FieldHandle(object):
+    """Pre-resolved handle of a registered field.
+
+    Handles are obtained from :func:`Serializer.lookup_field <serialbox.Serializer.lookup_field>`
+    and can be passed to :func:`Serializer.write <serialbox.Serializer.write>` and
+    :func:`Serializer.read <serialbox.Serializer.read>` instead of the name of the field (together
+    with a savepoint handle obtained from
+    :func:`Serializer.find_savepoint <serialbox.Serializer.find_savepoint>`), which spares the
+    lookup of the field name and savepoint.
+    """
+
+    def __init__(self, name, fieldmetainfo, handle):
+        self.__name = name
+        self.__dims = list(fieldmetainfo.dims)
+        self.__type = fieldmetainfo.type
+        self.__handle = handle
+
+    @property
+    def name(self):
+        """ Name of the field
+        """
+        return self.__name
+
+    @property
+    def dims(self):
+        """ Dimensions of the field
+        """
+        return self.__dims
+
+    @property
+    def type(self):
+        """ Type of the field
+        """
+        return self.__type
+
+    def impl(self):
+        return self.__handle
+
+    def __del__(self):
+        if self.__handle:
+            invoke(lib.serialboxFieldHandleDestroy, self.__handle)
+
+    def __repr__(self):
+        return "<FieldHandle name = %s>" % self.__name
+
+
 class Serializer(object):
     """Serializer implementation of the Python Interface.
 
@@ -399,6 +529,67 @@ class Serializer(object):
             raise SerialboxError(
                 "savepoint '%s' already exists withing the Serializer" % (savepoint.__str__()))
 
+    def find_savepoint(self, savepoint):
+        """Get the handle of `savepoint` which can be passed to
+        :func:`Serializer.write <serialbox.Serializer.write>` and
+        :func:`Serializer.read <serialbox.Serializer.read>`.
+
+        :param savepoint: Savepoint to search for
+        :type savepoint: Savepoint
+        :return: Handle of the savepoint if Savepoint exists, -1 otherwise
+        :rtype: int
+        """
+        return invoke(lib.serialboxSerializerFindSavepoint, self.__serializer, savepoint.impl())
+
+    def find_or_register_savepoint(self, savepoint):
+        """Get the handle of `savepoint` and register `savepoint` if it does not exist.
+
+        :param savepoint: Savepoint to search for
+        :type savepoint: Savepoint
+        :return: Handle of the savepoint
+        :rtype: int
+        """
+        if self.mode == OpenModeKind.Read:
+            raise SerialboxError("registering savepoints is not permitted in OpenModeKind.Read")
+
+        return invoke(lib.serialboxSerializerFindOrAddSavepoint, self.__serializer,
+                      savepoint.impl())
+
+    def query_savepoints(self, query):
+        """Query the savepoints by their name and meta-information.
+
+            >>> ser.query_savepoints(SavepointQuery('step').range('step', 100, 200))
+            [100, 101, 102, ...]
+            >>>
+
+        The query is answered by indexes of the Serializer without constructing
+        :class:`Savepoint <serialbox.Savepoint>` objects.
+
+        :param query: Query to evaluate
+        :type query: SavepointQuery
+        :return: Handles of the matching savepoints (in the order they were registered)
+        :rtype: :class:`list` [:class:`int`]
+        """
+        array = invoke(lib.serialboxSerializerQuerySavepoints, self.__serializer, query.impl())
+        handles = [array.contents.data[i] for i in range(array.contents.len)]
+        invoke(lib.serialboxArrayOfInt32Destroy, array)
+        return handles
+
+    def find_nearest_savepoint(self, key, value, query=None):
+        """Find the savepoint whose (numeric) meta-information `key` is closest to `value`.
+
+        :param str key: Key of the meta-information
+        :param value: Value to compare to
+        :param query: Query the savepoint has to match (optional)
+        :type query: SavepointQuery
+        :return: Handle of the savepoint if a savepoint matches, -1 otherwise
+        :rtype: int
+        """
+        if query is None:
+            query = SavepointQuery()
+        return invoke(lib.serialboxSerializerFindNearestSavepoint, self.__serializer, query.impl(),
+                      to_c_string(key)[0], c_double(value))
+
     def has_savepoint(self, savepoint):
         """Check if `savepoint` exists within the Serializer.
 
@@ -598,6 +789,29 @@ class Serializer(object):
                              impl=invoke(lib.serialboxSerializerGetFieldMetainfo, self.__serializer,
                                          fieldstr))
 
+    def lookup_field(self, name):
+        """Get the handle of field `name` which can be passed to
+        :func:`Serializer.write <serialbox.Serializer.write>` and
+        :func:`Serializer.read <serialbox.Serializer.read>` instead of the name.
+
+            >>> ser = Serializer(OpenModeKind.Write, ".", "field", "Binary")
+            >>> ser.register_field("myfield", FieldMetainfo(TypeID.Float64, [3, 3]))
+            >>> handle = ser.lookup_field("myfield")
+            >>> savepoint = ser.find_or_register_savepoint(Savepoint("mysavepoint"))
+            >>> ser.write(handle, savepoint, np.random.rand(3, 3))
+
+        :param name: Name of the field
+        :type name: str
+        :return: Handle of the field
+        :rtype: :class:`FieldHandle <serialbox.serializer.FieldHandle>`
+        :raises serialbox.SerialboxError: if `field` does not exist within the Serializer
+        """
+        namestr = to_c_string(name)[0]
+        handle = invoke(lib.serialboxSerializerLookupField, self.__serializer, namestr)
+        if not handle:
+            raise SerialboxError("field '%s' is not registered within the Serializer" % name)
+        return FieldHandle(name, self.get_field_metainfo(name), handle)
+
     def fieldnames(self):
         """Get a list of registered fieldnames within the Serializer.
 
@@ -667,12 +881,32 @@ class Serializer(object):
 
         return (field, info,)
 
+    @staticmethod
+    def __check_field_of_handle(handle, field):
+        """Check the numpy field for consistency with the field of `handle`
+        """
+        if list(field.shape) != handle.dims:
+            raise SerialboxError(
+                "registered dimensions %s do not match dimensions of field (%s) %s" % (
+                    field.shape, handle.name, handle.dims))
+
+        if numpy2TypeID(field.dtype) != handle.type:
+            raise SerialboxError(
+                "registered type %s does not match type of field (%s) %s" % (
+                    numpy2TypeID(field.dtype), handle.name, handle.type))
+
     def write(self, name, savepoint, field, register_field=True):
         """ Serialize `field` identified by `name` at `savepoint` to disk
 
         The `savepoint` will be registered at field `name` if not yet present. If `register_field`
         is `True`, the field will be registered if necessary.
 
+        Alternatively, the field and savepoint can be given by handles (see
+        :func:`Serializer.lookup_field <serialbox.Serializer.lookup_field>` and
+        :func:`Serializer.find_or_register_savepoint
+        <serialbox.Serializer.find_or_register_savepoint>`), which spares the lookup of the field
+        name and savepoint.
+
             >>> ser = Serializer(OpenModeKind.Write, ".", "field", "Binary")
             >>> field = np.random.rand(3,3)
             >>> ser.write("myfield", Savepoint("mysavepoint"), field)
@@ -681,10 +915,11 @@ class Serializer(object):
             >>> ser.fields_at_savepoint(Savepoint("mysavepoint"))
             ['myfield']
 
-        :param name: Name of the field
-        :type name: str
-        :param savepoint: Savepoint at which the field will be serialized
-        :type savepoint: Savepoint
+        :param name: Name or handle of the field
+        :type name: str, FieldHandle
+        :param savepoint: Savepoint (or handle of the savepoint) at which the field will be
+                          serialized
+        :type savepoint: Savepoint, int
         :param field: Field to serialize
         :type field: numpy.array
         :param register_field: Register the field if not present
@@ -695,6 +930,13 @@ class Serializer(object):
         if self.mode == OpenModeKind.Read:
             raise SerialboxError("write operations are not permitted in OpenModeKind.Read")
 
+        if isinstance(name, FieldHandle):
+            self.__check_field_of_handle(name, field)
+            strides, num_strides = self.__extract_strides(field)
+            invoke(lib.serialboxSerializerWriteByHandle, self.__serializer, name.impl(), savepoint,
+                   c_void_p(field.ctypes.data), strides, num_strides)
+            return
+
         savepoint = self.__extract_savepoint(savepoint)
 
         if not self.has_field(name):
@@ -735,10 +977,16 @@ class Serializer(object):
                    [ 0.94684836,  0.12496717,  0.47460455],
                    [ 0.11462436,  0.86608157,  0.57855988]])
 
-        :param name: Name of the field
-        :type name: str
-        :param savepoint: Savepoint at which the field will be deserialized
-        :type savepoint: Savepoint
+        Alternatively, the field and savepoint can be given by handles (see
+        :func:`Serializer.lookup_field <serialbox.Serializer.lookup_field>` and
+        :func:`Serializer.find_savepoint <serialbox.Serializer.find_savepoint>`), which spares the
+        lookup of the field name and savepoint.
+
+        :param name: Name or handle of the field
+        :type name: str, FieldHandle
+        :param savepoint: Savepoint (or handle of the savepoint) at which the field will be
+                          deserialized
+        :type savepoint: Savepoint, int
         :param field: Field to fill or ``None``
         :type field: numpy.array
         :return: Newly allocated and deserialized field
@@ -748,6 +996,16 @@ class Serializer(object):
         if self.mode != OpenModeKind.Read:
             raise SerialboxError("read operations are not permitted in OpenModeKind.%s" % self.mode)
 
+        if isinstance(name, FieldHandle):
+            if field is None:
+                field = np.ndarray(shape=name.dims, dtype=typeID2numpy(name.type))
+            else:
+                self.__check_field_of_handle(name, field)
+            strides, num_strides = self.__extract_strides(field)
+            invoke(lib.serialboxSerializerReadByHandle, self.__serializer, name.impl(), savepoint,
+                   c_void_p(field.ctypes.data), strides, num_strides)
+            return field
+
         savepoint = self.__extract_savepoint(savepoint)
 
         #
@@ -777,10 +1035,9 @@ class Serializer(object):
         If `field` is ``None``, a new :class:`numpy.array <numpy.array>` will be allocated with
         the registered dimensions and type.
 
-        This method runs the :func:`Serializer.read <serialbox.Serializer.read>` function
-        asynchronously (potentially in a separate thread which may be part of a thread pool),
-        meaning this function immediately returns. To synchronize all threads, use
-        :func:`Serializer.wait_for_all <serialbox.Serializer.wait_for_all>`.
+        This method queues the read and immediately returns. The queued reads are performed in
+        batches by a background thread, meaning `field` is only guaranteed to be filled once
+        :func:`Serializer.wait_for_all <serialbox.Serializer.wait_for_all>` returns.
 
         If the archive is not thread-safe or if the library was not configured with
         ``SERIALBOX_ASYNC_API`` the method falls back to synchronous execution.
@@ -829,7 +1086,9 @@ class Serializer(object):
         return field
 
     def wait_for_all(self):
-        """ Wait for all pending asynchronous read operations and reset the internal queue.
+        """ Wait for all pending asynchronous read operations to complete.
+
+        :raises SerialboxError: An asynchronous read failed
         """
         invoke(lib.serialboxSerializerWaitForAll, self.__serializer)
 
@@ -945,6 +1204,134 @@ class Serializer(object):
 
         return field
 
+    @property
+    def field_cache_size(self):
+        """ Budget in bytes of the in-memory cache of deserialized fields.
+
+        Repeated reads of the same field (i.e the same data on disk) and slice are served from an
+        LRU cache instead of the archive. A budget of 0 (the default) disables the cache.
+
+            >>> ser = Serializer(OpenModeKind.Read, ".", "field", "Binary")
+            >>> ser.field_cache_size = 512 * 1024 * 1024
+            >>> field = ser.read("field", Savepoint("sp"))
+            >>> field = ser.read("field", Savepoint("sp"))
+            >>> ser.field_cache_hits, ser.field_cache_misses
+            (1, 1)
+
+        :return: Budget in bytes
+        :rtype: int
+        """
+        return invoke(lib.serialboxSerializerGetFieldCacheSize, self.__serializer)
+
+    @field_cache_size.setter
+    def field_cache_size(self, size):
+        invoke(lib.serialboxSerializerSetFieldCacheSize, self.__serializer, size)
+
+    @property
+    def field_cache_hits(self):
+        """ Number of reads served by the cache of deserialized fields.
+
+        :rtype: int
+        """
+        return invoke(lib.serialboxSerializerGetFieldCacheHits, self.__serializer)
+
+    @property
+    def field_cache_misses(self):
+        """ Number of reads which were not served by the cache of deserialized fields.
+
+        :rtype: int
+        """
+        return invoke(lib.serialboxSerializerGetFieldCacheMisses, self.__serializer)
+
+    def flush_field_cache(self):
+        """ Drop all entries of the cache of deserialized fields.
+        """
+        invoke(lib.serialboxSerializerFlushFieldCache, self.__serializer)
+
+    def prefetch(self, savepoint, num_savepoints=1):
+        """ Hint that the fields of the `num_savepoints` savepoints following `savepoint` will be
+        read soon. The data is loaded in the background and the method returns immediately.
+
+        :param savepoint: Savepoint after which the fields will be prefetched
+        :type savepoint: Savepoint
+        :param num_savepoints: Number of savepoints to prefetch
+        :type num_savepoints: int
+        :raises SerialboxError: Savepoint does not exist
+        """
+        savepoint = self.__extract_savepoint(savepoint)
+        invoke(lib.serialboxSerializerPrefetch, self.__serializer, savepoint.impl(),
+               num_savepoints)
+
+    @property
+    def prefetch_depth(self):
+        """ Number of savepoints which are prefetched automatically after each read.
+
+        Replaying the savepoints in order, each read prefetches the fields of the following
+        savepoints. A depth of 0 (the default) disables automatic prefetching.
+
+            >>> ser = Serializer(OpenModeKind.Read, ".", "field", "Binary")
+            >>> ser.prefetch_depth = 2
+            >>> for sp in ser.savepoint_list():
+            ...     field = ser.read("field", sp)
+
+        :rtype: int
+        """
+        return invoke(lib.serialboxSerializerGetPrefetchDepth, self.__serializer)
+
+    @prefetch_depth.setter
+    def prefetch_depth(self, depth):
+        invoke(lib.serialboxSerializerSetPrefetchDepth, self.__serializer, depth)
+
+    @property
+    def record_access_trace(self):
+        """ Record the reads to the access trace `AccessTrace-prefix.txt`.
+
+        The field, savepoint and slice of each read are appended to the trace, which is
+        overwritten when the recording starts. Later replays which read the archive in the same
+        order can follow the trace to prefetch the data (see
+        :func:`Serializer.replay_access_trace`).
+
+            >>> ser = Serializer(OpenModeKind.Read, ".", "field", "Binary")
+            >>> ser.record_access_trace = True
+            >>> for sp in ser.savepoint_list():
+            ...     field = ser.read("field", sp)
+            >>> ser.record_access_trace = False
+
+        :rtype: bool
+        :raises SerialboxError: Access trace cannot be created
+        """
+        return bool(invoke(lib.serialboxSerializerIsRecordingAccessTrace, self.__serializer))
+
+    @record_access_trace.setter
+    def record_access_trace(self, record):
+        invoke(lib.serialboxSerializerSetAccessTraceRecording, self.__serializer, int(record))
+
+    def replay_access_trace(self, budget):
+        """ Follow the recorded access trace and prefetch the data ahead of the reads.
+
+        The reads of the trace are loaded into the field cache in the background as long as the
+        data which was prefetched but not yet read fits into `budget` bytes. The field cache is
+        enlarged to the budget if necessary. A budget of 0 stops following the trace.
+
+            >>> ser = Serializer(OpenModeKind.Read, ".", "field", "Binary")
+            >>> ser.replay_access_trace(256 * 1024 * 1024)
+            >>> for sp in ser.savepoint_list():
+            ...     field = ser.read("field", sp)
+
+        :param budget: Maximum number of bytes which are prefetched ahead of the reads
+        :type budget: int
+        :raises SerialboxError: Access trace does not exist or is corrupted
+        """
+        invoke(lib.serialboxSerializerReplayAccessTrace, self.__serializer, budget)
+
+    @property
+    def replaying_access_trace(self):
+        """ Check if the reads follow the access trace.
+
+        :rtype: bool
+        """
+        return bool(invoke(lib.serialboxSerializerIsReplayingAccessTrace, self.__serializer))
+
     # ===----------------------------------------------------------------------------------------===
     #    Stateless Serialization
     # ==-----------------------------------------------------------------------------------------===
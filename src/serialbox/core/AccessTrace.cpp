@@ -0,0 +1,178 @@
+//===-- serialbox/core/AccessTrace.cpp ----------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements the access trace of the reads of a Serializer.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/AccessTrace.h"
+#include "serialbox/core/Exception.h"
+#include <algorithm>
+#include <sstream>
+
+namespace serialbox {
+
+//===------------------------------------------------------------------------------------------===//
+//     AccessTrace
+//===------------------------------------------------------------------------------------------===//
+
+bool AccessTrace::Access::matches(const FieldID& id,
+                                  const std::vector<SliceTriple>& triples) const noexcept {
+  if(fieldID != id || slice.size() != triples.size())
+    return false;
+  for(std::size_t i = 0; i < slice.size(); ++i)
+    if(slice[i].start != triples[i].start || slice[i].stop != triples[i].stop ||
+       slice[i].step != triples[i].step)
+      return false;
+  return true;
+}
+
+const char* AccessTrace::Magic = "serialbox-access-trace";
+
+const int AccessTrace::Version = 0;
+
+std::string AccessTrace::filename(const std::string& prefix) {
+  return "AccessTrace-" + prefix + ".txt";
+}
+
+AccessTrace AccessTrace::fromFile(const std::string& filename) {
+  std::ifstream stream(filename);
+  if(!stream.is_open())
+    throw Exception("cannot open access trace '%s'", filename);
+
+  std::string line;
+  int version = -1;
+  {
+    std::getline(stream, line);
+    std::istringstream header(line);
+    std::string magic;
+    if(!(header >> magic >> version) || magic != Magic)
+      throw Exception("'%s' is not an access trace", filename);
+    if(version != Version)
+      throw Exception("access trace '%s' has version %i (expected %i)", filename, version,
+                      Version);
+  }
+
+  AccessTrace trace;
+  for(int lineNumber = 2; std::getline(stream, line); ++lineNumber) {
+    if(line.empty())
+      continue;
+
+    // <savepoint> <id> <number of slice triples> [<start> <stop> <step>]... <field>
+    std::istringstream ss(line);
+    Access access;
+    int numTriples = 0;
+    bool valid = bool(ss >> access.savepoint >> access.fieldID.id >> numTriples);
+    valid = valid && numTriples >= 0;
+    for(int i = 0; valid && i < numTriples; ++i) {
+      SliceTriple triple;
+      valid = bool(ss >> triple.start >> triple.stop >> triple.step);
+      access.slice.push_back(triple);
+    }
+    std::string name;
+    valid = valid && ss.get() == ' ' && std::getline(ss, name) && !name.empty();
+    access.fieldID.name = name;
+
+    if(!valid)
+      throw Exception("corrupted access trace '%s' (line %i)", filename, lineNumber);
+    trace.push_back(std::move(access));
+  }
+  return trace;
+}
+
+void AccessTrace::toFile(const std::string& filename) const {
+  std::ofstream stream(filename, std::ios::out | std::ios::trunc);
+  if(!stream.is_open())
+    throw Exception("cannot create access trace '%s'", filename);
+
+  writeHeader(stream);
+  for(const Access& access : accesses_)
+    writeAccess(stream, access);
+}
+
+void AccessTrace::writeHeader(std::ostream& stream) {
+  stream << Magic << ' ' << Version << '\n';
+}
+
+void AccessTrace::writeAccess(std::ostream& stream, const Access& access) {
+  stream << access.savepoint << ' ' << access.fieldID.id << ' ' << access.slice.size();
+  for(const SliceTriple& triple : access.slice)
+    stream << ' ' << triple.start << ' ' << triple.stop << ' ' << triple.step;
+  stream << ' ' << access.fieldID.name << '\n';
+}
+
+//===------------------------------------------------------------------------------------------===//
+//     AccessTraceRecorder
+//===------------------------------------------------------------------------------------------===//
+
+AccessTraceRecorder::AccessTraceRecorder(const std::string& filename) : filename_(filename) {
+  stream_.open(filename, std::ios::out | std::ios::trunc);
+  if(!stream_.is_open())
+    throw Exception("cannot create access trace '%s'", filename);
+  AccessTrace::writeHeader(stream_);
+}
+
+void AccessTraceRecorder::record(const AccessTrace::Access& access) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  AccessTrace::writeAccess(stream_, access);
+}
+
+//===------------------------------------------------------------------------------------------===//
+//     AccessTraceFollower
+//===------------------------------------------------------------------------------------------===//
+
+const std::size_t AccessTraceFollower::DefaultLookAhead = 1024;
+
+AccessTraceFollower::AccessTraceFollower(AccessTrace trace, std::vector<std::size_t> sizes,
+                                         std::size_t budget, std::size_t lookAhead)
+    : trace_(std::move(trace)), sizes_(std::move(sizes)), prefetched_(trace_.size(), false),
+      budget_(budget), lookAhead_(lookAhead) {
+  if(sizes_.size() != trace_.size())
+    throw Exception("number of sizes (%i) does not match the number of accesses (%i)",
+                    sizes_.size(), trace_.size());
+}
+
+bool AccessTraceFollower::advance(const FieldID& fieldID, const std::vector<SliceTriple>& slice) {
+  // Reads which are not part of the trace only cost a scan of the look-ahead window
+  const std::size_t end = cursor_ + std::min(lookAhead_, trace_.size() - cursor_);
+  std::size_t i = cursor_;
+  while(i < end && !trace_[i].matches(fieldID, slice))
+    ++i;
+  if(i == end)
+    return false;
+
+  // Accesses which were skipped by the replay are released as well
+  for(std::size_t j = cursor_; j <= i; ++j) {
+    if(prefetched_[j]) {
+      bytesInFlight_ -= sizes_[j];
+      prefetched_[j] = false;
+    }
+  }
+  cursor_ = i + 1;
+  scheduled_ = std::max(scheduled_, cursor_);
+  return true;
+}
+
+std::vector<std::size_t> AccessTraceFollower::schedule() {
+  std::vector<std::size_t> accesses;
+  for(; scheduled_ < trace_.size(); ++scheduled_) {
+    const std::size_t size = sizes_[scheduled_];
+    if(size > budget_)
+      continue;
+    if(bytesInFlight_ + size > budget_)
+      break;
+    bytesInFlight_ += size;
+    prefetched_[scheduled_] = true;
+    accesses.push_back(scheduled_);
+  }
+  return accesses;
+}
+
+} // namespace serialbox
@@ -0,0 +1,184 @@
+//===-- serialbox/core/AccessTrace.h ------------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the access trace of the reads of a Serializer which is used to prefetch
+/// the data of repeated replays.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_ACCESSTRACE_H
+#define SERIALBOX_CORE_ACCESSTRACE_H
+
+#include "serialbox/core/FieldID.h"
+#include "serialbox/core/Slice.h"
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace serialbox {
+
+/// \addtogroup core
+/// @{
+
+/// \brief Recorded sequence of reads of a Serializer
+///
+/// Each access consists of the FieldID, the index of the savepoint and the slice of a read. The
+/// trace is stored in the sidecar file `AccessTrace-prefix.txt` next to `MetaData-prefix.json`
+/// (one access per line) by the AccessTraceRecorder and can be followed by later replays of the
+/// same reads to prefetch the data ahead of the reads (see AccessTraceFollower).
+class AccessTrace {
+public:
+  /// \brief Read of a field
+  struct Access {
+    FieldID fieldID;                ///< Field which was read
+    int savepoint;                  ///< Index of the requested savepoint
+    std::vector<SliceTriple> slice; ///< Slice of the read (empty if the field is not sliced)
+
+    /// \brief Check if the access reads `fieldID` with `slice`
+    bool matches(const FieldID& fieldID, const std::vector<SliceTriple>& slice) const noexcept;
+  };
+
+  /// \brief Identifier of access trace files
+  static const char* Magic;
+
+  /// \brief Revision of the file format
+  static const int Version;
+
+  /// \brief Name of the access trace file of the serializer with `prefix`
+  static std::string filename(const std::string& prefix);
+
+  /// \brief Read the access trace from `filename`
+  ///
+  /// \throw Exception  File cannot be opened or is corrupted
+  static AccessTrace fromFile(const std::string& filename);
+
+  /// \brief Write the access trace to `filename` (existing files are overwritten)
+  ///
+  /// \throw Exception  File cannot be created
+  void toFile(const std::string& filename) const;
+
+  /// \brief Append `access` to the trace
+  void push_back(Access access) { accesses_.push_back(std::move(access)); }
+
+  /// \brief Number of recorded accesses
+  std::size_t size() const noexcept { return accesses_.size(); }
+
+  /// \brief Check if the trace is empty
+  bool empty() const noexcept { return accesses_.empty(); }
+
+  /// \brief Access the `i-th` access
+  const Access& operator[](std::size_t i) const noexcept { return accesses_[i]; }
+
+  /// \brief Iterators of the accesses
+  std::vector<Access>::const_iterator begin() const noexcept { return accesses_.begin(); }
+  std::vector<Access>::const_iterator end() const noexcept { return accesses_.end(); }
+
+  /// \brief Write the header of access trace files to `stream`
+  static void writeHeader(std::ostream& stream);
+
+  /// \brief Write `access` as a single line to `stream`
+  static void writeAccess(std::ostream& stream, const Access& access);
+
+private:
+  std::vector<Access> accesses_;
+};
+
+/// \brief Record the reads of a Serializer to an access trace file
+///
+/// Each access is appended to the file as it is recorded, the file is created (or truncated) on
+/// construction. Recording is thread-safe.
+class AccessTraceRecorder {
+public:
+  /// \brief Create the access trace file `filename`
+  ///
+  /// \throw Exception  File cannot be created
+  explicit AccessTraceRecorder(const std::string& filename);
+
+  AccessTraceRecorder(const AccessTraceRecorder&) = delete;
+  AccessTraceRecorder& operator=(const AccessTraceRecorder&) = delete;
+
+  /// \brief Append `access` to the file
+  void record(const AccessTrace::Access& access);
+
+  /// \brief Get the name of the access trace file
+  const std::string& filename() const noexcept { return filename_; }
+
+private:
+  std::string filename_;
+  std::mutex mutex_;
+  std::ofstream stream_;
+};
+
+/// \brief Follow an AccessTrace during a replay and schedule the accesses ahead of the reads
+///
+/// The follower keeps a cursor to the next expected access. The accesses after the cursor are
+/// scheduled for prefetching as long as the data which was prefetched but not yet read fits into
+/// the memory budget. A read moves the cursor past the next matching access within the look-ahead
+/// window of the trace, reads which are not part of the window are ignored. Accesses larger than
+/// the budget are never prefetched.
+///
+/// The follower is not thread-safe.
+class AccessTraceFollower {
+public:
+  /// \brief Default number of accesses after the cursor which are matched against a read
+  static const std::size_t DefaultLookAhead;
+
+  /// \brief Follow `trace` with a memory budget of `budget` bytes
+  ///
+  /// \param trace      Access trace to follow
+  /// \param sizes      Size in bytes of the data of each access of the trace
+  /// \param budget     Maximum number of bytes which are prefetched ahead of the reads
+  /// \param lookAhead  Number of accesses after the cursor which are matched against a read
+  AccessTraceFollower(AccessTrace trace, std::vector<std::size_t> sizes, std::size_t budget,
+                      std::size_t lookAhead = DefaultLookAhead);
+
+  /// \brief Register the read of `fieldID` with `slice`
+  ///
+  /// \return True iff the read is part of the trace (within the look-ahead window of the cursor)
+  bool advance(const FieldID& fieldID, const std::vector<SliceTriple>& slice);
+
+  /// \brief Get the indices of the next accesses to prefetch which fit into the budget
+  ///
+  /// The returned accesses are accounted to the budget until they are read.
+  std::vector<std::size_t> schedule();
+
+  /// \brief Get the followed trace
+  const AccessTrace& trace() const noexcept { return trace_; }
+
+  /// \brief Get the index of the next expected access
+  std::size_t position() const noexcept { return cursor_; }
+
+  /// \brief Get the number of bytes which were prefetched but not yet read
+  std::size_t bytesInFlight() const noexcept { return bytesInFlight_; }
+
+  /// \brief Get the memory budget in bytes
+  std::size_t budget() const noexcept { return budget_; }
+
+  /// \brief Get the number of accesses after the cursor which are matched against a read
+  std::size_t lookAhead() const noexcept { return lookAhead_; }
+
+private:
+  AccessTrace trace_;
+  std::vector<std::size_t> sizes_;
+  std::vector<bool> prefetched_;
+  std::size_t budget_;
+  std::size_t lookAhead_;
+  std::size_t cursor_ = 0;
+  std::size_t scheduled_ = 0;
+  std::size_t bytesInFlight_ = 0;
+};
+
+/// @}
+
+} // namespace serialbox
+
+#endif
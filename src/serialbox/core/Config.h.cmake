@@ -43,6 +43,15 @@
 /* Define if NetCDF is available */
 #cmakedefine SERIALBOX_HAS_NETCDF ${SERIALBOX_HAS_NETCDF}
 
+/* Define if Zstandard is available */
+#cmakedefine SERIALBOX_HAS_ZSTD ${SERIALBOX_HAS_ZSTD}
+
+/* Define if LZ4 is available */
+#cmakedefine SERIALBOX_HAS_LZ4 ${SERIALBOX_HAS_LZ4}
+
+/* Define if io_uring is available */
+#cmakedefine SERIALBOX_HAS_IO_URING ${SERIALBOX_HAS_IO_URING}
+
 /* SERIALBOX was compiled with logging support */
 #cmakedefine SERIALBOX_HAS_LOGGING ${SERIALBOX_HAS_LOGGING}
 
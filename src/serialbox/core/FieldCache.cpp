@@ -0,0 +1,150 @@
+//===-- serialbox/core/FieldCache.cpp -----------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements the in-memory cache of deserialized fields.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/FieldCache.h"
+#include <cstring>
+
+namespace serialbox {
+
+std::string FieldCache::key(const FieldID& fieldID, const StorageView& storageView) {
+  std::string key = fieldID.name;
+  key += '\0';
+  key += std::to_string(fieldID.id);
+  for(int dim : storageView.dims())
+    key += 'x' + std::to_string(dim);
+  for(const SliceTriple& triple : storageView.getSlice().sliceTriples()) {
+    key += ':' + std::to_string(triple.start) + ',' + std::to_string(triple.stop) + ',' +
+           std::to_string(triple.step);
+  }
+  return key;
+}
+
+bool FieldCache::lookup(const FieldID& fieldID, StorageView& storageView) {
+  Data data;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(capacity_ == 0)
+      return false;
+
+    auto it = index_.find(key(fieldID, storageView));
+    if(it == index_.end()) {
+      ++misses_;
+      return false;
+    }
+
+    // Mark the entry as most recently used
+    entries_.splice(entries_.begin(), entries_, it->second);
+    data = it->second->data;
+    ++hits_;
+  }
+
+  // The data is immutable, hence it can be copied without holding the lock
+  const Byte* dataPtr = data->data();
+  if(storageView.isMemCopyable()) {
+    std::memcpy(storageView.originPtr(), dataPtr, data->size());
+  } else {
+    const int bytesPerElement = storageView.bytesPerElement();
+    for(auto it = storageView.begin(), end = storageView.end(); it != end;
+        ++it, dataPtr += bytesPerElement)
+      std::memcpy(it.ptr(), dataPtr, bytesPerElement);
+  }
+  return true;
+}
+
+bool FieldCache::contains(const FieldID& fieldID, const StorageView& storageView) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return index_.count(key(fieldID, storageView)) != 0;
+}
+
+void FieldCache::insert(const FieldID& fieldID, const StorageView& storageView) {
+  if(!isEnabled())
+    return;
+
+  // Copy the data before taking the lock
+  const int bytesPerElement = storageView.bytesPerElement();
+  auto data = std::make_shared<std::vector<Byte>>();
+  if(storageView.isMemCopyable()) {
+    data->resize(storageView.sizeInBytes());
+    std::memcpy(data->data(), storageView.originPtr(), data->size());
+  } else {
+    for(auto it = storageView.begin(), end = storageView.end(); it != end; ++it)
+      data->insert(data->end(), it.ptr(), it.ptr() + bytesPerElement);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if(data->size() > capacity_)
+    return;
+
+  std::string entryKey = key(fieldID, storageView);
+  auto it = index_.find(entryKey);
+  if(it != index_.end()) {
+    bytes_ -= it->second->data->size();
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+
+  evictTo(capacity_ - data->size());
+
+  bytes_ += data->size();
+  entries_.push_front(Entry{entryKey, std::move(data)});
+  index_.emplace(std::move(entryKey), entries_.begin());
+}
+
+void FieldCache::demote(const FieldID& fieldID, const StorageView& storageView) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key(fieldID, storageView));
+  if(it != index_.end())
+    entries_.splice(entries_.end(), entries_, it->second);
+}
+
+void FieldCache::flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  evictTo(0);
+}
+
+void FieldCache::setCapacity(std::size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  evictTo(capacity_);
+}
+
+std::size_t FieldCache::capacity() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_;
+}
+
+FieldCache::Statistics FieldCache::statistics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Statistics statistics;
+  statistics.hits = hits_;
+  statistics.misses = misses_;
+  statistics.entries = entries_.size();
+  statistics.bytes = bytes_;
+  return statistics;
+}
+
+void FieldCache::resetStatistics() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  hits_ = misses_ = 0;
+}
+
+void FieldCache::evictTo(std::size_t bytes) noexcept {
+  while(bytes_ > bytes) {
+    bytes_ -= entries_.back().data->size();
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+}
+
+} // namespace serialbox
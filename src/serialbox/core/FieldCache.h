@@ -0,0 +1,119 @@
+//===-- serialbox/core/FieldCache.h -------------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the in-memory cache of deserialized fields.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_FIELDCACHE_H
+#define SERIALBOX_CORE_FIELDCACHE_H
+
+#include "serialbox/core/FieldID.h"
+#include "serialbox/core/StorageView.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace serialbox {
+
+/// \brief Thread-safe LRU cache of deserialized fields
+///
+/// Entries are keyed by the FieldID, the dimensions and the slice of the StorageView and hold the
+/// (sliced) data in the iteration order of the StorageView, hence a cached field can be copied into
+/// storages of any layout. Repeated reads of contiguous storages are served by a single memcpy.
+///
+/// The total size of the cached data is bounded by the capacity, the least recently used entries
+/// are evicted first. A capacity of 0 disables the cache.
+///
+/// \ingroup core
+class FieldCache {
+public:
+  /// \brief Hit/miss counters and occupancy of the cache
+  struct Statistics {
+    std::uint64_t hits = 0;   ///< Number of lookups served from the cache
+    std::uint64_t misses = 0; ///< Number of lookups which were not cached
+    std::size_t entries = 0;  ///< Number of cached fields
+    std::size_t bytes = 0;    ///< Size in bytes of the cached data
+  };
+
+  /// \brief Construct an empty cache of `capacity` bytes
+  explicit FieldCache(std::size_t capacity = 0) : capacity_(capacity) {}
+
+  FieldCache(const FieldCache&) = delete;
+  FieldCache& operator=(const FieldCache&) = delete;
+
+  /// \brief Copy the cached data of `fieldID` into `storageView`
+  ///
+  /// \return True iff the field (with the slice of `storageView`) was cached
+  bool lookup(const FieldID& fieldID, StorageView& storageView);
+
+  /// \brief Check if the field `fieldID` (with the slice of `storageView`) is cached
+  ///
+  /// The hit/miss counters are not modified.
+  bool contains(const FieldID& fieldID, const StorageView& storageView) const;
+
+  /// \brief Cache the data of `fieldID` given by `storageView`
+  ///
+  /// Fields which exceed the capacity are not cached.
+  void insert(const FieldID& fieldID, const StorageView& storageView);
+
+  /// \brief Mark the entry of `fieldID` (with the slice of `storageView`) as least recently used,
+  /// i.e it is the first entry to be evicted
+  void demote(const FieldID& fieldID, const StorageView& storageView);
+
+  /// \brief Remove all entries (the counters are kept)
+  void flush();
+
+  /// \brief Set the capacity in bytes and evict entries accordingly
+  void setCapacity(std::size_t capacity);
+
+  /// \brief Get the capacity in bytes
+  std::size_t capacity() const;
+
+  /// \brief Check if the cache is enabled (i.e the capacity is non-zero)
+  bool isEnabled() const { return capacity() != 0; }
+
+  /// \brief Get the hit/miss counters and the occupancy
+  Statistics statistics() const;
+
+  /// \brief Reset the hit/miss counters
+  void resetStatistics();
+
+private:
+  using Data = std::shared_ptr<const std::vector<Byte>>;
+
+  struct Entry {
+    std::string key;
+    Data data;
+  };
+
+  /// \brief Key of the field `fieldID` read into `storageView`
+  static std::string key(const FieldID& fieldID, const StorageView& storageView);
+
+  /// \brief Evict the least recently used entries until at most `bytes` are cached
+  void evictTo(std::size_t bytes) noexcept;
+
+  mutable std::mutex mutex_;
+  std::list<Entry> entries_; // Most recently used first
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  std::size_t capacity_;
+  std::size_t bytes_ = 0;
+  std::uint64_t hits_ = 0;
+  std::uint64_t misses_ = 0;
+};
+
+} // namespace serialbox
+
+#endif
@@ -15,6 +15,7 @@
 #ifndef SERIALBOX_CORE_FIELDID_H
 #define SERIALBOX_CORE_FIELDID_H
 
+#include "serialbox/core/InternTable.h"
 #include <iosfwd>
 #include <string>
 
@@ -24,9 +25,11 @@ namespace serialbox {
 /// @{
 
 /// \brief Uniquely identifiy a field
+///
+/// The name is interned, hence FieldIDs are cheap to copy and compare.
 struct FieldID {
-  std::string name; ///< Name of the field
-  unsigned int id;  ///< ID within the field
+  InternedString name; ///< Name of the field
+  unsigned int id;     ///< ID within the field
 };
 
 /// \brief Check for equality of FieldIDs
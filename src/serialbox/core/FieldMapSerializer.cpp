@@ -33,4 +33,24 @@ void from_json(json::json const& j, FieldMap& fieldMap) {
   }
 }
 
+void from_json(JsonReader& reader, FieldMap& fieldMap) {
+  fieldMap.clear();
+
+  if(reader.readNull())
+    return;
+
+  reader.beginObject();
+  std::string key;
+  while(reader.nextKey(key)) {
+    try {
+      FieldMetainfoImpl info;
+      from_json(reader, info);
+      fieldMap.insert(key, std::move(info));
+    } catch(Exception& e) {
+      throw Exception("cannot insert node '%s' in FieldMap: JSON node ill-formed: %s", key,
+                      e.what());
+    }
+  }
+}
+
 } // namespace serialbox
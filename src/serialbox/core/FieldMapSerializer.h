@@ -17,6 +17,7 @@
 
 #include "serialbox/core/FieldMap.h"
 #include "serialbox/core/Json.h"
+#include "serialbox/core/JsonReader.h"
 
 namespace serialbox {
 
@@ -25,6 +26,8 @@ namespace serialbox {
 void to_json(json::json& j, FieldMap const& fieldMap);
 
 void from_json(json::json const& j, FieldMap& fieldMap);
+
+void from_json(JsonReader& reader, FieldMap& fieldMap);
 /// @}
 
 } // namespace serialbox
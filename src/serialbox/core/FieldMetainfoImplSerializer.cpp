@@ -37,4 +37,39 @@ void from_json(json::json const& j, FieldMetainfoImpl& f) {
   f.metaInfo() = j.at("meta_info");
 }
 
+void from_json(JsonReader& reader, FieldMetainfoImpl& f) {
+  f.dims().clear();
+  f.metaInfo().clear();
+
+  if(reader.readNull())
+    throw Exception("node is empty");
+
+  bool hasType = false, hasDims = false, hasMetaInfo = false;
+  reader.beginObject();
+  std::string key;
+  while(reader.nextKey(key)) {
+    if(key == "type_id") {
+      f.type() = static_cast<TypeID>(reader.readInteger());
+      hasType = true;
+    } else if(key == "dims") {
+      reader.beginArray();
+      while(reader.nextElement())
+        f.dims().push_back(static_cast<int>(reader.readInteger()));
+      hasDims = true;
+    } else if(key == "meta_info") {
+      from_json(reader, f.metaInfo());
+      hasMetaInfo = true;
+    } else {
+      reader.skipValue();
+    }
+  }
+
+  if(!hasType)
+    throw Exception("no node 'type_id'");
+  if(!hasDims)
+    throw Exception("no node 'dims'");
+  if(!hasMetaInfo)
+    throw Exception("no node 'meta_info'");
+}
+
 } // namespace serialbox
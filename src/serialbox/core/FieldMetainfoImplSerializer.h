@@ -17,6 +17,7 @@
 
 #include "serialbox/core/FieldMetainfoImpl.h"
 #include "serialbox/core/Json.h"
+#include "serialbox/core/JsonReader.h"
 #include <memory>
 
 namespace serialbox {
@@ -26,6 +27,8 @@ namespace serialbox {
 void to_json(json::json& j, FieldMetainfoImpl const& f);
 
 void from_json(json::json const& j, FieldMetainfoImpl& f);
+
+void from_json(JsonReader& reader, FieldMetainfoImpl& f);
 /// @}
 
 } // namespace serialbox
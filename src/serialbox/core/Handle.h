@@ -0,0 +1,107 @@
+//===-- serialbox/core/Handle.h -----------------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the pre-resolved handles of fields and savepoints.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_HANDLE_H
+#define SERIALBOX_CORE_HANDLE_H
+
+#include "serialbox/core/FieldMetainfoImpl.h"
+#include "serialbox/core/InternTable.h"
+#include <memory>
+
+namespace serialbox {
+
+/// \addtogroup core
+/// @{
+
+/// \brief Pre-resolved handle of a registered field
+///
+/// Handles are obtained from SerializerImpl::registerField or SerializerImpl::lookupField and
+/// allow to read and write the field without looking up its name. A handle refers to the
+/// Serializer it was obtained from and is invalidated by SerializerImpl::clear (the Serializer
+/// rejects handles of an earlier generation).
+class FieldHandle {
+public:
+  /// \brief Construct an invalid handle
+  FieldHandle() : index_(0), generation_(0) {}
+
+  /// \brief Check if the handle refers to a field
+  bool valid() const noexcept { return (info_ != nullptr); }
+
+  /// \brief Name of the field
+  const InternedString& name() const noexcept { return name_; }
+
+  /// \brief Dense index of the field (see SavepointVector::registerField)
+  unsigned int index() const noexcept { return index_; }
+
+  /// \brief Meta-information of the field
+  const std::shared_ptr<FieldMetainfoImpl>& info() const noexcept { return info_; }
+
+  /// \brief Generation of the Serializer the handle was obtained in
+  unsigned int generation() const noexcept { return generation_; }
+
+private:
+  friend class SerializerImpl;
+
+  FieldHandle(const InternedString& name, unsigned int index,
+              const std::shared_ptr<FieldMetainfoImpl>& info, unsigned int generation)
+      : name_(name), index_(index), info_(info), generation_(generation) {}
+
+  InternedString name_;
+  unsigned int index_;
+  std::shared_ptr<FieldMetainfoImpl> info_;
+  unsigned int generation_;
+};
+
+/// \brief Pre-resolved handle of a registered savepoint
+///
+/// Handles are obtained from SerializerImpl::findSavepoint or
+/// SerializerImpl::findOrRegisterSavepoint and refer to the index of the savepoint in the
+/// SavepointVector. Like field handles, they are invalidated by SerializerImpl::clear.
+class SavepointHandle {
+public:
+  /// \brief Generation of handles which are only checked against the number of savepoints
+  static const unsigned int AnyGeneration = ~0u;
+
+  /// \brief Construct an invalid handle
+  SavepointHandle() : index_(-1), generation_(AnyGeneration) {}
+
+  /// \brief Construct the handle of the savepoint with index `index`
+  ///
+  /// The C and Fortran interfaces represent savepoint handles by their index; such handles can not
+  /// be told apart from those obtained before SerializerImpl::clear.
+  explicit SavepointHandle(int index) : index_(index), generation_(AnyGeneration) {}
+
+  /// \brief Check if the handle refers to a savepoint
+  bool valid() const noexcept { return (index_ >= 0); }
+
+  /// \brief Index of the savepoint in the SavepointVector
+  int index() const noexcept { return index_; }
+
+  /// \brief Generation of the Serializer the handle was obtained in
+  unsigned int generation() const noexcept { return generation_; }
+
+private:
+  friend class SerializerImpl;
+
+  SavepointHandle(int index, unsigned int generation) : index_(index), generation_(generation) {}
+
+  int index_;
+  unsigned int generation_;
+};
+
+/// @}
+
+} // namespace serialbox
+
+#endif
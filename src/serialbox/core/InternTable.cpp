@@ -0,0 +1,96 @@
+//===-- serialbox/core/InternTable.cpp ----------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements the table of interned strings.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/InternTable.h"
+#include <iostream>
+#include <unordered_map>
+
+namespace serialbox {
+
+namespace {
+
+/// Handles of the global table already seen by the calling thread. The global table is never
+/// destroyed and strings are never removed, hence the cached handles remain valid and lookups of
+/// known strings (e.g every FieldID construction) don't need to take the lock of the table.
+std::unordered_map<std::string, InternTable::Handle>& threadLocalHandles() {
+  static thread_local std::unordered_map<std::string, InternTable::Handle> handles;
+  return handles;
+}
+
+} // anonymous namespace
+
+InternTable::Handle InternTable::intern(const std::string& str) {
+  if(str.empty())
+    return empty();
+
+  if(this != &global()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return &*strings_.insert(str).first;
+  }
+
+  auto& handles = threadLocalHandles();
+  auto it = handles.find(str);
+  if(it != handles.end())
+    return it->second;
+
+  Handle handle;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    handle = &*strings_.insert(str).first;
+  }
+  handles.emplace(str, handle);
+  return handle;
+}
+
+InternTable::Handle InternTable::find(const std::string& str) const {
+  if(str.empty())
+    return empty();
+
+  if(this == &global()) {
+    auto& handles = threadLocalHandles();
+    auto it = handles.find(str);
+    if(it != handles.end())
+      return it->second;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = strings_.find(str);
+  return it == strings_.end() ? nullptr : &*it;
+}
+
+std::size_t InternTable::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return strings_.size();
+}
+
+InternTable& InternTable::global() {
+  // The table is never destroyed as interned keys may be referenced by static objects
+  static InternTable* table = new InternTable;
+  return *table;
+}
+
+InternTable::Handle InternTable::empty() noexcept {
+  static const std::string* emptyString = new std::string;
+  return emptyString;
+}
+
+InternedString InternedString::lookup(const std::string& str) {
+  return InternedString(InternTable::global().find(str));
+}
+
+std::ostream& operator<<(std::ostream& stream, const InternedString& s) {
+  return (stream << (s.valid() ? s.str() : std::string()));
+}
+
+} // namespace serialbox
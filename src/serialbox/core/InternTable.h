@@ -0,0 +1,160 @@
+//===-- serialbox/core/InternTable.h ------------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the table of interned strings and the interned string handle.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_INTERNTABLE_H
+#define SERIALBOX_CORE_INTERNTABLE_H
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+namespace serialbox {
+
+/// \addtogroup core
+/// @{
+
+/// \brief Table of unique strings
+///
+/// Interning a string returns a handle to the unique copy of the string stored in the table, hence
+/// interned strings can be compared and hashed by their handle. Handles remain valid for the
+/// lifetime of the table (strings are never removed). The table is thread-safe. Each thread
+/// caches the handles of the global table it has seen, hence repeatedly interning the same
+/// strings does not contend for the lock of the table.
+class InternTable {
+public:
+  /// \brief Handle of an interned string
+  using Handle = const std::string*;
+
+  InternTable() = default;
+  InternTable(const InternTable&) = delete;
+  InternTable& operator=(const InternTable&) = delete;
+
+  /// \brief Get the handle of `str` (the string is added to the table if necessary)
+  Handle intern(const std::string& str);
+
+  /// \brief Get the handle of `str` or `nullptr` if the string is not in the table
+  Handle find(const std::string& str) const;
+
+  /// \brief Number of strings in the table
+  std::size_t size() const;
+
+  /// \brief Process-wide table (used for field names and the keys of meta-information)
+  static InternTable& global();
+
+  /// \brief Handle of the empty string (shared by all tables)
+  static Handle empty() noexcept;
+
+private:
+  mutable std::mutex mutex_;
+  std::unordered_set<std::string> strings_;
+};
+
+/// \brief String interned in the global InternTable
+///
+/// An InternedString is pointer-sized. Copying, hashing and comparing for equality operate on the
+/// handle, while the ordering is the one of the underlying strings.
+class InternedString {
+public:
+  /// \brief Empty string
+  InternedString() noexcept : handle_(InternTable::empty()) {}
+
+  /// \brief Intern `str`
+  InternedString(const std::string& str) : handle_(InternTable::global().intern(str)) {}
+  InternedString(const char* str) : InternedString(std::string(str)) {}
+
+  /// \brief Get the interned string of `str` without adding it to the table
+  ///
+  /// \return Interned string or an invalid InternedString if `str` has never been interned (as
+  /// such `str` can not be equal to any existing InternedString)
+  static InternedString lookup(const std::string& str);
+
+  /// \brief Check if the string is valid i.e. it was not obtained by an unsuccessful lookup
+  bool valid() const noexcept { return handle_ != nullptr; }
+
+  /// \brief Access the string
+  const std::string& str() const noexcept { return *handle_; }
+  operator const std::string&() const noexcept { return *handle_; }
+  const char* c_str() const noexcept { return handle_->c_str(); }
+  std::size_t size() const noexcept { return handle_->size(); }
+  bool empty() const noexcept { return handle_->empty(); }
+
+  /// \brief Handle of the string
+  InternTable::Handle handle() const noexcept { return handle_; }
+
+  /// \brief Comparison (only found by argument-dependent lookup to avoid ambiguities with types
+  /// which are implicitly convertible to strings)
+  friend bool operator==(const InternedString& left, const InternedString& right) noexcept {
+    return left.handle_ == right.handle_;
+  }
+  friend bool operator!=(const InternedString& left, const InternedString& right) noexcept {
+    return left.handle_ != right.handle_;
+  }
+  friend bool operator==(const InternedString& left, const std::string& right) noexcept {
+    return left.valid() && left.str() == right;
+  }
+  friend bool operator==(const std::string& left, const InternedString& right) noexcept {
+    return right == left;
+  }
+  friend bool operator!=(const InternedString& left, const std::string& right) noexcept {
+    return !(left == right);
+  }
+  friend bool operator!=(const std::string& left, const InternedString& right) noexcept {
+    return !(right == left);
+  }
+  friend bool operator==(const InternedString& left, const char* right) noexcept {
+    return left.valid() && left.str() == right;
+  }
+  friend bool operator!=(const InternedString& left, const char* right) noexcept {
+    return !(left == right);
+  }
+  friend bool operator<(const InternedString& left, const InternedString& right) noexcept {
+    return left.str() < right.str();
+  }
+
+  /// \brief Concatenation
+  friend std::string operator+(const std::string& left, const InternedString& right) {
+    return left + right.str();
+  }
+  friend std::string operator+(const InternedString& left, const std::string& right) {
+    return left.str() + right;
+  }
+
+private:
+  explicit InternedString(InternTable::Handle handle) noexcept : handle_(handle) {}
+
+  InternTable::Handle handle_;
+};
+
+/// \brief Convert InternedString to stream
+std::ostream& operator<<(std::ostream& stream, const InternedString& s);
+
+/// @}
+
+} // namespace serialbox
+
+namespace std {
+
+template <>
+struct hash<serialbox::InternedString> {
+  std::size_t operator()(const serialbox::InternedString& s) const noexcept {
+    return std::hash<serialbox::InternTable::Handle>()(s.handle());
+  }
+};
+
+} // namespace std
+
+#endif
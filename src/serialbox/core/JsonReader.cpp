@@ -0,0 +1,262 @@
+//===-- serialbox/core/JsonReader.cpp -----------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements the streaming reader of JSON documents.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/JsonReader.h"
+#include "serialbox/core/Exception.h"
+#include <istream>
+#include <limits>
+
+namespace serialbox {
+
+JsonReader::JsonReader(std::istream& stream)
+    : lexer_(json::detail::input_adapter(stream)), token_(TokenType::uninitialized) {
+  scan();
+}
+
+JsonReader::JsonReader(const char* data, std::size_t size)
+    : lexer_(json::detail::input_adapter(data, size)), token_(TokenType::uninitialized) {
+  scan();
+}
+
+JsonReader::ValueKind JsonReader::peek() const noexcept {
+  switch(token_) {
+  case TokenType::literal_null:
+    return ValueKind::Null;
+  case TokenType::literal_true:
+  case TokenType::literal_false:
+    return ValueKind::Boolean;
+  case TokenType::value_unsigned:
+  case TokenType::value_integer:
+  case TokenType::value_float:
+    return ValueKind::Number;
+  case TokenType::value_string:
+    return ValueKind::String;
+  case TokenType::begin_array:
+    return ValueKind::Array;
+  case TokenType::begin_object:
+    return ValueKind::Object;
+  default:
+    return ValueKind::None;
+  }
+}
+
+void JsonReader::beginObject() {
+  expect(TokenType::begin_object, "'{'");
+  first_.push_back(true);
+}
+
+bool JsonReader::nextKey(std::string& key) {
+  if(first_.empty())
+    throw Exception("JSON reader: not inside of an object");
+
+  if(token_ == TokenType::end_object) {
+    first_.pop_back();
+    scan();
+    return false;
+  }
+
+  if(!first_.back())
+    expect(TokenType::value_separator, "',' or '}'");
+  first_.back() = false;
+
+  if(token_ != TokenType::value_string)
+    error("string literal");
+  key = lexer_.move_string();
+  scan();
+  expect(TokenType::name_separator, "':'");
+  return true;
+}
+
+void JsonReader::beginArray() {
+  expect(TokenType::begin_array, "'['");
+  first_.push_back(true);
+}
+
+bool JsonReader::nextElement() {
+  if(first_.empty())
+    throw Exception("JSON reader: not inside of an array");
+
+  if(token_ == TokenType::end_array) {
+    first_.pop_back();
+    scan();
+    return false;
+  }
+
+  if(!first_.back())
+    expect(TokenType::value_separator, "',' or ']'");
+  first_.back() = false;
+  return true;
+}
+
+bool JsonReader::readNull() {
+  if(token_ != TokenType::literal_null)
+    return false;
+  scan();
+  return true;
+}
+
+bool JsonReader::readBoolean() {
+  if(token_ != TokenType::literal_true && token_ != TokenType::literal_false)
+    error("boolean literal");
+  const bool value = (token_ == TokenType::literal_true);
+  scan();
+  return value;
+}
+
+std::int64_t JsonReader::readInteger() {
+  std::int64_t value = 0;
+  if(token_ == TokenType::value_integer)
+    value = lexer_.get_number_integer();
+  else if(token_ == TokenType::value_unsigned &&
+          lexer_.get_number_unsigned() <=
+              static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+    value = static_cast<std::int64_t>(lexer_.get_number_unsigned());
+  else
+    error("integer");
+  scan();
+  return value;
+}
+
+std::uint64_t JsonReader::readUnsigned() {
+  if(token_ != TokenType::value_unsigned)
+    error("unsigned integer");
+  const std::uint64_t value = lexer_.get_number_unsigned();
+  scan();
+  return value;
+}
+
+double JsonReader::readNumber() {
+  double value = 0.0;
+  if(token_ == TokenType::value_float)
+    value = lexer_.get_number_float();
+  else if(token_ == TokenType::value_integer)
+    value = static_cast<double>(lexer_.get_number_integer());
+  else if(token_ == TokenType::value_unsigned)
+    value = static_cast<double>(lexer_.get_number_unsigned());
+  else
+    error("number literal");
+  scan();
+  return value;
+}
+
+std::string JsonReader::readString() {
+  if(token_ != TokenType::value_string)
+    error("string literal");
+  std::string value = lexer_.move_string();
+  scan();
+  return value;
+}
+
+json::json JsonReader::readValue() {
+  json::json value;
+  switch(token_) {
+  case TokenType::begin_object: {
+    value = json::json::object();
+    beginObject();
+    std::string key;
+    while(nextKey(key))
+      value[key] = readValue();
+    return value;
+  }
+  case TokenType::begin_array:
+    value = json::json::array();
+    beginArray();
+    while(nextElement())
+      value.push_back(readValue());
+    return value;
+  case TokenType::literal_true:
+  case TokenType::literal_false:
+    return json::json(readBoolean());
+  case TokenType::literal_null:
+    scan();
+    return value;
+  case TokenType::value_string:
+    return json::json(readString());
+  case TokenType::value_unsigned:
+    value = lexer_.get_number_unsigned();
+    break;
+  case TokenType::value_integer:
+    value = lexer_.get_number_integer();
+    break;
+  case TokenType::value_float:
+    value = lexer_.get_number_float();
+    break;
+  default:
+    error("value");
+  }
+  scan();
+  return value;
+}
+
+void JsonReader::skipValue() {
+  std::string key;
+  switch(token_) {
+  case TokenType::begin_object:
+    beginObject();
+    while(nextKey(key))
+      skipValue();
+    break;
+  case TokenType::begin_array:
+    beginArray();
+    while(nextElement())
+      skipValue();
+    break;
+  case TokenType::literal_true:
+  case TokenType::literal_false:
+  case TokenType::literal_null:
+  case TokenType::value_string:
+  case TokenType::value_unsigned:
+  case TokenType::value_integer:
+  case TokenType::value_float:
+    scan();
+    break;
+  default:
+    error("value");
+  }
+}
+
+void JsonReader::end() {
+  if(token_ != TokenType::end_of_input)
+    error("end of input");
+}
+
+std::size_t JsonReader::position() const noexcept { return lexer_.get_position(); }
+
+void JsonReader::scan() {
+  token_ = lexer_.scan();
+  if(token_ == TokenType::parse_error)
+    error(nullptr);
+}
+
+void JsonReader::expect(TokenType token, const char* expected) {
+  if(token_ != token)
+    error(expected);
+  scan();
+}
+
+void JsonReader::error(const char* expected) const {
+  std::string message;
+  if(token_ == TokenType::parse_error)
+    message = std::string(lexer_.get_error_message()) + "; last read: '" +
+              lexer_.get_token_string() + "'";
+  else
+    message = std::string("unexpected ") + Lexer::token_type_name(token_);
+
+  if(expected)
+    message += std::string("; expected ") + expected;
+
+  throw Exception("JSON syntax error at position %i: %s", lexer_.get_position(), message);
+}
+
+} // namespace serialbox
@@ -0,0 +1,135 @@
+//===-- serialbox/core/JsonReader.h -------------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the streaming reader of JSON documents used to load the meta-data.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_JSONREADER_H
+#define SERIALBOX_CORE_JSONREADER_H
+
+#include "serialbox/core/Json.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace serialbox {
+
+/// \addtogroup core
+/// @{
+
+/// \brief Pull reader of the token stream of a JSON document
+///
+/// In contrast to parsing the document into a `json::json` (which holds the complete document in
+/// memory before it can be converted), the reader hands out one value at a time and the
+/// structures are built directly from the tokens. Objects and arrays are traversed with
+/// beginObject/nextKey and beginArray/nextElement:
+///
+/// \code{.cpp}
+///   JsonReader reader(stream);
+///   reader.beginObject();
+///   std::string key;
+///   while(reader.nextKey(key))
+///     if(key == "name")
+///       name = reader.readString();
+///     else
+///       reader.skipValue();
+///   reader.end();
+/// \endcode
+///
+/// Any syntax error or unexpected token throws an Exception.
+class JsonReader {
+public:
+  /// \brief Kind of the next value
+  enum class ValueKind { Null, Boolean, Number, String, Array, Object, None };
+
+  /// \brief Read the document from `stream`
+  explicit JsonReader(std::istream& stream);
+
+  /// \brief Read the document from the buffer `data` of `size` bytes
+  JsonReader(const char* data, std::size_t size);
+
+  JsonReader(const JsonReader&) = delete;
+  JsonReader& operator=(const JsonReader&) = delete;
+
+  /// \brief Kind of the next value (ValueKind::None if the next token is not a value)
+  ValueKind peek() const noexcept;
+
+  /// \brief Enter the object starting at the next token
+  void beginObject();
+
+  /// \brief Advance to the next member of the current object and read its `key`
+  ///
+  /// \return `false` if the end of the object was reached (the object is left)
+  bool nextKey(std::string& key);
+
+  /// \brief Enter the array starting at the next token
+  void beginArray();
+
+  /// \brief Advance to the next element of the current array
+  ///
+  /// \return `false` if the end of the array was reached (the array is left)
+  bool nextElement();
+
+  /// \brief Read the next value if it is `null`
+  ///
+  /// \return `true` if a `null` was read
+  bool readNull();
+
+  /// \brief Read the next value as boolean
+  bool readBoolean();
+
+  /// \brief Read the next value as (signed) integer
+  std::int64_t readInteger();
+
+  /// \brief Read the next value as unsigned integer
+  std::uint64_t readUnsigned();
+
+  /// \brief Read the next value as floating point number (integers are converted)
+  double readNumber();
+
+  /// \brief Read the next value as string
+  std::string readString();
+
+  /// \brief Read the next value (including nested objects and arrays) into a `json::json`
+  ///
+  /// This is intended for small sub-trees whose structure is not known in advance.
+  json::json readValue();
+
+  /// \brief Skip the next value (including nested objects and arrays)
+  void skipValue();
+
+  /// \brief Check that the document was read completely
+  void end();
+
+  /// \brief Number of characters read so far
+  std::size_t position() const noexcept;
+
+private:
+  using Lexer = json::detail::lexer<json::json>;
+  using TokenType = Lexer::token_type;
+
+  void scan();
+  void expect(TokenType token, const char* expected);
+  [[noreturn]] void error(const char* expected) const;
+
+  Lexer lexer_;
+  TokenType token_;
+
+  // The current nesting of objects and arrays (`true` if the first member was not yet read)
+  std::vector<bool> first_;
+};
+
+/// @}
+
+} // namespace serialbox
+
+#endif
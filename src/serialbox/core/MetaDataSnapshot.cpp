@@ -0,0 +1,658 @@
+//===-- serialbox/core/MetaDataSnapshot.cpp -----------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements the binary snapshot of the meta-data of a Serializer.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/MetaDataSnapshot.h"
+#include "serialbox/core/Exception.h"
+#include "serialbox/core/Type.h"
+#include "serialbox/core/Version.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace serialbox {
+
+const char* MetaDataSnapshot::Magic = "SBXMETA";
+
+const char* MetaDataSnapshot::ArchiveMagic = "SBXARCH";
+
+const int MetaDataSnapshot::Version = 1;
+
+namespace {
+
+/// Header of snapshot files (followed by the string table and the meta-data)
+struct Header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byteOrder; ///< Snapshots are only valid on machines of the same endianness
+  std::uint32_t serialboxVersion;
+  std::uint32_t numStrings;
+  std::uint64_t size; ///< Size of the file in bytes
+  MetaDataSnapshot::Source source;
+};
+
+const std::uint32_t ByteOrderMark = 0x01020304;
+
+[[noreturn]] void corrupted(const std::string& filename) {
+  throw Exception("corrupted meta-data snapshot '%s'", filename);
+}
+
+/// Read-only mapping of a file
+class MappedFile {
+public:
+  explicit MappedFile(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if(fd == -1)
+      throw Exception("cannot open file '%s': %s", filename, std::strerror(errno));
+
+    struct stat status;
+    if(::fstat(fd, &status) != 0) {
+      ::close(fd);
+      throw Exception("cannot stat file '%s': %s", filename, std::strerror(errno));
+    }
+
+#ifdef __APPLE__
+    const struct timespec& mtime = status.st_mtimespec;
+#else
+    const struct timespec& mtime = status.st_mtim;
+#endif
+    size_ = status.st_size;
+    mtime_ = std::int64_t(mtime.tv_sec) * 1000000000 + mtime.tv_nsec;
+
+    if(size_ > 0) {
+      data_ = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+      if(data_ == MAP_FAILED) {
+        ::close(fd);
+        throw Exception("cannot map file '%s': %s", filename, std::strerror(errno));
+      }
+    }
+    ::close(fd);
+  }
+
+  ~MappedFile() {
+    if(size_ > 0)
+      ::munmap(data_, size_);
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* data() const noexcept { return static_cast<const char*>(data_); }
+  std::size_t size() const noexcept { return size_; }
+  std::int64_t mtime() const noexcept { return mtime_; }
+
+private:
+  void* data_ = nullptr;
+  std::size_t size_ = 0;
+  std::int64_t mtime_ = 0;
+};
+
+/// Hash of the `size` bytes at `data` (the words are combined by multiplication which is fast
+/// enough to hash large files in the page cache)
+std::uint64_t hashBytes(const char* data, std::size_t size) noexcept {
+  const std::uint64_t multiplier = 0x9e3779b97f4a7c15ull;
+  std::uint64_t hash = size;
+
+  std::size_t i = 0;
+  for(; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+    std::uint64_t word;
+    std::memcpy(&word, data + i, sizeof(std::uint64_t));
+    hash = (hash ^ word) * multiplier;
+    hash ^= hash >> 29;
+  }
+
+  std::uint64_t tail = 0;
+  std::memcpy(&tail, data + i, size - i);
+  hash = (hash ^ tail) * multiplier;
+  return hash ^ (hash >> 32);
+}
+
+/// Serialization of the meta-data (strings are replaced by their index in the string table)
+class Writer {
+public:
+  template <class T>
+  void put(const T& value) {
+    buffer_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void putString(const std::string& str) {
+    auto it = indices_.emplace(str, strings_.size());
+    if(it.second)
+      strings_.push_back(&it.first->first);
+    put<std::uint32_t>(it.first->second);
+  }
+
+  template <class T>
+  void putElement(const T& value) {
+    put(value);
+  }
+  void putElement(bool value) { put<std::uint8_t>(value); }
+  void putElement(const std::string& value) { putString(value); }
+
+  template <class T>
+  void putVector(const std::vector<T>& vector) {
+    put<std::uint32_t>(vector.size());
+    for(const T& element : vector)
+      putElement(element);
+  }
+
+  /// Bytes which are not shared (e.g checksums) are stored in place instead of the string table
+  void putBytes(const char* data, std::size_t size) {
+    put<std::uint32_t>(size);
+    buffer_.append(data, size);
+  }
+
+  template <class T>
+  void putValue(const MetainfoValueImpl& value) {
+    if(TypeUtil::isArray(value.type())) {
+      const Array<T>& array = value.get<Array<T>>();
+      put<std::uint32_t>(array.size());
+      for(const T& element : array)
+        putElement(element);
+    } else {
+      putElement(value.get<T>());
+    }
+  }
+
+  void putMetaInfo(const MetainfoMapImpl& map) {
+    put<std::uint32_t>(map.size());
+    for(auto it = map.begin(), end = map.end(); it != end; ++it) {
+      const MetainfoValueImpl& value = it->second;
+      putString(it->first);
+      put<std::int32_t>(static_cast<int>(value.type()));
+
+      switch(TypeUtil::getPrimitive(value.type())) {
+      case TypeID::Boolean:
+        putValue<bool>(value);
+        break;
+      case TypeID::Int32:
+        putValue<int>(value);
+        break;
+      case TypeID::Int64:
+        putValue<std::int64_t>(value);
+        break;
+      case TypeID::Float32:
+        putValue<float>(value);
+        break;
+      case TypeID::Float64:
+        putValue<double>(value);
+        break;
+      case TypeID::String:
+        putValue<std::string>(value);
+        break;
+      default:
+        throw Exception("invalid type of meta-information '%s'", it->first);
+      }
+    }
+  }
+
+  const std::string& buffer() const noexcept { return buffer_; }
+  const std::vector<const std::string*>& strings() const noexcept { return strings_; }
+
+private:
+  std::string buffer_;
+  std::unordered_map<std::string, std::uint32_t> indices_;
+  std::vector<const std::string*> strings_;
+};
+
+/// Deserialization of the meta-data from the mapped snapshot
+class Reader {
+public:
+  Reader(const std::string& filename, const char* data, std::size_t size)
+      : filename_(filename), cur_(data), end_(data + size) {}
+
+  template <class T>
+  T get() {
+    if(sizeof(T) > std::size_t(end_ - cur_))
+      corrupted(filename_);
+    T value;
+    std::memcpy(&value, cur_, sizeof(T));
+    cur_ += sizeof(T);
+    return value;
+  }
+
+  void getStrings(std::uint32_t numStrings) {
+    strings_.reserve(numStrings);
+    for(std::uint32_t i = 0; i < numStrings; ++i) {
+      const std::uint32_t length = get<std::uint32_t>();
+      if(length > std::size_t(end_ - cur_))
+        corrupted(filename_);
+      strings_.emplace_back(cur_, length);
+      cur_ += length;
+    }
+  }
+
+  const std::string& getString() { return strings_[getIndex()]; }
+
+  InternedString getInternedString() { return InternedString(strings_[getIndex()]); }
+
+  template <class T>
+  T getElement() {
+    return get<T>();
+  }
+
+  template <class T>
+  void getVector(std::vector<T>& vector) {
+    vector.resize(get<std::uint32_t>());
+    for(std::size_t i = 0; i < vector.size(); ++i)
+      vector[i] = getElement<T>();
+  }
+
+  template <class Container>
+  void getBytes(Container& bytes) {
+    const std::uint32_t size = get<std::uint32_t>();
+    if(size > std::size_t(end_ - cur_))
+      corrupted(filename_);
+    bytes.assign(cur_, cur_ + size);
+    cur_ += size;
+  }
+
+  template <class T>
+  MetainfoValueImpl getValue(bool isArray) {
+    if(!isArray)
+      return MetainfoValueImpl(getElement<T>());
+
+    Array<T> array(get<std::uint32_t>());
+    for(std::size_t i = 0; i < array.size(); ++i)
+      array[i] = getElement<T>();
+    return MetainfoValueImpl(std::move(array));
+  }
+
+  void getMetaInfo(MetainfoMapImpl& map) {
+    map.clear();
+    const std::uint32_t size = get<std::uint32_t>();
+    for(std::uint32_t i = 0; i < size; ++i) {
+      const std::string& key = getString();
+      const TypeID type = static_cast<TypeID>(get<std::int32_t>());
+      const bool isArray = TypeUtil::isArray(type);
+
+      switch(TypeUtil::getPrimitive(type)) {
+      case TypeID::Boolean:
+        map.insert(key, getValue<bool>(isArray));
+        break;
+      case TypeID::Int32:
+        map.insert(key, getValue<int>(isArray));
+        break;
+      case TypeID::Int64:
+        map.insert(key, getValue<std::int64_t>(isArray));
+        break;
+      case TypeID::Float32:
+        map.insert(key, getValue<float>(isArray));
+        break;
+      case TypeID::Float64:
+        map.insert(key, getValue<double>(isArray));
+        break;
+      case TypeID::String:
+        map.insert(key, getValue<std::string>(isArray));
+        break;
+      default:
+        corrupted(filename_);
+      }
+    }
+  }
+
+  bool atEnd() const noexcept { return cur_ == end_; }
+
+private:
+  std::uint32_t getIndex() {
+    const std::uint32_t idx = get<std::uint32_t>();
+    if(idx >= strings_.size())
+      corrupted(filename_);
+    return idx;
+  }
+
+  const std::string& filename_;
+  const char* cur_;
+  const char* end_;
+  std::vector<std::string> strings_;
+};
+
+template <>
+bool Reader::getElement<bool>() {
+  return get<std::uint8_t>() != 0;
+}
+
+template <>
+std::string Reader::getElement<std::string>() {
+  return getString();
+}
+
+/// Map the snapshot `filename` identified by `magic` and check its header
+///
+/// \return Mapped snapshot or `nullptr` if the snapshot does not exist or is stale
+std::unique_ptr<MappedFile> openSnapshot(const std::string& filename, const char* magic,
+                                         const MetaDataSnapshot::Source& source, Header& header) {
+  struct stat status;
+  if(::stat(filename.c_str(), &status) != 0)
+    return nullptr;
+
+  std::unique_ptr<MappedFile> file(new MappedFile(filename));
+
+  if(file->size() < sizeof(Header))
+    corrupted(filename);
+  std::memcpy(&header, file->data(), sizeof(Header));
+
+  if(std::strncmp(header.magic, magic, sizeof(header.magic)) != 0 ||
+     header.byteOrder != ByteOrderMark || header.size != file->size())
+    corrupted(filename);
+
+  // Snapshots of other revisions or of a different JSON file are stale
+  if(header.version != std::uint32_t(MetaDataSnapshot::Version) ||
+     !Version::match(header.serialboxVersion) || !(header.source == source))
+    return nullptr;
+  return file;
+}
+
+/// Write the snapshot `filename` identified by `magic` holding the data of `writer`
+void writeSnapshot(const std::string& filename, const char* magic,
+                   const MetaDataSnapshot::Source& source, const Writer& writer) {
+  // String table
+  std::string strings;
+  for(const std::string* str : writer.strings()) {
+    const std::uint32_t length = str->size();
+    strings.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    strings.append(*str);
+  }
+
+  Header header;
+  std::memset(&header, 0, sizeof(Header));
+  std::strncpy(header.magic, magic, sizeof(header.magic));
+  header.version = MetaDataSnapshot::Version;
+  header.byteOrder = ByteOrderMark;
+  header.serialboxVersion =
+      100 * SERIALBOX_VERSION_MAJOR + 10 * SERIALBOX_VERSION_MINOR + SERIALBOX_VERSION_PATCH;
+  header.numStrings = writer.strings().size();
+  header.size = sizeof(Header) + strings.size() + writer.buffer().size();
+  header.source = source;
+
+  // Write to a temporary file which replaces the snapshot at once
+  const std::string tmpFilename = filename + ".tmp." + std::to_string(::getpid());
+  {
+    std::ofstream fs(tmpFilename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!fs.is_open())
+      throw Exception("cannot open file: %s", tmpFilename);
+
+    fs.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    fs.write(strings.data(), strings.size());
+    fs.write(writer.buffer().data(), writer.buffer().size());
+    fs.close();
+
+    if(!fs) {
+      std::remove(tmpFilename.c_str());
+      throw Exception("cannot write file: %s", tmpFilename);
+    }
+  }
+
+  if(std::rename(tmpFilename.c_str(), filename.c_str()) != 0) {
+    std::remove(tmpFilename.c_str());
+    throw Exception("cannot rename '%s' to '%s': %s", tmpFilename, filename, std::strerror(errno));
+  }
+}
+
+} // anonymous namespace
+
+MetaDataSnapshot::Source MetaDataSnapshot::Source::of(const std::string& filename) {
+  MappedFile file(filename);
+  Source source;
+  source.size = file.size();
+  source.mtime = file.mtime();
+  source.hash = hashBytes(file.data(), file.size());
+  return source;
+}
+
+bool MetaDataSnapshot::isEnabled() {
+  const char* snapshot = std::getenv("SERIALBOX_METADATA_SNAPSHOT");
+  return !(snapshot && std::atoi(snapshot) <= 0);
+}
+
+std::string MetaDataSnapshot::filename(const std::string& prefix) {
+  return "MetaData-" + prefix + ".bin";
+}
+
+std::string MetaDataSnapshot::archiveFilename(const std::string& prefix) {
+  return "ArchiveMetaData-" + prefix + ".bin";
+}
+
+bool MetaDataSnapshot::read(const std::string& filename, const Source& source,
+                            MetainfoMapImpl& globalMetainfo, SavepointVector& savepointVector,
+                            FieldMap& fieldMap) {
+  Header header;
+  auto file = openSnapshot(filename, Magic, source, header);
+  if(!file)
+    return false;
+
+  Reader reader(filename, file->data() + sizeof(Header), file->size() - sizeof(Header));
+  reader.getStrings(header.numStrings);
+
+  reader.getMetaInfo(globalMetainfo);
+
+  // Fields
+  fieldMap.clear();
+  const std::uint32_t numFields = reader.get<std::uint32_t>();
+  for(std::uint32_t i = 0; i < numFields; ++i) {
+    const std::string& name = reader.getString();
+    const TypeID type = static_cast<TypeID>(reader.get<std::int32_t>());
+    std::vector<int> dims(reader.get<std::uint32_t>());
+    for(int& dim : dims)
+      dim = reader.get<std::int32_t>();
+
+    MetainfoMapImpl metaInfo;
+    reader.getMetaInfo(metaInfo);
+    if(!fieldMap.insert(name, type, dims, metaInfo))
+      corrupted(filename);
+  }
+
+  // Savepoints
+  savepointVector.clear();
+  const std::uint32_t numSavepoints = reader.get<std::uint32_t>();
+  savepointVector.reserve(numSavepoints, reader.get<std::uint64_t>());
+
+  SavepointImpl savepoint("");
+  for(std::uint32_t i = 0; i < numSavepoints; ++i) {
+    savepoint.setName(reader.getString());
+    reader.getMetaInfo(savepoint.metaInfo());
+    if(savepointVector.insert(savepoint) != int(i))
+      corrupted(filename);
+  }
+
+  // Fields of the savepoints (the dense indices of the fields are preserved)
+  const std::uint32_t numFieldNames = reader.get<std::uint32_t>();
+  for(std::uint32_t i = 0; i < numFieldNames; ++i)
+    if(savepointVector.registerField(reader.getInternedString()) != i)
+      corrupted(filename);
+
+  const std::vector<InternedString>& fieldNames = savepointVector.fieldNames();
+  for(std::uint32_t i = 0; i < numSavepoints; ++i) {
+    const std::uint32_t numFieldsOfSavepoint = reader.get<std::uint32_t>();
+    for(std::uint32_t f = 0; f < numFieldsOfSavepoint; ++f) {
+      const std::uint32_t fieldIndex = reader.get<std::uint32_t>();
+      const std::uint32_t id = reader.get<std::uint32_t>();
+      if(fieldIndex >= fieldNames.size() ||
+         !savepointVector.addField(i, FieldID{fieldNames[fieldIndex], id}))
+        corrupted(filename);
+    }
+  }
+
+  if(!reader.atEnd())
+    corrupted(filename);
+  return true;
+}
+
+void MetaDataSnapshot::write(const std::string& filename, const Source& source,
+                             const MetainfoMapImpl& globalMetainfo,
+                             const SavepointVector& savepointVector, const FieldMap& fieldMap) {
+  Writer writer;
+
+  writer.putMetaInfo(globalMetainfo);
+
+  // Fields
+  writer.put<std::uint32_t>(fieldMap.size());
+  for(auto it = fieldMap.begin(), end = fieldMap.end(); it != end; ++it) {
+    const FieldMetainfoImpl& info = *it->second;
+    writer.putString(it->first);
+    writer.put<std::int32_t>(static_cast<int>(info.type()));
+    writer.put<std::uint32_t>(info.dims().size());
+    for(int dim : info.dims())
+      writer.put<std::int32_t>(dim);
+    writer.putMetaInfo(info.metaInfo());
+  }
+
+  // Savepoints
+  std::uint64_t numMetaInfo = 0;
+  for(std::size_t i = 0; i < savepointVector.size(); ++i)
+    numMetaInfo += savepointVector.metaInfoSizeOf(i);
+
+  writer.put<std::uint32_t>(savepointVector.size());
+  writer.put<std::uint64_t>(numMetaInfo);
+  for(std::size_t i = 0; i < savepointVector.size(); ++i) {
+    writer.putString(savepointVector.nameOf(i).str());
+    writer.putMetaInfo(savepointVector.savepointAt(i).metaInfo());
+  }
+
+  // Fields of the savepoints
+  writer.put<std::uint32_t>(savepointVector.fieldNames().size());
+  for(const InternedString& name : savepointVector.fieldNames())
+    writer.putString(name.str());
+
+  for(std::size_t i = 0; i < savepointVector.size(); ++i) {
+    const auto fields = savepointVector.fieldsOf(i);
+    writer.put<std::uint32_t>(fields.size());
+    for(auto it = fields.begin(), end = fields.end(); it != end; ++it) {
+      writer.put<std::uint32_t>(savepointVector.fieldIndex(it->first.str()));
+      writer.put<std::uint32_t>(it->second);
+    }
+  }
+
+  writeSnapshot(filename, Magic, source, writer);
+}
+
+bool MetaDataSnapshot::readArchive(const std::string& filename, const Source& source,
+                                   std::string& hashAlgorithm,
+                                   BinaryArchive::FieldTable& fieldTable) {
+  Header header;
+  auto file = openSnapshot(filename, ArchiveMagic, source, header);
+  if(!file)
+    return false;
+
+  Reader reader(filename, file->data() + sizeof(Header), file->size() - sizeof(Header));
+  reader.getStrings(header.numStrings);
+
+  hashAlgorithm = reader.getString();
+
+  fieldTable.clear();
+  const std::uint32_t numFields = reader.get<std::uint32_t>();
+  fieldTable.reserve(numFields);
+  for(std::uint32_t i = 0; i < numFields; ++i) {
+    BinaryArchive::FieldOffsetTable& fieldOffsetTable = fieldTable[reader.getInternedString()];
+    fieldOffsetTable.resize(reader.get<std::uint32_t>());
+
+    for(BinaryArchive::FileOffsetType& fileOffset : fieldOffsetTable) {
+      fileOffset.offset = reader.get<std::int64_t>();
+      reader.getBytes(fileOffset.checksum);
+
+      // Entries stored as is (the common case) have no layout description
+      if(reader.get<std::uint8_t>() == 0)
+        continue;
+
+      CodecInfo& codec = fileOffset.codec;
+      codec.codec = reader.getString();
+      codec.shuffle = reader.get<std::int32_t>();
+      codec.blockSize = reader.get<std::uint64_t>();
+      codec.size = reader.get<std::uint64_t>();
+      reader.getVector(codec.blocks);
+      codec.errorBoundKind = static_cast<ErrorBoundKind>(reader.get<std::int32_t>());
+      codec.errorBound = reader.get<double>();
+      codec.maxError = reader.get<double>();
+      codec.deltaReference = reader.get<std::int32_t>();
+      codec.deltaDepth = reader.get<std::int32_t>();
+
+      reader.getVector(fileOffset.chunks.shape);
+      reader.getVector(fileOffset.chunks.offsets);
+
+      reader.getBytes(fileOffset.uniform.value);
+      reader.getVector(fileOffset.uniform.dims);
+
+      fileOffset.blockStore = reader.getString();
+      fileOffset.blocks.resize(reader.get<std::uint32_t>());
+      for(BlockReference& block : fileOffset.blocks) {
+        block.digest = reader.getString();
+        block.size = reader.get<std::uint64_t>();
+      }
+    }
+  }
+
+  if(!reader.atEnd())
+    corrupted(filename);
+  return true;
+}
+
+void MetaDataSnapshot::writeArchive(const std::string& filename, const Source& source,
+                                    const std::string& hashAlgorithm,
+                                    const BinaryArchive::FieldTable& fieldTable) {
+  Writer writer;
+
+  writer.putString(hashAlgorithm);
+
+  writer.put<std::uint32_t>(fieldTable.size());
+  for(auto it = fieldTable.begin(), end = fieldTable.end(); it != end; ++it) {
+    writer.putString(it->first.str());
+    writer.put<std::uint32_t>(it->second.size());
+
+    for(const BinaryArchive::FileOffsetType& fileOffset : it->second) {
+      writer.put<std::int64_t>(fileOffset.offset);
+      writer.putBytes(fileOffset.checksum.data(), fileOffset.checksum.size());
+
+      const bool isPlain = !fileOffset.codec.isEncoded() && !fileOffset.chunks.isChunked() &&
+                           !fileOffset.uniform.isUniform() && fileOffset.blocks.empty();
+      writer.put<std::uint8_t>(!isPlain);
+      if(isPlain)
+        continue;
+
+      const CodecInfo& codec = fileOffset.codec;
+      writer.putString(codec.codec);
+      writer.put<std::int32_t>(codec.shuffle);
+      writer.put<std::uint64_t>(codec.blockSize);
+      writer.put<std::uint64_t>(codec.size);
+      writer.putVector(codec.blocks);
+      writer.put<std::int32_t>(static_cast<int>(codec.errorBoundKind));
+      writer.put<double>(codec.errorBound);
+      writer.put<double>(codec.maxError);
+      writer.put<std::int32_t>(codec.deltaReference);
+      writer.put<std::int32_t>(codec.deltaDepth);
+
+      writer.putVector(fileOffset.chunks.shape);
+      writer.putVector(fileOffset.chunks.offsets);
+
+      writer.putBytes(fileOffset.uniform.value.data(), fileOffset.uniform.value.size());
+      writer.putVector(fileOffset.uniform.dims);
+
+      writer.putString(fileOffset.blockStore);
+      writer.put<std::uint32_t>(fileOffset.blocks.size());
+      for(const BlockReference& block : fileOffset.blocks) {
+        writer.putString(block.digest);
+        writer.put<std::uint64_t>(block.size);
+      }
+    }
+  }
+
+  writeSnapshot(filename, ArchiveMagic, source, writer);
+}
+
+} // namespace serialbox
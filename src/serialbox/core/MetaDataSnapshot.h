@@ -0,0 +1,123 @@
+//===-- serialbox/core/MetaDataSnapshot.h -------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the binary snapshot of the meta-data of a Serializer.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_METADATASNAPSHOT_H
+#define SERIALBOX_CORE_METADATASNAPSHOT_H
+
+#include "serialbox/core/FieldMap.h"
+#include "serialbox/core/MetainfoMapImpl.h"
+#include "serialbox/core/SavepointVector.h"
+#include "serialbox/core/archive/BinaryArchive.h"
+#include <cstdint>
+#include <string>
+
+namespace serialbox {
+
+/// \addtogroup core
+/// @{
+
+/// \brief Binary snapshot of the meta-data of a Serializer
+///
+/// The snapshot `MetaData-prefix.bin` holds the global meta-information, the savepoints (including
+/// the fields stored at each savepoint) and the field map as they are in memory after reading
+/// `MetaData-prefix.json`. Strings are stored once in a string table and referred to by index.
+///
+/// The snapshot spares the parsing of the JSON file but it is not used in place: the file is
+/// decoded in a single pass into the in-memory data-structures, i.e the strings are interned and
+/// the savepoints are inserted into the SavepointVector (which rebuilds its index).
+///
+/// The field table of the BinaryArchive is kept in a second snapshot `ArchiveMetaData-prefix.bin`
+/// (see MetaDataSnapshot::readArchive) as it is created from its own JSON file.
+///
+/// A snapshot is only valid for the JSON file it was created from: the size, the modification time
+/// and a hash of the content of the JSON file (see MetaDataSnapshot::Source) are recorded and
+/// compared when loading. Stale snapshots are ignored. Snapshots are used by read-only openings
+/// unless the environment variable `SERIALBOX_METADATA_SNAPSHOT` is set to 0.
+class MetaDataSnapshot {
+public:
+  /// \brief Identifier of snapshot files
+  static const char* Magic;
+
+  /// \brief Identifier of snapshot files of the field table of a BinaryArchive
+  static const char* ArchiveMagic;
+
+  /// \brief Revision of the file format
+  static const int Version;
+
+  /// \brief JSON file of the meta-data a snapshot is created from
+  struct Source {
+    std::uint64_t size = 0; ///< Size in bytes
+    std::int64_t mtime = 0; ///< Time of the last modification in nanoseconds
+    std::uint64_t hash = 0; ///< Hash of the content
+
+    /// \brief Describe the file `filename`
+    ///
+    /// \throw Exception  File cannot be read
+    static Source of(const std::string& filename);
+
+    bool operator==(const Source& other) const noexcept {
+      return size == other.size && mtime == other.mtime && hash == other.hash;
+    }
+  };
+
+  /// \brief Check if snapshots are enabled (i.e `SERIALBOX_METADATA_SNAPSHOT` is not set to 0)
+  static bool isEnabled();
+
+  /// \brief Name of the snapshot file of the serializer with `prefix`
+  static std::string filename(const std::string& prefix);
+
+  /// \brief Name of the snapshot file of the BinaryArchive with `prefix`
+  static std::string archiveFilename(const std::string& prefix);
+
+  /// \brief Load the snapshot `filename` if it was created from `source`
+  ///
+  /// \return `false` if the snapshot does not exist or is stale (the meta-data is not modified)
+  ///
+  /// \throw Exception  Snapshot is corrupted
+  static bool read(const std::string& filename, const Source& source,
+                   MetainfoMapImpl& globalMetainfo, SavepointVector& savepointVector,
+                   FieldMap& fieldMap);
+
+  /// \brief Write the snapshot of the meta-data created from `source` to `filename`
+  ///
+  /// The snapshot is written to a temporary file first, which is then renamed to `filename`.
+  /// Concurrent writers therefore never expose partially written snapshots.
+  ///
+  /// \throw Exception  Snapshot cannot be written
+  static void write(const std::string& filename, const Source& source,
+                    const MetainfoMapImpl& globalMetainfo, const SavepointVector& savepointVector,
+                    const FieldMap& fieldMap);
+
+  /// \brief Load the snapshot `filename` of the field table of a BinaryArchive if it was created
+  /// from `source` (i.e `ArchiveMetaData-prefix.json`)
+  ///
+  /// \return `false` if the snapshot does not exist or is stale (nothing is modified)
+  ///
+  /// \throw Exception  Snapshot is corrupted
+  static bool readArchive(const std::string& filename, const Source& source,
+                          std::string& hashAlgorithm, BinaryArchive::FieldTable& fieldTable);
+
+  /// \brief Write the snapshot of the field table of a BinaryArchive created from `source`
+  ///
+  /// \throw Exception  Snapshot cannot be written
+  static void writeArchive(const std::string& filename, const Source& source,
+                           const std::string& hashAlgorithm,
+                           const BinaryArchive::FieldTable& fieldTable);
+};
+
+/// @}
+
+} // namespace serialbox
+
+#endif
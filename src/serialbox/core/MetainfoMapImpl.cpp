@@ -22,34 +22,50 @@ namespace serialbox {
 std::vector<std::string> MetainfoMapImpl::keys() const {
   std::vector<std::string> keys;
   keys.reserve(map_.size());
-  for(auto it = map_.begin(), end = map_.end(); it != end; ++it)
-    keys.push_back(it->first);
+  for(const Entry& entry : map_)
+    keys.push_back(*entry.key);
   return keys;
 }
 
 std::vector<TypeID> MetainfoMapImpl::types() const {
   std::vector<TypeID> types;
   types.reserve(map_.size());
-  for(auto it = map_.begin(), end = map_.end(); it != end; ++it)
-    types.push_back(it->second.type());
+  for(const Entry& entry : map_)
+    types.push_back(entry.value.type());
   return types;
 }
 
+MetainfoMapImpl::mapped_type& MetainfoMapImpl::operator[](const key_type& key) noexcept {
+  auto it = lowerBound(map_, key);
+  if(it == map_.end() || *it->key != key)
+    it = map_.insert(it, Entry{InternTable::global().intern(key), MetainfoValueImpl()});
+  return it->value;
+}
+
 MetainfoMapImpl::mapped_type& MetainfoMapImpl::at(const MetainfoMapImpl::key_type& key) {
-  try {
-    return map_.at(key);
-  } catch(std::out_of_range&) {
+  auto it = find(key);
+  if(it == end())
     throw Exception("no key '%s' exists", key);
-  }
+  return it->second;
 }
 
 const MetainfoMapImpl::mapped_type&
 MetainfoMapImpl::at(const MetainfoMapImpl::key_type& key) const {
-  try {
-    return map_.at(key);
-  } catch(std::out_of_range&) {
+  auto it = find(key);
+  if(it == end())
     throw Exception("no key '%s' exists", key);
-  }
+  return it->second;
+}
+
+bool MetainfoMapImpl::operator==(const MetainfoMapImpl& right) const noexcept {
+  if(map_.size() != right.map_.size())
+    return false;
+
+  // Keys are interned and sorted, hence equal maps have the same handles at the same positions
+  for(std::size_t i = 0; i < map_.size(); ++i)
+    if(map_[i].key != right.map_[i].key || map_[i].value != right.map_[i].value)
+      return false;
+  return true;
 }
 
 std::ostream& operator<<(std::ostream& stream, const MetainfoMapImpl& s) {
@@ -16,11 +16,15 @@
 #define SERIALBOX_CORE_METAINFOMAPIMPL_H
 
 #include "serialbox/core/Exception.h"
+#include "serialbox/core/InternTable.h"
 #include "serialbox/core/MetainfoValueImpl.h"
 #include "serialbox/core/Type.h"
+#include <algorithm>
+#include <cstddef>
 #include <iosfwd>
+#include <iterator>
 #include <string>
-#include <unordered_map>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -29,39 +33,116 @@ namespace serialbox {
 /// \addtogroup core
 /// @{
 
-/// \brief Hash-map of meta-information of the form `key = value` pair or
-/// `key = {value1, ..., valueN}`
+/// \brief Map of meta-information of the form `key = value` pair or `key = {value1, ..., valueN}`
 ///
 /// They keys are strings (std::string), while the values can be booleans, integers (32 and 64 bit),
 /// floating point numbers (32 and 64 bit) or strings.
+///
+/// Meta-information usually consists of a handful of elements, the elements are thus stored in a
+/// flat vector sorted by key. The keys are interned (see InternTable::global), hence comparing two
+/// maps compares the keys by their handle. Note that inserting or erasing elements invalidates
+/// all iterators and references to elements of the map.
 class MetainfoMapImpl {
 public:
-  /// \brief Type of the underlying hash-map
-  using map_type = std::unordered_map<std::string, MetainfoValueImpl>;
+  /// \brief Element of the map (the key is interned)
+  struct Entry {
+    InternTable::Handle key;
+    MetainfoValueImpl value;
+  };
+
+  /// \brief Type of the underlying container (sorted by key)
+  using map_type = std::vector<Entry>;
 
   /// \brief Type of an entry of the MetainfoMapImpl (`std::pair<std::string, MetainfoValueImpl>`)
-  using value_type = map_type::value_type;
+  using value_type = std::pair<const std::string, MetainfoValueImpl>;
 
   /// \brief Type of the key (`std::string`)
-  using key_type = map_type::key_type;
+  using key_type = std::string;
 
   /// \brief Type of the value (`MetainfoMapImpl::Value`)
-  using mapped_type = map_type::mapped_type;
+  using mapped_type = MetainfoValueImpl;
 
   /// \brief An unsigned integral type (`std::size_t`)
-  using size_type = map_type::size_type;
+  using size_type = std::size_t;
+
+  /// \brief Forward iterator over the elements
+  ///
+  /// Dereferencing yields a pair of references to the key and the value of the element.
+  template <bool IsConst>
+  class Iterator {
+    using BaseIterator = typename std::conditional<IsConst, map_type::const_iterator,
+                                                   map_type::iterator>::type;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = MetainfoMapImpl::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference =
+        std::pair<const std::string&,
+                  typename std::conditional<IsConst, const MetainfoValueImpl&,
+                                            MetainfoValueImpl&>::type>;
+
+    /// \brief Proxy returned by Iterator::operator->
+    struct pointer {
+      reference ref;
+      reference* operator->() noexcept { return &ref; }
+    };
+
+    Iterator() = default;
+    explicit Iterator(BaseIterator it) : it_(it) {}
+
+    /// \brief Conversion of an iterator to a const iterator
+    template <bool OtherIsConst, class = typename std::enable_if<IsConst && !OtherIsConst>::type>
+    Iterator(const Iterator<OtherIsConst>& other) : it_(other.base()) {}
+
+    reference operator*() const noexcept { return reference(*it_->key, it_->value); }
+    pointer operator->() const noexcept { return pointer{**this}; }
+
+    Iterator& operator++() noexcept {
+      ++it_;
+      return *this;
+    }
+
+    Iterator operator++(int) noexcept {
+      Iterator tmp(*this);
+      ++it_;
+      return tmp;
+    }
+
+    template <bool OtherIsConst>
+    bool operator==(const Iterator<OtherIsConst>& other) const noexcept {
+      return it_ == other.base();
+    }
+
+    template <bool OtherIsConst>
+    bool operator!=(const Iterator<OtherIsConst>& other) const noexcept {
+      return it_ != other.base();
+    }
+
+    /// \brief Get the iterator of the underlying container
+    const BaseIterator& base() const noexcept { return it_; }
+
+  private:
+    BaseIterator it_;
+  };
 
   /// \brief A forward iterator to `value_type`
-  using iterator = map_type::iterator;
+  using iterator = Iterator<false>;
 
   /// \brief A forward iterator to `const value_type`
-  using const_iterator = map_type::const_iterator;
+  using const_iterator = Iterator<true>;
 
   /// \brief Default constructor (empty map)
   MetainfoMapImpl() : map_(){};
 
+  /// \brief Construct from elements which are sorted by their key (the keys need to be unique)
+  explicit MetainfoMapImpl(map_type entries) : map_(std::move(entries)) {}
+
   /// \brief Construct from initalizer-list
-  explicit MetainfoMapImpl(std::initializer_list<value_type> list) : map_(list){};
+  explicit MetainfoMapImpl(std::initializer_list<value_type> list) {
+    for(const value_type& element : list)
+      insert(element.first, element.second);
+  }
 
   /// \brief Copy constructor
   MetainfoMapImpl(const MetainfoMapImpl&) = default;
@@ -82,7 +163,7 @@ public:
   /// \return True iff the key is present
   template <class StringType>
   bool hasKey(StringType&& key) const noexcept {
-    return (map_.find(key) != map_.end());
+    return (find(key) != end());
   }
 
   /// \brief Get vector of strings of all available keys
@@ -108,11 +189,13 @@ public:
   /// MetainfoMapImpl::end otherwise
   template <class StringType>
   iterator find(StringType&& key) noexcept {
-    return map_.find(key);
+    auto it = lowerBound(map_, key);
+    return iterator((it != map_.end() && *it->key == key) ? it : map_.end());
   }
   template <class StringType>
   const_iterator find(StringType&& key) const noexcept {
-    return map_.find(key);
+    auto it = lowerBound(map_, key);
+    return const_iterator((it != map_.end() && *it->key == key) ? it : map_.end());
   }
 
   /// \brief Insert a new element in the map
@@ -126,7 +209,12 @@ public:
   /// \return Value indicating whether the element was successfully inserted or not
   template <class KeyType, class ValueType>
   bool insert(KeyType&& key, ValueType&& value) noexcept {
-    return (map_.insert({key, MetainfoValueImpl(std::forward<ValueType>(value))}).second);
+    auto it = lowerBound(map_, key);
+    if(it != map_.end() && *it->key == key)
+      return false;
+    map_.insert(it, Entry{InternTable::global().intern(key),
+                          MetainfoValueImpl(std::forward<ValueType>(value))});
+    return true;
   }
 
   /// \brief Convert value of element with key `key` to type `T`
@@ -148,15 +236,22 @@ public:
 
   /// \brief Removes from the MetainfoMapImpl either a single element or a range of
   /// elements [first,last)
-  iterator erase(const_iterator position) { return map_.erase(position); }
-  size_type erase(const key_type& key) { return map_.erase(key); }
-  iterator erase(const_iterator first, const_iterator last) { return map_.erase(first, last); }
+  iterator erase(const_iterator position) { return iterator(map_.erase(position.base())); }
+  size_type erase(const key_type& key) {
+    auto it = find(key);
+    if(it == end())
+      return 0;
+    map_.erase(it.base());
+    return 1;
+  }
+  iterator erase(const_iterator first, const_iterator last) {
+    return iterator(map_.erase(first.base(), last.base()));
+  }
 
   /// \brief Return a reference to mapped value given by key
   ///
   /// \throw Exception  `Key` does not exist
-  mapped_type& operator[](const key_type& key) noexcept { return map_[key]; }
-  mapped_type& operator[](key_type&& key) noexcept { return map_[key]; }
+  mapped_type& operator[](const key_type& key) noexcept;
 
   /// \brief Return a reference to mapped value given by key
   ///
@@ -176,18 +271,21 @@ public:
   void clear() noexcept { map_.clear(); }
 
   /// \brief Returns an iterator pointing to the first element in the MetainfoMapImpl
-  iterator begin() noexcept { return map_.begin(); }
-  const_iterator begin() const noexcept { return map_.begin(); }
+  iterator begin() noexcept { return iterator(map_.begin()); }
+  const_iterator begin() const noexcept { return const_iterator(map_.begin()); }
 
   /// \brief Returns an iterator pointing to the past-the-end element in the MetainfoMapImpl
-  iterator end() noexcept { return map_.end(); }
-  const_iterator end() const noexcept { return map_.end(); }
+  iterator end() noexcept { return iterator(map_.end()); }
+  const_iterator end() const noexcept { return const_iterator(map_.end()); }
 
   /// \brief Swap with other
   void swap(MetainfoMapImpl& other) noexcept { map_.swap(other.map_); }
 
-  /// \brief Test for equality
-  bool operator==(const MetainfoMapImpl& right) const noexcept { return (map_ == right.map_); }
+  /// \brief Access the underlying container
+  const map_type& entries() const noexcept { return map_; }
+
+  /// \brief Test for equality (keys are compared by their handle)
+  bool operator==(const MetainfoMapImpl& right) const noexcept;
 
   /// \brief Test for inequality
   bool operator!=(const MetainfoMapImpl& right) const noexcept { return (!(*this == right)); }
@@ -196,6 +294,13 @@ public:
   friend std::ostream& operator<<(std::ostream& stream, const MetainfoMapImpl& s);
 
 private:
+  /// \brief First element whose key is not less than `key`
+  template <class MapType, class StringType>
+  static auto lowerBound(MapType& map, const StringType& key) noexcept -> decltype(map.begin()) {
+    return std::lower_bound(map.begin(), map.end(), key,
+                            [](const Entry& entry, const StringType& k) { return *entry.key < k; });
+  }
+
   map_type map_;
 };
 
@@ -18,28 +18,83 @@ struct InsertHelper {
   // Capture environment
   MetainfoMapImpl& map;
   const std::string& key;
-  const json::json& node;
+  const json::json& value;
 
   // Read value from JSON node (and check if the types match) and insert it into the MetainfoMapImpl
   // as
   // type ´T´
   template <class T, class CheckFunction>
   void insertAs(CheckFunction&& checkFunction, const char* valueStr) {
-    if(!(node["value"].*checkFunction)())
+    if(!(value.*checkFunction)())
       throw Exception("sub-node '%s' not regconized as %s", key, valueStr);
-    T value = node["value"];
-    map.insert(key, value);
+    T v = value;
+    map.insert(key, v);
   }
 
   // Read value from JSON node as Array of type ´T´ and insert as array of type ´T´ into the
   // MetainfoMapImpl
   template <class T>
   void insertAsArrayOf() {
-    Array<T> array = node["value"];
+    Array<T> array = value;
     map.insert(key, array);
   }
 };
 
+// Insert the JSON node `value` of type `type` as `key` into the map
+void insertValue(MetainfoMapImpl& map, const std::string& key, TypeID type,
+                 const json::json& value) {
+  const bool isArray = TypeUtil::isArray(type);
+
+  InsertHelper insertHelper{map, key, value};
+
+  switch(TypeUtil::getPrimitive(type)) {
+  case TypeID::Boolean:
+    if(isArray) {
+      insertHelper.insertAsArrayOf<bool>();
+    } else {
+      insertHelper.insertAs<bool>(&json::json::is_boolean, "boolean");
+    }
+    break;
+  case TypeID::Int32:
+    if(isArray) {
+      insertHelper.insertAsArrayOf<int>();
+    } else {
+      insertHelper.insertAs<int>(&json::json::is_number_integer, "integer");
+    }
+    break;
+  case TypeID::Int64:
+    if(isArray) {
+      insertHelper.insertAsArrayOf<std::int64_t>();
+    } else {
+      insertHelper.insertAs<std::int64_t>(&json::json::is_number_integer, "integer");
+    }
+    break;
+  case TypeID::Float32:
+    if(isArray) {
+      insertHelper.insertAsArrayOf<float>();
+    } else {
+      insertHelper.insertAs<float>(&json::json::is_number, "floating pointer number");
+    }
+    break;
+  case TypeID::Float64:
+    if(isArray) {
+      insertHelper.insertAsArrayOf<double>();
+    } else {
+      insertHelper.insertAs<double>(&json::json::is_number, "floating pointer number");
+    }
+    break;
+  case TypeID::String:
+    if(isArray) {
+      insertHelper.insertAsArrayOf<std::string>();
+    } else {
+      insertHelper.insertAs<std::string>(&json::json::is_string, "string");
+    }
+    break;
+  default:
+    serialbox_unreachable("Invalid TypeID");
+  }
+}
+
 } // namespace
 
 void to_json(json::json& jsonNode, MetainfoMapImpl const& map) {
@@ -52,53 +107,54 @@ void to_json(json::json& jsonNode, MetainfoMapImpl const& map) {
     json::json valueNode;
     const bool isArray = TypeUtil::isArray(value.type());
 
+    // The stored value is accessed directly (no conversion is needed)
     switch(TypeUtil::getPrimitive(value.type())) {
     case TypeID::Boolean:
       if(isArray) {
-        for(const bool& v : value.as<Array<bool>>())
+        for(const bool& v : value.get<Array<bool>>())
           valueNode.push_back(v);
       } else {
-        valueNode = value.as<bool>();
+        valueNode = value.get<bool>();
       }
       break;
     case TypeID::Int32:
       if(isArray) {
-        for(const int& v : value.as<Array<int>>())
+        for(const int& v : value.get<Array<int>>())
           valueNode.push_back(v);
       } else {
-        valueNode = value.as<int>();
+        valueNode = value.get<int>();
       }
       break;
     case TypeID::Int64:
       if(isArray) {
-        for(const std::int64_t& v : value.as<Array<std::int64_t>>())
+        for(const std::int64_t& v : value.get<Array<std::int64_t>>())
           valueNode.push_back(v);
       } else {
-        valueNode = value.as<std::int64_t>();
+        valueNode = value.get<std::int64_t>();
       }
       break;
     case TypeID::Float32:
       if(isArray) {
-        for(const float& v : value.as<Array<float>>())
+        for(const float& v : value.get<Array<float>>())
           valueNode.push_back(v);
       } else {
-        valueNode = value.as<float>();
+        valueNode = value.get<float>();
       }
       break;
     case TypeID::Float64:
       if(isArray) {
-        for(const double& v : value.as<Array<double>>())
+        for(const double& v : value.get<Array<double>>())
           valueNode.push_back(v);
       } else {
-        valueNode = value.as<double>();
+        valueNode = value.get<double>();
       }
       break;
     case TypeID::String:
       if(isArray) {
-        for(const std::string& v : value.as<Array<std::string>>())
+        for(const std::string& v : value.get<Array<std::string>>())
           valueNode.push_back(v);
       } else {
-        valueNode = value.as<std::string>();
+        valueNode = value.get<std::string>();
       }
       break;
     default:
@@ -124,59 +180,45 @@ void from_json(json::json const& jsonNode, MetainfoMapImpl& map) {
       throw Exception("sub-node '%s' has no node 'value'", it.key());
 
     const json::json& node = it.value();
-    const std::string& key = it.key();
     const int typeAsInt = node["type_id"];
-    const TypeID type = static_cast<TypeID>(typeAsInt);
-    const bool isArray = TypeUtil::isArray(type);
+    insertValue(map, it.key(), static_cast<TypeID>(typeAsInt), node["value"]);
+  }
+}
 
-    InsertHelper insertHelper{map, key, node};
+void from_json(JsonReader& reader, MetainfoMapImpl& map) {
+  map.clear();
 
-    switch(TypeUtil::getPrimitive(type)) {
-    case TypeID::Boolean:
-      if(isArray) {
-        insertHelper.insertAsArrayOf<bool>();
-      } else {
-        insertHelper.insertAs<bool>(&json::json::is_boolean, "boolean");
-      }
-      break;
-    case TypeID::Int32:
-      if(isArray) {
-        insertHelper.insertAsArrayOf<int>();
-      } else {
-        insertHelper.insertAs<int>(&json::json::is_number_integer, "integer");
-      }
-      break;
-    case TypeID::Int64:
-      if(isArray) {
-        insertHelper.insertAsArrayOf<std::int64_t>();
-      } else {
-        insertHelper.insertAs<std::int64_t>(&json::json::is_number_integer, "integer");
-      }
-      break;
-    case TypeID::Float32:
-      if(isArray) {
-        insertHelper.insertAsArrayOf<float>();
-      } else {
-        insertHelper.insertAs<float>(&json::json::is_number, "floating pointer number");
-      }
-      break;
-    case TypeID::Float64:
-      if(isArray) {
-        insertHelper.insertAsArrayOf<double>();
-      } else {
-        insertHelper.insertAs<double>(&json::json::is_number, "floating pointer number");
-      }
-      break;
-    case TypeID::String:
-      if(isArray) {
-        insertHelper.insertAsArrayOf<std::string>();
+  if(reader.readNull())
+    return;
+
+  reader.beginObject();
+  std::string key, member;
+  while(reader.nextKey(key)) {
+    int typeAsInt = 0;
+    json::json value;
+    bool hasType = false, hasValue = false;
+
+    // The value is a scalar or a (small) array and thus kept as `json::json`
+    reader.beginObject();
+    while(reader.nextKey(member)) {
+      if(member == "type_id") {
+        typeAsInt = static_cast<int>(reader.readInteger());
+        hasType = true;
+      } else if(member == "value") {
+        value = reader.readValue();
+        hasValue = true;
       } else {
-        insertHelper.insertAs<std::string>(&json::json::is_string, "string");
+        reader.skipValue();
       }
-      break;
-    default:
-      serialbox_unreachable("Invalid TypeID");
     }
+
+    if(!hasType)
+      throw Exception("sub-node '%s' has no node 'type_id'", key);
+
+    if(!hasValue)
+      throw Exception("sub-node '%s' has no node 'value'", key);
+
+    insertValue(map, key, static_cast<TypeID>(typeAsInt), value);
   }
 }
 
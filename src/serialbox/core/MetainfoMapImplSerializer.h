@@ -16,6 +16,7 @@
 #define SERIALBOX_CORE_METAINFOMAPIMPLSERIALIZER_H
 
 #include "serialbox/core/Json.h"
+#include "serialbox/core/JsonReader.h"
 #include "serialbox/core/MetainfoMapImpl.h"
 
 namespace serialbox {
@@ -25,6 +26,8 @@ namespace serialbox {
 void to_json(json::json& jsonNode, MetainfoMapImpl const& map);
 
 void from_json(json::json const& jsonNode, MetainfoMapImpl& map);
+
+void from_json(JsonReader& reader, MetainfoMapImpl& map);
 /// @}
 
 } // namespace serialbox
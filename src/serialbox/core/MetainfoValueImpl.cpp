@@ -22,10 +22,10 @@ namespace serialbox {
 
 namespace internal {
 
-/// Convert any to type T
+/// Interpret the stored value `data` as type T
 template <class T>
-const T& convert(const boost::any& any) noexcept {
-  return *boost::any_cast<T>(&any);
+const T& convert(const void* data) noexcept {
+  return *static_cast<const T*>(data);
 }
 
 /// Construct T from string
@@ -38,25 +38,25 @@ T fromString(StringType&& valueStr) {
   return value;
 }
 
-/// Convert any to primtive T
+/// Convert the stored value to primtive T
 template <class T>
-T makePrimitiveOf(const boost::any& any, TypeID type);
+T makePrimitiveOf(const void* data, TypeID type);
 
 template <>
-bool makePrimitiveOf<bool>(const boost::any& any, TypeID type) {
+bool makePrimitiveOf<bool>(const void* data, TypeID type) {
   switch(type) {
   case TypeID::Boolean:
-    return convert<bool>(any);
+    return convert<bool>(data);
   case TypeID::Int32:
-    return (bool)convert<int>(any);
+    return (bool)convert<int>(data);
   case TypeID::Int64:
-    return (bool)convert<std::int64_t>(any);
+    return (bool)convert<std::int64_t>(data);
   case TypeID::Float32:
-    return (bool)convert<float>(any);
+    return (bool)convert<float>(data);
   case TypeID::Float64:
-    return (bool)convert<double>(any);
+    return (bool)convert<double>(data);
   case TypeID::String:
-    return internal::fromString<bool>(convert<std::string>(any));
+    return internal::fromString<bool>(convert<std::string>(data));
   default:
     throw Exception("cannot convert [type = %s] to [T = bool]", TypeUtil::toString(type));
   }
@@ -64,28 +64,28 @@ bool makePrimitiveOf<bool>(const boost::any& any, TypeID type) {
 }
 
 template <>
-int makePrimitiveOf<int>(const boost::any& any, TypeID type) {
+int makePrimitiveOf<int>(const void* data, TypeID type) {
   switch(type) {
   case TypeID::Boolean:
-    return (int)convert<bool>(any);
+    return (int)convert<bool>(data);
   case TypeID::Int32:
-    return convert<int>(any);
+    return convert<int>(data);
   case TypeID::Int64:
-    return (int)convert<std::int64_t>(any);
+    return (int)convert<std::int64_t>(data);
   case TypeID::Float32: {
-    if((float)static_cast<int>(convert<float>(any)) != convert<float>(any))
+    if((float)static_cast<int>(convert<float>(data)) != convert<float>(data))
       throw Exception("conversion of [type = %s] to [T = %s] results in truncation of the value",
                       TypeUtil::toString(type), TypeUtil::toString(ToTypeID<int>::value));
-    return (int)convert<float>(any);
+    return (int)convert<float>(data);
   }
   case TypeID::Float64: {
-    if((double)static_cast<int>(convert<double>(any)) != convert<double>(any))
+    if((double)static_cast<int>(convert<double>(data)) != convert<double>(data))
       throw Exception("conversion of [type = %s] to [T = %s] results in truncation of the value",
                       TypeUtil::toString(type), TypeUtil::toString(ToTypeID<int>::value));
-    return (int)convert<double>(any);
+    return (int)convert<double>(data);
   }
   case TypeID::String:
-    return internal::fromString<int>(convert<std::string>(any));
+    return internal::fromString<int>(convert<std::string>(data));
   default:
     throw Exception("cannot convert [type = %s] to [T = int]", TypeUtil::toString(type));
   }
@@ -93,28 +93,28 @@ int makePrimitiveOf<int>(const boost::any& any, TypeID type) {
 }
 
 template <>
-std::int64_t makePrimitiveOf<std::int64_t>(const boost::any& any, TypeID type) {
+std::int64_t makePrimitiveOf<std::int64_t>(const void* data, TypeID type) {
   switch(type) {
   case TypeID::Boolean:
-    return (std::int64_t)convert<bool>(any);
+    return (std::int64_t)convert<bool>(data);
   case TypeID::Int32:
-    return (std::int64_t)convert<int>(any);
+    return (std::int64_t)convert<int>(data);
   case TypeID::Int64:
-    return convert<std::int64_t>(any);
+    return convert<std::int64_t>(data);
   case TypeID::Float32: {
-    if((float)static_cast<std::int64_t>(convert<float>(any)) != convert<float>(any))
+    if((float)static_cast<std::int64_t>(convert<float>(data)) != convert<float>(data))
       throw Exception("conversion of [type = %s] to [T = %s] results in truncation of the value",
                       TypeUtil::toString(type), TypeUtil::toString(ToTypeID<std::int64_t>::value));
-    return (std::int64_t)convert<float>(any);
+    return (std::int64_t)convert<float>(data);
   }
   case TypeID::Float64: {
-    if((double)static_cast<std::int64_t>(convert<double>(any)) != convert<double>(any))
+    if((double)static_cast<std::int64_t>(convert<double>(data)) != convert<double>(data))
       throw Exception("conversion of [type = %s] to [T = %s] results in truncation of the value",
                       TypeUtil::toString(type), TypeUtil::toString(ToTypeID<std::int64_t>::value));
-    return (std::int64_t)convert<double>(any);
+    return (std::int64_t)convert<double>(data);
   }
   case TypeID::String:
-    return internal::fromString<std::int64_t>(convert<std::string>(any));
+    return internal::fromString<std::int64_t>(convert<std::string>(data));
   default:
     throw Exception("cannot convert [type = %s] to [T = std::int64_t]", TypeUtil::toString(type));
   }
@@ -122,20 +122,20 @@ std::int64_t makePrimitiveOf<std::int64_t>(const boost::any& any, TypeID type) {
 }
 
 template <>
-float makePrimitiveOf<float>(const boost::any& any, TypeID type) {
+float makePrimitiveOf<float>(const void* data, TypeID type) {
   switch(type) {
   case TypeID::Boolean:
-    return (float)convert<bool>(any);
+    return (float)convert<bool>(data);
   case TypeID::Int32:
-    return (float)convert<int>(any);
+    return (float)convert<int>(data);
   case TypeID::Int64:
-    return (float)convert<std::int64_t>(any);
+    return (float)convert<std::int64_t>(data);
   case TypeID::Float32:
-    return convert<float>(any);
+    return convert<float>(data);
   case TypeID::Float64:
-    return (float)convert<double>(any);
+    return (float)convert<double>(data);
   case TypeID::String:
-    return internal::fromString<float>(convert<std::string>(any));
+    return internal::fromString<float>(convert<std::string>(data));
   default:
     throw Exception("cannot convert [type = %s] to [T = float]", TypeUtil::toString(type));
   }
@@ -143,20 +143,20 @@ float makePrimitiveOf<float>(const boost::any& any, TypeID type) {
 }
 
 template <>
-double makePrimitiveOf<double>(const boost::any& any, TypeID type) {
+double makePrimitiveOf<double>(const void* data, TypeID type) {
   switch(type) {
   case TypeID::Boolean:
-    return (double)convert<bool>(any);
+    return (double)convert<bool>(data);
   case TypeID::Int32:
-    return (double)convert<int>(any);
+    return (double)convert<int>(data);
   case TypeID::Int64:
-    return (double)convert<std::int64_t>(any);
+    return (double)convert<std::int64_t>(data);
   case TypeID::Float32:
-    return (double)convert<float>(any);
+    return (double)convert<float>(data);
   case TypeID::Float64:
-    return convert<double>(any);
+    return convert<double>(data);
   case TypeID::String:
-    return internal::fromString<double>(convert<std::string>(any));
+    return internal::fromString<double>(convert<std::string>(data));
   default:
     throw Exception("cannot convert [type = %s] to [T = double]", TypeUtil::toString(type));
   }
@@ -164,29 +164,29 @@ double makePrimitiveOf<double>(const boost::any& any, TypeID type) {
 }
 
 template <>
-std::string makePrimitiveOf<std::string>(const boost::any& any, TypeID type) {
+std::string makePrimitiveOf<std::string>(const void* data, TypeID type) {
   switch(type) {
   case TypeID::Boolean:
-    return (convert<bool>(any) ? "true" : "false");
+    return (convert<bool>(data) ? "true" : "false");
   case TypeID::Int32:
-    return std::to_string(convert<int>(any));
+    return std::to_string(convert<int>(data));
   case TypeID::Int64:
-    return std::to_string(convert<std::int64_t>(any));
+    return std::to_string(convert<std::int64_t>(data));
   case TypeID::Float32:
-    return std::to_string(convert<float>(any));
+    return std::to_string(convert<float>(data));
   case TypeID::Float64:
-    return std::to_string(convert<double>(any));
+    return std::to_string(convert<double>(data));
   case TypeID::String:
-    return convert<std::string>(any);
+    return convert<std::string>(data);
   default:
     throw Exception("cannot convert [type = %s] to [T = std::string]", TypeUtil::toString(type));
   }
   serialbox_unreachable("Invalid TypeID");
 }
 
-/// Convert any to array of T
+/// Convert the stored value to array of T
 template <class T, class ArrayType = Array<T>>
-ArrayType makeArrayOf(const boost::any& any, TypeID type) {
+ArrayType makeArrayOf(const void* data, TypeID type) {
   if(!TypeUtil::isArray(type))
     throw Exception("cannot convert non-array [type = %s] to array [T = %s]",
                     TypeUtil::toString(type), TypeUtil::toString(ToTypeID<ArrayType>::value));
@@ -195,39 +195,39 @@ ArrayType makeArrayOf(const boost::any& any, TypeID type) {
 
   switch(TypeUtil::getPrimitive(type)) {
   case TypeID::Boolean: {
-    const auto& array = convert<Array<bool>>(any);
-    for(const auto& a : array)
-      arrayT.push_back(makePrimitiveOf<T>(boost::any(bool(a)), TypeID::Boolean));
+    const auto& array = convert<Array<bool>>(data);
+    for(const bool a : array)
+      arrayT.push_back(makePrimitiveOf<T>(&a, TypeID::Boolean));
     break;
   }
   case TypeID::Int32: {
-    const auto& array = convert<Array<int>>(any);
-    for(const auto& a : array)
-      arrayT.push_back(makePrimitiveOf<T>(boost::any(int(a)), TypeID::Int32));
+    const auto& array = convert<Array<int>>(data);
+    for(const int a : array)
+      arrayT.push_back(makePrimitiveOf<T>(&a, TypeID::Int32));
     break;
   }
   case TypeID::Int64: {
-    const auto& array = convert<Array<std::int64_t>>(any);
-    for(const auto& a : array)
-      arrayT.push_back(makePrimitiveOf<T>(boost::any(std::int64_t(a)), TypeID::Int64));
+    const auto& array = convert<Array<std::int64_t>>(data);
+    for(const std::int64_t a : array)
+      arrayT.push_back(makePrimitiveOf<T>(&a, TypeID::Int64));
     break;
   }
   case TypeID::Float32: {
-    const auto& array = convert<Array<float>>(any);
-    for(const auto& a : array)
-      arrayT.push_back(makePrimitiveOf<T>(boost::any(float(a)), TypeID::Float32));
+    const auto& array = convert<Array<float>>(data);
+    for(const float a : array)
+      arrayT.push_back(makePrimitiveOf<T>(&a, TypeID::Float32));
     break;
   }
   case TypeID::Float64: {
-    const auto& array = convert<Array<double>>(any);
-    for(const auto& a : array)
-      arrayT.push_back(makePrimitiveOf<T>(boost::any(double(a)), TypeID::Float64));
+    const auto& array = convert<Array<double>>(data);
+    for(const double a : array)
+      arrayT.push_back(makePrimitiveOf<T>(&a, TypeID::Float64));
     break;
   }
   case TypeID::String: {
-    const auto& array = convert<Array<std::string>>(any);
+    const auto& array = convert<Array<std::string>>(data);
     for(const auto& a : array)
-      arrayT.push_back(makePrimitiveOf<T>(boost::any(std::string(a)), TypeID::String));
+      arrayT.push_back(makePrimitiveOf<T>(&a, TypeID::String));
     break;
   }
   default:
@@ -243,101 +243,136 @@ bool MetainfoValueImpl::operator==(const MetainfoValueImpl& right) const noexcep
   if(type_ != right.type_)
     return false;
 
+  // Copies share the out of line storage
+  if(!isInline(type_) && object_ == right.object_)
+    return true;
+
   switch(type_) {
 
   // Primitive
   case TypeID::Boolean:
-    return (convert<bool>() == right.convert<bool>());
+    return (get<bool>() == right.get<bool>());
   case TypeID::Int32:
-    return (convert<int>() == right.convert<int>());
+    return (get<int>() == right.get<int>());
   case TypeID::Int64:
-    return (convert<std::int64_t>() == right.convert<std::int64_t>());
+    return (get<std::int64_t>() == right.get<std::int64_t>());
   case TypeID::Float32:
-    return (convert<float>() == right.convert<float>());
+    return (get<float>() == right.get<float>());
   case TypeID::Float64:
-    return (convert<double>() == right.convert<double>());
+    return (get<double>() == right.get<double>());
   case TypeID::String:
-    return (convert<std::string>() == right.convert<std::string>());
+    return (get<std::string>() == right.get<std::string>());
 
   // Array
   case TypeID::ArrayOfBoolean:
-    return (convert<Array<bool>>() == right.convert<Array<bool>>());
+    return (get<Array<bool>>() == right.get<Array<bool>>());
   case TypeID::ArrayOfInt32:
-    return (convert<Array<int>>() == right.convert<Array<int>>());
+    return (get<Array<int>>() == right.get<Array<int>>());
   case TypeID::ArrayOfInt64:
-    return (convert<Array<std::int64_t>>() == right.convert<Array<std::int64_t>>());
+    return (get<Array<std::int64_t>>() == right.get<Array<std::int64_t>>());
   case TypeID::ArrayOfFloat32:
-    return (convert<Array<float>>() == right.convert<Array<float>>());
+    return (get<Array<float>>() == right.get<Array<float>>());
   case TypeID::ArrayOfFloat64:
-    return (convert<Array<double>>() == right.convert<Array<double>>());
+    return (get<Array<double>>() == right.get<Array<double>>());
   case TypeID::ArrayOfString:
-    return (convert<Array<std::string>>() == right.convert<Array<std::string>>());
+    return (get<Array<std::string>>() == right.get<Array<std::string>>());
 
   default:
     serialbox_unreachable("Invalid TypeID");
   }
 }
 
+boost::any MetainfoValueImpl::any() const {
+  switch(type_) {
+  case TypeID::Boolean:
+    return boost::any(get<bool>());
+  case TypeID::Int32:
+    return boost::any(get<int>());
+  case TypeID::Int64:
+    return boost::any(get<std::int64_t>());
+  case TypeID::Float32:
+    return boost::any(get<float>());
+  case TypeID::Float64:
+    return boost::any(get<double>());
+  case TypeID::String:
+    return boost::any(get<std::string>());
+  case TypeID::ArrayOfBoolean:
+    return boost::any(get<Array<bool>>());
+  case TypeID::ArrayOfInt32:
+    return boost::any(get<Array<int>>());
+  case TypeID::ArrayOfInt64:
+    return boost::any(get<Array<std::int64_t>>());
+  case TypeID::ArrayOfFloat32:
+    return boost::any(get<Array<float>>());
+  case TypeID::ArrayOfFloat64:
+    return boost::any(get<Array<double>>());
+  case TypeID::ArrayOfString:
+    return boost::any(get<Array<std::string>>());
+  default:
+    return boost::any();
+  }
+}
+
 std::string MetainfoValueImpl::toString() const { return as<std::string>(); }
 
 template <>
 bool MetainfoValueImpl::as() const {
-  return internal::makePrimitiveOf<bool>(any_, type_);
+  return internal::makePrimitiveOf<bool>(data(), type_);
 }
 
 template <>
 int MetainfoValueImpl::as() const {
-  return internal::makePrimitiveOf<int>(any_, type_);
+  return internal::makePrimitiveOf<int>(data(), type_);
 }
 
 template <>
 std::int64_t MetainfoValueImpl::as() const {
-  return internal::makePrimitiveOf<std::int64_t>(any_, type_);
+  return internal::makePrimitiveOf<std::int64_t>(data(), type_);
 }
 
 template <>
 float MetainfoValueImpl::as() const {
-  return internal::makePrimitiveOf<float>(any_, type_);
+  return internal::makePrimitiveOf<float>(data(), type_);
 }
 
 template <>
 double MetainfoValueImpl::as() const {
-  return internal::makePrimitiveOf<double>(any_, type_);
+  return internal::makePrimitiveOf<double>(data(), type_);
 }
 
 template <>
 std::string MetainfoValueImpl::as() const {
-  return internal::makePrimitiveOf<std::string>(any_, type_);
+  return internal::makePrimitiveOf<std::string>(data(), type_);
 }
 
 template <>
 Array<bool> MetainfoValueImpl::as() const {
-  return internal::makeArrayOf<bool>(any_, type_);
+  return internal::makeArrayOf<bool>(data(), type_);
 }
 
 template <>
 Array<int> MetainfoValueImpl::as() const {
-  return internal::makeArrayOf<int>(any_, type_);
+  return internal::makeArrayOf<int>(data(), type_);
 }
 
 template <>
 Array<std::int64_t> MetainfoValueImpl::as() const {
-  return internal::makeArrayOf<std::int64_t>(any_, type_);
+  return internal::makeArrayOf<std::int64_t>(data(), type_);
 }
 
 template <>
 Array<float> MetainfoValueImpl::as() const {
-  return internal::makeArrayOf<float>(any_, type_);
+  return internal::makeArrayOf<float>(data(), type_);
 }
 
 template <>
 Array<double> MetainfoValueImpl::as() const {
-  return internal::makeArrayOf<double>(any_, type_);
+  return internal::makeArrayOf<double>(data(), type_);
 }
 
 template <>
 Array<std::string> MetainfoValueImpl::as() const {
-  return internal::makeArrayOf<std::string>(any_, type_);
+  return internal::makeArrayOf<std::string>(data(), type_);
 }
 
 } // namespace serialbox
@@ -19,7 +19,8 @@
 #include "serialbox/core/Exception.h"
 #include "serialbox/core/Type.h"
 #include <boost/any.hpp>
-#include <boost/mpl/if.hpp>
+#include <cstdint>
+#include <memory>
 #include <type_traits>
 
 namespace serialbox {
@@ -27,13 +28,17 @@ namespace serialbox {
 /// \addtogroup core
 /// @{
 
-/// \brief Represent an immutable meta information value as a type-id and type-erased data
+/// \brief Represent an immutable meta information value as a type-id and a tagged value
+///
+/// Scalars (bool, int, std::int64_t, float and double) are stored inline, strings and arrays are
+/// allocated out of line and shared between copies (the value is immutable). Hence, constructing,
+/// copying and comparing scalars never allocates or goes through type-erasure.
 ///
 /// The MetainfoValueImpl can be implicitly casted to the supported types.
 class MetainfoValueImpl {
 public:
   /// \brief Default constructor
-  MetainfoValueImpl() : type_(TypeID::Invalid), any_(){};
+  MetainfoValueImpl() : type_(TypeID::Invalid) { scalar_.i64 = 0; }
 
   /// \brief Copy constructor
   MetainfoValueImpl(const MetainfoValueImpl&) = default;
@@ -59,7 +64,8 @@ public:
     static_assert(IsSupported<PrimitiveType>::value, "ValueType is not supported");
 
     type_ = ToTypeID<DecayedValueType>::value;
-    any_ = boost::any(DecayedValueType(value));
+    scalar_.i64 = 0;
+    store(DecayedValueType(std::forward<ValueType>(value)));
   }
   explicit MetainfoValueImpl(const char* value) : MetainfoValueImpl(std::string(value)) {}
 
@@ -89,8 +95,9 @@ public:
 
   /// \brief Swap with other
   void swap(MetainfoValueImpl& other) noexcept {
-    any_.swap(other.any_);
     std::swap(type_, other.type_);
+    std::swap(scalar_, other.scalar_);
+    object_.swap(other.object_);
   }
 
   /// \brief Test for equality
@@ -102,22 +109,62 @@ public:
   /// \brief Get TypeID
   TypeID type() const noexcept { return type_; }
 
-  /// \brief Get boost::any
-  boost::any& any() noexcept { return any_; }
-  const boost::any& any() const noexcept { return any_; }
+  /// \brief Get a copy of the value as boost::any
+  boost::any any() const;
+
+  /// \brief Get the stored value (`T` has to match the type)
+  template <class T>
+  const T& get() const noexcept {
+    return *static_cast<const T*>(data());
+  }
+
+  /// \brief Get a pointer to the stored value (`nullptr` if the value is invalid)
+  const void* data() const noexcept {
+    return isInline(type_) ? static_cast<const void*>(&scalar_) : object_.get();
+  }
 
   /// \brief Convert to string
   std::string toString() const;
 
 private:
+  /// \brief Check if values of type `type` are stored inline
+  static bool isInline(TypeID type) noexcept {
+    switch(type) {
+    case TypeID::Boolean:
+    case TypeID::Int32:
+    case TypeID::Int64:
+    case TypeID::Float32:
+    case TypeID::Float64:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  void store(bool value) noexcept { scalar_.b = value; }
+  void store(int value) noexcept { scalar_.i32 = value; }
+  void store(std::int64_t value) noexcept { scalar_.i64 = value; }
+  void store(float value) noexcept { scalar_.f32 = value; }
+  void store(double value) noexcept { scalar_.f64 = value; }
+
   template <class T>
-  const T& convert() const noexcept {
-    return *boost::any_cast<T>(&any_);
+  void store(T&& value) {
+    object_ = std::make_shared<const typename std::decay<T>::type>(std::forward<T>(value));
   }
 
 private:
-  TypeID type_;    ///< Type of the data
-  boost::any any_; ///< Type-erased value of the data
+  /// \brief Inline storage of scalars
+  union Scalar {
+    bool b;
+    int i32;
+    std::int64_t i64;
+    float f32;
+    double f64;
+  };
+
+  TypeID type_;                        ///< Type of the data
+  Scalar scalar_;                      ///< Value of scalars
+  std::shared_ptr<const void> object_; ///< Value of strings and arrays (shared between copies)
 };
 
 template <>
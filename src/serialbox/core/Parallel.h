@@ -0,0 +1,83 @@
+//===-- serialbox/core/Parallel.h ---------------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains a simple parallel loop based on std::thread.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_PARALLEL_H
+#define SERIALBOX_CORE_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace serialbox {
+
+/// \addtogroup core
+/// @{
+
+/// \brief Call `function(i)` for all i in [0, `n`) using up to `maxThreads` threads
+///
+/// The iterations are distributed round-robin over the threads, the calling thread takes part in
+/// the work. If `maxThreads` is 0, the number of hardware threads is used. Nested loops (i.e
+/// calls from within `function`) run in the calling thread to avoid spawning threads per thread.
+/// The first exception thrown by `function` is rethrown after all threads finished.
+inline void parallelFor(std::size_t n, const std::function<void(std::size_t)>& function,
+                        std::size_t maxThreads = 0) {
+  static thread_local bool isNested = false;
+
+  if(maxThreads == 0)
+    maxThreads = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+  std::size_t numThreads = isNested ? 1 : std::min<std::size_t>(n, maxThreads);
+
+  if(numThreads <= 1) {
+    for(std::size_t i = 0; i < n; ++i)
+      function(i);
+    return;
+  }
+
+  std::exception_ptr exception;
+  std::mutex exceptionMutex;
+  auto worker = [&](std::size_t thread) {
+    const bool wasNested = isNested;
+    isNested = true;
+    try {
+      for(std::size_t i = thread; i < n; i += numThreads)
+        function(i);
+    } catch(...) {
+      std::lock_guard<std::mutex> lock(exceptionMutex);
+      if(!exception)
+        exception = std::current_exception();
+    }
+    isNested = wasNested;
+  };
+
+  std::vector<std::thread> threads;
+  for(std::size_t thread = 1; thread < numThreads; ++thread)
+    threads.emplace_back(worker, thread);
+  worker(0);
+
+  for(auto& thread : threads)
+    thread.join();
+
+  if(exception)
+    std::rethrow_exception(exception);
+}
+
+/// @}
+
+} // namespace serialbox
+
+#endif
@@ -32,4 +32,31 @@ void from_json(json::json const& jsonNode, SavepointImpl& savepoint) {
     savepoint.metaInfo() = jsonNode["meta_info"];
 }
 
+void from_json(JsonReader& reader, SavepointImpl& savepoint) {
+  if(!savepoint.metaInfoPtr())
+    savepoint.metaInfoPtr() = std::make_shared<MetainfoMapImpl>();
+
+  savepoint.metaInfo().clear();
+
+  if(reader.readNull())
+    throw Exception("node is empty");
+
+  bool hasName = false;
+  reader.beginObject();
+  std::string key;
+  while(reader.nextKey(key)) {
+    if(key == "name") {
+      savepoint.setName(reader.readString());
+      hasName = true;
+    } else if(key == "meta_info") {
+      from_json(reader, savepoint.metaInfo());
+    } else {
+      reader.skipValue();
+    }
+  }
+
+  if(!hasName)
+    throw Exception("no node 'name'");
+}
+
 } // namespace serialbox
@@ -16,6 +16,7 @@
 #define SERIALBOX_CORE_SAVEPOINTIMPLSERIALIZER_H
 
 #include "serialbox/core/Json.h"
+#include "serialbox/core/JsonReader.h"
 #include "serialbox/core/SavepointImpl.h"
 
 namespace serialbox {
@@ -25,6 +26,8 @@ namespace serialbox {
 void to_json(json::json& jsonNode, SavepointImpl const& savepoint);
 
 void from_json(json::json const& jsonNode, SavepointImpl& savepoint);
+
+void from_json(JsonReader& reader, SavepointImpl& savepoint);
 /// @}
 
 } // namespace serialbox
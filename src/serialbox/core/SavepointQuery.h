@@ -0,0 +1,104 @@
+//===-- serialbox/core/SavepointQuery.h ---------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file provides the SavepointQuery which describes a query of the registered savepoints.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_SAVEPOINTQUERY_H
+#define SERIALBOX_CORE_SAVEPOINTQUERY_H
+
+#include "serialbox/core/MetainfoValueImpl.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace serialbox {
+
+/// \addtogroup core
+/// @{
+
+/// \brief Query of the registered savepoints by their name and meta-information
+///
+/// A savepoint matches the query if it has the requested name (if any) and satisfies all
+/// predicates on its meta-information:
+///
+/// \code
+///   SavepointQuery query;
+///   query.name("step").range("time", 100, 200); // savepoints "step" with 100 <= time < 200
+/// \endcode
+///
+/// Numeric values (integers and floating point numbers) are compared by their value converted to
+/// `double` (i.e `equal("step", 1)` also matches a value of `1.0`), booleans and strings only match
+/// values of the same type. Arrays never match.
+///
+/// \see SavepointVector::query
+class SavepointQuery {
+public:
+  /// \brief Kind of a predicate
+  enum class PredicateKind {
+    Equal, ///< `value == Predicate::value`
+    Range  ///< `Predicate::lower <= value < Predicate::upper`
+  };
+
+  /// \brief Predicate on the value of a meta-information key
+  struct Predicate {
+    PredicateKind kind;
+    std::string key;
+    MetainfoValueImpl value;
+    double lower;
+    double upper;
+  };
+
+  /// \brief Only match savepoints with name `name`
+  SavepointQuery& name(std::string name) {
+    name_ = std::move(name);
+    hasName_ = true;
+    return *this;
+  }
+
+  /// \brief Only match savepoints whose value of `key` is equal to `value`
+  template <class ValueType>
+  SavepointQuery& equal(std::string key, ValueType&& value) {
+    predicates_.push_back(Predicate{PredicateKind::Equal, std::move(key),
+                                    MetainfoValueImpl(std::forward<ValueType>(value)), 0.0, 0.0});
+    return *this;
+  }
+
+  /// \brief Only match savepoints whose value of `key` is in the half-open range `[lower, upper)`
+  SavepointQuery& range(std::string key, double lower, double upper) {
+    predicates_.push_back(
+        Predicate{PredicateKind::Range, std::move(key), MetainfoValueImpl(), lower, upper});
+    return *this;
+  }
+
+  /// \brief Check if the query restricts the name of the savepoints
+  bool hasName() const noexcept { return hasName_; }
+
+  /// \brief Name of the savepoints (only meaningful if SavepointQuery::hasName is true)
+  const std::string& name() const noexcept { return name_; }
+
+  /// \brief Predicates on the meta-information
+  const std::vector<Predicate>& predicates() const noexcept { return predicates_; }
+
+  /// \brief Check if the query matches all savepoints
+  bool empty() const noexcept { return (!hasName_ && predicates_.empty()); }
+
+private:
+  std::string name_;
+  bool hasName_ = false;
+  std::vector<Predicate> predicates_;
+};
+
+/// @}
+
+} // namespace serialbox
+
+#endif
@@ -16,17 +16,229 @@
 #include "serialbox/core/SavepointVector.h"
 #include "serialbox/core/Logging.h"
 #include "serialbox/core/SavepointVectorSerializer.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <numeric>
 
 namespace serialbox {
 
+namespace {
+
+void hashCombine(std::size_t& seed, std::size_t value) noexcept {
+  seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+/// Hash of a meta-information value (consistent with MetainfoValueImpl::operator==)
+std::size_t hashValue(const MetainfoValueImpl& value) noexcept {
+  std::size_t hash = std::size_t(value.type());
+  switch(value.type()) {
+  case TypeID::Boolean:
+    hashCombine(hash, value.get<bool>());
+    break;
+  case TypeID::Int32:
+    hashCombine(hash, std::hash<int>()(value.get<int>()));
+    break;
+  case TypeID::Int64:
+    hashCombine(hash, std::hash<std::int64_t>()(value.get<std::int64_t>()));
+    break;
+  case TypeID::Float32:
+    // 0.0 and -0.0 compare equal
+    hashCombine(hash, value.get<float>() == 0.0f ? 0 : std::hash<float>()(value.get<float>()));
+    break;
+  case TypeID::Float64:
+    hashCombine(hash, value.get<double>() == 0.0 ? 0 : std::hash<double>()(value.get<double>()));
+    break;
+  case TypeID::String:
+    hashCombine(hash, std::hash<std::string>()(value.get<std::string>()));
+    break;
+  default:
+    // Arrays are only distinguished by their type
+    break;
+  }
+  return hash;
+}
+
+std::size_t hashSavepoint(const InternedString& name, const MetainfoMapImpl& metaInfo) noexcept {
+  std::size_t hash = std::hash<InternedString>()(name);
+  for(const MetainfoMapImpl::Entry& entry : metaInfo.entries()) {
+    hashCombine(hash, std::hash<InternTable::Handle>()(entry.key));
+    hashCombine(hash, hashValue(entry.value));
+  }
+  return hash;
+}
+
+/// Slot of `hash` in an index of `numSlots` slots (a power of two)
+std::size_t slotOf(std::size_t hash, std::size_t numSlots) noexcept {
+  // Finalizer of MurmurHash3 as the hashes of the handles (i.e pointers) have poor low bits
+  std::uint64_t h = hash;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb53fa8ec4dd3ULL;
+  h ^= h >> 33;
+  return std::size_t(h) & (numSlots - 1);
+}
+
+using NumberEntry = std::pair<double, int>;
+
+bool isNumeric(TypeID type) noexcept {
+  return (type == TypeID::Int32 || type == TypeID::Int64 || type == TypeID::Float32 ||
+          type == TypeID::Float64);
+}
+
+double toNumber(const MetainfoValueImpl& value) noexcept {
+  switch(value.type()) {
+  case TypeID::Int32:
+    return value.get<int>();
+  case TypeID::Int64:
+    return double(value.get<std::int64_t>());
+  case TypeID::Float32:
+    return value.get<float>();
+  default:
+    return value.get<double>();
+  }
+}
+
+/// Predicate of a SavepointQuery with its key resolved to the interned handle
+struct ResolvedPredicate {
+  const SavepointQuery::Predicate* predicate;
+  InternTable::Handle key;
+  bool numeric; // Compare the numeric value to [lower, upper) (or to lower for Equal)
+  double lower;
+  double upper;
+};
+
+/// SavepointQuery with its name and keys resolved to the interned handles
+struct ResolvedQuery {
+  InternTable::Handle name = nullptr;
+  std::vector<ResolvedPredicate> predicates;
+};
+
+/// Resolve `query` (returns false if the query can not match any savepoint)
+bool resolveQuery(const SavepointQuery& query, ResolvedQuery& resolved) {
+  if(query.hasName()) {
+    resolved.name = InternedString::lookup(query.name()).handle();
+    if(!resolved.name)
+      return false;
+  }
+
+  for(const SavepointQuery::Predicate& predicate : query.predicates()) {
+    ResolvedPredicate p{&predicate, InternTable::global().find(predicate.key), true,
+                        predicate.lower, predicate.upper};
+    if(!p.key)
+      return false;
+
+    if(predicate.kind == SavepointQuery::PredicateKind::Equal) {
+      if(TypeUtil::isArray(predicate.value.type()))
+        return false;
+      p.numeric = isNumeric(predicate.value.type());
+      if(p.numeric)
+        p.lower = p.upper = toNumber(predicate.value);
+    }
+    resolved.predicates.push_back(p);
+  }
+  return true;
+}
+
+bool matchesPredicate(const MetainfoValueImpl& value, const ResolvedPredicate& p) noexcept {
+  if(p.numeric) {
+    if(!isNumeric(value.type()))
+      return false;
+    const double number = toNumber(value);
+    if(p.predicate->kind == SavepointQuery::PredicateKind::Equal)
+      return number == p.lower;
+    return (p.lower <= number && number < p.upper);
+  }
+  return (value.type() == p.predicate->value.type() && value == p.predicate->value);
+}
+
+/// Check if the savepoint with `name` and meta-information [first, last) matches `query`
+bool matchesQuery(const ResolvedQuery& query, const InternedString& name,
+                  MetainfoMapImpl::map_type::const_iterator first,
+                  MetainfoMapImpl::map_type::const_iterator last) noexcept {
+  if(query.name && name.handle() != query.name)
+    return false;
+
+  for(const ResolvedPredicate& p : query.predicates) {
+    auto it = std::find_if(first, last,
+                           [&](const MetainfoMapImpl::Entry& entry) { return entry.key == p.key; });
+    if(it == last || !matchesPredicate(it->value, p))
+      return false;
+  }
+  return true;
+}
+
+/// Range of the entries of the sorted `numbers` which satisfy the numeric predicate `p`
+std::pair<std::vector<NumberEntry>::const_iterator, std::vector<NumberEntry>::const_iterator>
+numberRange(const std::vector<NumberEntry>& numbers, const ResolvedPredicate& p) noexcept {
+  auto less = [](const NumberEntry& entry, double value) { return entry.first < value; };
+  auto first = std::lower_bound(numbers.begin(), numbers.end(), p.lower, less);
+  if(p.predicate->kind == SavepointQuery::PredicateKind::Equal)
+    return std::make_pair(first, std::upper_bound(first, numbers.end(), p.lower,
+                                                  [](double value, const NumberEntry& entry) {
+                                                    return value < entry.first;
+                                                  }));
+  return std::make_pair(first, std::lower_bound(first, numbers.end(), p.upper, less));
+}
+
+} // anonymous namespace
+
+SavepointVector::SavepointVector(const SavepointVector& other)
+    : names_(other.names_), metaInfoOffsets_(other.metaInfoOffsets_),
+      metaInfoArena_(other.metaInfoArena_), hashes_(other.hashes_), slots_(other.slots_),
+      fields_(other.fields_), fieldNames_(other.fieldNames_),
+      fieldSavepoints_(other.fieldSavepoints_), fieldIndices_(other.fieldIndices_) {}
+
+SavepointVector& SavepointVector::operator=(const SavepointVector& other) {
+  SavepointVector tmp(other);
+  swap(tmp);
+  return *this;
+}
+
+SavepointVector& SavepointVector::operator=(SavepointVector&& other) noexcept {
+  SavepointVector tmp(std::move(other));
+  swap(tmp);
+  return *this;
+}
+
 int SavepointVector::insert(const SavepointImpl& savepoint) noexcept {
-  int idx = savepoints_.size();
-  if(index_.insert(typename index_type::value_type{savepoint, idx}).second) {
-    savepoints_.push_back(std::make_shared<SavepointImpl>(savepoint));
-    fields_.push_back(fields_per_savepoint_type());
-    return idx;
+  const InternedString name(savepoint.name());
+  const std::size_t hash = hashSavepoint(name, savepoint.metaInfo());
+  if(find(name, savepoint.metaInfo(), hash) != -1)
+    return -1;
+
+  const int idx = names_.size();
+  const MetainfoMapImpl::map_type& entries = savepoint.metaInfo().entries();
+  names_.push_back(name);
+  metaInfoArena_.insert(metaInfoArena_.end(), entries.begin(), entries.end());
+  metaInfoOffsets_.push_back(metaInfoArena_.size());
+  hashes_.push_back(hash);
+  fields_.push_back(field_entry_vector_type());
+
+  // Keep the load factor of the index below 1/2
+  if(2 * names_.size() > slots_.size()) {
+    slots_.assign(std::max<std::size_t>(16, 2 * slots_.size()), -1);
+    for(int i = 0; i <= idx; ++i)
+      insertSlot(i);
+  } else {
+    insertSlot(idx);
   }
-  return -1;
+
+  updateIndexes(idx);
+
+  std::lock_guard<std::mutex> lock(viewsMutex_);
+  if(!views_.empty())
+    views_.push_back(std::make_shared<SavepointImpl>(savepoint));
+  return idx;
+}
+
+void SavepointVector::insertSlot(int idx) noexcept {
+  const std::size_t mask = slots_.size() - 1;
+  std::size_t slot = slotOf(hashes_[idx], slots_.size());
+  while(slots_[slot] != -1)
+    slot = (slot + 1) & mask;
+  slots_[slot] = idx;
 }
 
 bool SavepointVector::addField(const SavepointImpl& savepoint, const FieldID& fieldID) noexcept {
@@ -37,7 +249,49 @@ bool SavepointVector::addField(const SavepointImpl& savepoint, const FieldID& fi
 }
 
 bool SavepointVector::addField(int idx, const FieldID& fieldID) noexcept {
-  return fields_[idx].insert({fieldID.name, fieldID.id}).second;
+  const unsigned int fieldIndex = registerField(fieldID.name);
+  field_entry_vector_type& fields = fields_[idx];
+
+  auto it = std::lower_bound(
+      fields.begin(), fields.end(), fieldIndex,
+      [](const FieldEntry& entry, unsigned int index) { return entry.index < index; });
+  if(it != fields.end() && it->index == fieldIndex)
+    return false;
+  fields.insert(it, FieldEntry{fieldIndex, fieldID.id});
+
+  // Fields are usually added to the most recent savepoint i.e this appends
+  std::vector<int>& savepoints = fieldSavepoints_[fieldIndex];
+  savepoints.insert(std::upper_bound(savepoints.begin(), savepoints.end(), idx), idx);
+  return true;
+}
+
+unsigned int SavepointVector::registerField(const InternedString& field) {
+  auto it = fieldIndices_.find(field);
+  if(it != fieldIndices_.end())
+    return it->second;
+
+  const unsigned int fieldIndex = fieldNames_.size();
+  fieldNames_.push_back(field);
+  fieldSavepoints_.emplace_back();
+  fieldIndices_.insert({field, fieldIndex});
+  return fieldIndex;
+}
+
+int SavepointVector::fieldIndex(const std::string& field) const noexcept {
+  auto it = fieldIndices_.find(InternedString::lookup(field));
+  return (it != fieldIndices_.end() ? int(it->second) : -1);
+}
+
+SavepointVector::field_entry_vector_type::const_iterator
+SavepointVector::findEntry(int idx, int fieldIndex) const noexcept {
+  const field_entry_vector_type& fields = fields_[idx];
+  if(fieldIndex < 0)
+    return fields.end();
+
+  auto it = std::lower_bound(
+      fields.begin(), fields.end(), unsigned(fieldIndex),
+      [](const FieldEntry& entry, unsigned int index) { return entry.index < index; });
+  return ((it != fields.end() && it->index == unsigned(fieldIndex)) ? it : fields.end());
 }
 
 bool SavepointVector::hasField(const SavepointImpl& savepoint, const std::string& field) noexcept {
@@ -48,14 +302,37 @@ bool SavepointVector::hasField(const SavepointImpl& savepoint, const std::string
 }
 
 bool SavepointVector::hasField(int idx, const std::string& field) noexcept {
-  return (fields_[idx].find(field) != fields_[idx].end());
+  return (findEntry(idx, fieldIndex(field)) != fields_[idx].end());
 }
 
 FieldID SavepointVector::getFieldID(int idx, const std::string& field) const {
-  auto it = fields_[idx].find(field);
+  auto it = findEntry(idx, fieldIndex(field));
   if(it != fields_[idx].end())
-    return FieldID{it->first, it->second};
-  throw Exception("field '%s' does not exists at savepoint '%s'", field, savepoints_[idx]->name());
+    return FieldID{fieldNames_[it->index], it->id};
+  throw Exception("field '%s' does not exists at savepoint '%s'", field, names_[idx]);
+}
+
+int SavepointVector::fieldIDOf(int idx, unsigned int fieldIndex) const noexcept {
+  auto it = findEntry(idx, int(fieldIndex));
+  return (it != fields_[idx].end() ? int(it->id) : -1);
+}
+
+int SavepointVector::findLatest(int idx, unsigned int fieldIndex) const noexcept {
+  if(fieldIndex >= fieldSavepoints_.size())
+    return -1;
+
+  const std::vector<int>& savepoints = fieldSavepoints_[fieldIndex];
+  auto it = std::upper_bound(savepoints.begin(), savepoints.end(), idx);
+  return (it != savepoints.begin() ? *std::prev(it) : -1);
+}
+
+FieldID SavepointVector::getLatestFieldID(int idx, const std::string& field) const {
+  const int fieldIdx = fieldIndex(field);
+  const int latestIdx = (fieldIdx != -1 ? findLatest(idx, fieldIdx) : -1);
+  if(latestIdx == -1)
+    throw Exception("field '%s' not found at or before savepoint '%s'", field,
+                    savepointAt(idx).toString());
+  return FieldID{fieldNames_[fieldIdx], unsigned(fieldIDOf(latestIdx, fieldIdx))};
 }
 
 FieldID SavepointVector::getFieldID(const SavepointImpl& savepoint,
@@ -67,9 +344,19 @@ FieldID SavepointVector::getFieldID(const SavepointImpl& savepoint,
 }
 
 void SavepointVector::swap(SavepointVector& other) noexcept {
-  index_.swap(other.index_);
-  savepoints_.swap(other.savepoints_);
+  names_.swap(other.names_);
+  metaInfoOffsets_.swap(other.metaInfoOffsets_);
+  metaInfoArena_.swap(other.metaInfoArena_);
+  hashes_.swap(other.hashes_);
+  slots_.swap(other.slots_);
   fields_.swap(other.fields_);
+  fieldNames_.swap(other.fieldNames_);
+  fieldSavepoints_.swap(other.fieldSavepoints_);
+  fieldIndices_.swap(other.fieldIndices_);
+  views_.swap(other.views_);
+  metaInfoIndexes_.swap(other.metaInfoIndexes_);
+  nameIndexes_.swap(other.nameIndexes_);
+  std::swap(hasNameIndexes_, other.hasNameIndexes_);
 }
 
 bool SavepointVector::exists(const SavepointImpl& savepoint) const noexcept {
@@ -77,27 +364,252 @@ bool SavepointVector::exists(const SavepointImpl& savepoint) const noexcept {
 }
 
 int SavepointVector::find(const SavepointImpl& savepoint) const noexcept {
-  auto it = index_.find(savepoint);
-  return ((it != index_.end()) ? it->second : -1);
+  const InternedString name = InternedString::lookup(savepoint.name());
+  if(!name.valid())
+    return -1;
+  return find(name, savepoint.metaInfo(), hashSavepoint(name, savepoint.metaInfo()));
+}
+
+int SavepointVector::find(const InternedString& name, const MetainfoMapImpl& metaInfo,
+                          std::size_t hash) const noexcept {
+  if(slots_.empty())
+    return -1;
+
+  const MetainfoMapImpl::map_type& entries = metaInfo.entries();
+  const std::size_t mask = slots_.size() - 1;
+  for(std::size_t slot = slotOf(hash, slots_.size()); slots_[slot] != -1;
+      slot = (slot + 1) & mask) {
+    const int idx = slots_[slot];
+    if(hashes_[idx] != hash || names_[idx] != name || metaInfoSizeOf(idx) != entries.size())
+      continue;
+
+    if(std::equal(entries.begin(), entries.end(), metaInfoArena_.begin() + metaInfoOffsets_[idx],
+                  [](const MetainfoMapImpl::Entry& left, const MetainfoMapImpl::Entry& right) {
+                    return left.key == right.key && left.value == right.value;
+                  }))
+      return idx;
+  }
+  return -1;
+}
+
+SavepointImpl SavepointVector::savepointAt(int idx) const {
+  auto first = metaInfoArena_.begin() + metaInfoOffsets_[idx];
+  auto last = metaInfoArena_.begin() + metaInfoOffsets_[idx + 1];
+  return SavepointImpl(names_[idx], MetainfoMapImpl(MetainfoMapImpl::map_type(first, last)));
+}
+
+SavepointVector::savepoint_vector_type& SavepointVector::views() const {
+  std::lock_guard<std::mutex> lock(viewsMutex_);
+  views_.reserve(size());
+  for(std::size_t idx = views_.size(); idx < size(); ++idx)
+    views_.push_back(std::make_shared<SavepointImpl>(savepointAt(idx)));
+  return views_;
 }
 
-const SavepointVector::fields_per_savepoint_type& SavepointVector::fieldsOf(int idx) const
-    noexcept {
-  return fields_[idx];
+SavepointVector::fields_per_savepoint_type SavepointVector::fieldsOf(int idx) const noexcept {
+  return FieldsView(this, idx);
 }
 
-const SavepointVector::fields_per_savepoint_type&
+SavepointVector::fields_per_savepoint_type
 SavepointVector::fieldsOf(const SavepointImpl& savepoint) const {
-  auto it = index_.find(savepoint);
-  if(it != index_.end())
-    return fieldsOf(it->second);
+  int idx = find(savepoint);
+  if(idx != -1)
+    return fieldsOf(idx);
   throw Exception("savepoint '%' does not exist", savepoint.toString());
 }
 
+void SavepointVector::reserve(std::size_t numSavepoints, std::size_t numMetaInfo) {
+  names_.reserve(numSavepoints);
+  metaInfoOffsets_.reserve(numSavepoints + 1);
+  metaInfoArena_.reserve(numMetaInfo);
+  hashes_.reserve(numSavepoints);
+  fields_.reserve(numSavepoints);
+
+  // Rehash once for the final load factor instead of doubling the index repeatedly
+  std::size_t numSlots = std::max<std::size_t>(16, slots_.size());
+  while(2 * numSavepoints > numSlots)
+    numSlots *= 2;
+  if(numSlots > slots_.size()) {
+    slots_.assign(numSlots, -1);
+    for(int i = 0; i < int(names_.size()); ++i)
+      insertSlot(i);
+  }
+}
+
 void SavepointVector::clear() noexcept {
-  savepoints_.clear();
-  index_.clear();
+  names_.clear();
+  metaInfoOffsets_.assign(1, 0);
+  metaInfoArena_.clear();
+  hashes_.clear();
+  slots_.clear();
   fields_.clear();
+  fieldNames_.clear();
+  fieldSavepoints_.clear();
+  fieldIndices_.clear();
+
+  {
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    metaInfoIndexes_.clear();
+    nameIndexes_.clear();
+    hasNameIndexes_ = false;
+  }
+
+  std::lock_guard<std::mutex> lock(viewsMutex_);
+  views_.clear();
+}
+
+const SavepointVector::MetaInfoIndex&
+SavepointVector::metaInfoIndex(InternTable::Handle key) const {
+  auto it = metaInfoIndexes_.find(key);
+  if(it != metaInfoIndexes_.end())
+    return it->second;
+
+  MetaInfoIndex& index = metaInfoIndexes_[key];
+  for(int idx = 0; idx < int(size()); ++idx)
+    for(std::uint32_t i = metaInfoOffsets_[idx]; i < metaInfoOffsets_[idx + 1]; ++i) {
+      const MetainfoMapImpl::Entry& entry = metaInfoArena_[i];
+      if(entry.key != key)
+        continue;
+      if(isNumeric(entry.value.type()))
+        index.numbers.emplace_back(toNumber(entry.value), idx);
+      else if(!TypeUtil::isArray(entry.value.type()))
+        index.others.push_back(idx);
+      break;
+    }
+  std::sort(index.numbers.begin(), index.numbers.end());
+  return index;
+}
+
+const std::vector<int>& SavepointVector::nameIndex(const InternedString& name) const {
+  if(!hasNameIndexes_) {
+    for(int idx = 0; idx < int(size()); ++idx)
+      nameIndexes_[names_[idx]].push_back(idx);
+    hasNameIndexes_ = true;
+  }
+
+  static const std::vector<int> none;
+  auto it = nameIndexes_.find(name);
+  return (it != nameIndexes_.end() ? it->second : none);
+}
+
+void SavepointVector::updateIndexes(int idx) {
+  std::lock_guard<std::mutex> lock(indexMutex_);
+  if(hasNameIndexes_)
+    nameIndexes_[names_[idx]].push_back(idx);
+
+  if(metaInfoIndexes_.empty())
+    return;
+
+  for(std::uint32_t i = metaInfoOffsets_[idx]; i < metaInfoOffsets_[idx + 1]; ++i) {
+    const MetainfoMapImpl::Entry& entry = metaInfoArena_[i];
+    auto it = metaInfoIndexes_.find(entry.key);
+    if(it == metaInfoIndexes_.end())
+      continue;
+
+    MetaInfoIndex& index = it->second;
+    if(isNumeric(entry.value.type())) {
+      // Usually appends as the values tend to grow with the savepoints (e.g time steps)
+      const NumberEntry number(toNumber(entry.value), idx);
+      index.numbers.insert(std::upper_bound(index.numbers.begin(), index.numbers.end(), number),
+                           number);
+    } else if(!TypeUtil::isArray(entry.value.type())) {
+      index.others.push_back(idx);
+    }
+  }
+}
+
+std::vector<int> SavepointVector::query(const SavepointQuery& query) const {
+  std::vector<int> result;
+  if(query.empty()) {
+    result.resize(size());
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+  }
+
+  std::lock_guard<std::mutex> lock(indexMutex_);
+  ResolvedQuery resolved;
+  if(!resolveQuery(query, resolved))
+    return result;
+
+  // Start from the candidates of the most selective index
+  std::size_t numCandidates = std::numeric_limits<std::size_t>::max();
+  auto isMoreSelective = [&](std::size_t n) {
+    if(n >= numCandidates)
+      return false;
+    numCandidates = n;
+    return true;
+  };
+
+  const std::vector<int>* candidates = nullptr; // Sorted by savepoint index
+  std::pair<std::vector<NumberEntry>::const_iterator, std::vector<NumberEntry>::const_iterator>
+      numbers;
+
+  if(resolved.name) {
+    const std::vector<int>& index = nameIndex(InternedString::lookup(query.name()));
+    if(isMoreSelective(index.size()))
+      candidates = &index;
+  }
+
+  for(const ResolvedPredicate& p : resolved.predicates) {
+    const MetaInfoIndex& index = metaInfoIndex(p.key);
+    if(p.numeric) {
+      auto range = numberRange(index.numbers, p);
+      if(isMoreSelective(std::distance(range.first, range.second))) {
+        numbers = range;
+        candidates = nullptr;
+      }
+    } else if(isMoreSelective(index.others.size())) {
+      candidates = &index.others;
+    }
+  }
+
+  std::vector<int> sortedNumbers;
+  if(!candidates) {
+    for(auto it = numbers.first; it != numbers.second; ++it)
+      sortedNumbers.push_back(it->second);
+    std::sort(sortedNumbers.begin(), sortedNumbers.end());
+    candidates = &sortedNumbers;
+  }
+
+  for(int idx : *candidates)
+    if(matchesQuery(resolved, names_[idx], metaInfoArena_.begin() + metaInfoOffsets_[idx],
+                    metaInfoArena_.begin() + metaInfoOffsets_[idx + 1]))
+      result.push_back(idx);
+  return result;
+}
+
+int SavepointVector::nearest(const SavepointQuery& query, const std::string& key,
+                             double value) const {
+  std::lock_guard<std::mutex> lock(indexMutex_);
+  ResolvedQuery resolved;
+  const InternTable::Handle handle = InternTable::global().find(key);
+  if(!handle || !resolveQuery(query, resolved))
+    return -1;
+
+  // Walk outwards from `value` until a savepoint matches the remaining predicates
+  const std::vector<NumberEntry>& numbers = metaInfoIndex(handle).numbers;
+  auto upper = std::lower_bound(
+      numbers.begin(), numbers.end(), value,
+      [](const NumberEntry& entry, double v) { return entry.first < v; });
+  auto lower = upper;
+
+  while(lower != numbers.begin() || upper != numbers.end()) {
+    const bool takeLower =
+        upper == numbers.end() ||
+        (lower != numbers.begin() && value - std::prev(lower)->first <= upper->first - value);
+    const int idx = takeLower ? (--lower)->second : (upper++)->second;
+
+    if(matchesQuery(resolved, names_[idx], metaInfoArena_.begin() + metaInfoOffsets_[idx],
+                    metaInfoArena_.begin() + metaInfoOffsets_[idx + 1]))
+      return idx;
+  }
+  return -1;
+}
+
+SavepointVector::FieldsView::const_iterator
+SavepointVector::FieldsView::find(const std::string& name) const noexcept {
+  return const_iterator(savepointVector_->findEntry(idx_, savepointVector_->fieldIndex(name)),
+                        &savepointVector_->fieldNames_);
 }
 
 std::ostream& operator<<(std::ostream& stream, const SavepointVector& s) {
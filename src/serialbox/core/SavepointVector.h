@@ -18,8 +18,15 @@
 
 #include "serialbox/core/FieldID.h"
 #include "serialbox/core/SavepointImpl.h"
+#include "serialbox/core/SavepointQuery.h"
+#include <cstddef>
+#include <cstdint>
 #include <iosfwd>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace serialbox {
@@ -30,40 +37,128 @@ namespace serialbox {
 /// \brief The SavepointVector manages the registered savepoints and their mapping to the stored
 /// fields
 ///
-/// The savepoints are ordered in the sequence they were registred.
+/// The savepoints are ordered in the sequence they were registred. Each field is given a dense
+/// index (in the order the fields were registered) and the fields of a savepoint are stored as an
+/// array of `(field index, id)` pairs sorted by the field index. Conversely, the savepoints at
+/// which a field is stored are kept as a sorted array per field (see SavepointVector::findLatest).
+///
+/// The savepoints are stored column-wise: the interned names, the offsets of the meta-information
+/// into an arena shared by all savepoints and the hashes (used by an open-addressing index).
+/// SavepointImpl objects are only materialized on demand (see SavepointVector::savepoints), they
+/// are copies and modifying them does not alter the SavepointVector.
+///
+/// Queries (see SavepointVector::query) are answered by secondary indexes of the names and of the
+/// meta-information keys which are built on first use.
 class SavepointVector {
-  using index_type = std::unordered_map<SavepointImpl, int>;
-
 public:
-  /// \brief Vector of savepoints
-  using savepoint_vector_type = std::vector<std::shared_ptr<SavepointImpl>>;
+  /// \brief Vector of (read-only) savepoints
+  using savepoint_vector_type = std::vector<std::shared_ptr<const SavepointImpl>>;
 
-  /// \brief Map of fields per savepoint
-  using fields_per_savepoint_type = std::unordered_map<std::string, unsigned int>;
+  /// \brief Field stored at a savepoint
+  struct FieldEntry {
+    unsigned int index; ///< Dense index of the field
+    unsigned int id;    ///< ID within the field
+  };
 
-  /// \brief Vector of map of fields per savepoint
-  using fields_per_savepoint_vector_type = std::vector<fields_per_savepoint_type>;
+  /// \brief Sorted array of the fields stored at a savepoint
+  using field_entry_vector_type = std::vector<FieldEntry>;
 
-  /// \brief A random access iterator to `std::shared_ptr<Savepoint>`
-  using iterator = savepoint_vector_type::iterator;
-
-  /// \brief A random access iterator to `const std::shared_ptr<Savepoint>`
+  /// \brief View of the fields of a savepoint
+  ///
+  /// Iterating the view yields pairs of the name and the id of the fields.
+  class FieldsView {
+  public:
+    /// \brief Forward iterator over the fields
+    class const_iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::pair<InternedString, unsigned int>;
+      using difference_type = std::ptrdiff_t;
+      using reference = value_type;
+
+      /// \brief Proxy returned by const_iterator::operator->
+      struct pointer {
+        value_type value;
+        const value_type* operator->() const noexcept { return &value; }
+      };
+
+      const_iterator(field_entry_vector_type::const_iterator it,
+                     const std::vector<InternedString>* names)
+          : it_(it), names_(names) {}
+
+      reference operator*() const noexcept { return value_type((*names_)[it_->index], it_->id); }
+      pointer operator->() const noexcept { return pointer{**this}; }
+
+      const_iterator& operator++() noexcept {
+        ++it_;
+        return *this;
+      }
+
+      const_iterator operator++(int) noexcept {
+        const_iterator tmp(*this);
+        ++it_;
+        return tmp;
+      }
+
+      bool operator==(const const_iterator& other) const noexcept { return it_ == other.it_; }
+      bool operator!=(const const_iterator& other) const noexcept { return it_ != other.it_; }
+
+    private:
+      field_entry_vector_type::const_iterator it_;
+      const std::vector<InternedString>* names_;
+    };
+
+    using iterator = const_iterator;
+
+    FieldsView(const SavepointVector* savepointVector, int idx) noexcept
+        : savepointVector_(savepointVector), idx_(idx) {}
+
+    /// \brief Number of fields
+    std::size_t size() const noexcept { return entries().size(); }
+
+    /// \brief Check if there are no fields
+    bool empty() const noexcept { return entries().empty(); }
+
+    /// \brief Find field `name` or return FieldsView::end
+    const_iterator find(const std::string& name) const noexcept;
+
+    /// \brief Iterators (in the order of the field indices)
+    const_iterator begin() const noexcept {
+      return const_iterator(entries().begin(), &savepointVector_->fieldNames_);
+    }
+    const_iterator end() const noexcept {
+      return const_iterator(entries().end(), &savepointVector_->fieldNames_);
+    }
+
+  private:
+    const field_entry_vector_type& entries() const noexcept {
+      return savepointVector_->fields_[idx_];
+    }
+
+    const SavepointVector* savepointVector_;
+    int idx_;
+  };
+
+  /// \brief Fields per savepoint
+  using fields_per_savepoint_type = FieldsView;
+
+  /// \brief A random access iterator to `const std::shared_ptr<const Savepoint>`
   using const_iterator = savepoint_vector_type::const_iterator;
 
   /// \brief Default constructor (empty)
-  SavepointVector() : index_(), savepoints_(), fields_(){};
+  SavepointVector() : metaInfoOffsets_(1, 0){};
 
   /// \brief Copy constructor
-  SavepointVector(const SavepointVector&) = default;
+  SavepointVector(const SavepointVector& other);
 
   /// \brief Move constructor
-  SavepointVector(SavepointVector&&) = default;
+  SavepointVector(SavepointVector&& other) noexcept : SavepointVector() { swap(other); }
 
   /// \brief Copy assignment
-  SavepointVector& operator=(const SavepointVector&) = default;
+  SavepointVector& operator=(const SavepointVector& other);
 
   /// \brief Move assignment
-  SavepointVector& operator=(SavepointVector&&) = default;
+  SavepointVector& operator=(SavepointVector&& other) noexcept;
 
   /// \brief Check if savepoint exists
   ///
@@ -80,6 +175,21 @@ public:
   /// \return Index of the newly inserted savepoint or -1 if savepoint already exists
   int insert(const SavepointImpl& savepoint) noexcept;
 
+  /// \brief Register the field `field` i.e give it a dense index
+  ///
+  /// Fields are registered implicitly when they are added to a savepoint for the first time.
+  ///
+  /// \return Index of the field
+  unsigned int registerField(const InternedString& field);
+
+  /// \brief Get the dense index of field `field`
+  ///
+  /// \return Index of the field or -1 if the field has not been registered
+  int fieldIndex(const std::string& field) const noexcept;
+
+  /// \brief Names of the registered fields (indexed by the dense field index)
+  const std::vector<InternedString>& fieldNames() const noexcept { return fieldNames_; }
+
   /// \brief Add a field to the savepoint
   ///
   /// \return True iff the field was successfully addeed to the savepoint
@@ -110,19 +220,73 @@ public:
   /// \throw Exception  Savepoint or field at savepoint do not exist
   FieldID getFieldID(int idx, const std::string& field) const;
 
+  /// \brief Get the ID of the field with dense index `fieldIndex` given a valid savepoint index
+  /// `idx`
+  ///
+  /// \return ID of the field or -1 if the field does not exist at the savepoint
+  int fieldIDOf(int idx, unsigned int fieldIndex) const noexcept;
+
+  /// \brief Find the most recent savepoint at or before savepoint `idx` at which the field with
+  /// dense index `fieldIndex` is stored
+  ///
+  /// \return Index of the savepoint or -1 if the field is not stored at or before savepoint `idx`
+  int findLatest(int idx, unsigned int fieldIndex) const noexcept;
+
+  /// \brief Get the FieldID of field `field` at savepoint `idx` or, if the field is not stored at
+  /// savepoint `idx`, at the most recent savepoint before
+  ///
+  /// \throw Exception  Field is not stored at or before savepoint `idx`
+  FieldID getLatestFieldID(int idx, const std::string& field) const;
+
   /// \brief Access fields of savepoint
   ///
   /// \throw Exception  Savepoint does not exists
-  const fields_per_savepoint_type& fieldsOf(const SavepointImpl& savepoint) const;
+  fields_per_savepoint_type fieldsOf(const SavepointImpl& savepoint) const;
 
   /// \brief Access fields of savepoint given a valid savepoint index `idx`
-  const fields_per_savepoint_type& fieldsOf(int idx) const noexcept;
+  fields_per_savepoint_type fieldsOf(int idx) const noexcept;
+
+  /// \brief Name of the savepoint given a valid savepoint index `idx`
+  const InternedString& nameOf(int idx) const noexcept { return names_[idx]; }
+
+  /// \brief Number of meta-information elements of the savepoint given a valid index `idx`
+  std::size_t metaInfoSizeOf(int idx) const noexcept {
+    return metaInfoOffsets_[idx + 1] - metaInfoOffsets_[idx];
+  }
+
+  /// \brief Materialize the savepoint given a valid savepoint index `idx` (the copy is not cached)
+  SavepointImpl savepointAt(int idx) const;
+
+  /// \brief Query the savepoints
+  ///
+  /// The query is evaluated by the most selective of its predicates using the secondary indexes
+  /// (one per meta-information key sorted by the numeric values and one of the names), the
+  /// remaining predicates are checked for the resulting candidates only. The indexes are built on
+  /// the first query of the key (or name) and kept up to date afterwards.
+  ///
+  /// Queries may run concurrently with each other, but not with modifications of the vector (the
+  /// Serializer guards both by its meta-data mutex, see SerializerImpl::querySavepoints).
+  ///
+  /// \return Indices of the matching savepoints (in the order they were registered)
+  std::vector<int> query(const SavepointQuery& query) const;
+
+  /// \brief Find the savepoint which matches `query` and whose (numeric) value of `key` is closest
+  /// to `value`
+  ///
+  /// Ties are resolved in favor of the smaller value of `key`.
+  ///
+  /// \return Index of the savepoint or -1 if no savepoint matches
+  int nearest(const SavepointQuery& query, const std::string& key, double value) const;
 
   /// \brief Returns a bool value indicating whether the savepoint vector is empty
-  bool empty() const noexcept { return index_.empty(); }
+  bool empty() const noexcept { return names_.empty(); }
 
   /// \brief Returns the number of savepoints in the vector
-  std::size_t size() const noexcept { return savepoints_.size(); }
+  std::size_t size() const noexcept { return names_.size(); }
+
+  /// \brief Reserve storage (and slots of the index) for `numSavepoints` savepoints with a total
+  /// of `numMetaInfo` meta-information elements
+  void reserve(std::size_t numSavepoints, std::size_t numMetaInfo = 0);
 
   /// \brief All the elements Savepoints are dropped: their destructors are called, and they
   /// are removed from the container, leaving it with a size of 0
@@ -132,37 +296,73 @@ public:
   void swap(SavepointVector& other) noexcept;
 
   /// \brief Returns an iterator pointing to the first savepoint in the vector
-  iterator begin() noexcept { return savepoints_.begin(); }
-  const_iterator begin() const noexcept { return savepoints_.begin(); }
+  const_iterator begin() const { return views().begin(); }
 
   /// \brief Returns an iterator pointing to the past-the-end savepoint in the vector
-  iterator end() noexcept { return savepoints_.end(); }
-  const_iterator end() const noexcept { return savepoints_.end(); }
+  const_iterator end() const { return views().end(); }
 
   /// \brief Get savepoint
-  SavepointImpl& operator[](int idx) noexcept { return *savepoints_[idx]; }
-  const SavepointImpl& operator[](int idx) const noexcept { return *savepoints_[idx]; }
+  const SavepointImpl& operator[](int idx) const { return *views()[idx]; }
 
-  /// \brief Returns a reference to the last element in the savepoint vector
-  std::shared_ptr<SavepointImpl>& back() noexcept { return savepoints_.back(); }
-  const std::shared_ptr<SavepointImpl>& back() const noexcept { return savepoints_.back(); }
+  /// \brief Returns a copy of the last savepoint in the vector (only this one is materialized)
+  SavepointImpl back() const { return savepointAt(size() - 1); }
 
   /// \brief Access the savepoints
-  const savepoint_vector_type& savepoints() const noexcept { return savepoints_; }
-  savepoint_vector_type& savepoints() noexcept { return savepoints_; }
-
-  /// \brief Access the fields
-  const fields_per_savepoint_vector_type& fields() const noexcept { return fields_; }
-
-  void insertField(std::size_t index, fields_per_savepoint_type const& f) { fields_[index] = f; };
+  ///
+  /// The savepoints are materialized on the first call and kept up to date afterwards. They are
+  /// read-only views; modifications have to go through the savepoint vector (e.g `insert`).
+  const savepoint_vector_type& savepoints() const { return views(); }
 
   /// \brief Convert to stream
   friend std::ostream& operator<<(std::ostream& stream, const SavepointVector& s);
 
 private:
-  index_type index_;                        ///< Hash-map for fast lookup
-  savepoint_vector_type savepoints_;        ///< Vector of stored savepoints
-  fields_per_savepoint_vector_type fields_; ///< Fields of each savepoint
+  /// \brief Secondary index of a meta-information key
+  struct MetaInfoIndex {
+    std::vector<std::pair<double, int>> numbers; ///< Numeric values and savepoints (sorted)
+    std::vector<int> others;                     ///< Savepoints with non-numeric values
+  };
+
+  /// \brief Get the index of `key` (built on first use, requires `indexMutex_`)
+  const MetaInfoIndex& metaInfoIndex(InternTable::Handle key) const;
+
+  /// \brief Get the savepoints with name `name` (built on first use, requires `indexMutex_`)
+  const std::vector<int>& nameIndex(const InternedString& name) const;
+
+  /// \brief Add the newly inserted savepoint `idx` to the indexes which have been built
+  void updateIndexes(int idx);
+
+  /// \brief Find the entry of the field with index `fieldIndex` at savepoint `idx`
+  field_entry_vector_type::const_iterator findEntry(int idx, int fieldIndex) const noexcept;
+
+  /// \brief Find the savepoint with `name`, `metaInfo` and `hash`
+  int find(const InternedString& name, const MetainfoMapImpl& metaInfo,
+           std::size_t hash) const noexcept;
+
+  /// \brief Insert savepoint `idx` in the slots of the index
+  void insertSlot(int idx) noexcept;
+
+  /// \brief Materialize all savepoints
+  savepoint_vector_type& views() const;
+
+  std::vector<InternedString> names_;          ///< Name of each savepoint
+  std::vector<std::uint32_t> metaInfoOffsets_; ///< Offsets of the meta-information into the arena
+  MetainfoMapImpl::map_type metaInfoArena_;    ///< Meta-information of all savepoints
+  std::vector<std::size_t> hashes_;            ///< Hash of each savepoint
+  std::vector<int> slots_;                     ///< Open-addressing index (-1 denotes empty slots)
+
+  std::vector<field_entry_vector_type> fields_;                   ///< Fields of each savepoint
+  std::vector<InternedString> fieldNames_;                        ///< Name of each field index
+  std::vector<std::vector<int>> fieldSavepoints_;                 ///< Savepoints of each field
+  std::unordered_map<InternedString, unsigned int> fieldIndices_; ///< Index of each field
+
+  mutable savepoint_vector_type views_; ///< Materialized savepoints (either empty or complete)
+  mutable std::mutex viewsMutex_;
+
+  mutable std::unordered_map<InternTable::Handle, MetaInfoIndex> metaInfoIndexes_;
+  mutable std::unordered_map<InternedString, std::vector<int>> nameIndexes_;
+  mutable bool hasNameIndexes_ = false;
+  mutable std::mutex indexMutex_;
 };
 
 /// @}
@@ -13,20 +13,19 @@
 namespace serialbox {
 
 void to_json(json::json& jsonNode, SavepointVector const& v) {
-  assert(v.size() == v.fields().size());
-
   for(std::size_t i = 0; i < v.size(); ++i)
-    jsonNode["savepoints"].push_back(*(v.savepoints()[i]));
+    jsonNode["savepoints"].push_back(v.savepointAt(i));
 
-  for(std::size_t i = 0; i < v.fields().size(); ++i) {
-    const std::string& savepoint = v.savepoints()[i]->name();
+  for(std::size_t i = 0; i < v.size(); ++i) {
+    const std::string& savepoint = v.nameOf(i);
+    const auto fields = v.fieldsOf(i);
     json::json fieldNode;
 
-    if(v.fields()[i].empty())
+    if(fields.empty())
       fieldNode[savepoint] = nullptr;
 
-    for(auto it = v.fields()[i].begin(), end = v.fields()[i].end(); it != end; ++it)
-      fieldNode[savepoint][it->first] = it->second;
+    for(auto it = fields.begin(), end = fields.end(); it != end; ++it)
+      fieldNode[savepoint][it->first.str()] = it->second;
 
     jsonNode["fields_per_savepoint"].push_back(fieldNode);
   }
@@ -49,22 +48,86 @@ void from_json(json::json const& jsonNode, SavepointVector& v) {
 
   // Eeach savepoint needs an entry in the fields array (it can be null though)
   if(jsonNode.count("fields_per_savepoint") &&
-     jsonNode["fields_per_savepoint"].size() != v.fields().size())
+     jsonNode["fields_per_savepoint"].size() != v.size())
     throw Exception("inconsistent number of 'fields_per_savepoint' and 'savepoints'");
 
-  for(std::size_t i = 0; i < v.fields().size(); ++i) {
-    const json::json& fieldNode = jsonNode["fields_per_savepoint"][i][v.savepoints()[i]->name()];
+  for(std::size_t i = 0; i < v.size(); ++i) {
+    const json::json& fieldNode = jsonNode["fields_per_savepoint"][i][v.nameOf(i).str()];
 
     // Savepoint has no fields
     if(fieldNode.is_null() || fieldNode.empty())
-      break;
+      continue;
 
-    SavepointVector::fields_per_savepoint_type fields;
     // Add fields
     for(auto it = fieldNode.begin(), end = fieldNode.end(); it != end; ++it)
-      fields.insert({it.key(), static_cast<unsigned int>(it.value())});
-    v.insertField(i, fields);
+      v.addField(i, FieldID{it.key(), static_cast<unsigned int>(it.value())});
+  }
+}
+
+void from_json(JsonReader& reader, SavepointVector& v) {
+  v.clear();
+
+  if(reader.readNull())
+    return;
+
+  // The elements of "fields_per_savepoint" precede the savepoints in the written files. The fields
+  // are therefore collected first (each member of an element names a savepoint and refers to the
+  // range [first, last) of `fields`) and added once all savepoints are inserted.
+  struct FieldsOfSavepoint {
+    std::string savepoint;
+    std::size_t first, last;
+  };
+  std::vector<FieldsOfSavepoint> members;
+  std::vector<std::size_t> elements;
+  std::vector<FieldID> fields;
+  bool hasFields = false;
+
+  reader.beginObject();
+  std::string key, name, field;
+  while(reader.nextKey(key)) {
+    if(key == "savepoints") {
+      SavepointImpl savepoint;
+      reader.beginArray();
+      while(reader.nextElement()) {
+        from_json(reader, savepoint);
+        v.insert(savepoint);
+      }
+    } else if(key == "fields_per_savepoint") {
+      hasFields = true;
+      reader.beginArray();
+      while(reader.nextElement()) {
+        elements.push_back(members.size());
+        reader.beginObject();
+        while(reader.nextKey(name)) {
+          members.push_back(FieldsOfSavepoint{name, fields.size(), fields.size()});
+
+          // Savepoint has no fields
+          if(reader.readNull())
+            continue;
+
+          reader.beginObject();
+          while(reader.nextKey(field))
+            fields.push_back(FieldID{field, static_cast<unsigned int>(reader.readUnsigned())});
+          members.back().last = fields.size();
+        }
+      }
+    } else {
+      reader.skipValue();
+    }
   }
+
+  // Eeach savepoint needs an entry in the fields array (it can be null though)
+  if(hasFields && elements.size() != v.size())
+    throw Exception("inconsistent number of 'fields_per_savepoint' and 'savepoints'");
+
+  elements.push_back(members.size());
+  for(std::size_t i = 0; i < v.size() && hasFields; ++i)
+    for(std::size_t m = elements[i]; m < elements[i + 1]; ++m) {
+      if(members[m].savepoint != v.nameOf(i).str())
+        continue;
+      for(std::size_t f = members[m].first; f < members[m].last; ++f)
+        v.addField(i, fields[f]);
+    }
 }
 
 } // namespace serialbox
@@ -16,6 +16,7 @@
 #define SERIALBOX_CORE_SAVEPOINTVECTORSERIALIZER_H
 
 #include "serialbox/core/Json.h"
+#include "serialbox/core/JsonReader.h"
 #include "serialbox/core/SavepointVector.h"
 
 namespace serialbox {
@@ -25,6 +26,8 @@ namespace serialbox {
 void to_json(json::json& jsonNode, SavepointVector const& v);
 
 void from_json(json::json const& jsonNode, SavepointVector& v);
+
+void from_json(JsonReader& reader, SavepointVector& v);
 /// @}
 
 } // namespace serialbox
@@ -25,15 +25,16 @@
 #include "serialbox/core/archive/ArchiveFactory.h"
 #include "serialbox/core/archive/BinaryArchive.h"
 #include "serialbox/core/hash/HashFactory.h"
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <limits>
 #include <memory>
 #include <type_traits>
-
-#ifdef SERIALBOX_ASYNC_API
-#include <future>
-#include <thread>
-#endif
+#include <unistd.h>
 
 namespace serialbox {
 
@@ -96,13 +97,37 @@ SerializerImpl::SerializerImpl(OpenModeKind mode, const std::string& directory,
   // If mode is writing drop all files
   if(mode_ == OpenModeKind::Write)
     clear();
+
+  // Repeated replays (e.g nightly verification runs) can record or follow the access trace
+  // without modifying the application
+  const char* accessTrace = std::getenv("SERIALBOX_ACCESS_TRACE");
+  if(mode_ == OpenModeKind::Read && accessTrace) {
+    if(std::strcmp(accessTrace, "record") == 0)
+      setAccessTraceRecording(true);
+    else if(std::strcmp(accessTrace, "replay") == 0 && filesystem::exists(accessTraceFile())) {
+      const char* budget = std::getenv("SERIALBOX_ACCESS_TRACE_BUDGET");
+      replayAccessTrace((budget ? std::strtoull(budget, nullptr, 10) : 256) << 20);
+    }
+  }
 }
 
 void SerializerImpl::clear() noexcept {
-  savepointVector_->clear();
+  asyncReadQueue_->wait();
+  prefetchQueue_->wait();
+  {
+    std::lock_guard<std::mutex> lock(*metaDataMutex_);
+    handleSavepointIdx_ = -1;
+    handleSavepoint_.reset();
+    ++generation_;
+    savepointVector_->clear();
+  }
+
+  // The snapshot of the meta-data would be stale anyway
+  std::remove(metaDataSnapshotFile().string().c_str());
   fieldMap_->clear();
   globalMetainfo_->clear();
   archive_->clear();
+  fieldCache_->flush();
 }
 
 std::vector<std::string> SerializerImpl::fieldnames() const {
@@ -113,6 +138,40 @@ std::vector<std::string> SerializerImpl::fieldnames() const {
   return fields;
 }
 
+FieldHandle SerializerImpl::lookupField(const std::string& name) {
+  auto fieldIt = fieldMap_->findField(name);
+  if(fieldIt == fieldMap_->end())
+    throw Exception("field '%s' is not registerd within the Serializer", name);
+
+  InternedString fieldName(name);
+  std::lock_guard<std::mutex> lock(*metaDataMutex_);
+  return FieldHandle(fieldName, savepointVector_->registerField(fieldName), fieldIt->second,
+                     generation_);
+}
+
+SavepointHandle SerializerImpl::findOrRegisterSavepoint(const SavepointImpl& savepoint) {
+  std::lock_guard<std::mutex> lock(*metaDataMutex_);
+  int savepointIdx = savepointVector_->find(savepoint);
+  if(savepointIdx == -1)
+    savepointIdx = savepointVector_->insert(savepoint);
+  return SavepointHandle(savepointIdx, generation_);
+}
+
+void SerializerImpl::checkHandles(const FieldHandle& field,
+                                  const SavepointHandle& savepoint) const {
+  if(!field.valid() || field.generation() != generation_)
+    throw Exception("invalid field handle%s",
+                    field.valid() ? " (obtained before the Serializer was cleared)" : "");
+
+  if(!savepoint.valid() || savepoint.index() >= int(savepointVector_->size()))
+    throw Exception("invalid savepoint handle: %i", savepoint.index());
+
+  if(savepoint.generation() != SavepointHandle::AnyGeneration &&
+     savepoint.generation() != generation_)
+    throw Exception("invalid savepoint handle: %i (obtained before the Serializer was cleared)",
+                    savepoint.index());
+}
+
 static inline bool dimsEqual(const std::vector<int>& dims1, const std::vector<int>& dims2) {
   if(dims1.size() != dims2.size())
     return false;
@@ -133,8 +192,12 @@ SerializerImpl::checkStorageView(const std::string& name, const StorageView& sto
   if(fieldIt == fieldMap_->end())
     throw Exception("field '%s' is not registerd within the Serializer", name);
 
-  const FieldMetainfoImpl& fieldInfo = *fieldIt->second;
+  checkStorageView(name, *fieldIt->second, storageView);
+  return fieldIt->second;
+}
 
+void SerializerImpl::checkStorageView(const std::string& name, const FieldMetainfoImpl& fieldInfo,
+                                      const StorageView& storageView) {
   // Check if types match
   if(fieldInfo.type() != storageView.type())
     throw Exception("field '%s' has type '%s' but was registrered as type '%s'", name,
@@ -148,7 +211,6 @@ SerializerImpl::checkStorageView(const std::string& name, const StorageView& sto
                     name, ArrayUtil::toString(fieldInfo.dims()),
                     ArrayUtil::toString(storageView.dims()));
   }
-  return fieldIt->second;
 }
 
 //===------------------------------------------------------------------------------------------===//
@@ -173,29 +235,87 @@ void SerializerImpl::write(const std::string& name, const SavepointImpl& savepoi
   //
   // 2) Locate savepoint and register it if necessary
   //
-  int savepointIdx = savepointVector_->find(savepoint);
+  int savepointIdx = -1;
+  {
+    std::lock_guard<std::mutex> lock(*metaDataMutex_);
+    savepointIdx = savepointVector_->find(savepoint);
+
+    if(savepointIdx == -1) {
+      LOG(info) << "Registering new savepoint \"" << savepoint << "\"";
+      savepointIdx = savepointVector_->insert(savepoint);
+    }
 
-  if(savepointIdx == -1) {
-    LOG(info) << "Registering new savepoint \"" << savepoint << "\"";
-    savepointIdx = savepointVector_->insert(savepoint);
+    //
+    // 3) Check if field can be added to Savepoint
+    //
+    if(savepointVector_->hasField(savepointIdx, name))
+      throw Exception("field '%s' already saved at savepoint '%s'", name,
+                      (*savepointVector_)[savepointIdx].toString());
   }
 
-  //
-  // 3) Check if field can be added to Savepoint
-  //
-  if(savepointVector_->hasField(savepointIdx, name))
-    throw Exception("field '%s' already saved at savepoint '%s'", name,
-                    (*savepointVector_)[savepointIdx].toString());
+  writeField(name, info, savepointIdx, savepoint, storageView);
+}
+
+void SerializerImpl::write(const FieldHandle& field, const SavepointHandle& savepoint,
+                           const StorageView& storageView) {
+  if(SerializerImpl::serializationStatus() < 0)
+    return;
+
+  LOG(info) << "Serializing field \"" << field.name() << "\" at savepoint " << savepoint.index()
+            << " ... ";
+
+  if(mode_ == OpenModeKind::Read)
+    throw Exception("serializer not open in write mode, but write operation requested");
+
+  if(!field.valid())
+    throw Exception("invalid field handle");
+  checkStorageView(field.name(), *field.info(), storageView);
+
+  const int savepointIdx = savepoint.index();
+  std::shared_ptr<const SavepointImpl> savepointImpl;
+  {
+    std::lock_guard<std::mutex> lock(*metaDataMutex_);
+    checkHandles(field, savepoint);
+
+    if(savepointVector_->fieldIDOf(savepointIdx, field.index()) != -1)
+      throw Exception("field '%s' already saved at savepoint '%s'", field.name().str(),
+                      savepointVector_->savepointAt(savepointIdx).toString());
+
+    // Consecutive writes usually refer to the same savepoint
+    if(handleSavepointIdx_ != savepointIdx) {
+      handleSavepoint_ =
+          std::make_shared<SavepointImpl>(savepointVector_->savepointAt(savepointIdx));
+      handleSavepointIdx_ = savepointIdx;
+    }
+    savepointImpl = handleSavepoint_;
+  }
+
+  writeField(field.name(), field.info(), savepointIdx, *savepointImpl, storageView);
+}
 
+void SerializerImpl::writeField(const std::string& name,
+                                const std::shared_ptr<FieldMetainfoImpl>& info, int savepointIdx,
+                                const SavepointImpl& savepoint, const StorageView& storageView) {
   //
   // 4) Pass the StorageView to the backend Archive and perform actual data-serialization.
   //
-  FieldID fieldID = archive_->write(storageView, name, info);
+  FieldID fieldID;
+  if(archive_->isWritingThreadSafe())
+    fieldID = archive_->write(storageView, name, info, savepoint);
+  else {
+    std::lock_guard<std::mutex> lock(*archiveMutex_);
+    fieldID = archive_->write(storageView, name, info, savepoint);
+  }
 
   //
-  // 5) Register FieldID within Savepoint.
+  // 5) Register FieldID within Savepoint (another thread may have raced us to it)
   //
-  savepointVector_->addField(savepointIdx, fieldID);
+  {
+    std::lock_guard<std::mutex> lock(*metaDataMutex_);
+    if(!savepointVector_->addField(savepointIdx, fieldID))
+      throw Exception("field '%s' already saved at savepoint '%s'", name,
+                      (*savepointVector_)[savepointIdx].toString());
+  }
 
   //
   // 6) Update meta-data on disk
@@ -224,32 +344,89 @@ void SerializerImpl::read(const std::string& name, const SavepointImpl& savepoin
   //
   // 2) Check if savepoint exists and obtain fieldID
   //
-  int savepointIdx = savepointVector_->find(savepoint);
+  int requestedSavepointIdx;
+  FieldID fieldID = findFieldID(name, savepoint, alsoPrevious, requestedSavepointIdx);
 
-  if(savepointIdx == -1)
-    throw Exception("savepoint '%s' does not exist", savepoint.toString());
+  readField(fieldID, requestedSavepointIdx, info, storageView);
+}
+
+void SerializerImpl::read(const FieldHandle& field, const SavepointHandle& savepoint,
+                          StorageView& storageView, bool alsoPrevious) {
+  if(SerializerImpl::serializationStatus() < 0)
+    return;
+
+  LOG(info) << "Deserializing field \"" << field.name() << "\" at savepoint " << savepoint.index()
+            << " ... ";
+
+  if(!field.valid())
+    throw Exception("invalid field handle");
+  checkStorageView(field.name(), *field.info(), storageView);
 
   FieldID fieldID;
-  while(savepointIdx >= 0) {
-    if(savepointVector_->hasField(savepointIdx, name) || !alsoPrevious) {
-      fieldID = savepointVector_->getFieldID(savepointIdx, name);
-      break;
-    } else {
-      // If alsoPrevious is speicifed AND the field was not found,
-      // keep searching backwards
-      --savepointIdx;
-    }
+  {
+    std::lock_guard<std::mutex> lock(*metaDataMutex_);
+    checkHandles(field, savepoint);
+    fieldID = findFieldID(field, savepoint.index(), alsoPrevious);
   }
+  readField(fieldID, savepoint.index(), field.info(), storageView);
+}
 
-  if(savepointIdx == -1)
-    throw Exception("field '%s' not found at or before savepoint '%s'", name, savepoint.toString());
-
+void SerializerImpl::readField(const FieldID& fieldID, int requestedSavepointIdx,
+                               const std::shared_ptr<FieldMetainfoImpl>& info,
+                               StorageView& storageView) {
   //
-  // 3) Pass the StorageView to the backend Archive and perform actual data-deserialization.
+  // 3) Pass the StorageView to the backend Archive and perform actual data-deserialization (unless
+  //    the field is cached).
   //
+  if(fieldCache_->lookup(fieldID, storageView)) {
+    traceRead(fieldID, requestedSavepointIdx, storageView);
+    prefetchAfter(requestedSavepointIdx);
+    LOG(info) << "Successfully deserialized field \"" << fieldID.name << "\" (cached)";
+    return;
+  }
+
   archive_->read(storageView, fieldID, info);
+  fieldCache_->insert(fieldID, storageView);
 
-  LOG(info) << "Successfully deserialized field \"" << name << "\"";
+  //
+  // 4) Record the read and prefetch the following savepoints or reads of the access trace (if
+  //    enabled)
+  //
+  traceRead(fieldID, requestedSavepointIdx, storageView);
+  prefetchAfter(requestedSavepointIdx);
+
+  LOG(info) << "Successfully deserialized field \"" << fieldID.name << "\"";
+}
+
+FieldID SerializerImpl::findFieldID(const std::string& name, const SavepointImpl& savepoint,
+                                    bool alsoPrevious, int& requestedSavepointIdx) const {
+  int savepointIdx = savepointVector_->find(savepoint);
+
+  if(savepointIdx == -1)
+    throw Exception("savepoint '%s' does not exist", savepoint.toString());
+  requestedSavepointIdx = savepointIdx;
+
+  // If alsoPrevious is specified, fall back to the most recent savepoint storing the field
+  if(alsoPrevious)
+    return savepointVector_->getLatestFieldID(savepointIdx, name);
+  return savepointVector_->getFieldID(savepointIdx, name);
+}
+
+FieldID SerializerImpl::findFieldID(const FieldHandle& field, int savepointIdx,
+                                    bool alsoPrevious) const {
+  const int id = savepointVector_->fieldIDOf(savepointIdx, field.index());
+  if(id != -1)
+    return FieldID{field.name(), unsigned(id)};
+
+  if(!alsoPrevious)
+    throw Exception("field '%s' does not exists at savepoint '%s'", field.name().str(),
+                    savepointVector_->nameOf(savepointIdx).str());
+
+  const int latestIdx = savepointVector_->findLatest(savepointIdx, field.index());
+  if(latestIdx == -1)
+    throw Exception("field '%s' not found at or before savepoint '%s'", field.name().str(),
+                    savepointVector_->savepointAt(savepointIdx).toString());
+  return FieldID{field.name(), unsigned(savepointVector_->fieldIDOf(latestIdx, field.index()))};
 }
 
 void SerializerImpl::readSliced(const std::string& name, const SavepointImpl& savepoint,
@@ -261,19 +438,208 @@ void SerializerImpl::readSliced(const std::string& name, const SavepointImpl& sa
   this->read(name, savepoint, storageView);
 }
 
-// This is the global task vector. If we would put the tasks inside SerializerImpl, we would have a
-// conditional member in a class (i.e depending on a macro) which can cause trouble if someone
-// compiled the library with SERIALBOX_ASYNC_API but doesn't use it when linking the library which
-// will smash the stack!
-#ifdef SERIALBOX_ASYNC_API
-namespace global {
-static std::vector<std::future<void>> tasks;
+void SerializerImpl::prefetch(const SavepointImpl& savepoint, int numSavepoints) {
+  int savepointIdx = savepointVector_->find(savepoint);
+  if(savepointIdx == -1)
+    throw Exception("savepoint '%s' does not exist", savepoint.toString());
+
+  prefetchRange(savepointIdx + 1, savepointIdx + 1 + numSavepoints);
 }
-#endif
 
-void SerializerImpl::readAsyncImpl(const std::string name, const SavepointImpl savepoint,
-                                   StorageView storageView) {
-  this->read(name, savepoint, storageView);
+void SerializerImpl::setPrefetchDepth(int depth) {
+  std::lock_guard<std::mutex> lock(*prefetchMutex_);
+  prefetchDepth_ = std::max(depth, 0);
+  prefetchedUpTo_ = lastReadSavepoint_ = -1;
+}
+
+int SerializerImpl::prefetchDepth() const {
+  std::lock_guard<std::mutex> lock(*prefetchMutex_);
+  return prefetchDepth_;
+}
+
+void SerializerImpl::prefetchRange(int first, int last) {
+  using FieldInfo = std::pair<FieldID, std::shared_ptr<FieldMetainfoImpl>>;
+
+  // Resolve the FieldIDs (deduplicated fields are loaded only once)
+  std::vector<FieldInfo> fields;
+  last = std::min(last, int(savepointVector_->size()));
+  for(int idx = first; idx < last; ++idx) {
+    for(const auto& field : savepointVector_->fieldsOf(idx)) {
+      FieldID fieldID{field.first, field.second};
+      if(std::find_if(fields.begin(), fields.end(), [&](const FieldInfo& f) {
+           return f.first == fieldID;
+         }) == fields.end())
+        fields.emplace_back(fieldID, fieldMap_->getFieldMetainfoImplPtrOf(field.first));
+    }
+  }
+
+  for(const FieldInfo& field : fields) {
+    prefetchQueue_->push([this, field]() {
+      // Prefetching is only a hint, errors are reported once the field is actually read
+      try {
+        prefetchField(field.first, field.second);
+      } catch(std::exception& e) {
+        LOG(warning) << "Failed to prefetch field \"" << field.first.name
+                     << "\" (id = " << field.first.id << "): " << e.what();
+      }
+    });
+  }
+}
+
+void SerializerImpl::prefetchField(const FieldID& fieldID,
+                                   const std::shared_ptr<FieldMetainfoImpl>& info,
+                                   const Slice& slice) {
+  if(!fieldCache_->isEnabled() || !archive_->isReadingThreadSafe()) {
+    archive_->prefetch(fieldID, info);
+    return;
+  }
+
+  // Read the whole field into the cache (using a col-major storage)
+  const std::vector<int>& dims = info->dims();
+  std::vector<int> strides(dims.size(), 1);
+  std::size_t size = TypeUtil::sizeOf(info->type());
+  for(std::size_t i = 0; i < dims.size(); ++i) {
+    strides[i] = i == 0 ? 1 : strides[i - 1] * dims[i - 1];
+    size *= dims[i];
+  }
+
+  std::vector<Byte> data(size);
+  StorageView storageView(data.data(), info->type(), dims, strides);
+  if(!slice.empty())
+    storageView.setSlice(slice);
+  if(size == 0 || fieldCache_->contains(fieldID, storageView))
+    return;
+
+  archive_->read(storageView, fieldID, info);
+  fieldCache_->insert(fieldID, storageView);
+}
+
+void SerializerImpl::prefetchAfter(int savepointIdx) {
+  int first, last;
+  {
+    std::lock_guard<std::mutex> lock(*prefetchMutex_);
+    if(prefetchDepth_ == 0 || mode_ != OpenModeKind::Read || savepointIdx == lastReadSavepoint_)
+      return;
+
+    // Start over if the replay jumps backwards
+    if(savepointIdx < lastReadSavepoint_)
+      prefetchedUpTo_ = savepointIdx;
+    lastReadSavepoint_ = savepointIdx;
+
+    first = std::max(savepointIdx, prefetchedUpTo_) + 1;
+    last = savepointIdx + 1 + prefetchDepth_;
+    if(first >= last)
+      return;
+    prefetchedUpTo_ = last - 1;
+  }
+  prefetchRange(first, last);
+}
+
+void SerializerImpl::setAccessTraceRecording(bool record) {
+  std::unique_ptr<AccessTraceRecorder> recorder;
+  if(record)
+    recorder = std::make_unique<AccessTraceRecorder>(accessTraceFile().string());
+
+  std::lock_guard<std::mutex> lock(*prefetchMutex_);
+  traceRecorder_.swap(recorder);
+}
+
+bool SerializerImpl::isRecordingAccessTrace() const {
+  std::lock_guard<std::mutex> lock(*prefetchMutex_);
+  return traceRecorder_ != nullptr;
+}
+
+void SerializerImpl::replayAccessTrace(std::size_t budget) {
+  std::unique_ptr<AccessTraceFollower> follower;
+  if(budget != 0) {
+    AccessTrace trace = AccessTrace::fromFile(accessTraceFile().string());
+
+    // Size of the (sliced) data of each access, accesses of unknown fields are never prefetched
+    std::vector<std::size_t> sizes;
+    sizes.reserve(trace.size());
+    for(const AccessTrace::Access& access : trace) {
+      if(!fieldMap_->hasField(access.fieldID.name)) {
+        sizes.push_back(std::numeric_limits<std::size_t>::max());
+        continue;
+      }
+      const FieldMetainfoImpl& info = fieldMap_->getFieldMetainfoImplOf(access.fieldID.name);
+      std::size_t size = TypeUtil::sizeOf(info.type());
+      for(std::size_t i = 0; i < info.dims().size(); ++i) {
+        if(i < access.slice.size()) {
+          const SliceTriple& triple = access.slice[i];
+          size *= std::max(triple.stop - triple.start + triple.step - 1, 0) / triple.step;
+        } else
+          size *= info.dims()[i];
+      }
+      sizes.push_back(size);
+    }
+
+    follower = std::make_unique<AccessTraceFollower>(std::move(trace), std::move(sizes), budget);
+    if(fieldCache_->capacity() < budget)
+      fieldCache_->setCapacity(budget);
+  }
+
+  // Start prefetching the beginning of the trace
+  std::vector<AccessTrace::Access> accesses;
+  {
+    std::lock_guard<std::mutex> lock(*prefetchMutex_);
+    traceFollower_.swap(follower);
+    if(traceFollower_)
+      for(std::size_t i : traceFollower_->schedule())
+        accesses.push_back(traceFollower_->trace()[i]);
+  }
+  prefetchTrace(accesses);
+}
+
+bool SerializerImpl::isReplayingAccessTrace() const {
+  std::lock_guard<std::mutex> lock(*prefetchMutex_);
+  return traceFollower_ != nullptr;
+}
+
+void SerializerImpl::traceRead(const FieldID& fieldID, int savepointIdx,
+                               const StorageView& storageView) {
+  std::vector<AccessTrace::Access> accesses;
+  {
+    std::lock_guard<std::mutex> lock(*prefetchMutex_);
+    if(!traceRecorder_ && !traceFollower_)
+      return;
+
+    const std::vector<SliceTriple>& slice = storageView.getSlice().sliceTriples();
+    if(traceRecorder_)
+      traceRecorder_->record(AccessTrace::Access{fieldID, savepointIdx, slice});
+
+    // The data of the read is evicted before the data which was prefetched but not yet read
+    if(traceFollower_ && traceFollower_->advance(fieldID, slice)) {
+      fieldCache_->demote(fieldID, storageView);
+      for(std::size_t i : traceFollower_->schedule())
+        accesses.push_back(traceFollower_->trace()[i]);
+    }
+  }
+  prefetchTrace(accesses);
+}
+
+void SerializerImpl::prefetchTrace(const std::vector<AccessTrace::Access>& accesses) {
+  for(const AccessTrace::Access& access : accesses) {
+    // Prefetching never fails the read which triggered it
+    if(!fieldMap_->hasField(access.fieldID.name)) {
+      LOG(warning) << "Failed to prefetch field \"" << access.fieldID.name
+                   << "\": field is not registered";
+      continue;
+    }
+
+    auto info = fieldMap_->getFieldMetainfoImplPtrOf(access.fieldID.name);
+    Slice slice((Slice::Empty()));
+    slice.sliceTriples() = access.slice;
+
+    prefetchQueue_->push([this, access, info, slice]() {
+      try {
+        prefetchField(access.fieldID, info, slice);
+      } catch(std::exception& e) {
+        LOG(warning) << "Failed to prefetch field \"" << access.fieldID.name
+                     << "\" (id = " << access.fieldID.id << "): " << e.what();
+      }
+    });
+  }
 }
 
 void SerializerImpl::readAsync(const std::string& name, const SavepointImpl& savepoint,
@@ -281,27 +647,86 @@ void SerializerImpl::readAsync(const std::string& name, const SavepointImpl& sav
 #ifdef SERIALBOX_ASYNC_API
   if(!archive_->isReadingThreadSafe())
     this->read(name, savepoint, storageView);
-  else
-    // Bad things can happen if we forward the refrences and directly call the SerializerImpl::read,
-    // we thus just make a copy of the arguments.
-    global::tasks.emplace_back(std::async(std::launch::async, &SerializerImpl::readAsyncImpl, this,
-                                          name, savepoint, storageView));
+  else {
+    // Bad things can happen if we keep the refrences until SerializerImpl::waitForAll, we thus
+    // just make a copy of the arguments.
+    bool schedule = false;
+    {
+      std::lock_guard<std::mutex> lock(*asyncReadsMutex_);
+      asyncReads_.push_back(AsyncRead{name, savepoint, storageView});
+      schedule = !asyncReadScheduled_;
+      asyncReadScheduled_ = true;
+    }
+
+    // Start a batch unless one is already waiting for the background thread (which then picks up
+    // this read as well)
+    if(schedule)
+      asyncReadQueue_->push([this]() { performAsyncReads(); });
+  }
 #else
   this->read(name, savepoint, storageView);
 #endif
 }
 
 void SerializerImpl::waitForAll() {
-#ifdef SERIALBOX_ASYNC_API
+  asyncReadQueue_->wait();
+
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(*asyncReadsMutex_);
+    std::swap(error, asyncReadError_);
+  }
+  if(error)
+    std::rethrow_exception(error);
+}
+
+void SerializerImpl::performAsyncReads() {
+  std::vector<AsyncRead> reads;
+  {
+    std::lock_guard<std::mutex> lock(*asyncReadsMutex_);
+    reads.swap(asyncReads_);
+    asyncReadScheduled_ = false;
+  }
+  if(reads.empty() || SerializerImpl::serializationStatus() < 0)
+    return;
+
+  // Errors are reported by the next call to SerializerImpl::waitForAll
   try {
-    for(auto& task : global::tasks)
-      task.get();
-  } catch(std::exception& e) {
-    global::tasks.clear();
-    throw Exception(e.what());
+    LOG(info) << "Deserializing " << reads.size() << " fields asynchronously ... ";
+
+    // Cached fields are served immediately, all other fields are passed as one batch to the
+    // archive
+    std::vector<Archive::ReadRequest> requests;
+    std::vector<int> savepointIdxs;
+    for(AsyncRead& read : reads) {
+      auto info = checkStorageView(read.name, read.storageView);
+
+      int savepointIdx;
+      FieldID fieldID = findFieldID(read.name, read.savepoint, false, savepointIdx);
+
+      if(fieldCache_->lookup(fieldID, read.storageView)) {
+        traceRead(fieldID, savepointIdx, read.storageView);
+        prefetchAfter(savepointIdx);
+        continue;
+      }
+      requests.push_back(Archive::ReadRequest{read.storageView, fieldID, info});
+      savepointIdxs.push_back(savepointIdx);
+    }
+
+    archive_->readBatch(requests);
+
+    for(std::size_t i = 0; i < requests.size(); ++i) {
+      fieldCache_->insert(requests[i].fieldID, requests[i].storageView);
+      traceRead(requests[i].fieldID, savepointIdxs[i], requests[i].storageView);
+      prefetchAfter(savepointIdxs[i]);
+    }
+
+    LOG(info) << "Successfully deserialized " << reads.size() << " fields";
+  } catch(...) {
+    std::lock_guard<std::mutex> lock(*asyncReadsMutex_);
+    if(!asyncReadError_)
+      asyncReadError_ = std::current_exception();
   }
-  global::tasks.clear();
-#endif
 }
 
 //===------------------------------------------------------------------------------------------===//
@@ -320,49 +745,85 @@ void SerializerImpl::constructMetaDataFromJson() {
                       directory_);
   }
 
-  json::json jsonNode;
-  try {
-    std::ifstream fs(metaDataFile_.string(), std::ios::in);
-    fs >> jsonNode;
-    fs.close();
-  } catch(std::exception& e) {
-    throw Exception("JSON parser error: %s", e.what());
+  // Load the snapshot of the meta-data unless it is stale (or disabled)
+  const bool useSnapshot = mode_ == OpenModeKind::Read && MetaDataSnapshot::isEnabled();
+
+  MetaDataSnapshot::Source source;
+  if(useSnapshot) {
+    try {
+      source = MetaDataSnapshot::Source::of(metaDataFile_.string());
+      if(MetaDataSnapshot::read(metaDataSnapshotFile().string(), source, *globalMetainfo_,
+                                *savepointVector_, *fieldMap_))
+        return;
+    } catch(Exception& e) {
+      LOG(warning) << "Failed to load meta-data snapshot: " << e.what();
+      globalMetainfo_->clear();
+      savepointVector_->clear();
+      fieldMap_->clear();
+    }
   }
 
+  std::ifstream fs(metaDataFile_.string(), std::ios::in);
+  if(!fs.is_open())
+    throw Exception("cannot open file: %s", metaDataFile_);
+
+  // The meta-data is built directly from the token stream (without an intermediate JSON document)
   try {
+    JsonReader reader(fs);
+    int serialboxVersion = 0;
+    std::string prefix;
+    bool hasVersion = false, hasPrefix = false;
+
+    reader.beginObject();
+    std::string key;
+    while(reader.nextKey(key)) {
+      if(key == "serialbox_version") {
+        serialboxVersion = static_cast<int>(reader.readInteger());
+        hasVersion = true;
+      } else if(key == "prefix") {
+        prefix = reader.readString();
+        hasPrefix = true;
+      } else if(key == "global_meta_info") {
+        from_json(reader, *globalMetainfo_);
+      } else if(key == "savepoint_vector") {
+        from_json(reader, *savepointVector_);
+      } else if(key == "field_map") {
+        from_json(reader, *fieldMap_); // TODO probably fieldMap_ shouldn't be a shared_ptr
+      } else {
+        reader.skipValue();
+      }
+    }
+    reader.end();
+
     // Check consistency
-    if(!jsonNode.count("serialbox_version"))
+    if(!hasVersion)
       throw Exception("node 'serialbox_version' not found");
 
-    int serialboxVersion = jsonNode["serialbox_version"];
-
     if(!Version::isCompatible(serialboxVersion))
       throw Exception(
           "serialbox version of MetaData (%s) does not match the version of the library (%s)",
           Version::toString(serialboxVersion), SERIALBOX_VERSION_STRING);
 
     // Check if prefix match
-    if(!jsonNode.count("prefix"))
+    if(!hasPrefix)
       throw Exception("node 'prefix' not found");
 
-    if(jsonNode["prefix"] != prefix_)
-      throw Exception("inconsistent prefixes: expected '%s' got '%s'", jsonNode["prefix"], prefix_);
-
-    // Construct globalMetainfo
-    if(jsonNode.count("global_meta_info"))
-      *globalMetainfo_ = jsonNode.at("global_meta_info");
-
-    // Construct Savepoints
-    if(jsonNode.count("savepoint_vector"))
-      *savepointVector_ = jsonNode["savepoint_vector"];
-
-    // Construct FieldMap
-    if(jsonNode.count("field_map"))
-      *fieldMap_ = jsonNode["field_map"]; // TODO probably fieldMap_ shouldn't be a shared_ptr
+    if(prefix != prefix_)
+      throw Exception("inconsistent prefixes: expected '%s' got '%s'", prefix, prefix_);
 
   } catch(Exception& e) {
     throw Exception("error while parsing %s: %s", metaDataFile_, e.what());
   }
+
+  // Subsequent openings (possibly by other processes) load the snapshot
+  if(useSnapshot && source.size > 0 && ::access(directory_.string().c_str(), W_OK) == 0) {
+    try {
+      MetaDataSnapshot::write(metaDataSnapshotFile().string(), source, *globalMetainfo_,
+                              *savepointVector_, *fieldMap_);
+    } catch(Exception& e) {
+      LOG(warning) << "Failed to write meta-data snapshot: " << e.what();
+    }
+  }
 }
 
 std::string SerializerImpl::toString() const {
@@ -393,15 +854,28 @@ void SerializerImpl::updateMetaData() {
   if(mode_ == OpenModeKind::Read)
     throw Exception("Trying to write meta data in Read mode.");
 
-  json::json jsonNode = *this;
+  std::string metaData;
+  std::uint64_t revision = 0;
+  {
+    std::lock_guard<std::mutex> lock(*metaDataMutex_);
+    json::json jsonNode = *this;
+    metaData = jsonNode.dump(1);
+    revision = ++metaDataRevision_;
+  }
 
   // Write metaData to disk (just overwrite the file, we assume that there is never more than one
   // Serializer per data set and thus our in-memory copy is always the up-to-date one)
-  std::ofstream fs(metaDataFile_.string(), std::ios::out | std::ios::trunc);
-  if(!fs.is_open())
-    throw Exception("cannot open file: %s", metaDataFile_);
-  fs << jsonNode.dump(1) << std::endl;
-  fs.close();
+  {
+    std::lock_guard<std::mutex> lock(*metaDataFileMutex_);
+    if(revision > metaDataRevisionOnDisk_) {
+      std::ofstream fs(metaDataFile_.string(), std::ios::out | std::ios::trunc);
+      if(!fs.is_open())
+        throw Exception("cannot open file: %s", metaDataFile_);
+      fs << metaData << std::endl;
+      fs.close();
+      metaDataRevisionOnDisk_ = revision;
+    }
+  }
 
   // Update archive meta-data
   archive_->updateMetaData();
@@ -15,13 +15,23 @@
 #ifndef SERIALBOX_CORE_SERIALIZERIMPL_H
 #define SERIALBOX_CORE_SERIALIZERIMPL_H
 
+#include "serialbox/core/AccessTrace.h"
+#include "serialbox/core/FieldCache.h"
 #include "serialbox/core/FieldMap.h"
 #include "serialbox/core/Filesystem.h"
+#include "serialbox/core/Handle.h"
+#include "serialbox/core/MetaDataSnapshot.h"
 #include "serialbox/core/MetainfoMapImpl.h"
+#include "serialbox/core/STLExtras.h"
+#include "serialbox/core/SavepointQuery.h"
 #include "serialbox/core/SavepointVector.h"
 #include "serialbox/core/StorageView.h"
+#include "serialbox/core/TaskQueue.h"
 #include "serialbox/core/archive/Archive.h"
+#include <cstdint>
+#include <exception>
 #include <iosfwd>
+#include <mutex>
 
 namespace serialbox {
 
@@ -112,6 +122,16 @@ public:
   /// \brief Access the path to the meta-data file
   const filesystem::path& metaDataFile() const noexcept { return metaDataFile_; }
 
+  /// \brief Get the path of the binary snapshot of the meta-data (`MetaData-prefix.bin` in the
+  /// directory of the Serializer)
+  ///
+  /// Serializers opened for reading load the meta-data from the snapshot (see MetaDataSnapshot) and
+  /// create it on their first opening if the directory is writable. Setting the environment
+  /// variable `SERIALBOX_METADATA_SNAPSHOT` to 0 disables the snapshot.
+  filesystem::path metaDataSnapshotFile() const {
+    return directory_ / MetaDataSnapshot::filename(prefix_);
+  }
+
   /// \brief Drop all field and savepoint meta-data.
   ///
   /// This will also call Archive::clear() which may \b remove all related files on the disk.
@@ -167,14 +187,30 @@ public:
   ///
   /// \param name  Name of the the new field
   /// \param Args  Arguments forwarded to the constructor of FieldMetainfoImpl
+  /// \return Handle of the field
   ///
   /// \throw Exception  Field with same name already exists
   template <class StringType, typename... Args>
-  void registerField(StringType&& name, Args&&... args) {
-    if(!fieldMap_->insert(std::forward<StringType>(name), std::forward<Args>(args)...))
-      throw Exception("cannot register field '%s': field already exists", name);
+  FieldHandle registerField(StringType&& name, Args&&... args) {
+    // Dense indices of the fields follow the order of registration
+    InternedString fieldName(name);
+    unsigned int index, generation;
+    {
+      std::lock_guard<std::mutex> lock(*metaDataMutex_);
+      index = savepointVector_->registerField(fieldName);
+      generation = generation_;
+    }
+    if(!fieldMap_->insert(fieldName.str(), std::forward<Args>(args)...))
+      throw Exception("cannot register field '%s': field already exists", fieldName.str());
+    return FieldHandle(fieldName, index, fieldMap_->findField(fieldName.str())->second,
+                       generation);
   }
 
+  /// \brief Get the handle of the registered field `name`
+  ///
+  /// \throw Exception  Field `name` does not exist in FieldMap
+  FieldHandle lookupField(const std::string& name);
+
   /// \brief Check if field `name` has been registred within the Serializer
   ///
   /// \param name  Name of the the new field
@@ -230,7 +266,41 @@ public:
   /// \return True iff the savepoint was successfully inserted
   template <typename... Args>
   bool registerSavepoint(Args&&... args) noexcept {
-    return (savepointVector_->insert(SavepointImpl(std::forward<Args>(args)...)) != -1);
+    SavepointImpl savepoint(std::forward<Args>(args)...);
+    std::lock_guard<std::mutex> lock(*metaDataMutex_);
+    return (savepointVector_->insert(savepoint) != -1);
+  }
+
+  /// \brief Get the handle of `savepoint`
+  ///
+  /// \return Handle of the savepoint which is invalid if the savepoint does not exist
+  SavepointHandle findSavepoint(const SavepointImpl& savepoint) const {
+    std::lock_guard<std::mutex> lock(*metaDataMutex_);
+    return SavepointHandle(savepointVector_->find(savepoint), generation_);
+  }
+
+  /// \brief Get the handle of `savepoint` and register the savepoint if it does not exist
+  SavepointHandle findOrRegisterSavepoint(const SavepointImpl& savepoint);
+
+  /// \brief Query the savepoints by their name and meta-information
+  ///
+  /// \return Indices of the matching savepoints (in the order they were registered)
+  ///
+  /// \see SavepointVector::query
+  std::vector<int> querySavepoints(const SavepointQuery& query) const {
+    // Concurrent writes may register savepoints (and update the indexes) meanwhile
+    std::lock_guard<std::mutex> lock(*metaDataMutex_);
+    return savepointVector_->query(query);
+  }
+
+  /// \brief Find the savepoint which matches `query` and whose (numeric) value of `key` is closest
+  /// to `value`
+  ///
+  /// \return Index of the savepoint or -1 if no savepoint matches
+  int findNearestSavepoint(const SavepointQuery& query, const std::string& key,
+                           double value) const {
+    std::lock_guard<std::mutex> lock(*metaDataMutex_);
+    return savepointVector_->nearest(query, key, value);
   }
 
   /// \brief Add a field to the savepoint
@@ -246,13 +316,23 @@ public:
     return savepointVector_->getFieldID(savepoint, field);
   }
 
+  /// \brief Get the FielID of field `field` at savepoint `savepoint` or, if the field is not stored
+  /// at `savepoint`, at the most recent savepoint before (as read with `alsoPrevious`)
+  ///
+  /// \throw Exception  Savepoint does not exist or field is not stored at or before `savepoint`
+  FieldID getLatestFieldIDAtSavepoint(const SavepointImpl& savepoint,
+                                      const std::string& field) const {
+    std::lock_guard<std::mutex> lock(*metaDataMutex_);
+    const int savepointIdx = savepointVector_->find(savepoint);
+    if(savepointIdx == -1)
+      throw Exception("savepoint '%s' does not exist", savepoint.toString());
+    return savepointVector_->getLatestFieldID(savepointIdx, field);
+  }
+
   /// \brief Get refrence to savepoint vector
   const SavepointVector::savepoint_vector_type& savepoints() const noexcept {
     return savepointVector_->savepoints();
   }
-  SavepointVector::savepoint_vector_type& savepoints() noexcept {
-    return savepointVector_->savepoints();
-  }
 
   /// \brief Get refrence to SavepointVector
   const SavepointVector& savepointVector() const noexcept { return *savepointVector_; }
@@ -287,6 +367,11 @@ public:
   ///
   /// 6. Update meta-data on disk via SerializerImpl::updateMetaData()
   ///
+  /// Concurrent calls are safe as long as they write distinct fields (or the same field at
+  /// distinct savepoints) and no fields are registered at the same time. Steps 2, 3 and 5 are
+  /// carried out in a short critical section while step 4 runs in parallel if the Archive
+  /// supports thread-safe writing (see Archive::isWritingThreadSafe) and is serialized otherwise.
+  ///
   /// \param name           Name of the field
   /// \param savepoint      Savepoint at which the field will be serialized
   /// \param storageView    StorageView of the field
@@ -298,6 +383,16 @@ public:
   void write(const std::string& name, const SavepointImpl& savepoint,
              const StorageView& storageView);
 
+  /// \brief Serialize `field` (given as `storageView`) at `savepoint` to disk
+  ///
+  /// Same as above, but the field and savepoint are given by handles, which spares the lookup of
+  /// the field name and savepoint. The savepoint has to be registered beforehand (see
+  /// SerializerImpl::findOrRegisterSavepoint).
+  ///
+  /// \throw Exception
+  void write(const FieldHandle& field, const SavepointHandle& savepoint,
+             const StorageView& storageView);
+
   //===----------------------------------------------------------------------------------------===//
   //     Reading
   //===----------------------------------------------------------------------------------------===//
@@ -312,7 +407,11 @@ public:
   ///
   /// 2. Check if savepoint exists and has a field `name`.
   ///
-  /// 3. Pass the StorageView to the backend Archive and perform actual data-deserialization.
+  /// 3. Pass the StorageView to the backend Archive and perform actual data-deserialization
+  ///    (unless the field is cached, see SerializerImpl::setFieldCacheSize).
+  ///
+  /// 4. Prefetch the following savepoints (see SerializerImpl::setPrefetchDepth) or the next
+  ///    reads of the access trace (see SerializerImpl::replayAccessTrace).
   ///
   /// \param name           Name of the field
   /// \param savepoint      Savepoint at which the field will be deserialized
@@ -325,6 +424,15 @@ public:
   void read(const std::string& name, const SavepointImpl& savepoint, StorageView& storageView,
             bool alsoPrevious = false);
 
+  /// \brief Deserialize `field` (given as `storageView`) at `savepoint` from disk
+  ///
+  /// Same as above, but the field and savepoint are given by handles, which spares the lookup of
+  /// the field name and savepoint.
+  ///
+  /// \throw Exception
+  void read(const FieldHandle& field, const SavepointHandle& savepoint, StorageView& storageView,
+            bool alsoPrevious = false);
+
   /// \brief Deserialize sliced field `name` (given as `storageView` and `slice`) at `savepoint`
   /// from disk.
   ///
@@ -341,11 +449,14 @@ public:
                   Slice slice);
 
   /// \brief Asynchronously deserialize field `name` (given as `storageView`) at `savepoint` from
-  /// disk using std::async.
+  /// disk.
   ///
-  /// This method runs the `read` function (SerializerImpl::read) asynchronously (potentially in a
-  /// separate thread which may be part of a thread pool) meaning this function immediately returns.
-  /// To synchronize all threads, use SerializerImpl::waitForAll.
+  /// This method queues the read and immediately returns. The queued reads are performed by a
+  /// background thread while the caller continues: the thread takes all reads queued so far as
+  /// one batch, which allows the archive to have all of them in flight at once (e.g the
+  /// BinaryArchive submits them to an io_uring, see Archive::readBatch), and reads queued in the
+  /// meantime form the next batch. The `storageView` has to remain valid until
+  /// SerializerImpl::waitForAll returns.
   ///
   /// If the archive is not thread-safe or if the library was not configured with
   /// `SERIALBOX_ASYNC_API` the method falls back to synchronous execution.
@@ -358,13 +469,89 @@ public:
   ///
   /// \see
   ///   SerializerImpl::read
-  /// \see
-  ///   http://en.cppreference.com/w/cpp/thread/async
   void readAsync(const std::string& name, const SavepointImpl& savepoint, StorageView& storageView);
 
-  /// \brief Wait for all pending asynchronous read operations and reset the internal queue
+  /// \brief Wait until all pending asynchronous read operations are completed
+  ///
+  /// \throw Exception  The first error of the asynchronous reads since the last call
   void waitForAll();
 
+  /// \brief Set the budget in bytes of the cache of deserialized fields
+  ///
+  /// Repeated reads of the same field (i.e FieldID) and slice are served from an in-memory LRU
+  /// cache (see FieldCache) instead of the archive. A budget of 0 (the default) disables the
+  /// cache.
+  void setFieldCacheSize(std::size_t bytes) { fieldCache_->setCapacity(bytes); }
+
+  /// \brief Get the budget in bytes of the cache of deserialized fields
+  std::size_t fieldCacheSize() const { return fieldCache_->capacity(); }
+
+  /// \brief Get the hit/miss counters of the cache of deserialized fields
+  FieldCache::Statistics fieldCacheStatistics() const { return fieldCache_->statistics(); }
+
+  /// \brief Drop all entries of the cache of deserialized fields
+  void flushFieldCache() { fieldCache_->flush(); }
+
+  /// \brief Hint that the fields of the `numSavepoints` savepoints following `savepoint` will be
+  /// read soon
+  ///
+  /// The FieldIDs of all fields at these savepoints are resolved and loaded by a background task
+  /// while the function returns immediately. If the cache of deserialized fields is enabled (see
+  /// SerializerImpl::setFieldCacheSize), the fields are read into the cache, otherwise they are
+  /// passed to Archive::prefetch (e.g the BinaryArchive advises the kernel to read the data into
+  /// the page cache). The fields are loaded in order by a single background thread.
+  ///
+  /// \throw Exception  Savepoint does not exist
+  void prefetch(const SavepointImpl& savepoint, int numSavepoints = 1);
+
+  /// \brief Set the number of savepoints which are prefetched automatically
+  ///
+  /// Each read at a savepoint prefetches the fields of the following `depth` savepoints (which
+  /// were not yet prefetched) as it is the case when replaying the savepoints in order. A depth
+  /// of 0 (the default) disables automatic prefetching, which is only done in `Read` mode.
+  void setPrefetchDepth(int depth);
+
+  /// \brief Get the number of savepoints which are prefetched automatically
+  int prefetchDepth() const;
+
+  /// \brief Wait until all prefetched fields are loaded
+  void waitForPrefetch() { prefetchQueue_->wait(); }
+
+  /// \brief Get the path of the access trace (`AccessTrace-prefix.txt` in the directory of the
+  /// Serializer)
+  filesystem::path accessTraceFile() const { return directory_ / AccessTrace::filename(prefix_); }
+
+  /// \brief Start or stop recording the reads to the access trace
+  ///
+  /// The field, savepoint and slice of each read are appended to the access trace (see
+  /// SerializerImpl::accessTraceFile), which is overwritten when the recording starts. Replays
+  /// which read the archive in the same order can follow the trace to prefetch the data (see
+  /// SerializerImpl::replayAccessTrace).
+  ///
+  /// \throw Exception  Access trace cannot be created
+  void setAccessTraceRecording(bool record);
+
+  /// \brief Check if the reads are recorded to the access trace
+  bool isRecordingAccessTrace() const;
+
+  /// \brief Follow the recorded access trace and prefetch the data ahead of the reads
+  ///
+  /// The reads of the access trace are loaded into the cache of deserialized fields by a
+  /// background thread (see SerializerImpl::prefetch) as long as the data which was prefetched
+  /// but not yet read fits into `budget` bytes. The cache is enlarged to the budget if necessary.
+  /// Reads which are not part of the trace are served as usual. A budget of 0 stops following the
+  /// trace.
+  ///
+  /// Setting the environment variable `SERIALBOX_ACCESS_TRACE` to `record` or `replay` records or
+  /// follows the access trace of all Serializers opened in `Read` mode. The budget of replays is
+  /// given in MB by `SERIALBOX_ACCESS_TRACE_BUDGET` (256 MB by default).
+  ///
+  /// \throw Exception  Access trace does not exist or is corrupted
+  void replayAccessTrace(std::size_t budget);
+
+  /// \brief Check if the reads follow the access trace
+  bool isReplayingAccessTrace() const;
+
   //===----------------------------------------------------------------------------------------===//
   //     JSON Serialization
   //===----------------------------------------------------------------------------------------===//
@@ -373,7 +560,9 @@ public:
   /// ArchiveMetaData-prefix.json
   ///
   /// This will ensure MetaData-prefix.json is up-to-date with the in-memory versions of the
-  /// savepointVector, fieldMap and globalMetainfo as well as the meta-data of the Archive.
+  /// savepointVector, fieldMap and globalMetainfo as well as the meta-data of the Archive. The
+  /// function is thread-safe, if several threads update the meta-data concurrently only the most
+  /// recent snapshot is written to disk.
   void updateMetaData();
 
   /// \brief Convert to string
@@ -403,6 +592,23 @@ protected:
   std::shared_ptr<FieldMetainfoImpl> checkStorageView(const std::string& name,
                                                       const StorageView& storageView) const;
 
+  /// \brief Check if `storageView` is consistent with the field `name` described by `info`
+  ///
+  /// \throw Exception    Inconsistency is detected
+  static void checkStorageView(const std::string& name, const FieldMetainfoImpl& info,
+                               const StorageView& storageView);
+
+  /// \brief Perform steps 4 to 6 of SerializerImpl::write i.e pass the StorageView to the Archive
+  /// and register the field at savepoint `savepointIdx`
+  void writeField(const std::string& name, const std::shared_ptr<FieldMetainfoImpl>& info,
+                  int savepointIdx, const SavepointImpl& savepoint,
+                  const StorageView& storageView);
+
+  /// \brief Perform steps 3 and 4 of SerializerImpl::read i.e read `fieldID` requested at
+  /// savepoint `savepointIdx` from the cache or the Archive
+  void readField(const FieldID& fieldID, int savepointIdx,
+                 const std::shared_ptr<FieldMetainfoImpl>& info, StorageView& storageView);
+
   /// \brief Check if the current directory contains meta-information of an older version of
   /// serialbox and upgrade it if necessary
   ///
@@ -418,9 +624,48 @@ protected:
   /// \throw Exception
   bool upgradeMetaData();
 
-  /// \brief Implementation of SerializerImpl::readAsync
-  void readAsyncImpl(const std::string name, const SavepointImpl savepoint,
-                     StorageView storageView);
+  /// \brief Prefetch the fields of the savepoints [`first`, `last`)
+  void prefetchRange(int first, int last);
+
+  /// \brief Automatically prefetch the savepoints following the savepoint `savepointIdx`
+  void prefetchAfter(int savepointIdx);
+
+  /// \brief Record the read of `fieldID` at savepoint `savepointIdx` and prefetch the next reads
+  /// of the access trace
+  void traceRead(const FieldID& fieldID, int savepointIdx, const StorageView& storageView);
+
+  /// \brief Prefetch the `accesses` of the followed access trace
+  void prefetchTrace(const std::vector<AccessTrace::Access>& accesses);
+
+  /// \brief Load the (sliced) field `fieldID` into the cache or the page cache (runs in the
+  /// background)
+  void prefetchField(const FieldID& fieldID, const std::shared_ptr<FieldMetainfoImpl>& info,
+                     const Slice& slice = Slice(Slice::Empty()));
+
+  /// \brief Get the FieldID of field `name` at `savepoint` (or at the most recent savepoint before,
+  /// if `alsoPrevious` is true) and the index of `savepoint`
+  FieldID findFieldID(const std::string& name, const SavepointImpl& savepoint, bool alsoPrevious,
+                      int& requestedSavepointIdx) const;
+
+  /// \brief Get the FieldID of `field` at savepoint `savepointIdx` (or at the most recent
+  /// savepoint before, if `alsoPrevious` is true), requires `metaDataMutex_`
+  FieldID findFieldID(const FieldHandle& field, int savepointIdx, bool alsoPrevious) const;
+
+  /// \brief Check that the handles refer to a field and savepoint of the current generation,
+  /// requires `metaDataMutex_`
+  ///
+  /// \throw Exception  Handles are invalid or stale
+  void checkHandles(const FieldHandle& field, const SavepointHandle& savepoint) const;
+
+  /// \brief Read queued by SerializerImpl::readAsync
+  struct AsyncRead {
+    std::string name;
+    SavepointImpl savepoint;
+    StorageView storageView;
+  };
+
+  /// \brief Perform the queued asynchronous reads as one batch (runs on `asyncReadQueue_`)
+  void performAsyncReads();
 
 protected:
   OpenModeKind mode_;
@@ -434,6 +679,55 @@ protected:
 
   std::unique_ptr<Archive> archive_;
 
+  // Guards the savepoint vector and the JSON snapshot of the meta-data during concurrent writes
+  std::unique_ptr<std::mutex> metaDataMutex_ = std::make_unique<std::mutex>();
+
+  // Savepoint most recently written to by handle, materialized for the Archive (guarded by
+  // `metaDataMutex_`)
+  int handleSavepointIdx_ = -1;
+  std::shared_ptr<const SavepointImpl> handleSavepoint_;
+
+  // Generation of the handles, incremented by `clear` (guarded by `metaDataMutex_`)
+  unsigned int generation_ = 0;
+
+  // Serializes writing of MetaData-prefix.json. Each snapshot is tagged with a revision and a
+  // snapshot is only written if no newer one has already been written to disk.
+  std::unique_ptr<std::mutex> metaDataFileMutex_ = std::make_unique<std::mutex>();
+  std::uint64_t metaDataRevision_ = 0;
+  std::uint64_t metaDataRevisionOnDisk_ = 0;
+
+  // Serializes calls to Archive::write if the archive is not thread-safe for writing
+  std::unique_ptr<std::mutex> archiveMutex_ = std::make_unique<std::mutex>();
+
+  // Reads queued by `readAsync` which are not yet picked up by the background thread, whether a
+  // batch is scheduled and the first error of the batches (guarded by `asyncReadsMutex_`)
+  std::unique_ptr<std::mutex> asyncReadsMutex_ = std::make_unique<std::mutex>();
+  std::vector<AsyncRead> asyncReads_;
+  bool asyncReadScheduled_ = false;
+  std::exception_ptr asyncReadError_;
+
+  // Deserialized fields (disabled by default)
+  std::unique_ptr<FieldCache> fieldCache_ = std::make_unique<FieldCache>();
+
+  // Automatic prefetching: number of savepoints to prefetch, the last prefetched savepoint and the
+  // most recently read savepoint (guarded by `prefetchMutex_`)
+  std::unique_ptr<std::mutex> prefetchMutex_ = std::make_unique<std::mutex>();
+  int prefetchDepth_ = 0;
+  int prefetchedUpTo_ = -1;
+  int lastReadSavepoint_ = -1;
+
+  // Access trace of the reads, which is either recorded or followed (guarded by `prefetchMutex_`)
+  std::unique_ptr<AccessTraceRecorder> traceRecorder_;
+  std::unique_ptr<AccessTraceFollower> traceFollower_;
+
+  // Prefetched fields are loaded by a background thread. The queue is declared last as the thread
+  // has to finish before any other member is destroyed.
+  std::unique_ptr<TaskQueue> prefetchQueue_ = std::make_unique<TaskQueue>();
+
+  // Batches of asynchronous reads are performed by their own background thread (which may
+  // schedule prefetches, hence it is destroyed first)
+  std::unique_ptr<TaskQueue> asyncReadQueue_ = std::make_unique<TaskQueue>();
+
   // This variable can take three values:
   //
   //  0: the variable is not yet initialized -> the serialization is enabled if the environment
@@ -0,0 +1,81 @@
+//===-- serialbox/core/TaskQueue.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements a queue of tasks executed by a background thread.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/TaskQueue.h"
+#include "serialbox/core/Logging.h"
+#include <exception>
+
+namespace serialbox {
+
+TaskQueue::~TaskQueue() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+    tasks_.clear();
+  }
+  taskAvailable_.notify_all();
+  if(thread_.joinable())
+    thread_.join();
+}
+
+void TaskQueue::push(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+    if(!thread_.joinable())
+      thread_ = std::thread(&TaskQueue::run, this);
+  }
+  taskAvailable_.notify_one();
+}
+
+void TaskQueue::wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this] { return tasks_.empty() && !running_; });
+}
+
+std::size_t TaskQueue::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return tasks_.size() + (running_ ? 1 : 0);
+}
+
+void TaskQueue::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while(true) {
+    taskAvailable_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+    if(stop_)
+      break;
+
+    std::function<void()> task = std::move(tasks_.front());
+    tasks_.pop_front();
+    running_ = true;
+
+    lock.unlock();
+    try {
+      task();
+    } catch(std::exception& e) {
+      LOG(warning) << "Background task failed: " << e.what();
+    } catch(...) {
+      LOG(warning) << "Background task failed";
+    }
+    lock.lock();
+
+    running_ = false;
+    if(tasks_.empty())
+      idle_.notify_all();
+  }
+  running_ = false;
+  idle_.notify_all();
+}
+
+} // namespace serialbox
@@ -0,0 +1,68 @@
+//===-- serialbox/core/TaskQueue.h --------------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains a queue of tasks executed by a background thread.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_TASKQUEUE_H
+#define SERIALBOX_CORE_TASKQUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace serialbox {
+
+/// \brief Queue of tasks which are executed in order by a background thread
+///
+/// The thread is started by the first task. Exceptions thrown by the tasks are only logged as
+/// warnings, hence tasks are expected to handle their errors. Pending tasks are discarded on
+/// destruction (the running task is finished).
+///
+/// \ingroup core
+class TaskQueue {
+public:
+  TaskQueue() = default;
+
+  /// \brief Discard all pending tasks and wait for the running task
+  ~TaskQueue();
+
+  TaskQueue(const TaskQueue&) = delete;
+  TaskQueue& operator=(const TaskQueue&) = delete;
+
+  /// \brief Append `task` to the queue (returns immediately)
+  void push(std::function<void()> task);
+
+  /// \brief Wait until all tasks are executed
+  void wait();
+
+  /// \brief Get the number of tasks which are not yet finished
+  std::size_t size() const;
+
+private:
+  /// \brief Execute the tasks until the queue is destroyed
+  void run();
+
+  mutable std::mutex mutex_;
+  std::condition_variable taskAvailable_;
+  std::condition_variable idle_;
+  std::deque<std::function<void()>> tasks_;
+  bool running_ = false;
+  bool stop_ = false;
+  std::thread thread_;
+};
+
+} // namespace serialbox
+
+#endif
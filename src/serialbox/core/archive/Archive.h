@@ -18,9 +18,11 @@
 #include "serialbox/core/Exception.h"
 #include "serialbox/core/FieldID.h"
 #include "serialbox/core/FieldMetainfoImpl.h"
+#include "serialbox/core/SavepointImpl.h"
 #include "serialbox/core/StorageView.h"
 #include "serialbox/core/Type.h"
 #include <iosfwd>
+#include <vector>
 
 namespace serialbox {
 
@@ -44,6 +46,22 @@ public:
   virtual FieldID write(const StorageView& storageView, const std::string& field,
                         const std::shared_ptr<FieldMetainfoImpl> info) = 0;
 
+  /// \brief Write the `field` given by `storageView` at `savepoint` to disk
+  ///
+  /// Archives which can exploit the savepoint (e.g to store all fields of a savepoint
+  /// contiguously) override this method, by default the savepoint is ignored.
+  ///
+  /// \param storageView    Abstract StorageView of the underlying data
+  /// \param field          Name of the field
+  /// \param info           Field meta-information (can be a `nullptr`)
+  /// \param savepoint      Savepoint at which the field is serialized
+  /// \return Unique identifier of the field
+  virtual FieldID write(const StorageView& storageView, const std::string& field,
+                        const std::shared_ptr<FieldMetainfoImpl> info,
+                        const SavepointImpl& savepoint) {
+    return write(storageView, field, info);
+  }
+
   /// \brief Read the field identified by `fieldID` and given by `storageView` from disk
   ///
   /// \param storageView    Abstract StorageView of the underlying data
@@ -52,6 +70,33 @@ public:
   virtual void read(StorageView& storageView, const FieldID& fieldID,
                     std::shared_ptr<FieldMetainfoImpl> info) const = 0;
 
+  /// \brief Request of a batched read (see Archive::readBatch)
+  struct ReadRequest {
+    StorageView storageView;                 ///< StorageView of the underlying data
+    FieldID fieldID;                         ///< Name and Id of the field
+    std::shared_ptr<FieldMetainfoImpl> info; ///< Field meta-information (can be a `nullptr`)
+  };
+
+  /// \brief Read a batch of fields from disk
+  ///
+  /// Archives which can overlap the I/O of several fields override this method, by default the
+  /// fields are read one after another.
+  ///
+  /// \param requests       Fields to read
+  virtual void readBatch(std::vector<ReadRequest>& requests) const {
+    for(ReadRequest& request : requests)
+      read(request.storageView, request.fieldID, request.info);
+  }
+
+  /// \brief Hint that the field identified by `fieldID` will be read soon
+  ///
+  /// Archives may start loading the data in the background (e.g into the page cache) and return
+  /// immediately. By default nothing is done.
+  ///
+  /// \param fieldID        Name and and Id of the field
+  /// \param info           Field meta-information (can be a `nullptr`)
+  virtual void prefetch(const FieldID& fieldID, std::shared_ptr<FieldMetainfoImpl> info) const {}
+
   /// \brief Update the meta-data on disk
   virtual void updateMetaData() = 0;
 
@@ -18,6 +18,7 @@
 #include "serialbox/core/archive/BinaryArchive.h"
 #include "serialbox/core/archive/MockArchive.h"
 #include "serialbox/core/archive/NetCDFArchive.h"
+#include "serialbox/core/archive/PackedBinaryArchive.h"
 
 namespace serialbox {
 
@@ -26,6 +27,8 @@ std::unique_ptr<Archive> ArchiveFactory::create(const std::string& name, OpenMod
                                                 const std::string& prefix) {
   if(name == BinaryArchive::Name) {
     return std::make_unique<BinaryArchive>(mode, directory, prefix);
+  } else if(name == PackedBinaryArchive::Name) {
+    return std::make_unique<PackedBinaryArchive>(mode, directory, prefix);
   } else if(name == MockArchive::Name) {
     return std::make_unique<MockArchive>(mode);
 #ifdef SERIALBOX_HAS_NETCDF
@@ -43,7 +46,8 @@ std::unique_ptr<Archive> ArchiveFactory::create(const std::string& name, OpenMod
 }
 
 std::vector<std::string> ArchiveFactory::registeredArchives() {
-  std::vector<std::string> archives{BinaryArchive::Name, MockArchive::Name
+  std::vector<std::string> archives{BinaryArchive::Name, PackedBinaryArchive::Name,
+                                    MockArchive::Name
 #ifdef SERIALBOX_HAS_NETCDF
                                     ,
                                     NetCDFArchive::Name
@@ -57,6 +61,8 @@ std::string ArchiveFactory::archiveFromExtension(std::string filename) {
 
   if(extension == ".dat" || extension == ".bin")
     return BinaryArchive::Name;
+  else if(extension == ".pack")
+    return PackedBinaryArchive::Name;
 #ifdef SERIALBOX_HAS_NETCDF
   else if(extension == ".nc")
     return NetCDFArchive::Name;
@@ -78,6 +84,8 @@ void ArchiveFactory::writeToFile(std::string filename, const StorageView& storag
 
   if(archiveName == BinaryArchive::Name) {
     BinaryArchive::writeToFile(filename, storageView);
+  } else if(archiveName == PackedBinaryArchive::Name) {
+    PackedBinaryArchive::writeToFile(filename, storageView, fieldname);
   }
 #ifdef SERIALBOX_HAS_NETCDF
   else if(archiveName == NetCDFArchive::Name) {
@@ -103,6 +111,8 @@ void ArchiveFactory::readFromFile(std::string filename, StorageView& storageView
 
   if(archiveName == BinaryArchive::Name) {
     BinaryArchive::readFromFile(filename, storageView);
+  } else if(archiveName == PackedBinaryArchive::Name) {
+    PackedBinaryArchive::readFromFile(filename, storageView, fieldname);
   }
 #ifdef SERIALBOX_HAS_NETCDF
   else if(archiveName == NetCDFArchive::Name) {
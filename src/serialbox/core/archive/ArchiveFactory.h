@@ -49,6 +49,7 @@ public:
   /// Extensions    | Archives
   /// ------------- | --------
   /// .dat, .bin    | Binary
+  /// .pack         | PackedBinary
   /// .nc           | NetCDF
   ///
   static std::string archiveFromExtension(std::string filename);
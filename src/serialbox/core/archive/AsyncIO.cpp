@@ -0,0 +1,338 @@
+//===-- serialbox/core/archive/AsyncIO.cpp ------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements the backends of batched file I/O.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/archive/AsyncIO.h"
+#include "serialbox/core/Exception.h"
+#include "serialbox/core/Logging.h"
+#include "serialbox/core/Parallel.h"
+#include "serialbox/core/STLExtras.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unistd.h>
+
+#ifdef SERIALBOX_HAS_IO_URING
+#include <deque>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+namespace serialbox {
+
+namespace {
+
+std::string requestError(const AsyncIO::Request& request, const char* reason) {
+  return std::string("failed to ") + (request.kind == AsyncIO::OpKind::Read ? "read " : "write ") +
+         std::to_string(request.size) + " bytes at offset " + std::to_string(request.offset) +
+         ": " + reason;
+}
+
+} // anonymous namespace
+
+//===------------------------------------------------------------------------------------------===//
+//     AsyncIO
+//===------------------------------------------------------------------------------------------===//
+
+std::unique_ptr<AsyncIO> AsyncIO::create() {
+#ifdef SERIALBOX_HAS_IO_URING
+  try {
+    return std::make_unique<IoUringIO>();
+  } catch(Exception& e) {
+    LOG(info) << "Falling back to threads for batched I/O: " << e.what();
+  }
+#endif
+  return std::make_unique<ThreadPoolIO>();
+}
+
+//===------------------------------------------------------------------------------------------===//
+//     ThreadPoolIO
+//===------------------------------------------------------------------------------------------===//
+
+void ThreadPoolIO::submit(const std::vector<Request>& requests) {
+  std::mutex errorMutex;
+  std::string error;
+
+  parallelFor(requests.size(),
+              [&](std::size_t i) {
+                const Request& request = requests[i];
+                std::size_t done = 0;
+                while(done < request.size) {
+                  ssize_t ret =
+                      request.kind == OpKind::Read
+                          ? ::pread(request.fd, request.data + done, request.size - done,
+                                    request.offset + done)
+                          : ::pwrite(request.fd, request.data + done, request.size - done,
+                                     request.offset + done);
+                  if(ret < 0 && errno == EINTR)
+                    continue;
+
+                  if(ret <= 0) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if(error.empty())
+                      error = requestError(request, ret == 0 ? "unexpected end of file"
+                                                             : std::strerror(errno));
+                    return;
+                  }
+                  done += ret;
+                }
+              },
+              numThreads_);
+
+  if(!error.empty())
+    throw Exception("%s", error);
+}
+
+#ifdef SERIALBOX_HAS_IO_URING
+
+//===------------------------------------------------------------------------------------------===//
+//     IoUringIO
+//===------------------------------------------------------------------------------------------===//
+
+const unsigned IoUringIO::QueueDepth = 256;
+
+const std::size_t IoUringIO::FixedBufferSize = 64 * 1024;
+
+const unsigned IoUringIO::NumFixedBuffers = 64;
+
+/// \brief Shared memory of the submission and completion queues
+struct IoUringIO::Ring {
+  int fd = -1;
+  io_uring_params params;
+
+  void* sqRing = MAP_FAILED;
+  std::size_t sqRingSize = 0;
+  void* cqRing = MAP_FAILED;
+  std::size_t cqRingSize = 0;
+  io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+  std::size_t sqesSize = 0;
+
+  unsigned* sqHead = nullptr;
+  unsigned* sqTail = nullptr;
+  unsigned sqMask = 0;
+  unsigned* sqArray = nullptr;
+
+  unsigned* cqHead = nullptr;
+  unsigned* cqTail = nullptr;
+  unsigned cqMask = 0;
+  io_uring_cqe* cqes = nullptr;
+
+  // Registered staging buffers (empty if the registration failed)
+  std::vector<Byte> buffers;
+  unsigned numBuffers = 0;
+
+  ~Ring() {
+    if(sqes != MAP_FAILED)
+      ::munmap(sqes, sqesSize);
+    if(cqRing != MAP_FAILED && cqRing != sqRing)
+      ::munmap(cqRing, cqRingSize);
+    if(sqRing != MAP_FAILED)
+      ::munmap(sqRing, sqRingSize);
+    if(fd >= 0)
+      ::close(fd);
+  }
+};
+
+IoUringIO::IoUringIO() : ring_(std::make_unique<Ring>()) {
+  Ring& ring = *ring_;
+  std::memset(&ring.params, 0, sizeof(ring.params));
+
+  ring.fd = int(::syscall(__NR_io_uring_setup, QueueDepth, &ring.params));
+  if(ring.fd < 0)
+    throw Exception("cannot set up io_uring: %s", std::strerror(errno));
+
+  const io_uring_params& params = ring.params;
+  ring.sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  ring.cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  if(params.features & IORING_FEAT_SINGLE_MMAP)
+    ring.sqRingSize = ring.cqRingSize = std::max(ring.sqRingSize, ring.cqRingSize);
+
+  ring.sqRing = ::mmap(nullptr, ring.sqRingSize, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_SQ_RING);
+  if(ring.sqRing == MAP_FAILED)
+    throw Exception("cannot map io_uring: %s", std::strerror(errno));
+
+  if(params.features & IORING_FEAT_SINGLE_MMAP)
+    ring.cqRing = ring.sqRing;
+  else {
+    ring.cqRing = ::mmap(nullptr, ring.cqRingSize, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_CQ_RING);
+    if(ring.cqRing == MAP_FAILED)
+      throw Exception("cannot map io_uring: %s", std::strerror(errno));
+  }
+
+  ring.sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+  ring.sqes = static_cast<io_uring_sqe*>(::mmap(nullptr, ring.sqesSize, PROT_READ | PROT_WRITE,
+                                                MAP_SHARED | MAP_POPULATE, ring.fd,
+                                                IORING_OFF_SQES));
+  if(ring.sqes == MAP_FAILED)
+    throw Exception("cannot map io_uring: %s", std::strerror(errno));
+
+  Byte* sq = static_cast<Byte*>(ring.sqRing);
+  ring.sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  ring.sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  ring.sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  ring.sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+  Byte* cq = static_cast<Byte*>(ring.cqRing);
+  ring.cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  ring.cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  ring.cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  ring.cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  // Register the staging buffers (requires locked memory, requests are performed on the memory of
+  // the request if this fails)
+  ring.buffers.resize(NumFixedBuffers * FixedBufferSize);
+  std::vector<iovec> iovecs(NumFixedBuffers);
+  for(unsigned i = 0; i < NumFixedBuffers; ++i)
+    iovecs[i] = iovec{ring.buffers.data() + i * FixedBufferSize, FixedBufferSize};
+
+  if(::syscall(__NR_io_uring_register, ring.fd, IORING_REGISTER_BUFFERS, iovecs.data(),
+               NumFixedBuffers) == 0)
+    ring.numBuffers = NumFixedBuffers;
+  else {
+    LOG(info) << "Cannot register io_uring buffers: " << std::strerror(errno);
+    std::vector<Byte>().swap(ring.buffers);
+  }
+}
+
+IoUringIO::~IoUringIO() {}
+
+void IoUringIO::submit(const std::vector<Request>& requests) {
+  Ring& ring = *ring_;
+
+  // State of each request: the staging buffer (if any), the number of transferred bytes and the
+  // vector passed to readv/writev (which has to stay valid until the completion)
+  struct Operation {
+    int buffer = -1;
+    std::size_t done = 0;
+    iovec vec;
+  };
+  std::vector<Operation> operations(requests.size());
+
+  std::vector<int> freeBuffers;
+  for(unsigned i = ring.numBuffers; i-- > 0;)
+    freeBuffers.push_back(i);
+
+  std::deque<std::size_t> pending;
+  for(std::size_t i = 0; i < requests.size(); ++i)
+    if(requests[i].size > 0)
+      pending.push_back(i);
+
+  std::string error;
+  unsigned inFlight = 0;
+
+  while(!pending.empty() || inFlight > 0) {
+
+    // Fill the submission queue (the completion queue is twice as large and can't overflow)
+    unsigned tail = *ring.sqTail;
+    while(!pending.empty() && inFlight < ring.params.sq_entries) {
+      const std::size_t i = pending.front();
+      pending.pop_front();
+      const Request& request = requests[i];
+      Operation& operation = operations[i];
+      const bool isRead = request.kind == OpKind::Read;
+
+      if(operation.done == 0 && request.size <= FixedBufferSize && !freeBuffers.empty()) {
+        operation.buffer = freeBuffers.back();
+        freeBuffers.pop_back();
+        if(!isRead)
+          std::memcpy(ring.buffers.data() + operation.buffer * FixedBufferSize, request.data,
+                      request.size);
+      }
+
+      const unsigned index = tail & ring.sqMask;
+      io_uring_sqe& sqe = ring.sqes[index];
+      std::memset(&sqe, 0, sizeof(sqe));
+      sqe.fd = request.fd;
+      sqe.off = request.offset + operation.done;
+      sqe.user_data = i;
+
+      if(operation.buffer >= 0) {
+        sqe.opcode = isRead ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+        sqe.addr = reinterpret_cast<std::uintptr_t>(
+            ring.buffers.data() + operation.buffer * FixedBufferSize + operation.done);
+        sqe.len = request.size - operation.done;
+        sqe.buf_index = operation.buffer;
+      } else {
+        operation.vec = iovec{request.data + operation.done, request.size - operation.done};
+        sqe.opcode = isRead ? IORING_OP_READV : IORING_OP_WRITEV;
+        sqe.addr = reinterpret_cast<std::uintptr_t>(&operation.vec);
+        sqe.len = 1;
+      }
+
+      ring.sqArray[index] = index;
+      ++tail;
+      ++inFlight;
+    }
+    __atomic_store_n(ring.sqTail, tail, __ATOMIC_RELEASE);
+
+    // Submit the queued requests and wait for at least one completion
+    const unsigned toSubmit = tail - __atomic_load_n(ring.sqHead, __ATOMIC_ACQUIRE);
+    if(::syscall(__NR_io_uring_enter, ring.fd, toSubmit, 1, IORING_ENTER_GETEVENTS, nullptr,
+                 0) < 0 &&
+       errno != EINTR && errno != EAGAIN && errno != EBUSY)
+      throw Exception("cannot submit io_uring requests: %s", std::strerror(errno));
+
+    // Process the completions
+    unsigned head = *ring.cqHead;
+    const unsigned cqTail = __atomic_load_n(ring.cqTail, __ATOMIC_ACQUIRE);
+    for(; head != cqTail; ++head) {
+      const io_uring_cqe& cqe = ring.cqes[head & ring.cqMask];
+      const std::size_t i = cqe.user_data;
+      const Request& request = requests[i];
+      Operation& operation = operations[i];
+      --inFlight;
+
+      if(cqe.res == -EINTR || cqe.res == -EAGAIN) {
+        pending.push_back(i);
+        continue;
+      }
+
+      if(cqe.res <= 0) {
+        if(error.empty())
+          error = requestError(request,
+                               cqe.res == 0 ? "unexpected end of file" : std::strerror(-cqe.res));
+      } else {
+        operation.done += cqe.res;
+
+        // Short reads and writes are continued
+        if(operation.done < request.size) {
+          pending.push_back(i);
+          continue;
+        }
+
+        if(operation.buffer >= 0 && request.kind == OpKind::Read)
+          std::memcpy(request.data, ring.buffers.data() + operation.buffer * FixedBufferSize,
+                      request.size);
+      }
+
+      if(operation.buffer >= 0) {
+        freeBuffers.push_back(operation.buffer);
+        operation.buffer = -1;
+      }
+    }
+    __atomic_store_n(ring.cqHead, head, __ATOMIC_RELEASE);
+  }
+
+  if(!error.empty())
+    throw Exception("%s", error);
+}
+
+#endif
+
+} // namespace serialbox
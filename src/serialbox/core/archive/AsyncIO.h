@@ -0,0 +1,127 @@
+//===-- serialbox/core/archive/AsyncIO.h --------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the backends of batched file I/O (io_uring and a thread pool).
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_ARCHIVE_ASYNCIO_H
+#define SERIALBOX_CORE_ARCHIVE_ASYNCIO_H
+
+#include "serialbox/core/Config.h"
+#include "serialbox/core/Type.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace serialbox {
+
+/// \brief Batched file I/O
+///
+/// All requests of a batch are issued at once and AsyncIO::submit returns once all of them are
+/// completed. On Linux the requests are passed to the kernel via an io_uring (see IoUringIO),
+/// otherwise (or if io_uring is not permitted) they are distributed over a pool of threads (see
+/// ThreadPoolIO).
+///
+/// Backends are not thread-safe, each thread has to use its own backend.
+///
+/// \ingroup core
+class AsyncIO {
+public:
+  /// \brief Kind of a request
+  enum class OpKind { Read, Write };
+
+  /// \brief Read `size` bytes at `offset` of the file `fd` into `data` (or write them)
+  struct Request {
+    OpKind kind;
+    int fd;
+    std::uint64_t offset;
+    Byte* data;
+    std::size_t size;
+  };
+
+  virtual ~AsyncIO() {}
+
+  /// \brief Perform all `requests` and wait for their completion
+  ///
+  /// \throw Exception  A request failed or a read reached the end of the file (the remaining
+  ///                   requests are completed nevertheless)
+  virtual void submit(const std::vector<Request>& requests) = 0;
+
+  /// \brief Name of the backend
+  virtual const char* name() const noexcept = 0;
+
+  /// \brief Create the io_uring backend if available, otherwise the thread pool backend
+  static std::unique_ptr<AsyncIO> create();
+};
+
+/// \brief Batched file I/O using `pread`/`pwrite` on a pool of threads
+///
+/// \ingroup core
+class ThreadPoolIO : public AsyncIO {
+public:
+  /// \brief Distribute the requests over `numThreads` threads (0 uses all hardware threads)
+  explicit ThreadPoolIO(std::size_t numThreads = 0) : numThreads_(numThreads) {}
+
+  virtual void submit(const std::vector<Request>& requests) override;
+
+  virtual const char* name() const noexcept override { return "threads"; }
+
+private:
+  std::size_t numThreads_;
+};
+
+#ifdef SERIALBOX_HAS_IO_URING
+
+/// \brief Batched file I/O using an io_uring
+///
+/// The requests are submitted to the kernel by the calling thread, up to IoUringIO::QueueDepth
+/// requests are in flight at once. Small requests are staged in fixed buffers which are
+/// registered with the kernel once (saving the mapping of the user memory for each request),
+/// larger requests are performed directly on the memory of the request.
+///
+/// \ingroup core
+class IoUringIO : public AsyncIO {
+public:
+  /// \brief Maximum number of requests in flight
+  static const unsigned QueueDepth;
+
+  /// \brief Size in bytes of each registered staging buffer
+  static const std::size_t FixedBufferSize;
+
+  /// \brief Number of registered staging buffers
+  static const unsigned NumFixedBuffers;
+
+  /// \brief Set up the io_uring and register the staging buffers
+  ///
+  /// \throw Exception  io_uring is not supported or not permitted
+  IoUringIO();
+
+  /// \brief Tear down the io_uring
+  virtual ~IoUringIO();
+
+  IoUringIO(const IoUringIO&) = delete;
+  IoUringIO& operator=(const IoUringIO&) = delete;
+
+  virtual void submit(const std::vector<Request>& requests) override;
+
+  virtual const char* name() const noexcept override { return "io_uring"; }
+
+private:
+  struct Ring;
+  std::unique_ptr<Ring> ring_;
+};
+
+#endif
+
+} // namespace serialbox
+
+#endif
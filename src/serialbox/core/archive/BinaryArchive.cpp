@@ -13,155 +13,122 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "serialbox/core/archive/BinaryArchive.h"
+#include "serialbox/core/archive/BinaryBuffer.h"
+#include "serialbox/core/archive/BlockStore.h"
+#include "serialbox/core/archive/Readahead.h"
+#include "serialbox/core/archive/ChunkLayout.h"
+#include "serialbox/core/JsonReader.h"
 #include "serialbox/core/Logging.h"
+#include "serialbox/core/MetaDataSnapshot.h"
+#include "serialbox/core/Parallel.h"
 #include "serialbox/core/STLExtras.h"
 #include "serialbox/core/Version.h"
 #include "serialbox/core/hash/HashFactory.h"
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
 #include <fstream>
+#include <thread>
+#include <unistd.h>
 
 namespace serialbox {
 
 //===------------------------------------------------------------------------------------------===//
-//     BinaryBuffer
+//     BinaryArchive
 //===------------------------------------------------------------------------------------------===//
 
-/// \brief Contiguous buffer with support for sliced loading
-class BinaryBuffer {
-public:
-  /// \brief Allocate the buffer
-  BinaryBuffer(const StorageView& storageView) {
-    const auto& slice = storageView.getSlice();
-
-    if(slice.empty()) {
-      buffer_.resize(storageView.sizeInBytes());
-      offset_ = 0;
-    } else {
-      const auto& dims = storageView.dims();
-      const auto& triple = slice.sliceTriples().back();
-      const int bytesPerElement = storageView.bytesPerElement();
+const std::string BinaryArchive::Name = "Binary";
 
-      // Allocate a buffer which can be efficently loaded. The buffer will treat the
-      // dimensions dim_{1}, ..., dim_{N-1} as full while last the dimension dim_{N} as sliced but
-      // without incorporating the step. This is necessary as we only want to call ::write once.
+const int BinaryArchive::Version = 4;
 
-      // Compute dimensions
-      dims_ = dims;
-      dims_.back() = triple.stop - triple.start;
+const std::size_t BinaryArchive::DefaultMinReadSegmentSize = 16 << 20;
 
-      // Compute strides (col-major)
-      strides_.resize(dims_.size());
+const std::size_t BinaryArchive::ReadSegmentAlignment = 4096;
 
-      int stride = 1;
-      strides_[0] = stride;
+namespace {
 
-      for(int i = 1; i < dims_.size(); ++i) {
-        stride *= dims_[i - 1];
-        strides_[i] = stride;
-      }
+/// Hexadecimal representation of `bytes`
+std::string toHex(const std::vector<Byte>& bytes) {
+  static const char* digits = "0123456789abcdef";
+  std::string hex;
+  for(Byte byte : bytes) {
+    hex.push_back(digits[(unsigned char)byte >> 4]);
+    hex.push_back(digits[(unsigned char)byte & 0xf]);
+  }
+  return hex;
+}
 
-      // Compute size
-      std::size_t size = 1;
-      for(std::size_t i = 0; i < dims_.size(); ++i)
-        size *= (dims_[i] == 0 ? 1 : dims_[i]);
+/// Convert the hexadecimal representation `hex` back to bytes
+std::vector<Byte> fromHex(const std::string& hex) {
+  if(hex.size() % 2)
+    throw Exception("invalid hexadecimal value '%s'", hex);
 
-      // Compute initial offset in bytes
-      offset_ = (strides_.back() * triple.start) * bytesPerElement;
+  std::vector<Byte> bytes(hex.size() / 2);
+  for(std::size_t i = 0; i < bytes.size(); ++i)
+    bytes[i] = (Byte)std::stoi(hex.substr(2 * i, 2), nullptr, 16);
+  return bytes;
+}
 
-      buffer_.resize(size * bytesPerElement);
-    }
+/// Read the description of the layout of an encoded, chunked or uniform entry from `codecNode`
+void readEncoding(const json::json& codecNode, BinaryArchive::FileOffsetType& fileOffset) {
+  if(codecNode.count("uniform_value")) {
+    BinaryArchive::UniformValue& uniform = fileOffset.uniform;
+    uniform.value = fromHex(codecNode["uniform_value"].get<std::string>());
+    uniform.dims = codecNode["uniform_dims"].get<std::vector<int>>();
   }
 
-  /// \brief Copy data from buffer to `storageView` while handling slicing
-  void copyBufferToStorageView(StorageView& storageView) {
-    const auto& slice = storageView.getSlice();
-
-    if(slice.empty()) {
-      Byte* dataPtr = buffer_.data();
-      const int bytesPerElement = storageView.bytesPerElement();
-
-      if(storageView.isMemCopyable()) {
-        std::memcpy(storageView.originPtr(), dataPtr, buffer_.size());
-      } else {
-        for(auto it = storageView.begin(), end = storageView.end(); it != end;
-            ++it, dataPtr += bytesPerElement)
-          std::memcpy(it.ptr(), dataPtr, bytesPerElement);
-      }
+  if(codecNode.count("blocks") && codecNode.count("block_store")) {
+    fileOffset.blockStore = codecNode["block_store"].get<std::string>();
+    for(const auto& block : codecNode["blocks"])
+      fileOffset.blocks.push_back(BlockReference{block.at(0), block.at(1)});
+  }
 
-    } else {
-      const int numDims = dims_.size();
-      const auto& triples = slice.sliceTriples();
-      const int bytesPerElement = storageView.bytesPerElement();
-      Byte* dataPtr = buffer_.data();
-
-      // Compute intial indices in the buffer
-      std::vector<int> index(numDims);
-      for(int i = 0; i < numDims - 1; ++i)
-        index[i] = triples[i].start;
-      index.back() = 0;
-
-      // Iterate over the the storageView and the Buffer
-      Byte* curPtr = buffer_.data();
-      for(auto it = storageView.begin(), end = storageView.end(); it != end; ++it) {
-
-        // Compute position of current element
-        int pos = 0;
-        for(int i = 0; i < numDims; ++i)
-          pos += bytesPerElement * (strides_[i] * index[i]);
-        curPtr = dataPtr + pos;
-
-        // Memcopy the current elemment to the storageView
-        std::memcpy(it.ptr(), curPtr, bytesPerElement);
-
-        // Compute the index of the next element in the buffer
-        for(int i = 0; i < numDims; ++i)
-          if((index[i] += triples[i].step) < triples[i].stop)
-            break;
-          else
-            index[i] = triples[i].start;
-      }
-    }
+  if(codecNode.count("chunk_shape")) {
+    ChunkIndex& chunks = fileOffset.chunks;
+    chunks.shape = codecNode["chunk_shape"].get<std::vector<int>>();
+    chunks.offsets = codecNode["chunk_offsets"].get<std::vector<std::uint64_t>>();
   }
 
-  /// \brief Copy data from `storageView` to buffer
-  void copyStorageViewToBuffer(const StorageView& storageView) {
-    Byte* dataPtr = buffer_.data();
-    const int bytesPerElement = storageView.bytesPerElement();
+  if(codecNode.count("codec")) {
+    CodecInfo& codec = fileOffset.codec;
+    codec.codec = codecNode["codec"].get<std::string>();
+    codec.shuffle = codecNode["shuffle"];
+    codec.blockSize = codecNode["block_size"];
+    codec.size = codecNode["size"];
+    codec.blocks = codecNode["blocks"].get<std::vector<std::uint64_t>>();
+
+    if(codecNode.count("error_bound_kind")) {
+      codec.errorBoundKind =
+          LossyFilter::fromString(codecNode["error_bound_kind"].get<std::string>());
+      codec.errorBound = codecNode["error_bound"];
+      codec.maxError = codecNode["max_error"];
+    }
 
-    if(storageView.isMemCopyable()) {
-      std::memcpy(dataPtr, storageView.originPtr(), buffer_.size());
-    } else {
-      for(auto it = storageView.begin(), end = storageView.end(); it != end;
-          ++it, dataPtr += bytesPerElement)
-        std::memcpy(dataPtr, it.ptr(), bytesPerElement);
+    if(codecNode.count("delta_reference")) {
+      codec.deltaReference = codecNode["delta_reference"];
+      codec.deltaDepth = codecNode["delta_depth"];
     }
   }
+}
 
-  /// \brief Get Buffer size
-  std::size_t size() const noexcept { return buffer_.size(); }
-
-  /// \brief Get pointer to the beginning of the buffer
-  Byte* data() noexcept { return buffer_.data(); }
-  const Byte* data() const noexcept { return buffer_.data(); }
-
-  /// \brief Get initial offset of the data on disk in bytes
-  std::size_t offset() const noexcept { return offset_; }
-
-private:
-  std::vector<Byte> buffer_;
-
-  std::vector<int> strides_;
-  std::vector<int> dims_;
-  std::size_t offset_;
-};
-
-//===------------------------------------------------------------------------------------------===//
-//     BinaryArchive
-//===------------------------------------------------------------------------------------------===//
-
-const std::string BinaryArchive::Name = "Binary";
+/// Lowest revision of the archive supporting `fileOffset` (archives of plain entries remain
+/// readable by libraries prior to the encoding of entries)
+int versionOf(const BinaryArchive::FileOffsetType& fileOffset) {
+  if(!fileOffset.blocks.empty())
+    return 4;
+  if(fileOffset.uniform.isUniform())
+    return 3;
+  if(fileOffset.chunks.isChunked())
+    return 2;
+  if(fileOffset.codec.isEncoded())
+    return 1;
+  return 0;
+}
 
-const int BinaryArchive::Version = 0;
+} // anonymous namespace
 
 BinaryArchive::BinaryArchive(OpenModeKind mode, const std::string& directory,
                              const std::string& prefix, bool skipMetaData)
@@ -212,14 +179,88 @@ void BinaryArchive::readMetaDataFromJson() {
     throw Exception("archive meta data not found in directory '%s'", directory_.string());
   }
 
+  // Load the snapshot of the field table unless it is stale (or disabled)
+  const bool useSnapshot = mode_ == OpenModeKind::Read && MetaDataSnapshot::isEnabled();
+  const std::string snapshotFile = metaDataSnapshotFile().string();
+
+  MetaDataSnapshot::Source source;
+  if(useSnapshot) {
+    try {
+      source = MetaDataSnapshot::Source::of(metaDatafile_.string());
+      std::string hashAlgorithm;
+      if(MetaDataSnapshot::readArchive(snapshotFile, source, hashAlgorithm, fieldTable_)) {
+        hash_ = HashFactory::create(hashAlgorithm);
+        return;
+      }
+    } catch(Exception& e) {
+      LOG(warning) << "Failed to load archive meta-data snapshot: " << e.what();
+      fieldTable_.clear();
+    }
+  }
+
   std::ifstream fs(metaDatafile_.string(), std::ios::in);
-  fs >> json_;
+
+  int serialboxVersion = 0, archiveVersion = 0;
+  std::string archiveName, hashAlgorithm;
+  bool hasSerialboxVersion = false, hasArchiveVersion = false;
+
+  // The FieldTable is built directly from the token stream (only the layout descriptions of
+  // encoded entries are read as JSON nodes)
+  JsonReader reader(fs);
+  reader.beginObject();
+  std::string key, field;
+  while(reader.nextKey(key)) {
+    if(key == "serialbox_version") {
+      serialboxVersion = static_cast<int>(reader.readInteger());
+      hasSerialboxVersion = true;
+    } else if(key == "archive_name") {
+      archiveName = reader.readString();
+    } else if(key == "archive_version") {
+      archiveVersion = static_cast<int>(reader.readInteger());
+      hasArchiveVersion = true;
+    } else if(key == "hash_algorithm") {
+      hashAlgorithm = reader.readString();
+    } else if(key == "fields_table") {
+      reader.beginObject();
+      while(reader.nextKey(field)) {
+        FieldOffsetTable fieldOffsetTable;
+
+        // Iterate over savepoint of this field
+        reader.beginArray();
+        while(reader.nextElement()) {
+          FileOffsetType fileOffset{0, ""};
+
+          // Encoded or chunked entries carry the description of the layout
+          int n = 0;
+          reader.beginArray();
+          for(; reader.nextElement(); ++n) {
+            if(n == 0)
+              fileOffset.offset = reader.readInteger();
+            else if(n == 1)
+              fileOffset.checksum = reader.readString();
+            else if(n == 2)
+              readEncoding(reader.readValue(), fileOffset);
+            else
+              reader.skipValue();
+          }
+
+          if(n < 2)
+            throw Exception("invalid entry (id = %i) of field '%s' in archive meta data",
+                            fieldOffsetTable.size(), field);
+          fieldOffsetTable.push_back(std::move(fileOffset));
+        }
+
+        fieldTable_[field] = std::move(fieldOffsetTable);
+      }
+    } else {
+      reader.skipValue();
+    }
+  }
+  reader.end();
   fs.close();
 
-  int serialboxVersion = json_["serialbox_version"];
-  std::string archiveName = json_["archive_name"];
-  int archiveVersion = json_["archive_version"];
-  std::string hashAlgorithm = json_["hash_algorithm"];
+  if(!hasSerialboxVersion || archiveName.empty() || !hasArchiveVersion || hashAlgorithm.empty())
+    throw Exception("incomplete archive meta data: %s", metaDatafile_.string());
 
   // Check consistency
   if(!Version::isCompatible(serialboxVersion))
@@ -230,7 +271,9 @@ void BinaryArchive::readMetaDataFromJson() {
   if(archiveName != BinaryArchive::Name)
     throw Exception("archive is not a binary archive");
 
-  if(archiveVersion != BinaryArchive::Version)
+  // Version 1 added the (optional) encoding of the entries, version 2 the chunked layout,
+  // version 3 the uniform entries and version 4 the block store
+  if(archiveVersion < 0 || archiveVersion > BinaryArchive::Version)
     throw Exception("binary archive version (%s) does not match the version of the library (%s)",
                     archiveVersion, BinaryArchive::Version);
 
@@ -238,49 +281,297 @@ void BinaryArchive::readMetaDataFromJson() {
   if(mode_ != OpenModeKind::Write)
     hash_ = HashFactory::create(hashAlgorithm);
 
-  // Deserialize FieldTable
-  for(auto it = json_["fields_table"].begin(); it != json_["fields_table"].end(); ++it) {
-    FieldOffsetTable fieldOffsetTable;
-
-    // Iterate over savepoint of this field
-    for(auto fileOffsetIt = it->begin(); fileOffsetIt != it->end(); ++fileOffsetIt)
-      fieldOffsetTable.push_back(FileOffsetType{fileOffsetIt->at(0), fileOffsetIt->at(1)});
-
-    fieldTable_[it.key()] = fieldOffsetTable;
+  // Subsequent openings (possibly by other processes) load the snapshot
+  if(useSnapshot && source.size > 0 && ::access(directory_.string().c_str(), W_OK) == 0) {
+    try {
+      MetaDataSnapshot::writeArchive(snapshotFile, source, hashAlgorithm, fieldTable_);
+    } catch(Exception& e) {
+      LOG(warning) << "Failed to write archive meta-data snapshot: " << e.what();
+    }
   }
 }
 
 void BinaryArchive::writeMetaDataToJson() {
   LOG(info) << "Update MetaData of BinaryArchive";
 
-  json_.clear();
+  std::string metaData;
+  std::uint64_t revision = 0;
+  {
+    std::lock_guard<std::mutex> lock(tableMutex_);
+
+    json_.clear();
+
+    // Tag versions
+    json_["serialbox_version"] =
+        100 * SERIALBOX_VERSION_MAJOR + 10 * SERIALBOX_VERSION_MINOR + SERIALBOX_VERSION_PATCH;
+    json_["archive_name"] = BinaryArchive::Name;
+    json_["hash_algorithm"] = hash_->name();
+
+    // FieldsTable
+    int archiveVersion = 0;
+    for(auto it = fieldTable_.begin(), end = fieldTable_.end(); it != end; ++it) {
+      for(unsigned int id = 0; id < it->second.size(); ++id) {
+        const FileOffsetType& fileOffset = it->second[id];
+        archiveVersion = std::max(archiveVersion, versionOf(fileOffset));
+        if(!fileOffset.codec.isEncoded() && !fileOffset.chunks.isChunked() &&
+           !fileOffset.uniform.isUniform() && fileOffset.blocks.empty()) {
+          json_["fields_table"][it->first].push_back({fileOffset.offset, fileOffset.checksum});
+        } else {
+          json::json codecNode;
+          if(fileOffset.codec.isEncoded()) {
+            codecNode["codec"] = fileOffset.codec.codec;
+            codecNode["shuffle"] = fileOffset.codec.shuffle;
+            codecNode["block_size"] = fileOffset.codec.blockSize;
+            codecNode["size"] = fileOffset.codec.size;
+            codecNode["blocks"] = fileOffset.codec.blocks;
+          }
+          if(fileOffset.codec.isLossy()) {
+            codecNode["error_bound_kind"] = LossyFilter::toString(fileOffset.codec.errorBoundKind);
+            codecNode["error_bound"] = fileOffset.codec.errorBound;
+            codecNode["max_error"] = fileOffset.codec.maxError;
+          }
+          if(fileOffset.codec.isDelta()) {
+            codecNode["delta_reference"] = fileOffset.codec.deltaReference;
+            codecNode["delta_depth"] = fileOffset.codec.deltaDepth;
+          }
+          if(fileOffset.uniform.isUniform()) {
+            codecNode["uniform_value"] = toHex(fileOffset.uniform.value);
+            codecNode["uniform_dims"] = fileOffset.uniform.dims;
+          }
+          if(!fileOffset.blocks.empty()) {
+            codecNode["block_store"] = fileOffset.blockStore;
+            for(const BlockReference& block : fileOffset.blocks)
+              codecNode["blocks"].push_back({block.digest, block.size});
+          }
+          if(fileOffset.chunks.isChunked()) {
+            codecNode["chunk_shape"] = fileOffset.chunks.shape;
+            codecNode["chunk_offsets"] = fileOffset.chunks.offsets;
+          }
+          json_["fields_table"][it->first].push_back(
+              {fileOffset.offset, fileOffset.checksum, codecNode});
+        }
+      }
+    }
 
-  // Tag versions
-  json_["serialbox_version"] =
-      100 * SERIALBOX_VERSION_MAJOR + 10 * SERIALBOX_VERSION_MINOR + SERIALBOX_VERSION_PATCH;
-  json_["archive_name"] = BinaryArchive::Name;
-  json_["archive_version"] = BinaryArchive::Version;
-  json_["hash_algorithm"] = hash_->name();
+    json_["archive_version"] = archiveVersion;
 
-  // FieldsTable
-  for(auto it = fieldTable_.begin(), end = fieldTable_.end(); it != end; ++it) {
-    for(unsigned int id = 0; id < it->second.size(); ++id)
-      json_["fields_table"][it->first].push_back({it->second[id].offset, it->second[id].checksum});
+    metaData = json_.dump(2);
+    revision = ++metaDataRevision_;
   }
 
   // Write metaData to disk (just overwrite the file, we assume that there is never more than one
   // Archive per data set and thus our in-memory copy is always the up-to-date one)
+  std::lock_guard<std::mutex> lock(metaDataFileMutex_);
+  if(revision <= metaDataRevisionOnDisk_)
+    return;
+
   std::ofstream fs(metaDatafile_.string(), std::ios::out | std::ios::trunc);
 
   if(!fs.is_open())
     throw Exception("cannot open file: %s", metaDatafile_);
 
-  fs << json_.dump(2) << std::endl;
+  fs << metaData << std::endl;
   fs.close();
+  metaDataRevisionOnDisk_ = revision;
 }
 
 void BinaryArchive::updateMetaData() { writeMetaDataToJson(); }
 
+filesystem::path BinaryArchive::metaDataSnapshotFile() const {
+  return directory_ / MetaDataSnapshot::archiveFilename(prefix_);
+}
+
+namespace {
+
+/// Chain of delta-encoded entries starting at `id` and ending at the keyframe
+std::vector<BinaryArchive::FileOffsetType>
+deltaChain(const BinaryArchive::FieldOffsetTable& fieldOffsetTable, const FieldID& fieldID) {
+  std::vector<BinaryArchive::FileOffsetType> chain{fieldOffsetTable[fieldID.id]};
+  for(unsigned int id = fieldID.id; chain.back().codec.isDelta();) {
+    unsigned int reference = chain.back().codec.deltaReference;
+    if(reference >= id)
+      throw Exception("invalid delta reference (%i) of field '%s' (id = %i)", reference,
+                      fieldID.name, id);
+    chain.push_back(fieldOffsetTable[id = reference]);
+  }
+  return chain;
+}
+
+/// Decode the blocks [`firstBlock`, `lastBlock`) of the first entry of the delta `chain` (a single
+/// entry if the data is not delta-encoded) into `dst`. If the decoded data of an entry of the chain
+/// is available (`cached`), decoding starts from there instead of the keyframe. The blocks are
+/// decoded by `numThreads` threads.
+void decodeBlocks(std::ifstream& fs, const std::vector<BinaryArchive::FileOffsetType>& chain,
+                  std::size_t firstBlock, std::size_t lastBlock, Byte* dst, BufferPool& pool,
+                  std::size_t numThreads, const FieldID& fieldID,
+                  const BinaryArchive::DecodedField* cached = nullptr) {
+  const CodecInfo& codec = chain.front().codec;
+  const std::size_t size = std::min<std::size_t>(lastBlock * codec.blockSize, codec.size) -
+                           firstBlock * codec.blockSize;
+
+  // Find the first entry whose reference is cached
+  std::size_t start = chain.size();
+  const Byte* cachedReference = nullptr;
+  if(cached && cached->data.size() == codec.size)
+    for(std::size_t n = 0; n + 1 < chain.size(); ++n)
+      if(chain[n].codec.deltaReference == cached->id) {
+        start = n + 1;
+        cachedReference = cached->data.data() + firstBlock * codec.blockSize;
+        break;
+      }
+
+  // Decode the keyframe first and use the result as reference of the next entry
+  BufferPool::Buffer reference;
+  for(std::size_t n = start; n-- > 0;) {
+    const CodecInfo& entryCodec = chain[n].codec;
+    if(entryCodec.size != codec.size || entryCodec.blockSize != codec.blockSize)
+      throw Exception("invalid delta reference of field '%s' (id = %i)", fieldID.name,
+                      fieldID.id);
+
+    // Read the compressed blocks with a single read
+    const std::uint64_t compressedBegin = entryCodec.compressedOffset(firstBlock);
+    const std::uint64_t compressedSize = entryCodec.compressedOffset(lastBlock) - compressedBegin;
+    BufferPool::Buffer compressed = pool.acquire(compressedSize);
+
+    fs.clear();
+    fs.seekg(chain[n].offset + compressedBegin);
+    if(!fs.read(compressed.data(), compressedSize))
+      throw Exception("failed to read field '%s' (id = %i)", fieldID.name, fieldID.id);
+
+    BufferPool::Buffer decoded;
+    Byte* target = dst;
+    if(n > 0) {
+      decoded = pool.acquire(size);
+      target = decoded.data();
+    }
+
+    const Byte* entryReference = nullptr;
+    if(entryCodec.isDelta())
+      entryReference = (n + 1 == start && cachedReference) ? cachedReference : reference.data();
+
+    auto pipeline = CodecPipeline::create(entryCodec);
+    pipeline->setNumThreads(numThreads);
+    pipeline->decode(compressed.data(), entryCodec, firstBlock, lastBlock, target, pool,
+                     entryReference);
+    reference = std::move(decoded);
+  }
+}
+
+/// Read the bytes [`begin`, `end`) of the data referenced by `blocks` into `dst`
+void readBlocks(const BlockStore& store, const std::vector<BlockReference>& blocks,
+                std::uint64_t begin, std::uint64_t end, Byte* dst, const FieldID& fieldID) {
+  std::uint64_t blockBegin = 0;
+  for(const BlockReference& block : blocks) {
+    const std::uint64_t blockEnd = blockBegin + block.size;
+    if(blockEnd > begin && blockBegin < end) {
+      const std::uint64_t first = std::max(begin, blockBegin), last = std::min(end, blockEnd);
+      store.get(block, first - blockBegin, last - first, dst + (first - begin));
+    }
+    blockBegin = blockEnd;
+  }
+
+  if(blockBegin < end)
+    throw Exception("field '%s' (id = %i) is smaller than the requested storage", fieldID.name,
+                    fieldID.id);
+}
+
+/// Read the bytes [`begin`, `end`) of the entry (given by its delta `chain`) into `dst`. Encoded
+/// entries only decode the blocks covering the range (using `numThreads` threads), entries of the
+/// block `store` do not use the file stream.
+void readRange(std::ifstream& fs, const std::vector<BinaryArchive::FileOffsetType>& chain,
+               std::size_t begin, std::size_t end, Byte* dst, BufferPool& pool,
+               std::size_t numThreads, const FieldID& fieldID,
+               const BinaryArchive::DecodedField* cached, const BlockStore* store) {
+  const CodecInfo& codec = chain.front().codec;
+
+  if(!chain.front().blocks.empty()) {
+    readBlocks(*store, chain.front().blocks, begin, end, dst, fieldID);
+    return;
+  }
+
+  if(!codec.isEncoded()) {
+    fs.clear();
+    fs.seekg(chain.front().offset + begin);
+    if(!fs.read(dst, end - begin))
+      throw Exception("failed to read field '%s' (id = %i)", fieldID.name, fieldID.id);
+    return;
+  }
+
+  if(end > codec.size)
+    throw Exception("field '%s' (id = %i) is smaller than the requested storage", fieldID.name,
+                    fieldID.id);
+  if(begin == end)
+    return;
+
+  const std::size_t firstBlock = begin / codec.blockSize;
+  const std::size_t lastBlock = (end - 1) / codec.blockSize + 1;
+
+  // Decode directly into the buffer if it is aligned to the blocks, otherwise use a staging buffer
+  const std::size_t blocksBegin = firstBlock * codec.blockSize;
+  const std::size_t blocksEnd = std::min<std::size_t>(lastBlock * codec.blockSize, codec.size);
+  if(blocksBegin == begin && blocksEnd == end) {
+    decodeBlocks(fs, chain, firstBlock, lastBlock, dst, pool, numThreads, fieldID, cached);
+  } else {
+    BufferPool::Buffer decoded = pool.acquire(blocksEnd - blocksBegin);
+    decodeBlocks(fs, chain, firstBlock, lastBlock, decoded.data(), pool, numThreads, fieldID,
+                 cached);
+    std::memcpy(dst, decoded.data() + (begin - blocksBegin), end - begin);
+  }
+}
+
+/// Reads of chunked data below this size are not distributed over several threads
+const std::uint64_t ParallelChunkReadThreshold = 1 << 20;
+
+/// Check if all `size / bytesPerElement` elements of `data` are bitwise identical (comparing the
+/// data to itself shifted by one element uses the vectorized memcmp). Data of a single element is
+/// not considered uniform.
+bool isUniform(const Byte* data, std::size_t size, int bytesPerElement) noexcept {
+  return size > std::size_t(bytesPerElement) &&
+         std::memcmp(data, data + bytesPerElement, size - bytesPerElement) == 0;
+}
+
+/// Check if `fileOffset` holds the data as it would be stored with `uniform` and `pipeline`, i.e
+/// entries with the same checksum can only be shared if they decode to the same data
+bool isStoredAs(const BinaryArchive::FileOffsetType& fileOffset,
+                const BinaryArchive::UniformValue& uniform, const CodecPipeline* pipeline) {
+  if(uniform.isUniform() || fileOffset.uniform.isUniform())
+    return fileOffset.uniform.value == uniform.value && fileOffset.uniform.dims == uniform.dims;
+
+  const CodecInfo& codec = fileOffset.codec;
+  if(codec.codec != (pipeline ? pipeline->codec().name() : std::string()))
+    return false;
+
+  const LossyFilter* filter = pipeline ? pipeline->lossyFilter() : nullptr;
+  if(!filter)
+    return !codec.isLossy();
+  return codec.errorBoundKind == filter->kind() && codec.errorBound == filter->bound();
+}
+
+/// Fill the (sliced) `storageView` with `value`
+void fillUniform(StorageView& storageView, const Byte* value) {
+  const int bytesPerElement = storageView.bytesPerElement();
+
+  if(storageView.isMemCopyable()) {
+    // Double the filled range with each memcpy
+    Byte* data = storageView.originPtr();
+    const std::size_t size = storageView.sizeInBytes();
+    if(size == 0)
+      return;
+
+    std::memcpy(data, value, bytesPerElement);
+    for(std::size_t filled = bytesPerElement; filled < size;) {
+      const std::size_t length = std::min(filled, size - filled);
+      std::memcpy(data + filled, data, length);
+      filled += length;
+    }
+  } else {
+    for(auto it = storageView.begin(), end = storageView.end(); it != end; ++it)
+      std::memcpy(it.ptr(), value, bytesPerElement);
+  }
+}
+
+} // anonymous namespace
+
 //===------------------------------------------------------------------------------------------===//
 //     Writing
 //===------------------------------------------------------------------------------------------===//
@@ -295,34 +586,133 @@ FieldID BinaryArchive::write(const StorageView& storageView, const std::string&
   filesystem::path filename(directory_ / (prefix_ + "_" + field + ".dat"));
   std::ofstream fs;
 
-  // Create binary data buffer
-  BinaryBuffer binaryBuffer(storageView);
-  binaryBuffer.copyStorageViewToBuffer(storageView);
+  // Create binary data buffer and compute the hash (this does not require any locking). Uniform
+  // data (e.g all zero) is detected before hashing, only its value is stored.
+  BinaryBuffer binaryBuffer(bufferPool_, storageView);
+  const int bytesPerElement = storageView.bytesPerElement();
 
-  // Compute hash
-  std::string checksum(hash_->hash(binaryBuffer.data(), binaryBuffer.size()));
+  const Byte* data = storageView.originPtr();
+  const bool isMemCopyable = storageView.isMemCopyable();
+  if(!isMemCopyable) {
+    binaryBuffer.copyStorageViewToBuffer(storageView);
+    data = binaryBuffer.data();
+  }
 
-  // Check if field already exists
-  auto it = fieldTable_.find(field);
-  FieldID fieldID{field, 0};
+  UniformValue uniform;
+  std::string checksum;
+  if(isUniform(data, binaryBuffer.size(), bytesPerElement)) {
+    uniform.value.assign(data, data + bytesPerElement);
+    uniform.dims = storageView.dims();
+
+    // Identical constants of the same size share the checksum (the tag separates the checksums of
+    // uniform data from the checksums of raw data)
+    static const char UniformTag[] = "uniform";
+    std::vector<Byte> key(UniformTag, UniformTag + sizeof(UniformTag));
+    key.insert(key.end(), uniform.value.begin(), uniform.value.end());
+    const std::uint64_t size = binaryBuffer.size();
+    key.insert(key.end(), (const Byte*)&size, (const Byte*)&size + sizeof(size));
+    checksum = hash_->hash(key.data(), key.size());
+  } else {
+    if(isMemCopyable)
+      binaryBuffer.copyStorageViewToBuffer(storageView);
+    checksum = hash_->hash(binaryBuffer.data(), binaryBuffer.size());
+  }
 
-  // Field does exists
-  if(it != fieldTable_.end()) {
-    FieldOffsetTable& fieldOffsetTable = it->second;
+  // From here on, we are the only writer of this field (i.e data file)
+  std::lock_guard<std::mutex> fieldLock(fieldMutex(field));
+
+  // Check if field already exists. The offset table of a field is only ever modified by writers of
+  // the same field, hence we can access it without holding the table lock.
+  FieldOffsetTable* fieldOffsetTable = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(tableMutex_);
+    auto it = fieldTable_.find(field);
+    if(it != fieldTable_.end())
+      fieldOffsetTable = &it->second;
+  }
 
-    // Check if field has already been serialized by comparing the checksum
-    for(std::size_t i = 0; i < fieldOffsetTable.size(); ++i)
-      if(checksum == fieldOffsetTable[i].checksum) {
+  FieldID fieldID{field, 0};
+  std::streamoff offset = 0;
+
+  auto registerFileOffset = [&](FileOffsetType&& fileOffset) {
+    std::lock_guard<std::mutex> lock(tableMutex_);
+    if(fieldOffsetTable)
+      fieldOffsetTable->push_back(std::move(fileOffset));
+    else
+      fieldTable_.insert(
+          FieldTable::value_type(fieldID.name, FieldOffsetTable(1, std::move(fileOffset))));
+  };
+
+  // Encoding requested by the field meta-information
+  auto pipeline = CodecPipeline::create(info.get(), storageView.type());
+  if(pipeline)
+    pipeline->setNumThreads(numCodecThreads_);
+
+  // Check if field has already been serialized by comparing the checksum and the encoding
+  if(fieldOffsetTable) {
+    for(std::size_t i = 0; i < fieldOffsetTable->size(); ++i)
+      if(checksum == (*fieldOffsetTable)[i].checksum &&
+         isStoredAs((*fieldOffsetTable)[i], uniform, pipeline.get())) {
         LOG(info) << "Field \"" << field << "\" already serialized (id = " << i << "). Stopping";
         fieldID.id = i;
         return fieldID;
       }
+  }
+
+  // Uniform data is only recorded in the meta-data
+  if(uniform.isUniform()) {
+    fieldID.id = fieldOffsetTable ? fieldOffsetTable->size() : 0;
+
+    FileOffsetType fileOffset{offset, checksum};
+    fileOffset.uniform = std::move(uniform);
+    registerFileOffset(std::move(fileOffset));
+    updateMetaData();
+
+    LOG(info) << "Successfully wrote uniform field \"" << fieldID.name << "\" (id = " << fieldID.id
+              << ")";
+    return fieldID;
+  }
+
+  FileOffsetType fileOffset{offset, checksum};
+
+  // Reorder the data into chunks if requested by the field meta-information
+  data = binaryBuffer.data();
+  BufferPool::Buffer chunked;
+  if(auto chunkLayout = ChunkLayout::create(info.get(), storageView)) {
+    chunked = bufferPool_.acquire(binaryBuffer.size());
+    chunkLayout->toChunks(binaryBuffer.data(), chunked.data());
+    data = chunked.data();
+    fileOffset.chunks = chunkLayout->index();
+  }
+
+  // Data of fields using the block store is only referenced by the entry
+  const BlockStore::Configuration blockStoreConfig = BlockStore::configuration(info.get());
+  if(blockStoreConfig.isEnabled() && binaryBuffer.size() > 0) {
+    if(pipeline)
+      throw Exception("field '%s' cannot use the block store and compression at the same time",
+                      field);
+
+    fieldID.id = fieldOffsetTable ? fieldOffsetTable->size() : 0;
+
+    std::shared_ptr<BlockStore> store = blockStore(blockStoreConfig.directory);
+    fileOffset.blockStore = blockStoreConfig.directory;
+    fileOffset.blocks = store->put(data, binaryBuffer.size(), blockStoreConfig.chunking,
+                                   blockStoreConfig.blockSize);
+    registerFileOffset(std::move(fileOffset));
+    updateMetaData();
+
+    LOG(info) << "Successfully wrote field \"" << fieldID.name << "\" (id = " << fieldID.id
+              << ") to block store " << store->directory();
+    return fieldID;
+  }
+
+  // Field does exists
+  if(fieldOffsetTable) {
 
     // Append field at the end
     fs.open(filename.string(), std::ofstream::out | std::ofstream::binary | std::ofstream::app);
-    auto offset = fs.tellp();
-    fieldID.id = fieldOffsetTable.size();
-    fieldOffsetTable.push_back(FileOffsetType{offset, checksum});
+    offset = fs.tellp();
+    fieldID.id = fieldOffsetTable->size();
 
     LOG(info) << "Appending field \"" << fieldID.name << "\" (id = " << fieldID.id << ") to "
               << filename.filename();
@@ -332,20 +722,84 @@ FieldID BinaryArchive::write(const StorageView& storageView, const std::string&
     fs.open(filename.string(), std::ios::out | std::ios::binary | std::ios::trunc);
     fieldID.id = 0;
 
-    fieldTable_.insert(
-        FieldTable::value_type(fieldID.name, FieldOffsetTable(1, FileOffsetType{0, checksum})));
-
     LOG(info) << "Creating new file " << filename.filename() << " for field \"" << fieldID.name
               << "\" (id = " << fieldID.id << ")";
   }
 
   if(!fs.is_open())
     throw Exception("cannot open file: '%s'", filename.string());
+  fileOffset.offset = offset;
 
   // Write binaryData to disk
-  fs.write(binaryBuffer.data(), binaryBuffer.size());
+  if(pipeline) {
+    BufferPool::Buffer encoded;
+
+    // Delta encoding uses the previous id as reference (unless a keyframe is due)
+    DecodedField* delta = nullptr;
+    const Byte* reference = nullptr;
+    int deltaDepth = 0;
+    std::vector<Byte> reconstructed;
+
+    if(pipeline->isDeltaEncoding()) {
+      {
+        std::lock_guard<std::mutex> lock(tableMutex_);
+        delta = &deltaReferences_[field];
+      }
+      reconstructed.resize(binaryBuffer.size());
+
+      const FileOffsetType* previous =
+          (fieldOffsetTable && !fieldOffsetTable->empty()) ? &fieldOffsetTable->back() : nullptr;
+
+      if(previous && previous->codec.isEncoded() &&
+         previous->codec.size == binaryBuffer.size() &&
+         previous->codec.blockSize == pipeline->blockSize() &&
+         previous->codec.deltaDepth + 1 < pipeline->keyframeInterval()) {
+        unsigned int previousId = fieldOffsetTable->size() - 1;
+
+        // Decode the previous id if it is not cached (e.g the archive was opened for appending)
+        if(delta->id != int(previousId) || delta->data.size() != binaryBuffer.size()) {
+          delta->data.resize(binaryBuffer.size());
+          std::ifstream ifs(filename.string(), std::ios::in | std::ios::binary);
+          FieldID previousFieldID{field, previousId};
+          decodeBlocks(ifs, deltaChain(*fieldOffsetTable, previousFieldID), 0,
+                       previous->codec.numBlocks(), delta->data.data(), bufferPool_,
+                       numCodecThreads_, previousFieldID);
+          delta->id = previousId;
+        }
+
+        reference = delta->data.data();
+        deltaDepth = previous->codec.deltaDepth + 1;
+      }
+    }
+
+    fileOffset.codec =
+        pipeline->encode(data, binaryBuffer.size(), bufferPool_, encoded,
+                         reference, delta ? reconstructed.data() : nullptr);
+    if(reference) {
+      fileOffset.codec.deltaReference = delta->id;
+      fileOffset.codec.deltaDepth = deltaDepth;
+    }
+    fs.write(encoded.data(), fileOffset.codec.compressedSize());
+
+    // The decoded data of this id is the reference of the next id
+    if(delta) {
+      delta->id = fieldID.id;
+      delta->data.swap(reconstructed);
+    }
+
+    LOG(info) << "Compressed field \"" << fieldID.name << "\" (id = " << fieldID.id << ") with "
+              << fileOffset.codec.codec << " (ratio = " << fileOffset.codec.ratio()
+              << (fileOffset.codec.isLossy()
+                      ? ", max " + LossyFilter::toString(fileOffset.codec.errorBoundKind) +
+                            " error = " + std::to_string(fileOffset.codec.maxError)
+                      : std::string())
+              << ")";
+  } else {
+    fs.write(data, binaryBuffer.size());
+  }
   fs.close();
 
+  registerFileOffset(std::move(fileOffset));
   updateMetaData();
 
   LOG(info) << "Successfully wrote field \"" << fieldID.name << "\" (id = " << fieldID.id << ") to "
@@ -353,9 +807,62 @@ FieldID BinaryArchive::write(const StorageView& storageView, const std::string&
   return fieldID;
 }
 
+std::mutex& BinaryArchive::fieldMutex(const std::string& field) {
+  std::lock_guard<std::mutex> lock(tableMutex_);
+  auto& mutex = fieldMutexes_[field];
+  if(!mutex)
+    mutex = std::make_unique<std::mutex>();
+  return *mutex;
+}
+
+std::shared_ptr<BlockStore> BinaryArchive::blockStore(const std::string& directory) const {
+  std::lock_guard<std::mutex> lock(blockStoreMutex_);
+  auto& store = blockStores_[directory];
+  if(!store) {
+    filesystem::path path(directory);
+    if(path.is_relative())
+      path = directory_ / path;
+    store = std::make_shared<BlockStore>(path.string());
+  }
+  return store;
+}
+
+std::unique_ptr<AsyncIO> BinaryArchive::acquireAsyncIO() const {
+  {
+    std::lock_guard<std::mutex> lock(asyncIOMutex_);
+    if(!asyncIO_.empty()) {
+      std::unique_ptr<AsyncIO> asyncIO = std::move(asyncIO_.back());
+      asyncIO_.pop_back();
+      return asyncIO;
+    }
+  }
+  return AsyncIO::create();
+}
+
+void BinaryArchive::releaseAsyncIO(std::unique_ptr<AsyncIO> asyncIO) const {
+  std::lock_guard<std::mutex> lock(asyncIOMutex_);
+  asyncIO_.push_back(std::move(asyncIO));
+}
+
+std::string BinaryArchive::asyncIOName() const {
+  std::unique_ptr<AsyncIO> asyncIO = acquireAsyncIO();
+  std::string name = asyncIO->name();
+  releaseAsyncIO(std::move(asyncIO));
+  return name;
+}
+
+BlockStore::Statistics BinaryArchive::blockStoreStatistics() const {
+  std::lock_guard<std::mutex> lock(blockStoreMutex_);
+  BlockStore::Statistics statistics;
+  for(const auto& store : blockStores_)
+    statistics += store.second->statistics();
+  return statistics;
+}
+
 void BinaryArchive::writeToFile(std::string filename, const StorageView& storageView) {
-  // Create binary data buffer
-  BinaryBuffer binaryBuffer(storageView);
+  // Create binary data buffer (there is nothing to reuse, hence the pool does not cache anything)
+  BufferPool pool(0);
+  BinaryBuffer binaryBuffer(pool, storageView);
   binaryBuffer.copyStorageViewToBuffer(storageView);
 
   // Write data to disk
@@ -377,19 +884,79 @@ void BinaryArchive::read(StorageView& storageView, const FieldID& fieldID,
   LOG(info) << "Attempting to read field \"" << fieldID.name << "\" (id = " << fieldID.id
             << ") via BinaryArchive ... ";
 
-  // Check if field exists
-  auto it = fieldTable_.find(fieldID.name);
-  if(it == fieldTable_.end())
-    throw Exception("no field '%s' registered in BinaryArchive", fieldID.name);
+  // Check if field exists and obtain the offset (and the references of delta-encoded data)
+  std::vector<FileOffsetType> chain;
+  std::shared_ptr<const DecodedField> cached;
+  bool isReference = false;
+  {
+    std::lock_guard<std::mutex> lock(tableMutex_);
+    auto it = fieldTable_.find(fieldID.name);
+    if(it == fieldTable_.end())
+      throw Exception("no field '%s' registered in BinaryArchive", fieldID.name);
+
+    const FieldOffsetTable& fieldOffsetTable = it->second;
+
+    // Check if id is valid
+    if(fieldID.id >= fieldOffsetTable.size())
+      throw Exception("invalid id '%i' of field '%s'", fieldID.id, fieldID.name);
+
+    chain = deltaChain(fieldOffsetTable, fieldID);
+
+    // Delta-encoded data is usually read in the order it was written, hence the most recently
+    // decoded id is likely the reference of the requested id
+    if(chain.front().codec.isEncoded()) {
+      auto cachedIt = decodedFields_.find(fieldID.name);
+      if(cachedIt != decodedFields_.end())
+        cached = cachedIt->second;
+      isReference = chain.size() > 1 || (fieldID.id + 1 < fieldOffsetTable.size() &&
+                                         fieldOffsetTable[fieldID.id + 1].codec.deltaReference ==
+                                             int(fieldID.id));
+    }
+  }
+  const FileOffsetType& fileOffset = chain.front();
+
+  // Uniform data is filled in without touching the data file
+  if(fileOffset.uniform.isUniform()) {
+    const UniformValue& uniform = fileOffset.uniform;
+    if(uniform.value.size() != std::size_t(storageView.bytesPerElement()) ||
+       uniform.dims != storageView.dims())
+      throw Exception("uniform field '%s' (id = %i) does not match the requested storage",
+                      fieldID.name, fieldID.id);
+
+    fillUniform(storageView, uniform.value.data());
+    LOG(info) << "Successfully read uniform field \"" << fieldID.name << "\" (id = " << fieldID.id
+              << ")";
+    return;
+  }
 
-  const FieldOffsetTable& fieldOffsetTable = it->second;
+  // Data in the block store does not use the data file
+  std::shared_ptr<BlockStore> store;
+  if(!fileOffset.blocks.empty())
+    store = blockStore(fileOffset.blockStore);
 
-  // Check if id is valid
-  if(fieldID.id >= fieldOffsetTable.size())
-    throw Exception("invalid id '%i' of field '%s'", fieldID.id, fieldID.name);
+  if(fileOffset.chunks.isChunked()) {
+    readChunked(storageView, fieldID, chain, cached.get(), isReference, store.get());
+    LOG(info) << "Successfully read field \"" << fieldID.name << "\" (id = " << fieldID.id << ")";
+    return;
+  }
+
+  // Large data which is stored as is is read in parallel segments
+  if(!store && !fileOffset.codec.isEncoded() &&
+     readSegments(storageView, fieldID, fileOffset.offset)) {
+    LOG(info) << "Successfully read field \"" << fieldID.name << "\" (id = " << fieldID.id << ")";
+    return;
+  }
 
   // Create binary data buffer
-  BinaryBuffer binaryBuffer(storageView);
+  BinaryBuffer binaryBuffer(bufferPool_, storageView);
+
+  if(store) {
+    readBlocks(*store, fileOffset.blocks, binaryBuffer.offset(),
+               binaryBuffer.offset() + binaryBuffer.size(), binaryBuffer.data(), fieldID);
+    binaryBuffer.copyBufferToStorageView(storageView);
+    LOG(info) << "Successfully read field \"" << fieldID.name << "\" (id = " << fieldID.id << ")";
+    return;
+  }
 
   // Open file & read into binary buffer
   std::string filename((directory_ / (prefix_ + "_" + fieldID.name + ".dat")).string());
@@ -398,12 +965,21 @@ void BinaryArchive::read(StorageView& storageView, const FieldID& fieldID,
   if(!fs.is_open())
     throw Exception("cannot open file: '%s'", filename);
 
-  // Set position in the stream
-  auto offset = fieldOffsetTable[fieldID.id].offset + binaryBuffer.offset();
-  fs.seekg(offset);
+  if(!fileOffset.codec.isEncoded()) {
+    // Set position in the stream
+    auto offset = fileOffset.offset + binaryBuffer.offset();
+    fs.seekg(offset);
 
-  // Read data into contiguous memory
-  fs.read(binaryBuffer.data(), binaryBuffer.size());
+    // Read data into contiguous memory
+    fs.read(binaryBuffer.data(), binaryBuffer.size());
+  } else {
+    readRange(fs, chain, binaryBuffer.offset(), binaryBuffer.offset() + binaryBuffer.size(),
+              binaryBuffer.data(), bufferPool_, numCodecThreads_, fieldID, cached.get(), nullptr);
+
+    // Keep the decoded data as reference of the next id (only complete reads are cached)
+    if(isReference && binaryBuffer.offset() == 0 && binaryBuffer.size() == fileOffset.codec.size)
+      cacheDecodedField(fieldID, binaryBuffer.data(), binaryBuffer.size());
+  }
   fs.close();
 
   binaryBuffer.copyBufferToStorageView(storageView);
@@ -411,14 +987,313 @@ void BinaryArchive::read(StorageView& storageView, const FieldID& fieldID,
   LOG(info) << "Successfully read field \"" << fieldID.name << "\" (id = " << fieldID.id << ")";
 }
 
+bool BinaryArchive::readSegments(StorageView& storageView, const FieldID& fieldID,
+                                 std::streamoff offset) const {
+  std::size_t numThreads = numSegmentReadThreads_
+                               ? numSegmentReadThreads_
+                               : std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+  if(numThreads <= 1)
+    return false;
+
+  // Size of the data to read (sliced data is read up to whole planes of the last dimension, see
+  // BinaryBuffer)
+  const Slice& slice = storageView.getSlice();
+  std::size_t size = storageView.bytesPerElement();
+  for(std::size_t i = 0; i < storageView.dims().size(); ++i) {
+    if(!slice.empty() && i == storageView.dims().size() - 1) {
+      const auto& triple = slice.sliceTriples().back();
+      size *= std::max(triple.stop - triple.start, 0);
+    } else
+      size *= storageView.dims()[i];
+  }
+  if(size < 2 * minReadSegmentSize_)
+    return false;
+
+  // Segments are aligned and at least of the minimum size, a few segments per thread allow to
+  // copy the first segments while the remaining ones are still being read
+  std::size_t numSegments = std::min(size / minReadSegmentSize_, 4 * numThreads);
+  std::size_t segmentSize = (size + numSegments - 1) / numSegments;
+  segmentSize = (segmentSize + ReadSegmentAlignment - 1) / ReadSegmentAlignment *
+                ReadSegmentAlignment;
+  numSegments = (size + segmentSize - 1) / segmentSize;
+
+  // Unsliced contiguous storages are read directly, otherwise the data is staged in a buffer
+  std::unique_ptr<BinaryBuffer> buffer;
+  Byte* data = storageView.originPtr();
+  if(!storageView.isMemCopyable()) {
+    buffer = std::make_unique<BinaryBuffer>(bufferPool_, storageView);
+    data = buffer->data();
+    offset += buffer->offset();
+  }
+
+  std::string filename((directory_ / (prefix_ + "_" + fieldID.name + ".dat")).string());
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if(fd < 0)
+    throw Exception("cannot open file: '%s'", filename);
+
+  LOG(info) << "Reading " << size << " bytes in " << numSegments << " segments with "
+            << std::min(numThreads, numSegments) << " threads";
+
+  try {
+    parallelFor(numSegments,
+                [&](std::size_t segment) {
+                  const std::size_t begin = segment * segmentSize;
+                  const std::size_t end = std::min(begin + segmentSize, size);
+
+                  for(std::size_t pos = begin; pos < end;) {
+                    ssize_t bytes = ::pread(fd, data + pos, end - pos, offset + pos);
+                    if(bytes < 0 && errno == EINTR)
+                      continue;
+                    if(bytes <= 0)
+                      throw Exception("cannot read field '%s' (id = %i) from '%s': %s",
+                                      fieldID.name, fieldID.id, filename,
+                                      bytes < 0 ? std::strerror(errno) : "unexpected end of file");
+                    pos += bytes;
+                  }
+
+                  if(buffer)
+                    buffer->copyBufferToStorageView(storageView, begin, end);
+                },
+                numThreads);
+  } catch(...) {
+    ::close(fd);
+    throw;
+  }
+  ::close(fd);
+  return true;
+}
+
+namespace {
+
+/// File descriptors of the data files of a batch (closed on destruction)
+class DataFiles {
+public:
+  ~DataFiles() {
+    for(const auto& file : files_)
+      ::close(file.second);
+  }
+
+  int open(const std::string& filename) {
+    auto it = files_.find(filename);
+    if(it != files_.end())
+      return it->second;
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if(fd < 0)
+      throw Exception("cannot open file: '%s'", filename);
+    files_.emplace(filename, fd);
+    return fd;
+  }
+
+private:
+  std::unordered_map<std::string, int> files_;
+};
+
+} // anonymous namespace
+
+void BinaryArchive::readBatch(std::vector<ReadRequest>& requests) const {
+  // Select the entries which are stored as is (all other entries, including invalid ones, are
+  // passed to `read`)
+  std::vector<ReadRequest*> batched, others;
+  std::vector<std::streamoff> offsets;
+  {
+    std::lock_guard<std::mutex> lock(tableMutex_);
+    for(ReadRequest& request : requests) {
+      auto it = fieldTable_.find(request.fieldID.name);
+      if(it == fieldTable_.end() || request.fieldID.id >= it->second.size()) {
+        others.push_back(&request);
+        continue;
+      }
+
+      const FileOffsetType& fileOffset = it->second[request.fieldID.id];
+      if(fileOffset.codec.isEncoded() || fileOffset.chunks.isChunked() ||
+         fileOffset.uniform.isUniform() || !fileOffset.blocks.empty()) {
+        others.push_back(&request);
+        continue;
+      }
+      batched.push_back(&request);
+      offsets.push_back(fileOffset.offset);
+    }
+  }
+
+  if(!batched.empty()) {
+    LOG(info) << "Reading " << batched.size() << " fields via BinaryArchive ... ";
+
+    DataFiles files;
+    std::vector<BinaryBuffer> buffers;
+    std::vector<AsyncIO::Request> ioRequests;
+    buffers.reserve(batched.size());
+    ioRequests.reserve(batched.size());
+
+    for(std::size_t i = 0; i < batched.size(); ++i) {
+      const ReadRequest& request = *batched[i];
+      buffers.emplace_back(bufferPool_, request.storageView);
+      BinaryBuffer& buffer = buffers.back();
+
+      int fd = files.open(
+          (directory_ / (prefix_ + "_" + request.fieldID.name + ".dat")).string());
+      ioRequests.push_back(AsyncIO::Request{AsyncIO::OpKind::Read, fd,
+                                            std::uint64_t(offsets[i] + buffer.offset()),
+                                            buffer.data(), buffer.size()});
+    }
+
+    // The backend is discarded if the batch fails
+    std::unique_ptr<AsyncIO> asyncIO = acquireAsyncIO();
+    asyncIO->submit(ioRequests);
+    releaseAsyncIO(std::move(asyncIO));
+
+    for(std::size_t i = 0; i < batched.size(); ++i)
+      buffers[i].copyBufferToStorageView(batched[i]->storageView);
+
+    LOG(info) << "Successfully read " << batched.size() << " fields";
+  }
+
+  for(ReadRequest* request : others)
+    read(request->storageView, request->fieldID, request->info);
+}
+
+void BinaryArchive::prefetch(const FieldID& fieldID,
+                             std::shared_ptr<FieldMetainfoImpl> info) const {
+  std::vector<FileOffsetType> chain;
+  {
+    std::lock_guard<std::mutex> lock(tableMutex_);
+    auto it = fieldTable_.find(fieldID.name);
+    if(it == fieldTable_.end())
+      throw Exception("no field '%s' registered in BinaryArchive", fieldID.name);
+
+    if(fieldID.id >= it->second.size())
+      throw Exception("invalid id '%i' of field '%s'", fieldID.id, fieldID.name);
+
+    chain = deltaChain(it->second, fieldID);
+  }
+
+  // Size of data which is stored as is (the whole remaining file if the size is unknown)
+  std::uint64_t size = 0;
+  if(info) {
+    size = TypeUtil::sizeOf(info->type());
+    for(int dim : info->dims())
+      size *= dim;
+  }
+
+  const std::string filename((directory_ / (prefix_ + "_" + fieldID.name + ".dat")).string());
+  for(const FileOffsetType& fileOffset : chain) {
+    if(fileOffset.uniform.isUniform())
+      continue;
+
+    if(!fileOffset.blocks.empty()) {
+      std::shared_ptr<BlockStore> store = blockStore(fileOffset.blockStore);
+      for(const BlockReference& block : fileOffset.blocks)
+        store->prefetch(block);
+      continue;
+    }
+
+    adviseWillNeed(filename, fileOffset.offset,
+                   fileOffset.codec.isEncoded() ? fileOffset.codec.compressedSize() : size);
+  }
+}
+
+void BinaryArchive::readChunked(StorageView& storageView, const FieldID& fieldID,
+                                const std::vector<FileOffsetType>& chain,
+                                const DecodedField* cached, bool isReference,
+                                const BlockStore* store) const {
+  const ChunkIndex& chunks = chain.front().chunks;
+  const ChunkLayout layout(storageView.dims(), chunks.shape, storageView.bytesPerElement());
+  if(layout.index().offsets != chunks.offsets)
+    throw Exception("chunk index of field '%s' (id = %i) does not match the requested storage",
+                    fieldID.name, fieldID.id);
+
+  std::string filename((directory_ / (prefix_ + "_" + fieldID.name + ".dat")).string());
+
+  // Complete reads load all chunks at once
+  const Slice& slice = storageView.getSlice();
+  auto openDataFile = [&](std::ifstream& fs) {
+    if(store)
+      return;
+    fs.open(filename, std::ios::binary);
+    if(!fs.is_open())
+      throw Exception("cannot open file: '%s'", filename);
+  };
+
+  if(slice.empty()) {
+    std::ifstream fs;
+    openDataFile(fs);
+
+    BufferPool::Buffer chunked = bufferPool_.acquire(layout.size());
+    readRange(fs, chain, 0, layout.size(), chunked.data(), bufferPool_, numCodecThreads_, fieldID,
+              cached, store);
+    if(isReference)
+      cacheDecodedField(fieldID, chunked.data(), chunked.size());
+
+    BinaryBuffer binaryBuffer(bufferPool_, storageView);
+    layout.fromChunks(chunked.data(), binaryBuffer.data());
+    binaryBuffer.copyBufferToStorageView(storageView);
+    return;
+  }
+
+  // Sliced reads load the chunks intersecting the bounding box of the slice
+  const auto& triples = slice.sliceTriples();
+  std::vector<int> lower(triples.size()), upper(triples.size());
+  std::size_t boxSize = storageView.bytesPerElement();
+  for(std::size_t i = 0; i < triples.size(); ++i) {
+    lower[i] = triples[i].start;
+    upper[i] = std::max(triples[i].stop, triples[i].start);
+    boxSize *= upper[i] - lower[i];
+  }
+
+  const std::vector<std::size_t> intersecting = layout.intersectingChunks(lower, upper);
+  BufferPool::Buffer box = bufferPool_.acquire(boxSize);
+
+  // Large reads are distributed over several threads (each with its own stream)
+  std::uint64_t bytes = 0;
+  for(std::size_t chunk : intersecting)
+    bytes += layout.chunkSize(chunk);
+  std::size_t numThreads = 1;
+  if(bytes >= ParallelChunkReadThreshold)
+    numThreads = numChunkReadThreads_ ? numChunkReadThreads_
+                                      : std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+  numThreads = std::min(numThreads, intersecting.size());
+
+  // Don't multiply the chunk threads by the codec threads
+  const std::size_t codecThreads = numThreads > 1 ? 1 : numCodecThreads_;
+
+  parallelFor(numThreads,
+              [&](std::size_t thread) {
+                std::ifstream fs;
+                openDataFile(fs);
+
+                for(std::size_t i = thread; i < intersecting.size(); i += numThreads) {
+                  const std::size_t chunk = intersecting[i];
+                  const std::uint64_t begin = layout.chunkOffset(chunk);
+                  BufferPool::Buffer chunkData = bufferPool_.acquire(layout.chunkSize(chunk));
+                  readRange(fs, chain, begin, begin + layout.chunkSize(chunk), chunkData.data(),
+                            bufferPool_, codecThreads, fieldID, cached, store);
+                  layout.copyChunkToBox(chunk, chunkData.data(), lower, upper, box.data());
+                }
+              },
+              numThreads);
+
+  ChunkLayout::copyBoxToStorageView(box.data(), lower, upper, storageView);
+}
+
+void BinaryArchive::cacheDecodedField(const FieldID& fieldID, const Byte* data,
+                                      std::size_t size) const {
+  auto decoded = std::make_shared<DecodedField>();
+  decoded->id = fieldID.id;
+  decoded->data.assign(data, data + size);
+
+  std::lock_guard<std::mutex> lock(tableMutex_);
+  decodedFields_[fieldID.name] = std::move(decoded);
+}
+
 void BinaryArchive::readFromFile(std::string filename, StorageView& storageView) {
   filesystem::path filepath(filename);
 
   if(!filesystem::exists(filepath))
     throw Exception("cannot open %s: file does not exist", filepath);
 
-  // Create binary data buffer
-  BinaryBuffer binaryBuffer(storageView);
+  // Create binary data buffer (there is nothing to reuse, hence the pool does not cache anything)
+  BufferPool pool(0);
+  BinaryBuffer binaryBuffer(pool, storageView);
 
   std::ifstream fs(filepath.string(), std::ios::in | std::ios::binary);
 
@@ -438,10 +1313,29 @@ std::ostream& BinaryArchive::toStream(std::ostream& stream) const {
   stream << "  mode: " << mode_ << "\n";
   stream << "  prefix: " << prefix_ << "\n";
   stream << "  fieldsTable = {\n";
+
+  std::lock_guard<std::mutex> lock(tableMutex_);
   for(auto it = fieldTable_.begin(), end = fieldTable_.end(); it != end; ++it) {
     stream << "    " << it->first << " = {\n";
-    for(std::size_t id = 0; id < it->second.size(); ++id)
-      stream << "      [ " << it->second[id].offset << ", " << it->second[id].checksum << " ]\n";
+    for(std::size_t id = 0; id < it->second.size(); ++id) {
+      const CodecInfo& codec = it->second[id].codec;
+      stream << "      [ " << it->second[id].offset << ", " << it->second[id].checksum;
+      if(codec.isEncoded())
+        stream << ", " << codec.codec << " (ratio = " << codec.ratio() << ")";
+      if(codec.isLossy())
+        stream << ", max " << LossyFilter::toString(codec.errorBoundKind)
+               << " error = " << codec.maxError;
+      if(codec.isDelta())
+        stream << ", delta of " << codec.deltaReference;
+      if(it->second[id].uniform.isUniform())
+        stream << ", uniform";
+      if(!it->second[id].blocks.empty())
+        stream << ", " << it->second[id].blocks.size() << " blocks in "
+               << it->second[id].blockStore;
+      if(it->second[id].chunks.isChunked())
+        stream << ", " << it->second[id].chunks.offsets.size() << " chunks";
+      stream << " ]\n";
+    }
     stream << "    }\n";
   }
   stream << "  }\n";
@@ -460,11 +1354,16 @@ void BinaryArchive::clear() {
         LOG(warning) << "BinaryArchive: cannot remove file " << it->path();
     }
   }
+
+  // The snapshot of the field table would be stale anyway
+  std::remove(metaDataSnapshotFile().string().c_str());
   clearFieldTable();
 }
 
 void BinaryArchive::clearFieldTable() {
   fieldTable_.clear();
+  deltaReferences_.clear();
+  decodedFields_.clear();
   json_.clear();
 }
 
@@ -19,7 +19,16 @@
 #include "serialbox/core/Filesystem.h"
 #include "serialbox/core/Json.h"
 #include "serialbox/core/archive/Archive.h"
+#include "serialbox/core/archive/AsyncIO.h"
+#include "serialbox/core/archive/BlockStore.h"
+#include "serialbox/core/archive/BufferPool.h"
+#include "serialbox/core/archive/ChunkLayout.h"
+#include "serialbox/core/compression/CodecPipeline.h"
 #include "serialbox/core/hash/Hash.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -28,6 +37,22 @@ namespace serialbox {
 
 /// \brief Non-portable binary archive
 ///
+/// Fields can be compressed by setting the field meta-information `__codec` (see CodecPipeline).
+/// The encoding is recorded for each stored entry, hence fields can be stored with different
+/// codecs at different savepoints and archives can be read independently of the meta-information.
+///
+/// Setting `__chunk_shape` stores the field in fixed-size n-dimensional chunks (see ChunkLayout).
+/// Sliced reads of chunked fields only load the chunks intersecting the slice.
+///
+/// Uniform data (e.g all-zero fields) is not written to the data files, only the value and the
+/// dimensions are recorded in the meta-data. Identical constants are deduplicated.
+///
+/// Large data which is stored as is can be read in several aligned segments which are read
+/// concurrently (opt-in, see BinaryArchive::setNumSegmentReadThreads).
+///
+/// Setting `__block_store` stores the data in a content-addressed BlockStore which can be shared
+/// by several archives, blocks which are already present are not written again.
+///
 /// \ingroup core
 class BinaryArchive : public Archive {
 public:
@@ -35,19 +60,48 @@ public:
   static const std::string Name;
 
   /// \brief Revision of the binary archive
+  ///
+  /// The meta-data is tagged with the lowest revision supporting all entries of the archive,
+  /// archives without encoded, chunked, uniform or block store entries are tagged with revision 0.
   static const int Version;
 
+  /// \brief Value of data whose elements are all identical
+  struct UniformValue {
+    std::vector<Byte> value; ///< Bytes of one element (empty if the data is not uniform)
+    std::vector<int> dims;   ///< Dimensions of the data
+
+    /// \brief Check if the data is uniform
+    bool isUniform() const noexcept { return !value.empty(); }
+  };
+
   /// \brief Offset within a file
   struct FileOffsetType {
     std::streamoff offset; ///< Binary offset within the file
-    std::string checksum;  ///< Checksum of the field
+    std::string checksum;  ///< Checksum of the field (of the uncompressed data)
+    CodecInfo codec;       ///< Encoding of the data (empty codec if the data is stored as is)
+    ChunkIndex chunks;     ///< Chunk index (empty if the data is stored contiguously)
+    UniformValue uniform;  ///< Value of uniform data (which is not stored in the file)
+    std::string blockStore;            ///< Directory of the block store (as configured)
+    std::vector<BlockReference> blocks; ///< Blocks of the data (empty if stored in the file)
   };
 
   /// \brief Table of ids and corresponding offsets whithin in each field (i.e file)
   using FieldOffsetTable = std::vector<FileOffsetType>;
 
   /// \brief Table of all fields owned by this archive, each field has a corresponding file
-  using FieldTable = std::unordered_map<std::string, FieldOffsetTable>;
+  using FieldTable = std::unordered_map<InternedString, FieldOffsetTable>;
+
+  /// \brief Default minimum size in bytes of the segments of parallel reads
+  static const std::size_t DefaultMinReadSegmentSize;
+
+  /// \brief Alignment in bytes of the segments of parallel reads
+  static const std::size_t ReadSegmentAlignment;
+
+  /// \brief Decoded data of an id of a field (used as reference of delta-encoded data)
+  struct DecodedField {
+    int id = -1;            ///< Id of the data (-1 if empty)
+    std::vector<Byte> data; ///< Uncompressed data
+  };
 
   /// \brief
   BinaryArchive();
@@ -80,17 +134,33 @@ public:
   void readMetaDataFromJson();
 
   /// \brief Convert meta-data to JSON and serialize to file
+  ///
+  /// The function is thread-safe, if several threads update the meta-data concurrently only the
+  /// most recent snapshot is written to disk.
   void writeMetaDataToJson();
 
   /// \name Archive implementation
   /// \see Archive
   /// @{
+  using Archive::write;
+
   virtual FieldID write(const StorageView& storageView, const std::string& fieldID,
                         const std::shared_ptr<FieldMetainfoImpl> info) override;
 
   virtual void read(StorageView& storageView, const FieldID& fieldID,
                     std::shared_ptr<FieldMetainfoImpl> info) const override;
 
+  /// \brief Read a batch of fields with a single batch of I/O requests
+  ///
+  /// The data of all fields which are stored as is (i.e neither encoded, chunked, uniform nor in a
+  /// block store) is read at once via AsyncIO (e.g io_uring), the remaining fields are read one
+  /// after another.
+  virtual void readBatch(std::vector<ReadRequest>& requests) const override;
+
+  /// \brief Advise the kernel to read the data of the field into the page cache
+  virtual void prefetch(const FieldID& fieldID,
+                        std::shared_ptr<FieldMetainfoImpl> info) const override;
+
   virtual void updateMetaData() override;
 
   virtual OpenModeKind mode() const override { return mode_; }
@@ -109,7 +179,12 @@ public:
 
   virtual bool isReadingThreadSafe() const override { return true; }
 
-  virtual bool isWritingThreadSafe() const override { return false; }
+  /// \brief Concurrent writes are thread-safe
+  ///
+  /// Each field is protected by its own lock (serializing writes to the same data file) while the
+  /// field table is only locked to register the offset of newly written data. Note that
+  /// `clear()` must not be called concurrently to any write.
+  virtual bool isWritingThreadSafe() const override { return true; }
 
   virtual bool isSlicedReadingSupported() const override { return true; }
 
@@ -126,6 +201,12 @@ public:
   FieldTable& fieldTable() noexcept { return fieldTable_; }
   const FieldTable& fieldTable() const noexcept { return fieldTable_; }
 
+  /// \brief Get the path of the binary snapshot of the field table (`ArchiveMetaData-prefix.bin`)
+  ///
+  /// The snapshot is written by the first read-only opening if the directory is writable and
+  /// loaded instead of the JSON file as long as it is up to date (see MetaDataSnapshot).
+  filesystem::path metaDataSnapshotFile() const;
+
   /// \brief Directly write field (given by `storageView`) to file
   ///
   /// \param filename     Newly created file (if file already exists, it's contents will be
@@ -147,7 +228,92 @@ public:
   /// \brief Get the hash algorithm
   const std::unique_ptr<Hash>& hash() const noexcept { return hash_; }
 
+  /// \brief Get the pool of staging buffers used for reading and writing
+  ///
+  /// The pool can be used to configure the high-water mark of cached memory (see
+  /// BufferPool::setHighWaterMark) or the use of huge pages.
+  BufferPool& bufferPool() const noexcept { return bufferPool_; }
+
+  /// \brief Set the number of threads used to encode and decode the blocks of a field
+  ///
+  /// A value of 0 uses all hardware threads, 1 processes the blocks in the calling thread
+  /// (default). See CodecPipeline::setNumThreads.
+  void setNumCodecThreads(std::size_t numThreads) noexcept { numCodecThreads_ = numThreads; }
+
+  /// \brief Get the number of threads used to encode and decode the blocks of a field
+  std::size_t numCodecThreads() const noexcept { return numCodecThreads_; }
+
+  /// \brief Set the number of threads used to read the chunks of large sliced reads
+  ///
+  /// A value of 0 uses all hardware threads, 1 disables parallel reads (default). The blocks of
+  /// encoded chunks are decoded by the reading thread, i.e the codec threads are not used.
+  void setNumChunkReadThreads(std::size_t numThreads) noexcept {
+    numChunkReadThreads_ = numThreads;
+  }
+
+  /// \brief Get the number of threads used to read the chunks of large sliced reads
+  std::size_t numChunkReadThreads() const noexcept { return numChunkReadThreads_; }
+
+  /// \brief Set the number of threads used to read large contiguous data in parallel segments
+  ///
+  /// Data which is stored as is (i.e not encoded, chunked, uniform nor in a block store) and spans
+  /// at least two segments of the minimum segment size is split into aligned segments. The
+  /// segments are read concurrently via `pread` and each segment is copied into the storage as
+  /// soon as it arrives (unsliced contiguous storages are read directly). A value of 0 uses all
+  /// hardware threads, 1 disables parallel reads (default).
+  ///
+  /// The threads are started by each read, hence the mode is meant for reading a few large fields
+  /// from a single thread and should not be combined with prefetching or concurrent reads.
+  void setNumSegmentReadThreads(std::size_t numThreads) noexcept {
+    numSegmentReadThreads_ = numThreads;
+  }
+
+  /// \brief Get the number of threads used to read large contiguous data in parallel segments
+  std::size_t numSegmentReadThreads() const noexcept { return numSegmentReadThreads_; }
+
+  /// \brief Set the minimum size in bytes of the segments of parallel reads
+  void setMinReadSegmentSize(std::size_t size) noexcept {
+    minReadSegmentSize_ = std::max(size, ReadSegmentAlignment);
+  }
+
+  /// \brief Get the minimum size in bytes of the segments of parallel reads
+  std::size_t minReadSegmentSize() const noexcept { return minReadSegmentSize_; }
+
+  /// \brief Get the name of the backend of batched reads (e.g `io_uring` or `threads`)
+  std::string asyncIOName() const;
+
+  /// \brief Get the deduplication statistics of all block stores used by this archive
+  ///
+  /// Only the blocks referenced by this archive instance (since it was opened) are accounted.
+  BlockStore::Statistics blockStoreStatistics() const;
+
 private:
+  /// \brief Get the lock associated with `field` (the lock is created if necessary)
+  std::mutex& fieldMutex(const std::string& field);
+
+  /// \brief Read the chunked entry (given by its delta `chain`) into the (sliced) `storageView`
+  void readChunked(StorageView& storageView, const FieldID& fieldID,
+                   const std::vector<FileOffsetType>& chain, const DecodedField* cached,
+                   bool isReference, const BlockStore* store) const;
+
+  /// \brief Read the data at `offset` of the data file into `storageView` in parallel segments
+  ///
+  /// \return False iff the data is too small to be split (nothing is read)
+  bool readSegments(StorageView& storageView, const FieldID& fieldID,
+                    std::streamoff offset) const;
+
+  /// \brief Get the block store in `directory` (relative to the archive directory)
+  std::shared_ptr<BlockStore> blockStore(const std::string& directory) const;
+
+  /// \brief Take a backend of batched I/O from the pool (a new backend is created if necessary)
+  std::unique_ptr<AsyncIO> acquireAsyncIO() const;
+
+  /// \brief Return the backend `asyncIO` to the pool
+  void releaseAsyncIO(std::unique_ptr<AsyncIO> asyncIO) const;
+
+  /// \brief Keep the decoded data of `fieldID` as reference of the next id
+  void cacheDecodedField(const FieldID& fieldID, const Byte* data, std::size_t size) const;
+
   OpenModeKind mode_;
   filesystem::path directory_;
   std::string prefix_;
@@ -156,6 +322,46 @@ private:
   std::unique_ptr<Hash> hash_;
   json::json json_;
   FieldTable fieldTable_;
+
+  // Staging buffers are reused across calls to read and write
+  mutable BufferPool bufferPool_;
+
+  // Threads used to encode and decode the blocks of a field (0 = all hardware threads)
+  std::size_t numCodecThreads_ = 1;
+
+  // Threads used for large sliced reads of chunked fields (0 = all hardware threads)
+  std::size_t numChunkReadThreads_ = 1;
+
+  // Parallel reads of large contiguous data (0 = all hardware threads)
+  std::size_t numSegmentReadThreads_ = 1;
+  std::size_t minReadSegmentSize_ = DefaultMinReadSegmentSize;
+
+  // Guards the structure of `fieldTable_`, `fieldMutexes_` and `json_`
+  mutable std::mutex tableMutex_;
+
+  // Per-field locks serializing writes to the same data file
+  std::unordered_map<std::string, std::unique_ptr<std::mutex>> fieldMutexes_;
+
+  // References of delta-encoded fields (entries are created under `tableMutex_` and only accessed
+  // by the writer of the field)
+  std::unordered_map<std::string, DecodedField> deltaReferences_;
+
+  // Most recently read id of delta-encoded fields (guarded by `tableMutex_`)
+  mutable std::unordered_map<InternedString, std::shared_ptr<const DecodedField>> decodedFields_;
+
+  // Serializes writing of the meta-data file (only newer snapshots are written)
+  std::mutex metaDataFileMutex_;
+  std::uint64_t metaDataRevision_ = 0;
+  std::uint64_t metaDataRevisionOnDisk_ = 0;
+
+  // Block stores by configured directory (guarded by `blockStoreMutex_`)
+  mutable std::mutex blockStoreMutex_;
+  mutable std::unordered_map<std::string, std::shared_ptr<BlockStore>> blockStores_;
+
+  // Idle backends of batched I/O, each thread issuing a batch uses its own backend (guarded by
+  // `asyncIOMutex_`)
+  mutable std::mutex asyncIOMutex_;
+  mutable std::vector<std::unique_ptr<AsyncIO>> asyncIO_;
 };
 
 } // namespace serialbox
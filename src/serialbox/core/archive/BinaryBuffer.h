@@ -0,0 +1,219 @@
+//===-- serialbox/core/archive/BinaryBuffer.h ---------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the contiguous staging buffer of the binary archives.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_ARCHIVE_BINARYBUFFER_H
+#define SERIALBOX_CORE_ARCHIVE_BINARYBUFFER_H
+
+#include "serialbox/core/StorageView.h"
+#include "serialbox/core/archive/BufferPool.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace serialbox {
+
+/// \brief Contiguous buffer with support for sliced loading
+///
+/// The memory is acquired from a BufferPool and is *not* initialized.
+class BinaryBuffer {
+public:
+  /// \brief Allocate the buffer
+  BinaryBuffer(BufferPool& pool, const StorageView& storageView) {
+    const auto& slice = storageView.getSlice();
+
+    if(slice.empty()) {
+      buffer_ = pool.acquire(storageView.sizeInBytes());
+      offset_ = 0;
+    } else {
+      const auto& dims = storageView.dims();
+      const auto& triple = slice.sliceTriples().back();
+      const int bytesPerElement = storageView.bytesPerElement();
+
+      // Allocate a buffer which can be efficently loaded. The buffer will treat the
+      // dimensions dim_{1}, ..., dim_{N-1} as full while last the dimension dim_{N} as sliced but
+      // without incorporating the step. This is necessary as we only want to call ::write once.
+
+      // Compute dimensions
+      dims_ = dims;
+      dims_.back() = triple.stop - triple.start;
+
+      // Compute strides (col-major)
+      strides_.resize(dims_.size());
+
+      int stride = 1;
+      strides_[0] = stride;
+
+      for(int i = 1; i < dims_.size(); ++i) {
+        stride *= dims_[i - 1];
+        strides_[i] = stride;
+      }
+
+      // Compute size
+      std::size_t size = 1;
+      for(std::size_t i = 0; i < dims_.size(); ++i)
+        size *= (dims_[i] == 0 ? 1 : dims_[i]);
+
+      // Compute initial offset in bytes
+      offset_ = (strides_.back() * triple.start) * bytesPerElement;
+
+      buffer_ = pool.acquire(size * bytesPerElement);
+    }
+  }
+
+  /// \brief Copy data from buffer to `storageView` while handling slicing
+  void copyBufferToStorageView(StorageView& storageView) {
+    const auto& slice = storageView.getSlice();
+
+    if(slice.empty()) {
+      Byte* dataPtr = buffer_.data();
+      const int bytesPerElement = storageView.bytesPerElement();
+
+      if(storageView.isMemCopyable()) {
+        std::memcpy(storageView.originPtr(), dataPtr, buffer_.size());
+      } else {
+        for(auto it = storageView.begin(), end = storageView.end(); it != end;
+            ++it, dataPtr += bytesPerElement)
+          std::memcpy(it.ptr(), dataPtr, bytesPerElement);
+      }
+
+    } else {
+      const int numDims = dims_.size();
+      const auto& triples = slice.sliceTriples();
+      const int bytesPerElement = storageView.bytesPerElement();
+      Byte* dataPtr = buffer_.data();
+
+      // Compute intial indices in the buffer
+      std::vector<int> index(numDims);
+      for(int i = 0; i < numDims - 1; ++i)
+        index[i] = triples[i].start;
+      index.back() = 0;
+
+      // Iterate over the the storageView and the Buffer
+      Byte* curPtr = buffer_.data();
+      for(auto it = storageView.begin(), end = storageView.end(); it != end; ++it) {
+
+        // Compute position of current element
+        int pos = 0;
+        for(int i = 0; i < numDims; ++i)
+          pos += bytesPerElement * (strides_[i] * index[i]);
+        curPtr = dataPtr + pos;
+
+        // Memcopy the current elemment to the storageView
+        std::memcpy(it.ptr(), curPtr, bytesPerElement);
+
+        // Compute the index of the next element in the buffer
+        for(int i = 0; i < numDims; ++i)
+          if((index[i] += triples[i].step) < triples[i].stop)
+            break;
+          else
+            index[i] = triples[i].start;
+      }
+    }
+  }
+
+  /// \brief Copy the bytes [`begin`, `end`) of the buffer to `storageView` while handling slicing
+  ///
+  /// The bounds have to be multiples of the element size. Copying the ranges of a partition of the
+  /// buffer is equivalent to copying the whole buffer, hence the ranges can be copied
+  /// concurrently.
+  void copyBufferToStorageView(StorageView& storageView, std::size_t begin, std::size_t end) {
+    const auto& slice = storageView.getSlice();
+    const int bytesPerElement = storageView.bytesPerElement();
+
+    if(slice.empty() && storageView.isMemCopyable()) {
+      std::memcpy(storageView.originPtr() + begin, buffer_.data() + begin, end - begin);
+      return;
+    }
+
+    // The buffer covers the whole storage (or all but the last dimension of the slice)
+    const std::vector<int>& dims = slice.empty() ? storageView.dims() : dims_;
+    const std::vector<int>& strides = storageView.strides();
+    const int numDims = dims.size();
+    const int lastStart = slice.empty() ? 0 : slice.sliceTriples().back().start;
+
+    // Compute the index of the first element within the buffer
+    std::vector<int> index(numDims);
+    std::size_t element = begin / bytesPerElement;
+    for(int i = 0; i < numDims; ++i) {
+      const int dim = std::max(dims[i], 1);
+      index[i] = element % dim;
+      element /= dim;
+    }
+
+    for(std::size_t pos = begin; pos < end; pos += bytesPerElement) {
+      // Compute the position of the current element in the storage (skipping elements which are
+      // not part of the slice)
+      bool inSlice = true;
+      std::ptrdiff_t storagePos = 0;
+      for(int i = 0; i < numDims; ++i) {
+        const int idx = index[i] + (i == numDims - 1 ? lastStart : 0);
+        if(!slice.empty()) {
+          const auto& triple = slice.sliceTriples()[i];
+          if(idx < triple.start || idx >= triple.stop || (idx - triple.start) % triple.step) {
+            inSlice = false;
+            break;
+          }
+        }
+        storagePos += std::ptrdiff_t(strides[i]) * idx;
+      }
+
+      if(inSlice)
+        std::memcpy(storageView.originPtr() + storagePos * bytesPerElement,
+                    buffer_.data() + pos, bytesPerElement);
+
+      // Compute the index of the next element in the buffer
+      for(int i = 0; i < numDims; ++i)
+        if(++index[i] < dims[i])
+          break;
+        else
+          index[i] = 0;
+    }
+  }
+
+  /// \brief Copy data from `storageView` to buffer
+  void copyStorageViewToBuffer(const StorageView& storageView) {
+    Byte* dataPtr = buffer_.data();
+    const int bytesPerElement = storageView.bytesPerElement();
+
+    if(storageView.isMemCopyable()) {
+      std::memcpy(dataPtr, storageView.originPtr(), buffer_.size());
+    } else {
+      for(auto it = storageView.begin(), end = storageView.end(); it != end;
+          ++it, dataPtr += bytesPerElement)
+        std::memcpy(dataPtr, it.ptr(), bytesPerElement);
+    }
+  }
+
+  /// \brief Get Buffer size
+  std::size_t size() const noexcept { return buffer_.size(); }
+
+  /// \brief Get pointer to the beginning of the buffer
+  Byte* data() noexcept { return buffer_.data(); }
+  const Byte* data() const noexcept { return buffer_.data(); }
+
+  /// \brief Get initial offset of the data on disk in bytes
+  std::size_t offset() const noexcept { return offset_; }
+
+private:
+  BufferPool::Buffer buffer_;
+
+  std::vector<int> strides_;
+  std::vector<int> dims_;
+  std::size_t offset_;
+};
+
+} // namespace serialbox
+
+#endif
@@ -0,0 +1,330 @@
+//===-- serialbox/core/archive/BlockStore.cpp ---------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the content-addressed block store of the binary archive.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/archive/BlockStore.h"
+#include "serialbox/core/Exception.h"
+#include "serialbox/core/archive/Readahead.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+
+namespace serialbox {
+
+const char* BlockStore::BlockStoreKey = "__block_store";
+const char* BlockStore::ChunkingKey = "__block_store_chunking";
+const char* BlockStore::BlockSizeKey = "__block_store_block_size";
+const char* BlockStore::DefaultDirectory = "blocks";
+const std::size_t BlockStore::DefaultBlockSize = 256 << 10;
+
+namespace {
+
+inline std::uint64_t rotl64(std::uint64_t x, int r) noexcept { return (x << r) | (x >> (64 - r)); }
+
+inline std::uint64_t fmix64(std::uint64_t k) noexcept {
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdULL;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53ULL;
+  k ^= k >> 33;
+  return k;
+}
+
+/// MurmurHash3 (x64, 128 bit)
+void murmurHash3(const Byte* data, std::size_t size, std::uint64_t& h1,
+                 std::uint64_t& h2) noexcept {
+  const std::uint64_t c1 = 0x87c37b91114253d5ULL;
+  const std::uint64_t c2 = 0x4cf5ad432745937fULL;
+  h1 = h2 = 0;
+
+  const std::size_t numBlocks = size / 16;
+  for(std::size_t i = 0; i < numBlocks; ++i) {
+    std::uint64_t k1, k2;
+    std::memcpy(&k1, data + 16 * i, 8);
+    std::memcpy(&k2, data + 16 * i + 8, 8);
+
+    k1 *= c1;
+    k1 = rotl64(k1, 31);
+    k1 *= c2;
+    h1 ^= k1;
+    h1 = rotl64(h1, 27);
+    h1 += h2;
+    h1 = h1 * 5 + 0x52dce729;
+
+    k2 *= c2;
+    k2 = rotl64(k2, 33);
+    k2 *= c1;
+    h2 ^= k2;
+    h2 = rotl64(h2, 31);
+    h2 += h1;
+    h2 = h2 * 5 + 0x38495ab5;
+  }
+
+  // Tail
+  const unsigned char* tail = reinterpret_cast<const unsigned char*>(data + 16 * numBlocks);
+  const std::size_t rest = size & 15;
+  std::uint64_t k1 = 0, k2 = 0;
+  for(std::size_t i = rest; i-- > 8;)
+    k2 ^= std::uint64_t(tail[i]) << (8 * (i - 8));
+  for(std::size_t i = std::min<std::size_t>(rest, 8); i-- > 0;)
+    k1 ^= std::uint64_t(tail[i]) << (8 * i);
+
+  if(rest > 8) {
+    k2 *= c2;
+    k2 = rotl64(k2, 33);
+    k2 *= c1;
+    h2 ^= k2;
+  }
+  if(rest > 0) {
+    k1 *= c1;
+    k1 = rotl64(k1, 31);
+    k1 *= c2;
+    h1 ^= k1;
+  }
+
+  h1 ^= size;
+  h2 ^= size;
+  h1 += h2;
+  h2 += h1;
+  h1 = fmix64(h1);
+  h2 = fmix64(h2);
+  h1 += h2;
+  h2 += h1;
+}
+
+/// Random table of the gear rolling hash (generated with splitmix64)
+struct GearTable {
+  std::uint64_t values[256];
+
+  GearTable() noexcept {
+    std::uint64_t state = 0x9e3779b97f4a7c15ULL;
+    for(auto& value : values) {
+      std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      value = z ^ (z >> 31);
+    }
+  }
+};
+
+const GearTable gearTable;
+
+/// Counter of temporary files (unique within the process)
+std::atomic<std::uint64_t> temporaryCounter(0);
+
+} // anonymous namespace
+
+BlockStore::Statistics& BlockStore::Statistics::operator+=(const Statistics& other) noexcept {
+  referencedBlocks += other.referencedBlocks;
+  referencedBytes += other.referencedBytes;
+  storedBlocks += other.storedBlocks;
+  storedBytes += other.storedBytes;
+  return *this;
+}
+
+BlockStore::BlockStore(const std::string& directory) : directory_(directory) {
+  if(!filesystem::exists(directory_))
+    filesystem::create_directories(directory_);
+}
+
+BlockStore::Configuration BlockStore::configuration(const FieldMetainfoImpl* info) {
+  Configuration config;
+  if(!info || !info->metaInfo().hasKey(BlockStoreKey))
+    return config;
+
+  const MetainfoMapImpl& metaInfo = info->metaInfo();
+  const MetainfoValueImpl& value = metaInfo.at(BlockStoreKey);
+  if(value.type() == TypeID::String)
+    config.directory = value.as<std::string>();
+  else if(value.as<bool>())
+    config.directory = DefaultDirectory;
+
+  if(metaInfo.hasKey(ChunkingKey))
+    config.chunking = fromString(metaInfo.as<std::string>(ChunkingKey));
+
+  if(metaInfo.hasKey(BlockSizeKey)) {
+    int blockSize = metaInfo.as<int>(BlockSizeKey);
+    if(blockSize <= 0)
+      throw Exception("invalid block size of block store: %i", blockSize);
+    config.blockSize = blockSize;
+  }
+  return config;
+}
+
+std::string BlockStore::digest(const Byte* data, std::size_t size) noexcept {
+  std::uint64_t h1, h2;
+  murmurHash3(data, size, h1, h2);
+
+  static const char* digits = "0123456789abcdef";
+  std::string hex(32, '0');
+  for(int i = 0; i < 16; ++i) {
+    hex[15 - i] = digits[(h1 >> (4 * i)) & 0xf];
+    hex[31 - i] = digits[(h2 >> (4 * i)) & 0xf];
+  }
+  return hex;
+}
+
+std::vector<std::size_t> BlockStore::split(const Byte* data, std::size_t size,
+                                           ChunkingKind chunking, std::size_t blockSize) {
+  std::vector<std::size_t> sizes;
+
+  if(chunking == ChunkingKind::Fixed) {
+    for(std::size_t pos = 0; pos < size; pos += blockSize)
+      sizes.push_back(std::min(blockSize, size - pos));
+    return sizes;
+  }
+
+  // Content-defined chunking: a block ends where the low bits of the gear hash are zero. The
+  // block size is bounded to [blockSize / 4, 4 * blockSize] and averages about `blockSize`.
+  const std::size_t minSize = std::max<std::size_t>(blockSize / 4, 1);
+  const std::size_t maxSize = 4 * blockSize;
+  std::uint64_t mask = 1;
+  while(mask < blockSize - minSize + 1)
+    mask <<= 1;
+  mask = (mask >> 1) - 1;
+
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+  for(std::size_t pos = 0; pos < size;) {
+    const std::size_t end = std::min(pos + maxSize, size);
+    std::size_t cut = end;
+
+    std::uint64_t hash = 0;
+    for(std::size_t i = pos + std::min(minSize, end - pos); i < end; ++i) {
+      hash = (hash << 1) + gearTable.values[bytes[i]];
+      if((hash & mask) == 0) {
+        cut = i + 1;
+        break;
+      }
+    }
+
+    sizes.push_back(cut - pos);
+    pos = cut;
+  }
+  return sizes;
+}
+
+filesystem::path BlockStore::blockPath(const std::string& digest) const {
+  return directory_ / digest.substr(0, 2) / digest;
+}
+
+void BlockStore::prefetch(const BlockReference& block) const noexcept {
+  adviseWillNeed(blockPath(block.digest).string(), 0, block.size);
+}
+
+bool BlockStore::contains(const std::string& digest) const {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(knownBlocks_.count(digest))
+      return true;
+  }
+
+  if(!filesystem::exists(blockPath(digest)))
+    return false;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  knownBlocks_.insert(digest);
+  return true;
+}
+
+std::vector<BlockReference> BlockStore::put(const Byte* data, std::size_t size,
+                                            ChunkingKind chunking, std::size_t blockSize) {
+  std::vector<BlockReference> blocks;
+  Statistics statistics;
+
+  const std::vector<std::size_t> sizes = split(data, size, chunking, blockSize);
+  for(std::size_t length : sizes) {
+    BlockReference block{digest(data, length), length};
+
+    if(!contains(block.digest)) {
+      filesystem::path path = blockPath(block.digest);
+      filesystem::create_directories(path.parent_path());
+
+      // Write to a temporary file first, renaming is atomic (concurrent writers of the same block
+      // write the same content)
+      filesystem::path temporary(path.string() + ".tmp." + std::to_string(::getpid()) + "." +
+                                 std::to_string(temporaryCounter++));
+      {
+        std::ofstream fs(temporary.string(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if(fs.is_open()) {
+          fs.write(data, length);
+          fs.close();
+        }
+
+        // Never move a truncated block (e.g the device is full) into the store
+        if(!fs) {
+          std::remove(temporary.string().c_str());
+          throw Exception("cannot write block: '%s'", temporary.string());
+        }
+      }
+      filesystem::rename(temporary, path);
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      knownBlocks_.insert(block.digest);
+      statistics.storedBlocks++;
+      statistics.storedBytes += length;
+    }
+
+    statistics.referencedBlocks++;
+    statistics.referencedBytes += length;
+    blocks.push_back(std::move(block));
+    data += length;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  statistics_ += statistics;
+  return blocks;
+}
+
+void BlockStore::get(const BlockReference& block, std::uint64_t offset, std::uint64_t length,
+                     Byte* dst) const {
+  if(offset + length > block.size)
+    throw Exception("range [%i, %i) exceeds block '%s' of %i bytes", offset, offset + length,
+                    block.digest, block.size);
+
+  std::string path = blockPath(block.digest).string();
+  std::ifstream fs(path, std::ios::in | std::ios::binary);
+  if(!fs.is_open())
+    throw Exception("block '%s' is missing in the block store '%s'", block.digest,
+                    directory_.string());
+
+  fs.seekg(0, std::ios::end);
+  if(fs.tellg() != std::streamoff(block.size))
+    throw Exception("block '%s' of the block store '%s' has %i bytes (expected %i)", block.digest,
+                    directory_.string(), std::streamoff(fs.tellg()), block.size);
+
+  fs.seekg(offset);
+  if(!fs.read(dst, length))
+    throw Exception("failed to read block '%s'", block.digest);
+}
+
+BlockStore::Statistics BlockStore::statistics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_;
+}
+
+const char* BlockStore::toString(ChunkingKind chunking) noexcept {
+  return chunking == ChunkingKind::Fixed ? "fixed" : "content";
+}
+
+ChunkingKind BlockStore::fromString(const std::string& name) {
+  if(name == "fixed")
+    return ChunkingKind::Fixed;
+  if(name == "content")
+    return ChunkingKind::ContentDefined;
+  throw Exception("invalid chunking of block store: '%s' (expected 'fixed' or 'content')", name);
+}
+
+} // namespace serialbox
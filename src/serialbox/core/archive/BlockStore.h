@@ -0,0 +1,172 @@
+//===-- serialbox/core/archive/BlockStore.h -----------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the content-addressed block store of the binary archive.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_ARCHIVE_BLOCKSTORE_H
+#define SERIALBOX_CORE_ARCHIVE_BLOCKSTORE_H
+
+#include "serialbox/core/FieldMetainfoImpl.h"
+#include "serialbox/core/Filesystem.h"
+#include "serialbox/core/Type.h"
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace serialbox {
+
+/// \brief Reference to a block in a BlockStore
+struct BlockReference {
+  std::string digest; ///< Digest of the content
+  std::uint64_t size; ///< Size of the block in bytes
+};
+
+/// \brief Splitting of data into blocks
+enum class ChunkingKind {
+  Fixed,         ///< Blocks of a fixed size
+  ContentDefined ///< Block boundaries determined by the content (rolling hash)
+};
+
+/// \brief Content-addressed store of data blocks
+///
+/// Data is split into blocks which are stored under the digest of their content, hence identical
+/// blocks are stored only once, no matter which field or archive writes them. Content-defined
+/// chunking finds identical blocks even if the data is shifted (e.g by inserted elements).
+///
+/// Every block is a file `<directory>/<first 2 digits>/<digest>`. Blocks are written to a
+/// temporary file which is atomically renamed, hence several processes (e.g ensemble members) can
+/// share the same store. Blocks are never deleted.
+///
+/// The store is configured by the field meta-information:
+///
+/// Key                         | Type          | Description
+/// ---                         | ----          | -----------
+/// `__block_store`             | bool / string | Enable the store or give its directory
+/// `__block_store_chunking`    | string        | `fixed` (default) or `content`
+/// `__block_store_block_size`  | int           | (Average) size of the blocks in bytes (256 KB)
+///
+/// Setting `__block_store` to `true` uses the directory `blocks` next to the archive, hence all
+/// archives of the same directory share the store. Relative directories are interpreted relative
+/// to the archive directory.
+///
+/// \ingroup core
+class BlockStore {
+public:
+  /// \brief Meta-information keys of the configuration
+  static const char* BlockStoreKey;
+  static const char* ChunkingKey;
+  static const char* BlockSizeKey;
+
+  /// \brief Default directory of the store (relative to the archive directory)
+  static const char* DefaultDirectory;
+
+  /// \brief Default (average) size of the blocks
+  static const std::size_t DefaultBlockSize;
+
+  /// \brief Configuration of a field
+  struct Configuration {
+    std::string directory; ///< Directory of the store (empty if the store is not used)
+    ChunkingKind chunking = ChunkingKind::Fixed;
+    std::size_t blockSize = DefaultBlockSize;
+
+    /// \brief Check if the store is used
+    bool isEnabled() const noexcept { return !directory.empty(); }
+  };
+
+  /// \brief Deduplication statistics
+  struct Statistics {
+    std::uint64_t referencedBlocks = 0; ///< Number of blocks referenced by written data
+    std::uint64_t referencedBytes = 0;  ///< Size of the written data
+    std::uint64_t storedBlocks = 0;     ///< Number of blocks which were not yet in the store
+    std::uint64_t storedBytes = 0;      ///< Size of the blocks which were not yet in the store
+
+    /// \brief Ratio of the written data and the newly stored data
+    double ratio() const noexcept {
+      return storedBytes ? double(referencedBytes) / storedBytes : referencedBytes ? 0.0 : 1.0;
+    }
+
+    Statistics& operator+=(const Statistics& other) noexcept;
+  };
+
+  /// \brief Open (or create) the store in `directory`
+  explicit BlockStore(const std::string& directory);
+
+  /// \brief Copy constructor [deleted]
+  BlockStore(const BlockStore&) = delete;
+
+  /// \brief Copy assignment [deleted]
+  BlockStore& operator=(const BlockStore&) = delete;
+
+  /// \brief Parse the configuration of the field meta-information `info`
+  ///
+  /// \throw Exception  Invalid chunking or block size
+  static Configuration configuration(const FieldMetainfoImpl* info);
+
+  /// \brief Get the directory of the store
+  std::string directory() const { return directory_.string(); }
+
+  /// \brief Split `data` into blocks and add the blocks which are not yet stored
+  ///
+  /// This function is thread-safe.
+  ///
+  /// \return References to the blocks of `data` (in order)
+  std::vector<BlockReference> put(const Byte* data, std::size_t size, ChunkingKind chunking,
+                                  std::size_t blockSize);
+
+  /// \brief Read `length` bytes starting at `offset` of the `block` into `dst`
+  ///
+  /// \throw Exception  Block is missing or too small
+  void get(const BlockReference& block, std::uint64_t offset, std::uint64_t length,
+           Byte* dst) const;
+
+  /// \brief Advise the kernel that the `block` will be read soon
+  void prefetch(const BlockReference& block) const noexcept;
+
+  /// \brief Check if the block with the given `digest` is stored
+  bool contains(const std::string& digest) const;
+
+  /// \brief Get the deduplication statistics of all data written through this object
+  Statistics statistics() const;
+
+  /// \brief Compute the digest (128 bit, hex) of the content
+  static std::string digest(const Byte* data, std::size_t size) noexcept;
+
+  /// \brief Compute the sizes of the blocks of `data`
+  static std::vector<std::size_t> split(const Byte* data, std::size_t size,
+                                        ChunkingKind chunking, std::size_t blockSize);
+
+  /// \brief Convert the chunking to string
+  static const char* toString(ChunkingKind chunking) noexcept;
+
+  /// \brief Convert `name` to the chunking
+  ///
+  /// \throw Exception  Unknown chunking
+  static ChunkingKind fromString(const std::string& name);
+
+private:
+  /// \brief Path of the block with the given `digest`
+  filesystem::path blockPath(const std::string& digest) const;
+
+  filesystem::path directory_;
+
+  // Guards the set of known blocks and the statistics
+  mutable std::mutex mutex_;
+  mutable std::unordered_set<std::string> knownBlocks_;
+  Statistics statistics_;
+};
+
+} // namespace serialbox
+
+#endif
@@ -0,0 +1,194 @@
+//===-- serialbox/core/archive/BufferPool.cpp ---------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the pool of staging buffers used by the archives.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/archive/BufferPool.h"
+#include "serialbox/core/Exception.h"
+#include <cstdlib>
+#include <sys/mman.h>
+
+namespace serialbox {
+
+namespace {
+
+/// Alignment of huge page backed buffers (2 MB is the size of a transparent huge page on x86-64)
+constexpr std::size_t HugePageSize = 2 << 20;
+
+/// Granularity of regular buffers
+constexpr std::size_t CacheLineSize = 64;
+
+std::size_t roundUp(std::size_t size, std::size_t alignment) noexcept {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+} // anonymous namespace
+
+const std::size_t BufferPool::DefaultHighWaterMark = std::size_t(256) << 20;
+
+const std::size_t BufferPool::HugePageThreshold = std::size_t(4) << 20;
+
+//===------------------------------------------------------------------------------------------===//
+//     Buffer
+//===------------------------------------------------------------------------------------------===//
+
+BufferPool::Buffer::~Buffer() { reset(); }
+
+BufferPool::Buffer::Buffer(Buffer&& other) noexcept
+    : pool_(other.pool_), data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
+  other.pool_ = nullptr;
+  other.data_ = nullptr;
+  other.size_ = other.capacity_ = 0;
+}
+
+BufferPool::Buffer& BufferPool::Buffer::operator=(Buffer&& other) noexcept {
+  if(this != &other) {
+    reset();
+    pool_ = other.pool_;
+    data_ = other.data_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    other.pool_ = nullptr;
+    other.data_ = nullptr;
+    other.size_ = other.capacity_ = 0;
+  }
+  return *this;
+}
+
+void BufferPool::Buffer::reset() noexcept {
+  if(data_)
+    pool_->release(data_, capacity_);
+  pool_ = nullptr;
+  data_ = nullptr;
+  size_ = capacity_ = 0;
+}
+
+//===------------------------------------------------------------------------------------------===//
+//     BufferPool
+//===------------------------------------------------------------------------------------------===//
+
+BufferPool::BufferPool(std::size_t highWaterMark)
+    : cachedBytes_(0), highWaterMark_(highWaterMark), useHugePages_(true) {}
+
+BufferPool::~BufferPool() { trim(); }
+
+BufferPool::Buffer BufferPool::acquire(std::size_t size) {
+  if(size == 0)
+    return Buffer();
+
+  const bool isHuge = useHugePages() && size >= HugePageThreshold;
+  const std::size_t capacity = roundUp(size, isHuge ? HugePageSize : CacheLineSize);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Best fit: smallest cached block which is large enough but not more than twice the size of a
+    // fresh allocation (otherwise a small request would pin a huge buffer)
+    auto bestIt = blocks_.end();
+    for(auto it = blocks_.begin(), end = blocks_.end(); it != end; ++it)
+      if(it->capacity >= size && it->capacity / 2 <= capacity &&
+         (bestIt == blocks_.end() || it->capacity < bestIt->capacity))
+        bestIt = it;
+
+    if(bestIt != blocks_.end()) {
+      Block block = *bestIt;
+      blocks_.erase(bestIt);
+      cachedBytes_ -= block.capacity;
+      return Buffer(this, block.data, size, block.capacity);
+    }
+  }
+
+  return Buffer(this, allocate(capacity, isHuge), size, capacity);
+}
+
+void BufferPool::release(Byte* data, std::size_t capacity) noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if(highWaterMark_ == 0) {
+    deallocate(data);
+    return;
+  }
+
+  try {
+    blocks_.push_back(Block{data, capacity});
+  } catch(...) {
+    deallocate(data);
+    return;
+  }
+
+  cachedBytes_ += capacity;
+  trimTo(highWaterMark_, true);
+}
+
+void BufferPool::trimTo(std::size_t bytes, bool keepLast) noexcept {
+  auto last = keepLast && !blocks_.empty() ? blocks_.end() - 1 : blocks_.end();
+  auto it = blocks_.begin();
+  for(; it != last && cachedBytes_ > bytes; ++it) {
+    cachedBytes_ -= it->capacity;
+    deallocate(it->data);
+  }
+  blocks_.erase(blocks_.begin(), it);
+}
+
+void BufferPool::setHighWaterMark(std::size_t highWaterMark) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  highWaterMark_ = highWaterMark;
+  trimTo(highWaterMark_, highWaterMark_ != 0);
+}
+
+std::size_t BufferPool::highWaterMark() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return highWaterMark_;
+}
+
+void BufferPool::setUseHugePages(bool useHugePages) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  useHugePages_ = useHugePages;
+}
+
+bool BufferPool::useHugePages() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return useHugePages_;
+}
+
+std::size_t BufferPool::cachedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cachedBytes_;
+}
+
+void BufferPool::trim() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  trimTo(0, false);
+}
+
+Byte* BufferPool::allocate(std::size_t capacity, bool hugePages) {
+  void* data = nullptr;
+
+  if(hugePages) {
+    if(posix_memalign(&data, HugePageSize, capacity) != 0)
+      throw Exception("cannot allocate buffer of %i bytes", capacity);
+#ifdef MADV_HUGEPAGE
+    // This is only a hint, we don't care if the kernel does not support transparent huge pages
+    (void)madvise(data, capacity, MADV_HUGEPAGE);
+#endif
+  } else {
+    data = std::malloc(capacity);
+    if(!data)
+      throw Exception("cannot allocate buffer of %i bytes", capacity);
+  }
+
+  return static_cast<Byte*>(data);
+}
+
+void BufferPool::deallocate(Byte* data) noexcept { std::free(data); }
+
+} // namespace serialbox
@@ -0,0 +1,145 @@
+//===-- serialbox/core/archive/BufferPool.h -----------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the pool of staging buffers used by the archives.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_ARCHIVE_BUFFERPOOL_H
+#define SERIALBOX_CORE_ARCHIVE_BUFFERPOOL_H
+
+#include "serialbox/core/Type.h"
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace serialbox {
+
+/// \brief Thread-safe pool of uninitialized staging buffers
+///
+/// Buffers are handed out via BufferPool::acquire and automatically returned to the pool once the
+/// BufferPool::Buffer goes out of scope. Released buffers are cached and reused by subsequent
+/// requests of the same or a somewhat smaller size (at most half the cached capacity) which avoids
+/// repeated allocation (and page faults) of large buffers. The total number of cached bytes is
+/// bounded by the high-water mark, exceeding buffers are freed (oldest first). The most recently
+/// released buffer is always kept, even if it exceeds the high-water mark on its own, so that
+/// repeatedly reading or writing a single field larger than the high-water mark does not
+/// reallocate on every call. Use BufferPool::setHighWaterMark to raise the limit if several such
+/// buffers are in flight; a high-water mark of 0 disables caching altogether.
+///
+/// Buffers of at least BufferPool::HugePageThreshold bytes are aligned to huge page boundaries and
+/// advised to be backed by transparent huge pages (if supported by the platform).
+///
+/// \ingroup core
+class BufferPool {
+public:
+  /// \brief Default upper bound of cached bytes (256 MB)
+  static const std::size_t DefaultHighWaterMark;
+
+  /// \brief Minimal size in bytes of buffers backed by huge pages (4 MB)
+  static const std::size_t HugePageThreshold;
+
+  /// \brief Uninitialized contiguous memory owned by a BufferPool
+  class Buffer {
+  public:
+    Buffer() = default;
+
+    /// \brief Return the memory to the pool
+    ~Buffer();
+
+    Buffer(Buffer&& other) noexcept;
+    Buffer& operator=(Buffer&& other) noexcept;
+
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+
+    /// \brief Get pointer to the beginning of the buffer
+    Byte* data() noexcept { return data_; }
+    const Byte* data() const noexcept { return data_; }
+
+    /// \brief Get the requested size in bytes
+    std::size_t size() const noexcept { return size_; }
+
+    /// \brief Get the allocated size in bytes
+    std::size_t capacity() const noexcept { return capacity_; }
+
+  private:
+    friend class BufferPool;
+    Buffer(BufferPool* pool, Byte* data, std::size_t size, std::size_t capacity) noexcept
+        : pool_(pool), data_(data), size_(size), capacity_(capacity) {}
+
+    void reset() noexcept;
+
+    BufferPool* pool_ = nullptr;
+    Byte* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+  };
+
+  /// \brief Construct an empty pool
+  ///
+  /// \param highWaterMark  Upper bound of the number of bytes kept in the pool
+  explicit BufferPool(std::size_t highWaterMark = DefaultHighWaterMark);
+
+  /// \brief Free all cached buffers
+  ///
+  /// All buffers acquired from the pool have to be released before the pool is destroyed.
+  ~BufferPool();
+
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  /// \brief Acquire a buffer of at least `size` bytes
+  ///
+  /// The content of the buffer is uninitialized.
+  Buffer acquire(std::size_t size);
+
+  /// \brief Set the upper bound of cached bytes and trim the pool accordingly
+  ///
+  /// The most recently released buffer is kept unless the high-water mark is 0.
+  void setHighWaterMark(std::size_t highWaterMark);
+
+  /// \brief Get the upper bound of cached bytes
+  std::size_t highWaterMark() const;
+
+  /// \brief Enable or disable the use of huge pages for large buffers
+  void setUseHugePages(bool useHugePages);
+
+  /// \brief Check if large buffers are backed by huge pages
+  bool useHugePages() const;
+
+  /// \brief Get the number of bytes currently cached by the pool (i.e not in use)
+  std::size_t cachedBytes() const;
+
+  /// \brief Free all cached buffers
+  void trim();
+
+private:
+  struct Block {
+    Byte* data;
+    std::size_t capacity;
+  };
+
+  void release(Byte* data, std::size_t capacity) noexcept;
+  void trimTo(std::size_t bytes, bool keepLast) noexcept;
+
+  static Byte* allocate(std::size_t capacity, bool hugePages);
+  static void deallocate(Byte* data) noexcept;
+
+  mutable std::mutex mutex_;
+  std::vector<Block> blocks_;
+  std::size_t cachedBytes_;
+  std::size_t highWaterMark_;
+  bool useHugePages_;
+};
+
+} // namespace serialbox
+
+#endif
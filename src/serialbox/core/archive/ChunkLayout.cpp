@@ -0,0 +1,243 @@
+//===-- serialbox/core/archive/ChunkLayout.cpp --------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the chunked (tiled) storage layout of fields.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/archive/ChunkLayout.h"
+#include "serialbox/core/Exception.h"
+#include "serialbox/core/STLExtras.h"
+#include <algorithm>
+#include <cstring>
+
+namespace serialbox {
+
+const char* ChunkLayout::ChunkShapeKey = "__chunk_shape";
+
+namespace {
+
+/// Strides (in elements) of a column-major array of dimensions `dims`
+std::vector<std::size_t> columnMajorStrides(const std::vector<int>& dims) {
+  std::vector<std::size_t> strides(dims.size(), 1);
+  for(std::size_t i = 1; i < dims.size(); ++i)
+    strides[i] = strides[i - 1] * dims[i - 1];
+  return strides;
+}
+
+/// Linear position of `index` (relative to `origin`) in a column-major array of `strides`
+std::size_t linearPosition(const std::vector<int>& index, const std::vector<int>& origin,
+                           const std::vector<std::size_t>& strides) {
+  std::size_t pos = 0;
+  for(std::size_t i = 0; i < index.size(); ++i)
+    pos += strides[i] * (index[i] - origin[i]);
+  return pos;
+}
+
+/// Copy a box of `extents` elements between two column-major arrays (`src` and `dst` point to
+/// the first element of the box). The first dimension is copied with a single memcpy.
+void copyBox(const Byte* src, const std::vector<std::size_t>& srcStrides, Byte* dst,
+             const std::vector<std::size_t>& dstStrides, const std::vector<int>& extents,
+             int bytesPerElement) {
+  const std::size_t numDims = extents.size();
+  for(int extent : extents)
+    if(extent <= 0)
+      return;
+
+  const std::size_t rowSize = extents[0] * bytesPerElement;
+  std::vector<int> index(numDims, 0);
+
+  while(true) {
+    std::size_t srcPos = 0, dstPos = 0;
+    for(std::size_t i = 1; i < numDims; ++i) {
+      srcPos += srcStrides[i] * index[i];
+      dstPos += dstStrides[i] * index[i];
+    }
+    std::memcpy(dst + dstPos * bytesPerElement, src + srcPos * bytesPerElement, rowSize);
+
+    std::size_t i = 1;
+    for(; i < numDims; ++i) {
+      if(++index[i] < extents[i])
+        break;
+      index[i] = 0;
+    }
+    if(i >= numDims)
+      break;
+  }
+}
+
+} // anonymous namespace
+
+ChunkLayout::ChunkLayout(const std::vector<int>& dims, const std::vector<int>& shape,
+                         int bytesPerElement)
+    : dims_(dims), shape_(shape), grid_(dims.size()), bytesPerElement_(bytesPerElement) {
+  if(dims_.empty() || shape_.size() != dims_.size())
+    throw Exception("chunk shape (%i dimensions) does not match the field (%i dimensions)",
+                    shape_.size(), dims_.size());
+
+  for(std::size_t i = 0; i < dims_.size(); ++i) {
+    if(dims_[i] <= 0)
+      throw Exception("cannot chunk field with empty dimension %i", i);
+    if(shape_[i] <= 0)
+      throw Exception("invalid chunk shape: dimension %i is %i", i, shape_[i]);
+    shape_[i] = std::min(shape_[i], dims_[i]);
+    grid_[i] = (dims_[i] + shape_[i] - 1) / shape_[i];
+  }
+
+  std::size_t numChunks = 1;
+  for(int n : grid_)
+    numChunks *= n;
+
+  // Compute the offset of every chunk
+  offsets_.resize(numChunks + 1, 0);
+  std::vector<int> origin, extents;
+  for(std::size_t chunk = 0; chunk < numChunks; ++chunk) {
+    chunkBounds(chunk, origin, extents);
+    std::uint64_t size = bytesPerElement_;
+    for(int extent : extents)
+      size *= extent;
+    offsets_[chunk + 1] = offsets_[chunk] + size;
+  }
+}
+
+std::unique_ptr<ChunkLayout> ChunkLayout::create(const FieldMetainfoImpl* info,
+                                                 const StorageView& storageView) {
+  if(!info || !info->metaInfo().hasKey(ChunkShapeKey))
+    return nullptr;
+
+  return std::make_unique<ChunkLayout>(storageView.dims(),
+                                       info->metaInfo().as<Array<int>>(ChunkShapeKey),
+                                       storageView.bytesPerElement());
+}
+
+ChunkIndex ChunkLayout::index() const {
+  return ChunkIndex{shape_, std::vector<std::uint64_t>(offsets_.begin(), offsets_.end() - 1)};
+}
+
+void ChunkLayout::chunkBounds(std::size_t chunk, std::vector<int>& origin,
+                              std::vector<int>& extents) const {
+  origin.resize(dims_.size());
+  extents.resize(dims_.size());
+  for(std::size_t i = 0; i < dims_.size(); ++i) {
+    origin[i] = (chunk % grid_[i]) * shape_[i];
+    extents[i] = std::min(shape_[i], dims_[i] - origin[i]);
+    chunk /= grid_[i];
+  }
+}
+
+std::vector<std::size_t> ChunkLayout::intersectingChunks(const std::vector<int>& lower,
+                                                         const std::vector<int>& upper) const {
+  const std::size_t numDims = dims_.size();
+  std::vector<int> first(numDims), last(numDims);
+  for(std::size_t i = 0; i < numDims; ++i) {
+    if(upper[i] <= lower[i])
+      return std::vector<std::size_t>();
+    first[i] = lower[i] / shape_[i];
+    last[i] = std::min((upper[i] - 1) / shape_[i], grid_[i] - 1);
+  }
+
+  // Iterate the intersecting part of the grid in column-major order
+  std::vector<std::size_t> gridStrides = columnMajorStrides(grid_);
+  std::vector<std::size_t> chunks;
+  std::vector<int> coord(first);
+  while(true) {
+    std::size_t chunk = 0;
+    for(std::size_t i = 0; i < numDims; ++i)
+      chunk += gridStrides[i] * coord[i];
+    chunks.push_back(chunk);
+
+    std::size_t i = 0;
+    for(; i < numDims; ++i) {
+      if(++coord[i] <= last[i])
+        break;
+      coord[i] = first[i];
+    }
+    if(i == numDims)
+      break;
+  }
+  return chunks;
+}
+
+void ChunkLayout::toChunks(const Byte* data, Byte* chunked) const {
+  const std::vector<std::size_t> strides = columnMajorStrides(dims_);
+  const std::vector<int> zero(dims_.size(), 0);
+  std::vector<int> origin, extents;
+
+  for(std::size_t chunk = 0; chunk < numChunks(); ++chunk) {
+    chunkBounds(chunk, origin, extents);
+    copyBox(data + linearPosition(origin, zero, strides) * bytesPerElement_, strides,
+            chunked + offsets_[chunk], columnMajorStrides(extents), extents, bytesPerElement_);
+  }
+}
+
+void ChunkLayout::fromChunks(const Byte* chunked, Byte* data) const {
+  const std::vector<std::size_t> strides = columnMajorStrides(dims_);
+  const std::vector<int> zero(dims_.size(), 0);
+  std::vector<int> origin, extents;
+
+  for(std::size_t chunk = 0; chunk < numChunks(); ++chunk) {
+    chunkBounds(chunk, origin, extents);
+    copyBox(chunked + offsets_[chunk], columnMajorStrides(extents),
+            data + linearPosition(origin, zero, strides) * bytesPerElement_, strides, extents,
+            bytesPerElement_);
+  }
+}
+
+void ChunkLayout::copyChunkToBox(std::size_t chunk, const Byte* chunkData,
+                                 const std::vector<int>& lower, const std::vector<int>& upper,
+                                 Byte* box) const {
+  std::vector<int> origin, extents;
+  chunkBounds(chunk, origin, extents);
+
+  // Intersection of the chunk and the box
+  const std::size_t numDims = dims_.size();
+  std::vector<int> first(numDims), intersection(numDims), boxDims(numDims);
+  for(std::size_t i = 0; i < numDims; ++i) {
+    first[i] = std::max(origin[i], lower[i]);
+    intersection[i] = std::min(origin[i] + extents[i], upper[i]) - first[i];
+    boxDims[i] = upper[i] - lower[i];
+  }
+
+  const std::vector<std::size_t> chunkStrides = columnMajorStrides(extents);
+  const std::vector<std::size_t> boxStrides = columnMajorStrides(boxDims);
+  copyBox(chunkData + linearPosition(first, origin, chunkStrides) * bytesPerElement_,
+          chunkStrides, box + linearPosition(first, lower, boxStrides) * bytesPerElement_,
+          boxStrides, intersection, bytesPerElement_);
+}
+
+void ChunkLayout::copyBoxToStorageView(const Byte* box, const std::vector<int>& lower,
+                                       const std::vector<int>& upper, StorageView& storageView) {
+  const auto& triples = storageView.getSlice().sliceTriples();
+  const std::size_t numDims = lower.size();
+  const int bytesPerElement = storageView.bytesPerElement();
+
+  std::vector<int> boxDims(numDims);
+  for(std::size_t i = 0; i < numDims; ++i)
+    boxDims[i] = upper[i] - lower[i];
+  const std::vector<std::size_t> boxStrides = columnMajorStrides(boxDims);
+
+  // Iterate the sliced storageView and the box simultaneously
+  std::vector<int> index(numDims);
+  for(std::size_t i = 0; i < numDims; ++i)
+    index[i] = triples[i].start;
+
+  for(auto it = storageView.begin(), end = storageView.end(); it != end; ++it) {
+    std::memcpy(it.ptr(), box + linearPosition(index, lower, boxStrides) * bytesPerElement,
+                bytesPerElement);
+
+    for(std::size_t i = 0; i < numDims; ++i)
+      if((index[i] += triples[i].step) < triples[i].stop)
+        break;
+      else
+        index[i] = triples[i].start;
+  }
+}
+
+} // namespace serialbox
@@ -0,0 +1,124 @@
+//===-- serialbox/core/archive/ChunkLayout.h ----------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the chunked (tiled) storage layout of fields.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_ARCHIVE_CHUNKLAYOUT_H
+#define SERIALBOX_CORE_ARCHIVE_CHUNKLAYOUT_H
+
+#include "serialbox/core/FieldMetainfoImpl.h"
+#include "serialbox/core/StorageView.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace serialbox {
+
+/// \brief Chunk index of a field (empty if the field is stored contiguously)
+struct ChunkIndex {
+  std::vector<int> shape;             ///< Shape of the chunks
+  std::vector<std::uint64_t> offsets; ///< Offset in bytes of each chunk within the data
+
+  /// \brief Check if the data is chunked
+  bool isChunked() const noexcept { return !shape.empty(); }
+};
+
+/// \brief Layout of a field split into fixed-size n-dimensional chunks
+///
+/// The field is divided into a grid of chunks of the given shape (chunks at the upper boundary of
+/// a dimension are truncated). The chunks are stored one after another in column-major order of
+/// the grid and the elements of each chunk are stored in column-major order. Hence, reading a
+/// sub-domain only has to load the intersecting chunks instead of (almost) the whole field.
+///
+/// The chunk shape is configured by the field meta-information:
+///
+/// Key              | Type       | Description
+/// ---              | ----       | -----------
+/// `__chunk_shape`  | Array<int> | Shape of the chunks (one entry per dimension)
+///
+/// \ingroup core
+class ChunkLayout {
+public:
+  /// \brief Meta-information key of the chunk shape
+  static const char* ChunkShapeKey;
+
+  /// \brief Initialize the layout
+  ///
+  /// \param dims             Dimensions of the field
+  /// \param shape            Shape of the chunks (entries larger than the dimension are clamped)
+  /// \param bytesPerElement  Size of an element
+  /// \throw Exception  Shape does not match the dimensions or is not positive
+  ChunkLayout(const std::vector<int>& dims, const std::vector<int>& shape, int bytesPerElement);
+
+  /// \brief Create the layout of `storageView` as requested by the field meta-information
+  ///
+  /// \return Layout or `nullptr` if the field is stored contiguously
+  static std::unique_ptr<ChunkLayout> create(const FieldMetainfoImpl* info,
+                                             const StorageView& storageView);
+
+  /// \brief Get the dimensions of the field
+  const std::vector<int>& dims() const noexcept { return dims_; }
+
+  /// \brief Get the shape of the chunks
+  const std::vector<int>& shape() const noexcept { return shape_; }
+
+  /// \brief Get the number of chunks
+  std::size_t numChunks() const noexcept { return offsets_.size() - 1; }
+
+  /// \brief Get the offset in bytes of `chunk`
+  std::uint64_t chunkOffset(std::size_t chunk) const noexcept { return offsets_[chunk]; }
+
+  /// \brief Get the size in bytes of all chunks
+  std::uint64_t size() const noexcept { return offsets_.back(); }
+
+  /// \brief Get the size in bytes of `chunk`
+  std::uint64_t chunkSize(std::size_t chunk) const noexcept {
+    return offsets_[chunk + 1] - offsets_[chunk];
+  }
+
+  /// \brief Get the chunk index (shape and offsets) of the layout
+  ChunkIndex index() const;
+
+  /// \brief Get the chunks intersecting the box [`lower`, `upper`)
+  std::vector<std::size_t> intersectingChunks(const std::vector<int>& lower,
+                                              const std::vector<int>& upper) const;
+
+  /// \brief Reorder contiguous column-major `data` into chunks (`chunked`)
+  void toChunks(const Byte* data, Byte* chunked) const;
+
+  /// \brief Reorder the `chunked` data into contiguous column-major `data`
+  void fromChunks(const Byte* chunked, Byte* data) const;
+
+  /// \brief Copy the intersection of `chunk` (given by its data) with the box
+  /// [`lower`, `upper`) into the contiguous column-major `box`
+  void copyChunkToBox(std::size_t chunk, const Byte* chunkData, const std::vector<int>& lower,
+                      const std::vector<int>& upper, Byte* box) const;
+
+  /// \brief Copy the contiguous column-major `box` [`lower`, `upper`) to the sliced
+  /// `storageView` (the box has to cover the slice)
+  static void copyBoxToStorageView(const Byte* box, const std::vector<int>& lower,
+                                   const std::vector<int>& upper, StorageView& storageView);
+
+private:
+  /// \brief Origin and extents of `chunk`
+  void chunkBounds(std::size_t chunk, std::vector<int>& origin, std::vector<int>& extents) const;
+
+  std::vector<int> dims_;
+  std::vector<int> shape_;
+  std::vector<int> grid_;
+  std::vector<std::uint64_t> offsets_;
+  int bytesPerElement_;
+};
+
+} // namespace serialbox
+
+#endif
@@ -41,6 +41,8 @@ public:
   /// \name Archive implementation
   /// \see Archive
   /// @{
+  using Archive::write;
+
   virtual FieldID write(const StorageView& storageView, const std::string& fieldID,
                         const std::shared_ptr<FieldMetainfoImpl> info) override;
 
@@ -0,0 +1,728 @@
+//===-- serialbox/core/archive/PackedBinaryArchive.cpp ------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements the non-portable single-file binary archive.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/archive/PackedBinaryArchive.h"
+#include "serialbox/core/Logging.h"
+#include "serialbox/core/STLExtras.h"
+#include "serialbox/core/Version.h"
+#include "serialbox/core/archive/BinaryBuffer.h"
+#include "serialbox/core/archive/Readahead.h"
+#include "serialbox/core/hash/HashFactory.h"
+#include <cstring>
+
+namespace serialbox {
+
+//===------------------------------------------------------------------------------------------===//
+//     Container format
+//===------------------------------------------------------------------------------------------===//
+
+namespace {
+
+const char FileMagic[8] = {'S', 'B', 'X', 'P', 'A', 'C', 'K', '\0'};
+const char TrailerMagic[8] = {'S', 'B', 'X', 'I', 'N', 'D', 'E', 'X'};
+const std::uint32_t BlockMagic = 0x4b4c4253;      // "SBLK"
+const std::uint32_t IndexEntryMagic = 0x58444e49; // "INDX"
+
+/// Upper bound of the length of field names and checksums (used to detect garbage while scanning)
+const std::uint32_t MaxStringLength = 1 << 16;
+
+struct FileHeader {
+  char magic[8];
+  std::uint32_t serialboxVersion;
+  std::uint32_t archiveVersion;
+  std::uint32_t alignment;
+  std::uint32_t hashLength; ///< Followed by the name of the hash algorithm
+};
+
+struct BlockHeader {
+  std::uint32_t magic;
+  std::uint32_t id;
+  std::uint32_t nameLength;     ///< Followed by the name of the field
+  std::uint32_t checksumLength; ///< Followed by the checksum
+  std::uint32_t group;          ///< Savepoint group of the block
+  std::uint32_t reserved;
+  std::uint64_t length;
+};
+
+struct Trailer {
+  std::uint64_t indexOffset;
+  std::uint64_t numEntries;
+  char magic[8];
+};
+
+std::uint64_t alignOffset(std::uint64_t offset, std::uint64_t alignment) noexcept {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+template <class T>
+void writePOD(std::ostream& stream, const T& value) {
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+bool readPOD(std::istream& stream, T& value) {
+  return bool(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+bool readString(std::istream& stream, std::uint32_t length, std::string& str) {
+  if(length > MaxStringLength)
+    return false;
+  str.resize(length);
+  return length == 0 || bool(stream.read(&str[0], length));
+}
+
+/// Pad the stream with zeros from `offset` to the next multiple of `alignment`
+std::uint64_t writePadding(std::ostream& stream, std::uint64_t offset, std::uint64_t alignment) {
+  static const char zeros[64] = {0};
+  std::uint64_t alignedOffset = alignOffset(offset, alignment);
+  for(std::uint64_t n = alignedOffset - offset; n > 0;) {
+    std::uint64_t count = std::min<std::uint64_t>(n, sizeof(zeros));
+    stream.write(zeros, count);
+    n -= count;
+  }
+  return alignedOffset;
+}
+
+/// Write the file header at the current position (assumed to be 0), return the aligned end
+std::uint64_t writeFileHeader(std::ostream& stream, const std::string& hashName,
+                              std::uint32_t alignment) {
+  FileHeader header;
+  std::memcpy(header.magic, FileMagic, sizeof(FileMagic));
+  header.serialboxVersion =
+      100 * SERIALBOX_VERSION_MAJOR + 10 * SERIALBOX_VERSION_MINOR + SERIALBOX_VERSION_PATCH;
+  header.archiveVersion = PackedBinaryArchive::Version;
+  header.alignment = alignment;
+  header.hashLength = hashName.size();
+
+  writePOD(stream, header);
+  stream.write(hashName.data(), hashName.size());
+  return writePadding(stream, sizeof(FileHeader) + hashName.size(), alignment);
+}
+
+/// Read the file header and return the aligned offset of the first block
+std::uint64_t readFileHeader(std::istream& stream, const std::string& filename,
+                             std::uint32_t& alignment, std::string& hashName) {
+  FileHeader header;
+  if(!readPOD(stream, header) || std::memcmp(header.magic, FileMagic, sizeof(FileMagic)) != 0)
+    throw Exception("'%s' is not a packed binary archive", filename);
+
+  if(!Version::isCompatible(header.serialboxVersion))
+    throw Exception("serialbox version of packed binary archive (%s) does not match the version "
+                    "of the library (%s)",
+                    Version::toString(header.serialboxVersion), SERIALBOX_VERSION_STRING);
+
+  if(header.archiveVersion != std::uint32_t(PackedBinaryArchive::Version))
+    throw Exception(
+        "packed binary archive version (%s) does not match the version of the library (%s)",
+        header.archiveVersion, PackedBinaryArchive::Version);
+
+  if(header.alignment == 0 || !readString(stream, header.hashLength, hashName))
+    throw Exception("corrupted header of packed binary archive '%s'", filename);
+
+  alignment = header.alignment;
+  return alignOffset(sizeof(FileHeader) + header.hashLength, alignment);
+}
+
+/// Write a data block at `offset` and return the offset of the data, `offset` is advanced to the
+/// (aligned) end of the block
+std::uint64_t writeBlock(std::ostream& stream, std::uint64_t& offset, std::uint32_t alignment,
+                         const std::string& field, std::uint32_t id, const std::string& checksum,
+                         std::uint32_t group, const Byte* data, std::uint64_t length) {
+  BlockHeader header{BlockMagic, id, std::uint32_t(field.size()), std::uint32_t(checksum.size()),
+                     group, 0, length};
+
+  writePOD(stream, header);
+  stream.write(field.data(), field.size());
+  stream.write(checksum.data(), checksum.size());
+  std::uint64_t dataOffset =
+      writePadding(stream, offset + sizeof(BlockHeader) + field.size() + checksum.size(), alignment);
+
+  stream.write(data, length);
+  offset = writePadding(stream, dataOffset + length, alignment);
+  return dataOffset;
+}
+
+/// Write the index and the trailer at the current position `offset`
+void writeIndexFooter(std::ostream& stream, std::uint64_t offset,
+                      const PackedBinaryArchive::FieldTable& fieldTable) {
+  std::uint64_t numEntries = 0;
+  for(const auto& fieldPair : fieldTable) {
+    const std::string& field = fieldPair.first;
+    for(std::uint32_t id = 0; id < fieldPair.second.size(); ++id, ++numEntries) {
+      const auto& entry = fieldPair.second[id];
+      BlockHeader header{IndexEntryMagic, id, std::uint32_t(field.size()),
+                         std::uint32_t(entry.checksum.size()), entry.group, 0, entry.length};
+      writePOD(stream, header);
+      writePOD(stream, entry.offset);
+      stream.write(field.data(), field.size());
+      stream.write(entry.checksum.data(), entry.checksum.size());
+    }
+  }
+
+  Trailer trailer;
+  trailer.indexOffset = offset;
+  trailer.numEntries = numEntries;
+  std::memcpy(trailer.magic, TrailerMagic, sizeof(TrailerMagic));
+  writePOD(stream, trailer);
+}
+
+/// Try to read the index, returns false if the trailer or index is missing or incomplete
+bool readIndexFooter(std::istream& stream, std::uint64_t fileSize,
+                     PackedBinaryArchive::FieldTable& fieldTable, std::uint64_t& indexOffset) {
+  if(fileSize < sizeof(Trailer))
+    return false;
+
+  Trailer trailer;
+  stream.seekg(fileSize - sizeof(Trailer));
+  if(!readPOD(stream, trailer) ||
+     std::memcmp(trailer.magic, TrailerMagic, sizeof(TrailerMagic)) != 0 ||
+     trailer.indexOffset > fileSize - sizeof(Trailer))
+    return false;
+
+  PackedBinaryArchive::FieldTable table;
+  stream.seekg(trailer.indexOffset);
+  for(std::uint64_t i = 0; i < trailer.numEntries; ++i) {
+    BlockHeader header;
+    PackedBinaryArchive::BlockEntry entry;
+    std::string field;
+
+    if(!readPOD(stream, header) || header.magic != IndexEntryMagic ||
+       !readPOD(stream, entry.offset) || !readString(stream, header.nameLength, field) ||
+       !readString(stream, header.checksumLength, entry.checksum))
+      return false;
+
+    entry.length = header.length;
+    entry.group = header.group;
+    if(entry.offset + entry.length > trailer.indexOffset)
+      return false;
+
+    auto& fieldOffsetTable = table[field];
+    if(header.id != fieldOffsetTable.size())
+      return false;
+    fieldOffsetTable.push_back(entry);
+  }
+
+  fieldTable.swap(table);
+  indexOffset = trailer.indexOffset;
+  return true;
+}
+
+/// Rebuild the field table by scanning the block headers, returns the end of the last valid block
+std::uint64_t recoverBlocks(std::istream& stream, std::uint64_t fileSize, std::uint64_t offset,
+                            std::uint32_t alignment, PackedBinaryArchive::FieldTable& fieldTable) {
+  fieldTable.clear();
+
+  while(offset + sizeof(BlockHeader) <= fileSize) {
+    BlockHeader header;
+    std::string field, checksum;
+
+    stream.clear();
+    stream.seekg(offset);
+    if(!readPOD(stream, header) || header.magic != BlockMagic ||
+       !readString(stream, header.nameLength, field) ||
+       !readString(stream, header.checksumLength, checksum))
+      break;
+
+    std::uint64_t dataOffset =
+        alignOffset(offset + sizeof(BlockHeader) + header.nameLength + header.checksumLength,
+                    alignment);
+    if(dataOffset + header.length > fileSize)
+      break;
+
+    auto& fieldOffsetTable = fieldTable[field];
+    if(header.id != fieldOffsetTable.size()) {
+      if(fieldOffsetTable.empty())
+        fieldTable.erase(field);
+      break;
+    }
+
+    fieldOffsetTable.push_back(
+        PackedBinaryArchive::BlockEntry{dataOffset, header.length, checksum, header.group});
+    offset = alignOffset(dataOffset + header.length, alignment);
+  }
+
+  return std::min(offset, fileSize);
+}
+
+/// Load the field table from the index (or by scanning the blocks if the index is missing) and
+/// return the offset at which new blocks can be appended
+std::uint64_t loadFieldTable(const std::string& filename,
+                             PackedBinaryArchive::FieldTable& fieldTable, std::string& hashName,
+                             bool& recovered) {
+  std::ifstream fs(filename, std::ios::in | std::ios::binary);
+  if(!fs.is_open())
+    throw Exception("cannot open file: '%s'", filename);
+
+  fs.seekg(0, std::ios::end);
+  std::uint64_t fileSize = fs.tellg();
+  fs.seekg(0);
+
+  std::uint32_t alignment = 0;
+  std::uint64_t dataStart = readFileHeader(fs, filename, alignment, hashName);
+
+  std::uint64_t endOffset = 0;
+  recovered = !readIndexFooter(fs, fileSize, fieldTable, endOffset);
+
+  if(recovered) {
+    LOG(warning) << "PackedBinaryArchive: index of " << filename
+                 << " is missing, recovering field table from data blocks";
+    endOffset = recoverBlocks(fs, fileSize, dataStart, alignment, fieldTable);
+  }
+
+  return endOffset;
+}
+
+} // anonymous namespace
+
+//===------------------------------------------------------------------------------------------===//
+//     PackedBinaryArchive
+//===------------------------------------------------------------------------------------------===//
+
+const std::string PackedBinaryArchive::Name = "PackedBinary";
+
+const int PackedBinaryArchive::Version = 0;
+
+const std::uint32_t PackedBinaryArchive::Alignment = 64;
+
+const std::size_t PackedBinaryArchive::DefaultSavepointCacheLimit = 128 << 20;
+
+PackedBinaryArchive::PackedBinaryArchive(OpenModeKind mode, const std::string& directory,
+                                         const std::string& prefix)
+    : mode_(mode), directory_(directory), prefix_(prefix), recovered_(false), endOffset_(0),
+      indexWritten_(false), savepointCacheLimit_(DefaultSavepointCacheLimit) {
+
+  LOG(info) << "Creating PackedBinaryArchive (mode = " << mode_ << ") from directory "
+            << directory_;
+
+  containerFile_ = directory_ / (prefix_ + ".pack");
+  hash_ = HashFactory::create(HashFactory::defaultHash());
+
+  try {
+    bool isDir = filesystem::is_directory(directory_);
+
+    switch(mode_) {
+    // We are reading, the directory needs to exist
+    case OpenModeKind::Read:
+      if(!isDir)
+        throw Exception("no such directory: '%s'", directory_.string());
+      break;
+    // We are writing or appending, create directories if it they don't exist
+    case OpenModeKind::Write:
+    case OpenModeKind::Append:
+      if(!isDir)
+        filesystem::create_directories(directory_);
+      break;
+    }
+  } catch(filesystem::filesystem_error& e) {
+    throw Exception(e.what());
+  }
+
+  bool exists = filesystem::exists(containerFile_);
+
+  if(mode_ == OpenModeKind::Read && !exists)
+    throw Exception("archive container not found in directory '%s'", directory_.string());
+
+  if(mode_ == OpenModeKind::Write || !exists) {
+    createContainer();
+    return;
+  }
+
+  // Read the field table of the existing container
+  std::string hashName;
+  endOffset_ = loadFieldTable(containerFile_.string(), fieldTable_, hashName, recovered_);
+  hash_ = HashFactory::create(hashName);
+  rebuildGroupTable();
+
+  // Drop the index (it is rewritten on close) and any partially written block
+  if(mode_ == OpenModeKind::Append) {
+    filesystem::resize_file(containerFile_, endOffset_);
+    stream_.open(containerFile_.string(), std::ios::out | std::ios::in | std::ios::binary);
+    if(!stream_.is_open())
+      throw Exception("cannot open file: '%s'", containerFile_.string());
+  }
+}
+
+PackedBinaryArchive::~PackedBinaryArchive() {
+  if(mode_ == OpenModeKind::Read)
+    return;
+
+  try {
+    writeIndex();
+  } catch(Exception& e) {
+    LOG(warning) << "PackedBinaryArchive: " << e.what();
+  }
+}
+
+void PackedBinaryArchive::createContainer() {
+  if(stream_.is_open())
+    stream_.close();
+
+  stream_.open(containerFile_.string(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if(!stream_.is_open())
+    throw Exception("cannot open file: '%s'", containerFile_.string());
+
+  fieldTable_.clear();
+  groupTable_.clear();
+  currentSavepoint_.reset();
+  indexWritten_ = false;
+  endOffset_ = writeFileHeader(stream_, hash_->name(), Alignment);
+  stream_.flush();
+}
+
+void PackedBinaryArchive::rebuildGroupTable() {
+  groupTable_.clear();
+  for(const auto& fieldPair : fieldTable_)
+    for(const BlockEntry& entry : fieldPair.second) {
+      if(entry.group >= groupTable_.size())
+        groupTable_.resize(entry.group + 1, SavepointGroup{0, 0});
+
+      SavepointGroup& group = groupTable_[entry.group];
+      std::uint64_t end = entry.offset + entry.length;
+      if(group.length == 0) {
+        group.offset = entry.offset;
+        group.length = entry.length;
+      } else {
+        end = std::max(end, group.offset + group.length);
+        group.offset = std::min(group.offset, entry.offset);
+        group.length = end - group.offset;
+      }
+    }
+}
+
+void PackedBinaryArchive::writeIndex() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if(!stream_.is_open())
+    return;
+
+  LOG(info) << "Writing index of PackedBinaryArchive";
+
+  stream_.seekp(endOffset_);
+  writeIndexFooter(stream_, endOffset_, fieldTable_);
+  stream_.flush();
+  indexWritten_ = true;
+
+  if(!stream_.good())
+    throw Exception("failed to write index to '%s'", containerFile_.string());
+}
+
+void PackedBinaryArchive::updateMetaData() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if(stream_.is_open())
+    stream_.flush();
+}
+
+//===------------------------------------------------------------------------------------------===//
+//     Writing
+//===------------------------------------------------------------------------------------------===//
+
+FieldID PackedBinaryArchive::write(const StorageView& storageView, const std::string& field,
+                                   const std::shared_ptr<FieldMetainfoImpl> info) {
+  return writeImpl(storageView, field, nullptr);
+}
+
+FieldID PackedBinaryArchive::write(const StorageView& storageView, const std::string& field,
+                                   const std::shared_ptr<FieldMetainfoImpl> info,
+                                   const SavepointImpl& savepoint) {
+  return writeImpl(storageView, field, &savepoint);
+}
+
+FieldID PackedBinaryArchive::writeImpl(const StorageView& storageView, const std::string& field,
+                                       const SavepointImpl* savepoint) {
+  if(mode_ == OpenModeKind::Read)
+    throw Exception("Archive is not initialized with OpenModeKind set to 'Write' or 'Append'");
+
+  LOG(info) << "Attempting to write field \"" << field << "\" to PackedBinaryArchive ...";
+
+  // Create binary data buffer and compute the hash (this does not require any locking)
+  BinaryBuffer binaryBuffer(bufferPool_, storageView);
+  binaryBuffer.copyStorageViewToBuffer(storageView);
+
+  std::string checksum(hash_->hash(binaryBuffer.data(), binaryBuffer.size()));
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The field is only added to the table once its block has been written
+  auto fieldIt = fieldTable_.find(field);
+  FieldID fieldID{field, 0};
+
+  if(fieldIt != fieldTable_.end()) {
+    const FieldOffsetTable& fieldOffsetTable = fieldIt->second;
+    fieldID.id = fieldOffsetTable.size();
+
+    // Check if field has already been serialized by comparing the checksum
+    for(std::size_t i = 0; i < fieldOffsetTable.size(); ++i)
+      if(checksum == fieldOffsetTable[i].checksum) {
+        LOG(info) << "Field \"" << field << "\" already serialized (id = " << i << "). Stopping";
+        fieldID.id = i;
+        return fieldID;
+      }
+  }
+
+  // Drop a previously written index, it will be rewritten on close
+  if(indexWritten_) {
+    filesystem::resize_file(containerFile_, endOffset_);
+    indexWritten_ = false;
+  }
+
+  // Start a new savepoint group if the savepoint changed (writes without a savepoint are added to
+  // the current group)
+  bool newGroup = groupTable_.empty();
+  if(savepoint && (!currentSavepoint_ || *currentSavepoint_ != *savepoint))
+    newGroup = true;
+
+  // Append the block
+  std::uint32_t group = newGroup ? groupTable_.size() : groupTable_.size() - 1;
+  std::uint64_t offset = endOffset_;
+  stream_.seekp(offset);
+  std::uint64_t dataOffset = writeBlock(stream_, offset, Alignment, field, fieldID.id, checksum,
+                                        group, binaryBuffer.data(), binaryBuffer.size());
+  stream_.flush();
+
+  if(!stream_.good())
+    throw Exception("failed to write field '%s' to '%s'", field, containerFile_.string());
+
+  endOffset_ = offset;
+  fieldTable_[field].push_back(BlockEntry{dataOffset, binaryBuffer.size(), checksum, group});
+
+  if(savepoint && newGroup)
+    currentSavepoint_ = std::make_unique<SavepointImpl>(*savepoint);
+
+  if(newGroup)
+    groupTable_.push_back(SavepointGroup{dataOffset, binaryBuffer.size()});
+  else
+    groupTable_[group].length = dataOffset + binaryBuffer.size() - groupTable_[group].offset;
+
+  LOG(info) << "Successfully wrote field \"" << fieldID.name << "\" (id = " << fieldID.id
+            << ") to " << containerFile_.filename();
+  return fieldID;
+}
+
+void PackedBinaryArchive::writeToFile(std::string filename, const StorageView& storageView,
+                                      std::string field) {
+  // Create binary data buffer (there is nothing to reuse, hence the pool does not cache anything)
+  BufferPool pool(0);
+  BinaryBuffer binaryBuffer(pool, storageView);
+  binaryBuffer.copyStorageViewToBuffer(storageView);
+
+  auto hash = HashFactory::create(HashFactory::defaultHash());
+  std::string checksum(hash->hash(binaryBuffer.data(), binaryBuffer.size()));
+
+  std::ofstream fs(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+  if(!fs.is_open())
+    throw Exception("cannot open file: '%s'", filename);
+
+  std::uint64_t offset = writeFileHeader(fs, hash->name(), Alignment);
+  std::uint64_t dataOffset = writeBlock(fs, offset, Alignment, field, 0, checksum, 0,
+                                        binaryBuffer.data(), binaryBuffer.size());
+
+  FieldTable fieldTable;
+  fieldTable[field].push_back(BlockEntry{dataOffset, binaryBuffer.size(), checksum, 0});
+  writeIndexFooter(fs, offset, fieldTable);
+  fs.close();
+}
+
+//===------------------------------------------------------------------------------------------===//
+//     Reading
+//===------------------------------------------------------------------------------------------===//
+
+namespace {
+
+void checkBlockLength(const PackedBinaryArchive::BlockEntry& entry,
+                      const BinaryBuffer& binaryBuffer, const FieldID& fieldID) {
+  if(binaryBuffer.offset() + binaryBuffer.size() > entry.length)
+    throw Exception("field '%s' (id = %i) is smaller than the requested storage", fieldID.name,
+                    fieldID.id);
+}
+
+void readBlock(const std::string& filename, const PackedBinaryArchive::BlockEntry& entry,
+               BinaryBuffer& binaryBuffer, const FieldID& fieldID) {
+  checkBlockLength(entry, binaryBuffer, fieldID);
+
+  std::ifstream fs(filename, std::ios::in | std::ios::binary);
+  if(!fs.is_open())
+    throw Exception("cannot open file: '%s'", filename);
+
+  fs.seekg(entry.offset + binaryBuffer.offset());
+  if(!fs.read(binaryBuffer.data(), binaryBuffer.size()))
+    throw Exception("failed to read field '%s' (id = %i) from '%s'", fieldID.name, fieldID.id,
+                    filename);
+}
+
+} // anonymous namespace
+
+std::shared_ptr<const PackedBinaryArchive::CachedGroup>
+PackedBinaryArchive::loadGroup(std::uint32_t group, const SavepointGroup& range) const {
+  LOG(info) << "Loading savepoint group " << group << " (" << range.length << " bytes)";
+
+  auto cachedGroup = std::make_shared<CachedGroup>();
+  cachedGroup->group = group;
+  cachedGroup->range = range;
+  cachedGroup->data.reset(new Byte[range.length]);
+
+  std::ifstream fs(containerFile_.string(), std::ios::in | std::ios::binary);
+  if(!fs.is_open())
+    throw Exception("cannot open file: '%s'", containerFile_.string());
+
+  fs.seekg(range.offset);
+  if(!fs.read(cachedGroup->data.get(), range.length))
+    throw Exception("failed to read savepoint group %i from '%s'", group, containerFile_.string());
+  return cachedGroup;
+}
+
+int PackedBinaryArchive::cachedGroup() const {
+  std::lock_guard<std::mutex> lock(cacheMutex_);
+  return cachedGroup_ ? int(cachedGroup_->group) : -1;
+}
+
+void PackedBinaryArchive::read(StorageView& storageView, const FieldID& fieldID,
+                               std::shared_ptr<FieldMetainfoImpl> info) const {
+  LOG(info) << "Attempting to read field \"" << fieldID.name << "\" (id = " << fieldID.id
+            << ") via PackedBinaryArchive ... ";
+
+  BlockEntry entry;
+  SavepointGroup range{0, 0};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = fieldTable_.find(fieldID.name);
+    if(it == fieldTable_.end())
+      throw Exception("no field '%s' registered in PackedBinaryArchive", fieldID.name);
+
+    if(fieldID.id >= it->second.size())
+      throw Exception("invalid id '%i' of field '%s'", fieldID.id, fieldID.name);
+
+    entry = it->second[fieldID.id];
+    if(entry.group < groupTable_.size())
+      range = groupTable_[entry.group];
+  }
+
+  BinaryBuffer binaryBuffer(bufferPool_, storageView);
+
+  // Load the whole savepoint group with a single read, subsequent fields of the same savepoint are
+  // then copied from memory. Reads of earlier groups (i.e deduplicated fields) and slices do not
+  // replace the loaded group.
+  std::shared_ptr<const CachedGroup> cachedGroup;
+  if(range.length > 0 && entry.offset >= range.offset &&
+     entry.offset + entry.length <= range.offset + range.length) {
+    bool load = false;
+    {
+      std::lock_guard<std::mutex> lock(cacheMutex_);
+      if(cachedGroup_ && cachedGroup_->group == entry.group &&
+         cachedGroup_->range.offset == range.offset && cachedGroup_->range.length == range.length)
+        cachedGroup = cachedGroup_;
+      else
+        load = range.length <= savepointCacheLimit_ && binaryBuffer.offset() == 0 &&
+               binaryBuffer.size() == entry.length &&
+               (!cachedGroup_ || entry.group >= cachedGroup_->group);
+    }
+
+    if(load) {
+      checkBlockLength(entry, binaryBuffer, fieldID);
+      cachedGroup = loadGroup(entry.group, range);
+
+      std::lock_guard<std::mutex> lock(cacheMutex_);
+      if(!cachedGroup_ || entry.group >= cachedGroup_->group)
+        cachedGroup_ = cachedGroup;
+    }
+  }
+
+  if(cachedGroup) {
+    checkBlockLength(entry, binaryBuffer, fieldID);
+    std::memcpy(binaryBuffer.data(),
+                cachedGroup->data.get() + (entry.offset - range.offset) + binaryBuffer.offset(),
+                binaryBuffer.size());
+  } else {
+    readBlock(containerFile_.string(), entry, binaryBuffer, fieldID);
+  }
+  binaryBuffer.copyBufferToStorageView(storageView);
+
+  LOG(info) << "Successfully read field \"" << fieldID.name << "\" (id = " << fieldID.id << ")";
+}
+
+void PackedBinaryArchive::prefetch(const FieldID& fieldID,
+                                   std::shared_ptr<FieldMetainfoImpl> info) const {
+  BlockEntry entry;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = fieldTable_.find(fieldID.name);
+    if(it == fieldTable_.end())
+      throw Exception("no field '%s' registered in PackedBinaryArchive", fieldID.name);
+
+    if(fieldID.id >= it->second.size())
+      throw Exception("invalid id '%i' of field '%s'", fieldID.id, fieldID.name);
+
+    entry = it->second[fieldID.id];
+  }
+  adviseWillNeed(containerFile_.string(), entry.offset, entry.length);
+}
+
+void PackedBinaryArchive::readFromFile(std::string filename, StorageView& storageView,
+                                       std::string field) {
+  if(!filesystem::exists(filename))
+    throw Exception("cannot open %s: file does not exist", filename);
+
+  FieldTable fieldTable;
+  std::string hashName;
+  bool recovered;
+  loadFieldTable(filename, fieldTable, hashName, recovered);
+
+  auto it = fieldTable.find(field);
+  if(it == fieldTable.end() && fieldTable.size() == 1)
+    it = fieldTable.begin();
+
+  if(it == fieldTable.end() || it->second.empty())
+    throw Exception("no field '%s' in '%s'", field, filename);
+
+  BufferPool pool(0);
+  BinaryBuffer binaryBuffer(pool, storageView);
+  readBlock(filename, it->second[0], binaryBuffer, FieldID{it->first, 0});
+  binaryBuffer.copyBufferToStorageView(storageView);
+}
+
+std::ostream& PackedBinaryArchive::toStream(std::ostream& stream) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stream << "PackedBinaryArchive = {\n";
+  stream << "  directory: " << directory_.string() << "\n";
+  stream << "  mode: " << mode_ << "\n";
+  stream << "  prefix: " << prefix_ << "\n";
+  stream << "  fieldsTable = {\n";
+  for(auto it = fieldTable_.begin(), end = fieldTable_.end(); it != end; ++it) {
+    stream << "    " << it->first << " = {\n";
+    for(std::size_t id = 0; id < it->second.size(); ++id)
+      stream << "      [ " << it->second[id].offset << ", " << it->second[id].length << ", "
+             << it->second[id].checksum << ", " << it->second[id].group << " ]\n";
+    stream << "    }\n";
+  }
+  stream << "  }\n";
+  stream << "}\n";
+  return stream;
+}
+
+void PackedBinaryArchive::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if(mode_ == OpenModeKind::Read) {
+    fieldTable_.clear();
+    groupTable_.clear();
+  } else
+    createContainer();
+
+  std::lock_guard<std::mutex> cacheLock(cacheMutex_);
+  cachedGroup_.reset();
+}
+
+std::unique_ptr<Archive> PackedBinaryArchive::create(OpenModeKind mode,
+                                                     const std::string& directory,
+                                                     const std::string& prefix) {
+  return std::make_unique<PackedBinaryArchive>(mode, directory, prefix);
+}
+
+} // namespace serialbox
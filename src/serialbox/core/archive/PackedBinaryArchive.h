@@ -0,0 +1,258 @@
+//===-- serialbox/core/archive/PackedBinaryArchive.h --------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements the non-portable single-file binary archive.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_ARCHIVE_PACKEDBINARYARCHIVE_H
+#define SERIALBOX_CORE_ARCHIVE_PACKEDBINARYARCHIVE_H
+
+#include "serialbox/core/Filesystem.h"
+#include "serialbox/core/archive/Archive.h"
+#include "serialbox/core/archive/BufferPool.h"
+#include "serialbox/core/hash/Hash.h"
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace serialbox {
+
+/// \brief Non-portable binary archive storing all fields in a single container file
+///
+/// In contrast to the BinaryArchive, which creates one file per field, all data is appended to
+/// the container file `prefix.pack`. The container is laid out as follows:
+///
+/// \verbatim
+///   [ file header ]                                   (padded to the alignment)
+///   [ block header | name | checksum ] [ data ]       (each padded to the alignment)
+///   ...
+///   [ index ] [ trailer: offset of the index, magic ]
+/// \endverbatim
+///
+/// Each data block is preceded by a small header describing the field, id, length and checksum of
+/// the block. The index (a copy of all block headers including the offsets) is only written when
+/// the archive is closed (i.e destructed). If the index is missing, e.g because the writing
+/// process crashed, the archive is recovered by scanning the block headers.
+///
+/// Data is appended in the order it is written which results in a savepoint-major layout: all
+/// fields written at the same savepoint form a contiguous savepoint group. Deduplicated fields
+/// are not copied but refer to the block of the earlier savepoint. When reading, the whole group
+/// of the requested field is loaded with a single read and kept in memory, so loading all fields
+/// of a savepoint results in one sequential read (plus one read for each group referenced by a
+/// deduplicated field). Interleaved writes of different savepoints split a savepoint into several
+/// groups.
+///
+/// \ingroup core
+class PackedBinaryArchive : public Archive {
+public:
+  /// \brief Name of the packed binary archive
+  static const std::string Name;
+
+  /// \brief Revision of the packed binary archive
+  static const int Version;
+
+  /// \brief Alignment in bytes of all headers and data blocks
+  static const std::uint32_t Alignment;
+
+  /// \brief Default upper bound of the size of savepoint groups loaded at once (128 MB)
+  static const std::size_t DefaultSavepointCacheLimit;
+
+  /// \brief Location of a data block within the container
+  struct BlockEntry {
+    std::uint64_t offset; ///< Offset of the data within the container
+    std::uint64_t length; ///< Length of the data in bytes
+    std::string checksum; ///< Checksum of the data
+    std::uint32_t group;  ///< Savepoint group of the block
+  };
+
+  /// \brief Contiguous range of the container holding the blocks written at one savepoint
+  struct SavepointGroup {
+    std::uint64_t offset; ///< Offset of the data of the first block
+    std::uint64_t length; ///< Length of the range in bytes (up to the end of the last block)
+  };
+
+  /// \brief Table of all savepoint groups (indexed by group)
+  using GroupTable = std::vector<SavepointGroup>;
+
+  /// \brief Table of ids and corresponding data blocks of a field
+  using FieldOffsetTable = std::vector<BlockEntry>;
+
+  /// \brief Table of all fields stored in the container
+  using FieldTable = std::unordered_map<std::string, FieldOffsetTable>;
+
+  /// \brief Initialize the archive
+  ///
+  /// \param mode          Policy to open files in the archive
+  /// \param directory     Directory to write/read the container. If the archive is opened in
+  ///                      ´Read´ mode, the directory is expected to supply a ´prefix.pack´. In
+  ///                      case the archive is opened in ´Write´ mode, an existing container is
+  ///                      discarded, if the directory is non-existent, it will be created.
+  ///                      The ´Append´ mode will continue an existing container.
+  /// \param prefix        Prefix of the container
+  PackedBinaryArchive(OpenModeKind mode, const std::string& directory, const std::string& prefix);
+
+  /// \brief Copy constructor [deleted]
+  PackedBinaryArchive(const PackedBinaryArchive&) = delete;
+
+  /// \brief Copy assignment [deleted]
+  PackedBinaryArchive& operator=(const PackedBinaryArchive&) = delete;
+
+  /// \brief Write the index and close the container
+  virtual ~PackedBinaryArchive();
+
+  /// \brief Write the index footer to the container
+  ///
+  /// This is done automatically on destruction. Subsequent writes will overwrite the index.
+  void writeIndex();
+
+  /// \name Archive implementation
+  /// \see Archive
+  /// @{
+  virtual FieldID write(const StorageView& storageView, const std::string& fieldID,
+                        const std::shared_ptr<FieldMetainfoImpl> info) override;
+
+  /// \brief Write the field and start a new savepoint group if `savepoint` differs from the
+  /// savepoint of the previous write
+  virtual FieldID write(const StorageView& storageView, const std::string& fieldID,
+                        const std::shared_ptr<FieldMetainfoImpl> info,
+                        const SavepointImpl& savepoint) override;
+
+  virtual void read(StorageView& storageView, const FieldID& fieldID,
+                    std::shared_ptr<FieldMetainfoImpl> info) const override;
+
+  /// \brief Advise the kernel to read the data of the field into the page cache
+  virtual void prefetch(const FieldID& fieldID,
+                        std::shared_ptr<FieldMetainfoImpl> info) const override;
+
+  /// \brief Flush the container (the index is only written on close)
+  virtual void updateMetaData() override;
+
+  virtual OpenModeKind mode() const override { return mode_; }
+
+  virtual std::string directory() const override { return directory_.string(); }
+
+  virtual std::string prefix() const override { return prefix_; }
+
+  virtual std::string name() const override { return PackedBinaryArchive::Name; }
+
+  virtual std::string metaDataFile() const override { return containerFile_.string(); }
+
+  virtual std::ostream& toStream(std::ostream& stream) const override;
+
+  virtual void clear() override;
+
+  virtual bool isReadingThreadSafe() const override { return true; }
+
+  virtual bool isWritingThreadSafe() const override { return true; }
+
+  virtual bool isSlicedReadingSupported() const override { return true; }
+
+  /// @}
+
+  /// \brief Check if the field table was recovered by scanning the container (i.e the index was
+  /// missing)
+  bool isRecovered() const noexcept { return recovered_; }
+
+  /// \brief Get field table
+  const FieldTable& fieldTable() const noexcept { return fieldTable_; }
+
+  /// \brief Get table of savepoint groups
+  const GroupTable& groupTable() const noexcept { return groupTable_; }
+
+  /// \brief Set the upper bound of the size of savepoint groups which are loaded at once
+  ///
+  /// Fields of larger groups are read individually, a limit of 0 disables loading of groups.
+  ///
+  /// Only the savepoint group being replayed is held in memory: a group is loaded by the first
+  /// (unsliced) read of a field of a later group. Fields deduplicated into earlier groups and
+  /// slices are read individually unless their group is already loaded.
+  void setSavepointCacheLimit(std::size_t bytes) noexcept { savepointCacheLimit_ = bytes; }
+
+  /// \brief Get the upper bound of the size of savepoint groups which are loaded at once
+  std::size_t savepointCacheLimit() const noexcept { return savepointCacheLimit_; }
+
+  /// \brief Get the savepoint group held in memory (-1 if no group is loaded)
+  int cachedGroup() const;
+
+  /// \brief Create a PackedBinaryArchive
+  static std::unique_ptr<Archive> create(OpenModeKind mode, const std::string& directory,
+                                         const std::string& prefix);
+
+  /// \brief Directly write field (given by `storageView`) to a new container `filename`
+  ///
+  /// \param filename     Newly created file (if file already exists, it's contents will be
+  ///                     discarded)
+  /// \param storageView  StorageView of the field
+  /// \param field        Name of the field
+  static void writeToFile(std::string filename, const StorageView& storageView,
+                          std::string field);
+
+  /// \brief Directly read field (given by `storageView`) from the container `filename`
+  ///
+  /// \param filename     File to read from
+  /// \param storageView  StorageView of the field
+  /// \param field        Name of the field (if the container holds only a single field, the
+  ///                     name is ignored)
+  static void readFromFile(std::string filename, StorageView& storageView, std::string field);
+
+private:
+  /// \brief Create a new container (discarding existing contents)
+  void createContainer();
+
+  /// \brief Append the field to the container (`savepoint` can be a `nullptr`)
+  FieldID writeImpl(const StorageView& storageView, const std::string& field,
+                    const SavepointImpl* savepoint);
+
+  /// \brief Compute the savepoint groups from the field table
+  void rebuildGroupTable();
+
+  /// \brief Savepoint group loaded into memory
+  struct CachedGroup {
+    std::uint32_t group;
+    SavepointGroup range;
+    std::unique_ptr<Byte[]> data;
+  };
+
+  /// \brief Load the savepoint `group` from disk
+  std::shared_ptr<const CachedGroup> loadGroup(std::uint32_t group,
+                                               const SavepointGroup& range) const;
+
+  OpenModeKind mode_;
+  filesystem::path directory_;
+  std::string prefix_;
+  filesystem::path containerFile_;
+
+  std::unique_ptr<Hash> hash_;
+  FieldTable fieldTable_;
+  GroupTable groupTable_;
+  bool recovered_;
+
+  // Guards the field table and the container stream
+  mutable std::mutex mutex_;
+  std::ofstream stream_;
+  std::uint64_t endOffset_;
+  bool indexWritten_;
+  std::unique_ptr<SavepointImpl> currentSavepoint_;
+
+  // Savepoint group being replayed (the lock is not held while loading a group)
+  std::size_t savepointCacheLimit_;
+  mutable std::mutex cacheMutex_;
+  mutable std::shared_ptr<const CachedGroup> cachedGroup_;
+
+  mutable BufferPool bufferPool_;
+};
+
+} // namespace serialbox
+
+#endif
@@ -0,0 +1,50 @@
+//===-- serialbox/core/archive/Readahead.h ------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the utility to hint upcoming reads of files to the kernel.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_ARCHIVE_READAHEAD_H
+#define SERIALBOX_CORE_ARCHIVE_READAHEAD_H
+
+#include <cstdint>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+
+namespace serialbox {
+
+/// \brief Advise the kernel that the bytes [`offset`, `offset + length`) of `filename` will be
+/// read soon
+///
+/// The kernel starts reading the range into the page cache in the background and the function
+/// returns immediately. A `length` of 0 covers the range up to the end of the file. Failures
+/// (e.g a missing file or an unsupported platform) are ignored as the advice is only a hint.
+///
+/// \ingroup core
+inline void adviseWillNeed(const std::string& filename, std::uint64_t offset,
+                           std::uint64_t length) noexcept {
+#ifdef POSIX_FADV_WILLNEED
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if(fd < 0)
+    return;
+  (void)::posix_fadvise(fd, offset, length, POSIX_FADV_WILLNEED);
+  ::close(fd);
+#else
+  (void)filename;
+  (void)offset;
+  (void)length;
+#endif
+}
+
+} // namespace serialbox
+
+#endif
@@ -0,0 +1,64 @@
+//===-- serialbox/core/compression/Codec.h ------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the interface of compression codecs.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_COMPRESSION_CODEC_H
+#define SERIALBOX_CORE_COMPRESSION_CODEC_H
+
+#include "serialbox/core/Type.h"
+#include <cstddef>
+
+namespace serialbox {
+
+/// \brief Lossless compression codec interface
+///
+/// Codecs are stateless, i.e `compress` and `decompress` may be called concurrently.
+///
+/// \ingroup core
+class Codec {
+public:
+  virtual ~Codec() {}
+
+  /// \brief Get identifier of the codec as used in the CodecFactory
+  virtual const char* name() const noexcept = 0;
+
+  /// \brief Upper bound of the compressed size of `size` bytes
+  virtual std::size_t maxCompressedSize(std::size_t size) const noexcept = 0;
+
+  /// \brief Compress `size` bytes of `src` into `dst`
+  ///
+  /// \param src       Uncompressed data
+  /// \param size      Length of the uncompressed data in bytes
+  /// \param dst       Destination buffer of at least `maxCompressedSize(size)` bytes
+  /// \param capacity  Length of the destination buffer in bytes
+  /// \return Length of the compressed data in bytes
+  ///
+  /// \throw Exception  Compression failed
+  virtual std::size_t compress(const Byte* src, std::size_t size, Byte* dst,
+                               std::size_t capacity) const = 0;
+
+  /// \brief Decompress `size` bytes of `src` into `dst`
+  ///
+  /// \param src       Compressed data
+  /// \param size      Length of the compressed data in bytes
+  /// \param dst       Destination buffer
+  /// \param dstSize   Length of the uncompressed data in bytes
+  ///
+  /// \throw Exception  The data is corrupted or does not decompress to exactly `dstSize` bytes
+  virtual void decompress(const Byte* src, std::size_t size, Byte* dst,
+                          std::size_t dstSize) const = 0;
+};
+
+} // namespace serialbox
+
+#endif
@@ -0,0 +1,60 @@
+//===-- serialbox/core/compression/CodecFactory.cpp ---------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements the factory of compression codecs.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/compression/CodecFactory.h"
+#include "serialbox/core/Exception.h"
+#include "serialbox/core/STLExtras.h"
+#include "serialbox/core/compression/LZ4Codec.h"
+#include "serialbox/core/compression/LZCodec.h"
+#include "serialbox/core/compression/ZstdCodec.h"
+#include <sstream>
+
+namespace serialbox {
+
+std::unique_ptr<Codec> CodecFactory::create(const std::string& name) {
+  if(name == LZCodec::Name) {
+    return std::make_unique<LZCodec>();
+  }
+#ifdef SERIALBOX_HAS_ZSTD
+  else if(name == ZstdCodec::Name) {
+    return std::make_unique<ZstdCodec>();
+  }
+#endif
+#ifdef SERIALBOX_HAS_LZ4
+  else if(name == LZ4Codec::Name) {
+    return std::make_unique<LZ4Codec>();
+  }
+#endif
+  else {
+    std::stringstream ss;
+    ss << "cannot create Codec '" << name << "': codec does not exist or is not registred.\n";
+    ss << "Registered codecs:\n";
+    for(const auto& codec : CodecFactory::registeredCodecs())
+      ss << " " << codec << "\n";
+    throw Exception(ss.str().c_str());
+  }
+}
+
+std::vector<std::string> CodecFactory::registeredCodecs() {
+  std::vector<std::string> codecs{LZCodec::Name};
+#ifdef SERIALBOX_HAS_ZSTD
+  codecs.push_back(ZstdCodec::Name);
+#endif
+#ifdef SERIALBOX_HAS_LZ4
+  codecs.push_back(LZ4Codec::Name);
+#endif
+  return codecs;
+}
+
+} // namespace serialbox
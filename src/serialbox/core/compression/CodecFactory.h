@@ -0,0 +1,46 @@
+//===-- serialbox/core/compression/CodecFactory.h -----------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the factory of compression codecs.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_COMPRESSION_CODECFACTORY_H
+#define SERIALBOX_CORE_COMPRESSION_CODECFACTORY_H
+
+#include "serialbox/core/compression/Codec.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace serialbox {
+
+/// \brief Factory to create compression codecs
+///
+/// \ingroup core
+class CodecFactory {
+  CodecFactory() = delete;
+
+public:
+  /// \brief Construct an instance of the Codec `name`
+  ///
+  /// \param name        Name of the Codec (as given by Codec::name())
+  /// \return Pointer to the newly constructed Codec with the requested dynamic-type
+  ///
+  /// \throw Exception   No Codec with given `name` exists or is registered
+  static std::unique_ptr<Codec> create(const std::string& name);
+
+  /// \brief Get a vector of strings of the registered (i.e available) codecs
+  static std::vector<std::string> registeredCodecs();
+};
+
+} // namespace serialbox
+
+#endif
@@ -0,0 +1,297 @@
+//===-- serialbox/core/compression/CodecPipeline.cpp --------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements the shuffle and compression pipeline of binary archives.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/compression/CodecPipeline.h"
+#include "serialbox/core/Exception.h"
+#include "serialbox/core/Parallel.h"
+#include "serialbox/core/STLExtras.h"
+#include "serialbox/core/compression/CodecFactory.h"
+#include "serialbox/core/compression/LZCodec.h"
+#include <algorithm>
+#include <cstring>
+
+namespace serialbox {
+
+//===------------------------------------------------------------------------------------------===//
+//     CodecInfo
+//===------------------------------------------------------------------------------------------===//
+
+std::uint64_t CodecInfo::compressedOffset(std::size_t block) const noexcept {
+  std::uint64_t offset = 0;
+  for(std::size_t i = 0; i < block; ++i)
+    offset += blocks[i];
+  return offset;
+}
+
+double CodecInfo::ratio() const noexcept {
+  std::uint64_t compressed = compressedSize();
+  return compressed == 0 ? 1.0 : double(size) / compressed;
+}
+
+std::uint64_t CodecInfo::uncompressedSize(std::size_t block) const noexcept {
+  return std::min(blockSize, size - block * blockSize);
+}
+
+//===------------------------------------------------------------------------------------------===//
+//     CodecPipeline
+//===------------------------------------------------------------------------------------------===//
+
+const char* CodecPipeline::CodecKey = "__codec";
+
+const char* CodecPipeline::ShuffleKey = "__shuffle";
+
+const char* CodecPipeline::BlockSizeKey = "__codec_block_size";
+
+const char* CodecPipeline::AbsErrorKey = "__lossy_abs_error";
+
+const char* CodecPipeline::RelErrorKey = "__lossy_rel_error";
+
+const char* CodecPipeline::DeltaKey = "__delta";
+
+const char* CodecPipeline::KeyframeIntervalKey = "__keyframe_interval";
+
+const int CodecPipeline::DefaultKeyframeInterval = 16;
+
+const std::size_t CodecPipeline::DefaultBlockSize = 1 << 20;
+
+CodecPipeline::CodecPipeline(const std::string& codec, int shuffle, std::size_t blockSize)
+    : codec_(CodecFactory::create(codec)), shuffle_(shuffle > 1 ? shuffle : 0),
+      keyframeInterval_(0), numThreads_(1) {
+  if(blockSize == 0)
+    throw Exception("invalid block size of codec pipeline: %i", blockSize);
+
+  // Blocks need to hold whole elements to be shuffled independently
+  if(shuffle_)
+    blockSize = std::max<std::size_t>(blockSize / shuffle_, 1) * shuffle_;
+  blockSize_ = blockSize;
+}
+
+std::unique_ptr<CodecPipeline> CodecPipeline::create(const FieldMetainfoImpl* info, TypeID type) {
+  if(!info)
+    return nullptr;
+
+  const MetainfoMapImpl& metaInfo = info->metaInfo();
+
+  ErrorBoundKind errorBoundKind = ErrorBoundKind::None;
+  double errorBound = 0.0;
+  if(metaInfo.hasKey(AbsErrorKey) && metaInfo.hasKey(RelErrorKey))
+    throw Exception("lossy compression requires either an absolute or a relative error bound");
+
+  if(metaInfo.hasKey(AbsErrorKey)) {
+    errorBoundKind = ErrorBoundKind::Absolute;
+    errorBound = metaInfo.as<double>(AbsErrorKey);
+  } else if(metaInfo.hasKey(RelErrorKey)) {
+    errorBoundKind = ErrorBoundKind::Relative;
+    errorBound = metaInfo.as<double>(RelErrorKey);
+  }
+
+  int keyframeInterval = 0;
+  if(metaInfo.hasKey(DeltaKey) && metaInfo.as<bool>(DeltaKey)) {
+    keyframeInterval = DefaultKeyframeInterval;
+    if(metaInfo.hasKey(KeyframeIntervalKey)) {
+      keyframeInterval = metaInfo.as<int>(KeyframeIntervalKey);
+      if(keyframeInterval <= 0)
+        throw Exception("invalid keyframe interval of delta encoding: %i", keyframeInterval);
+    }
+  }
+
+  // Lossy compression and delta encoding default to the in-tree codec
+  std::string codec;
+  if(metaInfo.hasKey(CodecKey))
+    codec = metaInfo.as<std::string>(CodecKey);
+  else if(errorBoundKind != ErrorBoundKind::None || keyframeInterval > 0)
+    codec = LZCodec::Name;
+
+  if(codec.empty() || codec == "none") {
+    if(errorBoundKind != ErrorBoundKind::None)
+      throw Exception("lossy compression requires a codec");
+    if(keyframeInterval > 0)
+      throw Exception("delta encoding requires a codec");
+    return nullptr;
+  }
+
+  bool shuffle = metaInfo.hasKey(ShuffleKey) ? metaInfo.as<bool>(ShuffleKey) : true;
+
+  int blockSize = DefaultBlockSize;
+  if(metaInfo.hasKey(BlockSizeKey)) {
+    blockSize = metaInfo.as<int>(BlockSizeKey);
+    if(blockSize <= 0)
+      throw Exception("invalid block size of codec pipeline: %i", blockSize);
+  }
+
+  const int bytesPerElement = TypeUtil::sizeOf(type);
+  auto pipeline =
+      std::make_unique<CodecPipeline>(codec, shuffle ? bytesPerElement : 0, blockSize);
+
+  if(errorBoundKind != ErrorBoundKind::None)
+    pipeline->setLossyFilter(std::make_unique<LossyFilter>(type, errorBoundKind, errorBound),
+                             bytesPerElement);
+  pipeline->setKeyframeInterval(keyframeInterval);
+  return pipeline;
+}
+
+void CodecPipeline::setLossyFilter(std::unique_ptr<LossyFilter> filter, int elementSize) {
+  lossyFilter_ = std::move(filter);
+  blockSize_ = std::max<std::size_t>(blockSize_ / elementSize, 1) * elementSize;
+}
+
+std::unique_ptr<CodecPipeline> CodecPipeline::create(const CodecInfo& info) {
+  return std::make_unique<CodecPipeline>(info.codec, info.shuffle, info.blockSize);
+}
+
+CodecInfo CodecPipeline::encode(const Byte* data, std::size_t size, BufferPool& pool,
+                                BufferPool::Buffer& output, const Byte* reference,
+                                Byte* reconstructed) const {
+  CodecInfo info;
+  info.codec = codec_->name();
+  info.shuffle = shuffle_;
+  info.blockSize = blockSize_;
+  info.size = size;
+  info.blocks.resize((size + blockSize_ - 1) / blockSize_);
+
+  std::vector<double> maxErrors(info.numBlocks(), 0.0);
+  if(lossyFilter_) {
+    info.errorBoundKind = lossyFilter_->kind();
+    info.errorBound = lossyFilter_->bound();
+  }
+
+  // Each block is compressed into its own slot of the output buffer
+  const std::size_t slotSize = std::max(codec_->maxCompressedSize(blockSize_), blockSize_);
+  output = pool.acquire(info.numBlocks() * slotSize);
+
+  auto encodeBlock = [&](std::size_t i) {
+    const std::size_t length = info.uncompressedSize(i);
+    const Byte* block = data + i * blockSize_;
+
+    // Round the values of a copy of the block
+    BufferPool::Buffer filtered;
+    if(lossyFilter_) {
+      filtered = pool.acquire(length);
+      std::memcpy(filtered.data(), block, length);
+      maxErrors[i] = lossyFilter_->apply(filtered.data(), length);
+      block = filtered.data();
+    }
+
+    if(reconstructed)
+      std::memcpy(reconstructed + i * blockSize_, block, length);
+
+    // Difference to the reference
+    if(reference) {
+      if(!filtered.data()) {
+        filtered = pool.acquire(length);
+        std::memcpy(filtered.data(), block, length);
+        block = filtered.data();
+      }
+      xorBytes(filtered.data(), reference + i * blockSize_, length);
+    }
+
+    BufferPool::Buffer shuffled;
+    if(shuffle_) {
+      shuffled = pool.acquire(length);
+      shuffleBytes(block, shuffled.data(), length, shuffle_);
+      block = shuffled.data();
+    }
+
+    Byte* slot = output.data() + i * slotSize;
+    std::size_t compressedSize = codec_->compress(block, length, slot, slotSize);
+
+    // Store incompressible blocks as is
+    if(compressedSize >= length) {
+      std::memcpy(slot, block, length);
+      compressedSize = length;
+    }
+    info.blocks[i] = compressedSize;
+  };
+  parallelFor(info.numBlocks(), encodeBlock, numThreads_);
+
+  // Compact the slots
+  std::uint64_t offset = 0;
+  for(std::size_t i = 0; i < info.numBlocks(); ++i) {
+    std::memmove(output.data() + offset, output.data() + i * slotSize, info.blocks[i]);
+    offset += info.blocks[i];
+  }
+
+  for(double maxError : maxErrors)
+    info.maxError = std::max(info.maxError, maxError);
+  return info;
+}
+
+void CodecPipeline::decode(const Byte* src, const CodecInfo& info, std::size_t firstBlock,
+                           std::size_t lastBlock, Byte* dst, BufferPool& pool,
+                           const Byte* reference) const {
+  if(lastBlock > info.numBlocks() || firstBlock > lastBlock)
+    throw Exception("invalid block range [%i, %i) of encoded data with %i blocks", firstBlock,
+                    lastBlock, info.numBlocks());
+
+  // Offsets of the compressed blocks relative to `src`
+  std::vector<std::uint64_t> offsets(lastBlock - firstBlock + 1, 0);
+  for(std::size_t i = firstBlock; i < lastBlock; ++i)
+    offsets[i - firstBlock + 1] = offsets[i - firstBlock] + info.blocks[i];
+
+  auto decodeBlock = [&](std::size_t n) {
+    const std::size_t i = firstBlock + n;
+    const std::size_t length = info.uncompressedSize(i);
+    const Byte* block = src + offsets[n];
+    Byte* out = dst + n * info.blockSize;
+
+    BufferPool::Buffer shuffled;
+    Byte* target = out;
+    if(shuffle_) {
+      shuffled = pool.acquire(length);
+      target = shuffled.data();
+    }
+
+    if(info.blocks[i] == length)
+      std::memcpy(target, block, length);
+    else
+      codec_->decompress(block, info.blocks[i], target, length);
+
+    if(shuffle_)
+      unshuffleBytes(target, out, length, shuffle_);
+
+    if(reference)
+      xorBytes(out, reference + n * info.blockSize, length);
+  };
+  parallelFor(lastBlock - firstBlock, decodeBlock, numThreads_);
+}
+
+void CodecPipeline::shuffleBytes(const Byte* src, Byte* dst, std::size_t size,
+                                 int elementSize) noexcept {
+  const std::size_t numElements = size / elementSize;
+  for(std::size_t i = 0; i < numElements; ++i)
+    for(int j = 0; j < elementSize; ++j)
+      dst[j * numElements + i] = src[i * elementSize + j];
+
+  // Trailing bytes (if any) are copied as is
+  const std::size_t shuffledSize = numElements * elementSize;
+  std::memcpy(dst + shuffledSize, src + shuffledSize, size - shuffledSize);
+}
+
+void CodecPipeline::xorBytes(Byte* dst, const Byte* src, std::size_t size) noexcept {
+  for(std::size_t i = 0; i < size; ++i)
+    dst[i] ^= src[i];
+}
+
+void CodecPipeline::unshuffleBytes(const Byte* src, Byte* dst, std::size_t size,
+                                   int elementSize) noexcept {
+  const std::size_t numElements = size / elementSize;
+  for(std::size_t i = 0; i < numElements; ++i)
+    for(int j = 0; j < elementSize; ++j)
+      dst[i * elementSize + j] = src[j * numElements + i];
+
+  const std::size_t shuffledSize = numElements * elementSize;
+  std::memcpy(dst + shuffledSize, src + shuffledSize, size - shuffledSize);
+}
+
+} // namespace serialbox
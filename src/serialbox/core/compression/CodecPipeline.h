@@ -0,0 +1,233 @@
+//===-- serialbox/core/compression/CodecPipeline.h ----------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the shuffle and compression pipeline of binary archives.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_COMPRESSION_CODECPIPELINE_H
+#define SERIALBOX_CORE_COMPRESSION_CODECPIPELINE_H
+
+#include "serialbox/core/FieldMetainfoImpl.h"
+#include "serialbox/core/archive/BufferPool.h"
+#include "serialbox/core/compression/Codec.h"
+#include "serialbox/core/compression/LossyFilter.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace serialbox {
+
+/// \brief Encoding of a stored field (recorded for each entry in the meta-data of the archive)
+///
+/// The data is split into blocks of `blockSize` bytes (the last block may be smaller) which are
+/// shuffled and compressed independently. Blocks which do not compress are stored as is, i.e
+/// their compressed size equals their uncompressed size.
+struct CodecInfo {
+  std::string codec;                 ///< Name of the codec (empty if the data is stored as is)
+  int shuffle = 0;                   ///< Element size of the byte-shuffle filter (0 if disabled)
+  std::uint64_t blockSize = 0;       ///< Uncompressed size of a block in bytes
+  std::uint64_t size = 0;            ///< Uncompressed size of the data in bytes
+  std::vector<std::uint64_t> blocks; ///< Compressed size of each block in bytes
+
+  ErrorBoundKind errorBoundKind = ErrorBoundKind::None; ///< Kind of the error bound (lossy data)
+  double errorBound = 0.0; ///< Error bound of lossy data
+  double maxError = 0.0;   ///< Achieved maximal (absolute or relative) error of lossy data
+
+  int deltaReference = -1; ///< Id of the reference of delta-encoded data (-1 if not delta-encoded)
+  int deltaDepth = 0;      ///< Number of references up to the next keyframe
+
+  /// \brief Check if the data is encoded (i.e not stored as is)
+  bool isEncoded() const noexcept { return !codec.empty(); }
+
+  /// \brief Check if the data was stored with a lossy filter
+  bool isLossy() const noexcept { return errorBoundKind != ErrorBoundKind::None; }
+
+  /// \brief Check if the data is stored as difference to the data of `deltaReference`
+  bool isDelta() const noexcept { return deltaReference >= 0; }
+
+  /// \brief Achieved compression ratio (uncompressed size / compressed size)
+  double ratio() const noexcept;
+
+  /// \brief Number of blocks
+  std::size_t numBlocks() const noexcept { return blocks.size(); }
+
+  /// \brief Offset of the compressed `block` relative to the first block
+  std::uint64_t compressedOffset(std::size_t block) const noexcept;
+
+  /// \brief Compressed size of all blocks
+  std::uint64_t compressedSize() const noexcept { return compressedOffset(blocks.size()); }
+
+  /// \brief Uncompressed size of `block`
+  std::uint64_t uncompressedSize(std::size_t block) const noexcept;
+};
+
+/// \brief Pipeline of a byte-shuffle filter followed by a compression codec
+///
+/// The pipeline of a field is configured with the following field meta-information:
+///
+/// Key                     | Type   | Description
+/// ----------------------- | ------ | ---------------------------------------------------------
+/// `__codec`               | string | Name of the codec (see CodecFactory) or `none` (default)
+/// `__shuffle`             | bool   | Shuffle bytes by significance before compression (default)
+/// `__codec_block_size`    | int    | Uncompressed size of a block in bytes (default 1 MB)
+/// `__lossy_abs_error`     | double | Absolute error bound of lossy compression (opt-in)
+/// `__lossy_rel_error`     | double | Relative error bound of lossy compression (opt-in)
+/// `__delta`               | bool   | Store the XOR difference to the previous id (opt-in)
+/// `__keyframe_interval`   | int    | Maximal distance of a delta-encoded id to a keyframe (16)
+///
+/// Lossy compression is only available for `Float32` and `Float64` fields (see LossyFilter) and
+/// uses the `lz` codec unless another codec is given. The bound is guaranteed for each value.
+///
+/// With delta encoding, every id (except for keyframes) is stored as the bitwise XOR with the
+/// previous id of the same field. Slowly changing fields result in long runs of zero bits which
+/// compress well. Reading has to decode the chain of references back to the last keyframe, hence
+/// the keyframe interval bounds the cost of random access. Delta encoding uses the `lz` codec
+/// unless another codec is given.
+///
+/// Blocks can be processed in parallel (see CodecPipeline::setNumThreads) and sliced reads decode
+/// only the blocks covering the slice.
+///
+/// \ingroup core
+class CodecPipeline {
+public:
+  /// \brief Field meta-information key of the codec
+  static const char* CodecKey;
+
+  /// \brief Field meta-information key of the byte-shuffle filter
+  static const char* ShuffleKey;
+
+  /// \brief Field meta-information key of the block size
+  static const char* BlockSizeKey;
+
+  /// \brief Field meta-information key of the absolute error bound
+  static const char* AbsErrorKey;
+
+  /// \brief Field meta-information key of the relative error bound
+  static const char* RelErrorKey;
+
+  /// \brief Field meta-information key of the delta encoding
+  static const char* DeltaKey;
+
+  /// \brief Field meta-information key of the keyframe interval of the delta encoding
+  static const char* KeyframeIntervalKey;
+
+  /// \brief Default keyframe interval of the delta encoding
+  static const int DefaultKeyframeInterval;
+
+  /// \brief Default uncompressed size of a block (1 MB)
+  static const std::size_t DefaultBlockSize;
+
+  /// \brief Construct the pipeline
+  ///
+  /// \param codec      Name of the codec
+  /// \param shuffle    Element size of the byte-shuffle filter (0 or 1 to disable)
+  /// \param blockSize  Uncompressed size of a block in bytes (rounded down to a multiple of the
+  ///                   element size)
+  CodecPipeline(const std::string& codec, int shuffle, std::size_t blockSize);
+
+  /// \brief Create the pipeline requested by the field meta-information `info`
+  ///
+  /// \param info   Field meta-information (can be a `nullptr`)
+  /// \param type   Type of the field
+  /// \return Pipeline or `nullptr` if the field is stored as is (no codec or `none` is given)
+  /// \throw Exception  Unknown codec, invalid block size or invalid error bound
+  static std::unique_ptr<CodecPipeline> create(const FieldMetainfoImpl* info, TypeID type);
+
+  /// \brief Create the pipeline which decodes data encoded as described by `info`
+  static std::unique_ptr<CodecPipeline> create(const CodecInfo& info);
+
+  /// \brief Encode `size` bytes of `data` into `output`
+  ///
+  /// \param data           Uncompressed data
+  /// \param size           Length of the uncompressed data in bytes
+  /// \param pool           Pool of staging buffers
+  /// \param output         Buffer receiving the compressed data
+  /// \param reference      Data of the reference if the data is delta-encoded (`size` bytes)
+  /// \param reconstructed  If not `nullptr`, receives the data which will be decoded (i.e
+  ///                       `data` after applying the lossy filter, `size` bytes)
+  /// \return Description of the encoding, the compressed length of the data in `output` is given
+  ///         by CodecInfo::compressedSize
+  CodecInfo encode(const Byte* data, std::size_t size, BufferPool& pool,
+                   BufferPool::Buffer& output, const Byte* reference = nullptr,
+                   Byte* reconstructed = nullptr) const;
+
+  /// \brief Decode the blocks [`firstBlock`, `lastBlock`)
+  ///
+  /// \param src         Compressed data starting at `firstBlock`
+  /// \param info        Description of the encoding
+  /// \param firstBlock  First block to decode
+  /// \param lastBlock   One past the last block to decode
+  /// \param dst         Destination of the uncompressed data of the blocks
+  /// \param pool        Pool of staging buffers
+  /// \param reference   Decoded data of the blocks of the reference (delta-encoded data)
+  void decode(const Byte* src, const CodecInfo& info, std::size_t firstBlock,
+              std::size_t lastBlock, Byte* dst, BufferPool& pool,
+              const Byte* reference = nullptr) const;
+
+  /// \brief Get the codec
+  const Codec& codec() const noexcept { return *codec_; }
+
+  /// \brief Get the element size of the byte-shuffle filter (0 if disabled)
+  int shuffle() const noexcept { return shuffle_; }
+
+  /// \brief Get the uncompressed size of a block
+  std::size_t blockSize() const noexcept { return blockSize_; }
+
+  /// \brief Apply the lossy `filter` before shuffling (the block size is rounded down to a
+  /// multiple of `elementSize`)
+  void setLossyFilter(std::unique_ptr<LossyFilter> filter, int elementSize);
+
+  /// \brief Get the lossy filter (`nullptr` if the pipeline is lossless)
+  const LossyFilter* lossyFilter() const noexcept { return lossyFilter_.get(); }
+
+  /// \brief Set the number of threads used to encode and decode the blocks
+  ///
+  /// A value of 0 uses all hardware threads, 1 processes the blocks in the calling thread
+  /// (default). The threads are started by each call, hence this only pays off for large fields
+  /// which are not already read or written concurrently.
+  void setNumThreads(std::size_t numThreads) noexcept { numThreads_ = numThreads; }
+
+  /// \brief Get the number of threads used to encode and decode the blocks
+  std::size_t numThreads() const noexcept { return numThreads_; }
+
+  /// \brief Enable delta encoding with the given keyframe interval (0 disables delta encoding)
+  void setKeyframeInterval(int keyframeInterval) noexcept { keyframeInterval_ = keyframeInterval; }
+
+  /// \brief Get the keyframe interval of the delta encoding (0 if delta encoding is disabled)
+  int keyframeInterval() const noexcept { return keyframeInterval_; }
+
+  /// \brief Check if delta encoding is enabled
+  bool isDeltaEncoding() const noexcept { return keyframeInterval_ > 0; }
+
+  /// \brief Group the bytes of `size / elementSize` elements by significance
+  static void shuffleBytes(const Byte* src, Byte* dst, std::size_t size,
+                           int elementSize) noexcept;
+
+  /// \brief Bitwise XOR of `size` bytes of `src` into `dst`
+  static void xorBytes(Byte* dst, const Byte* src, std::size_t size) noexcept;
+
+  /// \brief Revert `shuffleBytes`
+  static void unshuffleBytes(const Byte* src, Byte* dst, std::size_t size,
+                             int elementSize) noexcept;
+
+private:
+  std::unique_ptr<Codec> codec_;
+  std::unique_ptr<LossyFilter> lossyFilter_;
+  int shuffle_;
+  std::size_t blockSize_;
+  int keyframeInterval_;
+  std::size_t numThreads_;
+};
+
+} // namespace serialbox
+
+#endif
@@ -0,0 +1,69 @@
+//===-- serialbox/core/compression/LZ4Codec.cpp -------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements the LZ4 compression codec.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/compression/LZ4Codec.h"
+#include "serialbox/core/Exception.h"
+#include <algorithm>
+#include <limits>
+
+#ifdef SERIALBOX_HAS_LZ4
+#include <lz4.h>
+#endif
+
+namespace serialbox {
+
+const char* LZ4Codec::Name = "lz4";
+
+#ifdef SERIALBOX_HAS_LZ4
+
+std::size_t LZ4Codec::maxCompressedSize(std::size_t size) const noexcept {
+  return size > std::size_t(LZ4_MAX_INPUT_SIZE) ? 0 : LZ4_compressBound(int(size));
+}
+
+std::size_t LZ4Codec::compress(const Byte* src, std::size_t size, Byte* dst,
+                               std::size_t capacity) const {
+  if(size > std::size_t(LZ4_MAX_INPUT_SIZE))
+    throw Exception("LZ4Codec: input of %i bytes exceeds the maximal size", size);
+
+  int ret = LZ4_compress_default(
+      src, dst, int(size), int(std::min<std::size_t>(capacity, std::numeric_limits<int>::max())));
+  if(ret <= 0)
+    throw Exception("LZ4Codec: compression failed");
+  return ret;
+}
+
+void LZ4Codec::decompress(const Byte* src, std::size_t size, Byte* dst,
+                          std::size_t dstSize) const {
+  int ret = LZ4_decompress_safe(src, dst, int(size), int(dstSize));
+  if(ret < 0 || std::size_t(ret) != dstSize)
+    throw Exception("LZ4Codec: corrupted input");
+}
+
+#else
+
+std::size_t LZ4Codec::maxCompressedSize(std::size_t size) const noexcept { return 0; }
+
+std::size_t LZ4Codec::compress(const Byte* src, std::size_t size, Byte* dst,
+                               std::size_t capacity) const {
+  throw Exception("LZ4Codec: Serialbox was not compiled with LZ4 support");
+}
+
+void LZ4Codec::decompress(const Byte* src, std::size_t size, Byte* dst,
+                          std::size_t dstSize) const {
+  throw Exception("LZ4Codec: Serialbox was not compiled with LZ4 support");
+}
+
+#endif
+
+} // namespace serialbox
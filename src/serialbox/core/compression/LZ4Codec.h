@@ -0,0 +1,49 @@
+//===-- serialbox/core/compression/LZ4Codec.h ---------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the LZ4 compression codec.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_COMPRESSION_LZ4CODEC_H
+#define SERIALBOX_CORE_COMPRESSION_LZ4CODEC_H
+
+#include "serialbox/core/Config.h"
+#include "serialbox/core/compression/Codec.h"
+
+namespace serialbox {
+
+/// \brief Compression codec using the LZ4 library
+///
+/// The codec is only available if Serialbox was compiled with LZ4 support.
+///
+/// \see
+///   https://lz4.github.io/lz4/
+///
+/// \ingroup core
+class LZ4Codec : public Codec {
+public:
+  /// \brief Identifier of the codec
+  static const char* Name;
+
+  virtual const char* name() const noexcept override { return Name; }
+
+  virtual std::size_t maxCompressedSize(std::size_t size) const noexcept override;
+
+  virtual std::size_t compress(const Byte* src, std::size_t size, Byte* dst,
+                               std::size_t capacity) const override;
+
+  virtual void decompress(const Byte* src, std::size_t size, Byte* dst,
+                          std::size_t dstSize) const override;
+};
+
+} // namespace serialbox
+
+#endif
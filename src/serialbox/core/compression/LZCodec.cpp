@@ -0,0 +1,191 @@
+//===-- serialbox/core/compression/LZCodec.cpp --------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements the in-tree LZ77 compression codec.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/compression/LZCodec.h"
+#include "serialbox/core/Exception.h"
+#include <cstdint>
+#include <cstring>
+
+namespace serialbox {
+
+const char* LZCodec::Name = "lz";
+
+namespace {
+
+using UByte = unsigned char;
+
+const std::size_t MinMatch = 4;
+const std::size_t MaxOffset = 65535;
+const int HashLog = 14;
+
+inline std::uint32_t read32(const UByte* ptr) noexcept {
+  std::uint32_t value;
+  std::memcpy(&value, ptr, sizeof(value));
+  return value;
+}
+
+inline std::uint32_t hashSequence(std::uint32_t sequence) noexcept {
+  return (sequence * 2654435761u) >> (32 - HashLog);
+}
+
+/// Write the extension of a length (the token already holds 15)
+inline UByte* writeLength(UByte* op, std::size_t length) noexcept {
+  for(; length >= 255; length -= 255)
+    *op++ = 255;
+  *op++ = static_cast<UByte>(length);
+  return op;
+}
+
+/// Emit a token with the literals [`literals`, `literals + numLiterals`) followed by a match of
+/// `matchLength` bytes at `offset` (no match is emitted if `matchLength` is 0)
+inline UByte* writeSequence(UByte* op, const UByte* literals, std::size_t numLiterals,
+                            std::size_t offset, std::size_t matchLength) noexcept {
+  UByte* token = op++;
+  std::size_t matchCode = matchLength ? matchLength - MinMatch : 0;
+
+  *token = static_cast<UByte>(((numLiterals < 15 ? numLiterals : 15) << 4) |
+                              (matchCode < 15 ? matchCode : 15));
+
+  if(numLiterals >= 15)
+    op = writeLength(op, numLiterals - 15);
+  std::memcpy(op, literals, numLiterals);
+  op += numLiterals;
+
+  if(matchLength) {
+    *op++ = static_cast<UByte>(offset & 0xff);
+    *op++ = static_cast<UByte>(offset >> 8);
+    if(matchCode >= 15)
+      op = writeLength(op, matchCode - 15);
+  }
+  return op;
+}
+
+/// Read the extension of a length, returns false if the input is exhausted
+inline bool readLength(const UByte*& ip, const UByte* end, std::size_t& length) noexcept {
+  UByte value;
+  do {
+    if(ip >= end)
+      return false;
+    value = *ip++;
+    length += value;
+  } while(value == 255);
+  return true;
+}
+
+} // anonymous namespace
+
+std::size_t LZCodec::maxCompressedSize(std::size_t size) const noexcept {
+  return size + size / 255 + 16;
+}
+
+std::size_t LZCodec::compress(const Byte* src, std::size_t size, Byte* dst,
+                              std::size_t capacity) const {
+  if(capacity < maxCompressedSize(size))
+    throw Exception("LZCodec: insufficient capacity of output buffer (%i < %i)", capacity,
+                    maxCompressedSize(size));
+
+  const UByte* in = reinterpret_cast<const UByte*>(src);
+  UByte* op = reinterpret_cast<UByte*>(dst);
+
+  std::uint32_t table[1 << HashLog];
+  std::memset(table, 0, sizeof(table));
+
+  std::size_t anchor = 0, pos = 0;
+  const std::size_t matchLimit = size >= MinMatch ? size - MinMatch + 1 : 0;
+
+  while(pos < matchLimit) {
+    std::uint32_t sequence = read32(in + pos);
+    std::uint32_t& entry = table[hashSequence(sequence)];
+    std::size_t candidate = entry;
+    entry = static_cast<std::uint32_t>(pos);
+
+    if(candidate < pos && pos - candidate <= MaxOffset && read32(in + candidate) == sequence) {
+      std::size_t length = MinMatch;
+      while(pos + length < size && in[candidate + length] == in[pos + length])
+        ++length;
+
+      op = writeSequence(op, in + anchor, pos - anchor, pos - candidate, length);
+      pos += length;
+      anchor = pos;
+    } else {
+      ++pos;
+    }
+  }
+
+  // The last token only holds literals
+  op = writeSequence(op, in + anchor, size - anchor, 0, 0);
+  return op - reinterpret_cast<UByte*>(dst);
+}
+
+void LZCodec::decompress(const Byte* src, std::size_t size, Byte* dst,
+                         std::size_t dstSize) const {
+  const UByte* ip = reinterpret_cast<const UByte*>(src);
+  const UByte* const inEnd = ip + size;
+  UByte* const out = reinterpret_cast<UByte*>(dst);
+  UByte* op = out;
+  UByte* const outEnd = out + dstSize;
+
+  while(true) {
+    if(ip >= inEnd)
+      throw Exception("LZCodec: corrupted input (missing token)");
+
+    const UByte token = *ip++;
+
+    // Literals
+    std::size_t numLiterals = token >> 4;
+    if(numLiterals == 15 && !readLength(ip, inEnd, numLiterals))
+      throw Exception("LZCodec: corrupted input (truncated literal length)");
+
+    if(numLiterals > std::size_t(inEnd - ip) || numLiterals > std::size_t(outEnd - op))
+      throw Exception("LZCodec: corrupted input (literals out of bounds)");
+
+    std::memcpy(op, ip, numLiterals);
+    ip += numLiterals;
+    op += numLiterals;
+
+    if(ip == inEnd)
+      break;
+
+    // Match
+    if(inEnd - ip < 2)
+      throw Exception("LZCodec: corrupted input (truncated offset)");
+
+    std::size_t offset = ip[0] | (std::size_t(ip[1]) << 8);
+    ip += 2;
+
+    std::size_t matchLength = token & 15;
+    if(matchLength == 15 && !readLength(ip, inEnd, matchLength))
+      throw Exception("LZCodec: corrupted input (truncated match length)");
+    matchLength += MinMatch;
+
+    if(offset == 0 || offset > std::size_t(op - out) || matchLength > std::size_t(outEnd - op))
+      throw Exception("LZCodec: corrupted input (match out of bounds)");
+
+    const UByte* match = op - offset;
+    if(offset >= matchLength) {
+      std::memcpy(op, match, matchLength);
+      op += matchLength;
+    } else {
+      // Overlapping copy (repeating pattern)
+      for(std::size_t i = 0; i < matchLength; ++i)
+        *op++ = *match++;
+    }
+  }
+
+  if(op != outEnd)
+    throw Exception("LZCodec: size of decompressed data (%i) does not match the expected size (%i)",
+                    std::size_t(op - out), dstSize);
+}
+
+} // namespace serialbox
@@ -0,0 +1,48 @@
+//===-- serialbox/core/compression/LZCodec.h ----------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the in-tree LZ77 compression codec.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_COMPRESSION_LZCODEC_H
+#define SERIALBOX_CORE_COMPRESSION_LZCODEC_H
+
+#include "serialbox/core/compression/Codec.h"
+
+namespace serialbox {
+
+/// \brief Fast byte-oriented LZ77 codec without external dependencies
+///
+/// The compressed stream is a sequence of tokens, each consisting of a run of literals followed
+/// by a back-reference (16-bit offset) into the last 64 KB of the output, similar to the LZ4 block
+/// format. The last token only contains literals. The codec favours speed over ratio and is
+/// intended to be used after the byte-shuffle filter.
+///
+/// \ingroup core
+class LZCodec : public Codec {
+public:
+  /// \brief Identifier of the codec
+  static const char* Name;
+
+  virtual const char* name() const noexcept override { return Name; }
+
+  virtual std::size_t maxCompressedSize(std::size_t size) const noexcept override;
+
+  virtual std::size_t compress(const Byte* src, std::size_t size, Byte* dst,
+                               std::size_t capacity) const override;
+
+  virtual void decompress(const Byte* src, std::size_t size, Byte* dst,
+                          std::size_t dstSize) const override;
+};
+
+} // namespace serialbox
+
+#endif
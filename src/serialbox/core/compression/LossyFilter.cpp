@@ -0,0 +1,159 @@
+//===-- serialbox/core/compression/LossyFilter.cpp ----------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements the error-bounded lossy filter of floating point data.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/compression/LossyFilter.h"
+#include "serialbox/core/Exception.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace serialbox {
+
+namespace {
+
+/// IEEE-754 layout of `T`
+template <class T>
+struct FloatTraits;
+
+template <>
+struct FloatTraits<float> {
+  using UInt = std::uint32_t;
+  static constexpr int MantissaBits = 23;
+  static constexpr int ExponentBias = 127;
+  static constexpr UInt ExponentMask = 0xff;
+};
+
+template <>
+struct FloatTraits<double> {
+  using UInt = std::uint64_t;
+  static constexpr int MantissaBits = 52;
+  static constexpr int ExponentBias = 1023;
+  static constexpr UInt ExponentMask = 0x7ff;
+};
+
+/// Round `value` to `keepBits` mantissa bits (round half up on the magnitude)
+///
+/// Values which would round to infinity keep more bits, which only reduces the error.
+template <class T>
+T roundMantissa(T value, int keepBits) noexcept {
+  using Traits = FloatTraits<T>;
+  using UInt = typename Traits::UInt;
+
+  UInt bits;
+  std::memcpy(&bits, &value, sizeof(T));
+
+  for(; keepBits < Traits::MantissaBits; ++keepBits) {
+    const int dropBits = Traits::MantissaBits - keepBits;
+
+    // A carry into the exponent yields the correctly rounded power of two
+    UInt rounded = (bits + (UInt(1) << (dropBits - 1))) & ~((UInt(1) << dropBits) - 1);
+
+    T result;
+    std::memcpy(&result, &rounded, sizeof(T));
+    if(!std::isinf(result))
+      return result;
+  }
+  return value;
+}
+
+template <class T>
+double applyFilter(T* data, std::size_t numElements, ErrorBoundKind kind, double bound) noexcept {
+  using Traits = FloatTraits<T>;
+  using UInt = typename Traits::UInt;
+
+  // Rounding to k mantissa bits introduces an error of at most 2^(e - k - 1) for a value with
+  // exponent e, i.e a relative error of at most 2^(-k - 1)
+  const int boundExponent = std::floor(std::log2(bound));
+  const int relativeKeepBits = std::max(-boundExponent - 1, 0);
+
+  double maxError = 0.0;
+  for(std::size_t i = 0; i < numElements; ++i) {
+    const T value = data[i];
+
+    UInt bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    const int biasedExponent = int((bits >> Traits::MantissaBits) & Traits::ExponentMask);
+
+    // Infinity and NaN
+    if(biasedExponent == int(Traits::ExponentMask))
+      continue;
+
+    T result = value;
+    if(kind == ErrorBoundKind::Absolute) {
+      if(std::abs(double(value)) <= bound) {
+        result = T(0);
+      } else {
+        const int exponent = std::max(biasedExponent, 1) - Traits::ExponentBias;
+        result = roundMantissa(value, std::max(exponent - boundExponent - 1, 0));
+      }
+    } else if(biasedExponent != 0) {
+      result = roundMantissa(value, relativeKeepBits);
+    }
+
+    data[i] = result;
+
+    double error = std::abs(double(value) - double(result));
+    if(kind == ErrorBoundKind::Relative && value != T(0))
+      error /= std::abs(double(value));
+    maxError = std::max(maxError, error);
+  }
+  return maxError;
+}
+
+} // anonymous namespace
+
+LossyFilter::LossyFilter(TypeID type, ErrorBoundKind kind, double bound)
+    : type_(type), kind_(kind), bound_(bound) {
+  if(type_ != TypeID::Float32 && type_ != TypeID::Float64)
+    throw Exception("lossy compression is only supported for Float32 and Float64 fields (type: %s)",
+                    TypeUtil::toString(type_));
+
+  if(kind_ != ErrorBoundKind::None && !(bound_ > 0.0 && std::isfinite(bound_)))
+    throw Exception("invalid error bound of lossy compression: %f", bound_);
+}
+
+double LossyFilter::apply(Byte* data, std::size_t size) const noexcept {
+  if(kind_ == ErrorBoundKind::None)
+    return 0.0;
+
+  if(type_ == TypeID::Float32)
+    return applyFilter(reinterpret_cast<float*>(data), size / sizeof(float), kind_, bound_);
+  else
+    return applyFilter(reinterpret_cast<double*>(data), size / sizeof(double), kind_, bound_);
+}
+
+std::string LossyFilter::toString(ErrorBoundKind kind) {
+  switch(kind) {
+  case ErrorBoundKind::Absolute:
+    return "abs";
+  case ErrorBoundKind::Relative:
+    return "rel";
+  default:
+    return "none";
+  }
+}
+
+ErrorBoundKind LossyFilter::fromString(const std::string& kind) {
+  if(kind == "abs")
+    return ErrorBoundKind::Absolute;
+  else if(kind == "rel")
+    return ErrorBoundKind::Relative;
+  else if(kind == "none")
+    return ErrorBoundKind::None;
+  throw Exception("invalid kind of error bound: '%s'", kind);
+}
+
+} // namespace serialbox
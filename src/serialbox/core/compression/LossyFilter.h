@@ -0,0 +1,73 @@
+//===-- serialbox/core/compression/LossyFilter.h ------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the error-bounded lossy filter of floating point data.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SERIALBOX_CORE_COMPRESSION_LOSSYFILTER_H
+#define SERIALBOX_CORE_COMPRESSION_LOSSYFILTER_H
+
+#include "serialbox/core/Type.h"
+#include <string>
+
+namespace serialbox {
+
+/// \brief Kind of the error bound of the LossyFilter
+enum class ErrorBoundKind {
+  None = 0, ///< Lossless
+  Absolute, ///< |x - x'| <= bound
+  Relative  ///< |x - x'| <= bound * |x|
+};
+
+/// \brief Error-bounded lossy filter of `Float32` and `Float64` data (mantissa rounding)
+///
+/// Each value is rounded to the fewest mantissa bits which keep the error within the bound, the
+/// discarded bits are set to zero. The result is still valid floating point data (i.e reading
+/// requires no decoding), the trailing zeros are removed by the subsequent shuffle and
+/// compression stages. Infinities and NaNs are preserved, for relative bounds subnormal numbers
+/// are kept as is.
+///
+/// \ingroup core
+class LossyFilter {
+public:
+  /// \brief Construct the filter
+  ///
+  /// \throw Exception  `type` is not `Float32` or `Float64` or `bound` is not positive
+  LossyFilter(TypeID type, ErrorBoundKind kind, double bound);
+
+  /// \brief Round `size` bytes of `data` in-place
+  ///
+  /// \return Maximal error introduced (absolute or relative, depending on the kind of the bound)
+  double apply(Byte* data, std::size_t size) const noexcept;
+
+  /// \brief Get the kind of the error bound
+  ErrorBoundKind kind() const noexcept { return kind_; }
+
+  /// \brief Get the error bound
+  double bound() const noexcept { return bound_; }
+
+  /// \brief Convert the kind to string ("abs" or "rel")
+  static std::string toString(ErrorBoundKind kind);
+
+  /// \brief Convert string ("abs" or "rel") to the kind
+  ///
+  /// \throw Exception  Invalid string
+  static ErrorBoundKind fromString(const std::string& kind);
+
+private:
+  TypeID type_;
+  ErrorBoundKind kind_;
+  double bound_;
+};
+
+} // namespace serialbox
+
+#endif
@@ -0,0 +1,74 @@
+//===-- serialbox/core/compression/ZstdCodec.cpp ------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements the Zstandard compression codec.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/compression/ZstdCodec.h"
+#include "serialbox/core/Exception.h"
+
+#ifdef SERIALBOX_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace serialbox {
+
+const char* ZstdCodec::Name = "zstd";
+
+#ifdef SERIALBOX_HAS_ZSTD
+
+namespace {
+
+/// Compression level (favour speed, the data is usually byte-shuffled floating point data)
+const int CompressionLevel = 3;
+
+} // anonymous namespace
+
+std::size_t ZstdCodec::maxCompressedSize(std::size_t size) const noexcept {
+  return ZSTD_compressBound(size);
+}
+
+std::size_t ZstdCodec::compress(const Byte* src, std::size_t size, Byte* dst,
+                                std::size_t capacity) const {
+  std::size_t ret = ZSTD_compress(dst, capacity, src, size, CompressionLevel);
+  if(ZSTD_isError(ret))
+    throw Exception("ZstdCodec: %s", ZSTD_getErrorName(ret));
+  return ret;
+}
+
+void ZstdCodec::decompress(const Byte* src, std::size_t size, Byte* dst,
+                           std::size_t dstSize) const {
+  std::size_t ret = ZSTD_decompress(dst, dstSize, src, size);
+  if(ZSTD_isError(ret))
+    throw Exception("ZstdCodec: %s", ZSTD_getErrorName(ret));
+  if(ret != dstSize)
+    throw Exception("ZstdCodec: size of decompressed data (%i) does not match the expected size "
+                    "(%i)",
+                    ret, dstSize);
+}
+
+#else
+
+std::size_t ZstdCodec::maxCompressedSize(std::size_t size) const noexcept { return 0; }
+
+std::size_t ZstdCodec::compress(const Byte* src, std::size_t size, Byte* dst,
+                                std::size_t capacity) const {
+  throw Exception("ZstdCodec: Serialbox was not compiled with Zstandard support");
+}
+
+void ZstdCodec::decompress(const Byte* src, std::size_t size, Byte* dst,
+                           std::size_t dstSize) const {
+  throw Exception("ZstdCodec: Serialbox was not compiled with Zstandard support");
+}
+
+#endif
+
+} // namespace serialbox
@@ -33,26 +33,26 @@ namespace gridtools {
 /// \ingroup gridtools
 class meta_info_map {
 public:
-  /// \brief Type of the underlying hash-map
+  /// \brief Type of the underlying container
   using map_type = MetainfoMapImpl::map_type;
 
   /// \brief Type of an entry of the MetainfoMapImpl (`std::pair<std::string, meta_info_value>`)
-  using value_type = map_type::value_type;
+  using value_type = MetainfoMapImpl::value_type;
 
   /// \brief Type of the key (`std::string`)
-  using key_type = map_type::key_type;
+  using key_type = MetainfoMapImpl::key_type;
 
   /// \brief Type of the value (`MetainfoMapImpl::Value`)
-  using mapped_type = map_type::mapped_type;
+  using mapped_type = MetainfoMapImpl::mapped_type;
 
   /// \brief An unsigned integral type (`std::size_t`)
-  using size_type = map_type::size_type;
+  using size_type = MetainfoMapImpl::size_type;
 
   /// \brief A forward iterator to `value_type`
-  using iterator = map_type::iterator;
+  using iterator = MetainfoMapImpl::iterator;
 
   /// \brief A forward iterator to `const value_type`
-  using const_iterator = map_type::const_iterator;
+  using const_iterator = MetainfoMapImpl::const_iterator;
 
   /// \brief Default constructor (empty map)
   meta_info_map() : map_impl_(std::make_shared<MetainfoMapImpl>()) {}
@@ -245,11 +245,11 @@ public:
 
   /// \brief Get a refrence to savepoint vector
   const std::vector<savepoint>& savepoints() {
-    const auto& savepoints = serializerImpl_->savepointVector().savepoints();
+    const SavepointVector& savepoints = serializerImpl_->savepointVector();
     if(!savepoints_ || (savepoints.size() != savepoints_->size())) {
       savepoints_ = std::make_shared<std::vector<savepoint>>();
       for(std::size_t i = 0; i < savepoints.size(); ++i)
-        savepoints_->emplace_back(savepoints[i]);
+        savepoints_->emplace_back(std::make_shared<SavepointImpl>(savepoints.savepointAt(i)));
     }
     return *savepoints_;
   }
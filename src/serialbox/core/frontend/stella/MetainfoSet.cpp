@@ -75,7 +75,7 @@ void MetainfoSet::AddMetainfo(const std::string& key, const std::string& value)
     internal::throwSerializationException("Error: metainfo with key = %s exists already", key);
 }
 
-const boost::any& MetainfoSet::AsAny(const std::string& key) const {
+boost::any MetainfoSet::AsAny(const std::string& key) const {
   return internal::checkKeyExists(mapImpl_, key)->second.any();
 }
 
@@ -88,10 +88,10 @@ public:
   /// \brief Gives access to the internal representation of the requested metainfo
   ///
   /// \param key  The identification of the metainfo value which is requested
-  /// \return The metainfo object is returned as constant reference
+  /// \return Copy of the metainfo value
   ///
   /// \throw SerializationException     The key exists already
-  const boost::any& AsAny(const std::string& key) const;
+  boost::any AsAny(const std::string& key) const;
 
   /// \brief Extracts a value in bool representation
   ///
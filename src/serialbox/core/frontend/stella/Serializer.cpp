@@ -80,9 +80,10 @@ void Serializer::Init(const std::string& directory, const std::string& prefix,
   globalMetainfo_.setImpl(
       internal::make_shared_ptr<MetainfoMapImpl>(serializerImpl_->globalMetainfoPtr()));
 
-  // Initialize savepoint vector
-  for(auto& savepoint : serializerImpl_->savepoints())
-    savepoints_.emplace_back(internal::make_shared_ptr(savepoint));
+  // Initialize savepoint vector (the frontend owns copies of the savepoints)
+  const SavepointVector& savepointVector = serializerImpl_->savepointVector();
+  for(std::size_t i = 0; i < savepointVector.size(); ++i)
+    savepoints_.emplace_back(boost::make_shared<SavepointImpl>(savepointVector.savepointAt(i)));
 
   // Initialize data field infos
   for(auto it = serializerImpl_->fieldMap().begin(), end = serializerImpl_->fieldMap().end();
@@ -257,7 +258,7 @@ void Serializer::WriteField(const std::string& fieldName, const Savepoint& savep
     // Keep the frontend data-structure up to date
     if(numSavepoints < serializerImpl_->savepointVector().size())
       savepoints_.emplace_back(
-          internal::make_shared_ptr<SavepointImpl>(serializerImpl_->savepointVector().back()));
+          boost::make_shared<SavepointImpl>(serializerImpl_->savepointVector().back()));
 
   } catch(Exception& e) {
     internal::throwSerializationException("Error: %s", e.what());
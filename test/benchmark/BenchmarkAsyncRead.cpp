@@ -0,0 +1,130 @@
+//===-- benchmark/BenchmarkAsyncRead.cpp --------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the benchmark of batched asynchronous reads of many small fields.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "utility/SerializerTestBase.h"
+#include "utility/Storage.h"
+#include "serialbox/core/SerializerImpl.h"
+#include "serialbox/core/Timer.h"
+#include "serialbox/core/Type.h"
+#include "serialbox/core/archive/BinaryArchive.h"
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using namespace serialbox;
+using namespace unittest;
+
+namespace {
+
+class AsyncReadBenchmark : public SerializerBenchmarkBase,
+                           public ::testing::WithParamInterface<bool> {};
+
+/// Drop the data files of `directory` from the page cache so that every read hits the disk
+void evictPageCache(const filesystem::path& directory) {
+#ifdef POSIX_FADV_DONTNEED
+  for(filesystem::directory_iterator it(directory), end; it != end; ++it) {
+    if(it->path().extension() != ".dat")
+      continue;
+    int fd = ::open(it->path().c_str(), O_RDONLY);
+    if(fd < 0)
+      continue;
+    (void)::fdatasync(fd);
+    (void)::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+  }
+#endif
+}
+
+} // anonymous namespace
+
+TEST_P(AsyncReadBenchmark, Benchmark) {
+  const bool async = GetParam();
+  const int numSavepoints = 8;
+  const int numFields = 64;
+
+  using Storage = Storage<double>;
+
+  std::vector<SavepointImpl> savepoints;
+  for(int s = 0; s < numSavepoints; ++s)
+    savepoints.emplace_back("step-" + std::to_string(s));
+
+  std::vector<std::string> fields;
+  for(int f = 0; f < numFields; ++f)
+    fields.push_back("field_" + std::to_string(f));
+
+  std::vector<Size> sizes{Size{{8, 8, 4}}, Size{{32, 32, 8}}};
+
+  BenchmarkResult result;
+  std::string backend;
+  for(const Size& size : sizes) {
+    Storage storage(Storage::ColMajor, size.dimensions, Storage::random);
+
+    //
+    // Write data (distinct data at each savepoint)
+    //
+    Timer t;
+    {
+      SerializerImpl ser_write(OpenModeKind::Write, this->directory->path().string(), "field",
+                               "Binary");
+      for(const std::string& field : fields)
+        ser_write.registerField(field, ToTypeID<double>::value, size.dimensions);
+
+      for(int s = 0; s < numSavepoints; ++s) {
+        storage(0, 0, 0) = s;
+        for(const std::string& field : fields)
+          ser_write.write(field, savepoints[s], storage.toStorageView());
+      }
+    }
+    result.timingsWrite.push_back(std::make_pair(size, t.stop()));
+
+    //
+    // Read all fields of all savepoints on a cold page cache (one batch per savepoint)
+    //
+    std::vector<Storage> outputs(numFields, Storage(Storage::ColMajor, size.dimensions));
+
+    double timingRead = 0.0;
+    for(int n = 0; n < BenchmarkEnvironment::NumRepetitions; ++n) {
+      evictPageCache(this->directory->path());
+
+      Timer timer;
+      SerializerImpl ser_read(OpenModeKind::Read, this->directory->path().string(), "field",
+                              "Binary");
+      for(int s = 0; s < numSavepoints; ++s) {
+        for(int f = 0; f < numFields; ++f) {
+          auto sv = outputs[f].toStorageView();
+          if(async)
+            ser_read.readAsync(fields[f], savepoints[s], sv);
+          else
+            ser_read.read(fields[f], savepoints[s], sv);
+        }
+        ser_read.waitForAll();
+        ASSERT_EQ(outputs[numFields - 1](0, 0, 0), s);
+      }
+      timingRead += timer.stop();
+    }
+    timingRead /= BenchmarkEnvironment::NumRepetitions;
+    result.timingsRead.push_back(std::make_pair(size, timingRead));
+
+    backend = BinaryArchive(OpenModeKind::Read, this->directory->path().string(), "field")
+                  .asyncIOName();
+  }
+
+  const std::string kind =
+      async ? "batched async reads (" + backend + ")" : std::string("sequential reads");
+  result.name = "Binary " + kind + " (" + std::to_string(numFields) + " fields x " +
+                std::to_string(numSavepoints) + " savepoints, cold page cache)";
+  BenchmarkEnvironment::getInstance().appendResult(result);
+}
+
+INSTANTIATE_TEST_CASE_P(BenchmarkTest, AsyncReadBenchmark, ::testing::Values(false, true));
@@ -0,0 +1,89 @@
+//===-- benchmark/BenchmarkConcurrentWrite.cpp --------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the scaling benchmark of concurrent writes of distinct fields.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "utility/SerializerTestBase.h"
+#include "utility/Storage.h"
+#include "serialbox/core/SerializerImpl.h"
+#include "serialbox/core/Timer.h"
+#include "serialbox/core/Type.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace serialbox;
+using namespace unittest;
+
+class ConcurrentWriteBenchmark : public SerializerBenchmarkBase,
+                                 public ::testing::WithParamInterface<int> {};
+
+TEST_P(ConcurrentWriteBenchmark, Benchmark) {
+  const int numThreads = GetParam();
+  const int numFields = 8;
+  const int numSavepoints = 4;
+
+  BenchmarkResult result;
+  result.name = "Binary (concurrent write, " + std::to_string(numThreads) + " threads)";
+
+  const auto& sizes = BenchmarkEnvironment::getInstance().sizes();
+
+  using Storage = Storage<double>;
+
+  std::vector<SavepointImpl> savepoints;
+  for(int s = 0; s < numSavepoints; ++s)
+    savepoints.emplace_back("savepoint-" + std::to_string(s));
+
+  for(std::size_t i = 0; i < sizes.size(); ++i) {
+    const Size& size = sizes[i];
+
+    //
+    // Allocate data (every field has different content at every savepoint)
+    //
+    std::vector<std::vector<Storage>> data(numFields);
+    for(int f = 0; f < numFields; ++f)
+      for(int s = 0; s < numSavepoints; ++s)
+        data[f].emplace_back(Storage::ColMajor, size.dimensions, Storage::random);
+
+    //
+    // Write data, field `f` is owned by thread `f % numThreads`
+    //
+    double timingWrite = 0.0;
+    for(int n = 0; n < BenchmarkEnvironment::NumRepetitions; ++n) {
+      SerializerImpl ser_write(OpenModeKind::Write, this->directory->path().string(), "field",
+                               "Binary");
+      for(int f = 0; f < numFields; ++f)
+        ser_write.registerField("data" + std::to_string(f), ToTypeID<double>::value,
+                                size.dimensions);
+
+      Timer t;
+      std::vector<std::thread> threads;
+      for(int tid = 0; tid < numThreads; ++tid)
+        threads.emplace_back([&, tid]() {
+          for(int s = 0; s < numSavepoints; ++s)
+            for(int f = tid; f < numFields; f += numThreads)
+              ser_write.write("data" + std::to_string(f), savepoints[s],
+                              data[f][s].toStorageView());
+        });
+
+      for(auto& thread : threads)
+        thread.join();
+      timingWrite += t.stop();
+    }
+    timingWrite /= BenchmarkEnvironment::NumRepetitions;
+
+    result.timingsWrite.push_back(std::make_pair(size, timingWrite));
+  }
+
+  BenchmarkEnvironment::getInstance().appendResult(result);
+}
+
+INSTANTIATE_TEST_CASE_P(BenchmarkTest, ConcurrentWriteBenchmark, ::testing::Values(1, 2, 4, 8));
@@ -0,0 +1,147 @@
+//===-- benchmark/BenchmarkDeltaEncoding.cpp ----------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the benchmark of the temporal delta encoding of the BinaryArchive.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "utility/SerializerTestBase.h"
+#include "utility/Storage.h"
+#include "serialbox/core/SerializerImpl.h"
+#include "serialbox/core/Timer.h"
+#include "serialbox/core/Type.h"
+#include "serialbox/core/compression/CodecPipeline.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace serialbox;
+using namespace unittest;
+
+namespace {
+
+/// Encoding of the field (passed as field meta-information)
+struct Encoding {
+  std::string name;
+  std::string codec;
+  bool delta;
+  double relError;
+};
+
+std::ostream& operator<<(std::ostream& stream, const Encoding& encoding) {
+  return (stream << encoding.name);
+}
+
+class DeltaEncodingBenchmark : public SerializerBenchmarkBase,
+                               public ::testing::WithParamInterface<Encoding> {};
+
+/// Size in bytes of all data files of the serializer
+std::uintmax_t dataSize(const filesystem::path& directory) {
+  std::uintmax_t size = 0;
+  for(filesystem::directory_iterator it(directory), end; it != end; ++it)
+    if(it->path().extension() == ".dat")
+      size += filesystem::file_size(it->path());
+  return size;
+}
+
+} // anonymous namespace
+
+TEST_P(DeltaEncodingBenchmark, Benchmark) {
+  const Encoding& encoding = GetParam();
+  const int numSavepoints = 16;
+
+  using Storage = Storage<double>;
+
+  std::vector<SavepointImpl> savepoints;
+  for(int s = 0; s < numSavepoints; ++s)
+    savepoints.emplace_back("step-" + std::to_string(s));
+
+  std::vector<Size> sizes{Size{{32, 32, 16}}, Size{{64, 64, 32}}};
+
+  BenchmarkResult result;
+  std::ostringstream ratios;
+
+  for(const Size& size : sizes) {
+    const int nx = size.dimensions[0], ny = size.dimensions[1], nz = size.dimensions[2];
+
+    // Slowly evolving temperature field: a smooth background profile advected by a small wave.
+    // Between two time steps only a fraction of the points change (as for tendencies which are
+    // only updated in active regions).
+    std::vector<Storage> steps;
+    steps.emplace_back(Storage::ColMajor, size.dimensions);
+    for(int k = 0; k < nz; ++k)
+      for(int j = 0; j < ny; ++j)
+        for(int i = 0; i < nx; ++i)
+          steps[0](i, j, k) = 288.15 - 0.0065 * 100.0 * k + std::sin(0.1 * i) * std::cos(0.1 * j);
+
+    for(int s = 1; s < numSavepoints; ++s) {
+      steps.push_back(steps.back());
+      for(int k = 0; k < nz; ++k)
+        for(int j = 0; j < ny; ++j)
+          for(int i = (s * 7 + j) % 8; i < nx; i += 8)
+            steps[s](i, j, k) += 0.01 * std::sin(0.3 * (i + s));
+    }
+
+    //
+    // Write data
+    //
+    double timingWrite = 0.0;
+    for(int n = 0; n < BenchmarkEnvironment::NumRepetitions; ++n) {
+      Timer t;
+      SerializerImpl ser_write(OpenModeKind::Write, this->directory->path().string(), "field",
+                               "Binary");
+      ser_write.registerField("t", ToTypeID<double>::value, size.dimensions);
+      if(!encoding.codec.empty())
+        ser_write.addFieldMetainfoImpl("t", CodecPipeline::CodecKey, encoding.codec);
+      if(encoding.delta)
+        ser_write.addFieldMetainfoImpl("t", CodecPipeline::DeltaKey, true);
+      if(encoding.relError > 0.0)
+        ser_write.addFieldMetainfoImpl("t", CodecPipeline::RelErrorKey, encoding.relError);
+
+      for(int s = 0; s < numSavepoints; ++s)
+        ser_write.write("t", savepoints[s], steps[s].toStorageView());
+      timingWrite += t.stop();
+    }
+    timingWrite /= BenchmarkEnvironment::NumRepetitions;
+    result.timingsWrite.push_back(std::make_pair(size, timingWrite));
+
+    const double rawSize = double(numSavepoints) * nx * ny * nz * sizeof(double);
+    ratios << (ratios.tellp() ? ", " : "") << rawSize / dataSize(this->directory->path());
+
+    //
+    // Read data (sequential replay of all time steps)
+    //
+    Storage output(Storage::ColMajor, size.dimensions);
+    double timingRead = 0.0;
+    for(int n = 0; n < BenchmarkEnvironment::NumRepetitions; ++n) {
+      Timer t;
+      SerializerImpl ser_read(OpenModeKind::Read, this->directory->path().string(), "field",
+                              "Binary");
+
+      for(int s = 0; s < numSavepoints; ++s) {
+        auto sv = output.toStorageView();
+        ser_read.read("t", savepoints[s], sv);
+      }
+      timingRead += t.stop();
+    }
+    timingRead /= BenchmarkEnvironment::NumRepetitions;
+    result.timingsRead.push_back(std::make_pair(size, timingRead));
+  }
+
+  result.name = "Binary " + encoding.name + " (" + std::to_string(numSavepoints) +
+                " time steps, compression ratio " + ratios.str() + ")";
+  BenchmarkEnvironment::getInstance().appendResult(result);
+}
+
+INSTANTIATE_TEST_CASE_P(BenchmarkTest, DeltaEncodingBenchmark,
+                        ::testing::Values(Encoding{"plain", "", false, 0.0},
+                                          Encoding{"lz", "lz", false, 0.0},
+                                          Encoding{"lz+delta", "lz", true, 0.0},
+                                          Encoding{"lz+delta+lossy", "lz", true, 1e-6}));
@@ -0,0 +1,127 @@
+//===-- benchmark/BenchmarkHandles.cpp ----------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the benchmark of reads and writes by name and by pre-resolved handles.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "utility/SerializerTestBase.h"
+#include "utility/Storage.h"
+#include "serialbox/core/SerializerImpl.h"
+#include "serialbox/core/Timer.h"
+#include "serialbox/core/Type.h"
+#include <gtest/gtest.h>
+
+using namespace serialbox;
+using namespace unittest;
+
+namespace {
+
+class HandlesBenchmark : public SerializerBenchmarkBase,
+                         public ::testing::WithParamInterface<bool> {};
+
+} // anonymous namespace
+
+TEST_P(HandlesBenchmark, Benchmark) {
+  const bool useHandles = GetParam();
+  const int numFields = 128;
+  const int numSavepoints = 16;
+
+  BenchmarkResult result;
+  result.name = std::string("PackedBinary by ") + (useHandles ? "handle" : "name") + " (" +
+                std::to_string(numFields) + " small fields, " + std::to_string(numSavepoints) +
+                " savepoints)";
+
+  using Storage = Storage<double>;
+
+  std::vector<SavepointImpl> savepoints;
+  for(int s = 0; s < numSavepoints; ++s)
+    savepoints.emplace_back("savepoint-" + std::to_string(s));
+
+  std::vector<std::string> names;
+  for(int f = 0; f < numFields; ++f)
+    names.push_back("data" + std::to_string(f));
+
+  std::vector<Size> sizes{Size{{1}}, Size{{16}}};
+
+  for(const Size& size : sizes) {
+    std::vector<Storage> data;
+    for(int f = 0; f < numFields; ++f)
+      data.emplace_back(Storage::ColMajor, size.dimensions, Storage::random);
+
+    //
+    // Write data
+    //
+    double timingWrite = 0.0;
+    for(int n = 0; n < BenchmarkEnvironment::NumRepetitions; ++n) {
+      Timer t;
+      SerializerImpl ser_write(OpenModeKind::Write, this->directory->path().string(), "field",
+                               "PackedBinary");
+
+      std::vector<FieldHandle> fields;
+      for(int f = 0; f < numFields; ++f)
+        fields.push_back(ser_write.registerField(names[f], ToTypeID<double>::value,
+                                                 size.dimensions));
+
+      for(int s = 0; s < numSavepoints; ++s) {
+        SavepointHandle savepoint;
+        if(useHandles)
+          savepoint = ser_write.findOrRegisterSavepoint(savepoints[s]);
+
+        for(int f = 0; f < numFields; ++f) {
+          data[f](0) = s;
+          if(useHandles)
+            ser_write.write(fields[f], savepoint, data[f].toStorageView());
+          else
+            ser_write.write(names[f], savepoints[s], data[f].toStorageView());
+        }
+      }
+      timingWrite += t.stop();
+    }
+    timingWrite /= BenchmarkEnvironment::NumRepetitions;
+    result.timingsWrite.push_back(std::make_pair(size, timingWrite));
+
+    //
+    // Read data
+    //
+    double timingRead = 0.0;
+    for(int n = 0; n < BenchmarkEnvironment::NumRepetitions; ++n) {
+      Timer t;
+      SerializerImpl ser_read(OpenModeKind::Read, this->directory->path().string(), "field",
+                              "PackedBinary");
+
+      std::vector<FieldHandle> fields;
+      if(useHandles)
+        for(int f = 0; f < numFields; ++f)
+          fields.push_back(ser_read.lookupField(names[f]));
+
+      for(int s = 0; s < numSavepoints; ++s) {
+        SavepointHandle savepoint;
+        if(useHandles)
+          savepoint = ser_read.findSavepoint(savepoints[s]);
+
+        for(int f = 0; f < numFields; ++f) {
+          auto sv = data[f].toStorageView();
+          if(useHandles)
+            ser_read.read(fields[f], savepoint, sv);
+          else
+            ser_read.read(names[f], savepoints[s], sv);
+        }
+      }
+      timingRead += t.stop();
+    }
+    timingRead /= BenchmarkEnvironment::NumRepetitions;
+    result.timingsRead.push_back(std::make_pair(size, timingRead));
+  }
+
+  BenchmarkEnvironment::getInstance().appendResult(result);
+}
+
+INSTANTIATE_TEST_CASE_P(BenchmarkTest, HandlesBenchmark, ::testing::Values(false, true));
@@ -0,0 +1,184 @@
+//===-- benchmark/BenchmarkMetaDataLoad.cpp -----------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the benchmark of opening the meta-data of a serializer with many savepoints.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "utility/SerializerTestBase.h"
+#include "serialbox/core/FieldMapSerializer.h"
+#include "serialbox/core/MetainfoMapImplSerializer.h"
+#include "serialbox/core/SavepointVectorSerializer.h"
+#include "serialbox/core/SerializerImpl.h"
+#include "serialbox/core/Timer.h"
+#include "serialbox/core/archive/BinaryArchive.h"
+#include "serialbox/core/hash/HashFactory.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+
+#ifdef __linux__
+#include <malloc.h>
+#include <unistd.h>
+#endif
+
+using namespace serialbox;
+using namespace unittest;
+
+namespace {
+
+/// Construction of the meta-data
+enum class Loader { Documents, TokenStream, Snapshot };
+
+std::ostream& operator<<(std::ostream& stream, const Loader& loader) {
+  switch(loader) {
+  case Loader::Documents:
+    return (stream << "via JSON documents");
+  case Loader::TokenStream:
+    return (stream << "from the token stream");
+  default:
+    return (stream << "from the binary snapshot");
+  }
+}
+
+class MetaDataLoadBenchmark : public SerializerBenchmarkBase,
+                              public ::testing::WithParamInterface<Loader> {};
+
+/// Value of `entry` of the memory status of the process in bytes (0 if unknown)
+std::size_t residentSize(const char* entry) {
+#ifdef __linux__
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while(std::getline(status, line))
+    if(line.compare(0, std::strlen(entry), entry) == 0)
+      return std::stoul(line.substr(std::strlen(entry))) * 1024;
+#endif
+  return 0;
+}
+
+/// Return freed memory to the system and reset the peak of the resident set size
+void resetPeakRSS() {
+#ifdef __linux__
+  malloc_trim(0);
+  std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+}
+
+/// Write the meta-data of `numSavepoints` savepoints of a time loop which all store field `u`
+void writeMetaData(const std::string& directory, int numSavepoints) {
+  {
+    SerializerImpl ser(OpenModeKind::Write, directory, "field", "Binary");
+    ser.registerField("u", TypeID::Float64, std::vector<int>{32, 32, 80});
+    ser.addGlobalMetainfo("experiment", std::string("benchmark"));
+
+    for(int i = 0; i < numSavepoints; ++i) {
+      SavepointImpl savepoint("stage-" + std::to_string(i % 8));
+      savepoint.addMetainfo("time_step", i / 8);
+      savepoint.addMetainfo("dt", 0.5);
+      savepoint.addMetainfo("stage_id", i % 8);
+      ASSERT_TRUE(ser.registerSavepoint(savepoint));
+      ASSERT_TRUE(ser.addFieldToSavepoint(savepoint, FieldID{"u", unsigned(i)}));
+    }
+    ser.updateMetaData();
+  }
+
+  // The archive holds one entry of `u` per savepoint (no data is written)
+  json::json archive;
+  archive["serialbox_version"] =
+      100 * SERIALBOX_VERSION_MAJOR + 10 * SERIALBOX_VERSION_MINOR + SERIALBOX_VERSION_PATCH;
+  archive["archive_name"] = BinaryArchive::Name;
+  archive["archive_version"] = BinaryArchive::Version;
+  archive["hash_algorithm"] = HashFactory::defaultHash();
+
+  const std::size_t bytes = 32 * 32 * 80 * sizeof(double);
+  for(int i = 0; i < numSavepoints; ++i)
+    archive["fields_table"]["u"].push_back(
+        {i * bytes, "0123456789abcdef0123456789abcdef" + std::to_string(i)});
+
+  std::ofstream fs((filesystem::path(directory) / "ArchiveMetaData-field.json").string());
+  fs << archive.dump(2) << std::endl;
+}
+
+/// Construct the meta-data from JSON documents of the whole files (as done before the token stream
+/// was used)
+std::size_t loadDocuments(const std::string& directory) {
+  json::json metaData, archive;
+  std::ifstream(directory + "/MetaData-field.json") >> metaData;
+  std::ifstream(directory + "/ArchiveMetaData-field.json") >> archive;
+
+  MetainfoMapImpl globalMetainfo = metaData["global_meta_info"];
+  SavepointVector savepointVector = metaData["savepoint_vector"];
+  FieldMap fieldMap = metaData["field_map"];
+
+  std::vector<std::pair<std::streamoff, std::string>> fieldTable;
+  for(const auto& entry : archive["fields_table"]["u"])
+    fieldTable.emplace_back(entry.at(0), entry.at(1));
+
+  return savepointVector.size() + fieldMap.size() + globalMetainfo.size() + fieldTable.size();
+}
+
+} // anonymous namespace
+
+TEST_P(MetaDataLoadBenchmark, Benchmark) {
+  const Loader loader = GetParam();
+  const std::string directory = this->directory->path().string();
+
+  BenchmarkResult result;
+  std::ostringstream peak;
+
+  for(int numSavepoints : {1000, 100000}) {
+    writeMetaData(directory, numSavepoints);
+
+    // The snapshot is created by the first opening (the token stream is measured without it)
+    if(loader == Loader::Snapshot) {
+      SerializerImpl ser(OpenModeKind::Read, directory, "field", "Binary");
+      ASSERT_TRUE(filesystem::exists(ser.metaDataSnapshotFile()));
+      ASSERT_TRUE(filesystem::exists(filesystem::path(directory) /
+                                     MetaDataSnapshot::archiveFilename("field")));
+    } else
+      ::setenv("SERIALBOX_METADATA_SNAPSHOT", "0", 1);
+
+    double timingOpen = 0.0;
+    for(int n = 0; n < BenchmarkEnvironment::NumRepetitions; ++n) {
+      resetPeakRSS();
+      const std::size_t residentBefore = residentSize("VmRSS:");
+
+      Timer t;
+      if(loader == Loader::Documents) {
+        ASSERT_EQ(loadDocuments(directory), 2 * numSavepoints + 2);
+      } else {
+        SerializerImpl ser(OpenModeKind::Read, directory, "field", "Binary");
+        ASSERT_EQ(ser.savepointVector().size(), numSavepoints);
+      }
+      timingOpen += t.stop();
+
+      const std::size_t residentPeak = residentSize("VmHWM:");
+      if(n == 0 && residentPeak > residentBefore)
+        peak << (peak.tellp() ? ", " : "") << (residentPeak - residentBefore) / 1024 << " kB";
+    }
+
+    result.timingsRead.push_back(std::make_pair(
+        Size{{numSavepoints}}, timingOpen / BenchmarkEnvironment::NumRepetitions));
+  }
+  ::unsetenv("SERIALBOX_METADATA_SNAPSHOT");
+
+  std::ostringstream name;
+  name << "Open meta-data " << loader;
+  result.name = name.str();
+  if(peak.tellp())
+    result.name += " (peak RSS +" + peak.str() + ")";
+  BenchmarkEnvironment::getInstance().appendResult(result);
+}
+
+INSTANTIATE_TEST_CASE_P(BenchmarkTest, MetaDataLoadBenchmark,
+                        ::testing::Values(Loader::Documents, Loader::TokenStream,
+                                          Loader::Snapshot));
@@ -0,0 +1,309 @@
+//===-- benchmark/BenchmarkMetainfo.cpp ---------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the microbenchmarks of the meta-information values.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "utility/SerializerTestBase.h"
+#include "serialbox/core/MetainfoMapImpl.h"
+#include "serialbox/core/MetainfoMapImplSerializer.h"
+#include "serialbox/core/SavepointImpl.h"
+#include "serialbox/core/SavepointVector.h"
+#include "serialbox/core/SavepointVectorSerializer.h"
+#include "serialbox/core/Timer.h"
+#include <gtest/gtest.h>
+#include <sstream>
+
+#ifdef __linux__
+#include <malloc.h>
+#endif
+
+using namespace serialbox;
+using namespace unittest;
+
+namespace {
+
+class MetainfoBenchmark : public SerializerBenchmarkBase {};
+
+/// Meta-information of a typical savepoint: mostly scalars and a few strings
+MetainfoValueImpl makeValue(int i) {
+  switch(i % 4) {
+  case 0:
+    return MetainfoValueImpl(i);
+  case 1:
+    return MetainfoValueImpl(double(i) * 0.5);
+  case 2:
+    return MetainfoValueImpl(i % 8 == 2);
+  default:
+    return MetainfoValueImpl("stage-" + std::to_string(i % 16));
+  }
+}
+
+/// Bytes currently allocated on the heap (0 if unknown)
+std::size_t heapSize() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  return mallinfo2().uordblks;
+#else
+  return 0;
+#endif
+}
+
+/// Savepoint of a typical time loop: `stage-<stage>` with the time step and the stage
+SavepointImpl makeSavepoint(int i) {
+  SavepointImpl savepoint("stage-" + std::to_string(i % 8));
+  savepoint.addMetainfo("time_step", i / 8);
+  savepoint.addMetainfo("dt", 0.5);
+  savepoint.addMetainfo("stage_id", i % 8);
+  return savepoint;
+}
+
+} // anonymous namespace
+
+TEST_F(MetainfoBenchmark, Values) {
+  const std::vector<int> sizes{1000, 100000};
+
+  //
+  // Construction (Writing) and comparison (Reading) of values
+  //
+  BenchmarkResult result;
+  result.name = "MetainfoValueImpl construction (write) and comparison (read)";
+
+  for(int numValues : sizes) {
+    double timingConstruct = 0.0, timingCompare = 0.0;
+    std::size_t numEqual = 0;
+
+    for(int n = 0; n < BenchmarkEnvironment::NumRepetitions; ++n) {
+      Timer t;
+      std::vector<MetainfoValueImpl> values, others;
+      values.reserve(numValues);
+      others.reserve(numValues);
+      for(int i = 0; i < numValues; ++i) {
+        values.push_back(makeValue(i));
+        others.push_back(makeValue(i + (i % 3 == 0)));
+      }
+      timingConstruct += t.stop();
+
+      t.start();
+      for(int i = 0; i < numValues; ++i)
+        numEqual += (values[i] == others[i]);
+      timingCompare += t.stop();
+    }
+    ASSERT_GT(numEqual, 0);
+
+    result.timingsWrite.push_back(std::make_pair(
+        Size{{numValues}}, timingConstruct / BenchmarkEnvironment::NumRepetitions));
+    result.timingsRead.push_back(std::make_pair(
+        Size{{numValues}}, timingCompare / BenchmarkEnvironment::NumRepetitions));
+  }
+  BenchmarkEnvironment::getInstance().appendResult(result);
+
+  //
+  // JSON serialization (Writing) and deserialization (Reading) of maps of 8 values
+  //
+  BenchmarkResult resultJson;
+  resultJson.name = "MetainfoMapImpl JSON round-trip (maps of 8 values)";
+
+  for(int numValues : sizes) {
+    const int numMaps = numValues / 8;
+    std::vector<MetainfoMapImpl> maps(numMaps);
+    for(int m = 0; m < numMaps; ++m)
+      for(int i = 0; i < 8; ++i)
+        maps[m].insert("key_" + std::to_string(i), makeValue(m + i));
+
+    double timingToJson = 0.0, timingFromJson = 0.0;
+    for(int n = 0; n < BenchmarkEnvironment::NumRepetitions; ++n) {
+      Timer t;
+      std::vector<json::json> nodes(numMaps);
+      for(int m = 0; m < numMaps; ++m)
+        nodes[m] = maps[m];
+      timingToJson += t.stop();
+
+      t.start();
+      std::vector<MetainfoMapImpl> mapsRead(numMaps);
+      for(int m = 0; m < numMaps; ++m)
+        mapsRead[m] = nodes[m];
+      timingFromJson += t.stop();
+      ASSERT_TRUE(mapsRead.back() == maps.back());
+    }
+
+    resultJson.timingsWrite.push_back(std::make_pair(
+        Size{{numValues}}, timingToJson / BenchmarkEnvironment::NumRepetitions));
+    resultJson.timingsRead.push_back(std::make_pair(
+        Size{{numValues}}, timingFromJson / BenchmarkEnvironment::NumRepetitions));
+  }
+  BenchmarkEnvironment::getInstance().appendResult(resultJson);
+}
+
+TEST_F(MetainfoBenchmark, Savepoints) {
+  const std::vector<int> sizes{1000, 100000};
+
+  //
+  // Construction (Writing) and comparison (Reading) of savepoints with 3 meta-information entries
+  //
+  BenchmarkResult result;
+  std::ostringstream bytes;
+
+  for(int numSavepoints : sizes) {
+    double timingConstruct = 0.0, timingCompare = 0.0;
+    std::size_t numEqual = 0;
+
+    for(int n = 0; n < BenchmarkEnvironment::NumRepetitions; ++n) {
+      const std::size_t heapBefore = heapSize();
+      Timer t;
+      std::vector<SavepointImpl> savepoints;
+      savepoints.reserve(numSavepoints);
+      for(int i = 0; i < numSavepoints; ++i)
+        savepoints.push_back(makeSavepoint(i));
+      timingConstruct += t.stop();
+
+      if(n == 0 && heapSize() > heapBefore)
+        bytes << (bytes.tellp() ? ", " : "") << (heapSize() - heapBefore) / numSavepoints;
+
+      // Compare equal savepoints (full comparison of the meta-information)
+      std::vector<SavepointImpl> others(savepoints);
+      t.start();
+      for(int i = 0; i < numSavepoints; ++i)
+        numEqual += (savepoints[i] == others[i]);
+      timingCompare += t.stop();
+    }
+    ASSERT_EQ(numEqual, numSavepoints * BenchmarkEnvironment::NumRepetitions);
+
+    result.timingsWrite.push_back(std::make_pair(
+        Size{{numSavepoints}}, timingConstruct / BenchmarkEnvironment::NumRepetitions));
+    result.timingsRead.push_back(std::make_pair(
+        Size{{numSavepoints}}, timingCompare / BenchmarkEnvironment::NumRepetitions));
+  }
+
+  result.name = "SavepointImpl construction (write) and comparison (read)";
+  if(bytes.tellp())
+    result.name += " (" + bytes.str() + " bytes per savepoint)";
+  BenchmarkEnvironment::getInstance().appendResult(result);
+}
+
+TEST_F(MetainfoBenchmark, FieldsPerSavepoint) {
+  const std::vector<int> sizes{1000, 100000};
+  const std::vector<std::string> fields{"u", "v", "w", "pp", "temperature", "specific_humidity",
+                                        "turbulent_kinetic_energy", "cloud_ice_content"};
+
+  //
+  // Registration (Writing) and lookup (Reading) of the fields of each savepoint
+  //
+  BenchmarkResult result;
+  std::ostringstream bytes;
+
+  for(int numSavepoints : sizes) {
+    double timingRegister = 0.0, timingLookup = 0.0;
+    std::size_t numFound = 0;
+
+    for(int n = 0; n < BenchmarkEnvironment::NumRepetitions; ++n) {
+      // Savepoints are hashed by name, hence the names are unique
+      std::vector<SavepointImpl> savepoints;
+      savepoints.reserve(numSavepoints);
+      for(int i = 0; i < numSavepoints; ++i) {
+        savepoints.emplace_back("step-" + std::to_string(i));
+        savepoints.back().addMetainfo("time_step", i);
+      }
+
+      const std::size_t heapBefore = heapSize();
+      Timer t;
+      SavepointVector savepointVector;
+      for(int i = 0; i < numSavepoints; ++i) {
+        int idx = savepointVector.insert(savepoints[i]);
+        for(const std::string& field : fields)
+          savepointVector.addField(idx, FieldID{field, unsigned(i / 8)});
+      }
+      timingRegister += t.stop();
+
+      if(n == 0 && heapSize() > heapBefore)
+        bytes << (bytes.tellp() ? ", " : "") << (heapSize() - heapBefore) / numSavepoints;
+
+      t.start();
+      for(int i = 0; i < numSavepoints; ++i)
+        for(const std::string& field : fields)
+          numFound += (savepointVector.getFieldID(i, field).id == unsigned(i / 8));
+      timingLookup += t.stop();
+    }
+    ASSERT_EQ(numFound, numSavepoints * fields.size() * BenchmarkEnvironment::NumRepetitions);
+
+    result.timingsWrite.push_back(std::make_pair(
+        Size{{numSavepoints}}, timingRegister / BenchmarkEnvironment::NumRepetitions));
+    result.timingsRead.push_back(std::make_pair(
+        Size{{numSavepoints}}, timingLookup / BenchmarkEnvironment::NumRepetitions));
+  }
+
+  result.name = "SavepointVector registration (write) and lookup (read) of 8 fields";
+  if(bytes.tellp())
+    result.name += " (" + bytes.str() + " bytes per savepoint)";
+  BenchmarkEnvironment::getInstance().appendResult(result);
+}
+
+TEST_F(MetainfoBenchmark, SavepointVector) {
+  const std::vector<int> sizes{1000, 100000};
+
+  //
+  // Loading from JSON (Writing) and lookup (Reading) of all savepoints with 4 fields each
+  //
+  BenchmarkResult result;
+  std::ostringstream bytes;
+
+  for(int numSavepoints : sizes) {
+    // Savepoints are hashed by name (in the default hash), hence use a realistic number of names
+    json::json node;
+    {
+      SavepointVector savepointVector;
+      for(int i = 0; i < numSavepoints; ++i) {
+        SavepointImpl savepoint("savepoint-" + std::to_string(i % 1000));
+        savepoint.addMetainfo("time_step", i / 1000);
+        savepoint.addMetainfo("dt", 0.5);
+        int idx = savepointVector.insert(savepoint);
+        for(const char* field : {"u", "v", "w", "pp"})
+          savepointVector.addField(idx, FieldID{field, unsigned(i / 1000)});
+      }
+      node = savepointVector;
+    }
+
+    std::vector<SavepointImpl> savepoints;
+    for(int i = 0; i < numSavepoints; ++i) {
+      savepoints.emplace_back("savepoint-" + std::to_string(i % 1000));
+      savepoints.back().addMetainfo("time_step", i / 1000);
+      savepoints.back().addMetainfo("dt", 0.5);
+    }
+
+    double timingLoad = 0.0, timingFind = 0.0;
+    std::size_t numFound = 0;
+
+    for(int n = 0; n < BenchmarkEnvironment::NumRepetitions; ++n) {
+      const std::size_t heapBefore = heapSize();
+      Timer t;
+      SavepointVector savepointVector = node;
+      timingLoad += t.stop();
+
+      if(n == 0 && heapSize() > heapBefore)
+        bytes << (bytes.tellp() ? ", " : "") << (heapSize() - heapBefore) / numSavepoints;
+
+      t.start();
+      for(int i = 0; i < numSavepoints; ++i)
+        numFound += (savepointVector.find(savepoints[i]) == i);
+      timingFind += t.stop();
+    }
+    ASSERT_EQ(numFound, numSavepoints * BenchmarkEnvironment::NumRepetitions);
+
+    result.timingsWrite.push_back(
+        std::make_pair(Size{{numSavepoints}}, timingLoad / BenchmarkEnvironment::NumRepetitions));
+    result.timingsRead.push_back(
+        std::make_pair(Size{{numSavepoints}}, timingFind / BenchmarkEnvironment::NumRepetitions));
+  }
+
+  result.name = "SavepointVector loading from JSON (write) and lookup (read)";
+  if(bytes.tellp())
+    result.name += " (" + bytes.str() + " bytes per savepoint)";
+  BenchmarkEnvironment::getInstance().appendResult(result);
+}
@@ -0,0 +1,96 @@
+//===-- benchmark/BenchmarkPackedBinary.cpp -----------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the benchmark of many small fields for the Binary and PackedBinary archive.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "utility/SerializerTestBase.h"
+#include "utility/Storage.h"
+#include "serialbox/core/SerializerImpl.h"
+#include "serialbox/core/Timer.h"
+#include "serialbox/core/Type.h"
+#include <gtest/gtest.h>
+
+using namespace serialbox;
+using namespace unittest;
+
+class ManySmallFieldsBenchmark : public SerializerBenchmarkBase,
+                                 public ::testing::WithParamInterface<std::string> {};
+
+TEST_P(ManySmallFieldsBenchmark, Benchmark) {
+  const int numFields = 128;
+  const int numSavepoints = 2;
+
+  BenchmarkResult result;
+  result.name = GetParam() + " (" + std::to_string(numFields) + " small fields, " +
+                std::to_string(numSavepoints) + " savepoints)";
+
+  using Storage = Storage<double>;
+
+  std::vector<SavepointImpl> savepoints;
+  for(int s = 0; s < numSavepoints; ++s)
+    savepoints.emplace_back("savepoint-" + std::to_string(s));
+
+  std::vector<Size> sizes{Size{{16}}, Size{{32, 32}}};
+
+  for(const Size& size : sizes) {
+    std::vector<Storage> data;
+    for(int f = 0; f < numFields; ++f)
+      data.emplace_back(Storage::ColMajor, size.dimensions, Storage::random);
+
+    //
+    // Write data (every field gets a different content at every savepoint)
+    //
+    double timingWrite = 0.0;
+    for(int n = 0; n < BenchmarkEnvironment::NumRepetitions; ++n) {
+      Timer t;
+      SerializerImpl ser_write(OpenModeKind::Write, this->directory->path().string(), "field",
+                               GetParam());
+
+      for(int f = 0; f < numFields; ++f)
+        ser_write.registerField("data" + std::to_string(f), ToTypeID<double>::value,
+                                size.dimensions);
+
+      for(int s = 0; s < numSavepoints; ++s)
+        for(int f = 0; f < numFields; ++f) {
+          data[f](0) = s;
+          ser_write.write("data" + std::to_string(f), savepoints[s], data[f].toStorageView());
+        }
+      timingWrite += t.stop();
+    }
+    timingWrite /= BenchmarkEnvironment::NumRepetitions;
+    result.timingsWrite.push_back(std::make_pair(size, timingWrite));
+
+    //
+    // Read data
+    //
+    double timingRead = 0.0;
+    for(int n = 0; n < BenchmarkEnvironment::NumRepetitions; ++n) {
+      Timer t;
+      SerializerImpl ser_read(OpenModeKind::Read, this->directory->path().string(), "field",
+                              GetParam());
+
+      for(int s = 0; s < numSavepoints; ++s)
+        for(int f = 0; f < numFields; ++f) {
+          auto sv = data[f].toStorageView();
+          ser_read.read("data" + std::to_string(f), savepoints[s], sv);
+        }
+      timingRead += t.stop();
+    }
+    timingRead /= BenchmarkEnvironment::NumRepetitions;
+    result.timingsRead.push_back(std::make_pair(size, timingRead));
+  }
+
+  BenchmarkEnvironment::getInstance().appendResult(result);
+}
+
+INSTANTIATE_TEST_CASE_P(BenchmarkTest, ManySmallFieldsBenchmark,
+                        ::testing::Values("Binary", "PackedBinary"));
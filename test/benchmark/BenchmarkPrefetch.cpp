@@ -0,0 +1,176 @@
+//===-- benchmark/BenchmarkPrefetch.cpp ---------------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the benchmark of prefetching during sequential replay of savepoints.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "utility/SerializerTestBase.h"
+#include "utility/Storage.h"
+#include "serialbox/core/SerializerImpl.h"
+#include "serialbox/core/Timer.h"
+#include "serialbox/core/Type.h"
+#include <chrono>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace serialbox;
+using namespace unittest;
+
+namespace {
+
+/// How the replay prefetches the next `depth` savepoints
+enum class PrefetchKind {
+  Automatic,  ///< SerializerImpl::setPrefetchDepth
+  Explicit,   ///< SerializerImpl::prefetch once all fields of a savepoint are read
+  AccessTrace ///< SerializerImpl::replayAccessTrace with a budget of `depth` savepoints
+};
+
+/// Prefetching configuration of the replay
+struct Prefetch {
+  std::string name;
+  PrefetchKind kind;
+  int depth;
+  std::size_t fieldCacheSize;
+};
+
+std::ostream& operator<<(std::ostream& stream, const Prefetch& prefetch) {
+  return (stream << prefetch.name);
+}
+
+class PrefetchBenchmark : public SerializerBenchmarkBase,
+                          public ::testing::WithParamInterface<Prefetch> {};
+
+/// Drop the data files of `directory` from the page cache (as after a reboot or on a different
+/// node) so that every replay starts with a cold cache
+void evictPageCache(const filesystem::path& directory) {
+#ifdef POSIX_FADV_DONTNEED
+  for(filesystem::directory_iterator it(directory), end; it != end; ++it) {
+    if(it->path().extension() != ".dat")
+      continue;
+    int fd = ::open(it->path().c_str(), O_RDONLY);
+    if(fd < 0)
+      continue;
+    (void)::fdatasync(fd);
+    (void)::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+  }
+#endif
+}
+
+} // anonymous namespace
+
+TEST_P(PrefetchBenchmark, Benchmark) {
+  const Prefetch& prefetch = GetParam();
+  const int numSavepoints = 16;
+  const int numFields = 4;
+
+  // Time spent computing between two savepoints of the replay
+  const std::chrono::milliseconds computeTime(10);
+
+  using Storage = Storage<double>;
+
+  std::vector<SavepointImpl> savepoints;
+  for(int s = 0; s < numSavepoints; ++s)
+    savepoints.emplace_back("step-" + std::to_string(s));
+
+  std::vector<std::string> fields;
+  for(int f = 0; f < numFields; ++f)
+    fields.push_back("field_" + std::to_string(f));
+
+  std::vector<Size> sizes{Size{{64, 64, 16}}, Size{{128, 128, 16}}};
+
+  BenchmarkResult result;
+  for(const Size& size : sizes) {
+    Storage storage(Storage::ColMajor, size.dimensions, Storage::random);
+
+    //
+    // Write data (distinct data at each savepoint)
+    //
+    Timer t;
+    {
+      SerializerImpl ser_write(OpenModeKind::Write, this->directory->path().string(), "field",
+                               "Binary");
+      for(const std::string& field : fields)
+        ser_write.registerField(field, ToTypeID<double>::value, size.dimensions);
+
+      for(int s = 0; s < numSavepoints; ++s) {
+        storage(0, 0, 0) = s;
+        for(const std::string& field : fields)
+          ser_write.write(field, savepoints[s], storage.toStorageView());
+      }
+    }
+    result.timingsWrite.push_back(std::make_pair(size, t.stop()));
+
+    const std::size_t savepointSize = numFields * storage.toStorageView().sizeInBytes();
+
+    // Record the access trace of the replay
+    if(prefetch.kind == PrefetchKind::AccessTrace) {
+      SerializerImpl ser_read(OpenModeKind::Read, this->directory->path().string(), "field",
+                              "Binary");
+      ser_read.setAccessTraceRecording(true);
+      for(int s = 0; s < numSavepoints; ++s)
+        for(const std::string& field : fields) {
+          auto sv = storage.toStorageView();
+          ser_read.read(field, savepoints[s], sv);
+        }
+    }
+
+    //
+    // Replay all savepoints in order on a cold page cache, only the time spent waiting for the
+    // data (i.e in read) is accounted
+    //
+    double stallTime = 0.0;
+    for(int n = 0; n < BenchmarkEnvironment::NumRepetitions; ++n) {
+      evictPageCache(this->directory->path());
+
+      SerializerImpl ser_read(OpenModeKind::Read, this->directory->path().string(), "field",
+                              "Binary");
+      ser_read.setFieldCacheSize(prefetch.fieldCacheSize);
+      if(prefetch.kind == PrefetchKind::Automatic)
+        ser_read.setPrefetchDepth(prefetch.depth);
+      else if(prefetch.kind == PrefetchKind::AccessTrace)
+        ser_read.replayAccessTrace(prefetch.depth * savepointSize);
+
+      for(int s = 0; s < numSavepoints; ++s) {
+        for(const std::string& field : fields) {
+          auto sv = storage.toStorageView();
+          Timer timer;
+          ser_read.read(field, savepoints[s], sv);
+          stallTime += timer.stop();
+        }
+        ASSERT_EQ(storage(0, 0, 0), s);
+
+        if(prefetch.kind == PrefetchKind::Explicit)
+          ser_read.prefetch(savepoints[s], prefetch.depth);
+        std::this_thread::sleep_for(computeTime);
+      }
+    }
+    stallTime /= BenchmarkEnvironment::NumRepetitions;
+    result.timingsRead.push_back(std::make_pair(size, stallTime));
+  }
+
+  result.name = "Binary replay (" + prefetch.name + ", " + std::to_string(numSavepoints) +
+                " savepoints, cold page cache, read = stall time)";
+  BenchmarkEnvironment::getInstance().appendResult(result);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    BenchmarkTest, PrefetchBenchmark,
+    ::testing::Values(Prefetch{"no prefetch", PrefetchKind::Automatic, 0, 0},
+                      Prefetch{"automatic prefetch, depth 2", PrefetchKind::Automatic, 2, 0},
+                      Prefetch{"automatic prefetch into field cache, depth 2",
+                               PrefetchKind::Automatic, 2, std::size_t(256) << 20},
+                      Prefetch{"explicit prefetch into field cache, depth 1",
+                               PrefetchKind::Explicit, 1, std::size_t(256) << 20},
+                      Prefetch{"access trace, budget of 2 savepoints", PrefetchKind::AccessTrace,
+                               2, 0}));
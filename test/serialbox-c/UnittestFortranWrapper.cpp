@@ -411,3 +411,76 @@ TEST_F(CFortranWrapperTest, PermanentMetaInfo) {
     ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
 
 }
+
+TEST_F(CFortranWrapperTest, Handles) {
+  serialboxSavepoint_t* savepoint = serialboxSavepointCreate("Savepoint");
+  double input[2][1][3] = {{{1, 2, 3}}, {{4, 5, 6}}};
+  double output[2][1][3] = {{{0, 0, 0}}, {{0, 0, 0}}};
+
+  // Write by handle
+  {
+    serialboxSerializer_t* serializer =
+        serialboxSerializerCreate(Write, directory->path().c_str(), "Handles", "Binary");
+    ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+
+    serialboxFortranSerializerRegisterField(serializer, "field", Float64, 8, 3, 1, 2, 0, -1, 1, 0,
+                                            0, 0, 0, 0, 0);
+    ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+
+    serialboxFieldHandle_t* field = serialboxSerializerLookupField(serializer, "field");
+    int sp = serialboxSerializerFindOrAddSavepoint(serializer, savepoint);
+    ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+
+    // Halos have to match the registered ones
+    serialboxFortranSerializerCheckHalosHandle(field, -1, 1, 0, 0, 0, 0, 0, 0);
+    ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+    serialboxFortranSerializerCheckHalosHandle(field, -2, 2, 0, 0, 0, 0, 0, 0);
+    ASSERT_TRUE(this->hasErrorAndReset());
+
+    // Dimensions, rank and type have to match the registered ones
+    serialboxFortranSerializerWriteHandle(serializer, field, sp, Float64, &input[0][0][0],
+                                          &input[0][0][1], &input[0][0][0], &input[1][0][0],
+                                          &input[0][0][0], 3, 2, 1, 0);
+    ASSERT_TRUE(this->hasErrorAndReset());
+    serialboxFortranSerializerWriteHandle(serializer, field, sp, Float64, &input[0][0][0],
+                                          &input[0][0][1], &input[1][0][0], &input[0][0][0],
+                                          &input[0][0][0], 3, 2, 0, 0);
+    ASSERT_TRUE(this->hasErrorAndReset());
+    serialboxFortranSerializerWriteHandle(serializer, field, sp, Int32, &input[0][0][0],
+                                          &input[0][0][1], &input[0][0][0], &input[1][0][0],
+                                          &input[0][0][0], 3, 1, 2, 0);
+    ASSERT_TRUE(this->hasErrorAndReset());
+
+    serialboxFortranSerializerWriteHandle(serializer, field, sp, Float64, &input[0][0][0],
+                                          &input[0][0][1], &input[0][0][0], &input[1][0][0],
+                                          &input[0][0][0], 3, 1, 2, 0);
+    ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+
+    serialboxFieldHandleDestroy(field);
+    serialboxSerializerDestroy(serializer);
+  }
+
+  // Read by handle
+  {
+    serialboxSerializer_t* serializer =
+        serialboxSerializerCreate(Read, directory->path().c_str(), "Handles", "Binary");
+    ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+
+    serialboxFieldHandle_t* field = serialboxSerializerLookupField(serializer, "field");
+    int sp = serialboxSerializerFindSavepoint(serializer, savepoint);
+    ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+
+    serialboxFortranSerializerReadHandle(serializer, field, sp, Float64, &output[0][0][0],
+                                         &output[0][0][1], &output[0][0][0], &output[1][0][0],
+                                         &output[0][0][0], 3, 1, 2, 0);
+    ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+    for(int k = 0; k < 2; ++k)
+      for(int i = 0; i < 3; ++i)
+        EXPECT_EQ(output[k][0][i], input[k][0][i]);
+
+    serialboxFieldHandleDestroy(field);
+    serialboxSerializerDestroy(serializer);
+  }
+
+  serialboxSavepointDestroy(savepoint);
+}
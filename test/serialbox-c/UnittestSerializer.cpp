@@ -15,6 +15,7 @@
 #include "serialbox-c/FieldMetainfo.h"
 #include "serialbox-c/Metainfo.h"
 #include "serialbox-c/Savepoint.h"
+#include "serialbox-c/SavepointQuery.h"
 #include "serialbox-c/Serializer.h"
 #include "utility/CInterfaceTestBase.h"
 #include "utility/Storage.h"
@@ -337,6 +338,284 @@ TEST_F(CSerializerUtilityTest, StatelessSerialization) {
   ASSERT_TRUE(Storage::verify(storage_input, storage_output));
 }
 
+TEST_F(CSerializerUtilityTest, FieldCache) {
+  using Storage = serialbox::unittest::Storage<double>;
+  Storage storage_input(Storage::ColMajor, {5, 2, 5}, Storage::random);
+  Storage storage_output(Storage::ColMajor, {5, 2, 5});
+
+  serialboxSavepoint_t* savepoint = serialboxSavepointCreate("savepoint");
+
+  {
+    serialboxSerializer_t* ser_write =
+        serialboxSerializerCreate(Write, this->directory->path().c_str(), "Field", "Binary");
+    serialboxFieldMetainfo_t* info = serialboxFieldMetainfoCreate(
+        Float64, storage_input.dims().data(), storage_input.dims().size());
+    ASSERT_TRUE(serialboxSerializerAddField(ser_write, "u", info));
+    serialboxFieldMetainfoDestroy(info);
+
+    serialboxSerializerWrite(ser_write, "u", savepoint, (void*)storage_input.originPtr(),
+                             storage_input.strides().data(), storage_input.strides().size());
+    ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+    serialboxSerializerDestroy(ser_write);
+  }
+
+  serialboxSerializer_t* ser_read =
+      serialboxSerializerCreate(Read, this->directory->path().c_str(), "Field", "Binary");
+  EXPECT_EQ(serialboxSerializerGetFieldCacheSize(ser_read), 0);
+
+  serialboxSerializerSetFieldCacheSize(ser_read, 1 << 20);
+  EXPECT_EQ(serialboxSerializerGetFieldCacheSize(ser_read), 1 << 20);
+
+  for(int i = 0; i < 3; ++i) {
+    serialboxSerializerRead(ser_read, "u", savepoint, (void*)storage_output.originPtr(),
+                            storage_output.strides().data(), storage_output.strides().size());
+    ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+    ASSERT_TRUE(Storage::verify(storage_input, storage_output));
+  }
+  EXPECT_EQ(serialboxSerializerGetFieldCacheHits(ser_read), 2);
+  EXPECT_EQ(serialboxSerializerGetFieldCacheMisses(ser_read), 1);
+
+  serialboxSerializerFlushFieldCache(ser_read);
+  serialboxSerializerRead(ser_read, "u", savepoint, (void*)storage_output.originPtr(),
+                          storage_output.strides().data(), storage_output.strides().size());
+  EXPECT_EQ(serialboxSerializerGetFieldCacheMisses(ser_read), 2);
+
+  serialboxSavepointDestroy(savepoint);
+  serialboxSerializerDestroy(ser_read);
+}
+
+TEST_F(CSerializerUtilityTest, Handles) {
+  using Storage = serialbox::unittest::Storage<double>;
+  Storage storage_input(Storage::ColMajor, {5, 2, 5}, Storage::random);
+  Storage storage_output(Storage::ColMajor, {5, 2, 5});
+
+  serialboxSavepoint_t* savepoint1 = serialboxSavepointCreate("savepoint1");
+  serialboxSavepoint_t* savepoint2 = serialboxSavepointCreate("savepoint2");
+
+  {
+    serialboxSerializer_t* ser_write =
+        serialboxSerializerCreate(Write, this->directory->path().c_str(), "Field", "Binary");
+    serialboxFieldMetainfo_t* info = serialboxFieldMetainfoCreate(
+        Float64, storage_input.dims().data(), storage_input.dims().size());
+    ASSERT_TRUE(serialboxSerializerAddField(ser_write, "u", info));
+    serialboxFieldMetainfoDestroy(info);
+
+    EXPECT_EQ(serialboxSerializerLookupField(ser_write, "v"), nullptr);
+    serialboxFieldHandle_t* u = serialboxSerializerLookupField(ser_write, "u");
+    ASSERT_NE(u, nullptr);
+
+    EXPECT_EQ(serialboxSerializerFindSavepoint(ser_write, savepoint1), -1);
+    int sp1 = serialboxSerializerFindOrAddSavepoint(ser_write, savepoint1);
+    int sp2 = serialboxSerializerFindOrAddSavepoint(ser_write, savepoint2);
+    EXPECT_EQ(serialboxSerializerFindSavepoint(ser_write, savepoint1), sp1);
+    EXPECT_NE(sp1, sp2);
+
+    for(int sp : {sp1, sp2}) {
+      serialboxSerializerWriteByHandle(ser_write, u, sp, (void*)storage_input.originPtr(),
+                                       storage_input.strides().data(),
+                                       storage_input.strides().size());
+      ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+    }
+
+    // Field is already saved at savepoint2
+    serialboxSerializerWriteByHandle(ser_write, u, sp2, (void*)storage_input.originPtr(),
+                                     storage_input.strides().data(),
+                                     storage_input.strides().size());
+    ASSERT_TRUE(this->hasErrorAndReset());
+
+    serialboxFieldHandleDestroy(u);
+    serialboxSerializerDestroy(ser_write);
+  }
+
+  serialboxSerializer_t* ser_read =
+      serialboxSerializerCreate(Read, this->directory->path().c_str(), "Field", "Binary");
+  serialboxFieldHandle_t* u = serialboxSerializerLookupField(ser_read, "u");
+  ASSERT_NE(u, nullptr);
+
+  for(serialboxSavepoint_t* savepoint : {savepoint1, savepoint2}) {
+    int sp = serialboxSerializerFindSavepoint(ser_read, savepoint);
+    ASSERT_NE(sp, -1);
+
+    storage_output.forEach(Storage::random);
+    serialboxSerializerReadByHandle(ser_read, u, sp, (void*)storage_output.originPtr(),
+                                    storage_output.strides().data(),
+                                    storage_output.strides().size());
+    ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+    ASSERT_TRUE(Storage::verify(storage_input, storage_output));
+  }
+
+  // Invalid savepoint handle
+  serialboxSerializerReadByHandle(ser_read, u, 2, (void*)storage_output.originPtr(),
+                                  storage_output.strides().data(),
+                                  storage_output.strides().size());
+  ASSERT_TRUE(this->hasErrorAndReset());
+
+  serialboxFieldHandleDestroy(u);
+  serialboxSavepointDestroy(savepoint1);
+  serialboxSavepointDestroy(savepoint2);
+  serialboxSerializerDestroy(ser_read);
+}
+
+TEST_F(CSerializerUtilityTest, QuerySavepoints) {
+  serialboxSerializer_t* ser =
+      serialboxSerializerCreate(Write, this->directory->path().c_str(), "Field", "Binary");
+
+  // Savepoints "step" with step = 0, ..., 9 and time = 0, 0.5, ..., 4.5
+  for(int step = 0; step < 10; ++step) {
+    serialboxSavepoint_t* savepoint = serialboxSavepointCreate("step");
+    serialboxMetainfo_t* metaInfo = serialboxSavepointGetMetainfo(savepoint);
+    ASSERT_TRUE(serialboxMetainfoAddInt32(metaInfo, "step", step));
+    ASSERT_TRUE(serialboxMetainfoAddFloat64(metaInfo, "time", 0.5 * step));
+    ASSERT_TRUE(serialboxSerializerAddSavepoint(ser, savepoint));
+    serialboxMetainfoDestroy(metaInfo);
+    serialboxSavepointDestroy(savepoint);
+  }
+
+  // Range
+  serialboxSavepointQuery_t* query = serialboxSavepointQueryCreate();
+  serialboxSavepointQuerySetName(query, "step");
+  serialboxSavepointQueryRange(query, "step", 3, 6);
+
+  serialboxArrayOfInt32_t* indices = serialboxSerializerQuerySavepoints(ser, query);
+  ASSERT_EQ(indices->len, 3);
+  EXPECT_EQ(indices->data[0], 3);
+  EXPECT_EQ(indices->data[1], 4);
+  EXPECT_EQ(indices->data[2], 5);
+  serialboxArrayOfInt32Destroy(indices);
+
+  // Range and equality
+  serialboxSavepointQueryEqualFloat64(query, "time", 2.0);
+  indices = serialboxSerializerQuerySavepoints(ser, query);
+  ASSERT_EQ(indices->len, 1);
+  EXPECT_EQ(indices->data[0], 4);
+  serialboxArrayOfInt32Destroy(indices);
+
+  serialboxSavepointQueryEqualString(query, "time", "2.0");
+  indices = serialboxSerializerQuerySavepoints(ser, query);
+  EXPECT_EQ(indices->len, 0);
+  serialboxArrayOfInt32Destroy(indices);
+  serialboxSavepointQueryDestroy(query);
+
+  // Nearest
+  query = serialboxSavepointQueryCreate();
+  EXPECT_EQ(serialboxSerializerFindNearestSavepoint(ser, query, "time", 1.4), 3);
+  EXPECT_EQ(serialboxSerializerFindNearestSavepoint(ser, query, "X", 1.4), -1);
+
+  serialboxSavepointQueryEqualInt32(query, "step", 7);
+  EXPECT_EQ(serialboxSerializerFindNearestSavepoint(ser, query, "time", 1.4), 7);
+  serialboxSavepointQueryDestroy(query);
+
+  serialboxSerializerDestroy(ser);
+}
+
+TEST_F(CSerializerUtilityTest, Prefetch) {
+  using Storage = serialbox::unittest::Storage<double>;
+  Storage storage_input(Storage::ColMajor, {5, 2, 5}, Storage::random);
+  Storage storage_output(Storage::ColMajor, {5, 2, 5});
+
+  serialboxSavepoint_t* savepoint1 = serialboxSavepointCreate("savepoint1");
+  serialboxSavepoint_t* savepoint2 = serialboxSavepointCreate("savepoint2");
+
+  {
+    serialboxSerializer_t* ser_write =
+        serialboxSerializerCreate(Write, this->directory->path().c_str(), "Field", "Binary");
+    serialboxFieldMetainfo_t* info = serialboxFieldMetainfoCreate(
+        Float64, storage_input.dims().data(), storage_input.dims().size());
+    ASSERT_TRUE(serialboxSerializerAddField(ser_write, "u", info));
+    serialboxFieldMetainfoDestroy(info);
+
+    for(serialboxSavepoint_t* savepoint : {savepoint1, savepoint2})
+      serialboxSerializerWrite(ser_write, "u", savepoint, (void*)storage_input.originPtr(),
+                               storage_input.strides().data(), storage_input.strides().size());
+    ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+    serialboxSerializerDestroy(ser_write);
+  }
+
+  serialboxSerializer_t* ser_read =
+      serialboxSerializerCreate(Read, this->directory->path().c_str(), "Field", "Binary");
+
+  serialboxSerializerPrefetch(ser_read, savepoint1, 1);
+  ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+
+  EXPECT_EQ(serialboxSerializerGetPrefetchDepth(ser_read), 0);
+  serialboxSerializerSetPrefetchDepth(ser_read, 1);
+  EXPECT_EQ(serialboxSerializerGetPrefetchDepth(ser_read), 1);
+
+  serialboxSerializerRead(ser_read, "u", savepoint1, (void*)storage_output.originPtr(),
+                          storage_output.strides().data(), storage_output.strides().size());
+  ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+  ASSERT_TRUE(Storage::verify(storage_input, storage_output));
+
+  // Savepoint does not exist -> FatalError
+  serialboxSavepoint_t* savepoint3 = serialboxSavepointCreate("savepoint3");
+  serialboxSerializerPrefetch(ser_read, savepoint3, 1);
+  ASSERT_TRUE(this->hasErrorAndReset());
+
+  serialboxSavepointDestroy(savepoint1);
+  serialboxSavepointDestroy(savepoint2);
+  serialboxSavepointDestroy(savepoint3);
+  serialboxSerializerDestroy(ser_read);
+}
+
+TEST_F(CSerializerUtilityTest, AccessTrace) {
+  using Storage = serialbox::unittest::Storage<double>;
+  Storage storage_input(Storage::ColMajor, {5, 2, 5}, Storage::random);
+  Storage storage_output(Storage::ColMajor, {5, 2, 5});
+
+  serialboxSavepoint_t* savepoint1 = serialboxSavepointCreate("savepoint1");
+  serialboxSavepoint_t* savepoint2 = serialboxSavepointCreate("savepoint2");
+
+  {
+    serialboxSerializer_t* ser_write =
+        serialboxSerializerCreate(Write, this->directory->path().c_str(), "Field", "Binary");
+    serialboxFieldMetainfo_t* info = serialboxFieldMetainfoCreate(
+        Float64, storage_input.dims().data(), storage_input.dims().size());
+    ASSERT_TRUE(serialboxSerializerAddField(ser_write, "u", info));
+    serialboxFieldMetainfoDestroy(info);
+
+    for(serialboxSavepoint_t* savepoint : {savepoint1, savepoint2})
+      serialboxSerializerWrite(ser_write, "u", savepoint, (void*)storage_input.originPtr(),
+                               storage_input.strides().data(), storage_input.strides().size());
+    ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+    serialboxSerializerDestroy(ser_write);
+  }
+
+  // No access trace recorded yet -> FatalError
+  serialboxSerializer_t* ser_read =
+      serialboxSerializerCreate(Read, this->directory->path().c_str(), "Field", "Binary");
+  serialboxSerializerReplayAccessTrace(ser_read, 1 << 20);
+  ASSERT_TRUE(this->hasErrorAndReset());
+
+  // Record
+  EXPECT_EQ(serialboxSerializerIsRecordingAccessTrace(ser_read), 0);
+  serialboxSerializerSetAccessTraceRecording(ser_read, 1);
+  EXPECT_EQ(serialboxSerializerIsRecordingAccessTrace(ser_read), 1);
+  for(serialboxSavepoint_t* savepoint : {savepoint2, savepoint1})
+    serialboxSerializerRead(ser_read, "u", savepoint, (void*)storage_output.originPtr(),
+                            storage_output.strides().data(), storage_output.strides().size());
+  serialboxSerializerSetAccessTraceRecording(ser_read, 0);
+  EXPECT_EQ(serialboxSerializerIsRecordingAccessTrace(ser_read), 0);
+  ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+
+  // Replay
+  EXPECT_EQ(serialboxSerializerIsReplayingAccessTrace(ser_read), 0);
+  serialboxSerializerReplayAccessTrace(ser_read, 1 << 20);
+  ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+  EXPECT_EQ(serialboxSerializerIsReplayingAccessTrace(ser_read), 1);
+  for(serialboxSavepoint_t* savepoint : {savepoint2, savepoint1}) {
+    serialboxSerializerRead(ser_read, "u", savepoint, (void*)storage_output.originPtr(),
+                            storage_output.strides().data(), storage_output.strides().size());
+    ASSERT_FALSE(this->hasErrorAndReset()) << this->getLastErrorMsg();
+    ASSERT_TRUE(Storage::verify(storage_input, storage_output));
+  }
+  serialboxSerializerReplayAccessTrace(ser_read, 0);
+  EXPECT_EQ(serialboxSerializerIsReplayingAccessTrace(ser_read), 0);
+
+  serialboxSavepointDestroy(savepoint1);
+  serialboxSavepointDestroy(savepoint2);
+  serialboxSerializerDestroy(ser_read);
+}
+
 namespace {
 
 template <class T>
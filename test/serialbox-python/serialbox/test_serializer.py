@@ -471,6 +471,153 @@ class TestSerializer(unittest.TestCase):
         self.assertRaises(SerialboxError, ser_read.read_slice, "field", Savepoint("sp"),
                           Slice[:, :, :, :])
 
+    def test_write_and_read_handles(self):
+        fields = [np.random.rand(4, 5) for i in range(3)]
+        savepoints = [Savepoint("step-%i" % i) for i in range(3)]
+
+        #
+        # Write
+        #
+        ser_write = Serializer(OpenModeKind.Write, self.path, "field", self.archive)
+        ser_write.register_field("field", FieldMetainfo(TypeID.Float64, [4, 5]))
+
+        handle = ser_write.lookup_field("field")
+        self.assertEqual(handle.name, "field")
+        self.assertEqual(handle.dims, [4, 5])
+        self.assertEqual(handle.type, TypeID.Float64)
+
+        for field, savepoint in zip(fields, savepoints):
+            sp_handle = ser_write.find_or_register_savepoint(savepoint)
+            self.assertEqual(ser_write.find_savepoint(savepoint), sp_handle)
+            ser_write.write(handle, sp_handle, field)
+
+        #
+        # Read
+        #
+        ser_read = Serializer(OpenModeKind.Read, self.path, "field", self.archive)
+        handle = ser_read.lookup_field("field")
+
+        for field, savepoint in zip(fields, savepoints):
+            sp_handle = ser_read.find_savepoint(savepoint)
+            self.assertTrue(np.allclose(ser_read.read(handle, sp_handle), field))
+
+            field_output = np.ndarray(shape=[4, 5])
+            ser_read.read(handle, sp_handle, field_output)
+            self.assertTrue(np.allclose(field_output, field))
+
+        #
+        # Failures
+        #
+        self.assertEqual(ser_read.find_savepoint(Savepoint("X")), -1)
+        self.assertRaises(SerialboxError, ser_read.lookup_field, "X")
+        self.assertRaises(SerialboxError, ser_read.find_or_register_savepoint, Savepoint("X"))
+        self.assertRaises(SerialboxError, ser_read.read, handle, -1)
+        self.assertRaises(SerialboxError, ser_read.read, handle, 0, np.ndarray(shape=[5, 4]))
+
+    def test_query_savepoints(self):
+        ser = Serializer(OpenModeKind.Write, self.path, "field", self.archive)
+        for step in range(10):
+            ser.register_savepoint(Savepoint("step", {"step": step, "time": 0.5 * step}))
+        ser.register_savepoint(Savepoint("init", {"kind": "output"}))
+
+        #
+        # Query
+        #
+        self.assertEqual(len(ser.query_savepoints(SavepointQuery())), 11)
+        self.assertEqual(ser.query_savepoints(SavepointQuery("init")), [10])
+        self.assertEqual(ser.query_savepoints(SavepointQuery().equal("step", 3)), [3])
+        self.assertEqual(ser.query_savepoints(SavepointQuery().equal("step", 3.0)), [3])
+        self.assertEqual(ser.query_savepoints(SavepointQuery().equal("kind", "output")), [10])
+        self.assertEqual(ser.query_savepoints(SavepointQuery("step").range("time", 1.0, 2.5)),
+                         [2, 3, 4])
+        self.assertEqual(ser.query_savepoints(SavepointQuery("init").range("step", 0, 10)), [])
+        self.assertRaises(SerialboxError, SavepointQuery().equal, "step", [1, 2])
+
+        #
+        # Nearest
+        #
+        self.assertEqual(ser.find_nearest_savepoint("time", 1.4), 3)
+        self.assertEqual(ser.find_nearest_savepoint("time", 1.4, SavepointQuery().equal("step", 7)),
+                         7)
+        self.assertEqual(ser.find_nearest_savepoint("X", 1.4), -1)
+
+    def test_field_cache(self):
+        field_input = np.random.rand(10, 15, 20)
+
+        ser_write = Serializer(OpenModeKind.Write, self.path, "field", self.archive)
+        ser_write.write("field", Savepoint("sp"), field_input)
+
+        ser_read = Serializer(OpenModeKind.Read, self.path, "field", self.archive)
+        self.assertEqual(ser_read.field_cache_size, 0)
+
+        ser_read.field_cache_size = 1 << 20
+        self.assertEqual(ser_read.field_cache_size, 1 << 20)
+
+        for i in range(3):
+            field_output = ser_read.read("field", Savepoint("sp"))
+            self.assertTrue(np.allclose(field_output, field_input))
+
+        self.assertEqual(ser_read.field_cache_hits, 2)
+        self.assertEqual(ser_read.field_cache_misses, 1)
+
+        ser_read.flush_field_cache()
+        ser_read.read("field", Savepoint("sp"))
+        self.assertEqual(ser_read.field_cache_misses, 2)
+
+    def test_prefetch(self):
+        fields = [np.random.rand(10, 15, 20) for i in range(4)]
+        savepoints = [Savepoint("step-%i" % i) for i in range(4)]
+
+        ser_write = Serializer(OpenModeKind.Write, self.path, "field", self.archive)
+        for field, sp in zip(fields, savepoints):
+            ser_write.write("field", sp, field)
+
+        ser_read = Serializer(OpenModeKind.Read, self.path, "field", self.archive)
+        ser_read.prefetch(savepoints[0], 2)
+        self.assertRaises(SerialboxError, ser_read.prefetch, Savepoint("XXX"))
+
+        self.assertEqual(ser_read.prefetch_depth, 0)
+        ser_read.prefetch_depth = 2
+        self.assertEqual(ser_read.prefetch_depth, 2)
+
+        for field, sp in zip(fields, savepoints):
+            self.assertTrue(np.allclose(ser_read.read("field", sp), field))
+
+    def test_access_trace(self):
+        fields = [np.random.rand(10, 15, 20) for i in range(4)]
+        savepoints = [Savepoint("step-%i" % i) for i in range(4)]
+
+        ser_write = Serializer(OpenModeKind.Write, self.path, "field", self.archive)
+        for field, sp in zip(fields, savepoints):
+            ser_write.write("field", sp, field)
+
+        ser_read = Serializer(OpenModeKind.Read, self.path, "field", self.archive)
+        self.assertRaises(SerialboxError, ser_read.replay_access_trace, 1 << 20)
+
+        #
+        # Record
+        #
+        self.assertFalse(ser_read.record_access_trace)
+        ser_read.record_access_trace = True
+        self.assertTrue(ser_read.record_access_trace)
+        for field, sp in zip(fields, savepoints):
+            self.assertTrue(np.allclose(ser_read.read("field", sp), field))
+        ser_read.record_access_trace = False
+        self.assertFalse(ser_read.record_access_trace)
+
+        #
+        # Replay
+        #
+        ser_read = Serializer(OpenModeKind.Read, self.path, "field", self.archive)
+        self.assertFalse(ser_read.replaying_access_trace)
+        ser_read.replay_access_trace(1 << 20)
+        self.assertTrue(ser_read.replaying_access_trace)
+        for field, sp in zip(fields, savepoints):
+            self.assertTrue(np.allclose(ser_read.read("field", sp), field))
+
+        ser_read.replay_access_trace(0)
+        self.assertFalse(ser_read.replaying_access_trace)
+
     def test_write_and_read_stateless(self):
         field_input = np.random.rand(2, 2, 2)
         field_output = np.random.rand(2, 2, 2)
@@ -0,0 +1,155 @@
+//===-- serialbox/core/UnittestAccessTrace.cpp --------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the unittests of the access trace of the reads of a Serializer.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "utility/SerializerTestBase.h"
+#include "serialbox/core/AccessTrace.h"
+#include "serialbox/core/Exception.h"
+#include <fstream>
+#include <gtest/gtest.h>
+
+using namespace serialbox;
+using namespace unittest;
+
+namespace {
+
+class AccessTraceTest : public SerializerUnittestBase {};
+
+AccessTrace::Access makeAccess(const std::string& name, unsigned int id, int savepoint,
+                               std::vector<SliceTriple> slice = {}) {
+  return AccessTrace::Access{FieldID{name, id}, savepoint, slice};
+}
+
+} // anonymous namespace
+
+TEST_F(AccessTraceTest, Match) {
+  auto access = makeAccess("u", 1, 0, {{0, 5, 1}, {2, 4, 2}});
+  EXPECT_TRUE(access.matches(FieldID{"u", 1}, {{0, 5, 1}, {2, 4, 2}}));
+  EXPECT_FALSE(access.matches(FieldID{"u", 2}, {{0, 5, 1}, {2, 4, 2}}));
+  EXPECT_FALSE(access.matches(FieldID{"v", 1}, {{0, 5, 1}, {2, 4, 2}}));
+  EXPECT_FALSE(access.matches(FieldID{"u", 1}, {{0, 5, 1}, {2, 4, 1}}));
+  EXPECT_FALSE(access.matches(FieldID{"u", 1}, {{0, 5, 1}}));
+}
+
+TEST_F(AccessTraceTest, RecordAndRead) {
+  std::string filename = (this->directory->path() / AccessTrace::filename("field")).string();
+  EXPECT_EQ(AccessTrace::filename("field"), "AccessTrace-field.txt");
+
+  {
+    AccessTraceRecorder recorder(filename);
+    EXPECT_EQ(recorder.filename(), filename);
+    recorder.record(makeAccess("u", 0, 0));
+    recorder.record(makeAccess("field with spaces", 3, 1, {{0, 5, 1}, {2, 4, 2}}));
+    recorder.record(makeAccess("u", 1, 2));
+  }
+
+  AccessTrace trace = AccessTrace::fromFile(filename);
+  ASSERT_EQ(trace.size(), 3);
+  EXPECT_EQ(trace[0].fieldID, (FieldID{"u", 0}));
+  EXPECT_EQ(trace[0].savepoint, 0);
+  EXPECT_TRUE(trace[0].slice.empty());
+  EXPECT_EQ(trace[1].fieldID, (FieldID{"field with spaces", 3}));
+  EXPECT_EQ(trace[1].savepoint, 1);
+  EXPECT_TRUE(trace[1].matches(FieldID{"field with spaces", 3}, {{0, 5, 1}, {2, 4, 2}}));
+  EXPECT_EQ(trace[2].fieldID, (FieldID{"u", 1}));
+
+  // Round trip
+  std::string copy = (this->directory->path() / "copy.txt").string();
+  trace.toFile(copy);
+  AccessTrace traceCopy = AccessTrace::fromFile(copy);
+  ASSERT_EQ(traceCopy.size(), trace.size());
+  for(std::size_t i = 0; i < trace.size(); ++i)
+    EXPECT_TRUE(traceCopy[i].matches(trace[i].fieldID, trace[i].slice));
+}
+
+TEST_F(AccessTraceTest, Corrupted) {
+  std::string filename = (this->directory->path() / "trace.txt").string();
+  ASSERT_THROW(AccessTrace::fromFile(filename), Exception);
+
+  {
+    std::ofstream file(filename);
+    file << "something else\n";
+  }
+  ASSERT_THROW(AccessTrace::fromFile(filename), Exception);
+
+  {
+    std::ofstream file(filename);
+    file << AccessTrace::Magic << " " << AccessTrace::Version + 1 << "\n";
+  }
+  ASSERT_THROW(AccessTrace::fromFile(filename), Exception);
+
+  // Truncated access
+  {
+    std::ofstream file(filename);
+    file << AccessTrace::Magic << " " << AccessTrace::Version << "\n0 1 2 0 5 1\n";
+  }
+  ASSERT_THROW(AccessTrace::fromFile(filename), Exception);
+}
+
+TEST_F(AccessTraceTest, Follow) {
+  AccessTrace trace;
+  for(unsigned int id = 0; id < 6; ++id)
+    trace.push_back(makeAccess("u", id, id));
+
+  // The fourth access exceeds the budget and is never prefetched
+  AccessTraceFollower follower(trace, {100, 100, 100, 1000, 100, 100}, 250);
+  EXPECT_EQ(follower.budget(), 250);
+  EXPECT_EQ(follower.position(), 0);
+
+  EXPECT_EQ(follower.schedule(), (std::vector<std::size_t>{0, 1}));
+  EXPECT_EQ(follower.bytesInFlight(), 200);
+  EXPECT_TRUE(follower.schedule().empty());
+
+  // Reading the first access releases its budget
+  EXPECT_TRUE(follower.advance(FieldID{"u", 0}, {}));
+  EXPECT_EQ(follower.position(), 1);
+  EXPECT_EQ(follower.bytesInFlight(), 100);
+  EXPECT_EQ(follower.schedule(), (std::vector<std::size_t>{2}));
+
+  // Reads which are not part of the trace are ignored
+  EXPECT_FALSE(follower.advance(FieldID{"v", 0}, {}));
+  EXPECT_FALSE(follower.advance(FieldID{"u", 1}, {{0, 2, 1}}));
+  EXPECT_EQ(follower.position(), 1);
+
+  // Skipping accesses releases their budget as well
+  EXPECT_TRUE(follower.advance(FieldID{"u", 2}, {}));
+  EXPECT_EQ(follower.position(), 3);
+  EXPECT_EQ(follower.bytesInFlight(), 0);
+  EXPECT_EQ(follower.schedule(), (std::vector<std::size_t>{4, 5}));
+
+  // Reads behind the cursor are not part of the (remaining) trace
+  EXPECT_FALSE(follower.advance(FieldID{"u", 0}, {}));
+  EXPECT_TRUE(follower.advance(FieldID{"u", 5}, {}));
+  EXPECT_EQ(follower.position(), 6);
+  EXPECT_EQ(follower.bytesInFlight(), 0);
+  EXPECT_TRUE(follower.schedule().empty());
+
+  ASSERT_THROW(AccessTraceFollower(trace, {100}, 250), Exception);
+}
+
+TEST_F(AccessTraceTest, FollowLookAhead) {
+  AccessTrace trace;
+  for(unsigned int id = 0; id < 6; ++id)
+    trace.push_back(makeAccess("u", id, id));
+
+  AccessTraceFollower follower(trace, std::vector<std::size_t>(6, 100), 1000, 2);
+  EXPECT_EQ(follower.lookAhead(), 2);
+
+  // Reads beyond the window are ignored
+  EXPECT_FALSE(follower.advance(FieldID{"u", 2}, {}));
+  EXPECT_EQ(follower.position(), 0);
+  EXPECT_TRUE(follower.advance(FieldID{"u", 1}, {}));
+  EXPECT_EQ(follower.position(), 2);
+  EXPECT_TRUE(follower.advance(FieldID{"u", 3}, {}));
+  EXPECT_EQ(follower.position(), 4);
+}
@@ -0,0 +1,115 @@
+//===-- serialbox/core/UnittestFieldCache.cpp ---------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the unittests of the cache of deserialized fields.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "utility/Storage.h"
+#include "serialbox/core/FieldCache.h"
+#include <gtest/gtest.h>
+
+using namespace serialbox;
+using namespace unittest;
+
+TEST(FieldCacheTest, Disabled) {
+  Storage<double> storage(Storage<double>::ColMajor, {5, 6, 7}, Storage<double>::random);
+  auto sv = storage.toStorageView();
+
+  FieldCache cache;
+  EXPECT_FALSE(cache.isEnabled());
+  cache.insert(FieldID{"u", 0}, sv);
+  EXPECT_FALSE(cache.lookup(FieldID{"u", 0}, sv));
+  EXPECT_EQ(cache.statistics().entries, 0);
+  EXPECT_EQ(cache.statistics().misses, 0);
+}
+
+TEST(FieldCacheTest, LookupAndInsert) {
+  using Storage = Storage<double>;
+  Storage input(Storage::ColMajor, {5, 6, 7}, Storage::random);
+  Storage output(Storage::ColMajor, {5, 6, 7});
+  Storage outputPadded(Storage::RowMajor, {5, 6, 7}, {{1, 2}, {0, 3}, {2, 0}});
+
+  FieldCache cache(1 << 20);
+  auto svInput = input.toStorageView();
+  auto svOutput = output.toStorageView();
+  auto svOutputPadded = outputPadded.toStorageView();
+
+  EXPECT_FALSE(cache.lookup(FieldID{"u", 0}, svOutput));
+  cache.insert(FieldID{"u", 0}, svInput);
+
+  // Contiguous and non-contiguous storages are served from the same entry
+  ASSERT_TRUE(cache.lookup(FieldID{"u", 0}, svOutput));
+  ASSERT_TRUE(Storage::verify(input, output));
+  ASSERT_TRUE(cache.lookup(FieldID{"u", 0}, svOutputPadded));
+  ASSERT_TRUE(Storage::verify(input, outputPadded));
+
+  // Other ids and slices are distinct entries
+  EXPECT_FALSE(cache.lookup(FieldID{"u", 1}, svOutput));
+  svOutput.setSlice(Slice(1, 3)()(2, 3));
+  EXPECT_FALSE(cache.lookup(FieldID{"u", 0}, svOutput));
+
+  auto svSliced = input.toStorageView();
+  svSliced.setSlice(Slice(1, 3)()(2, 3));
+  cache.insert(FieldID{"u", 0}, svSliced);
+
+  output.forEach(Storage::random);
+  ASSERT_TRUE(cache.lookup(FieldID{"u", 0}, svOutput));
+  for(int j = 0; j < 6; ++j)
+    for(int i = 1; i < 3; ++i)
+      ASSERT_EQ(input(i, j, 2), output(i, j, 2));
+
+  FieldCache::Statistics statistics = cache.statistics();
+  EXPECT_EQ(statistics.hits, 3);
+  EXPECT_EQ(statistics.misses, 3);
+  EXPECT_EQ(statistics.entries, 2);
+  EXPECT_EQ(statistics.bytes, (5 * 6 * 7 + 2 * 6) * sizeof(double));
+
+  cache.flush();
+  EXPECT_EQ(cache.statistics().entries, 0);
+  EXPECT_EQ(cache.statistics().bytes, 0);
+  EXPECT_EQ(cache.statistics().hits, 3);
+
+  cache.resetStatistics();
+  EXPECT_EQ(cache.statistics().hits, 0);
+  EXPECT_EQ(cache.statistics().misses, 0);
+}
+
+TEST(FieldCacheTest, Eviction) {
+  using Storage = Storage<double>;
+  Storage storage(Storage::ColMajor, {10, 10}, Storage::random);
+  auto sv = storage.toStorageView();
+  const std::size_t size = sv.sizeInBytes();
+
+  FieldCache cache(2 * size);
+  cache.insert(FieldID{"u", 0}, sv);
+  cache.insert(FieldID{"u", 1}, sv);
+
+  // Touch id 0 so that id 1 is the least recently used entry
+  ASSERT_TRUE(cache.lookup(FieldID{"u", 0}, sv));
+  cache.insert(FieldID{"u", 2}, sv);
+
+  EXPECT_TRUE(cache.lookup(FieldID{"u", 0}, sv));
+  EXPECT_FALSE(cache.lookup(FieldID{"u", 1}, sv));
+  EXPECT_TRUE(cache.lookup(FieldID{"u", 2}, sv));
+  EXPECT_EQ(cache.statistics().bytes, 2 * size);
+
+  // Demoted entries are evicted first
+  cache.demote(FieldID{"u", 2}, sv);
+  cache.insert(FieldID{"u", 3}, sv);
+  EXPECT_TRUE(cache.contains(FieldID{"u", 0}, sv));
+  EXPECT_FALSE(cache.contains(FieldID{"u", 2}, sv));
+
+  // Fields exceeding the budget are not cached
+  cache.setCapacity(size / 2);
+  EXPECT_EQ(cache.statistics().entries, 0);
+  cache.insert(FieldID{"u", 0}, sv);
+  EXPECT_EQ(cache.statistics().entries, 0);
+}
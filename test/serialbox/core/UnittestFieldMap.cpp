@@ -289,6 +289,53 @@ TEST(FieldMapTest, fromJSON) {
   }
 }
 
+TEST(FieldMapTest, fromJSONStream) {
+  FieldMap map;
+  ASSERT_TRUE(map.insert("field1", constructFieldMetainfoImpl(1.0)));
+  ASSERT_TRUE(map.insert("field2", constructFieldMetainfoImpl(2.0)));
+  ASSERT_TRUE(map.insert("field3", TypeID::Int32, std::vector<int>{1}));
+
+  // -----------------------------------------------------------------------------------------------
+  // Success
+  // -----------------------------------------------------------------------------------------------
+  {
+    const std::string document = json::json(map).dump(2);
+    JsonReader reader(document.data(), document.size());
+
+    FieldMap fromStream;
+    ASSERT_NO_THROW(from_json(reader, fromStream));
+    ASSERT_NO_THROW(reader.end());
+
+    ASSERT_EQ(fromStream.size(), 3);
+    EXPECT_EQ(json::json(fromStream), json::json(map));
+    EXPECT_EQ(fromStream.getMetainfoOf("field2").at("key2").as<double>(), 2.0);
+    EXPECT_EQ(fromStream.getDimsOf("field3"), (std::vector<int>{1}));
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Failure (corrupted meta_info of field1; key1 is missing the type-id)
+  // -----------------------------------------------------------------------------------------------
+  {
+    const std::string document = R"(
+    {
+        "field1": {
+            "dims": [32, 16],
+            "meta_info": {
+                "key1": {
+                    "value": "field1_meta_info_str"
+                }
+            },
+            "type_id": 4
+        }
+    }
+    )";
+    JsonReader reader(document.data(), document.size());
+
+    FieldMap fromStream;
+    ASSERT_THROW(from_json(reader, fromStream), Exception);
+  }
+}
+
 TEST(FieldMapTest, toString) {
   FieldMap map;
   ASSERT_TRUE(map.insert("field1", constructFieldMetainfoImpl(1.0)));
@@ -0,0 +1,114 @@
+//===-- serialbox/core/UnittestInternTable.cpp --------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This implements the unittests of the InternTable.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/InternTable.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace serialbox;
+
+TEST(InternTableTest, Intern) {
+  InternTable table;
+  EXPECT_EQ(table.size(), 0);
+  EXPECT_EQ(table.find("key"), nullptr);
+
+  InternTable::Handle h1 = table.intern("key");
+  ASSERT_NE(h1, nullptr);
+  EXPECT_EQ(*h1, "key");
+  EXPECT_EQ(table.find("key"), h1);
+
+  // Equal strings share the handle
+  std::string key("ke");
+  key += "y";
+  EXPECT_EQ(table.intern(key), h1);
+  EXPECT_EQ(table.size(), 1);
+
+  InternTable::Handle h2 = table.intern("other");
+  EXPECT_NE(h1, h2);
+  EXPECT_EQ(table.size(), 2);
+
+  // Handles are stable
+  for(int i = 0; i < 1000; ++i)
+    table.intern("key" + std::to_string(i));
+  EXPECT_EQ(table.intern("key"), h1);
+  EXPECT_EQ(*h1, "key");
+}
+
+TEST(InternTableTest, Concurrent) {
+  InternTable table;
+  std::vector<std::thread> threads;
+  std::vector<InternTable::Handle> handles(4);
+
+  for(int t = 0; t < 4; ++t)
+    threads.emplace_back([&, t]() {
+      for(int i = 0; i < 100; ++i)
+        table.intern(std::to_string(i));
+      handles[t] = table.intern("shared");
+    });
+  for(auto& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(table.size(), 101);
+  for(int t = 1; t < 4; ++t)
+    EXPECT_EQ(handles[t], handles[0]);
+}
+
+TEST(InternTableTest, Global) {
+  InternTable::Handle h = InternTable::global().intern("InternTableTest.Global");
+  EXPECT_EQ(InternTable::global().find("InternTableTest.Global"), h);
+  EXPECT_EQ(InternTable::global().intern("InternTableTest.Global"), h);
+
+  // Handles cached by different threads refer to the same string
+  std::vector<InternTable::Handle> handles(4);
+  std::vector<std::thread> threads;
+  for(int t = 0; t < 4; ++t)
+    threads.emplace_back([&, t]() {
+      InternTable::global().intern("InternTableTest.GlobalShared");
+      handles[t] = InternTable::global().intern("InternTableTest.GlobalShared");
+      EXPECT_EQ(InternTable::global().intern("InternTableTest.Global"), h);
+    });
+  for(auto& thread : threads)
+    thread.join();
+
+  for(int t = 1; t < 4; ++t)
+    EXPECT_EQ(handles[t], handles[0]);
+  EXPECT_EQ(InternTable::global().find("InternTableTest.GlobalShared"), handles[0]);
+}
+
+TEST(InternedStringTest, Comparison) {
+  InternedString s1("InternedStringTest.u");
+  InternedString s2(std::string("InternedStringTest.u"));
+  InternedString s3("InternedStringTest.v");
+
+  EXPECT_EQ(s1.handle(), s2.handle());
+  EXPECT_TRUE(s1 == s2);
+  EXPECT_TRUE(s1 != s3);
+  EXPECT_TRUE(s1 < s3);
+  EXPECT_TRUE(s1 == std::string("InternedStringTest.u"));
+  EXPECT_TRUE(s1 != "InternedStringTest.v");
+  EXPECT_EQ(std::string("prefix_") + s1, "prefix_InternedStringTest.u");
+  EXPECT_EQ(std::hash<InternedString>()(s1), std::hash<InternedString>()(s2));
+
+  // Empty strings
+  EXPECT_TRUE(InternedString().empty());
+  EXPECT_EQ(InternedString(), InternedString(""));
+
+  // Lookup does not intern
+  EXPECT_EQ(InternedString::lookup("InternedStringTest.u"), s1);
+  InternedString unknown = InternedString::lookup("InternedStringTest.unknown");
+  EXPECT_FALSE(unknown.valid());
+  EXPECT_EQ(InternTable::global().find("InternedStringTest.unknown"), nullptr);
+  EXPECT_FALSE(unknown == std::string("InternedStringTest.unknown"));
+}
@@ -0,0 +1,136 @@
+//===-- serialbox/core/UnittestJsonReader.cpp ---------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements the unittests of the JsonReader.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/Exception.h"
+#include "serialbox/core/JsonReader.h"
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace serialbox;
+
+TEST(JsonReaderTest, Traversal) {
+  std::istringstream stream(R"(
+    {
+      "name": "savepoint",
+      "flag": true,
+      "null": null,
+      "ints": [-1, 2, 9223372036854775807],
+      "float": 0.5,
+      "nested": {"a": [1, {"b": "c"}], "d": {}}
+    }
+  )");
+  JsonReader reader(stream);
+
+  std::string key;
+  std::vector<std::string> keys;
+
+  reader.beginObject();
+  while(reader.nextKey(key)) {
+    keys.push_back(key);
+    if(key == "name") {
+      EXPECT_EQ(reader.peek(), JsonReader::ValueKind::String);
+      EXPECT_EQ(reader.readString(), "savepoint");
+    } else if(key == "flag") {
+      EXPECT_FALSE(reader.readNull());
+      EXPECT_TRUE(reader.readBoolean());
+    } else if(key == "null") {
+      EXPECT_TRUE(reader.readNull());
+    } else if(key == "ints") {
+      std::vector<std::int64_t> values;
+      reader.beginArray();
+      while(reader.nextElement())
+        values.push_back(reader.readInteger());
+      EXPECT_EQ(values, (std::vector<std::int64_t>{-1, 2, 9223372036854775807}));
+    } else if(key == "float") {
+      EXPECT_EQ(reader.peek(), JsonReader::ValueKind::Number);
+      EXPECT_DOUBLE_EQ(reader.readNumber(), 0.5);
+    } else {
+      EXPECT_EQ(reader.peek(), JsonReader::ValueKind::Object);
+      reader.skipValue();
+    }
+  }
+  EXPECT_EQ(reader.peek(), JsonReader::ValueKind::None);
+  EXPECT_NO_THROW(reader.end());
+
+  EXPECT_EQ(keys, (std::vector<std::string>{"name", "flag", "null", "ints", "float", "nested"}));
+}
+
+TEST(JsonReaderTest, ReadValue) {
+  const std::string document = R"({"a": [1, -2, 0.5, "s", true, null], "b": {"c": {}}})";
+  JsonReader reader(document.data(), document.size());
+
+  json::json value = reader.readValue();
+  EXPECT_NO_THROW(reader.end());
+  EXPECT_EQ(value, json::json::parse(document));
+}
+
+TEST(JsonReaderTest, Numbers) {
+  const std::string document = "[1, -1, 1.5, 18446744073709551615]";
+  JsonReader reader(document.data(), document.size());
+  reader.beginArray();
+
+  ASSERT_TRUE(reader.nextElement());
+  EXPECT_EQ(reader.readUnsigned(), 1);
+
+  // Negative numbers are no unsigned integers
+  ASSERT_TRUE(reader.nextElement());
+  EXPECT_THROW(reader.readUnsigned(), Exception);
+  EXPECT_EQ(reader.readInteger(), -1);
+
+  // Floating point numbers are no integers
+  ASSERT_TRUE(reader.nextElement());
+  EXPECT_THROW(reader.readInteger(), Exception);
+  EXPECT_DOUBLE_EQ(reader.readNumber(), 1.5);
+
+  // Out of range of signed integers
+  ASSERT_TRUE(reader.nextElement());
+  EXPECT_THROW(reader.readInteger(), Exception);
+  EXPECT_EQ(reader.readUnsigned(), 18446744073709551615ull);
+
+  EXPECT_FALSE(reader.nextElement());
+  EXPECT_NO_THROW(reader.end());
+}
+
+TEST(JsonReaderTest, Failure) {
+  auto read = [](const std::string& document) {
+    JsonReader reader(document.data(), document.size());
+    reader.skipValue();
+    reader.end();
+  };
+
+  EXPECT_NO_THROW(read(R"({"a": [1, 2], "b": {}})"));
+
+  // Syntax errors
+  EXPECT_THROW(read(R"({"a": [1, 2})"), Exception);
+  EXPECT_THROW(read(R"({"a" 1})"), Exception);
+  EXPECT_THROW(read(R"({"a": 1 "b": 2})"), Exception);
+  EXPECT_THROW(read(R"({"a": 1,})"), Exception);
+  EXPECT_THROW(read(R"([1, 2,])"), Exception);
+  EXPECT_THROW(read(R"({1: 2})"), Exception);
+  EXPECT_THROW(read(R"({"a": tru})"), Exception);
+  EXPECT_THROW(read(R"({"a": 1}})"), Exception);
+  EXPECT_THROW(read(""), Exception);
+
+  // Unexpected values
+  const std::string document = R"({"a": "1"})";
+  JsonReader reader(document.data(), document.size());
+  EXPECT_THROW(reader.beginArray(), Exception);
+  reader.beginObject();
+  std::string key;
+  ASSERT_TRUE(reader.nextKey(key));
+  EXPECT_THROW(reader.readInteger(), Exception);
+  EXPECT_THROW(reader.readBoolean(), Exception);
+  EXPECT_EQ(reader.readString(), "1");
+  EXPECT_FALSE(reader.nextKey(key));
+}
@@ -0,0 +1,333 @@
+//===-- serialbox/core/UnittestMetaDataSnapshot.cpp ---------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the unittests of the binary snapshot of the meta-data.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "utility/SerializerTestBase.h"
+#include "utility/Storage.h"
+#include "serialbox/core/Exception.h"
+#include "serialbox/core/MetaDataSnapshot.h"
+#include "serialbox/core/SerializerImpl.h"
+#include <cstdlib>
+#include <fstream>
+#include <gtest/gtest.h>
+
+using namespace serialbox;
+using namespace unittest;
+
+namespace {
+
+class MetaDataSnapshotTest : public SerializerUnittestBase {
+protected:
+  virtual void SetUp() override {
+    SerializerUnittestBase::SetUp();
+
+    globalMetainfo.insert("bool", true);
+    globalMetainfo.insert("int64", std::int64_t(-64));
+    globalMetainfo.insert("string", std::string("str"));
+    globalMetainfo.insert("array_of_double", Array<double>{1.5, -2.5});
+    globalMetainfo.insert("array_of_string", Array<std::string>{"a", "", "b"});
+
+    MetainfoMapImpl fieldMetainfo;
+    fieldMetainfo.insert("float", 1.5f);
+    fieldMap.insert("u", TypeID::Float64, std::vector<int>{10, 15, 20}, fieldMetainfo);
+    fieldMap.insert("v", TypeID::Int32, std::vector<int>{5}, MetainfoMapImpl());
+
+    for(int i = 0; i < 8; ++i) {
+      SavepointImpl savepoint(i % 2 ? "odd" : "even");
+      savepoint.addMetainfo("step", i);
+      savepoint.addMetainfo("time", 0.5 * i);
+      int idx = savepointVector.insert(savepoint);
+      savepointVector.addField(idx, FieldID{"u", unsigned(i)});
+      if(i % 3 == 0)
+        savepointVector.addField(idx, FieldID{"v", unsigned(i / 3)});
+    }
+    savepointVector.insert(SavepointImpl("empty"));
+
+    snapshotFile = (directory->path() / MetaDataSnapshot::filename("field")).string();
+    source.size = 1024;
+    source.mtime = 42;
+    source.hash = 7;
+  }
+
+  MetainfoMapImpl globalMetainfo;
+  SavepointVector savepointVector;
+  FieldMap fieldMap;
+
+  std::string snapshotFile;
+  MetaDataSnapshot::Source source;
+};
+
+} // anonymous namespace
+
+TEST_F(MetaDataSnapshotTest, Filename) {
+  EXPECT_EQ(MetaDataSnapshot::filename("field"), "MetaData-field.bin");
+  EXPECT_EQ(MetaDataSnapshot::archiveFilename("field"), "ArchiveMetaData-field.bin");
+}
+
+TEST_F(MetaDataSnapshotTest, Source) {
+  std::string filename = (directory->path() / "file.txt").string();
+  ASSERT_THROW(MetaDataSnapshot::Source::of(filename), Exception);
+
+  {
+    std::ofstream fs(filename);
+    fs << "{\"serialbox_version\": 0}";
+  }
+  MetaDataSnapshot::Source a = MetaDataSnapshot::Source::of(filename);
+  EXPECT_EQ(a.size, 24);
+  EXPECT_TRUE(a == MetaDataSnapshot::Source::of(filename));
+
+  {
+    std::ofstream fs(filename);
+    fs << "{\"serialbox_version\": 1}";
+  }
+  MetaDataSnapshot::Source b = MetaDataSnapshot::Source::of(filename);
+  EXPECT_EQ(b.size, 24);
+  EXPECT_NE(a.hash, b.hash);
+}
+
+TEST_F(MetaDataSnapshotTest, WriteAndRead) {
+  MetaDataSnapshot::write(snapshotFile, source, globalMetainfo, savepointVector, fieldMap);
+
+  MetainfoMapImpl globalMetainfoRead;
+  SavepointVector savepointVectorRead;
+  FieldMap fieldMapRead;
+  ASSERT_TRUE(MetaDataSnapshot::read(snapshotFile, source, globalMetainfoRead,
+                                     savepointVectorRead, fieldMapRead));
+
+  // Global meta-information
+  EXPECT_TRUE(globalMetainfoRead == globalMetainfo);
+
+  // Savepoints
+  ASSERT_EQ(savepointVectorRead.size(), savepointVector.size());
+  for(std::size_t i = 0; i < savepointVector.size(); ++i) {
+    EXPECT_EQ(savepointVectorRead[i], savepointVector[i]);
+    EXPECT_EQ(savepointVectorRead.find(savepointVector[i]), int(i));
+  }
+
+  // Fields of the savepoints
+  EXPECT_EQ(savepointVectorRead.fieldNames(), savepointVector.fieldNames());
+  for(std::size_t i = 0; i < savepointVector.size(); ++i) {
+    auto fields = savepointVector.fieldsOf(i);
+    auto fieldsRead = savepointVectorRead.fieldsOf(i);
+    ASSERT_EQ(fieldsRead.size(), fields.size());
+    for(auto it = fields.begin(), end = fields.end(); it != end; ++it)
+      EXPECT_EQ(savepointVectorRead.getFieldID(i, it->first.str()).id, it->second);
+  }
+  EXPECT_EQ(savepointVectorRead.getLatestFieldID(7, "v").id, 2);
+
+  // Field map
+  ASSERT_EQ(fieldMapRead.size(), fieldMap.size());
+  for(auto it = fieldMap.begin(), end = fieldMap.end(); it != end; ++it) {
+    ASSERT_TRUE(fieldMapRead.hasField(it->first));
+    EXPECT_TRUE(fieldMapRead.getFieldMetainfoImplOf(it->first) == *it->second);
+  }
+}
+
+TEST_F(MetaDataSnapshotTest, Stale) {
+  MetainfoMapImpl globalMetainfoRead;
+  SavepointVector savepointVectorRead;
+  FieldMap fieldMapRead;
+
+  // Snapshot does not exist
+  EXPECT_FALSE(MetaDataSnapshot::read(snapshotFile, source, globalMetainfoRead,
+                                      savepointVectorRead, fieldMapRead));
+
+  // Snapshot of a different source
+  MetaDataSnapshot::write(snapshotFile, source, globalMetainfo, savepointVector, fieldMap);
+
+  MetaDataSnapshot::Source modified = source;
+  modified.mtime += 1;
+  EXPECT_FALSE(MetaDataSnapshot::read(snapshotFile, modified, globalMetainfoRead,
+                                      savepointVectorRead, fieldMapRead));
+  EXPECT_TRUE(globalMetainfoRead.empty());
+  EXPECT_TRUE(savepointVectorRead.empty());
+  EXPECT_TRUE(fieldMapRead.empty());
+}
+
+TEST_F(MetaDataSnapshotTest, Corrupted) {
+  MetaDataSnapshot::write(snapshotFile, source, globalMetainfo, savepointVector, fieldMap);
+
+  std::string content;
+  {
+    std::ifstream fs(snapshotFile, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(fs), std::istreambuf_iterator<char>());
+  }
+
+  MetainfoMapImpl globalMetainfoRead;
+  SavepointVector savepointVectorRead;
+  FieldMap fieldMapRead;
+
+  // Truncated
+  {
+    std::ofstream fs(snapshotFile, std::ios::binary | std::ios::trunc);
+    fs.write(content.data(), content.size() - 4);
+  }
+  ASSERT_THROW(MetaDataSnapshot::read(snapshotFile, source, globalMetainfoRead,
+                                      savepointVectorRead, fieldMapRead),
+               Exception);
+
+  // Not a snapshot
+  {
+    std::ofstream fs(snapshotFile, std::ios::binary | std::ios::trunc);
+    fs << "not a snapshot";
+  }
+  ASSERT_THROW(MetaDataSnapshot::read(snapshotFile, source, globalMetainfoRead,
+                                      savepointVectorRead, fieldMapRead),
+               Exception);
+}
+
+TEST_F(MetaDataSnapshotTest, ArchiveWriteAndRead) {
+  // Entries stored as is and with each kind of layout description
+  BinaryArchive::FieldTable fieldTable;
+  fieldTable["u"].push_back(BinaryArchive::FileOffsetType{0, "checksum-0"});
+  fieldTable["u"].push_back(BinaryArchive::FileOffsetType{128, "checksum-1"});
+
+  BinaryArchive::FileOffsetType encoded{256, "checksum-2"};
+  encoded.codec.codec = "lz";
+  encoded.codec.shuffle = 8;
+  encoded.codec.blockSize = 1024;
+  encoded.codec.size = 3000;
+  encoded.codec.blocks = {100, 200, 300};
+  encoded.codec.errorBoundKind = ErrorBoundKind::Absolute;
+  encoded.codec.errorBound = 1e-3;
+  encoded.codec.maxError = 5e-4;
+  encoded.codec.deltaReference = 1;
+  encoded.codec.deltaDepth = 2;
+  encoded.chunks.shape = {4, 4};
+  encoded.chunks.offsets = {0, 1000, 2000};
+  fieldTable["u"].push_back(encoded);
+
+  BinaryArchive::FileOffsetType uniform{0, "checksum-3"};
+  uniform.uniform.value = {1, 0, 0, 0};
+  uniform.uniform.dims = {5, 6};
+  fieldTable["v"].push_back(uniform);
+
+  BinaryArchive::FileOffsetType stored{0, "checksum-4"};
+  stored.blockStore = "blocks";
+  stored.blocks = {BlockReference{"digest-a", 64}, BlockReference{"digest-b", 32}};
+  fieldTable["w"].push_back(stored);
+
+  const std::string archiveSnapshotFile =
+      (directory->path() / MetaDataSnapshot::archiveFilename("field")).string();
+  MetaDataSnapshot::writeArchive(archiveSnapshotFile, source, "SHA256", fieldTable);
+
+  std::string hashAlgorithm;
+  BinaryArchive::FieldTable fieldTableRead;
+  ASSERT_TRUE(
+      MetaDataSnapshot::readArchive(archiveSnapshotFile, source, hashAlgorithm, fieldTableRead));
+  EXPECT_EQ(hashAlgorithm, "SHA256");
+
+  ASSERT_EQ(fieldTableRead.size(), fieldTable.size());
+  for(auto it = fieldTable.begin(), end = fieldTable.end(); it != end; ++it) {
+    const BinaryArchive::FieldOffsetTable& entries = fieldTableRead.at(it->first);
+    ASSERT_EQ(entries.size(), it->second.size());
+    for(std::size_t id = 0; id < entries.size(); ++id) {
+      const BinaryArchive::FileOffsetType& a = entries[id];
+      const BinaryArchive::FileOffsetType& b = it->second[id];
+      EXPECT_EQ(a.offset, b.offset);
+      EXPECT_EQ(a.checksum, b.checksum);
+      EXPECT_EQ(a.codec.codec, b.codec.codec);
+      EXPECT_EQ(a.codec.shuffle, b.codec.shuffle);
+      EXPECT_EQ(a.codec.blockSize, b.codec.blockSize);
+      EXPECT_EQ(a.codec.size, b.codec.size);
+      EXPECT_EQ(a.codec.blocks, b.codec.blocks);
+      EXPECT_EQ(a.codec.errorBoundKind, b.codec.errorBoundKind);
+      EXPECT_EQ(a.codec.errorBound, b.codec.errorBound);
+      EXPECT_EQ(a.codec.maxError, b.codec.maxError);
+      EXPECT_EQ(a.codec.deltaReference, b.codec.deltaReference);
+      EXPECT_EQ(a.codec.deltaDepth, b.codec.deltaDepth);
+      EXPECT_EQ(a.chunks.shape, b.chunks.shape);
+      EXPECT_EQ(a.chunks.offsets, b.chunks.offsets);
+      EXPECT_EQ(a.uniform.value, b.uniform.value);
+      EXPECT_EQ(a.uniform.dims, b.uniform.dims);
+      EXPECT_EQ(a.blockStore, b.blockStore);
+      ASSERT_EQ(a.blocks.size(), b.blocks.size());
+      for(std::size_t i = 0; i < a.blocks.size(); ++i) {
+        EXPECT_EQ(a.blocks[i].digest, b.blocks[i].digest);
+        EXPECT_EQ(a.blocks[i].size, b.blocks[i].size);
+      }
+    }
+  }
+
+  // Snapshot of a different source
+  MetaDataSnapshot::Source modified = source;
+  modified.hash += 1;
+  EXPECT_FALSE(
+      MetaDataSnapshot::readArchive(archiveSnapshotFile, modified, hashAlgorithm, fieldTableRead));
+
+  // The snapshots of the serializer and the archive can't be mixed up
+  MetaDataSnapshot::write(snapshotFile, source, globalMetainfo, savepointVector, fieldMap);
+  ASSERT_THROW(MetaDataSnapshot::readArchive(snapshotFile, source, hashAlgorithm, fieldTableRead),
+               Exception);
+}
+
+TEST_F(MetaDataSnapshotTest, Serializer) {
+  using Storage = Storage<double>;
+  Storage u(Storage::RowMajor, {5, 6}, Storage::random);
+  Storage u_read(Storage::RowMajor, {5, 6});
+
+  {
+    SerializerImpl s_write(OpenModeKind::Write, directory->path().string(), "field", "Binary");
+    s_write.addGlobalMetainfo("key", std::string("value"));
+    s_write.registerField("u", TypeID::Float64, std::vector<int>{5, 6});
+    for(int i = 0; i < 4; ++i) {
+      SavepointImpl savepoint("sp");
+      savepoint.addMetainfo("step", i);
+      s_write.write("u", savepoint, u.toStorageView());
+    }
+  }
+
+  const filesystem::path archiveSnapshotFile =
+      directory->path() / MetaDataSnapshot::archiveFilename("field");
+
+  // Snapshots can be disabled
+  ::setenv("SERIALBOX_METADATA_SNAPSHOT", "0", 1);
+  {
+    SerializerImpl s_read(OpenModeKind::Read, directory->path().string(), "field", "Binary");
+    EXPECT_FALSE(filesystem::exists(s_read.metaDataSnapshotFile()));
+    EXPECT_FALSE(filesystem::exists(archiveSnapshotFile));
+  }
+  ::unsetenv("SERIALBOX_METADATA_SNAPSHOT");
+
+  // The first opening creates the snapshot which is loaded by the second
+  for(int n = 0; n < 2; ++n) {
+    SerializerImpl s_read(OpenModeKind::Read, directory->path().string(), "field", "Binary");
+    EXPECT_TRUE(filesystem::exists(s_read.metaDataSnapshotFile()));
+    EXPECT_TRUE(filesystem::exists(archiveSnapshotFile));
+    EXPECT_EQ(s_read.globalMetainfo().as<std::string>("key"), "value");
+    ASSERT_EQ(s_read.savepoints().size(), 4);
+
+    auto sv = u_read.toStorageView();
+    s_read.read("u", *s_read.savepoints()[3], sv);
+    EXPECT_TRUE(Storage::verify(u, u_read));
+  }
+
+  // Snapshots are ignored once the meta-data is modified
+  {
+    SerializerImpl s_append(OpenModeKind::Append, directory->path().string(), "field", "Binary");
+    SavepointImpl savepoint("sp");
+    savepoint.addMetainfo("step", 4);
+    s_append.write("u", savepoint, u.toStorageView());
+  }
+  {
+    SerializerImpl s_read(OpenModeKind::Read, directory->path().string(), "field", "Binary");
+    EXPECT_EQ(s_read.savepoints().size(), 5);
+  }
+
+  // Writing from scratch drops the snapshot
+  {
+    SerializerImpl s_write(OpenModeKind::Write, directory->path().string(), "field", "Binary");
+    EXPECT_FALSE(filesystem::exists(s_write.metaDataSnapshotFile()));
+    EXPECT_FALSE(filesystem::exists(archiveSnapshotFile));
+  }
+}
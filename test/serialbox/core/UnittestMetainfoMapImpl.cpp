@@ -128,6 +128,50 @@ TEST(MetainfoMapImplTest, Comparison) {
   EXPECT_TRUE(map1 != map2);
 }
 
+TEST(MetainfoMapImplTest, SortedStorage) {
+  MetainfoMapImpl map1;
+  ASSERT_TRUE(map1.insert("c", int(3)));
+  ASSERT_TRUE(map1.insert("a", int(1)));
+  ASSERT_TRUE(map1.insert("b", int(2)));
+  ASSERT_FALSE(map1.insert("a", int(4)));
+
+  // Elements are iterated in the order of their keys
+  EXPECT_EQ(map1.keys(), (std::vector<std::string>{"a", "b", "c"}));
+  int value = 1;
+  for(auto it = map1.begin(); it != map1.end(); ++it, ++value)
+    EXPECT_EQ(it->second.as<int>(), value);
+
+  // Insertion order does not matter for comparison
+  MetainfoMapImpl map2;
+  ASSERT_TRUE(map2.insert("b", int(2)));
+  ASSERT_TRUE(map2.insert("c", int(3)));
+  ASSERT_TRUE(map2.insert("a", int(1)));
+  EXPECT_TRUE(map1 == map2);
+
+  // Keys are interned
+  const std::string& key1 = map1.begin()->first;
+  const std::string& key2 = map2.begin()->first;
+  EXPECT_EQ(&key1, &key2);
+  EXPECT_EQ(&key1, InternTable::global().find("a"));
+
+  // Modify values through iterators and operator[]
+  map1.begin()->second = MetainfoValueImpl(int(5));
+  EXPECT_EQ(map1.at("a").as<int>(), 5);
+  map1["d"] = MetainfoValueImpl(int(6));
+  EXPECT_EQ(map1.size(), 4);
+  EXPECT_EQ(map1.keys().back(), "d");
+  EXPECT_EQ(map1["d"].as<int>(), 6);
+
+  // Erase by key, position and range
+  EXPECT_EQ(map1.erase("b"), 1);
+  EXPECT_EQ(map1.erase("b"), 0);
+  auto it = map1.erase(map1.find("a"));
+  EXPECT_EQ(it->first, "c");
+  map1.erase(map1.begin(), map1.end());
+  EXPECT_TRUE(map1.empty());
+  EXPECT_FALSE(map1.hasKey("c"));
+}
+
 TEST(MetainfoMapImplTest, Conversion) {
   MetainfoMapImpl map;
   ASSERT_TRUE(map.insert("key", int(32)));
@@ -312,6 +356,56 @@ TEST(MetainfoMapImplTest, fromJSON) {
   }
 }
 
+TEST(MetainfoMapImplTest, fromJSONStream) {
+  auto read = [](const std::string& document, MetainfoMapImpl& map) {
+    JsonReader reader(document.data(), document.size());
+    from_json(reader, map);
+    reader.end();
+  };
+
+  // -----------------------------------------------------------------------------------------------
+  // Success
+  // -----------------------------------------------------------------------------------------------
+  {
+    MetainfoMapImpl map;
+    map.insert("bool", true);
+    map.insert("int32", int(-1));
+    map.insert("int64", std::int64_t(1) << 40);
+    map.insert("float32", 0.5f);
+    map.insert("float64", 0.1);
+    map.insert("string", std::string("str"));
+    map.insert("array_of_int32", Array<int>{1, 2, 3});
+    map.insert("array_of_string", Array<std::string>{"a", "b"});
+
+    MetainfoMapImpl fromStream;
+    ASSERT_NO_THROW(read(json::json(map).dump(), fromStream));
+    EXPECT_TRUE(fromStream == map);
+  }
+
+  // Empty
+  {
+    MetainfoMapImpl map;
+    ASSERT_NO_THROW(read("null", map));
+    EXPECT_TRUE(map.empty());
+    ASSERT_NO_THROW(read("{}", map));
+    EXPECT_TRUE(map.empty());
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Failures
+  // -----------------------------------------------------------------------------------------------
+  MetainfoMapImpl map;
+
+  // Missing value
+  EXPECT_THROW(read(R"({"key": {"type_id": 1}})", map), Exception);
+
+  // Missing type id
+  EXPECT_THROW(read(R"({"key": {"value": 5}})", map), Exception);
+
+  // TypeId / value mismatch
+  EXPECT_THROW(read(R"({"key": {"type_id": 1, "value": 5.0}})", map), Exception);
+}
+
 TEST(MetainfoMapImplTest, toString) {
   std::stringstream ss;
 
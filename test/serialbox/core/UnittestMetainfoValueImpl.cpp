@@ -252,3 +252,41 @@ TYPED_TEST(MetainfoValueImplTest, toString) {
   EXPECT_STREQ(value1.toString().c_str(), toString(pair.first).c_str());
   EXPECT_STREQ(value2.toString().c_str(), toString(pair.second).c_str());
 }
+
+TYPED_TEST(MetainfoValueImplTest, Storage) {
+  auto pair = getValuePair<TypeParam>();
+  MetainfoValueImpl value(TypeParam(pair.first));
+  MetainfoValueImpl valueArray(Array<TypeParam>{pair.first, pair.second});
+
+  // Typed access of the stored value
+  EXPECT_TRUE(value.get<TypeParam>() == pair.first);
+  EXPECT_TRUE(valueArray.get<Array<TypeParam>>() == (Array<TypeParam>{pair.first, pair.second}));
+
+  // Scalars are stored inline, strings and arrays are shared between copies
+  MetainfoValueImpl copy(value), copyArray(valueArray);
+  const bool isString = std::is_same<TypeParam, std::string>::value;
+  EXPECT_EQ(copy.data() == value.data(), isString);
+  EXPECT_EQ(copyArray.data(), valueArray.data());
+  EXPECT_TRUE(copy == value);
+  EXPECT_TRUE(copyArray == valueArray);
+
+  // Equal values which do not share the storage
+  MetainfoValueImpl other(TypeParam(pair.first));
+  MetainfoValueImpl otherArray(Array<TypeParam>{pair.first, pair.second});
+  EXPECT_TRUE(other == value);
+  EXPECT_TRUE(otherArray == valueArray);
+
+  // Moved and swapped values keep the value
+  MetainfoValueImpl moved(std::move(copy));
+  EXPECT_TRUE(moved.as<TypeParam>() == pair.first);
+  moved.swap(copyArray);
+  EXPECT_TRUE(moved == valueArray);
+  EXPECT_TRUE(copyArray == value);
+
+  // Conversion to boost::any
+  EXPECT_TRUE(boost::any_cast<TypeParam>(value.any()) == pair.first);
+  EXPECT_TRUE(boost::any_cast<Array<TypeParam>>(valueArray.any()) ==
+              (Array<TypeParam>{pair.first, pair.second}));
+  EXPECT_TRUE(MetainfoValueImpl().any().empty());
+  EXPECT_EQ(MetainfoValueImpl().data(), nullptr);
+}
@@ -0,0 +1,63 @@
+//===-- serialbox/core/UnittestParallel.cpp -----------------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This implements the unittests of the parallel loop.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/Parallel.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace serialbox;
+
+TEST(ParallelTest, ParallelFor) {
+  std::vector<int> visited(100, 0);
+  parallelFor(visited.size(), [&](std::size_t i) { visited[i]++; }, 4);
+  for(int count : visited)
+    EXPECT_EQ(count, 1);
+
+  // Exceptions are rethrown in the calling thread
+  ASSERT_THROW(parallelFor(10,
+                           [](std::size_t i) {
+                             if(i == 7)
+                               throw std::runtime_error("error");
+                           },
+                           4),
+               std::runtime_error);
+}
+
+TEST(ParallelTest, Nested) {
+  std::vector<int> spawned(4, 0);
+
+  parallelFor(spawned.size(),
+              [&](std::size_t i) {
+                // Inner loops run in the thread of the outer iteration
+                const std::thread::id outer = std::this_thread::get_id();
+                parallelFor(8,
+                            [&](std::size_t) {
+                              if(std::this_thread::get_id() != outer)
+                                spawned[i] = 1;
+                            },
+                            4);
+              },
+              4);
+
+  for(int count : spawned)
+    EXPECT_EQ(count, 0);
+
+  // Loops are parallel again once the outer loop finished
+  std::atomic<int> numCalls(0);
+  parallelFor(4, [&](std::size_t) { numCalls++; }, 4);
+  EXPECT_EQ(numCalls, 4);
+}
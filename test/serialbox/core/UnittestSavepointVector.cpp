@@ -122,6 +122,113 @@ TEST(SavepointVectorTest, Construction) {
     EXPECT_THROW(s.getFieldID(idx, "XXX"), Exception);
   }
 
+  //------------------------------------------------------------------------------------------------
+  //  Dense field indices
+  //------------------------------------------------------------------------------------------------
+  {
+    SavepointVector s;
+    ASSERT_EQ(s.insert(savepoint1), 0);
+    ASSERT_EQ(s.insert(savepoint2), 1);
+
+    // Explicit registration assigns indices in order
+    EXPECT_EQ(s.registerField("w"), 0);
+    EXPECT_EQ(s.registerField("u"), 1);
+    EXPECT_EQ(s.registerField("w"), 0);
+    EXPECT_EQ(s.fieldIndex("u"), 1);
+    EXPECT_EQ(s.fieldIndex("v"), -1);
+    EXPECT_FALSE(s.hasField(0, "v"));
+
+    // Adding a field registers it implicitly
+    ASSERT_TRUE(s.addField(0, FieldID{"v", 2}));
+    ASSERT_TRUE(s.addField(0, FieldID{"u", 1}));
+    ASSERT_TRUE(s.addField(0, FieldID{"w", 0}));
+    ASSERT_TRUE(s.addField(1, FieldID{"u", 3}));
+    EXPECT_EQ(s.fieldIndex("v"), 2);
+    ASSERT_EQ(s.fieldNames().size(), 3);
+    EXPECT_EQ(s.fieldNames()[2], "v");
+
+    // Fields of a savepoint are iterated in the order of their indices
+    std::vector<std::string> names;
+    std::vector<unsigned int> ids;
+    for(const auto& field : s.fieldsOf(0)) {
+      names.push_back(field.first);
+      ids.push_back(field.second);
+    }
+    EXPECT_EQ(names, (std::vector<std::string>{"w", "u", "v"}));
+    EXPECT_EQ(ids, (std::vector<unsigned int>{0, 1, 2}));
+
+    EXPECT_EQ(s.getFieldID(0, "v"), (FieldID{"v", 2}));
+    EXPECT_EQ(s.getFieldID(1, "u"), (FieldID{"u", 3}));
+    EXPECT_FALSE(s.hasField(1, "w"));
+    EXPECT_TRUE(s.fieldsOf(1).find("w") == s.fieldsOf(1).end());
+
+    // Copies keep the indices
+    SavepointVector s2(s);
+    EXPECT_EQ(s2.fieldIndex("v"), 2);
+    EXPECT_EQ(s2.getFieldID(0, "u"), (FieldID{"u", 1}));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  //  Columnar storage
+  //------------------------------------------------------------------------------------------------
+  {
+    SavepointVector s;
+
+    // Savepoints of the same name which only differ in their meta-information
+    for(int i = 0; i < 100; ++i) {
+      SavepointImpl savepoint("step");
+      savepoint.addMetainfo("i", i);
+      if(i % 2)
+        savepoint.addMetainfo("odd", true);
+      ASSERT_EQ(s.insert(savepoint), i);
+    }
+    ASSERT_EQ(s.size(), 100);
+
+    for(int i = 0; i < 100; ++i) {
+      SavepointImpl savepoint("step");
+      if(i % 2)
+        savepoint.addMetainfo("odd", true);
+      savepoint.addMetainfo("i", i);
+      EXPECT_EQ(s.find(savepoint), i);
+      EXPECT_EQ(s.nameOf(i), "step");
+      EXPECT_EQ(s.metaInfoSizeOf(i), i % 2 ? 2 : 1);
+      EXPECT_EQ(s.savepointAt(i), savepoint);
+    }
+
+    SavepointImpl savepointWrongType("step");
+    savepointWrongType.addMetainfo("i", double(1));
+    EXPECT_EQ(s.find(savepointWrongType), -1);
+    EXPECT_EQ(s.find(SavepointImpl("step")), -1);
+    EXPECT_EQ(s.find(SavepointImpl("SavepointVectorTest.unknown")), -1);
+
+    // 0.0 and -0.0 are the same savepoint
+    SavepointImpl savepointZero("zero");
+    savepointZero.addMetainfo("x", 0.0);
+    SavepointImpl savepointNegativeZero("zero");
+    savepointNegativeZero.addMetainfo("x", -0.0);
+    ASSERT_EQ(s.insert(savepointZero), 100);
+    EXPECT_EQ(s.insert(savepointNegativeZero), -1);
+    EXPECT_EQ(s.find(savepointNegativeZero), 100);
+
+    // Materialized savepoints are kept up to date
+    ASSERT_EQ(s.savepoints().size(), 101);
+    std::shared_ptr<const SavepointImpl> first = s.savepoints()[0];
+    ASSERT_EQ(s.insert(SavepointImpl("last")), 101);
+    ASSERT_EQ(s.savepoints().size(), 102);
+    EXPECT_EQ(s.back().name(), "last");
+    EXPECT_EQ(s.savepoints()[0], first);
+    EXPECT_EQ(s[1], s.savepointAt(1));
+
+    // Copies are independent
+    SavepointVector s2(s);
+    s.clear();
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(s.find(savepointZero), -1);
+    EXPECT_EQ(s2.size(), 102);
+    EXPECT_EQ(s2.find(savepointZero), 100);
+    EXPECT_EQ(*first, s2[0]);
+  }
+
   //------------------------------------------------------------------------------------------------
   //  Copy construct
   //------------------------------------------------------------------------------------------------
@@ -199,6 +306,144 @@ TEST(SavepointVectorTest, Construction) {
   }
 }
 
+TEST(SavepointVectorTest, FindLatest) {
+  SavepointVector s;
+  for(int i = 0; i < 100; ++i)
+    ASSERT_EQ(s.insert(SavepointImpl("savepoint-" + std::to_string(i))), i);
+
+  // Field "constant" is stored at savepoint 0, field "field" at every 10th savepoint (added out of
+  // order)
+  ASSERT_TRUE(s.addField(0, FieldID{"constant", 0}));
+  for(int i = 90; i >= 0; i -= 10)
+    ASSERT_TRUE(s.addField(i, FieldID{"field", unsigned(i / 10)}));
+
+  const unsigned int field = s.fieldIndex("field");
+  const unsigned int constant = s.fieldIndex("constant");
+
+  EXPECT_EQ(s.findLatest(99, constant), 0);
+  EXPECT_EQ(s.findLatest(0, constant), 0);
+  EXPECT_EQ(s.findLatest(99, field), 90);
+  EXPECT_EQ(s.findLatest(50, field), 50);
+  EXPECT_EQ(s.findLatest(49, field), 40);
+  EXPECT_EQ(s.findLatest(5, 42), -1);
+
+  EXPECT_EQ(s.getLatestFieldID(99, "constant"), (FieldID{"constant", 0}));
+  EXPECT_EQ(s.getLatestFieldID(59, "field"), (FieldID{"field", 5}));
+  EXPECT_THROW(s.getLatestFieldID(59, "X"), Exception);
+
+  SavepointVector copy(s);
+  EXPECT_EQ(copy.getLatestFieldID(59, "field"), (FieldID{"field", 5}));
+
+  s.clear();
+  ASSERT_EQ(s.insert(SavepointImpl("savepoint")), 0);
+  EXPECT_THROW(s.getLatestFieldID(0, "field"), Exception);
+}
+
+TEST(SavepointVectorTest, Reserve) {
+  SavepointVector s;
+  for(int i = 0; i < 10; ++i)
+    ASSERT_EQ(s.insert(SavepointImpl("savepoint-" + std::to_string(i))), i);
+
+  // The savepoints inserted before are still found after rehashing the index
+  s.reserve(1000, 1000);
+  for(int i = 10; i < 1000; ++i)
+    ASSERT_EQ(s.insert(SavepointImpl("savepoint-" + std::to_string(i))), i);
+  for(int i = 0; i < 1000; ++i)
+    EXPECT_EQ(s.find(SavepointImpl("savepoint-" + std::to_string(i))), i);
+  EXPECT_EQ(s.insert(SavepointImpl("savepoint-0")), -1);
+}
+
+TEST(SavepointVectorTest, Back) {
+  SavepointVector s;
+  SavepointImpl savepoint("savepoint");
+  savepoint.addMetainfo("key", 1);
+  ASSERT_EQ(s.insert(SavepointImpl("first")), 0);
+  ASSERT_EQ(s.insert(savepoint), 1);
+
+  // The last savepoint is returned as a copy
+  SavepointImpl last = s.back();
+  EXPECT_EQ(last, savepoint);
+  last.addMetainfo("other", 2);
+  EXPECT_EQ(s.back(), savepoint);
+  EXPECT_EQ(s.savepointAt(1), savepoint);
+}
+
+TEST(SavepointVectorTest, Query) {
+  SavepointVector s;
+
+  // Savepoints "step" at time 0, 0.5, ..., 9.5 (every other step is tagged as output) and a
+  // savepoint "init" without a time
+  for(int step = 0; step < 20; ++step) {
+    SavepointImpl savepoint("step");
+    savepoint.addMetainfo("step", step);
+    savepoint.addMetainfo("time", 0.5 * step);
+    if(step % 2 == 0)
+      savepoint.addMetainfo("kind", std::string("output"));
+    ASSERT_EQ(s.insert(savepoint), step);
+  }
+  SavepointImpl init("init");
+  init.addMetainfo("kind", std::string("output"));
+  ASSERT_EQ(s.insert(init), 20);
+
+  using Indices = std::vector<int>;
+
+  // All savepoints
+  EXPECT_EQ(s.query(SavepointQuery()).size(), 21);
+
+  // Name
+  EXPECT_EQ(s.query(SavepointQuery().name("init")), (Indices{20}));
+  EXPECT_EQ(s.query(SavepointQuery().name("step")).size(), 20);
+  EXPECT_TRUE(s.query(SavepointQuery().name("X")).empty());
+
+  // Equality (numeric values are compared by value)
+  EXPECT_EQ(s.query(SavepointQuery().equal("step", 3)), (Indices{3}));
+  EXPECT_EQ(s.query(SavepointQuery().equal("step", 3.0)), (Indices{3}));
+  EXPECT_EQ(s.query(SavepointQuery().equal("time", 1.5)), (Indices{3}));
+  EXPECT_TRUE(s.query(SavepointQuery().equal("time", 1.25)).empty());
+  EXPECT_TRUE(s.query(SavepointQuery().equal("step", std::string("3"))).empty());
+  EXPECT_TRUE(s.query(SavepointQuery().equal("X", 3)).empty());
+  EXPECT_EQ(s.query(SavepointQuery().equal("kind", std::string("output"))).size(), 11);
+
+  // Range
+  EXPECT_EQ(s.query(SavepointQuery().range("step", 5, 8)), (Indices{5, 6, 7}));
+  EXPECT_EQ(s.query(SavepointQuery().range("time", 2.0, 3.5)), (Indices{4, 5, 6}));
+  EXPECT_TRUE(s.query(SavepointQuery().range("step", 8, 5)).empty());
+  EXPECT_TRUE(s.query(SavepointQuery().range("kind", 0, 100)).empty());
+
+  // Combinations
+  EXPECT_EQ(s.query(SavepointQuery().range("step", 5, 10).equal("kind", std::string("output"))),
+            (Indices{6, 8}));
+  EXPECT_EQ(s.query(SavepointQuery().name("init").equal("kind", std::string("output"))),
+            (Indices{20}));
+  EXPECT_TRUE(s.query(SavepointQuery().name("init").range("step", 0, 100)).empty());
+
+  // Nearest
+  EXPECT_EQ(s.nearest(SavepointQuery(), "time", 3.1), 6);
+  EXPECT_EQ(s.nearest(SavepointQuery(), "time", 3.25), 6);
+  EXPECT_EQ(s.nearest(SavepointQuery(), "time", -10.0), 0);
+  EXPECT_EQ(s.nearest(SavepointQuery(), "time", 100.0), 19);
+  EXPECT_EQ(s.nearest(SavepointQuery().equal("kind", std::string("output")), "time", 3.6), 8);
+  EXPECT_EQ(s.nearest(SavepointQuery().name("init"), "time", 0.0), -1);
+  EXPECT_EQ(s.nearest(SavepointQuery(), "X", 0.0), -1);
+
+  // The indexes are kept up to date
+  SavepointImpl savepoint("step");
+  savepoint.addMetainfo("step", 6);
+  savepoint.addMetainfo("time", 3.1);
+  ASSERT_EQ(s.insert(savepoint), 21);
+  EXPECT_EQ(s.query(SavepointQuery().name("step").equal("step", 6)), (Indices{6, 21}));
+  EXPECT_EQ(s.nearest(SavepointQuery(), "time", 3.1), 21);
+
+  // Copies and cleared vectors rebuild their indexes
+  SavepointVector copy(s);
+  EXPECT_EQ(copy.query(SavepointQuery().equal("step", 6)), (Indices{6, 21}));
+
+  s.clear();
+  EXPECT_TRUE(s.query(SavepointQuery().equal("step", 6)).empty());
+  ASSERT_EQ(s.insert(savepoint), 0);
+  EXPECT_EQ(s.query(SavepointQuery().equal("step", 6)), (Indices{0}));
+}
+
 TEST(SavepointVectorTest, toJSON) {
   // s1 and s2 have same name but different meta-info, s3 has a different name and no meta-info
   SavepointImpl savepoint1("savepoint");
@@ -376,6 +621,72 @@ TEST(SavepointVectorTest, fromJSON) {
   }
 }
 
+TEST(SavepointVectorTest, fromJSONStream) {
+  SavepointImpl savepoint1("savepoint");
+  SavepointImpl savepoint2("different-savepoint");
+  SavepointImpl savepoint3("savepoint");
+
+  ASSERT_NO_THROW(savepoint1.addMetainfo("key1", "s1"));
+  ASSERT_NO_THROW(savepoint3.addMetainfo("key1", "s3"));
+  ASSERT_NO_THROW(savepoint3.addMetainfo("key2", 3.0));
+
+  // The second savepoint has no fields
+  SavepointVector s;
+  ASSERT_NE(s.insert(savepoint1), -1);
+  ASSERT_NE(s.insert(savepoint2), -1);
+  ASSERT_NE(s.insert(savepoint3), -1);
+  ASSERT_TRUE(s.addField(savepoint1, FieldID{"u", 0}));
+  ASSERT_TRUE(s.addField(savepoint1, FieldID{"v", 0}));
+  ASSERT_TRUE(s.addField(savepoint3, FieldID{"u", 1}));
+
+  json::json j = s;
+  const std::string document = j.dump(1);
+
+  // -----------------------------------------------------------------------------------------------
+  // Success (token stream and JSON node yield the same savepoints and fields)
+  // -----------------------------------------------------------------------------------------------
+  {
+    SavepointVector fromStream;
+    JsonReader reader(document.data(), document.size());
+    ASSERT_NO_THROW(from_json(reader, fromStream));
+    ASSERT_NO_THROW(reader.end());
+
+    SavepointVector fromNode = j;
+
+    for(const SavepointVector* sv : {&fromStream, &fromNode}) {
+      ASSERT_EQ(sv->size(), 3);
+      for(int i = 0; i < 3; ++i) {
+        EXPECT_EQ(sv->savepointAt(i), s.savepointAt(i));
+        EXPECT_EQ(sv->fieldsOf(i).size(), s.fieldsOf(i).size());
+      }
+      EXPECT_EQ(sv->getFieldID(savepoint1, "v"), (FieldID{"v", 0}));
+      EXPECT_EQ(sv->getFieldID(savepoint3, "u"), (FieldID{"u", 1}));
+    }
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Success (empty)
+  // -----------------------------------------------------------------------------------------------
+  {
+    SavepointVector fromStream;
+    JsonReader reader("{}", 2);
+    ASSERT_NO_THROW(from_json(reader, fromStream));
+    EXPECT_TRUE(fromStream.empty());
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Failure (entry in "fields_per_savepoint" for the last savepoint is missing)
+  // -----------------------------------------------------------------------------------------------
+  {
+    j["fields_per_savepoint"].erase(2);
+    const std::string illFormed = j.dump();
+
+    SavepointVector fromStream;
+    JsonReader reader(illFormed.data(), illFormed.size());
+    ASSERT_THROW(from_json(reader, fromStream), Exception);
+  }
+}
+
 TEST(SavepointVectorTest, toString) {
   SavepointImpl savepoint1("savepoint");
   ASSERT_NO_THROW(savepoint1.addMetainfo("key1", "s1"));
@@ -14,9 +14,14 @@
 
 #include "serialbox/core/Json.h"
 #include "serialbox/core/SerializerImpl.h"
+#include "serialbox/core/archive/ChunkLayout.h"
+#include "serialbox/core/compression/CodecPipeline.h"
+#include "serialbox/core/compression/LZCodec.h"
 #include "utility/SerializerTestBase.h"
 #include "utility/Storage.h"
+#include <algorithm>
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace serialbox;
 using namespace unittest;
@@ -366,6 +371,12 @@ TEST_F(SerializerImplUtilityTest, JSONSuccess) {
   EXPECT_EQ(s_read.getFieldIDAtSavepoint(sp2, "field1"), (FieldID{"field1", 1}));
   EXPECT_EQ(s_read.getFieldIDAtSavepoint(sp2, "field2"), (FieldID{"field2", 1}));
 
+  // No field is stored at the last savepoint
+  EXPECT_EQ(s_read.getLatestFieldIDAtSavepoint(sp3, "field1"), (FieldID{"field1", 1}));
+  EXPECT_EQ(s_read.getLatestFieldIDAtSavepoint(sp1, "field2"), (FieldID{"field2", 0}));
+  EXPECT_THROW(s_read.getLatestFieldIDAtSavepoint(sp3, "field3"), Exception);
+  EXPECT_THROW(s_read.getLatestFieldIDAtSavepoint(SavepointImpl("X"), "field1"), Exception);
+
   // FieldMap
   ASSERT_TRUE(s_read.fieldMap().hasField("field1"));
   ASSERT_TRUE(s_read.fieldMap().hasField("field2"));
@@ -549,9 +560,185 @@ TEST_F(SerializerImplUtilityTest, AsyncRead) {
     s_read.readAsync("field-XXX", sp, sv_3);
     ASSERT_THROW(s_read.waitForAll(), Exception);
   }
+
+  // The reads are performed in the background, i.e they complete without waiting for them (the
+  // field is inserted into the cache once it is read)
+  {
+    SerializerImpl s_read(OpenModeKind::Read, directory->path().string(), "Field", "Binary");
+    s_read.setFieldCacheSize(1 << 20);
+
+    storage_1.forEach(Storage::random);
+    auto sv_1 = storage_1.toStorageView();
+    s_read.readAsync("field", sp, sv_1);
+    for(int i = 0; i < 1000 && s_read.fieldCacheStatistics().entries == 0; ++i)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(s_read.fieldCacheStatistics().entries, 1);
+
+    s_read.waitForAll();
+    ASSERT_TRUE(Storage::verify(storage_1, storage));
+  }
+}
+
+TEST_F(SerializerImplUtilityTest, AsyncReadBatch) {
+  using Storage = Storage<double>;
+
+  const int numSavepoints = 8;
+  const std::vector<int> dims{10, 15, 4};
+  std::vector<SavepointImpl> savepoints;
+  std::vector<Storage> inputs;
+  for(int s = 0; s < numSavepoints; ++s) {
+    savepoints.emplace_back("sp-" + std::to_string(s));
+    inputs.emplace_back(Storage::ColMajor, dims, Storage::random);
+  }
+
+  // Plain and compressed fields
+  {
+    SerializerImpl s_write(OpenModeKind::Write, directory->path().string(), "Field", "Binary");
+    s_write.registerField("u", TypeID::Float64, dims);
+    s_write.registerField("v", TypeID::Float64, dims);
+    s_write.addFieldMetainfoImpl("v", CodecPipeline::CodecKey, std::string(LZCodec::Name));
+    for(int s = 0; s < numSavepoints; ++s) {
+      s_write.write("u", savepoints[s], inputs[s].toStorageView());
+      s_write.write("v", savepoints[s], inputs[numSavepoints - 1 - s].toStorageView());
+    }
+  }
+
+  SerializerImpl s_read(OpenModeKind::Read, directory->path().string(), "Field", "Binary");
+  s_read.setFieldCacheSize(1 << 20);
+
+  // The first half of the savepoints is cached
+  Storage output(Storage::ColMajor, dims);
+  for(int s = 0; s < numSavepoints / 2; ++s) {
+    auto sv = output.toStorageView();
+    s_read.read("u", savepoints[s], sv);
+  }
+
+  std::vector<Storage> outputsU, outputsV;
+  for(int s = 0; s < numSavepoints; ++s) {
+    outputsU.emplace_back(Storage::ColMajor, dims);
+    outputsV.emplace_back(Storage::ColMajor, dims);
+  }
+  for(int s = 0; s < numSavepoints; ++s) {
+    auto svU = outputsU[s].toStorageView();
+    auto svV = outputsV[s].toStorageView();
+    s_read.readAsync("u", savepoints[s], svU);
+    s_read.readAsync("v", savepoints[s], svV);
+  }
+  s_read.waitForAll();
+
+  for(int s = 0; s < numSavepoints; ++s) {
+    ASSERT_TRUE(Storage::verify(outputsU[s], inputs[s])) << s;
+    ASSERT_TRUE(Storage::verify(outputsV[s], inputs[numSavepoints - 1 - s])) << s;
+  }
+
+  // The queue is empty after a failed batch
+  auto sv = output.toStorageView();
+  s_read.readAsync("u", SavepointImpl("sp-XXX"), sv);
+  ASSERT_THROW(s_read.waitForAll(), Exception);
+  s_read.waitForAll();
 }
 #endif
 
+TEST_F(SerializerImplUtilityTest, ConcurrentWrite) {
+  using Storage = Storage<double>;
+
+  const int numThreads = 8;
+  const int numSavepoints = 16;
+  const int numFieldsPerThread = 2;
+  const int numFields = numThreads * numFieldsPerThread;
+
+  // Each field gets a different content at each savepoint (the last savepoint repeats the first
+  // one to exercise the deduplication)
+  std::vector<std::vector<Storage>> storages(numFields);
+  for(int f = 0; f < numFields; ++f) {
+    for(int s = 0; s < numSavepoints - 1; ++s)
+      storages[f].emplace_back(Storage::ColMajor, std::vector<int>{8, 9, 4}, Storage::random);
+    storages[f].push_back(storages[f].front());
+  }
+
+  std::vector<SavepointImpl> savepoints;
+  for(int s = 0; s < numSavepoints; ++s)
+    savepoints.emplace_back("sp-" + std::to_string(s));
+
+  // Write (each thread owns `numFieldsPerThread` fields)
+  {
+    SerializerImpl s_write(OpenModeKind::Write, directory->path().string(), "Field", "Binary");
+    for(int f = 0; f < numFields; ++f) {
+      auto sv = storages[f][0].toStorageView();
+      s_write.registerField("field-" + std::to_string(f), sv.type(), sv.dims());
+    }
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < numThreads; ++t)
+      threads.emplace_back([&, t]() {
+        for(int s = 0; s < numSavepoints; ++s)
+          for(int f = t * numFieldsPerThread; f < (t + 1) * numFieldsPerThread; ++f)
+            s_write.write("field-" + std::to_string(f), savepoints[s],
+                          storages[f][s].toStorageView());
+      });
+
+    for(auto& thread : threads)
+      thread.join();
+
+    // Writing an already saved field has to fail in a thread-safe manner as well
+    auto sv = storages[0][0].toStorageView();
+    ASSERT_THROW(s_write.write("field-0", savepoints[0], sv), Exception);
+  }
+
+  // Read
+  {
+    SerializerImpl s_read(OpenModeKind::Read, directory->path().string(), "Field", "Binary");
+    ASSERT_EQ(s_read.savepoints().size(), numSavepoints);
+
+    for(int s = 0; s < numSavepoints; ++s) {
+      ASSERT_EQ(s_read.savepointVector().fieldsOf(savepoints[s]).size(), numFields);
+
+      for(int f = 0; f < numFields; ++f) {
+        Storage storage(Storage::ColMajor, {8, 9, 4});
+        auto sv = storage.toStorageView();
+        s_read.read("field-" + std::to_string(f), savepoints[s], sv);
+        ASSERT_TRUE(Storage::verify(storage, storages[f][s])) << "field-" << f << " at sp-" << s;
+      }
+    }
+
+    // The duplicated field at the last savepoint refers to the data of the first one
+    ASSERT_EQ(s_read.savepointVector().getFieldID(numSavepoints - 1, "field-0").id, 0);
+  }
+}
+
+TEST_F(SerializerImplUtilityTest, ConcurrentQuery) {
+  using Storage = Storage<double>;
+
+  const int numSavepoints = 64;
+  Storage storage(Storage::ColMajor, std::vector<int>{4, 3}, Storage::random);
+  auto sv = storage.toStorageView();
+
+  SerializerImpl s_write(OpenModeKind::Write, directory->path().string(), "Field", "Binary");
+  s_write.registerField("field", sv.type(), sv.dims());
+
+  // Query the savepoints (and build the indexes) while they are being registered
+  std::thread writer([&]() {
+    for(int s = 0; s < numSavepoints; ++s) {
+      SavepointImpl savepoint("sp");
+      savepoint.addMetainfo("time", s);
+      s_write.write("field", savepoint, sv);
+    }
+  });
+
+  std::size_t numMatches = 0;
+  while(numMatches < std::size_t(numSavepoints)) {
+    auto indices = s_write.querySavepoints(SavepointQuery().name("sp").range("time", 0, 1e9));
+    ASSERT_GE(indices.size(), numMatches);
+    ASSERT_TRUE(std::is_sorted(indices.begin(), indices.end()));
+    numMatches = indices.size();
+
+    int nearest = s_write.findNearestSavepoint(SavepointQuery().name("sp"), "time", 1e9);
+    ASSERT_GE(nearest, int(numMatches) - 1);
+    ASSERT_LT(nearest, numSavepoints);
+  }
+  writer.join();
+}
+
 //===------------------------------------------------------------------------------------------===//
 //     Read/Write tests
 //===------------------------------------------------------------------------------------------===//
@@ -758,6 +945,334 @@ TYPED_TEST(SerializerImplReadWriteTest, SliceWriteAndRead) {
 #endif
 }
 
+TYPED_TEST(SerializerImplReadWriteTest, ChunkedSliceWriteAndRead) {
+  using Storage = Storage<TypeParam>;
+
+  int dim1 = 10, dim2 = 12, dim3 = 5;
+  Storage input(Storage::RowMajor, {dim1, dim2, dim3}, {{1, 1}, {2, 0}, {0, 0}},
+                Storage::random);
+  Storage output(Storage::RowMajor, {dim1, dim2, dim3}, {{1, 1}, {2, 0}, {0, 0}},
+                 Storage::random);
+  SavepointImpl sp("sp");
+
+  // Write (the chunk shape is given by the field meta-information)
+  {
+    SerializerImpl s_write(OpenModeKind::Write, this->directory->path().string(), "Field",
+                           "Binary");
+
+    auto sv = input.toStorageView();
+    s_write.registerField("u", sv.type(), sv.dims());
+    s_write.addFieldMetainfoImpl("u", ChunkLayout::ChunkShapeKey, Array<int>{4, 4, 2});
+    s_write.write("u", sp, sv);
+  }
+
+  // Read
+  SerializerImpl s_read(OpenModeKind::Read, this->directory->path().string(), "Field", "Binary");
+  {
+    auto sv = output.toStorageView();
+    s_read.read("u", sp, sv);
+    ASSERT_TRUE(Storage::verify(input, output));
+  }
+
+  output.forEach(Storage::random);
+
+  auto sv = output.toStorageView();
+  s_read.readSliced("u", sp, sv, Slice(1, 7)(2, 11, 3)(3, 4));
+  for(int i = 1; i < 7; ++i)
+    for(int j = 2; j < 11; j += 3)
+      ASSERT_EQ(input(i, j, 3), output(i, j, 3)) << "(i,j) = (" << i << "," << j << ")";
+}
+
+TYPED_TEST(SerializerImplReadWriteTest, FieldCache) {
+  using Storage = Storage<TypeParam>;
+
+  Storage input(Storage::RowMajor, {8, 6, 4}, Storage::random);
+  Storage output(Storage::RowMajor, {8, 6, 4});
+  SavepointImpl sp1("sp1"), sp2("sp2");
+
+  // The same data at two savepoints is deduplicated to the same FieldID
+  {
+    SerializerImpl s_write(OpenModeKind::Write, this->directory->path().string(), "Field",
+                           "Binary");
+    auto sv = input.toStorageView();
+    s_write.registerField("u", sv.type(), sv.dims());
+    s_write.write("u", sp1, sv);
+    s_write.write("u", sp2, sv);
+  }
+
+  SerializerImpl s_read(OpenModeKind::Read, this->directory->path().string(), "Field", "Binary");
+  EXPECT_EQ(s_read.fieldCacheSize(), 0);
+  s_read.setFieldCacheSize(1 << 20);
+
+  auto sv = output.toStorageView();
+  s_read.read("u", sp1, sv);
+  ASSERT_TRUE(Storage::verify(input, output));
+
+  output.forEach(Storage::random);
+  s_read.read("u", sp2, sv);
+  ASSERT_TRUE(Storage::verify(input, output));
+
+  FieldCache::Statistics statistics = s_read.fieldCacheStatistics();
+  EXPECT_EQ(statistics.hits, 1);
+  EXPECT_EQ(statistics.misses, 1);
+
+  // Sliced reads are cached separately
+  s_read.readSliced("u", sp1, sv, Slice(1, 3));
+  s_read.readSliced("u", sp2, sv, Slice(1, 3));
+  EXPECT_EQ(s_read.fieldCacheStatistics().hits, 2);
+  EXPECT_EQ(s_read.fieldCacheStatistics().entries, 2);
+
+  s_read.flushFieldCache();
+  EXPECT_EQ(s_read.fieldCacheStatistics().entries, 0);
+
+  auto svFull = output.toStorageView();
+  s_read.read("u", sp1, svFull);
+  EXPECT_EQ(s_read.fieldCacheStatistics().misses, 3);
+}
+
+TYPED_TEST(SerializerImplReadWriteTest, Handles) {
+  using Storage = Storage<TypeParam>;
+
+  Storage u_input(Storage::RowMajor, {8, 6, 4}, Storage::random);
+  Storage v_input(Storage::ColMajor, {5, 1}, Storage::random);
+  Storage u_output(Storage::RowMajor, {8, 6, 4});
+  Storage v_output(Storage::ColMajor, {5, 1});
+
+  SavepointImpl sp1("sp"), sp2("sp");
+  sp1.addMetainfo("time", 1);
+  sp2.addMetainfo("time", 2);
+
+  for(const std::string archive : {"Binary", "PackedBinary"}) {
+    const std::string prefix = "Handle" + archive;
+
+    // Write by handle
+    {
+      SerializerImpl s_write(OpenModeKind::Write, this->directory->path().string(), prefix,
+                             archive);
+      auto sv_u = u_input.toStorageView();
+      auto sv_v = v_input.toStorageView();
+      FieldHandle u = s_write.registerField("u", sv_u.type(), sv_u.dims());
+      s_write.registerField("v", sv_v.type(), sv_v.dims());
+      FieldHandle v = s_write.lookupField("v");
+      ASSERT_TRUE(u.valid());
+      EXPECT_EQ(u.name(), "u");
+      EXPECT_EQ(v.name(), "v");
+      EXPECT_NE(u.index(), v.index());
+      EXPECT_THROW(s_write.lookupField("w"), Exception);
+
+      EXPECT_FALSE(s_write.findSavepoint(sp1).valid());
+      SavepointHandle h1 = s_write.findOrRegisterSavepoint(sp1);
+      SavepointHandle h2 = s_write.findOrRegisterSavepoint(sp2);
+      ASSERT_TRUE(h1.valid());
+      EXPECT_EQ(s_write.findSavepoint(sp1).index(), h1.index());
+      EXPECT_EQ(s_write.findOrRegisterSavepoint(sp2).index(), h2.index());
+
+      s_write.write(u, h1, sv_u);
+      s_write.write(v, h1, sv_v);
+      s_write.write("u", sp2, sv_u);
+
+      // Invalid handles, fields which are already saved and inconsistent storages
+      EXPECT_THROW(s_write.write(FieldHandle(), h2, sv_v), Exception);
+      EXPECT_THROW(s_write.write(v, SavepointHandle(), sv_v), Exception);
+      EXPECT_THROW(s_write.write(v, SavepointHandle(2), sv_v), Exception);
+      EXPECT_THROW(s_write.write(u, h2, sv_u), Exception);
+      EXPECT_THROW(s_write.write(v, h2, sv_u), Exception);
+    }
+
+    // Read by handle (fields written by name and by handle)
+    {
+      SerializerImpl s_read(OpenModeKind::Read, this->directory->path().string(), prefix,
+                            archive);
+      auto sv_u = u_output.toStorageView();
+      auto sv_v = v_output.toStorageView();
+      FieldHandle u = s_read.lookupField("u");
+      FieldHandle v = s_read.lookupField("v");
+      SavepointHandle h1 = s_read.findSavepoint(sp1);
+      SavepointHandle h2 = s_read.findSavepoint(sp2);
+      ASSERT_TRUE(h1.valid());
+      ASSERT_TRUE(h2.valid());
+
+      s_read.read(u, h1, sv_u);
+      ASSERT_TRUE(Storage::verify(u_input, u_output));
+
+      u_output.forEach(Storage::random);
+      s_read.read(u, h2, sv_u);
+      ASSERT_TRUE(Storage::verify(u_input, u_output));
+
+      s_read.read(v, h1, sv_v);
+      ASSERT_TRUE(Storage::verify(v_input, v_output));
+
+      // Field `v` is only available at the previous savepoint
+      EXPECT_THROW(s_read.read(v, h2, sv_v), Exception);
+      v_output.forEach(Storage::random);
+      s_read.read(v, h2, sv_v, true);
+      ASSERT_TRUE(Storage::verify(v_input, v_output));
+
+      v_output.forEach(Storage::random);
+      s_read.read("v", sp2, sv_v, true);
+      ASSERT_TRUE(Storage::verify(v_input, v_output));
+
+      EXPECT_THROW(s_read.read(u, SavepointHandle(2), sv_u), Exception);
+      EXPECT_THROW(s_read.read(u, h1, sv_v), Exception);
+    }
+
+    // Handles obtained before clearing the Serializer are rejected
+    {
+      SerializerImpl s_write(OpenModeKind::Write, this->directory->path().string(),
+                             prefix + "Stale", archive);
+      auto sv_u = u_input.toStorageView();
+      auto sv_v = v_input.toStorageView();
+      FieldHandle u = s_write.registerField("u", sv_u.type(), sv_u.dims());
+      SavepointHandle h1 = s_write.findOrRegisterSavepoint(sp1);
+
+      s_write.clear();
+      s_write.registerField("v", sv_v.type(), sv_v.dims());
+      s_write.registerField("u", sv_u.type(), sv_u.dims());
+      SavepointHandle h2 = s_write.findOrRegisterSavepoint(sp2);
+      ASSERT_EQ(h1.index(), h2.index());
+
+      EXPECT_THROW(s_write.write(u, h2, sv_u), Exception);
+      EXPECT_THROW(s_write.write(s_write.lookupField("u"), h1, sv_u), Exception);
+      s_write.write(s_write.lookupField("u"), h2, sv_u);
+    }
+  }
+}
+
+TYPED_TEST(SerializerImplReadWriteTest, Prefetch) {
+  using Storage = Storage<TypeParam>;
+
+  const int numSavepoints = 6;
+  std::vector<Storage> inputs;
+  for(int s = 0; s < numSavepoints; ++s)
+    inputs.emplace_back(Storage::ColMajor, std::vector<int>{7, 5, 3}, Storage::random);
+  Storage output(Storage::ColMajor, {7, 5, 3});
+
+  std::vector<SavepointImpl> savepoints;
+  for(int s = 0; s < numSavepoints; ++s)
+    savepoints.emplace_back("step-" + std::to_string(s));
+
+  {
+    SerializerImpl s_write(OpenModeKind::Write, this->directory->path().string(), "Field",
+                           "Binary");
+    auto sv = inputs[0].toStorageView();
+    s_write.registerField("u", sv.type(), sv.dims());
+    s_write.registerField("v", sv.type(), sv.dims());
+    for(int s = 0; s < numSavepoints; ++s) {
+      s_write.write("u", savepoints[s], inputs[s].toStorageView());
+      if(s % 2 == 0)
+        s_write.write("v", savepoints[s], inputs[s].toStorageView());
+    }
+  }
+
+  SerializerImpl s_read(OpenModeKind::Read, this->directory->path().string(), "Field", "Binary");
+  EXPECT_EQ(s_read.prefetchDepth(), 0);
+
+  // Explicit prefetching (beyond the last savepoint is ignored)
+  s_read.prefetch(savepoints[0], 2);
+  s_read.prefetch(savepoints[numSavepoints - 1], 4);
+  ASSERT_THROW(s_read.prefetch(SavepointImpl("XXX")), Exception);
+
+  // Replay in order and backwards with automatic prefetching
+  s_read.setPrefetchDepth(2);
+  EXPECT_EQ(s_read.prefetchDepth(), 2);
+
+  for(int n = 0; n < 2; ++n) {
+    for(int i = 0; i < numSavepoints; ++i) {
+      int s = n == 0 ? i : numSavepoints - 1 - i;
+      auto sv = output.toStorageView();
+      s_read.read("u", savepoints[s], sv);
+      ASSERT_TRUE(Storage::verify(inputs[s], output));
+    }
+  }
+}
+
+TYPED_TEST(SerializerImplReadWriteTest, AccessTrace) {
+  using Storage = Storage<TypeParam>;
+
+  const int numSavepoints = 4;
+  std::vector<Storage> inputs;
+  for(int s = 0; s < numSavepoints; ++s)
+    inputs.emplace_back(Storage::ColMajor, std::vector<int>{7, 5, 3}, Storage::random);
+  Storage output(Storage::ColMajor, {7, 5, 3});
+  const std::size_t fieldSize = 7 * 5 * 3 * sizeof(TypeParam);
+
+  std::vector<SavepointImpl> savepoints;
+  for(int s = 0; s < numSavepoints; ++s)
+    savepoints.emplace_back("step-" + std::to_string(s));
+
+  {
+    SerializerImpl s_write(OpenModeKind::Write, this->directory->path().string(), "Field",
+                           "Binary");
+    auto sv = inputs[0].toStorageView();
+    s_write.registerField("u", sv.type(), sv.dims());
+    for(int s = 0; s < numSavepoints; ++s)
+      s_write.write("u", savepoints[s], inputs[s].toStorageView());
+  }
+
+  // Replay: full reads of all savepoints (backwards) and a sliced read of the first savepoint
+  auto replay = [&](SerializerImpl& ser) {
+    for(int s = numSavepoints - 1; s >= 0; --s) {
+      auto sv = output.toStorageView();
+      ser.read("u", savepoints[s], sv);
+      ASSERT_TRUE(Storage::verify(inputs[s], output));
+    }
+    auto sv = output.toStorageView();
+    ser.readSliced("u", savepoints[0], sv, Slice(1, 3)(0, 2));
+  };
+
+  // Record the access trace
+  {
+    SerializerImpl s_read(OpenModeKind::Read, this->directory->path().string(), "Field",
+                          "Binary");
+    ASSERT_THROW(s_read.replayAccessTrace(1 << 20), Exception);
+
+    EXPECT_FALSE(s_read.isRecordingAccessTrace());
+    s_read.setAccessTraceRecording(true);
+    EXPECT_TRUE(s_read.isRecordingAccessTrace());
+    replay(s_read);
+    s_read.setAccessTraceRecording(false);
+    EXPECT_FALSE(s_read.isRecordingAccessTrace());
+  }
+
+  AccessTrace trace = AccessTrace::fromFile(
+      (this->directory->path() / AccessTrace::filename("Field")).string());
+  ASSERT_EQ(trace.size(), numSavepoints + 1);
+  EXPECT_EQ(trace[0].savepoint, numSavepoints - 1);
+  EXPECT_EQ(trace[0].fieldID, (FieldID{"u", numSavepoints - 1}));
+  EXPECT_TRUE(trace[numSavepoints].matches(FieldID{"u", 0}, {{1, 3, 1}, {0, 2, 1}, {0, 3, 1}}));
+
+  // Follow the trace with a budget of two fields
+  SerializerImpl s_read(OpenModeKind::Read, this->directory->path().string(), "Field", "Binary");
+  s_read.replayAccessTrace(2 * fieldSize);
+  EXPECT_TRUE(s_read.isReplayingAccessTrace());
+  EXPECT_GE(s_read.fieldCacheSize(), 2 * fieldSize);
+
+  s_read.waitForPrefetch();
+  EXPECT_EQ(s_read.fieldCacheStatistics().entries, 2);
+
+  for(int s = numSavepoints - 1; s >= 0; --s) {
+    auto sv = output.toStorageView();
+    s_read.read("u", savepoints[s], sv);
+    ASSERT_TRUE(Storage::verify(inputs[s], output));
+    s_read.waitForPrefetch();
+  }
+  EXPECT_EQ(s_read.fieldCacheStatistics().hits, numSavepoints);
+  EXPECT_EQ(s_read.fieldCacheStatistics().misses, 0);
+
+  // The sliced read was prefetched as well
+  Storage sliced(Storage::ColMajor, {7, 5, 3});
+  auto sv = sliced.toStorageView();
+  s_read.readSliced("u", savepoints[0], sv, Slice(1, 3)(0, 2));
+  EXPECT_EQ(s_read.fieldCacheStatistics().hits, numSavepoints + 1);
+  for(int k = 0; k < 3; ++k)
+    for(int j = 0; j < 2; ++j)
+      for(int i = 1; i < 3; ++i)
+        ASSERT_EQ(sliced(i, j, k), inputs[0](i, j, k));
+
+  s_read.replayAccessTrace(0);
+  EXPECT_FALSE(s_read.isReplayingAccessTrace());
+}
+
 #ifdef SERIALBOX_RUN_LARGE_FILE_TESTS
 
 TYPED_TEST(SerializerImplReadWriteTest, LargeFile) {
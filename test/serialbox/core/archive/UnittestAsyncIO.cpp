@@ -0,0 +1,161 @@
+//===-- serialbox/core/archive/UnittestAsyncIO.cpp ----------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the unittests of the backends of batched file I/O.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "utility/SerializerTestBase.h"
+#include "serialbox/core/Exception.h"
+#include "serialbox/core/STLExtras.h"
+#include "serialbox/core/archive/AsyncIO.h"
+#include <algorithm>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <unistd.h>
+
+using namespace serialbox;
+using namespace unittest;
+
+namespace {
+
+class AsyncIOTest : public SerializerUnittestBase {
+protected:
+  /// Open (and create) the file `name` in the test directory
+  int open(const std::string& name) {
+    int fd = ::open((directory->path() / name).c_str(), O_RDWR | O_CREAT, 0644);
+    if(fd >= 0)
+      fds_.push_back(fd);
+    return fd;
+  }
+
+  virtual void TearDown() override {
+    for(int fd : fds_)
+      ::close(fd);
+    SerializerUnittestBase::TearDown();
+  }
+
+  /// Write and read back many small and a few large requests
+  void testReadWrite(AsyncIO& asyncIO) {
+    int fd = open("data.bin");
+    ASSERT_GE(fd, 0);
+
+    // 4096 requests of 100 bytes followed by 4 requests of 1 MB (written in reverse order)
+    const std::size_t numSmall = 4096, smallSize = 100, numLarge = 4, largeSize = 1 << 20;
+    const std::size_t size = numSmall * smallSize + numLarge * largeSize;
+
+    std::vector<Byte> data(size);
+    for(std::size_t i = 0; i < size; ++i)
+      data[i] = static_cast<Byte>((i * 7 + i / 251) & 0xff);
+
+    std::vector<AsyncIO::Request> writes;
+    for(std::size_t i = 0; i < numSmall; ++i)
+      writes.push_back(AsyncIO::Request{AsyncIO::OpKind::Write, fd, i * smallSize,
+                                        data.data() + i * smallSize, smallSize});
+    for(std::size_t i = 0; i < numLarge; ++i) {
+      std::size_t offset = numSmall * smallSize + i * largeSize;
+      writes.push_back(
+          AsyncIO::Request{AsyncIO::OpKind::Write, fd, offset, data.data() + offset, largeSize});
+    }
+    std::reverse(writes.begin(), writes.end());
+    asyncIO.submit(writes);
+
+    std::vector<Byte> output(size, 0);
+    std::vector<AsyncIO::Request> reads(writes);
+    for(AsyncIO::Request& request : reads) {
+      request.kind = AsyncIO::OpKind::Read;
+      request.data = output.data() + (request.data - data.data());
+    }
+    asyncIO.submit(reads);
+    ASSERT_TRUE(output == data);
+
+    // The backend can be reused and an empty batch is a no-op
+    std::fill(output.begin(), output.end(), 0);
+    asyncIO.submit(reads);
+    ASSERT_TRUE(output == data);
+    asyncIO.submit(std::vector<AsyncIO::Request>());
+  }
+
+  /// Reads beyond the end of the file and of invalid files fail
+  void testErrors(AsyncIO& asyncIO) {
+    int fd = open("small.bin");
+    ASSERT_GE(fd, 0);
+
+    std::vector<Byte> data(1000, 1), output(1000, 0);
+    asyncIO.submit({AsyncIO::Request{AsyncIO::OpKind::Write, fd, 0, data.data(), data.size()}});
+
+    // Short read at the end of the file (the other requests are completed nevertheless)
+    std::vector<AsyncIO::Request> reads{
+        AsyncIO::Request{AsyncIO::OpKind::Read, fd, 500, output.data(), 1000},
+        AsyncIO::Request{AsyncIO::OpKind::Read, fd, 0, output.data(), 10}};
+    EXPECT_THROW(asyncIO.submit(reads), Exception);
+
+    reads = {AsyncIO::Request{AsyncIO::OpKind::Read, -1, 0, output.data(), 10}};
+    EXPECT_THROW(asyncIO.submit(reads), Exception);
+
+    // The backend is still usable
+    reads = {AsyncIO::Request{AsyncIO::OpKind::Read, fd, 0, output.data(), 1000}};
+    asyncIO.submit(reads);
+    EXPECT_TRUE(output == data);
+  }
+
+private:
+  std::vector<int> fds_;
+};
+
+} // anonymous namespace
+
+TEST_F(AsyncIOTest, ThreadPool) {
+  ThreadPoolIO asyncIO(4);
+  EXPECT_STREQ(asyncIO.name(), "threads");
+  testReadWrite(asyncIO);
+  testErrors(asyncIO);
+}
+
+TEST_F(AsyncIOTest, Default) {
+  std::unique_ptr<AsyncIO> asyncIO = AsyncIO::create();
+  ASSERT_TRUE(asyncIO != nullptr);
+  testReadWrite(*asyncIO);
+  testErrors(*asyncIO);
+}
+
+#ifdef SERIALBOX_HAS_IO_URING
+TEST_F(AsyncIOTest, IoUring) {
+  std::unique_ptr<IoUringIO> asyncIO;
+  try {
+    asyncIO = std::make_unique<IoUringIO>();
+  } catch(Exception& e) {
+    std::cout << "[  SKIPPED ] io_uring is not available: " << e.what() << std::endl;
+    return;
+  }
+  EXPECT_STREQ(asyncIO->name(), "io_uring");
+  testReadWrite(*asyncIO);
+  testErrors(*asyncIO);
+
+  // More staging buffers than registered are needed for the batch
+  int fd = open("many.bin");
+  ASSERT_GE(fd, 0);
+  const std::size_t numRequests = 4 * IoUringIO::NumFixedBuffers + 1;
+  std::vector<Byte> data(numRequests * 8), output(data.size(), 0);
+  std::iota(data.begin(), data.end(), 0);
+  std::vector<AsyncIO::Request> requests;
+  for(std::size_t i = 0; i < numRequests; ++i)
+    requests.push_back(
+        AsyncIO::Request{AsyncIO::OpKind::Write, fd, 8 * i, data.data() + 8 * i, 8});
+  asyncIO->submit(requests);
+  for(AsyncIO::Request& request : requests) {
+    request.kind = AsyncIO::OpKind::Read;
+    request.data = output.data() + request.offset;
+  }
+  asyncIO->submit(requests);
+  ASSERT_TRUE(output == data);
+}
+#endif
@@ -15,8 +15,10 @@
 #include "utility/SerializerTestBase.h"
 #include "utility/Storage.h"
 #include "serialbox/core/archive/BinaryArchive.h"
+#include "serialbox/core/compression/LZCodec.h"
 #include "serialbox/core/Version.h"
 #include <boost/algorithm/string.hpp>
+#include <fstream>
 #include <gtest/gtest.h>
 
 using namespace serialbox;
@@ -109,6 +111,9 @@ TEST_F(BinaryArchiveUtilityTest, MetaData) {
   ifs >> j;
   ifs.close();
 
+  // Archives of plain entries are readable by all revisions
+  EXPECT_EQ(int(j["archive_version"]), 0);
+
   // Write meta file to disk (to corrupt it)
   std::string filename = archiveWrite.metaDataFile();
   auto toFile = [this, &filename](const json::json& jsonNode) -> void {
@@ -348,6 +353,646 @@ TEST_F(BinaryArchiveUtilityTest, SliceWriteAndRead) {
   }
 }
 
+TEST_F(BinaryArchiveUtilityTest, Compression) {
+  using Storage = Storage<double>;
+
+  int dim1 = 5, dim2 = 10, dim3 = 15;
+  Storage input(Storage::ColMajor, {dim1, dim2, dim3}, {{3, 3}, {3, 3}, {3, 3}},
+                Storage::sequential);
+  Storage output(Storage::ColMajor, {dim1, dim2, dim3}, {{3, 3}, {3, 3}, {3, 3}},
+                 Storage::random);
+
+  // Small blocks to exercise sliced reads of several blocks (the block size is rounded down to
+  // a multiple of the element size)
+  auto info = std::make_shared<FieldMetainfoImpl>(TypeID::Float64, input.dims());
+  info->metaInfo().insert(CodecPipeline::CodecKey, std::string(LZCodec::Name));
+  info->metaInfo().insert(CodecPipeline::BlockSizeKey, 100);
+
+  const std::size_t size = dim1 * dim2 * dim3 * sizeof(double);
+  {
+    BinaryArchive archiveWrite(OpenModeKind::Write, directory->path().string(), "field");
+    auto sv = input.toStorageView();
+    EXPECT_EQ(archiveWrite.write(sv, "u", info).id, 0);
+    EXPECT_EQ(archiveWrite.write(sv, "u", info).id, 0);
+    EXPECT_EQ(archiveWrite.write(sv, "v", nullptr).id, 0);
+
+    const CodecInfo& codec = archiveWrite.fieldTable().at("u")[0].codec;
+    EXPECT_TRUE(codec.isEncoded());
+    EXPECT_EQ(codec.codec, LZCodec::Name);
+    EXPECT_EQ(codec.shuffle, sizeof(double));
+    EXPECT_EQ(codec.blockSize, 96);
+    EXPECT_EQ(codec.size, size);
+    EXPECT_EQ(codec.numBlocks(), (size + 95) / 96);
+    EXPECT_LT(codec.compressedSize(), size);
+    EXPECT_FALSE(archiveWrite.fieldTable().at("v")[0].codec.isEncoded());
+  }
+
+  EXPECT_EQ(filesystem::file_size(directory->path() / "field_v.dat"), size);
+  EXPECT_LT(filesystem::file_size(directory->path() / "field_u.dat"), size);
+
+  {
+    std::ifstream fs((directory->path() / "ArchiveMetaData-field.json").string());
+    json::json j;
+    fs >> j;
+    EXPECT_EQ(int(j["archive_version"]), 1);
+  }
+
+  BinaryArchive archiveRead(OpenModeKind::Read, directory->path().string(), "field");
+  EXPECT_EQ(archiveRead.fieldTable().at("u")[0].codec.numBlocks(), (size + 95) / 96);
+
+  {
+    auto sv = output.toStorageView();
+    archiveRead.read(sv, FieldID{"u", 0}, nullptr);
+    ASSERT_TRUE(Storage::verify(input, output));
+  }
+
+  output.forEach(Storage::random);
+
+  {
+    auto sv = output.toStorageView();
+    sv.setSlice(Slice()()(5, 7));
+    archiveRead.read(sv, FieldID{"u", 0}, nullptr);
+    for(int k = 5; k < 7; ++k)
+      for(int j = 0; j < dim2; ++j)
+        for(int i = 0; i < dim1; ++i)
+          ASSERT_EQ(input(i, j, k), output(i, j, k))
+              << "(i,j,k) = (" << i << "," << j << "," << k << ")";
+  }
+
+  // Corrupted data
+  {
+    std::ofstream fs((directory->path() / "field_u.dat").string(),
+                     std::ios::out | std::ios::binary | std::ios::trunc);
+  }
+  auto sv = output.toStorageView();
+  ASSERT_THROW(archiveRead.read(sv, FieldID{"u", 0}, nullptr), Exception);
+}
+
+TEST_F(BinaryArchiveUtilityTest, LossyCompression) {
+  using Storage = Storage<float>;
+  Storage input(Storage::ColMajor, {32, 32, 8}, Storage::random);
+  Storage output(Storage::ColMajor, {32, 32, 8});
+
+  auto info = std::make_shared<FieldMetainfoImpl>(TypeID::Float32, input.dims());
+  info->metaInfo().insert(CodecPipeline::RelErrorKey, 1e-2);
+
+  {
+    BinaryArchive archiveWrite(OpenModeKind::Write, directory->path().string(), "field");
+    auto sv = input.toStorageView();
+    archiveWrite.write(sv, "u", info);
+  }
+
+  BinaryArchive archiveRead(OpenModeKind::Read, directory->path().string(), "field");
+  const CodecInfo& codec = archiveRead.fieldTable().at("u")[0].codec;
+  EXPECT_EQ(codec.codec, LZCodec::Name);
+  EXPECT_EQ(codec.errorBoundKind, ErrorBoundKind::Relative);
+  EXPECT_EQ(codec.errorBound, 1e-2);
+  EXPECT_LE(codec.maxError, 1e-2);
+  EXPECT_GT(codec.ratio(), 1.0);
+
+  auto sv = output.toStorageView();
+  archiveRead.read(sv, FieldID{"u", 0}, nullptr);
+  for(int k = 0; k < 8; ++k)
+    for(int j = 0; j < 32; ++j)
+      for(int i = 0; i < 32; ++i)
+        ASSERT_LE(std::abs(input(i, j, k) - output(i, j, k)), 1e-2 * std::abs(input(i, j, k)));
+}
+
+TEST_F(BinaryArchiveUtilityTest, DeltaEncoding) {
+  using Storage = Storage<double>;
+
+  int dim1 = 8, dim2 = 10, dim3 = 12;
+  const int numIds = 7;
+
+  // Slowly evolving field (only a few elements change between the ids)
+  std::vector<Storage> inputs;
+  inputs.emplace_back(Storage::ColMajor, std::vector<int>{dim1, dim2, dim3}, Storage::random);
+  for(int n = 1; n < numIds; ++n) {
+    inputs.push_back(inputs.back());
+    for(int k = 0; k < dim3; ++k)
+      inputs.back()(n, n, k) += 1.0;
+  }
+  Storage output(Storage::ColMajor, {dim1, dim2, dim3});
+
+  auto info = std::make_shared<FieldMetainfoImpl>(TypeID::Float64, output.dims());
+  info->metaInfo().insert(CodecPipeline::DeltaKey, true);
+  info->metaInfo().insert(CodecPipeline::KeyframeIntervalKey, 3);
+  info->metaInfo().insert(CodecPipeline::BlockSizeKey, 512);
+
+  auto infoPlain = std::make_shared<FieldMetainfoImpl>(TypeID::Float64, output.dims());
+  infoPlain->metaInfo().insert(CodecPipeline::CodecKey, std::string(LZCodec::Name));
+
+  auto verify = [&](const BinaryArchive& archive) {
+    const auto& table = archive.fieldTable().at("u");
+    ASSERT_EQ(table.size(), numIds);
+    for(int n = 0; n < numIds; ++n) {
+      const CodecInfo& codec = table[n].codec;
+      EXPECT_EQ(codec.codec, LZCodec::Name);
+      EXPECT_EQ(codec.deltaDepth, n % 3);
+      EXPECT_EQ(codec.deltaReference, n % 3 == 0 ? -1 : n - 1);
+
+      // Full read
+      auto sv = output.toStorageView();
+      archive.read(sv, FieldID{"u", (unsigned)n}, nullptr);
+      ASSERT_TRUE(Storage::verify(inputs[n], output)) << "id = " << n;
+
+      // Sliced read
+      output.forEach(Storage::random);
+      sv.setSlice(Slice()()(3, 5));
+      archive.read(sv, FieldID{"u", (unsigned)n}, nullptr);
+      for(int k = 3; k < 5; ++k)
+        for(int j = 0; j < dim2; ++j)
+          for(int i = 0; i < dim1; ++i)
+            ASSERT_EQ(inputs[n](i, j, k), output(i, j, k)) << "id = " << n;
+    }
+  };
+
+  // Write the first half and continue in append mode (the reference is decoded from disk)
+  {
+    BinaryArchive archiveWrite(OpenModeKind::Write, directory->path().string(), "field");
+    for(int n = 0; n < 4; ++n) {
+      auto sv = inputs[n].toStorageView();
+      EXPECT_EQ(archiveWrite.write(sv, "u", info).id, n);
+      archiveWrite.write(sv, "v", infoPlain);
+    }
+  }
+  {
+    BinaryArchive archiveAppend(OpenModeKind::Append, directory->path().string(), "field");
+    for(int n = 4; n < numIds; ++n) {
+      auto sv = inputs[n].toStorageView();
+      EXPECT_EQ(archiveAppend.write(sv, "u", info).id, n);
+      archiveAppend.write(sv, "v", infoPlain);
+    }
+    verify(archiveAppend);
+  }
+
+  EXPECT_LT(filesystem::file_size(directory->path() / "field_u.dat"),
+            filesystem::file_size(directory->path() / "field_v.dat"));
+
+  BinaryArchive archiveRead(OpenModeKind::Read, directory->path().string(), "field");
+  verify(archiveRead);
+
+  // Random access (the most recently decoded id is not a reference)
+  for(int n = numIds - 1; n >= 0; --n) {
+    auto sv = output.toStorageView();
+    archiveRead.read(sv, FieldID{"u", (unsigned)n}, nullptr);
+    ASSERT_TRUE(Storage::verify(inputs[n], output)) << "id = " << n;
+  }
+
+  // Invalid interval
+  info->metaInfo().clear();
+  info->metaInfo().insert(CodecPipeline::DeltaKey, true);
+  info->metaInfo().insert(CodecPipeline::KeyframeIntervalKey, 0);
+  BinaryArchive archiveWrite(OpenModeKind::Write, directory->path().string(), "field");
+  auto sv = inputs[0].toStorageView();
+  ASSERT_THROW(archiveWrite.write(sv, "u", info), Exception);
+}
+
+TEST_F(BinaryArchiveUtilityTest, ChunkedStorage) {
+  using Storage = Storage<double>;
+
+  int dim1 = 128, dim2 = 128, dim3 = 10;
+  Storage input(Storage::ColMajor, {dim1, dim2, dim3}, Storage::random);
+  Storage output(Storage::ColMajor, {dim1, dim2, dim3});
+
+  auto info = std::make_shared<FieldMetainfoImpl>(TypeID::Float64, input.dims());
+  info->metaInfo().insert(ChunkLayout::ChunkShapeKey, Array<int>{32, 48, 10});
+
+  auto infoCompressed = std::make_shared<FieldMetainfoImpl>(*info);
+  infoCompressed->metaInfo().insert(CodecPipeline::CodecKey, std::string(LZCodec::Name));
+  infoCompressed->metaInfo().insert(CodecPipeline::BlockSizeKey, 32 * 48 * 10 * 8);
+
+  {
+    BinaryArchive archiveWrite(OpenModeKind::Write, directory->path().string(), "field");
+    auto sv = input.toStorageView();
+    archiveWrite.write(sv, "u", info);
+    archiveWrite.write(sv, "v", infoCompressed);
+    archiveWrite.write(sv, "w", nullptr);
+  }
+
+  BinaryArchive archiveRead(OpenModeKind::Read, directory->path().string(), "field");
+
+  // Chunk index is stored in the meta-data (4 x 3 x 1 chunks)
+  const ChunkIndex& chunks = archiveRead.fieldTable().at("u")[0].chunks;
+  EXPECT_EQ(chunks.shape, (std::vector<int>{32, 48, 10}));
+  EXPECT_EQ(chunks.offsets.size(), 12);
+  EXPECT_TRUE(archiveRead.fieldTable().at("v")[0].chunks.isChunked());
+  EXPECT_TRUE(archiveRead.fieldTable().at("v")[0].codec.isEncoded());
+  EXPECT_FALSE(archiveRead.fieldTable().at("w")[0].chunks.isChunked());
+
+  for(std::string field : {"u", "v", "w"}) {
+    // Full read
+    {
+      auto sv = output.toStorageView();
+      archiveRead.read(sv, FieldID{field, 0}, nullptr);
+      ASSERT_TRUE(Storage::verify(input, output)) << field;
+    }
+
+    // Sub-domain reads (sequential and parallel)
+    for(std::size_t numThreads : {1, 4}) {
+      archiveRead.setNumChunkReadThreads(numThreads);
+      output.forEach(Storage::random);
+
+      auto sv = output.toStorageView();
+      sv.setSlice(Slice(10, 40, 3)(50, 60)(2, 9, 2));
+      archiveRead.read(sv, FieldID{field, 0}, nullptr);
+      for(int k = 2; k < 9; k += 2)
+        for(int j = 50; j < 60; ++j)
+          for(int i = 10; i < 40; i += 3)
+            ASSERT_EQ(input(i, j, k), output(i, j, k)) << field;
+
+      // The whole domain exceeds the threshold of parallel reads
+      sv.setSlice(Slice()()(4, 6));
+      archiveRead.read(sv, FieldID{field, 0}, nullptr);
+      for(int k = 4; k < 6; ++k)
+        for(int j = 0; j < dim2; ++j)
+          for(int i = 0; i < dim1; ++i)
+            ASSERT_EQ(input(i, j, k), output(i, j, k)) << field;
+    }
+  }
+
+  // Chunk index does not match the requested storage
+  Storage other(Storage::ColMajor, {dim1, dim2 / 2, dim3 * 2});
+  auto sv = other.toStorageView();
+  ASSERT_THROW(archiveRead.read(sv, FieldID{"u", 0}, nullptr), Exception);
+}
+
+TEST_F(BinaryArchiveUtilityTest, SegmentedReads) {
+  using Storage = Storage<double>;
+
+  int dim1 = 50, dim2 = 40, dim3 = 12;
+  Storage input(Storage::ColMajor, {dim1, dim2, dim3}, Storage::random);
+  Storage zero(Storage::ColMajor, {dim1, dim2, dim3}, [](int) { return 0.0; });
+  Storage inputRowMajor(Storage::RowMajor, {dim1, dim2, dim3}, Storage::random);
+
+  {
+    BinaryArchive archiveWrite(OpenModeKind::Write, directory->path().string(), "field");
+    archiveWrite.write(zero.toStorageView(), "u", nullptr);
+    archiveWrite.write(input.toStorageView(), "u", nullptr);
+    archiveWrite.write(inputRowMajor.toStorageView(), "v", nullptr);
+  }
+
+  BinaryArchive archiveRead(OpenModeKind::Read, directory->path().string(), "field");
+  EXPECT_EQ(archiveRead.minReadSegmentSize(), BinaryArchive::DefaultMinReadSegmentSize);
+  EXPECT_EQ(archiveRead.numSegmentReadThreads(), 1); // Opt-in
+
+  // Segments are at least aligned
+  archiveRead.setMinReadSegmentSize(1);
+  EXPECT_EQ(archiveRead.minReadSegmentSize(), BinaryArchive::ReadSegmentAlignment);
+
+  // The field (192 KB) is split into 4 KB segments (the single-threaded read is the reference)
+  for(std::size_t numThreads : {1, 4}) {
+    archiveRead.setNumSegmentReadThreads(numThreads);
+    EXPECT_EQ(archiveRead.numSegmentReadThreads(), numThreads);
+
+    // Contiguous storage (read directly)
+    Storage output(Storage::ColMajor, {dim1, dim2, dim3});
+    auto sv = output.toStorageView();
+    archiveRead.read(sv, FieldID{"u", 1}, nullptr);
+    ASSERT_TRUE(Storage::verify(input, output)) << numThreads;
+
+    // Non-contiguous storage (staged)
+    Storage outputRowMajor(Storage::RowMajor, {dim1, dim2, dim3});
+    auto svRowMajor = outputRowMajor.toStorageView();
+    archiveRead.read(svRowMajor, FieldID{"v", 0}, nullptr);
+    ASSERT_TRUE(Storage::verify(inputRowMajor, outputRowMajor)) << numThreads;
+
+    // Sliced storage (staged)
+    Storage outputSliced(Storage::ColMajor, {dim1, dim2, dim3}, [](int) { return -1.0; });
+    auto svSliced = outputSliced.toStorageView();
+    svSliced.setSlice(Slice(3, 47, 4)(0, 40, 3)(1, 11, 2));
+    archiveRead.read(svSliced, FieldID{"u", 1}, nullptr);
+    for(int k = 0; k < dim3; ++k)
+      for(int j = 0; j < dim2; ++j)
+        for(int i = 0; i < dim1; ++i) {
+          bool inSlice = i >= 3 && i < 47 && (i - 3) % 4 == 0 && j % 3 == 0 && k >= 1 &&
+                         k < 11 && (k - 1) % 2 == 0;
+          ASSERT_EQ(outputSliced(i, j, k), inSlice ? input(i, j, k) : -1.0) << numThreads;
+        }
+  }
+
+  // Truncated data file
+  filesystem::path file = directory->path() / "field_u.dat";
+  filesystem::resize_file(file, filesystem::file_size(file) - 1000);
+  Storage output(Storage::ColMajor, {dim1, dim2, dim3});
+  auto sv = output.toStorageView();
+  EXPECT_THROW(archiveRead.read(sv, FieldID{"u", 1}, nullptr), Exception);
+}
+
+TEST_F(BinaryArchiveUtilityTest, UniformFields) {
+  using Storage = Storage<double>;
+
+  int dim1 = 20, dim2 = 15, dim3 = 4;
+  Storage zero(Storage::ColMajor, {dim1, dim2, dim3}, [](int) { return 0.0; });
+  Storage constant(Storage::ColMajor, {dim1, dim2, dim3}, [](int) { return 3.5; });
+  Storage random(Storage::ColMajor, {dim1, dim2, dim3}, Storage::random);
+
+  // Non-contiguous storage with the same content
+  Storage zeroPadded(Storage::RowMajor, {dim1, dim2, dim3}, {{1, 1}, {2, 2}, {0, 0}},
+                     [](int) { return 0.0; });
+
+  {
+    BinaryArchive archiveWrite(OpenModeKind::Write, directory->path().string(), "field");
+    auto sv_zero = zero.toStorageView();
+    auto sv_constant = constant.toStorageView();
+    auto sv_random = random.toStorageView();
+    auto sv_zeroPadded = zeroPadded.toStorageView();
+
+    // Identical constants are deduplicated
+    EXPECT_EQ(archiveWrite.write(sv_zero, "u", nullptr).id, 0);
+    EXPECT_EQ(archiveWrite.write(sv_zero, "u", nullptr).id, 0);
+    EXPECT_EQ(archiveWrite.write(sv_zeroPadded, "u", nullptr).id, 0);
+    EXPECT_EQ(archiveWrite.write(sv_constant, "u", nullptr).id, 1);
+    EXPECT_EQ(archiveWrite.write(sv_random, "u", nullptr).id, 2);
+    EXPECT_EQ(archiveWrite.write(sv_constant, "u", nullptr).id, 1);
+
+    // Fields which are always uniform never create a data file
+    EXPECT_EQ(archiveWrite.write(sv_zero, "mask", nullptr).id, 0);
+  }
+
+  // Only the non-uniform data is written
+  EXPECT_EQ(filesystem::file_size(directory->path() / "field_u.dat"),
+            dim1 * dim2 * dim3 * sizeof(double));
+  EXPECT_FALSE(filesystem::exists(directory->path() / "field_mask.dat"));
+
+  BinaryArchive archiveRead(OpenModeKind::Read, directory->path().string(), "field");
+  const auto& table = archiveRead.fieldTable().at("u");
+  ASSERT_EQ(table.size(), 3);
+  EXPECT_TRUE(table[0].uniform.isUniform());
+  EXPECT_EQ(table[0].uniform.dims, (std::vector<int>{dim1, dim2, dim3}));
+  EXPECT_TRUE(table[1].uniform.isUniform());
+  EXPECT_FALSE(table[2].uniform.isUniform());
+
+  Storage output(Storage::ColMajor, {dim1, dim2, dim3}, Storage::random);
+  Storage outputPadded(Storage::RowMajor, {dim1, dim2, dim3}, {{1, 1}, {2, 2}, {0, 0}},
+                       Storage::random);
+  auto sv = output.toStorageView();
+  auto svPadded = outputPadded.toStorageView();
+
+  archiveRead.read(sv, FieldID{"u", 0}, nullptr);
+  ASSERT_TRUE(Storage::verify(zero, output));
+  archiveRead.read(sv, FieldID{"mask", 0}, nullptr);
+  ASSERT_TRUE(Storage::verify(zero, output));
+  archiveRead.read(sv, FieldID{"u", 1}, nullptr);
+  ASSERT_TRUE(Storage::verify(constant, output));
+  archiveRead.read(sv, FieldID{"u", 2}, nullptr);
+  ASSERT_TRUE(Storage::verify(random, output));
+
+  archiveRead.read(svPadded, FieldID{"u", 1}, nullptr);
+  ASSERT_TRUE(Storage::verify(constant, outputPadded));
+
+  // Sliced read
+  output.forEach(Storage::random);
+  sv.setSlice(Slice(2, 5)()(1, 2));
+  archiveRead.read(sv, FieldID{"u", 1}, nullptr);
+  for(int j = 0; j < dim2; ++j)
+    for(int i = 2; i < 5; ++i)
+      ASSERT_EQ(output(i, j, 1), 3.5);
+
+  // Dimensions do not match
+  Storage other(Storage::ColMajor, {dim1, dim2});
+  auto svOther = other.toStorageView();
+  ASSERT_THROW(archiveRead.read(svOther, FieldID{"u", 0}, nullptr), Exception);
+}
+
+TEST_F(BinaryArchiveUtilityTest, UniformFieldsDeduplication) {
+  // The raw data of `collision` equals the value of `uniform` followed by its size in bytes
+  Storage<int> uniform(Storage<int>::ColMajor, {3}, [](int) { return 7; });
+  Storage<int> collision(Storage<int>::ColMajor, {3});
+  collision(0) = 7;
+  collision(1) = 3 * sizeof(int);
+  collision(2) = 0;
+  Storage<int> single(Storage<int>::ColMajor, {1}, [](int) { return 7; });
+
+  Storage<double> input(Storage<double>::ColMajor, {16, 8}, Storage<double>::random);
+  auto lossy = std::make_shared<FieldMetainfoImpl>(TypeID::Float64, input.dims());
+  lossy->metaInfo().insert(CodecPipeline::RelErrorKey, 1e-3);
+
+  {
+    BinaryArchive archiveWrite(OpenModeKind::Write, directory->path().string(), "field");
+    auto sv_uniform = uniform.toStorageView();
+    auto sv_collision = collision.toStorageView();
+    auto sv_single = single.toStorageView();
+    auto sv_input = input.toStorageView();
+
+    EXPECT_EQ(archiveWrite.write(sv_uniform, "u", nullptr).id, 0);
+    EXPECT_EQ(archiveWrite.write(sv_collision, "u", nullptr).id, 1);
+    EXPECT_EQ(archiveWrite.write(sv_single, "s", nullptr).id, 0);
+    EXPECT_FALSE(archiveWrite.fieldTable().at("s")[0].uniform.isUniform());
+
+    // Lossy and lossless data is not shared
+    EXPECT_EQ(archiveWrite.write(sv_input, "v", lossy).id, 0);
+    EXPECT_EQ(archiveWrite.write(sv_input, "v", nullptr).id, 1);
+    EXPECT_EQ(archiveWrite.write(sv_input, "v", lossy).id, 0);
+    EXPECT_EQ(archiveWrite.write(sv_input, "v", nullptr).id, 1);
+  }
+
+  BinaryArchive archiveRead(OpenModeKind::Read, directory->path().string(), "field");
+  Storage<int> output(Storage<int>::ColMajor, {3});
+  auto sv = output.toStorageView();
+  archiveRead.read(sv, FieldID{"u", 1}, nullptr);
+  ASSERT_TRUE(Storage<int>::verify(collision, output));
+  archiveRead.read(sv, FieldID{"u", 0}, nullptr);
+  ASSERT_TRUE(Storage<int>::verify(uniform, output));
+
+  Storage<double> outputDouble(Storage<double>::ColMajor, {16, 8});
+  auto svDouble = outputDouble.toStorageView();
+  archiveRead.read(svDouble, FieldID{"v", 1}, nullptr);
+  ASSERT_TRUE(Storage<double>::verify(input, outputDouble));
+}
+
+TEST_F(BinaryArchiveUtilityTest, BlockStore) {
+  using Storage = Storage<double>;
+
+  int dim1 = 40, dim2 = 30, dim3 = 8;
+  Storage input(Storage::ColMajor, {dim1, dim2, dim3}, Storage::random);
+  Storage output(Storage::ColMajor, {dim1, dim2, dim3});
+
+  auto info = std::make_shared<FieldMetainfoImpl>(TypeID::Float64, input.dims());
+  info->metaInfo().insert(BlockStore::BlockStoreKey, true);
+  info->metaInfo().insert(BlockStore::BlockSizeKey, 4096);
+
+  auto infoChunked = std::make_shared<FieldMetainfoImpl>(*info);
+  infoChunked->metaInfo().insert(ChunkLayout::ChunkShapeKey, Array<int>{20, 15, 8});
+
+  const std::uint64_t size = dim1 * dim2 * dim3 * sizeof(double);
+
+  {
+    BinaryArchive archiveWrite(OpenModeKind::Write, directory->path().string(), "field");
+    auto sv = input.toStorageView();
+    archiveWrite.write(sv, "u", info);
+    archiveWrite.write(sv, "v", info);
+    archiveWrite.write(sv, "w", infoChunked);
+
+    // The identical field `v` does not add any blocks
+    BlockStore::Statistics statistics = archiveWrite.blockStoreStatistics();
+    EXPECT_EQ(statistics.referencedBytes, 3 * size);
+    EXPECT_LT(statistics.storedBytes, 3 * size);
+    EXPECT_GT(statistics.ratio(), 1.0);
+
+    // Combining the store with compression is not supported
+    auto infoCompressed = std::make_shared<FieldMetainfoImpl>(*info);
+    infoCompressed->metaInfo().insert(CodecPipeline::CodecKey, std::string(LZCodec::Name));
+    ASSERT_THROW(archiveWrite.write(sv, "x", infoCompressed), Exception);
+  }
+
+  // Archives of the same directory share the store
+  {
+    BinaryArchive archiveWrite(OpenModeKind::Write, directory->path().string(), "other");
+    auto sv = input.toStorageView();
+    archiveWrite.write(sv, "u", info);
+    EXPECT_EQ(archiveWrite.blockStoreStatistics().storedBytes, 0);
+  }
+
+  EXPECT_FALSE(filesystem::exists(directory->path() / "field_u.dat"));
+  EXPECT_TRUE(filesystem::exists(directory->path() / BlockStore::DefaultDirectory));
+
+  BinaryArchive archiveRead(OpenModeKind::Read, directory->path().string(), "field");
+  EXPECT_EQ(archiveRead.fieldTable().at("u")[0].blocks.size(), (size + 4095) / 4096);
+  EXPECT_EQ(archiveRead.fieldTable().at("u")[0].blockStore, BlockStore::DefaultDirectory);
+
+  for(std::string field : {"u", "v", "w"}) {
+    output.forEach(Storage::random);
+    auto sv = output.toStorageView();
+    archiveRead.read(sv, FieldID{field, 0}, nullptr);
+    ASSERT_TRUE(Storage::verify(input, output)) << field;
+
+    output.forEach(Storage::random);
+    sv.setSlice(Slice(5, 30, 2)(10, 20)(3, 4));
+    archiveRead.read(sv, FieldID{field, 0}, nullptr);
+    for(int j = 10; j < 20; ++j)
+      for(int i = 5; i < 30; i += 2)
+        ASSERT_EQ(input(i, j, 3), output(i, j, 3)) << field;
+  }
+
+  BinaryArchive otherRead(OpenModeKind::Read, directory->path().string(), "other");
+  auto sv = output.toStorageView();
+  otherRead.read(sv, FieldID{"u", 0}, nullptr);
+  ASSERT_TRUE(Storage::verify(input, output));
+}
+
+TEST_F(BinaryArchiveUtilityTest, Prefetch) {
+  using Storage = Storage<double>;
+
+  int dim1 = 20, dim2 = 15, dim3 = 4;
+  Storage input(Storage::ColMajor, {dim1, dim2, dim3}, Storage::random);
+  Storage zero(Storage::ColMajor, {dim1, dim2, dim3}, [](int) { return 0.0; });
+  Storage output(Storage::ColMajor, {dim1, dim2, dim3});
+
+  auto info = std::make_shared<FieldMetainfoImpl>(TypeID::Float64, input.dims());
+
+  auto infoDelta = std::make_shared<FieldMetainfoImpl>(*info);
+  infoDelta->metaInfo().insert(CodecPipeline::DeltaKey, true);
+
+  auto infoBlocks = std::make_shared<FieldMetainfoImpl>(*info);
+  infoBlocks->metaInfo().insert(BlockStore::BlockStoreKey, true);
+
+  {
+    BinaryArchive archiveWrite(OpenModeKind::Write, directory->path().string(), "field");
+    auto sv = input.toStorageView();
+    auto svZero = zero.toStorageView();
+    archiveWrite.write(sv, "u", info);
+    archiveWrite.write(svZero, "u", info);
+    archiveWrite.write(svZero, "v", infoDelta);
+    archiveWrite.write(sv, "v", infoDelta);
+    archiveWrite.write(sv, "w", infoBlocks);
+  }
+
+  // Prefetching is only a hint, the data is read as usual
+  BinaryArchive archiveRead(OpenModeKind::Read, directory->path().string(), "field");
+  for(FieldID fieldID : {FieldID{"u", 0}, FieldID{"u", 1}, FieldID{"v", 1}, FieldID{"w", 0}}) {
+    archiveRead.prefetch(fieldID, info);
+    archiveRead.prefetch(fieldID, nullptr);
+
+    auto sv = output.toStorageView();
+    archiveRead.read(sv, fieldID, info);
+    ASSERT_TRUE(Storage::verify(fieldID.id == 1 && fieldID.name == "u" ? zero : input, output))
+        << fieldID.name << " " << fieldID.id;
+  }
+
+  EXPECT_THROW(archiveRead.prefetch(FieldID{"u", 2}, nullptr), Exception);
+  EXPECT_THROW(archiveRead.prefetch(FieldID{"x", 0}, nullptr), Exception);
+}
+
+TEST_F(BinaryArchiveUtilityTest, ReadBatch) {
+  using Storage = Storage<double>;
+
+  int dim1 = 20, dim2 = 15, dim3 = 4;
+  Storage input(Storage::ColMajor, {dim1, dim2, dim3}, Storage::random);
+  Storage zero(Storage::ColMajor, {dim1, dim2, dim3}, [](int) { return 0.0; });
+
+  auto info = std::make_shared<FieldMetainfoImpl>(TypeID::Float64, input.dims());
+
+  auto infoDelta = std::make_shared<FieldMetainfoImpl>(*info);
+  infoDelta->metaInfo().insert(CodecPipeline::DeltaKey, true);
+
+  auto infoBlocks = std::make_shared<FieldMetainfoImpl>(*info);
+  infoBlocks->metaInfo().insert(BlockStore::BlockStoreKey, true);
+
+  const int numIds = 16;
+  std::vector<Storage> inputs;
+  {
+    BinaryArchive archiveWrite(OpenModeKind::Write, directory->path().string(), "field");
+    for(int id = 0; id < numIds; ++id) {
+      inputs.emplace_back(Storage::ColMajor, input.dims(), Storage::random);
+      archiveWrite.write(inputs.back().toStorageView(), "u", info);
+    }
+    archiveWrite.write(zero.toStorageView(), "u", info);
+    archiveWrite.write(zero.toStorageView(), "v", infoDelta);
+    archiveWrite.write(input.toStorageView(), "v", infoDelta);
+    archiveWrite.write(input.toStorageView(), "w", infoBlocks);
+  }
+
+  BinaryArchive archiveRead(OpenModeKind::Read, directory->path().string(), "field");
+  EXPECT_FALSE(archiveRead.asyncIOName().empty());
+
+  // Plain entries (full and sliced) mixed with uniform, delta-encoded and block store entries
+  std::vector<Storage> outputs;
+  for(int i = 0; i < numIds + 4; ++i)
+    outputs.emplace_back(Storage::ColMajor, input.dims(), [](int) { return -1.0; });
+
+  std::vector<Archive::ReadRequest> requests;
+  for(int id = 0; id < numIds; ++id) {
+    auto sv = outputs[id].toStorageView();
+    if(id % 2)
+      sv.setSlice(Slice(2, 18, 3)()(1, 3));
+    requests.push_back(Archive::ReadRequest{sv, FieldID{"u", unsigned(id)}, info});
+  }
+  requests.push_back(Archive::ReadRequest{outputs[numIds].toStorageView(),
+                                          FieldID{"u", unsigned(numIds)}, info});
+  requests.push_back(
+      Archive::ReadRequest{outputs[numIds + 1].toStorageView(), FieldID{"v", 1}, infoDelta});
+  requests.push_back(
+      Archive::ReadRequest{outputs[numIds + 2].toStorageView(), FieldID{"w", 0}, infoBlocks});
+  requests.push_back(Archive::ReadRequest{outputs[numIds + 3].toStorageView(), FieldID{"u", 3},
+                                          nullptr});
+
+  archiveRead.readBatch(requests);
+
+  for(int id = 0; id < numIds; id += 2)
+    ASSERT_TRUE(Storage::verify(inputs[id], outputs[id])) << id;
+  for(int id = 1; id < numIds; id += 2)
+    for(int k = 0; k < dim3; ++k)
+      for(int j = 0; j < dim2; ++j)
+        for(int i = 0; i < dim1; ++i) {
+          bool inSlice = i >= 2 && i < 18 && (i - 2) % 3 == 0 && k >= 1 && k < 3;
+          ASSERT_EQ(outputs[id](i, j, k), inSlice ? inputs[id](i, j, k) : -1.0) << id;
+        }
+  ASSERT_TRUE(Storage::verify(zero, outputs[numIds]));
+  ASSERT_TRUE(Storage::verify(input, outputs[numIds + 1]));
+  ASSERT_TRUE(Storage::verify(input, outputs[numIds + 2]));
+  ASSERT_TRUE(Storage::verify(inputs[3], outputs[numIds + 3]));
+
+  // Invalid entries
+  std::vector<Archive::ReadRequest> invalid{
+      Archive::ReadRequest{outputs[0].toStorageView(), FieldID{"u", 0}, info},
+      Archive::ReadRequest{outputs[1].toStorageView(), FieldID{"x", 0}, info}};
+  EXPECT_THROW(archiveRead.readBatch(invalid), Exception);
+
+  invalid[1].fieldID = FieldID{"u", unsigned(numIds + 1)};
+  EXPECT_THROW(archiveRead.readBatch(invalid), Exception);
+}
+
 //===------------------------------------------------------------------------------------------===//
 //     Read/Write tests
 //===------------------------------------------------------------------------------------------===//
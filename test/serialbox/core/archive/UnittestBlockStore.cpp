@@ -0,0 +1,179 @@
+//===-- serialbox/core/archive/UnittestBlockStore.cpp -------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the unittests for the content-addressed block store.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "utility/SerializerTestBase.h"
+#include "serialbox/core/Exception.h"
+#include "serialbox/core/archive/BlockStore.h"
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+
+using namespace serialbox;
+using namespace unittest;
+
+namespace {
+
+class BlockStoreTest : public SerializerUnittestBase {};
+
+std::vector<Byte> randomBytes(std::size_t size, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<Byte> data(size);
+  for(Byte& byte : data)
+    byte = static_cast<Byte>(dist(gen));
+  return data;
+}
+
+std::size_t sum(const std::vector<std::size_t>& sizes) {
+  return std::accumulate(sizes.begin(), sizes.end(), std::size_t(0));
+}
+
+} // anonymous namespace
+
+TEST_F(BlockStoreTest, Digest) {
+  std::vector<Byte> data = randomBytes(1000, 0);
+
+  std::string digest = BlockStore::digest(data.data(), data.size());
+  EXPECT_EQ(digest.size(), 32);
+  EXPECT_EQ(digest, BlockStore::digest(data.data(), data.size()));
+  EXPECT_NE(digest, BlockStore::digest(data.data(), data.size() - 1));
+
+  data[500] ^= 1;
+  EXPECT_NE(digest, BlockStore::digest(data.data(), data.size()));
+}
+
+TEST_F(BlockStoreTest, Split) {
+  std::vector<Byte> data = randomBytes(10000, 1);
+
+  auto fixed = BlockStore::split(data.data(), data.size(), ChunkingKind::Fixed, 4096);
+  EXPECT_EQ(fixed, (std::vector<std::size_t>{4096, 4096, 1808}));
+
+  auto content = BlockStore::split(data.data(), data.size(), ChunkingKind::ContentDefined, 1024);
+  EXPECT_EQ(sum(content), data.size());
+  for(std::size_t i = 0; i + 1 < content.size(); ++i) {
+    EXPECT_GE(content[i], 1024 / 4);
+    EXPECT_LE(content[i], 1024 * 4);
+  }
+
+  EXPECT_TRUE(BlockStore::split(data.data(), 0, ChunkingKind::Fixed, 1024).empty());
+}
+
+TEST_F(BlockStoreTest, PutAndGet) {
+  BlockStore store((directory->path() / "blocks").string());
+  EXPECT_TRUE(filesystem::exists(directory->path() / "blocks"));
+
+  std::vector<Byte> data = randomBytes(10000, 2);
+  auto blocks = store.put(data.data(), data.size(), ChunkingKind::Fixed, 4096);
+  ASSERT_EQ(blocks.size(), 3);
+
+  for(const BlockReference& block : blocks)
+    EXPECT_TRUE(store.contains(block.digest));
+
+  // Read the blocks back (full and partial)
+  std::vector<Byte> output(data.size());
+  std::uint64_t offset = 0;
+  for(const BlockReference& block : blocks) {
+    store.get(block, 0, block.size, output.data() + offset);
+    offset += block.size;
+  }
+  EXPECT_EQ(data, output);
+
+  std::vector<Byte> part(100);
+  store.get(blocks[1], 10, part.size(), part.data());
+  EXPECT_TRUE(std::equal(part.begin(), part.end(), data.begin() + 4096 + 10));
+
+  EXPECT_THROW(store.get(blocks[2], 0, blocks[2].size + 1, output.data()), Exception);
+  EXPECT_THROW(store.get(BlockReference{std::string(32, '0'), 1}, 0, 1, output.data()),
+               Exception);
+  // Truncated blocks are detected
+  const std::string& digest = blocks[0].digest;
+  filesystem::resize_file(directory->path() / "blocks" / digest.substr(0, 2) / digest, 100);
+  EXPECT_THROW(store.get(blocks[0], 0, 10, output.data()), Exception);
+}
+
+TEST_F(BlockStoreTest, Statistics) {
+  std::vector<Byte> data = randomBytes(8192, 3);
+
+  {
+    BlockStore store((directory->path() / "blocks").string());
+    store.put(data.data(), data.size(), ChunkingKind::Fixed, 4096);
+    store.put(data.data(), data.size(), ChunkingKind::Fixed, 4096);
+
+    BlockStore::Statistics statistics = store.statistics();
+    EXPECT_EQ(statistics.referencedBlocks, 4);
+    EXPECT_EQ(statistics.referencedBytes, 2 * data.size());
+    EXPECT_EQ(statistics.storedBlocks, 2);
+    EXPECT_EQ(statistics.storedBytes, data.size());
+    EXPECT_DOUBLE_EQ(statistics.ratio(), 2.0);
+  }
+
+  // Blocks written by another store object (e.g another process) are not stored again
+  {
+    BlockStore store((directory->path() / "blocks").string());
+    store.put(data.data(), data.size(), ChunkingKind::Fixed, 4096);
+
+    BlockStore::Statistics statistics = store.statistics();
+    EXPECT_EQ(statistics.referencedBlocks, 2);
+    EXPECT_EQ(statistics.storedBlocks, 0);
+  }
+}
+
+TEST_F(BlockStoreTest, ContentDefinedChunking) {
+  std::vector<Byte> data = randomBytes(1 << 16, 4);
+
+  // Prepend a few bytes, all but the first blocks are identical
+  std::vector<Byte> shifted = randomBytes(37, 5);
+  shifted.insert(shifted.end(), data.begin(), data.end());
+
+  BlockStore store((directory->path() / "blocks").string());
+  store.put(data.data(), data.size(), ChunkingKind::ContentDefined, 2048);
+  BlockStore::Statistics first = store.statistics();
+
+  store.put(shifted.data(), shifted.size(), ChunkingKind::ContentDefined, 2048);
+  BlockStore::Statistics second = store.statistics();
+  EXPECT_LT(second.storedBytes - first.storedBytes, data.size() / 4);
+
+  // Fixed-size blocks do not survive the shift
+  BlockStore fixedStore((directory->path() / "fixed").string());
+  fixedStore.put(data.data(), data.size(), ChunkingKind::Fixed, 2048);
+  fixedStore.put(shifted.data(), shifted.size(), ChunkingKind::Fixed, 2048);
+  EXPECT_LT(fixedStore.statistics().ratio(), 1.1);
+}
+
+TEST_F(BlockStoreTest, Configuration) {
+  EXPECT_FALSE(BlockStore::configuration(nullptr).isEnabled());
+
+  FieldMetainfoImpl info(TypeID::Float64, {10});
+  EXPECT_FALSE(BlockStore::configuration(&info).isEnabled());
+
+  info.metaInfo().insert(BlockStore::BlockStoreKey, true);
+  auto config = BlockStore::configuration(&info);
+  EXPECT_EQ(config.directory, BlockStore::DefaultDirectory);
+  EXPECT_EQ(config.chunking, ChunkingKind::Fixed);
+  EXPECT_EQ(config.blockSize, BlockStore::DefaultBlockSize);
+
+  FieldMetainfoImpl custom(TypeID::Float64, {10});
+  custom.metaInfo().insert(BlockStore::BlockStoreKey, std::string("../shared"));
+  custom.metaInfo().insert(BlockStore::ChunkingKey, std::string("content"));
+  custom.metaInfo().insert(BlockStore::BlockSizeKey, 1024);
+  config = BlockStore::configuration(&custom);
+  EXPECT_EQ(config.directory, "../shared");
+  EXPECT_EQ(config.chunking, ChunkingKind::ContentDefined);
+  EXPECT_EQ(config.blockSize, 1024);
+
+  FieldMetainfoImpl invalid(TypeID::Float64, {10});
+  invalid.metaInfo().insert(BlockStore::BlockStoreKey, true);
+  invalid.metaInfo().insert(BlockStore::ChunkingKey, std::string("rabin"));
+  EXPECT_THROW(BlockStore::configuration(&invalid), Exception);
+}
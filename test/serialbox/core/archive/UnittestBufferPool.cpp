@@ -0,0 +1,129 @@
+//===-- serialbox/core/archive/UnittestBufferPool.cpp -------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the unittests for the pool of staging buffers.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/archive/BufferPool.h"
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+
+using namespace serialbox;
+
+TEST(BufferPoolTest, AcquireAndRelease) {
+  BufferPool pool;
+  EXPECT_EQ(pool.cachedBytes(), 0);
+
+  // Empty buffer
+  {
+    auto buffer = pool.acquire(0);
+    EXPECT_EQ(buffer.size(), 0);
+    EXPECT_EQ(buffer.data(), nullptr);
+  }
+  EXPECT_EQ(pool.cachedBytes(), 0);
+
+  // Buffer is returned to the pool and reused by smaller requests
+  Byte* data = nullptr;
+  std::size_t capacity = 0;
+  {
+    auto buffer = pool.acquire(1000);
+    EXPECT_EQ(buffer.size(), 1000);
+    EXPECT_GE(buffer.capacity(), 1000);
+    std::memset(buffer.data(), 1, buffer.size());
+    data = buffer.data();
+    capacity = buffer.capacity();
+  }
+  EXPECT_EQ(pool.cachedBytes(), capacity);
+
+  {
+    auto buffer = pool.acquire(500);
+    EXPECT_EQ(buffer.data(), data);
+    EXPECT_EQ(buffer.size(), 500);
+    EXPECT_EQ(pool.cachedBytes(), 0);
+
+    // Moving transfers ownership
+    BufferPool::Buffer other(std::move(buffer));
+    EXPECT_EQ(buffer.data(), nullptr);
+    EXPECT_EQ(other.data(), data);
+  }
+  EXPECT_EQ(pool.cachedBytes(), capacity);
+
+  // Larger requests require a new allocation
+  {
+    auto buffer = pool.acquire(capacity + 1);
+    EXPECT_NE(buffer.data(), data);
+    EXPECT_EQ(pool.cachedBytes(), capacity);
+  }
+
+  // Much smaller requests do not pin the large buffer
+  pool.trim();
+  { auto buffer = pool.acquire(1000); }
+  {
+    auto buffer = pool.acquire(100);
+    EXPECT_EQ(pool.cachedBytes(), capacity);
+  }
+
+  pool.trim();
+  EXPECT_EQ(pool.cachedBytes(), 0);
+}
+
+TEST(BufferPoolTest, HighWaterMark) {
+  BufferPool pool(4096);
+  EXPECT_EQ(pool.highWaterMark(), 4096);
+
+  // The most recent buffer is kept even if it exceeds the high-water mark
+  Byte* data = nullptr;
+  {
+    auto buffer = pool.acquire(8192);
+    data = buffer.data();
+  }
+  EXPECT_EQ(pool.cachedBytes(), 8192);
+  {
+    auto buffer = pool.acquire(8192);
+    EXPECT_EQ(buffer.data(), data);
+  }
+
+  // The pool is trimmed to the high-water mark
+  {
+    auto buffer1 = pool.acquire(2048);
+    auto buffer2 = pool.acquire(2048);
+    auto buffer3 = pool.acquire(2048);
+  }
+  EXPECT_LE(pool.cachedBytes(), 4096);
+  EXPECT_GT(pool.cachedBytes(), 0);
+
+  pool.setHighWaterMark(0);
+  EXPECT_EQ(pool.cachedBytes(), 0);
+
+  { auto buffer = pool.acquire(16); }
+  EXPECT_EQ(pool.cachedBytes(), 0);
+}
+
+TEST(BufferPoolTest, HugePages) {
+  BufferPool pool;
+  EXPECT_TRUE(pool.useHugePages());
+
+  {
+    auto buffer = pool.acquire(BufferPool::HugePageThreshold);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer.data()) % (2 << 20), 0);
+    std::memset(buffer.data(), 0, buffer.size());
+  }
+
+  pool.setUseHugePages(false);
+  EXPECT_FALSE(pool.useHugePages());
+  pool.trim();
+
+  {
+    auto buffer = pool.acquire(BufferPool::HugePageThreshold);
+    std::memset(buffer.data(), 0, buffer.size());
+  }
+}
@@ -0,0 +1,81 @@
+//===-- serialbox/core/archive/UnittestChunkLayout.cpp ------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the unittests for the chunked storage layout.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/Exception.h"
+#include "serialbox/core/archive/ChunkLayout.h"
+#include <gtest/gtest.h>
+#include <numeric>
+
+using namespace serialbox;
+
+TEST(ChunkLayoutTest, Construction) {
+  ChunkLayout layout({10, 6, 3}, {4, 6, 8}, sizeof(double));
+
+  // Chunk shape is clamped to the dimensions
+  EXPECT_EQ(layout.shape(), (std::vector<int>{4, 6, 3}));
+  ASSERT_EQ(layout.numChunks(), 3);
+
+  // The last chunk of the first dimension is truncated
+  EXPECT_EQ(layout.chunkSize(0), 4 * 6 * 3 * sizeof(double));
+  EXPECT_EQ(layout.chunkSize(2), 2 * 6 * 3 * sizeof(double));
+  EXPECT_EQ(layout.chunkOffset(1), layout.chunkSize(0));
+  EXPECT_EQ(layout.size(), 10 * 6 * 3 * sizeof(double));
+
+  ChunkIndex index = layout.index();
+  EXPECT_TRUE(index.isChunked());
+  EXPECT_EQ(index.offsets.size(), 3);
+
+  EXPECT_THROW(ChunkLayout({10, 6}, {4}, 8), Exception);
+  EXPECT_THROW(ChunkLayout({10, 6}, {4, 0}, 8), Exception);
+  EXPECT_THROW(ChunkLayout({10, 0}, {4, 4}, 8), Exception);
+}
+
+TEST(ChunkLayoutTest, Reorder) {
+  std::vector<int> dims{7, 5, 3};
+  ChunkLayout layout(dims, {3, 2, 2}, sizeof(int));
+  EXPECT_EQ(layout.numChunks(), 3 * 3 * 2);
+
+  std::vector<int> data(7 * 5 * 3), chunked(data.size()), output(data.size());
+  std::iota(data.begin(), data.end(), 0);
+
+  layout.toChunks(reinterpret_cast<const Byte*>(data.data()),
+                  reinterpret_cast<Byte*>(chunked.data()));
+
+  // The first chunk holds the elements [0, 3) x [0, 2) x [0, 2)
+  EXPECT_EQ(chunked[0], 0);
+  EXPECT_EQ(chunked[2], 2);
+  EXPECT_EQ(chunked[3], 7);
+  EXPECT_EQ(chunked[6], 35);
+
+  layout.fromChunks(reinterpret_cast<const Byte*>(chunked.data()),
+                    reinterpret_cast<Byte*>(output.data()));
+  EXPECT_EQ(output, data);
+
+  // Copy the box [2, 6) x [1, 4) x [1, 2) from the intersecting chunks
+  std::vector<int> lower{2, 1, 1}, upper{6, 4, 2};
+  std::vector<std::size_t> chunks = layout.intersectingChunks(lower, upper);
+  EXPECT_EQ(chunks, (std::vector<std::size_t>{0, 1, 3, 4}));
+
+  std::vector<int> box(4 * 3 * 1, -1);
+  for(std::size_t chunk : chunks)
+    layout.copyChunkToBox(chunk, reinterpret_cast<const Byte*>(chunked.data()) +
+                                     layout.chunkOffset(chunk),
+                          lower, upper, reinterpret_cast<Byte*>(box.data()));
+
+  for(int j = 0; j < 3; ++j)
+    for(int i = 0; i < 4; ++i)
+      EXPECT_EQ(box[i + 4 * j], (i + 2) + 7 * (j + 1) + 35);
+
+  EXPECT_TRUE(layout.intersectingChunks({2, 2, 2}, {2, 3, 3}).empty());
+}
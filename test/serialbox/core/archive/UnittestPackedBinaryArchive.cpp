@@ -0,0 +1,399 @@
+//===-- serialbox/core/archive/UnittestPackedBinaryArchive.cpp ----------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the unittests for the Packed Binary Archive.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "utility/SerializerTestBase.h"
+#include "utility/Storage.h"
+#include "serialbox/core/SerializerImpl.h"
+#include "serialbox/core/archive/PackedBinaryArchive.h"
+#include <fstream>
+#include <gtest/gtest.h>
+
+using namespace serialbox;
+using namespace unittest;
+
+//===------------------------------------------------------------------------------------------===//
+//     Utility tests
+//===------------------------------------------------------------------------------------------===//
+
+namespace {
+
+class PackedBinaryArchiveUtilityTest : public SerializerUnittestBase {};
+
+/// Return the offset of the index of the container (stored in the first 8 bytes of the trailer)
+std::uint64_t indexOffset(const filesystem::path& container) {
+  std::ifstream fs(container.string(), std::ios::binary);
+  fs.seekg(-24, std::ios::end);
+  std::uint64_t offset = 0;
+  fs.read(reinterpret_cast<char*>(&offset), sizeof(offset));
+  return offset;
+}
+
+} // anonymous namespace
+
+TEST_F(PackedBinaryArchiveUtilityTest, Construction) {
+  // Open fresh archive, a single container is created
+  {
+    PackedBinaryArchive b(OpenModeKind::Write, directory->path().string(), "field");
+    b.updateMetaData();
+
+    EXPECT_EQ(b.name(), "PackedBinary");
+    EXPECT_EQ(b.mode(), OpenModeKind::Write);
+    EXPECT_EQ(b.prefix(), "field");
+    EXPECT_TRUE(filesystem::exists(directory->path() / "field.pack"));
+  }
+
+  // Create directory if not already existent
+  {
+    PackedBinaryArchive b(OpenModeKind::Write,
+                          (directory->path() / "this-dir-is-created").string(), "field");
+    EXPECT_TRUE(filesystem::exists(directory->path() / "this-dir-is-created"));
+  }
+
+  // Read empty archive
+  {
+    PackedBinaryArchive b(OpenModeKind::Read, directory->path().string(), "field");
+    EXPECT_TRUE(b.fieldTable().empty());
+    EXPECT_FALSE(b.isRecovered());
+  }
+
+  // Throw Exception: Directory or container does not exist
+  EXPECT_THROW(PackedBinaryArchive(OpenModeKind::Read,
+                                   (directory->path() / "not-a-dir").string(), "field"),
+               Exception);
+  EXPECT_THROW(PackedBinaryArchive(OpenModeKind::Read, directory->path().string(), "not-a-prefix"),
+               Exception);
+
+  // Throw Exception: Not a container
+  {
+    std::ofstream fs((directory->path() / "garbage.pack").string());
+    fs << "this is not a container";
+  }
+  EXPECT_THROW(PackedBinaryArchive(OpenModeKind::Read, directory->path().string(), "garbage"),
+               Exception);
+
+  // Appending to non-existing container
+  EXPECT_NO_THROW(PackedBinaryArchive(OpenModeKind::Append, directory->path().string(), "new"));
+}
+
+TEST_F(PackedBinaryArchiveUtilityTest, AppendAndDeduplicate) {
+  using Storage = Storage<double>;
+  Storage u_0(Storage::ColMajor, {5, 6, 7}, Storage::random);
+  Storage u_1(Storage::ColMajor, {5, 6, 7}, Storage::random);
+  Storage v_0(Storage::RowMajor, {3}, Storage::random);
+
+  {
+    PackedBinaryArchive archive(OpenModeKind::Write, directory->path().string(), "field");
+    auto sv_u_0 = u_0.toStorageView();
+    EXPECT_EQ(archive.write(sv_u_0, "u", nullptr).id, 0);
+    EXPECT_EQ(archive.write(sv_u_0, "u", nullptr).id, 0);
+  }
+
+  {
+    PackedBinaryArchive archive(OpenModeKind::Append, directory->path().string(), "field");
+    ASSERT_EQ(archive.fieldTable().at("u").size(), 1);
+
+    auto sv_u_0 = u_0.toStorageView();
+    auto sv_u_1 = u_1.toStorageView();
+    auto sv_v_0 = v_0.toStorageView();
+    EXPECT_EQ(archive.write(sv_u_1, "u", nullptr).id, 1);
+    EXPECT_EQ(archive.write(sv_u_0, "u", nullptr).id, 0);
+    EXPECT_EQ(archive.write(sv_v_0, "v", nullptr).id, 0);
+
+    // Explicitly writing the index and continue writing afterwards
+    archive.writeIndex();
+    EXPECT_EQ(archive.write(sv_u_1, "v", nullptr).id, 1);
+  }
+
+  {
+    PackedBinaryArchive archive(OpenModeKind::Read, directory->path().string(), "field");
+    EXPECT_FALSE(archive.isRecovered());
+    ASSERT_EQ(archive.fieldTable().at("u").size(), 2);
+    ASSERT_EQ(archive.fieldTable().at("v").size(), 2);
+
+    // Data blocks are aligned
+    for(const auto& fieldPair : archive.fieldTable())
+      for(const auto& entry : fieldPair.second)
+        EXPECT_EQ(entry.offset % PackedBinaryArchive::Alignment, 0);
+
+    Storage u_0_output(Storage::ColMajor, {5, 6, 7});
+    Storage u_1_output(Storage::ColMajor, {5, 6, 7});
+    Storage v_0_output(Storage::RowMajor, {3});
+    Storage v_1_output(Storage::ColMajor, {5, 6, 7});
+
+    auto sv_u_0 = u_0_output.toStorageView();
+    auto sv_u_1 = u_1_output.toStorageView();
+    auto sv_v_0 = v_0_output.toStorageView();
+    auto sv_v_1 = v_1_output.toStorageView();
+    archive.read(sv_u_0, FieldID{"u", 0}, nullptr);
+    archive.read(sv_u_1, FieldID{"u", 1}, nullptr);
+    archive.read(sv_v_0, FieldID{"v", 0}, nullptr);
+    archive.read(sv_v_1, FieldID{"v", 1}, nullptr);
+
+    ASSERT_TRUE(Storage::verify(u_0_output, u_0));
+    ASSERT_TRUE(Storage::verify(u_1_output, u_1));
+    ASSERT_TRUE(Storage::verify(v_0_output, v_0));
+    ASSERT_TRUE(Storage::verify(v_1_output, u_1));
+
+    // Invalid field or id
+    ASSERT_THROW(archive.read(sv_u_0, FieldID{"X", 0}, nullptr), Exception);
+    ASSERT_THROW(archive.read(sv_u_0, FieldID{"u", 2}, nullptr), Exception);
+
+    // Storage larger than the stored data
+    ASSERT_THROW(archive.read(sv_u_0, FieldID{"v", 0}, nullptr), Exception);
+  }
+}
+
+TEST_F(PackedBinaryArchiveUtilityTest, Recovery) {
+  using Storage = Storage<float>;
+  Storage u_0(Storage::ColMajor, {10, 12}, Storage::random);
+  Storage u_1(Storage::ColMajor, {10, 12}, Storage::random);
+  Storage v_0(Storage::ColMajor, {4, 3, 2}, Storage::random);
+
+  filesystem::path container = directory->path() / "field.pack";
+
+  {
+    PackedBinaryArchive archive(OpenModeKind::Write, directory->path().string(), "field");
+    auto sv_u_0 = u_0.toStorageView();
+    auto sv_u_1 = u_1.toStorageView();
+    auto sv_v_0 = v_0.toStorageView();
+    archive.write(sv_u_0, "u", nullptr);
+    archive.write(sv_v_0, "v", nullptr);
+    archive.write(sv_u_1, "u", nullptr);
+  }
+
+  // Simulate a crash by removing the index and the tail of the last block (the data of u_1 spans
+  // 480 bytes and is padded to 512)
+  std::uint64_t endOfData = indexOffset(container);
+  filesystem::resize_file(container, endOfData - 2 * PackedBinaryArchive::Alignment);
+
+  {
+    PackedBinaryArchive archive(OpenModeKind::Read, directory->path().string(), "field");
+    EXPECT_TRUE(archive.isRecovered());
+    ASSERT_EQ(archive.fieldTable().at("u").size(), 1);
+    ASSERT_EQ(archive.fieldTable().at("v").size(), 1);
+
+    Storage u_0_output(Storage::ColMajor, {10, 12});
+    auto sv = u_0_output.toStorageView();
+    archive.read(sv, FieldID{"u", 0}, nullptr);
+    ASSERT_TRUE(Storage::verify(u_0_output, u_0));
+  }
+
+  // Appending to a recovered container drops the incomplete block and writes a new index on close
+  {
+    PackedBinaryArchive archive(OpenModeKind::Append, directory->path().string(), "field");
+    EXPECT_TRUE(archive.isRecovered());
+    auto sv_u_1 = u_1.toStorageView();
+    EXPECT_EQ(archive.write(sv_u_1, "u", nullptr).id, 1);
+  }
+
+  {
+    PackedBinaryArchive archive(OpenModeKind::Read, directory->path().string(), "field");
+    EXPECT_FALSE(archive.isRecovered());
+
+    Storage u_1_output(Storage::ColMajor, {10, 12});
+    auto sv = u_1_output.toStorageView();
+    archive.read(sv, FieldID{"u", 1}, nullptr);
+    ASSERT_TRUE(Storage::verify(u_1_output, u_1));
+  }
+}
+
+TEST_F(PackedBinaryArchiveUtilityTest, SliceWriteAndRead) {
+  using Storage = Storage<double>;
+
+  int dim1 = 5, dim2 = 10, dim3 = 15;
+  Storage storage_3d_input(Storage::ColMajor, {dim1, dim2, dim3}, {{3, 3}, {3, 3}, {3, 3}},
+                           Storage::sequential);
+  Storage storage_3d_output(Storage::ColMajor, {dim1, dim2, dim3}, {{3, 3}, {3, 3}, {3, 3}},
+                            Storage::random);
+
+  {
+    PackedBinaryArchive archiveWrite(OpenModeKind::Write, directory->path().string(), "field");
+    auto sv_3d = storage_3d_input.toStorageView();
+    archiveWrite.write(sv_3d, "3d", nullptr);
+  }
+
+  PackedBinaryArchive archiveRead(OpenModeKind::Read, directory->path().string(), "field");
+  auto sv_3d = storage_3d_output.toStorageView();
+  sv_3d.setSlice(Slice(1, 3)(0, -1, 2)(4, 11, 3));
+  archiveRead.read(sv_3d, FieldID{"3d", 0}, nullptr);
+
+  for(int i = 1; i < 3; ++i)
+    for(int j = 0; j < dim2; j += 2)
+      for(int k = 4; k < 11; k += 3)
+        ASSERT_EQ(storage_3d_output(i, j, k), storage_3d_input(i, j, k));
+}
+
+TEST_F(PackedBinaryArchiveUtilityTest, SavepointGroups) {
+  using Storage = Storage<double>;
+  Storage u_0(Storage::ColMajor, {5, 6, 7}, Storage::random);
+  Storage u_1(Storage::ColMajor, {5, 6, 7}, Storage::random);
+  Storage v_0(Storage::RowMajor, {3, 4}, Storage::random);
+  Storage w_0(Storage::RowMajor, {8}, Storage::random);
+
+  SavepointImpl sp0("sp"), sp1("sp");
+  sp0.addMetainfo("step", 0);
+  sp1.addMetainfo("step", 1);
+
+  {
+    PackedBinaryArchive archive(OpenModeKind::Write, directory->path().string(), "field");
+    auto sv_u_0 = u_0.toStorageView();
+    auto sv_u_1 = u_1.toStorageView();
+    auto sv_v_0 = v_0.toStorageView();
+    auto sv_w_0 = w_0.toStorageView();
+
+    EXPECT_EQ(archive.write(sv_u_0, "u", nullptr, sp0).id, 0);
+    EXPECT_EQ(archive.write(sv_v_0, "v", nullptr, sp0).id, 0);
+    EXPECT_EQ(archive.write(sv_u_1, "u", nullptr, sp1).id, 1);
+    EXPECT_EQ(archive.write(sv_v_0, "v", nullptr, sp1).id, 0); // Deduplicated
+    EXPECT_EQ(archive.write(sv_w_0, "w", nullptr, sp1).id, 0);
+    EXPECT_EQ(archive.groupTable().size(), 2);
+  }
+
+  PackedBinaryArchive archive(OpenModeKind::Read, directory->path().string(), "field");
+  const auto& fieldTable = archive.fieldTable();
+  const auto& groupTable = archive.groupTable();
+  ASSERT_EQ(groupTable.size(), 2);
+
+  // Deduplicated fields refer to the group of the earlier savepoint
+  EXPECT_EQ(fieldTable.at("u")[0].group, 0);
+  EXPECT_EQ(fieldTable.at("v")[0].group, 0);
+  EXPECT_EQ(fieldTable.at("u")[1].group, 1);
+  EXPECT_EQ(fieldTable.at("w")[0].group, 1);
+
+  // Groups are contiguous and contain all their blocks
+  EXPECT_LE(groupTable[0].offset + groupTable[0].length, groupTable[1].offset);
+  for(const auto& fieldPair : fieldTable)
+    for(const auto& entry : fieldPair.second) {
+      const auto& group = groupTable[entry.group];
+      EXPECT_GE(entry.offset, group.offset);
+      EXPECT_LE(entry.offset + entry.length, group.offset + group.length);
+    }
+
+  // Read from the cached groups and with loading of groups disabled
+  for(std::size_t limit : {PackedBinaryArchive::DefaultSavepointCacheLimit, std::size_t(0)}) {
+    archive.setSavepointCacheLimit(limit);
+    EXPECT_EQ(archive.savepointCacheLimit(), limit);
+
+    Storage u_0_output(Storage::ColMajor, {5, 6, 7});
+    Storage u_1_output(Storage::ColMajor, {5, 6, 7});
+    Storage v_0_output(Storage::RowMajor, {3, 4});
+    Storage w_0_output(Storage::RowMajor, {8});
+
+    auto sv_u_0 = u_0_output.toStorageView();
+    auto sv_u_1 = u_1_output.toStorageView();
+    auto sv_v_0 = v_0_output.toStorageView();
+    auto sv_w_0 = w_0_output.toStorageView();
+    archive.read(sv_u_1, FieldID{"u", 1}, nullptr);
+    archive.read(sv_w_0, FieldID{"w", 0}, nullptr);
+    archive.read(sv_v_0, FieldID{"v", 0}, nullptr);
+    archive.read(sv_u_0, FieldID{"u", 0}, nullptr);
+
+    ASSERT_TRUE(Storage::verify(u_0_output, u_0));
+    ASSERT_TRUE(Storage::verify(u_1_output, u_1));
+    ASSERT_TRUE(Storage::verify(v_0_output, v_0));
+    ASSERT_TRUE(Storage::verify(w_0_output, w_0));
+
+    // Storage larger than the stored data
+    ASSERT_THROW(archive.read(sv_u_0, FieldID{"w", 0}, nullptr), Exception);
+  }
+
+  // Reads of earlier groups do not evict the group being replayed
+  PackedBinaryArchive replay(OpenModeKind::Read, directory->path().string(), "field");
+  EXPECT_EQ(replay.cachedGroup(), -1);
+
+  Storage u_output(Storage::ColMajor, {5, 6, 7});
+  Storage v_output(Storage::RowMajor, {3, 4});
+  auto sv_u = u_output.toStorageView();
+  auto sv_v = v_output.toStorageView();
+
+  sv_u.setSlice(Slice(0, 2)(0, 3)(1, 4));
+  replay.read(sv_u, FieldID{"u", 1}, nullptr);
+  EXPECT_EQ(replay.cachedGroup(), -1); // Slices do not load groups
+
+  sv_u.setSlice(Slice()()());
+  replay.read(sv_u, FieldID{"u", 1}, nullptr);
+  EXPECT_EQ(replay.cachedGroup(), 1);
+
+  replay.read(sv_v, FieldID{"v", 0}, nullptr);
+  EXPECT_EQ(replay.cachedGroup(), 1);
+  ASSERT_TRUE(Storage::verify(v_output, v_0));
+
+  replay.read(sv_u, FieldID{"u", 0}, nullptr);
+  EXPECT_EQ(replay.cachedGroup(), 1);
+  ASSERT_TRUE(Storage::verify(u_output, u_0));
+}
+
+TEST_F(PackedBinaryArchiveUtilityTest, ToAndFromFile) {
+  using Storage = Storage<double>;
+  Storage storage_input(Storage::ColMajor, {5, 2, 5}, Storage::random);
+  Storage storage_output(Storage::ColMajor, {5, 2, 5});
+
+  auto sv_input = storage_input.toStorageView();
+  auto sv_output = storage_output.toStorageView();
+
+  std::string filename = (directory->path() / "test.pack").string();
+  PackedBinaryArchive::writeToFile(filename, sv_input, "field");
+  PackedBinaryArchive::readFromFile(filename, sv_output, "field");
+  ASSERT_TRUE(Storage::verify(storage_input, storage_output));
+
+  ASSERT_THROW(PackedBinaryArchive::readFromFile(filename + "X", sv_output, "field"), Exception);
+}
+
+TEST_F(PackedBinaryArchiveUtilityTest, Serializer) {
+  using Storage = Storage<double>;
+  Storage u(Storage::ColMajor, {8, 9, 10}, Storage::random);
+  Storage u_output(Storage::ColMajor, {8, 9, 10});
+
+  {
+    SerializerImpl ser(OpenModeKind::Write, directory->path().string(), "Field", "PackedBinary");
+    auto sv = u.toStorageView();
+    ser.registerField("u", sv.type(), sv.dims());
+    ser.write("u", SavepointImpl("sp"), sv);
+  }
+
+  // Only the meta-data of the serializer and the container are created
+  int numFiles = 0;
+  for(filesystem::directory_iterator it(directory->path()), end; it != end; ++it)
+    ++numFiles;
+  EXPECT_EQ(numFiles, 2);
+
+  {
+    SerializerImpl ser(OpenModeKind::Read, directory->path().string(), "Field", "PackedBinary");
+    auto sv = u_output.toStorageView();
+    ser.read("u", SavepointImpl("sp"), sv);
+    ASSERT_TRUE(Storage::verify(u_output, u));
+  }
+}
+
+TEST_F(PackedBinaryArchiveUtilityTest, Prefetch) {
+  using Storage = Storage<double>;
+  Storage u(Storage::ColMajor, {8, 9, 10}, Storage::random);
+  Storage u_output(Storage::ColMajor, {8, 9, 10});
+
+  {
+    PackedBinaryArchive archive(OpenModeKind::Write, directory->path().string(), "field");
+    auto sv = u.toStorageView();
+    archive.write(sv, "u", nullptr);
+  }
+
+  PackedBinaryArchive archive(OpenModeKind::Read, directory->path().string(), "field");
+  archive.prefetch(FieldID{"u", 0}, nullptr);
+
+  auto sv = u_output.toStorageView();
+  archive.read(sv, FieldID{"u", 0}, nullptr);
+  ASSERT_TRUE(Storage::verify(u_output, u));
+
+  EXPECT_THROW(archive.prefetch(FieldID{"u", 1}, nullptr), Exception);
+  EXPECT_THROW(archive.prefetch(FieldID{"v", 0}, nullptr), Exception);
+}
@@ -0,0 +1,247 @@
+//===-- serialbox/core/compression/UnittestCodec.cpp --------------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the unittests of the compression codecs and the codec pipeline.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/Exception.h"
+#include "serialbox/core/compression/CodecFactory.h"
+#include "serialbox/core/compression/CodecPipeline.h"
+#include "serialbox/core/compression/LZCodec.h"
+#include <cmath>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace serialbox;
+
+namespace {
+
+/// Smooth floating point field (compresses well after shuffling)
+std::vector<Byte> smoothField(std::size_t numElements) {
+  std::vector<double> values(numElements);
+  for(std::size_t i = 0; i < numElements; ++i)
+    values[i] = 300.0 + std::sin(0.001 * i);
+
+  std::vector<Byte> data(numElements * sizeof(double));
+  std::memcpy(data.data(), values.data(), data.size());
+  return data;
+}
+
+std::vector<Byte> randomBytes(std::size_t size) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<Byte> data(size);
+  for(auto& byte : data)
+    byte = static_cast<Byte>(dist(gen));
+  return data;
+}
+
+} // anonymous namespace
+
+TEST(CodecTest, RoundTrip) {
+  std::vector<std::vector<Byte>> inputs{std::vector<Byte>(), std::vector<Byte>(3, 'x'),
+                                        std::vector<Byte>(100000, 0), smoothField(10000),
+                                        randomBytes(5000)};
+
+  for(const auto& name : CodecFactory::registeredCodecs()) {
+    auto codec = CodecFactory::create(name);
+    EXPECT_EQ(name, codec->name());
+
+    for(const auto& input : inputs) {
+      std::vector<Byte> compressed(codec->maxCompressedSize(input.size()));
+      std::size_t compressedSize =
+          codec->compress(input.data(), input.size(), compressed.data(), compressed.size());
+      ASSERT_LE(compressedSize, compressed.size());
+
+      std::vector<Byte> output(input.size());
+      codec->decompress(compressed.data(), compressedSize, output.data(), output.size());
+      ASSERT_EQ(input, output) << "codec: " << name << ", size: " << input.size();
+    }
+  }
+
+  ASSERT_THROW(CodecFactory::create("X"), Exception);
+}
+
+TEST(CodecTest, LZCorruptedInput) {
+  LZCodec codec;
+  auto input = smoothField(1000);
+  std::vector<Byte> compressed(codec.maxCompressedSize(input.size()));
+  std::size_t compressedSize =
+      codec.compress(input.data(), input.size(), compressed.data(), compressed.size());
+  EXPECT_LT(compressedSize, input.size());
+
+  std::vector<Byte> output(input.size());
+
+  // Truncated input
+  ASSERT_THROW(
+      codec.decompress(compressed.data(), compressedSize / 2, output.data(), output.size()),
+      Exception);
+
+  // Wrong expected size
+  ASSERT_THROW(
+      codec.decompress(compressed.data(), compressedSize, output.data(), output.size() - 1),
+      Exception);
+
+  // Insufficient capacity
+  ASSERT_THROW(codec.compress(input.data(), input.size(), compressed.data(), 10), Exception);
+}
+
+TEST(CodecPipelineTest, Shuffle) {
+  const Byte input[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
+  Byte shuffled[13], output[13];
+
+  CodecPipeline::shuffleBytes(input, shuffled, 13, 4);
+  const Byte expected[] = {1, 5, 9, 2, 6, 10, 3, 7, 11, 4, 8, 12, 13};
+  for(int i = 0; i < 13; ++i)
+    EXPECT_EQ(shuffled[i], expected[i]);
+
+  CodecPipeline::unshuffleBytes(shuffled, output, 13, 4);
+  for(int i = 0; i < 13; ++i)
+    EXPECT_EQ(output[i], input[i]);
+}
+
+TEST(CodecPipelineTest, EncodeAndDecode) {
+  BufferPool pool;
+  auto input = smoothField(100000);
+
+  for(int shuffle : {0, 8}) {
+    CodecPipeline pipeline(LZCodec::Name, shuffle, 10000);
+    EXPECT_EQ(pipeline.blockSize(), shuffle ? 10000 / 8 * 8 : 10000);
+
+    BufferPool::Buffer encoded;
+    CodecInfo info = pipeline.encode(input.data(), input.size(), pool, encoded);
+    EXPECT_EQ(info.size, input.size());
+    EXPECT_EQ(info.numBlocks(), (input.size() + pipeline.blockSize() - 1) / pipeline.blockSize());
+    EXPECT_LT(info.compressedSize(), input.size());
+
+    // Decode all blocks
+    std::vector<Byte> output(input.size());
+    auto decoder = CodecPipeline::create(info);
+    decoder->decode(encoded.data(), info, 0, info.numBlocks(), output.data(), pool);
+    ASSERT_EQ(input, output);
+
+    // Decode a range of blocks
+    std::vector<Byte> blocks(3 * info.blockSize);
+    decoder->decode(encoded.data() + info.compressedOffset(2), info, 2, 5, blocks.data(), pool);
+    ASSERT_EQ(0, std::memcmp(blocks.data(), input.data() + 2 * info.blockSize, blocks.size()));
+
+    ASSERT_THROW(
+        decoder->decode(encoded.data(), info, 0, info.numBlocks() + 1, output.data(), pool),
+        Exception);
+  }
+
+  // Incompressible blocks are stored as is
+  auto random = randomBytes(50000);
+  CodecPipeline pipeline(LZCodec::Name, 0, 10000);
+  BufferPool::Buffer encoded;
+  CodecInfo info = pipeline.encode(random.data(), random.size(), pool, encoded);
+  EXPECT_EQ(info.compressedSize(), random.size());
+
+  std::vector<Byte> output(random.size());
+  pipeline.decode(encoded.data(), info, 0, info.numBlocks(), output.data(), pool);
+  ASSERT_EQ(random, output);
+}
+
+TEST(CodecPipelineTest, NumThreads) {
+  BufferPool pool;
+  auto input = smoothField(100000);
+
+  CodecPipeline pipeline(LZCodec::Name, 8, 10000);
+  EXPECT_EQ(pipeline.numThreads(), 1);
+
+  BufferPool::Buffer encoded;
+  CodecInfo info = pipeline.encode(input.data(), input.size(), pool, encoded);
+
+  // Threaded encoding and decoding produce the same result
+  pipeline.setNumThreads(4);
+  EXPECT_EQ(pipeline.numThreads(), 4);
+
+  BufferPool::Buffer threadedEncoded;
+  CodecInfo threadedInfo = pipeline.encode(input.data(), input.size(), pool, threadedEncoded);
+  ASSERT_EQ(info.blocks, threadedInfo.blocks);
+  ASSERT_EQ(0, std::memcmp(encoded.data(), threadedEncoded.data(), info.compressedSize()));
+
+  std::vector<Byte> output(input.size());
+  pipeline.decode(encoded.data(), info, 0, info.numBlocks(), output.data(), pool);
+  ASSERT_EQ(input, output);
+}
+
+TEST(CodecPipelineTest, Metainfo) {
+  EXPECT_EQ(CodecPipeline::create(nullptr, TypeID::Float64), nullptr);
+
+  FieldMetainfoImpl info(TypeID::Float64, {10});
+  EXPECT_EQ(CodecPipeline::create(&info, TypeID::Float64), nullptr);
+
+  info.metaInfo().insert(CodecPipeline::CodecKey, std::string("none"));
+  EXPECT_EQ(CodecPipeline::create(&info, TypeID::Float64), nullptr);
+
+  info.metaInfo()[CodecPipeline::CodecKey] = MetainfoValueImpl(std::string(LZCodec::Name));
+  auto pipeline = CodecPipeline::create(&info, TypeID::Float64);
+  ASSERT_NE(pipeline, nullptr);
+  EXPECT_STREQ(pipeline->codec().name(), LZCodec::Name);
+  EXPECT_EQ(pipeline->shuffle(), 8);
+  EXPECT_EQ(pipeline->blockSize(), CodecPipeline::DefaultBlockSize);
+
+  info.metaInfo().insert(CodecPipeline::ShuffleKey, false);
+  info.metaInfo().insert(CodecPipeline::BlockSizeKey, 4096);
+  pipeline = CodecPipeline::create(&info, TypeID::Float64);
+  EXPECT_EQ(pipeline->shuffle(), 0);
+  EXPECT_EQ(pipeline->blockSize(), 4096);
+
+  info.metaInfo()[CodecPipeline::BlockSizeKey] = MetainfoValueImpl(0);
+  ASSERT_THROW(CodecPipeline::create(&info, TypeID::Float64), Exception);
+
+  info.metaInfo()[CodecPipeline::CodecKey] = MetainfoValueImpl(std::string("X"));
+  info.metaInfo()[CodecPipeline::BlockSizeKey] = MetainfoValueImpl(4096);
+  ASSERT_THROW(CodecPipeline::create(&info, TypeID::Float64), Exception);
+
+  // Delta encoding defaults to the lz codec
+  FieldMetainfoImpl deltaInfo(TypeID::Float64, {10});
+  deltaInfo.metaInfo().insert(CodecPipeline::DeltaKey, true);
+  pipeline = CodecPipeline::create(&deltaInfo, TypeID::Float64);
+  ASSERT_NE(pipeline, nullptr);
+  EXPECT_TRUE(pipeline->isDeltaEncoding());
+  EXPECT_STREQ(pipeline->codec().name(), LZCodec::Name);
+  EXPECT_EQ(pipeline->keyframeInterval(), CodecPipeline::DefaultKeyframeInterval);
+
+  deltaInfo.metaInfo().insert(CodecPipeline::CodecKey, std::string("none"));
+  ASSERT_THROW(CodecPipeline::create(&deltaInfo, TypeID::Float64), Exception);
+}
+
+TEST(CodecPipelineTest, DeltaEncoding) {
+  BufferPool pool;
+  const std::size_t size = 1000 * sizeof(double);
+
+  std::vector<double> reference(1000), data(1000), output(1000);
+  for(std::size_t i = 0; i < data.size(); ++i)
+    data[i] = reference[i] = std::sin(0.01 * i);
+  data[42] += 1.0;
+
+  CodecPipeline pipeline(LZCodec::Name, sizeof(double), 1024);
+  pipeline.setKeyframeInterval(4);
+
+  BufferPool::Buffer encoded, plain;
+  std::vector<double> reconstructed(1000);
+  CodecInfo info = pipeline.encode(reinterpret_cast<const Byte*>(data.data()), size, pool,
+                                   encoded, reinterpret_cast<const Byte*>(reference.data()),
+                                   reinterpret_cast<Byte*>(reconstructed.data()));
+  CodecInfo infoPlain =
+      pipeline.encode(reinterpret_cast<const Byte*>(data.data()), size, pool, plain);
+  EXPECT_EQ(reconstructed, data);
+
+  // The difference to the reference is almost zero everywhere
+  EXPECT_LT(info.compressedSize(), infoPlain.compressedSize());
+
+  pipeline.decode(encoded.data(), info, 0, info.numBlocks(), reinterpret_cast<Byte*>(output.data()),
+                  pool, reinterpret_cast<const Byte*>(reference.data()));
+  EXPECT_EQ(output, data);
+}
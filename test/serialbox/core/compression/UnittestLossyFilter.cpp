@@ -0,0 +1,181 @@
+//===-- serialbox/core/compression/UnittestLossyFilter.cpp --------------------------*- C++ -*-===//
+//
+//                                    S E R I A L B O X
+//
+// This file is distributed under terms of BSD license.
+// See LICENSE.txt for more information
+//
+//===------------------------------------------------------------------------------------------===//
+//
+/// \file
+/// This file contains the unittests of the error-bounded lossy filter.
+///
+//===------------------------------------------------------------------------------------------===//
+
+#include "serialbox/core/Exception.h"
+#include "serialbox/core/compression/CodecPipeline.h"
+#include "serialbox/core/compression/LossyFilter.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+
+using namespace serialbox;
+
+namespace {
+
+template <class T>
+class LossyFilterTest : public testing::Test {};
+
+using TestTypes = testing::Types<float, double>;
+
+template <class T>
+std::vector<T> randomValues(std::size_t numElements) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+  std::uniform_int_distribution<int> exponent(-20, 20);
+
+  std::vector<T> values(numElements);
+  for(auto& value : values)
+    value = T(std::ldexp(mantissa(gen), exponent(gen)));
+  return values;
+}
+
+} // anonymous namespace
+
+TYPED_TEST_CASE(LossyFilterTest, TestTypes);
+
+TYPED_TEST(LossyFilterTest, AbsoluteBound) {
+  const TypeID type = ToTypeID<TypeParam>::value;
+
+  for(double bound : {1e-6, 1e-3, 0.3, 100.0}) {
+    auto input = randomValues<TypeParam>(10000);
+    auto output = input;
+
+    LossyFilter filter(type, ErrorBoundKind::Absolute, bound);
+    double maxError = filter.apply(reinterpret_cast<Byte*>(output.data()),
+                                   output.size() * sizeof(TypeParam));
+
+    double error = 0.0;
+    for(std::size_t i = 0; i < input.size(); ++i)
+      error = std::max(error, std::abs(double(input[i]) - double(output[i])));
+
+    EXPECT_LE(error, bound) << "bound: " << bound;
+    EXPECT_DOUBLE_EQ(error, maxError);
+  }
+}
+
+TYPED_TEST(LossyFilterTest, RelativeBound) {
+  const TypeID type = ToTypeID<TypeParam>::value;
+
+  for(double bound : {1e-6, 1e-3, 0.3, 2.0}) {
+    auto input = randomValues<TypeParam>(10000);
+    auto output = input;
+
+    LossyFilter filter(type, ErrorBoundKind::Relative, bound);
+    double maxError = filter.apply(reinterpret_cast<Byte*>(output.data()),
+                                   output.size() * sizeof(TypeParam));
+
+    double error = 0.0;
+    for(std::size_t i = 0; i < input.size(); ++i)
+      if(input[i] != 0)
+        error = std::max(error, std::abs(double(input[i]) - double(output[i])) /
+                                    std::abs(double(input[i])));
+
+    EXPECT_LE(error, bound) << "bound: " << bound;
+    EXPECT_DOUBLE_EQ(error, maxError);
+  }
+}
+
+TYPED_TEST(LossyFilterTest, SpecialValues) {
+  using Limits = std::numeric_limits<TypeParam>;
+  const TypeID type = ToTypeID<TypeParam>::value;
+
+  std::vector<TypeParam> values{Limits::infinity(), -Limits::infinity(), Limits::quiet_NaN(),
+                                Limits::max(), Limits::denorm_min(), TypeParam(0)};
+
+  LossyFilter filter(type, ErrorBoundKind::Relative, 0.1);
+  filter.apply(reinterpret_cast<Byte*>(values.data()), values.size() * sizeof(TypeParam));
+
+  EXPECT_EQ(values[0], Limits::infinity());
+  EXPECT_EQ(values[1], -Limits::infinity());
+  EXPECT_TRUE(std::isnan(values[2]));
+  EXPECT_TRUE(std::isfinite(values[3]));
+  EXPECT_EQ(values[4], Limits::denorm_min());
+  EXPECT_EQ(values[5], TypeParam(0));
+
+  // Values close to the largest finite value are not truncated when rounding overflows
+  const double bound = std::ldexp(1.0, Limits::max_exponent - 10);
+  std::vector<TypeParam> large{Limits::max(), -Limits::max(),
+                               TypeParam(std::ldexp(1.99, Limits::max_exponent - 1))};
+  auto output = large;
+
+  LossyFilter absFilter(type, ErrorBoundKind::Absolute, bound);
+  absFilter.apply(reinterpret_cast<Byte*>(output.data()), output.size() * sizeof(TypeParam));
+  for(std::size_t i = 0; i < large.size(); ++i) {
+    EXPECT_TRUE(std::isfinite(output[i]));
+    EXPECT_LE(std::abs(double(large[i]) - double(output[i])), bound);
+  }
+}
+
+TEST(LossyFilterTest, Construction) {
+  ASSERT_THROW(LossyFilter(TypeID::Int32, ErrorBoundKind::Absolute, 0.1), Exception);
+  ASSERT_THROW(LossyFilter(TypeID::Float64, ErrorBoundKind::Absolute, 0.0), Exception);
+  ASSERT_THROW(LossyFilter(TypeID::Float64, ErrorBoundKind::Relative, -1.0), Exception);
+
+  EXPECT_EQ(LossyFilter::fromString(LossyFilter::toString(ErrorBoundKind::Absolute)),
+            ErrorBoundKind::Absolute);
+  EXPECT_EQ(LossyFilter::fromString(LossyFilter::toString(ErrorBoundKind::Relative)),
+            ErrorBoundKind::Relative);
+  ASSERT_THROW(LossyFilter::fromString("X"), Exception);
+}
+
+TEST(LossyFilterTest, Pipeline) {
+  std::vector<double> input(100000);
+  for(std::size_t i = 0; i < input.size(); ++i)
+    input[i] = 280.0 + 20.0 * std::sin(1e-3 * i) + 1e-7 * std::cos(double(i));
+
+  FieldMetainfoImpl info(TypeID::Float64, {int(input.size())});
+  info.metaInfo().insert(CodecPipeline::AbsErrorKey, 1e-3);
+  info.metaInfo().insert(CodecPipeline::BlockSizeKey, 10001);
+
+  auto pipeline = CodecPipeline::create(&info, TypeID::Float64);
+  ASSERT_NE(pipeline, nullptr);
+  ASSERT_NE(pipeline->lossyFilter(), nullptr);
+  EXPECT_EQ(pipeline->blockSize(), 10000);
+
+  BufferPool pool;
+  BufferPool::Buffer encoded;
+  const Byte* data = reinterpret_cast<const Byte*>(input.data());
+  CodecInfo codec = pipeline->encode(data, input.size() * sizeof(double), pool, encoded);
+  EXPECT_TRUE(codec.isLossy());
+  EXPECT_LE(codec.maxError, 1e-3);
+  EXPECT_GT(codec.ratio(), 2.0);
+
+  // The lossless pipeline can hardly compress the noise in the low bits
+  FieldMetainfoImpl losslessInfo(TypeID::Float64, {int(input.size())});
+  losslessInfo.metaInfo().insert(CodecPipeline::CodecKey, std::string("lz"));
+  BufferPool::Buffer losslessEncoded;
+  CodecInfo lossless = CodecPipeline::create(&losslessInfo, TypeID::Float64)
+                           ->encode(data, input.size() * sizeof(double), pool, losslessEncoded);
+  EXPECT_GT(codec.ratio(), lossless.ratio());
+
+  std::vector<double> output(input.size());
+  pipeline->decode(encoded.data(), codec, 0, codec.numBlocks(),
+                   reinterpret_cast<Byte*>(output.data()), pool);
+  for(std::size_t i = 0; i < input.size(); ++i)
+    ASSERT_LE(std::abs(input[i] - output[i]), 1e-3);
+
+  // Invalid configurations
+  info.metaInfo().insert(CodecPipeline::RelErrorKey, 1e-3);
+  ASSERT_THROW(CodecPipeline::create(&info, TypeID::Float64), Exception);
+
+  FieldMetainfoImpl intInfo(TypeID::Int32, {10});
+  intInfo.metaInfo().insert(CodecPipeline::RelErrorKey, 1e-3);
+  ASSERT_THROW(CodecPipeline::create(&intInfo, TypeID::Int32), Exception);
+
+  FieldMetainfoImpl noneInfo(TypeID::Float64, {10});
+  noneInfo.metaInfo().insert(CodecPipeline::CodecKey, std::string("none"));
+  noneInfo.metaInfo().insert(CodecPipeline::RelErrorKey, 1e-3);
+  ASSERT_THROW(CodecPipeline::create(&noneInfo, TypeID::Float64), Exception);
+}